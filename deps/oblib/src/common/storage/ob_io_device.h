@@ -423,6 +423,18 @@ public:
   virtual ObIOEvents *alloc_io_events(const uint32_t max_events) = 0;
   virtual void free_iocb(ObIOCB *iocb) = 0;
   virtual void free_io_events(ObIOEvents *io_event) = 0;
+  // system fd and file offset of an io, for io channels driving the kernel directly (io_uring)
+  virtual int get_sys_io_target(
+    const ObIOFd &fd,
+    const int64_t offset,
+    int64_t &sys_fd,
+    int64_t &sys_offset) const
+  {
+    UNUSEDx(fd, offset);
+    sys_fd = -1;
+    sys_offset = -1;
+    return OB_NOT_SUPPORTED;
+  }
 
   // space management interface
   virtual int64_t get_total_block_size() const = 0;
@@ -617,6 +617,13 @@ int ObServer::start()
     FLOG_INFO("success to start server checkpoint slog handler");
   }
 
+  // macro block refs are replayed, hot blocks recorded before restart can be reloaded now
+  if (FAILEDx(OB_STORE_CACHE.get_cache_warmer().start())) {
+    LOG_ERROR("fail to start micro block cache warmer", KR(ret));
+  } else {
+    FLOG_INFO("success to start micro block cache warmer");
+  }
+
   if (FAILEDx(try_create_hidden_sys())) {
     LOG_ERROR("fail to create hidden sys tenant", KR(ret));
   } else {
@@ -974,6 +981,12 @@ int ObServer::stop()
   ObServerCheckpointSlogHandler::get_instance().stop();
   FLOG_INFO("server checkpoint slog handler stopped");
 
+  // record hot blocks while tenant caches are still alive
+  FLOG_INFO("begin to stop micro block cache warmer");
+  OB_STORE_CACHE.get_cache_warmer().stop();
+  OB_STORE_CACHE.get_cache_warmer().wait();
+  FLOG_INFO("micro block cache warmer stopped");
+
   // It will wait for all requests done.
   FLOG_INFO("begin to stop multi tenant");
   multi_tenant_.stop();
@@ -1585,7 +1598,8 @@ int ObServer::init_io()
           } else if (OB_FAIL(ObIOManager::get_instance().add_device_channel(THE_IO_DEVICE,
                                                                             io_config.disk_io_thread_count_,
                                                                             io_config.disk_io_thread_count_ / 2,
-                                                                            max_io_depth))) {
+                                                                            max_io_depth,
+                                                                            get_io_channel_type_enum(GCONF._io_channel_type.str())))) {
             LOG_ERROR("add device channel failed", KR(ret));
           } else if (OB_FAIL(ObIOManager::get_instance().add_tenant_io_manager(OB_SERVER_TENANT_ID,
                                                                                server_tenant_io_config))) {
@@ -2068,6 +2082,11 @@ int ObServer::init_storage()
                                     storage_env_.bf_cache_priority_,
                                     storage_env_.bf_cache_miss_count_threshold_))) {
       LOG_WARN("Fail to init OB_STORE_CACHE, ", KR(ret), K(storage_env_.data_dir_));
+    } else if (FALSE_IT(ObKVGlobalCache::get_instance().reload_admission_policy())) {
+    } else if (OB_FAIL(init_micro_block_flash_cache())) {
+      LOG_WARN("fail to init micro block flash cache", KR(ret));
+    } else if (OB_FAIL(init_micro_block_cache_warmer())) {
+      LOG_WARN("fail to init micro block cache warmer", KR(ret));
     } else if (OB_FAIL(ObTmpFileManager::get_instance().init())) {
       LOG_WARN("fail to init temp file manager", KR(ret));
     } else if (OB_FAIL(OB_SERVER_BLOCK_MGR.init(THE_IO_DEVICE,
@@ -2095,6 +2114,44 @@ int ObServer::init_storage()
   return ret;
 }
 
+int ObServer::init_micro_block_flash_cache()
+{
+  int ret = OB_SUCCESS;
+  const int64_t file_size = GCONF._micro_block_flash_cache_size;
+  char file_path[OB_MAX_FILE_NAME_LENGTH] = {0};
+  if (0 == file_size) {
+    // disabled
+  } else if (0 != STRLEN(GCONF._micro_block_flash_cache_path.str())) {
+    STRNCPY(file_path, GCONF._micro_block_flash_cache_path.str(), sizeof(file_path) - 1);
+  } else if (OB_FAIL(databuff_printf(file_path, sizeof(file_path), "%s/flash_cache",
+                                     storage_env_.sstable_dir_))) {
+    LOG_WARN("fail to build flash cache path", KR(ret), K(storage_env_.sstable_dir_));
+  }
+
+  if (OB_FAIL(ret) || 0 == file_size) {
+  } else if (OB_FAIL(OB_STORE_CACHE.init_flash_cache(file_path, file_size))) {
+    // flash cache is optional, serve from macro block io only
+    LOG_ERROR("fail to init micro block flash cache, run without it", KR(ret), K(file_path), K(file_size));
+    ret = OB_SUCCESS;
+  } else {
+    LOG_INFO("succeed to init micro block flash cache", K(file_path), K(file_size));
+  }
+  return ret;
+}
+
+int ObServer::init_micro_block_cache_warmer()
+{
+  int ret = OB_SUCCESS;
+  char manifest_path[OB_MAX_FILE_NAME_LENGTH] = {0};
+  if (OB_FAIL(databuff_printf(manifest_path, sizeof(manifest_path), "%s/micro_block_cache.manifest",
+                              storage_env_.sstable_dir_))) {
+    LOG_WARN("fail to build micro block cache manifest path", KR(ret), K(storage_env_.sstable_dir_));
+  } else if (OB_FAIL(OB_STORE_CACHE.init_cache_warmer(manifest_path))) {
+    LOG_WARN("fail to init micro block cache warmer", KR(ret), K(manifest_path));
+  }
+  return ret;
+}
+
 int ObServer::get_network_speed_from_sysfs(int64_t &network_speed)
 {
   int ret = OB_SUCCESS;
@@ -250,6 +250,8 @@ private:
   int init_ts_mgr();
   int init_px_target_mgr();
   int init_storage();
+  int init_micro_block_flash_cache();
+  int init_micro_block_cache_warmer();
   int init_gc_partition_adapter();
   int init_loaddata_global_stat();
   int init_bandwidth_throttle();
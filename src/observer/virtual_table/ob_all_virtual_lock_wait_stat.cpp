@@ -30,6 +30,8 @@ void ObAllVirtualLockWaitStat::reset()
 {
   ObVirtualTableScannerIterator::reset();
   node_iter_ = NULL;
+  queue_hash_ = 0;
+  queue_depth_ = 0;
 }
 
 
@@ -37,6 +39,8 @@ int ObAllVirtualLockWaitStat::inner_open()
 {
   int ret = OB_SUCCESS;
   node_iter_ = NULL;
+  queue_hash_ = 0;
+  queue_depth_ = 0;
   all_tenant_ids_.reset();
   GCTX.omt_->get_mtl_tenant_ids(all_tenant_ids_);
   cur_tenant_index_ = 0;
@@ -60,7 +64,7 @@ int ObAllVirtualLockWaitStat::inner_get_next_row(ObNewRow *&row)
           ret = OB_ERR_UNEXPECTED;
           SERVER_LOG(WARN, "lockWaitMgr is null for tenant", K(ret), K(tenant_id));
         } else if (OB_ISNULL(node_iter_ = MTL(memtable::ObLockWaitMgr*)
-                           ->next(node_iter_, &cur_node_))) {
+                           ->next(node_iter_, &cur_node_, queue_hash_, queue_depth_))) {
           ret = OB_ITER_END;
         }
       }
@@ -68,6 +72,7 @@ int ObAllVirtualLockWaitStat::inner_get_next_row(ObNewRow *&row)
           cur_tenant_index_ + 1 < all_tenant_ids_.count()) {
         // prepare for retry
         node_iter_ = NULL;
+        queue_hash_ = 0;
         cur_tenant_index_ += 1;
         ret = OB_SUCCESS;
       }
@@ -154,6 +159,9 @@ int ObAllVirtualLockWaitStat::inner_get_next_row(ObNewRow *&row)
           case TOTAL_UPDATE_CNT:
             cur_row_.cells_[i].set_int(node_iter_->total_update_cnt_);
             break;
+          case WAIT_QUEUE_DEPTH:
+            cur_row_.cells_[i].set_int(queue_depth_);
+            break;
           default:
             ret = OB_ERR_UNEXPECTED;
             SERVER_LOG(WARN, "invalid col_id", K(ret), K(col_id));
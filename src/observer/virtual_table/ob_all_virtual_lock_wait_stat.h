@@ -24,7 +24,8 @@ namespace observer
 class ObAllVirtualLockWaitStat : public common::ObVirtualTableScannerIterator
 {
 public:
-  ObAllVirtualLockWaitStat() : node_iter_(NULL), cur_tenant_index_(0) {}
+  ObAllVirtualLockWaitStat()
+    : node_iter_(NULL), cur_tenant_index_(0), queue_hash_(0), queue_depth_(0) {}
   virtual ~ObAllVirtualLockWaitStat() {reset();}
 public:
   virtual int inner_open();
@@ -53,11 +54,15 @@ private:
     LMODE,
     LAST_COMPACT_CNT,
     TOTAL_UPDATE_CNT,
+    WAIT_QUEUE_DEPTH,
   };
   rpc::ObLockWaitNode cur_node_;
   rpc::ObLockWaitNode *node_iter_;
   ObSEArray<uint64_t, 16> all_tenant_ids_;
   int cur_tenant_index_;
+  // depth of the wait queue of the current row, reused by the rows of the same queue
+  uint64_t queue_hash_;
+  int64_t queue_depth_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObAllVirtualLockWaitStat);
 };
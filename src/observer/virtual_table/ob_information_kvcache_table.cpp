@@ -262,6 +262,21 @@ int ObInfoSchemaKvCacheTable::inner_get_next_row(ObNewRow *&row)
             cells_[cell_idx].set_int(inst->status_.hold_size_);
             break;
           }
+          case RECENT_HIT_RATIO: {
+            memset(buf, 0, MAX_DOUBLE_PRINT_SIZE);
+            value = inst->status_.recent_hit_ratio_ * 100;
+            if (OB_UNLIKELY(0 > snprintf(buf, MAX_DOUBLE_PRINT_SIZE, "%lf", value))) {
+              ret = OB_IO_ERROR;
+              SERVER_LOG(WARN, "snprintf fail", K(ret), K(errno), KERRNOMSG(errno));
+            } else if (OB_SUCCESS == (ret = num.from(buf, str_buf_))) {
+              cells_[cell_idx].set_number(num);
+            }
+            break;
+          }
+          case PROBATION_PUT_CNT: {
+            cells_[cell_idx].set_int(ATOMIC_LOAD(&inst->status_.probation_put_cnt_));
+            break;
+          }
           default: {
             ret = OB_ERR_UNEXPECTED;
             SERVER_LOG(WARN, "invalid column id", K(ret), K(cell_idx),
@@ -55,7 +55,9 @@ private:
     TOTAL_PUT_CNT,
     TOTAL_HIT_CNT,
     TOTAL_MISS_CNT,
-    HOLD_SIZE
+    HOLD_SIZE,
+    RECENT_HIT_RATIO,
+    PROBATION_PUT_CNT
   };
   common::ObAddr *addr_;
   common::ObString ipstr_;
@@ -268,6 +268,7 @@ void ObKVGlobalCache::destroy()
     insts_.destroy();
     for (int64_t i = 0; i < MAX_CACHE_NUM; ++i) {
       configs_[i].reset();
+      sketches_[i].destroy();
     }
     cache_num_ = 0;
     mem_limit_getter_ = nullptr;
@@ -448,6 +449,14 @@ int ObKVGlobalCache::get(
         COMMON_LOG(WARN, "fail to get value from map, ", K(ret));
       }
     }
+    if (OB_LIKELY(cache_id >= 0 && cache_id < MAX_CACHE_NUM)) {
+      // both hits and misses count towards the access frequency used on admission
+      ObKVCacheFrequencySketch *sketch = configs_[cache_id].get_admission_sketch();
+      uint64_t hash_code = 0;
+      if (NULL != sketch && OB_SUCCESS == key.hash(hash_code)) {
+        sketch->record(hash_code);
+      }
+    }
   }
   return ret;
 }
@@ -605,6 +614,8 @@ void ObKVGlobalCache::deregister_cache(const int64_t cache_id)
   } else {
     lib::ObMutexGuard guard(mutex_);
     configs_[cache_id].is_valid_ = false;
+    configs_[cache_id].victim_handler_ = NULL;
+    ATOMIC_STORE(&configs_[cache_id].admission_policy_, ADMIT_ALL);
   }
 
   if (OB_SUCC(ret)) {
@@ -670,6 +681,77 @@ int ObKVGlobalCache::set_priority(const int64_t cache_id, const int64_t priority
   return ret;
 }
 
+int ObKVGlobalCache::set_victim_handler(
+    const int64_t cache_id,
+    ObIKVCacheVictimHandler *victim_handler)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(cache_id < 0) || OB_UNLIKELY(cache_id >= MAX_CACHE_NUM)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(cache_id), K(ret));
+  } else {
+    lib::ObMutexGuard guard(mutex_);
+    ATOMIC_STORE(&configs_[cache_id].victim_handler_, victim_handler);
+  }
+  return ret;
+}
+
+int ObKVGlobalCache::set_admission_policy(
+    const int64_t cache_id,
+    const ObKVCacheAdmissionPolicy policy)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(cache_id < 0) || OB_UNLIKELY(cache_id >= MAX_CACHE_NUM)
+      || OB_UNLIKELY(policy < ADMIT_ALL) || OB_UNLIKELY(policy >= MAX_ADMISSION_POLICY)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(cache_id), K(policy), K(ret));
+  } else {
+    lib::ObMutexGuard guard(mutex_);
+    if (configs_[cache_id].admission_policy_ == policy) {
+      // same policy, do nothing
+    } else {
+      // the sketch is kept until destroy, since gets and puts may still be reading it
+      if (ADMIT_TINY_LFU == policy && !sketches_[cache_id].is_inited()) {
+        if (OB_FAIL(sketches_[cache_id].init(ObKVCacheFrequencySketch::DEFAULT_COUNTER_CNT))) {
+          COMMON_LOG(WARN, "Fail to init frequency sketch, ", K(ret), K(cache_id));
+        } else {
+          configs_[cache_id].sketch_ = &sketches_[cache_id];
+        }
+      }
+      if (OB_SUCC(ret)) {
+        ATOMIC_STORE(&configs_[cache_id].admission_policy_, policy);
+        COMMON_LOG(INFO, "Success to set admission policy, ", K(cache_id), K(policy),
+            "cache_name", configs_[cache_id].cache_name_);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObKVGlobalCache::visit_hot_pairs(
+    const int64_t cache_id,
+    const int64_t max_size,
+    ObIKVCachePairVisitor &visitor)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(cache_id < 0) || OB_UNLIKELY(cache_id >= MAX_CACHE_NUM)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(cache_id), K(ret));
+  } else if (OB_FAIL(store_.visit_hot_pairs(cache_id, max_size, visitor))) {
+    COMMON_LOG(WARN, "Fail to visit hot pairs, ", K(ret), K(cache_id), K(max_size));
+  }
+  return ret;
+}
+
 void ObKVGlobalCache::wash()
 {
   if (OB_LIKELY(inited_ && !start_destory_)) {
@@ -732,6 +814,33 @@ void ObKVGlobalCache::reload_priority()
   }
 }
 
+void ObKVGlobalCache::reload_admission_policy()
+{
+  int ret = OB_SUCCESS;
+  const int64_t MAX_CACHE_LIST_LENGTH = common::OB_MAX_CONFIG_VALUE_LEN;
+  char cache_list[MAX_CACHE_LIST_LENGTH] = {0};
+  if (OB_FAIL(GCONF._cache_tinylfu_admission.copy(cache_list, MAX_CACHE_LIST_LENGTH))) {
+    COMMON_LOG(WARN, "Fail to copy tinylfu admission cache list, ", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < MAX_CACHE_NUM; ++i) {
+    if (configs_[i].is_valid_) {
+      bool found = false;
+      char buf[MAX_CACHE_LIST_LENGTH] = {0};
+      char *save_ptr = NULL;
+      STRNCPY(buf, cache_list, MAX_CACHE_LIST_LENGTH - 1);
+      for (char *name = strtok_r(buf, ", ", &save_ptr); !found && NULL != name;
+           name = strtok_r(NULL, ", ", &save_ptr)) {
+        found = 0 == STRNCMP(configs_[i].cache_name_, name, MAX_CACHE_NAME_LENGTH);
+      }
+      const ObKVCacheAdmissionPolicy policy = found ? ADMIT_TINY_LFU : ADMIT_ALL;
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(set_admission_policy(i, policy))) {
+        COMMON_LOG(WARN, "Fail to set admission policy, ", K(tmp_ret), K(i), K(policy));
+      }
+    }
+  }
+}
+
 int ObKVGlobalCache::reload_wash_interval()
 {
   int ret = OB_SUCCESS;
@@ -62,6 +62,10 @@ public:
   int init(const char *cache_name, const int64_t priority = 1);
   void destroy();
   int set_priority(const int64_t priority);
+  // @victim_handler receives the kv pairs of this cache washed out of memory, NULL to unset
+  int set_victim_handler(ObIKVCacheVictimHandler *victim_handler);
+  // visit kv pairs of this cache in the hottest mem blocks first, until about @max_size visited
+  int visit_hot_pairs(const int64_t max_size, ObIKVCachePairVisitor &visitor);
   virtual int put(const Key &key, const Value &value, bool overwrite = true);
   virtual int put_and_fetch(
     const Key &key,
@@ -138,6 +142,7 @@ public:
            const int64_t cache_wash_interval = 0);
   void destroy();
   void reload_priority();
+  void reload_admission_policy();
   int reload_wash_interval();
   int64_t get_suitable_bucket_num();
   int get_tenant_cache_info(const uint64_t tenant_id, ObIArray<ObKVCacheInstHandle> &inst_handles);
@@ -173,6 +178,10 @@ private:
   int create_working_set(const ObKVCacheInstKey &inst_key, ObWorkingSet *&working_set);
   int delete_working_set(ObWorkingSet *working_set);
   int set_priority(const int64_t cache_id, const int64_t priority);
+  int set_victim_handler(const int64_t cache_id, ObIKVCacheVictimHandler *victim_handler);
+  int set_admission_policy(const int64_t cache_id, const ObKVCacheAdmissionPolicy policy);
+  int visit_hot_pairs(const int64_t cache_id, const int64_t max_size,
+                      ObIKVCachePairVisitor &visitor);
   int put(
     const int64_t cache_id,
     const ObIKVCacheKey &key,
@@ -293,6 +302,8 @@ private:
   ObWorkingSetMgr ws_mgr_;
   // cache configs
   ObKVCacheConfig configs_[MAX_CACHE_NUM];
+  // access frequency of caches using TinyLFU admission, allocated on first use
+  ObKVCacheFrequencySketch sketches_[MAX_CACHE_NUM];
   int64_t cache_num_;
   lib::ObMutex mutex_;
   // timer and task
@@ -452,6 +463,32 @@ int ObKVCache<Key, Value>::set_priority(const int64_t priority)
   return ret;
 }
 
+template <class Key, class Value>
+int ObKVCache<Key, Value>::set_victim_handler(ObIKVCacheVictimHandler *victim_handler)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().set_victim_handler(cache_id_, victim_handler))) {
+    COMMON_LOG(WARN, "Fail to set victim handler, ", K(ret));
+  }
+  return ret;
+}
+
+template <class Key, class Value>
+int ObKVCache<Key, Value>::visit_hot_pairs(const int64_t max_size, ObIKVCachePairVisitor &visitor)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().visit_hot_pairs(cache_id_, max_size, visitor))) {
+    COMMON_LOG(WARN, "Fail to visit hot pairs, ", K(ret), K(max_size));
+  }
+  return ret;
+}
+
 template <class Key, class Value>
 int64_t ObKVCache<Key, Value>::size(const uint64_t tenant_id) const
 {
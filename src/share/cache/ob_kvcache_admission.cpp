@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_kvcache_admission.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/thread_local/ob_tsi_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+ObKVCacheFrequencySketch::ObKVCacheFrequencySketch()
+  : is_inited_(false),
+    table_(NULL),
+    doorkeeper_(NULL),
+    table_size_(0),
+    doorkeeper_size_(0),
+    sample_size_(0),
+    sample_cnt_(0),
+    reset_cnt_(0)
+{
+}
+
+ObKVCacheFrequencySketch::~ObKVCacheFrequencySketch()
+{
+  destroy();
+}
+
+int ObKVCacheFrequencySketch::init(const int64_t counter_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int64_t bits_per_word = 64;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "The ObKVCacheFrequencySketch has been inited", K(ret));
+  } else if (OB_UNLIKELY(counter_cnt < bits_per_word || 0 != (counter_cnt & (counter_cnt - 1)))) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "counter cnt should be power of 2", K(ret), K(counter_cnt));
+  } else {
+    // one doorkeeper bit per counter
+    table_size_ = counter_cnt / COUNTERS_PER_WORD;
+    doorkeeper_size_ = counter_cnt / bits_per_word;
+    const int64_t buf_size = (table_size_ + doorkeeper_size_) * sizeof(uint64_t);
+    void *buf = NULL;
+    if (OB_ISNULL(buf = ob_malloc(buf_size, ObMemAttr(OB_SERVER_TENANT_ID, "KVCacheSketch")))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "Fail to allocate frequency sketch", K(ret), K(buf_size));
+    } else {
+      MEMSET(buf, 0, buf_size);
+      table_ = static_cast<uint64_t *>(buf);
+      doorkeeper_ = table_ + table_size_;
+      sample_size_ = counter_cnt * SAMPLE_FACTOR;
+      sample_cnt_ = 0;
+      reset_cnt_ = 0;
+      is_inited_ = true;
+    }
+  }
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObKVCacheFrequencySketch::destroy()
+{
+  if (NULL != table_) {
+    ob_free(table_);
+  }
+  table_ = NULL;
+  doorkeeper_ = NULL;
+  table_size_ = 0;
+  doorkeeper_size_ = 0;
+  sample_size_ = 0;
+  sample_cnt_ = 0;
+  reset_cnt_ = 0;
+  for (int64_t i = 0; i < SAMPLE_SLOT_CNT; ++i) {
+    sample_slots_[i].cnt_ = 0;
+  }
+  is_inited_ = false;
+}
+
+void ObKVCacheFrequencySketch::record(const uint64_t hash)
+{
+  if (OB_LIKELY(is_inited_)) {
+    const uint64_t h = spread(hash);
+    if (check_and_set_doorkeeper(h)) {
+      for (int64_t i = 0; i < HASH_CNT; ++i) {
+        increment(h, i);
+      }
+    }
+    // threads sharing a slot may lose a few samples, which only delays aging
+    SampleSlot &slot = sample_slots_[get_itid() & (SAMPLE_SLOT_CNT - 1)];
+    const int64_t slot_cnt = ATOMIC_LOAD(&slot.cnt_) + 1;
+    if (slot_cnt < SAMPLE_BATCH_CNT) {
+      ATOMIC_STORE(&slot.cnt_, slot_cnt);
+    } else {
+      ATOMIC_STORE(&slot.cnt_, 0);
+      if (ATOMIC_AAF(&sample_cnt_, SAMPLE_BATCH_CNT) >= sample_size_) {
+        age();
+      }
+    }
+  }
+}
+
+int64_t ObKVCacheFrequencySketch::estimate(const uint64_t hash) const
+{
+  int64_t frequency = 0;
+  if (OB_LIKELY(is_inited_)) {
+    const uint64_t h = spread(hash);
+    frequency = MAX_FREQUENCY;
+    for (int64_t i = 0; i < HASH_CNT; ++i) {
+      frequency = MIN(frequency, get_counter(h, i));
+    }
+    if (check_doorkeeper(h)) {
+      ++frequency;
+    }
+  }
+  return frequency;
+}
+
+uint64_t ObKVCacheFrequencySketch::spread(const uint64_t hash)
+{
+  // the hash of some cache keys is a plain combination of their fields
+  uint64_t h = hash;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdUL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53UL;
+  h ^= h >> 33;
+  return h;
+}
+
+bool ObKVCacheFrequencySketch::check_and_set_doorkeeper(const uint64_t hash)
+{
+  bool exist = true;
+  for (int64_t i = 0; i < 2; ++i) {
+    const uint64_t h = sub_hash(hash, HASH_CNT + i);
+    uint64_t *word = &doorkeeper_[(h >> 6) & (doorkeeper_size_ - 1)];
+    const uint64_t bit = 1UL << (h & 63);
+    if (0 == (ATOMIC_LOAD(word) & bit)) {
+      exist = false;
+      (void) __sync_fetch_and_or(word, bit);
+    }
+  }
+  return exist;
+}
+
+bool ObKVCacheFrequencySketch::check_doorkeeper(const uint64_t hash) const
+{
+  bool exist = true;
+  for (int64_t i = 0; exist && i < 2; ++i) {
+    const uint64_t h = sub_hash(hash, HASH_CNT + i);
+    const uint64_t bit = 1UL << (h & 63);
+    exist = 0 != (ATOMIC_LOAD(&doorkeeper_[(h >> 6) & (doorkeeper_size_ - 1)]) & bit);
+  }
+  return exist;
+}
+
+void ObKVCacheFrequencySketch::increment(const uint64_t hash, const int64_t i)
+{
+  const uint64_t h = sub_hash(hash, i);
+  uint64_t *word = &table_[(h >> 4) & (table_size_ - 1)];
+  const int64_t shift = (h & (COUNTERS_PER_WORD - 1)) << 2;
+  bool done = false;
+  while (!done) {
+    const uint64_t old_value = ATOMIC_LOAD(word);
+    if (static_cast<int64_t>((old_value >> shift) & 0xF) >= MAX_FREQUENCY) {
+      done = true;
+    } else {
+      done = ATOMIC_BCAS(word, old_value, old_value + (1UL << shift));
+    }
+  }
+}
+
+int64_t ObKVCacheFrequencySketch::get_counter(const uint64_t hash, const int64_t i) const
+{
+  const uint64_t h = sub_hash(hash, i);
+  const uint64_t word = ATOMIC_LOAD(&table_[(h >> 4) & (table_size_ - 1)]);
+  const int64_t shift = (h & (COUNTERS_PER_WORD - 1)) << 2;
+  return static_cast<int64_t>((word >> shift) & 0xF);
+}
+
+void ObKVCacheFrequencySketch::age()
+{
+  const int64_t cur_cnt = ATOMIC_LOAD(&sample_cnt_);
+  // only the thread taking the sample off the count ages the sketch, samples added
+  // meanwhile stay for the next round
+  if (cur_cnt >= sample_size_ && ATOMIC_BCAS(&sample_cnt_, cur_cnt, cur_cnt - sample_size_)) {
+    for (int64_t i = 0; i < table_size_; ++i) {
+      ATOMIC_STORE(&table_[i], (ATOMIC_LOAD(&table_[i]) >> 1) & RESET_MASK);
+    }
+    for (int64_t i = 0; i < doorkeeper_size_; ++i) {
+      ATOMIC_STORE(&doorkeeper_[i], 0);
+    }
+    ATOMIC_INC(&reset_cnt_);
+  }
+}
+
+}//end namespace common
+}//end namespace oceanbase
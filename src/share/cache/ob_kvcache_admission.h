@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
+#define OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
+
+#include "share/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+#include "lib/utility/ob_macro_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+enum ObKVCacheAdmissionPolicy
+{
+  // every put is treated alike, the default
+  ADMIT_ALL = 0,
+  // puts of keys that are not frequent in the recent access history are kept on probation
+  ADMIT_TINY_LFU = 1,
+  MAX_ADMISSION_POLICY
+};
+
+// Approximate access frequency of cache keys (TinyLFU).
+//
+// A count-min sketch of 4-bit counters, four counters per key, fronted by a doorkeeper
+// bitmap which absorbs the first access of every key, so that one-hit wonders such as
+// the blocks of a full table scan never reach the counters. After a sample of
+// SAMPLE_FACTOR times the counter count accesses, all counters are halved and the
+// doorkeeper is cleared, so the estimate tracks recent history. Accesses are first
+// counted in per-thread slots and added to the sample count in batches, so that gets
+// of different threads do not contend on one counter.
+//
+// Updates are lock free and may be lost under contention or during aging, which only
+// makes the estimate slightly lower.
+class ObKVCacheFrequencySketch
+{
+public:
+  ObKVCacheFrequencySketch();
+  virtual ~ObKVCacheFrequencySketch();
+  int init(const int64_t counter_cnt);
+  void destroy();
+  void record(const uint64_t hash);
+  int64_t estimate(const uint64_t hash) const;
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  TO_STRING_KV(K_(is_inited), K_(table_size), K_(doorkeeper_size), K_(sample_size), K_(sample_cnt),
+      K_(reset_cnt));
+public:
+  static const int64_t DEFAULT_COUNTER_CNT = 1L << 20;
+  static const int64_t MAX_FREQUENCY = 15;
+private:
+  static const int64_t HASH_CNT = 4;
+  static const int64_t COUNTERS_PER_WORD = 16;
+  static const int64_t SAMPLE_FACTOR = 10;
+  static const int64_t SAMPLE_SLOT_CNT = 64;
+  static const int64_t SAMPLE_BATCH_CNT = 64;
+  static const uint64_t RESET_MASK = 0x7777777777777777UL;
+  static uint64_t spread(const uint64_t hash);
+  OB_INLINE static uint64_t sub_hash(const uint64_t hash, const int64_t i)
+  {
+    return hash + static_cast<uint64_t>(i) * ((hash >> 32) | 1);
+  }
+  bool check_and_set_doorkeeper(const uint64_t hash);
+  bool check_doorkeeper(const uint64_t hash) const;
+  void increment(const uint64_t hash, const int64_t i);
+  int64_t get_counter(const uint64_t hash, const int64_t i) const;
+  void age();
+private:
+  struct SampleSlot
+  {
+    SampleSlot() : cnt_(0) {}
+    int64_t cnt_ CACHE_ALIGNED;
+  };
+  bool is_inited_;
+  // 16 4-bit counters in each word
+  uint64_t *table_;
+  uint64_t *doorkeeper_;
+  int64_t table_size_;
+  int64_t doorkeeper_size_;
+  int64_t sample_size_;
+  int64_t sample_cnt_;
+  int64_t reset_cnt_;
+  SampleSlot sample_slots_[SAMPLE_SLOT_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObKVCacheFrequencySketch);
+};
+
+}//end namespace common
+}//end namespace oceanbase
+
+#endif //OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
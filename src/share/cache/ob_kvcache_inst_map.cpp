@@ -387,16 +387,27 @@ int ObKVCacheInstMap::refresh_score()
     double avg_hit = 0;
     ObKVCacheInst *inst = NULL;
     int64_t total_hit_cnt = 0;
+    int64_t total_put_cnt = 0;
+    int64_t recent_hit_cnt = 0;
+    int64_t recent_put_cnt = 0;
     DRWLock::RDLockGuard rd_guard(lock_);
     for (KVCacheInstMap::iterator iter = inst_map_.begin(); OB_SUCC(ret) && iter != inst_map_.end(); ++iter) {
       inst = iter->second;
       mb_cnt = ATOMIC_LOAD(&inst->status_.lru_mb_cnt_) + ATOMIC_LOAD(&inst->status_.lfu_mb_cnt_);
       avg_hit = 0;
       total_hit_cnt = inst->status_.total_hit_cnt_.value();
+      total_put_cnt = inst->status_.total_put_cnt_.value();
+      recent_hit_cnt = total_hit_cnt - inst->status_.last_hit_cnt_;
+      recent_put_cnt = total_put_cnt - inst->status_.last_put_cnt_;
       if (mb_cnt > 0) {
-        avg_hit = double (total_hit_cnt - inst->status_.last_hit_cnt_) / (double) mb_cnt;
+        avg_hit = double (recent_hit_cnt) / (double) mb_cnt;
+      }
+      // almost every miss is followed by a put, so puts stand for the misses of the period
+      if (recent_hit_cnt + recent_put_cnt > 0) {
+        inst->status_.recent_hit_ratio_ = double(recent_hit_cnt) / double(recent_hit_cnt + recent_put_cnt);
       }
       inst->status_.last_hit_cnt_ = total_hit_cnt;
+      inst->status_.last_put_cnt_ = total_put_cnt;
       inst->status_.base_mb_score_ = inst->status_.base_mb_score_ * CACHE_SCORE_DECAY_FACTOR
           + avg_hit * (double) (inst->status_.config_->priority_);
     }
@@ -472,14 +483,16 @@ void ObKVCacheInstMap::print_tenant_cache_info(const uint64_t tenant_id)
           for (KVCacheInstMap::iterator iter = inst_map_.begin(); iter != inst_map_.end(); ++iter) {
             if (iter->second->tenant_id_ == tenant_id) {
               ret = databuff_printf(buf, BUFLEN, ctx_pos,
-              "[CACHE] tenant_id=%8ld | cache_name=%30s | cache_size=%12ld | cache_store_size=%12ld | cache_map_size=%12ld | kv_cnt=%8ld | hold_size=%12ld\n",
+              "[CACHE] tenant_id=%8ld | cache_name=%30s | cache_size=%12ld | cache_store_size=%12ld | cache_map_size=%12ld | kv_cnt=%8ld | hold_size=%12ld | recent_hit_ratio=%6.2lf | probation_put_cnt=%12ld\n",
               iter->second->tenant_id_,
               iter->second->status_.config_->cache_name_,
               iter->second->status_.store_size_ + iter->second->node_allocator_.allocated(),
               iter->second->status_.store_size_,
               iter->second->node_allocator_.allocated(),
               iter->second->status_.kv_cnt_,
-              iter->second->status_.hold_size_);
+              iter->second->status_.hold_size_,
+              iter->second->status_.recent_hit_ratio_ * 100,
+              iter->second->status_.probation_put_cnt_);
             }
           }
         }
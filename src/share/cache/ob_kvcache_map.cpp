@@ -153,6 +153,7 @@ int ObKVCacheMap::put(
     COMMON_LOG(WARN, "Failed to get kvcache key hash", K(ret));
   } else {
     uint64_t bucket_pos = hash_code % bucket_num_;
+    const bool on_probation = is_on_probation(inst, hash_code);
     hash_code += inst.cache_id_;
 
     GlobalHazardVersionGuard hazard_guard(global_hazard_version_);
@@ -220,6 +221,10 @@ int ObKVCacheMap::put(
           (void) ATOMIC_AAF(&mb_handle->get_cnt_, 1);
           ++mb_handle->recent_get_cnt_;
           inst.status_.total_put_cnt_.inc();
+          if (on_probation) {
+            (void) ATOMIC_AAF(&mb_handle->probation_kv_cnt_, 1);
+            (void) ATOMIC_AAF(&inst.status_.probation_put_cnt_, 1);
+          }
 
           // add new node to list
           new_node->next_ = bucket_ptr;
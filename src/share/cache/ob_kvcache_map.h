@@ -29,6 +29,8 @@ class ObKVCacheMap
   static constexpr int64_t DEFAULT_BUCKET_SIZE = (16L << 20); // 16M
   static constexpr int64_t MIN_BUCKET_SIZE     = ( 4L << 10); //  4K
   static const int64_t HAZARD_VERSION_THREAD_WAITING_THRESHOLD = 512;
+  // the get miss leading to a put counts once, so puts of keys seen only once are on probation
+  static const int64_t PROBATION_FREQUENCY = 1;
   
 public:
   ObKVCacheMap();
@@ -97,6 +99,13 @@ private:
     }
     return ret;
   }
+  // a put is kept on probation if the key was not accessed again since it was first seen
+  OB_INLINE bool is_on_probation(const ObKVCacheInst &inst, const uint64_t hash_code) const
+  {
+    const ObKVCacheFrequencySketch *sketch = NULL == inst.status_.config_
+        ? NULL : inst.status_.config_->get_admission_sketch();
+    return NULL != sketch && sketch->estimate(hash_code) <= PROBATION_FREQUENCY;
+  }
   Node *&get_bucket_node(const int64_t idx)
   {
     const int64_t bucket_idx = idx / bucket_size_;
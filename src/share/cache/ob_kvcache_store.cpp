@@ -15,6 +15,7 @@
 #include "ob_kvcache_store.h"
 #include "lib/trace/ob_trace_event.h"
 #include "lib/stat/ob_diagnose_info.h"
+#include "lib/container/ob_array.h"
 
 namespace oceanbase
 {
@@ -251,6 +252,50 @@ void ObKVCacheStore::refresh_score()
   return;
 }
 
+int ObKVCacheStore::visit_hot_pairs(
+    const int64_t cache_id,
+    const int64_t max_size,
+    ObIKVCachePairVisitor &visitor)
+{
+  int ret = OB_SUCCESS;
+  ObArray<ObKVMemBlockHandle *> mb_handles;
+  if (OB_UNLIKELY(cache_id < 0 || cache_id >= MAX_CACHE_NUM || max_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(cache_id), K(max_size), K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < cur_mb_num_; ++i) {
+      if (add_handle_ref(&mb_handles_[i])) {
+        // pairs of a using mem block may still be under construction
+        if (NULL != mb_handles_[i].inst_ && cache_id == mb_handles_[i].inst_->cache_id_
+            && FULL == ATOMIC_LOAD(&mb_handles_[i].status_)) {
+          if (OB_FAIL(mb_handles.push_back(&mb_handles_[i]))) {
+            COMMON_LOG(WARN, "Fail to push back mb_handle, ", K(ret));
+            de_handle_ref(&mb_handles_[i]);
+          }
+        } else {
+          de_handle_ref(&mb_handles_[i]);
+        }
+      }
+    }
+    if (OB_SUCC(ret) && mb_handles.count() > 0) {
+      std::sort(&mb_handles.at(0), &mb_handles.at(0) + mb_handles.count(), StoreMBHandleCmp());
+      int64_t visited_size = 0;
+      for (int64_t i = mb_handles.count() - 1; OB_SUCC(ret) && i >= 0 && visited_size < max_size; --i) {
+        ObKVStoreMemBlock *mem_block = mb_handles.at(i)->mem_block_;
+        if (OB_FAIL(mem_block->visit(visitor))) {
+          COMMON_LOG(WARN, "Fail to visit mem block, ", K(ret));
+        } else {
+          visited_size += mem_block->get_align_size();
+        }
+      }
+    }
+    for (int64_t i = 0; i < mb_handles.count(); ++i) {
+      de_handle_ref(mb_handles.at(i));
+    }
+  }
+  return ret;
+}
+
 bool ObKVCacheStore::wash()
 {
   bool is_wash_valid = true;
@@ -1097,6 +1142,13 @@ int ObKVCacheStore::do_wash_mb(ObKVMemBlockHandle *mb_handle, void *&buf, int64_
         (void) ATOMIC_SAF(&mb_handle->inst_->status_.lfu_mb_cnt_, 1);
       }
     }
+    if (NULL != mb_handle->inst_ && NULL != mb_handle->inst_->status_.config_) {
+      ObIKVCacheVictimHandler *victim_handler
+          = ATOMIC_LOAD(&mb_handle->inst_->status_.config_->victim_handler_);
+      if (NULL != victim_handler) {
+        mb_handle->mem_block_->demote(*victim_handler);
+      }
+    }
     buf = mb_handle->mem_block_;
     mb_size = mb_handle->mem_block_->get_align_size();
     mb_handle->mem_block_->~ObKVStoreMemBlock();
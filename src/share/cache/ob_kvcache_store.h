@@ -71,6 +71,10 @@ public:
   void destroy();
   int set_priority(const int64_t cache_id, const int64_t old_priority, const int64_t new_priority);
   void refresh_score();
+  // visit kv pairs of cache @cache_id in the hottest full mem blocks first, until about
+  // @max_size of mem blocks are visited
+  int visit_hot_pairs(const int64_t cache_id, const int64_t max_size,
+                      ObIKVCachePairVisitor &visitor);
   bool wash();
   int get_avg_cache_item_size(const uint64_t tenant_id, const int64_t cache_id,
                               int64_t &avg_cache_item_size);
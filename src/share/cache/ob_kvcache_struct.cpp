@@ -21,7 +21,10 @@ namespace common
  */
 ObKVCacheConfig::ObKVCacheConfig()
   : is_valid_(false),
-    priority_(0)
+    priority_(0),
+    victim_handler_(NULL),
+    admission_policy_(ADMIT_ALL),
+    sketch_(NULL)
 {
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
@@ -31,6 +34,9 @@ void ObKVCacheConfig::reset()
   is_valid_ = false;
   priority_ = 0;
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
+  victim_handler_ = NULL;
+  admission_policy_ = ADMIT_ALL;
+  sketch_ = NULL;
 }
 
 /**
@@ -67,6 +73,9 @@ void ObKVCacheStatus::reset()
   base_mb_score_ = 0;
   hold_size_ = 0;
   total_miss_cnt_ = 0;
+  probation_put_cnt_ = 0;
+  last_put_cnt_ = 0;
+  recent_hit_ratio_ = 0;
 }
 
 /*
@@ -105,6 +114,40 @@ void ObKVStoreMemBlock::reuse()
   atomic_pos_.pairs = 0;
 }
 
+void ObKVStoreMemBlock::demote(ObIKVCacheVictimHandler &handler) const
+{
+  if (NULL != buffer_) {
+    int64_t pos = 0;
+    const ObKVCachePair *kvpair = NULL;
+
+    for (uint32_t i = 0; i < atomic_pos_.pairs; ++i) {
+      kvpair = reinterpret_cast<const ObKVCachePair*>(buffer_ + pos);
+      if (NULL != kvpair->key_ && NULL != kvpair->value_) {
+        handler.on_wash(*kvpair->key_, *kvpair->value_);
+      }
+      pos += kvpair->size_;
+    }
+  }
+}
+
+int ObKVStoreMemBlock::visit(ObIKVCachePairVisitor &visitor) const
+{
+  int ret = OB_SUCCESS;
+  if (NULL != buffer_) {
+    int64_t pos = 0;
+    const ObKVCachePair *kvpair = NULL;
+
+    for (uint32_t i = 0; OB_SUCC(ret) && i < atomic_pos_.pairs; ++i) {
+      kvpair = reinterpret_cast<const ObKVCachePair*>(buffer_ + pos);
+      if (NULL != kvpair->key_ && NULL != kvpair->value_) {
+        ret = visitor.visit(*kvpair->key_, *kvpair->value_);
+      }
+      pos += kvpair->size_;
+    }
+  }
+  return ret;
+}
+
 int64_t ObKVStoreMemBlock::upper_align(int64_t input, int64_t align)
 {
   return (input + align - 1) & ~(align - 1);
@@ -276,6 +319,7 @@ ObKVMemBlockHandle::ObKVMemBlockHandle()
       recent_get_cnt_(0),
       score_(0),
       kv_cnt_(0),
+      probation_kv_cnt_(0),
       working_set_(NULL)
 {
 }
@@ -293,6 +337,7 @@ void ObKVMemBlockHandle::reset()
   recent_get_cnt_ = 0;
   score_ = 0;
   kv_cnt_ = 0;
+  probation_kv_cnt_ = 0;
   handle_ref_.reset();
   prev_ = NULL;
   next_ = NULL;
@@ -326,7 +371,15 @@ int ObKVMemBlockHandle::alloc(const int64_t key_size, const int64_t value_size,
 
 void ObKVMemBlockHandle::set_full(const double base_mb_score)
 {
-  score_ += base_mb_score;
+  const int64_t kv_cnt = ATOMIC_LOAD(&kv_cnt_);
+  const int64_t probation_kv_cnt = MIN(ATOMIC_LOAD(&probation_kv_cnt_), kv_cnt);
+  if (probation_kv_cnt > 0) {
+    // pairs on probation earn no base score, so blocks filled by scans are washed
+    // before the blocks holding the frequent keys
+    score_ += base_mb_score * double(kv_cnt - probation_kv_cnt) / double(kv_cnt);
+  } else {
+    score_ += base_mb_score;
+  }
   ATOMIC_STORE((uint32_t*)(&status_), FULL);
 }
 }//end namespace common
@@ -22,6 +22,7 @@
 #include "lib/resource/ob_resource_mgr.h"
 #include "lib/allocator/ob_lf_fifo_allocator.h"
 #include "lib/metrics/ob_counter.h"
+#include "share/cache/ob_kvcache_admission.h"
 
 namespace oceanbase
 {
@@ -57,6 +58,27 @@ public:
   virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const = 0;
 };
 
+// Receives the kv pairs of a washed mem block right before they are destroyed,
+// e.g. to demote them into a lower storage tier. Called by whichever thread frees
+// the mem block, so it must be cheap and must not block on io or access the kv cache.
+class ObIKVCacheVictimHandler
+{
+public:
+  ObIKVCacheVictimHandler() {}
+  virtual ~ObIKVCacheVictimHandler() {}
+  virtual void on_wash(const ObIKVCacheKey &key, const ObIKVCacheValue &value) = 0;
+};
+
+// Visits kv pairs resident in memory, e.g. to record the hot keys of a cache.
+// Pairs are only guaranteed alive during visit().
+class ObIKVCachePairVisitor
+{
+public:
+  ObIKVCachePairVisitor() {}
+  virtual ~ObIKVCachePairVisitor() {}
+  virtual int visit(const ObIKVCacheKey &key, const ObIKVCacheValue &value) = 0;
+};
+
 struct ObKVCachePair
 {
   uint32_t magic_;
@@ -88,6 +110,8 @@ public:
   static int64_t get_align_size(const int64_t key_size, const int64_t value_size);
   int store(const ObIKVCacheKey &key, const ObIKVCacheValue &value, ObKVCachePair *&kvpair);
   int alloc(const int64_t key_size, const int64_t value_size, const int64_t align_kv_size, ObKVCachePair *&kvpair);
+  void demote(ObIKVCacheVictimHandler &handler) const;
+  int visit(ObIKVCachePairVisitor &visitor) const;
   inline int64_t get_payload_size() const
   {
     return payload_size_;
@@ -124,6 +148,8 @@ struct ObKVMemBlockHandle : public common::ObDLink
   int64_t recent_get_cnt_;
   double score_;
   int64_t kv_cnt_;
+  // pairs put while their keys were rare in the access history of a TinyLFU cache
+  int64_t probation_kv_cnt_;
   ObAtomicReference handle_ref_;
   common::ObLink retire_link_;
   ObWorkingSet *working_set_;
@@ -139,7 +165,7 @@ struct ObKVMemBlockHandle : public common::ObDLink
   void set_full(const double base_mb_score);
   ObKVMemBlockHandle *get_mb_handle() { return this; }
   TO_STRING_KV(KP_(mem_block), K_(status), KP_(inst), K_(policy), K_(get_cnt),
-      K_(recent_get_cnt), K_(score), K_(kv_cnt));
+      K_(recent_get_cnt), K_(score), K_(kv_cnt), K_(probation_kv_cnt));
 };
 
 struct ObKVCacheInstKey
@@ -173,9 +199,17 @@ struct ObKVCacheConfig
 public:
   ObKVCacheConfig();
   void reset();
+  // the sketch to consult on admission, NULL if the cache admits all puts alike
+  OB_INLINE ObKVCacheFrequencySketch *get_admission_sketch() const
+  {
+    return ADMIT_TINY_LFU == ATOMIC_LOAD(&admission_policy_) ? sketch_ : NULL;
+  }
   bool is_valid_;
   int64_t priority_;
   char cache_name_[MAX_CACHE_NAME_LENGTH];
+  ObIKVCacheVictimHandler *victim_handler_;
+  ObKVCacheAdmissionPolicy admission_policy_;
+  ObKVCacheFrequencySketch *sketch_;
 };
 
 struct ObKVCacheStatus
@@ -188,7 +222,8 @@ public:
   inline int64_t get_hold_size() const { return ATOMIC_LOAD(&hold_size_); }
   void reset();
   TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt),
-      K_(lfu_mb_cnt), K_(base_mb_score), K_(hold_size));
+      K_(lfu_mb_cnt), K_(base_mb_score), K_(hold_size), K_(probation_put_cnt),
+      K_(recent_hit_ratio));
 
   const ObKVCacheConfig *config_;
   ObPCNonAtomicCounter total_put_cnt_;
@@ -203,6 +238,11 @@ public:
   double base_mb_score_;
   // guarantee at least hold_size_ memory left in cache after wash
   int64_t hold_size_;
+  // puts kept on probation by TinyLFU admission
+  int64_t probation_put_cnt_;
+  int64_t last_put_cnt_;
+  // hits / (hits + puts) during the last score refresh period
+  double recent_hit_ratio_;
 };
 
 struct ObKVCacheInfo
@@ -27,6 +27,7 @@
 #include "sql/plan_cache/ob_plan_cache_util.h"
 #include "share/ob_encryption_util.h"
 #include "share/ob_resource_limit.h"
+#include "share/io/ob_io_define.h"
 
 namespace oceanbase
 {
@@ -340,6 +341,11 @@ bool ObConfigRpcChecksumChecker::check(const ObConfigItem &t) const
   return obrpc::get_rpc_checksum_check_level_from_string(tmp_string) != obrpc::ObRpcCheckSumCheckLevel::INVALID ;
 }
 
+bool ObConfigIOChannelTypeChecker::check(const ObConfigItem &t) const
+{
+  return ObIOChannelType::MAX_TYPE != get_io_channel_type_enum(t.str());
+}
+
 bool ObConfigMemoryLimitChecker::check(const ObConfigItem &t) const
 {
   bool is_valid = false;
@@ -333,6 +333,18 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObConfigRpcChecksumChecker);
 };
 
+class ObConfigIOChannelTypeChecker
+  : public ObConfigChecker
+{
+public:
+  ObConfigIOChannelTypeChecker() {}
+  virtual ~ObConfigIOChannelTypeChecker() {};
+  bool check(const ObConfigItem &t) const;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObConfigIOChannelTypeChecker);
+};
+
 class ObConfigMemoryLimitChecker
   : public ObConfigChecker
 {
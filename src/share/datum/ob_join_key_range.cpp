@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SHARE
+
+#include "ob_join_key_range.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+void ObJoinKeyRange::reset()
+{
+  state_ = EMPTY;
+  has_null_ = false;
+  in_set_count_ = 0;
+  min_.reset();
+  max_.reset();
+  payload_len_ = 0;
+  min_payload_ = 0;
+  max_payload_ = 0;
+}
+
+bool ObJoinKeyRange::is_supported_type(const ObObjDatumMapType map_type)
+{
+  return OBJ_DATUM_8BYTE_DATA == map_type
+      || OBJ_DATUM_4BYTE_DATA == map_type
+      || OBJ_DATUM_1BYTE_DATA == map_type;
+}
+
+int ObJoinKeyRange::to_payload(const ObObj &obj, uint64_t &payload, uint32_t &payload_len)
+{
+  int ret = OB_SUCCESS;
+  ObDatum datum;
+  if (OB_FAIL(datum.from_obj(obj))) {
+    LOG_WARN("fail to convert obj to datum", K(ret), K(obj));
+  } else if (OB_UNLIKELY(datum.is_null() || datum.len_ > sizeof(payload))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected join key datum", K(ret), K(obj), K(datum));
+  } else {
+    payload = 0;
+    MEMCPY(&payload, datum.ptr_, datum.len_);
+    payload_len = datum.len_;
+  }
+  return ret;
+}
+
+void ObJoinKeyRange::add_to_in_set(const ObObj &obj, const uint64_t payload)
+{
+  bool found = false;
+  for (int64_t i = 0; !found && i < in_set_count_; ++i) {
+    found = (0 == in_set_[i].compare(obj));
+  }
+  if (found) {
+  } else if (in_set_count_ >= 0 && in_set_count_ < MAX_IN_SET_COUNT) {
+    in_set_[in_set_count_] = obj;
+    in_set_payloads_[in_set_count_] = payload;
+    ++in_set_count_;
+  } else {
+    in_set_count_ = -1;
+  }
+}
+
+int ObJoinKeyRange::refresh_payloads()
+{
+  int ret = OB_SUCCESS;
+  if (VALID != state_) {
+  } else if (OB_FAIL(to_payload(min_, min_payload_, payload_len_))) {
+    LOG_WARN("fail to make payload of min", K(ret), K(*this));
+  } else if (OB_FAIL(to_payload(max_, max_payload_, payload_len_))) {
+    LOG_WARN("fail to make payload of max", K(ret), K(*this));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && VALID == state_ && i < in_set_count_; ++i) {
+    if (OB_FAIL(to_payload(in_set_[i], in_set_payloads_[i], payload_len_))) {
+      LOG_WARN("fail to make payload of in set", K(ret), K(i), K(*this));
+    }
+  }
+  return ret;
+}
+
+int ObJoinKeyRange::add(const ObObj &obj)
+{
+  int ret = OB_SUCCESS;
+  uint64_t payload = 0;
+  uint32_t payload_len = 0;
+  if (INVALID == state_) {
+  } else if (obj.is_null()) {
+    has_null_ = true;
+  } else if (OB_UNLIKELY(!is_supported_type(ObDatum::get_obj_datum_map_type(obj.get_type())))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("unexpected join key type", K(ret), K(obj));
+  } else if (OB_UNLIKELY(EMPTY != state_ && obj.get_type() != min_.get_type())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("join key type changed", K(ret), K(obj), K(*this));
+  } else if (OB_FAIL(to_payload(obj, payload, payload_len))) {
+    LOG_WARN("fail to make payload of join key", K(ret), K(obj));
+  } else if (EMPTY == state_) {
+    min_ = obj;
+    max_ = obj;
+    min_payload_ = payload;
+    max_payload_ = payload;
+    payload_len_ = payload_len;
+    in_set_[0] = obj;
+    in_set_payloads_[0] = payload;
+    in_set_count_ = 1;
+    state_ = VALID;
+  } else {
+    if (obj.compare(min_) < 0) {
+      min_ = obj;
+      min_payload_ = payload;
+    } else if (obj.compare(max_) > 0) {
+      max_ = obj;
+      max_payload_ = payload;
+    }
+    add_to_in_set(obj, payload);
+  }
+  return ret;
+}
+
+int ObJoinKeyRange::merge(const ObJoinKeyRange &other)
+{
+  int ret = OB_SUCCESS;
+  if (INVALID == state_) {
+  } else if (INVALID == other.state_) {
+    invalidate();
+  } else if (EMPTY == other.state_) {
+    has_null_ = has_null_ || other.has_null_;
+  } else if (EMPTY == state_) {
+    const bool has_null = has_null_;
+    *this = other;
+    has_null_ = has_null_ || has_null;
+  } else if (OB_UNLIKELY(other.min_.get_type() != min_.get_type())) {
+    invalidate();
+    LOG_INFO("join key type differs, key range is not used", K(*this), K(other));
+  } else {
+    has_null_ = has_null_ || other.has_null_;
+    if (other.min_.compare(min_) < 0) {
+      min_ = other.min_;
+      min_payload_ = other.min_payload_;
+    }
+    if (other.max_.compare(max_) > 0) {
+      max_ = other.max_;
+      max_payload_ = other.max_payload_;
+    }
+    if (other.in_set_count_ < 0) {
+      in_set_count_ = -1;
+    }
+    for (int64_t i = 0; in_set_count_ >= 0 && i < other.in_set_count_; ++i) {
+      add_to_in_set(other.in_set_[i], other.in_set_payloads_[i]);
+    }
+  }
+  return ret;
+}
+
+bool ObJoinKeyRange::might_contain(const ObDatum &datum, ObDatumCmpFuncType cmp_func) const
+{
+  bool is_match = true;
+  ObDatum value;
+  if (VALID != state_ || OB_ISNULL(cmp_func)) {
+  } else if (datum.is_null()) {
+    is_match = has_null_;
+  } else if (in_set_count_ > 0) {
+    is_match = false;
+    for (int64_t i = 0; !is_match && i < in_set_count_; ++i) {
+      payload_to_datum(in_set_payloads_[i], value);
+      is_match = (0 == cmp_func(datum, value));
+    }
+  } else {
+    payload_to_datum(min_payload_, value);
+    if (cmp_func(datum, value) < 0) {
+      is_match = false;
+    } else {
+      payload_to_datum(max_payload_, value);
+      is_match = cmp_func(datum, value) <= 0;
+    }
+  }
+  return is_match;
+}
+
+bool ObJoinKeyRange::might_intersect(const ObObj &min, const ObObj &max) const
+{
+  bool is_match = true;
+  if (VALID != state_ || min.get_type() != min_.get_type() || max.get_type() != min_.get_type()) {
+  } else {
+    const ObCollationType cs_type = min_.get_collation_type();
+    if (ObObjCmpFuncs::compare_oper_nullsafe(max_, min, cs_type, CO_LT)
+        || ObObjCmpFuncs::compare_oper_nullsafe(min_, max, cs_type, CO_GT)) {
+      is_match = false;
+    } else if (in_set_count_ > 0) {
+      is_match = false;
+      for (int64_t i = 0; !is_match && i < in_set_count_; ++i) {
+        is_match = ObObjCmpFuncs::compare_oper_nullsafe(in_set_[i], min, cs_type, CO_GE)
+            && ObObjCmpFuncs::compare_oper_nullsafe(in_set_[i], max, cs_type, CO_LE);
+      }
+    }
+  }
+  return is_match;
+}
+
+OB_DEF_SERIALIZE(ObJoinKeyRange)
+{
+  int ret = OB_SUCCESS;
+  LST_DO_CODE(OB_UNIS_ENCODE,
+              state_,
+              has_null_,
+              in_set_count_,
+              min_,
+              max_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < in_set_count_; ++i) {
+    OB_UNIS_ENCODE(in_set_[i]);
+  }
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObJoinKeyRange)
+{
+  int ret = OB_SUCCESS;
+  LST_DO_CODE(OB_UNIS_DECODE,
+              state_,
+              has_null_,
+              in_set_count_,
+              min_,
+              max_);
+  if (OB_FAIL(ret)) {
+  } else if (OB_UNLIKELY(in_set_count_ > MAX_IN_SET_COUNT)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected in set count", K(ret), K(in_set_count_));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < in_set_count_; ++i) {
+    OB_UNIS_DECODE(in_set_[i]);
+  }
+  if (OB_SUCC(ret) && OB_FAIL(refresh_payloads())) {
+    LOG_WARN("fail to refresh payloads", K(ret));
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObJoinKeyRange)
+{
+  int64_t len = 0;
+  LST_DO_CODE(OB_UNIS_ADD_LEN,
+              state_,
+              has_null_,
+              in_set_count_,
+              min_,
+              max_);
+  for (int64_t i = 0; i < in_set_count_; ++i) {
+    OB_UNIS_ADD_LEN(in_set_[i]);
+  }
+  return len;
+}
+
+} // end namespace common
+} // end namespace oceanbase
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SHARE_DATUM_OB_JOIN_KEY_RANGE_H_
+#define OCEANBASE_SHARE_DATUM_OB_JOIN_KEY_RANGE_H_
+
+#include "common/object/ob_object.h"
+#include "share/datum/ob_datum.h"
+#include "share/datum/ob_datum_funcs.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+// Bounds of the single join key of the build side of a runtime join filter, and its
+// distinct values while there are no more than MAX_IN_SET_COUNT of them. Only kept for
+// keys of fixed length types, whose values need no deep copy. Probe rows and micro blocks
+// outside of them find no match.
+class ObJoinKeyRange
+{
+  OB_UNIS_VERSION(1);
+public:
+  enum State
+  {
+    EMPTY = 0,  // no value yet
+    VALID = 1,
+    INVALID = 2 // not tracked, sticky across merges
+  };
+  static const int64_t MAX_IN_SET_COUNT = 8;
+  ObJoinKeyRange() { reset(); }
+  ~ObJoinKeyRange() = default;
+  void reset();
+  void invalidate() { reset(); state_ = INVALID; }
+  static bool is_supported_type(const ObObjDatumMapType map_type);
+  int add(const ObObj &obj);
+  int merge(const ObJoinKeyRange &other);
+  bool is_valid() const { return VALID == state_; }
+  bool is_invalid() const { return INVALID == state_; }
+  bool has_null() const { return has_null_; }
+  // the values of the build side are all known
+  bool has_in_set() const { return in_set_count_ > 0; }
+  ObObjType get_type() const { return min_.get_type(); }
+  // whether a probe row of @datum may find a match, @cmp_func compares datums of the key type
+  bool might_contain(const ObDatum &datum, ObDatumCmpFuncType cmp_func) const;
+  // whether a non null value in [@min, @max] may find a match
+  bool might_intersect(const ObObj &min, const ObObj &max) const;
+  TO_STRING_KV(K_(state), K_(has_null), K_(in_set_count), K_(min), K_(max));
+private:
+  static int to_payload(const ObObj &obj, uint64_t &payload, uint32_t &payload_len);
+  void add_to_in_set(const ObObj &obj, const uint64_t payload);
+  int refresh_payloads();
+  OB_INLINE void payload_to_datum(const uint64_t &payload, ObDatum &datum) const
+  {
+    datum.ptr_ = reinterpret_cast<const char *>(&payload);
+    datum.pack_ = payload_len_;
+  }
+private:
+  int8_t state_;
+  bool has_null_;
+  // -1 once the build side has more distinct values than MAX_IN_SET_COUNT
+  int64_t in_set_count_;
+  ObObj min_;
+  ObObj max_;
+  ObObj in_set_[MAX_IN_SET_COUNT];
+  // datum payloads of the values above, made once when the values are added, merged or
+  // deserialized, so that probing compares datums without converting objs
+  uint32_t payload_len_;
+  uint64_t min_payload_;
+  uint64_t max_payload_;
+  uint64_t in_set_payloads_[MAX_IN_SET_COUNT];
+};
+
+} // end namespace common
+} // end namespace oceanbase
+
+#endif // OCEANBASE_SHARE_DATUM_OB_JOIN_KEY_RANGE_H_
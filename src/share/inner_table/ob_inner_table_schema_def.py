@@ -5777,6 +5777,8 @@ def_table_schema(
   ('total_hit_cnt', 'int', 'false'),
   ('total_miss_cnt', 'int', 'false'),
   ('hold_size', 'int', 'false'),
+  ('recent_hit_ratio', 'number:38:3', 'false'),
+  ('probation_put_cnt', 'int', 'false'),
   ],
   vtable_route_policy = 'distributed',
   partition_columns = ['svr_ip', 'svr_port'],
@@ -7963,7 +7965,8 @@ def_table_schema(
   ('type', 'int'),# 0 for ROW_LOCK
   ('lock_mode', 'int'), # 0 for write lock
   ('last_compact_cnt', 'int'),
-  ('total_update_cnt', 'int')
+  ('total_update_cnt', 'int'),
+  ('wait_queue_depth', 'int')
   ],
 
   partition_columns = ['svr_ip', 'svr_port'],
@@ -104,6 +104,45 @@ ObIOCategory oceanbase::common::get_io_category_enum(const char *category_name)
   return io_category;
 }
 
+/******************             IOChannelType              **********************/
+static const char *aio_channel_type_name = "AIO";
+static const char *io_uring_channel_type_name = "IO_URING";
+static const char *io_uring_sqpoll_channel_type_name = "IO_URING_SQPOLL";
+
+const char *oceanbase::common::get_io_channel_type_name(const ObIOChannelType type)
+{
+  const char *ret_name = "UNKNOWN";
+  switch (type) {
+    case ObIOChannelType::AIO:
+      ret_name = aio_channel_type_name;
+      break;
+    case ObIOChannelType::IO_URING:
+      ret_name = io_uring_channel_type_name;
+      break;
+    case ObIOChannelType::IO_URING_SQPOLL:
+      ret_name = io_uring_sqpoll_channel_type_name;
+      break;
+    default:
+      break;
+  }
+  return ret_name;
+}
+
+ObIOChannelType oceanbase::common::get_io_channel_type_enum(const char *type_name)
+{
+  ObIOChannelType type = ObIOChannelType::MAX_TYPE;
+  if (OB_ISNULL(type_name)) {
+    // do nothing
+  } else if (0 == strcasecmp(type_name, aio_channel_type_name)) {
+    type = ObIOChannelType::AIO;
+  } else if (0 == strcasecmp(type_name, io_uring_channel_type_name)) {
+    type = ObIOChannelType::IO_URING;
+  } else if (0 == strcasecmp(type_name, io_uring_sqpoll_channel_type_name)) {
+    type = ObIOChannelType::IO_URING_SQPOLL;
+  }
+  return type;
+}
+
 /******************             IOFlag              **********************/
 ObIOFlag::ObIOFlag()
   : flag_(0)
@@ -52,6 +52,18 @@ enum class ObIOCategory : uint8_t
 const char *get_io_category_name(ObIOCategory category);
 ObIOCategory get_io_category_enum(const char *category_name);
 
+// how async io requests of a device are delivered to the kernel
+enum class ObIOChannelType : uint8_t
+{
+  AIO = 0,             // libaio, one iocb per io_submit
+  IO_URING = 1,        // io_uring, batched submission
+  IO_URING_SQPOLL = 2, // io_uring with kernel submission queue polling thread
+  MAX_TYPE
+};
+
+const char *get_io_channel_type_name(const ObIOChannelType type);
+ObIOChannelType get_io_channel_type_enum(const char *type_name);
+
 struct ObIOFlag final
 {
 public:
@@ -107,6 +107,31 @@ private:
   ObIAllocator &allocator_;
 };
 
+// pin the macro pool of tenant in io_uring channels of all devices
+struct RegisterFixedBufferFn
+{
+public:
+  RegisterFixedBufferFn(char *buf, const int64_t buf_size, const bool is_register)
+    : buf_(buf), buf_size_(buf_size), is_register_(is_register) {}
+  int operator () (oceanbase::common::hash::HashMapPair<int64_t, ObDeviceChannel *> &entry) {
+    int ret = OB_SUCCESS;
+    if (nullptr == entry.second || ObIOChannelType::AIO == entry.second->get_channel_type()) {
+      // do nothing
+    } else if (is_register_) {
+      if (OB_FAIL(entry.second->register_fixed_buffer(buf_, buf_size_))) {
+        LOG_WARN("register fixed buffer failed", K(ret), KP(buf_), K(buf_size_));
+      }
+    } else if (OB_FAIL(entry.second->unregister_fixed_buffer(buf_))) {
+      LOG_WARN("unregister fixed buffer failed", K(ret), KP(buf_));
+    }
+    return OB_SUCCESS; // fixed buffer is an optimization, go on with other devices
+  }
+private:
+  char *buf_;
+  int64_t buf_size_;
+  bool is_register_;
+};
+
 void ObIOManager::destroy()
 {
   stop();
@@ -361,7 +386,8 @@ int ObIOManager::reset_device_health()
 int ObIOManager::add_device_channel(ObIODevice *device_handle,
                                     const int64_t async_channel_count,
                                     const int64_t sync_channel_count,
-                                    const int64_t max_io_depth)
+                                    const int64_t max_io_depth,
+                                    const ObIOChannelType channel_type)
 {
   int ret = OB_SUCCESS;
   ObDeviceChannel *device_channel = nullptr;
@@ -380,12 +406,14 @@ int ObIOManager::add_device_channel(ObIODevice *device_handle,
                                           async_channel_count,
                                           sync_channel_count,
                                           max_io_depth,
-                                          allocator_))) {
-    LOG_WARN("init device_channel failed", K(ret), K(async_channel_count), K(sync_channel_count));
+                                          allocator_,
+                                          channel_type))) {
+    LOG_WARN("init device_channel failed", K(ret), K(async_channel_count), K(sync_channel_count),
+        "channel_type", get_io_channel_type_name(channel_type));
   } else if (OB_FAIL(channel_map_.set_refactored(reinterpret_cast<int64_t>(device_handle), device_channel))) {
     LOG_WARN("set channel map failed", K(ret), KP(device_handle));
   } else {
-    LOG_INFO("add io device channel succ", KP(device_handle));
+    LOG_INFO("add io device channel succ", KP(device_handle), KPC(device_channel));
     device_channel = nullptr;
   }
   if (OB_UNLIKELY(nullptr != device_channel)) {
@@ -458,6 +486,10 @@ int ObIOManager::add_tenant_io_manager(const uint64_t tenant_id, const ObTenantI
       LOG_WARN("put into tenant map failed", K(ret), K(tenant_id), KP(tenant_io_mgr));
     } else {
       LOG_INFO("add tenant io manager", K(tenant_id), KPC(tenant_io_mgr));
+      RegisterFixedBufferFn register_fn(tenant_io_mgr->get_io_allocator().get_macro_pool_begin(),
+                                        tenant_io_mgr->get_io_allocator().get_macro_pool_size(),
+                                        true/*is_register*/);
+      channel_map_.foreach_refactored(register_fn);
       tenant_io_mgr = nullptr;
     }
   }
@@ -493,6 +525,10 @@ int ObIOManager::remove_tenant_io_manager(const uint64_t tenant_id)
     }
   }
   if (OB_SUCC(ret) && nullptr != tenant_io_mgr) {
+    RegisterFixedBufferFn unregister_fn(tenant_io_mgr->get_io_allocator().get_macro_pool_begin(),
+                                        tenant_io_mgr->get_io_allocator().get_macro_pool_size(),
+                                        false/*is_register*/);
+    channel_map_.foreach_refactored(unregister_fn);
     tenant_io_mgr->stop();
     tenant_io_mgr->dec_ref();
     if (OB_FAIL(io_scheduler_.remove_tenant_map(tenant_id))) {
@@ -61,7 +61,8 @@ public:
   int add_device_channel(ObIODevice *device_handle,
                          const int64_t async_channel_count,
                          const int64_t sync_channel_count,
-                         const int64_t max_io_depth);
+                         const int64_t max_io_depth,
+                         const ObIOChannelType channel_type = ObIOChannelType::AIO);
   int remove_device_channel(ObIODevice *device_handle);
   int get_device_channel(const ObIODevice *device_handle, ObDeviceChannel *&device_channel);
 
@@ -113,6 +114,7 @@ public:
   int enqueue_callback(ObIORequest &req);
   ObIOClock *get_io_clock() { return io_clock_; }
   const ObIOUsage &get_io_usage() { return io_usage_; }
+  const ObIOAllocator &get_io_allocator() const { return io_allocator_; }
   int update_io_config(const ObTenantIOConfig &io_config);
   int alloc_io_request(ObIAllocator &allocator,const int64_t callback_size,  ObIORequest *&req);
   int alloc_io_clock(ObIAllocator &allocator, ObIOClock *&io_clock);
@@ -1322,6 +1322,137 @@ void ObIOChannel::destroy_thread()
   }
 }
 
+void ObIOChannel::on_io_event(ObIORequest &req, const int system_errno, const int64_t complete_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_LIKELY(0 == system_errno)) { // io succ
+    if (complete_size == req.io_size_) { // full complete
+      LOG_DEBUG("Success to get io event", K(req), K(complete_size));
+      if (OB_FAIL(on_full_return(req))) {
+        LOG_WARN("process full return io request failed", K(ret), K(req));
+      }
+    } else if (complete_size >= 0 && complete_size < req.io_size_) { // partial complete
+      LOG_WARN("io request partial finished", K(req), K(complete_size));
+      if (0 == complete_size || !is_io_aligned(complete_size)) { // reach end of file
+        if (OB_FAIL(on_partial_return(req, complete_size))) {
+          LOG_WARN("process partial return io request failed", K(ret), K(complete_size), K(req));
+        }
+      } else {
+        if (OB_FAIL(on_partial_retry(req, complete_size))) { // partial retry
+          LOG_WARN("partial retry io request failed", K(ret), K(complete_size), K(req));
+        }
+      }
+    } else { // invalid complete size
+      LOG_WARN("invalid complete size", K(req), K(complete_size));
+      if (OB_FAIL(on_failed(req, ObIORetCode(OB_IO_ERROR, static_cast<int>(complete_size))))) { // use complete_size as errno here
+        LOG_WARN("process failed io request failed", K(ret), K(req));
+      }
+    }
+  } else { // io failed
+    LOG_ERROR("io request failed", K(req), K(system_errno), K(complete_size));
+    const bool need_retry = false; // wait io device to support retry policy
+    if (need_retry) {
+      if (OB_FAIL(on_full_retry(req))) {
+        LOG_WARN("retry io request failed", K(ret), K(system_errno), K(req));
+      }
+    } else {
+      if (OB_FAIL(on_failed(req, ObIORetCode(OB_IO_ERROR, system_errno)))) {
+        LOG_WARN("process failed io request failed", K(ret), K(req));
+      }
+    }
+  }
+}
+
+int ObIOChannel::on_full_return(ObIORequest &req)
+{
+  int ret = OB_SUCCESS;
+  req.complete_size_ = req.io_size_;
+  if (!req.is_canceled_ && req.can_callback()) {
+    if (OB_FAIL(req.tenant_io_mgr_.get_ptr()->enqueue_callback(req))) {
+      LOG_WARN("push io request into callback queue failed", K(ret), K(req));
+      req.finish(ret);
+    }
+  } else {
+    req.finish(OB_SUCCESS);
+  }
+  return ret;
+}
+
+int ObIOChannel::on_partial_return(ObIORequest &req, const int64_t complete_size)
+{
+  int ret = OB_SUCCESS;
+  // partial return ignore callback
+  req.complete_size_ += complete_size;
+  if (req.get_data_size() >= req.io_info_.size_) {
+    // in case of aligned_size > file_size > user_need_size
+    if (!req.is_canceled_ && req.can_callback()) {
+      // the callback is not aware of complete size, not supported for now
+      req.finish(OB_NOT_SUPPORTED);
+    } else {
+      req.finish(OB_SUCCESS);
+    }
+  } else {
+    req.finish(OB_DATA_OUT_OF_RANGE);
+  }
+  return ret;
+}
+
+int ObIOChannel::on_partial_retry(ObIORequest &req, const int64_t complete_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_io_aligned(complete_size))) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("complete size not aligned", K(ret), K(complete_size));
+  } else {
+    req.complete_size_ += complete_size;
+    req.io_buf_ += complete_size;
+    req.io_offset_ += complete_size;
+    req.io_size_ -= complete_size;
+    if (OB_FAIL(req.prepare())) {
+      LOG_WARN("prepare io request failed", K(ret), K(req));
+    } else if (OB_FAIL(submit(req))) {
+      LOG_WARN("submit io request failed", K(ret), K(req));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = on_failed(req, ObIORetCode(ret)))) {
+      LOG_WARN("deal with failed request failed", K(tmp_ret), K(ret), K(req));
+    }
+  }
+  return ret;
+}
+
+int ObIOChannel::on_full_retry(ObIORequest &req)
+{
+  int ret = OB_SUCCESS;
+  static const int64_t MAX_RETRY_COUNT = 10;
+  if (++req.retry_count_ > MAX_RETRY_COUNT) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("retry too many times", K(ret), K(req));
+  } else if (FALSE_IT(req.complete_size_ = 0)) {
+  } else if (OB_FAIL(req.prepare())) {
+    LOG_WARN("prepare io request failed", K(ret), K(req));
+  } else if (OB_FAIL(submit(req))) {
+    LOG_WARN("submit io request failed", K(ret));
+  }
+  if (OB_FAIL(ret)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = on_failed(req, ObIORetCode(ret)))) {
+      LOG_WARN("deal with failed request failed", K(tmp_ret), K(ret), K(req));
+    }
+  }
+  return ret;
+}
+
+int ObIOChannel::on_failed(ObIORequest &req, const ObIORetCode &ret_code)
+{
+  int ret = OB_SUCCESS;
+  req.finish(ret_code);
+  return ret;
+}
+
+
 /******************             AsyncIOChannel              **********************/
 ObAsyncIOChannel::ObAsyncIOChannel()
   : io_context_(nullptr),
@@ -1512,139 +1643,463 @@ void ObAsyncIOChannel::get_events()
         req->dec_ref("os_dec"); // ref for file system
         req->time_log_.return_ts_ = io_return_time;
         ATOMIC_FAS(&device_channel_->used_io_depth_, req->io_size_);
-        const int system_errno = io_events_->get_ith_ret_code(i);
-        const int complete_size = io_events_->get_ith_ret_bytes(i);
-        if (OB_LIKELY(0 == system_errno)) { // io succ
-          if (complete_size == req->io_size_) { // full complete
-            LOG_DEBUG("Success to get io event", K(*req), K(complete_size));
-            if (OB_FAIL(on_full_return(*req))) {
-              LOG_WARN("process full return io request failed", K(ret), K(*req));
-            }
-          } else if (complete_size >= 0 && complete_size < req->io_size_) { // partial complete
-            LOG_WARN("io request partial finished", K(*req), K(complete_size));
-            if (0 == complete_size || !is_io_aligned(complete_size)) { // reach end of file
-              if (OB_FAIL(on_partial_return(*req, complete_size))) {
-                LOG_WARN("process partial return io request failed", K(ret), K(complete_size), K(*req));
-              }
-            } else {
-              if (OB_FAIL(on_partial_retry(*req, complete_size))) { // partial retry
-                LOG_WARN("partial retry io request failed", K(ret), K(complete_size), K(*req));
-              }
-            }
-          } else { // invalid complete size
-            LOG_WARN("invalid complete size", K(*req), K(complete_size));
-            if (OB_FAIL(on_failed(*req, ObIORetCode(OB_IO_ERROR, complete_size)))) { // use complete_size as errno here
-              LOG_WARN("process failed io request failed", K(ret), K(*req));
-            }
-          }
-        } else { // io failed
-          LOG_ERROR("io request failed", K(*req), K(system_errno), K(complete_size));
-          const bool need_retry = false; // wait io device to support retry policy
-          if (need_retry) {
-            if (OB_FAIL(on_full_retry(*req))) {
-              LOG_WARN("retry io request failed", K(ret), K(system_errno), K(*req));
-            }
-          } else {
-            if (OB_FAIL(on_failed(*req, ObIORetCode(OB_IO_ERROR, system_errno)))) {
-              LOG_WARN("process failed io request failed", K(ret), K(*req));
-            }
-          }
-        }
+        on_io_event(*req, io_events_->get_ith_ret_code(i), io_events_->get_ith_ret_bytes(i));
       }
       ATOMIC_DEC(&submit_count_);
     }
   }
 }
 
-int ObAsyncIOChannel::on_full_return(ObIORequest &req)
+/******************             IOUringChannel              **********************/
+ObIOUringChannel::ObIOUringChannel()
+  : ring_(),
+    pending_queue_(),
+    submit_lock_(),
+    submit_count_(0),
+    fixed_buffer_cnt_(0),
+    buffer_set_lock_(),
+    buffer_set_cnt_(0)
+{
+  MEMSET(fixed_buffers_, 0, sizeof(fixed_buffers_));
+  MEMSET(buffer_set_, 0, sizeof(buffer_set_));
+  MEMSET(cqes_, 0, sizeof(cqes_));
+  MEMSET(reclaimed_user_datas_, 0, sizeof(reclaimed_user_datas_));
+}
+
+ObIOUringChannel::~ObIOUringChannel()
+{
+  destroy();
+}
+
+int ObIOUringChannel::init(ObDeviceChannel *device_channel, const bool use_sq_poll)
 {
   int ret = OB_SUCCESS;
-  req.complete_size_ = req.io_size_;
-  if (!req.is_canceled_ && req.can_callback()) {
-    if (OB_FAIL(req.tenant_io_mgr_.get_ptr()->enqueue_callback(req))) {
-      LOG_WARN("push io request into callback queue failed", K(ret), K(req));
-      req.finish(ret);
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret), K(is_inited_));
+  } else if (OB_FAIL(ring_.init(MAX_URING_EVENT_CNT, use_sq_poll, SQ_THREAD_IDLE_MS))) {
+    LOG_WARN("init io_uring failed", K(ret), K(use_sq_poll));
+  } else if (OB_FAIL(base_init(device_channel))) {
+    LOG_WARN("base init failed", K(ret), KP(device_channel));
+  } else if (OB_FAIL(pending_queue_.init(MAX_URING_EVENT_CNT * 2))) {
+    LOG_WARN("init pending queue failed", K(ret));
+  } else {
+    submit_count_ = 0;
+    is_inited_ = true;
+  }
+  if (OB_UNLIKELY(!is_inited_)) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObIOUringChannel::stop()
+{
+  if (tg_id_ >= 0) {
+    TG_STOP(tg_id_);
+    int tmp_ret = OB_SUCCESS;
+    if (OB_UNLIKELY(OB_SUCCESS != (tmp_ret = wakeup_getevents()))) {
+      LOG_WARN("wakeup get_events thread failed", K(tmp_ret));
     }
+  }
+}
+
+void ObIOUringChannel::wait()
+{
+  if (tg_id_ >= 0) {
+    TG_WAIT(tg_id_);
+  }
+}
+
+void ObIOUringChannel::destroy()
+{
+  // wait flying request
+  const int64_t max_wait_ts = ObTimeUtility::fast_current_time() + 1000L * 1000L * 30L; // 30s
+  while (submit_count_ > 0 && ObTimeUtility::fast_current_time() < max_wait_ts) {
+    ob_usleep(1000L * 10L);
+  }
+  if (submit_count_ > 0) {
+    LOG_WARN("some request have not returned from file system", K(submit_count_));
+  }
+  destroy_thread();
+  ring_.destroy();
+  pending_queue_.destroy();
+  fixed_buffer_cnt_ = 0;
+  buffer_set_cnt_ = 0;
+  submit_count_ = 0;
+  device_handle_ = nullptr;
+  is_inited_ = false;
+}
+
+void ObIOUringChannel::run1()
+{
+  int ret = OB_SUCCESS;
+  const int64_t thread_id = get_thread_idx();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
   } else {
-    req.finish(OB_SUCCESS);
+    set_thread_name("IO_URING", thread_id);
+    LOG_INFO("io_uring get_events thread started", K(thread_id), K(tg_id_));
+    while (!has_set_stop()) {
+      get_events();
+    }
+    LOG_INFO("io_uring get_events thread stopped", K(thread_id), K(tg_id_));
+  }
+}
+
+int ObIOUringChannel::submit(ObIORequest &req)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(device_handle_ != req.io_info_.fd_.device_handle_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(req), KP(device_handle_));
+  } else if (submit_count_ >= MAX_URING_EVENT_CNT) {
+    ret = OB_EAGAIN;
+    if (REACH_TIME_INTERVAL(1000000L)) {
+      LOG_WARN("too many io requests", K(ret), K(submit_count_));
+    }
+  } else if (device_channel_->used_io_depth_ > device_channel_->max_io_depth_) {
+    ret = OB_EAGAIN;
+    LOG_DEBUG("reach max io depth", K(ret), K(device_channel_->used_io_depth_), K(device_channel_->max_io_depth_));
+  } else {
+    ATOMIC_INC(&submit_count_);
+    ATOMIC_FAA(&device_channel_->used_io_depth_, get_io_depth(req.io_size_));
+    req.channel_ = this;
+    req.time_log_.submit_ts_ = ObTimeUtility::fast_current_time();
+    req.inc_ref("os_inc"); // ref for file system
+    if (OB_FAIL(pending_queue_.push(&req))) {
+      ATOMIC_DEC(&submit_count_);
+      ATOMIC_FAS(&device_channel_->used_io_depth_, get_io_depth(req.io_size_));
+      req.dec_ref("os_dec"); // ref for file system
+      if (OB_SIZE_OVERFLOW == ret) {
+        ret = OB_EAGAIN;
+      } else {
+        LOG_WARN("push pending queue failed", K(ret), K(submit_count_), K(req));
+      }
+    } else {
+      try_flush();
+    }
   }
   return ret;
 }
 
-int ObAsyncIOChannel::on_partial_return(ObIORequest &req, const int64_t complete_size)
+void ObIOUringChannel::cancel(ObIORequest &req)
+{
+  // same as libaio, the flying request is not recalled from file system and returns normally
+  LOG_DEBUG("cancel is not supported on io_uring channel", K(req));
+}
+
+int64_t ObIOUringChannel::get_queue_count() const
+{
+  return submit_count_;
+}
+
+void ObIOUringChannel::try_flush()
 {
   int ret = OB_SUCCESS;
-  // partial return ignore callback
-  req.complete_size_ += complete_size;
-  if (req.get_data_size() >= req.io_info_.size_) {
-    // in case of aligned_size > file_size > user_need_size
-    if (!req.is_canceled_ && req.can_callback()) {
-      // the callback is not aware of complete size, not supported for now
-      req.finish(OB_NOT_SUPPORTED);
+  // requests staged while the lock is held are flushed by the holder in its next round.
+  // sqes left in the ring by -EAGAIN of last enter are entered again even if nothing is staged.
+  bool need_flush = pending_queue_.get_total() > 0 || ring_.has_unsubmitted();
+  while (need_flush && OB_SUCC(submit_lock_.trylock())) {
+    if (OB_FAIL(flush())) {
+      LOG_WARN("flush pending requests failed", K(ret));
+    }
+    submit_lock_.unlock();
+    need_flush = OB_SUCC(ret) && pending_queue_.get_total() > 0;
+  }
+}
+
+int ObIOUringChannel::flush()
+{
+  int ret = OB_SUCCESS;
+  int64_t prepared_cnt = 0;
+  ObIOUringSqe *sqe = nullptr;
+  ObIORequest *req = nullptr;
+  while (OB_SUCC(ret) && pending_queue_.get_total() > 0) {
+    if (OB_ISNULL(sqe = ring_.get_sqe())) {
+      ret = OB_EAGAIN; // submission queue is full, left requests are flushed after completion
+    } else if (OB_FAIL(pending_queue_.pop(req))) {
+      // the reserved sqe is left as a nop
+      if (OB_ENTRY_NOT_EXIST == ret) {
+        ret = OB_SUCCESS;
+        break;
+      }
+      LOG_WARN("pop pending queue failed", K(ret));
+    } else if (OB_ISNULL(req)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("request is null", K(ret));
     } else {
-      req.finish(OB_SUCCESS);
+      int tmp_ret = OB_SUCCESS;
+      ++prepared_cnt;
+      if (OB_UNLIKELY(OB_SUCCESS != (tmp_ret = prepare_sqe(*req, *sqe)))) {
+        LOG_WARN("prepare sqe failed", K(tmp_ret), KPC(req));
+        MEMSET(sqe, 0, sizeof(ObIOUringSqe)); // turn into nop
+        RequestHolder holder(req);
+        req->dec_ref("os_dec"); // ref for file system
+        ATOMIC_FAS(&device_channel_->used_io_depth_, get_io_depth(req->io_size_));
+        ATOMIC_DEC(&submit_count_);
+        on_failed(*req, ObIORetCode(tmp_ret));
+      }
+    }
+  }
+  if (OB_EAGAIN == ret) {
+    ret = OB_SUCCESS;
+  }
+  if (OB_SUCC(ret) && (prepared_cnt > 0 || ring_.has_unsubmitted())) {
+    if (OB_FAIL(submit_ring())) {
+      LOG_WARN("submit io_uring batch failed", K(ret), K(prepared_cnt));
+    } else {
+      LOG_DEBUG("Success to submit io_uring batch", K(prepared_cnt), K(submit_count_));
     }
-  } else {
-    req.finish(OB_DATA_OUT_OF_RANGE);
   }
   return ret;
 }
 
-int ObAsyncIOChannel::on_partial_retry(ObIORequest &req, const int64_t complete_size)
+// enter the published sqes into kernel, with submit_lock_ held
+int ObIOUringChannel::submit_ring()
 {
   int ret = OB_SUCCESS;
-  if (OB_UNLIKELY(!is_io_aligned(complete_size))) {
-    ret = OB_ERR_SYS;
-    LOG_WARN("complete size not aligned", K(ret), K(complete_size));
+  int64_t submitted_cnt = 0;
+  if (OB_FAIL(ring_.submit(submitted_cnt))) {
+    if (OB_EAGAIN == ret) {
+      // sqes stay in the ring and are entered again with the next batch, or by get_events
+      // when there is no next batch
+      ret = OB_SUCCESS;
+    } else if (ring_.is_sq_poll()) {
+      // the sq thread may consume the published sqes at any time, they can not be taken back.
+      // the wakeup is retried by the next submission and before get_events waits.
+      LOG_ERROR("wakeup io_uring sq thread failed", K(ret), K(ring_));
+    } else {
+      LOG_ERROR("io_uring submit failed, fail the unsubmitted requests", K(ret), K(ring_));
+      fail_unsubmitted(ret);
+    }
+  }
+  return ret;
+}
+
+void ObIOUringChannel::fail_unsubmitted(const int ret_code)
+{
+  const int64_t cnt = ring_.reclaim_unsubmitted(reclaimed_user_datas_, MAX_URING_EVENT_CNT);
+  ObIORequest *req = nullptr;
+  for (int64_t i = 0; i < cnt; ++i) {
+    if (0 == reclaimed_user_datas_[i]) {
+      // wakeup nop or failed to prepare
+    } else if (FALSE_IT(req = reinterpret_cast<ObIORequest *>(reclaimed_user_datas_[i]))) {
+    } else {
+      RequestHolder holder(req);
+      req->dec_ref("os_dec"); // ref for file system
+      ATOMIC_FAS(&device_channel_->used_io_depth_, get_io_depth(req->io_size_));
+      ATOMIC_DEC(&submit_count_);
+      on_failed(*req, ObIORetCode(ret_code));
+    }
+  }
+}
+
+int ObIOUringChannel::prepare_sqe(ObIORequest &req, ObIOUringSqe &sqe)
+{
+  int ret = OB_SUCCESS;
+  int64_t sys_fd = -1;
+  int64_t sys_offset = -1;
+  int64_t buf_index = -1;
+  if (OB_FAIL(device_handle_->get_sys_io_target(req.io_info_.fd_, req.io_offset_, sys_fd, sys_offset))) {
+    LOG_WARN("get sys io target failed", K(ret), K(req));
+  } else if (OB_UNLIKELY(!req.get_flag().is_read() && !req.get_flag().is_write())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("not supported io mode", K(ret), K(req));
   } else {
-    req.complete_size_ += complete_size;
-    req.io_buf_ += complete_size;
-    req.io_offset_ += complete_size;
-    req.io_size_ -= complete_size;
-    if (OB_FAIL(req.prepare())) {
-      LOG_WARN("prepare io request failed", K(ret), K(req));
-    } else if (OB_FAIL(submit(req))) {
-      LOG_WARN("submit io request failed", K(ret), K(req));
+    const char *io_end = req.io_buf_ + req.io_size_;
+    for (int64_t i = 0; buf_index < 0 && i < fixed_buffer_cnt_; ++i) {
+      const char *begin = static_cast<const char *>(fixed_buffers_[i].iov_base);
+      if (begin <= req.io_buf_ && io_end <= begin + fixed_buffers_[i].iov_len) {
+        buf_index = i;
+      }
     }
+    const bool is_read = req.get_flag().is_read();
+    if (buf_index >= 0) {
+      sqe.opcode_ = is_read ? IO_URING_OP_READ_FIXED : IO_URING_OP_WRITE_FIXED;
+      sqe.buf_index_ = static_cast<uint16_t>(buf_index);
+    } else {
+      sqe.opcode_ = is_read ? IO_URING_OP_READ : IO_URING_OP_WRITE;
+    }
+    sqe.fd_ = static_cast<int32_t>(sys_fd);
+    sqe.off_ = static_cast<uint64_t>(sys_offset);
+    sqe.addr_ = reinterpret_cast<uint64_t>(req.io_buf_);
+    sqe.len_ = static_cast<uint32_t>(req.io_size_);
+    sqe.user_data_ = reinterpret_cast<uint64_t>(&req);
   }
-  if (OB_FAIL(ret)) {
-    int tmp_ret = OB_SUCCESS;
-    if (OB_SUCCESS != (tmp_ret = on_failed(req, ObIORetCode(ret)))) {
-      LOG_WARN("deal with failed request failed", K(tmp_ret), K(ret), K(req));
+  return ret;
+}
+
+void ObIOUringChannel::get_events()
+{
+  int ret = OB_SUCCESS;
+  int64_t cqe_cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (ring_.has_unsubmitted() && FALSE_IT(try_flush())) {
+  } else if (ring_.has_unsubmitted() && !ring_.has_cqe()) {
+    // enter failed with -EAGAIN again, the requests are not in kernel and waiting for their
+    // completions may block forever, retry the enter later
+    ob_usleep(RESUBMIT_INTERVAL_US);
+  } else if (OB_FAIL(ring_.wait_cqe())) {
+    if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      LOG_ERROR("io_uring get_events failed", K(ret));
+    }
+    ob_usleep(1000L); // avoid busy loop
+  } else if ((cqe_cnt = ring_.peek_cqes(cqes_, MAX_URING_EVENT_CNT)) > 0) {
+    const int64_t io_return_time = ObTimeUtility::fast_current_time();
+    ObIORequest *req = nullptr;
+    for (int64_t i = 0; i < cqe_cnt; ++i) { // ignore ret
+      const uint64_t user_data = cqes_[i]->user_data_;
+      const int32_t res = cqes_[i]->res_;
+      if (0 == user_data) {
+        // wakeup nop
+      } else if (FALSE_IT(req = reinterpret_cast<ObIORequest *>(user_data))) {
+      } else {
+        RequestHolder holder(req);
+        req->dec_ref("os_dec"); // ref for file system
+        req->time_log_.return_ts_ = io_return_time;
+        ATOMIC_FAS(&device_channel_->used_io_depth_, get_io_depth(req->io_size_));
+        ATOMIC_DEC(&submit_count_);
+        on_io_event(*req, res < 0 ? -res : 0, res < 0 ? 0 : res);
+      }
     }
+    ring_.advance_cq(cqe_cnt);
+    // requests staged when the submission queue was full
+    try_flush();
+  }
+}
+
+int ObIOUringChannel::wakeup_getevents()
+{
+  int ret = OB_SUCCESS;
+  ObSpinLockGuard guard(submit_lock_);
+  if (OB_UNLIKELY(!ring_.is_inited())) {
+    // do nothing
+  } else if (OB_ISNULL(ring_.get_sqe())) {
+    ret = OB_EAGAIN;
+    LOG_WARN("submission queue is full", K(ret), K(ring_));
+  } else if (OB_FAIL(submit_ring())) { // nop with zero user data
+    LOG_WARN("submit nop failed", K(ret), K(ring_));
   }
   return ret;
 }
 
-int ObAsyncIOChannel::on_full_retry(ObIORequest &req)
+int ObIOUringChannel::register_fixed_buffer(char *buf, const int64_t buf_size)
 {
   int ret = OB_SUCCESS;
-  static const int64_t MAX_RETRY_COUNT = 10;
-  if (++req.retry_count_ > MAX_RETRY_COUNT) {
-    ret = OB_IO_ERROR;
-    LOG_WARN("retry too many times", K(ret), K(req));
-  } else if (FALSE_IT(req.complete_size_ = 0)) {
-  } else if (OB_FAIL(req.prepare())) {
-    LOG_WARN("prepare io request failed", K(ret), K(req));
-  } else if (OB_FAIL(submit(req))) {
-    LOG_WARN("submit io request failed", K(ret));
+  lib::ObMutexGuard guard(buffer_set_lock_);
+  bool exist = false;
+  for (int64_t i = 0; !exist && i < buffer_set_cnt_; ++i) {
+    exist = buffer_set_[i].iov_base == buf && static_cast<int64_t>(buffer_set_[i].iov_len) == buf_size;
   }
-  if (OB_FAIL(ret)) {
-    int tmp_ret = OB_SUCCESS;
-    if (OB_SUCCESS != (tmp_ret = on_failed(req, ObIORetCode(ret)))) {
-      LOG_WARN("deal with failed request failed", K(tmp_ret), K(ret), K(req));
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(nullptr == buf || buf_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_size));
+  } else if (exist) {
+    // the set does not change
+  } else if (OB_UNLIKELY(buffer_set_cnt_ >= MAX_FIXED_BUFFER_CNT)) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("too many fixed buffers", K(ret), K(buffer_set_cnt_));
+  } else {
+    buffer_set_[buffer_set_cnt_].iov_base = buf;
+    buffer_set_[buffer_set_cnt_].iov_len = buf_size;
+    ++buffer_set_cnt_;
+    if (OB_FAIL(refresh_fixed_buffers())) {
+      LOG_WARN("refresh fixed buffers failed", K(ret));
     }
   }
   return ret;
 }
 
-int ObAsyncIOChannel::on_failed(ObIORequest &req, const ObIORetCode &ret_code)
+int ObIOUringChannel::unregister_fixed_buffer(char *buf)
 {
   int ret = OB_SUCCESS;
-  req.finish(ret_code);
+  lib::ObMutexGuard guard(buffer_set_lock_);
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else {
+    bool found = false;
+    for (int64_t i = 0; i < buffer_set_cnt_; ++i) {
+      if (found) {
+        buffer_set_[i - 1] = buffer_set_[i];
+      } else if (buffer_set_[i].iov_base == buf) {
+        found = true;
+      }
+    }
+    if (found) {
+      --buffer_set_cnt_;
+      if (OB_FAIL(refresh_fixed_buffers())) {
+        LOG_WARN("refresh fixed buffers failed", K(ret));
+      }
+    }
+  }
   return ret;
 }
 
+// register buffer_set_ in kernel, with buffer_set_lock_ held.
+// submitters only stop using fixed buffer io during the registration, they are not blocked by it.
+int ObIOUringChannel::refresh_fixed_buffers()
+{
+  int ret = OB_SUCCESS;
+  uint32_t sqe_tail = 0;
+  {
+    ObSpinLockGuard guard(submit_lock_);
+    fixed_buffer_cnt_ = 0;
+    sqe_tail = ring_.get_sqe_tail();
+  }
+  // buf_index of sqes prepared with the old table must be resolved by kernel before the table
+  // is replaced, the kernel waits the flying ones itself when unregistering.
+  if (OB_FAIL(wait_sqes_consumed(sqe_tail))) {
+    LOG_WARN("wait sqes consumed failed, fixed buffer io disabled", K(ret), K(ring_));
+  } else if (OB_FAIL(ring_.unregister_buffers())) {
+    LOG_WARN("unregister fixed buffers failed", K(ret));
+  } else if (0 == buffer_set_cnt_) {
+    // do nothing
+  } else if (OB_FAIL(ring_.register_buffers(buffer_set_, buffer_set_cnt_))) {
+    // fallback to normal read/write, usually limited by RLIMIT_MEMLOCK
+    LOG_WARN("register fixed buffers failed, fixed buffer io disabled", K(ret), K(buffer_set_cnt_));
+    ret = OB_SUCCESS;
+  } else {
+    ObSpinLockGuard guard(submit_lock_);
+    MEMCPY(fixed_buffers_, buffer_set_, sizeof(buffer_set_[0]) * buffer_set_cnt_);
+    fixed_buffer_cnt_ = buffer_set_cnt_;
+  }
+  return ret;
+}
+
+int ObIOUringChannel::wait_sqes_consumed(const uint32_t sqe_tail)
+{
+  int ret = OB_SUCCESS;
+  const int64_t timeout_ts = ObTimeUtility::fast_current_time() + WAIT_SQES_CONSUMED_TIMEOUT_US;
+  while (OB_SUCC(ret) && !ring_.is_consumed(sqe_tail)) {
+    if (ObTimeUtility::fast_current_time() > timeout_ts) {
+      ret = OB_TIMEOUT;
+      LOG_WARN("wait sqes consumed timeout", K(ret), K(sqe_tail), K(ring_));
+    } else {
+      {
+        // sqes left by OB_EAGAIN are entered again
+        ObSpinLockGuard guard(submit_lock_);
+        if (OB_FAIL(submit_ring())) {
+          LOG_WARN("submit io_uring failed", K(ret));
+        }
+      }
+      if (OB_SUCC(ret) && !ring_.is_consumed(sqe_tail)) {
+        ob_usleep(1000L);
+      }
+    }
+  }
+  return ret;
+}
 
 /******************             SyncIOChannel              **********************/
 ObSyncIOChannel::ObSyncIOChannel()
@@ -1806,6 +2261,7 @@ int ObSyncIOChannel::do_sync_io(ObIORequest &req)
 /******************             DeviceChannel              **********************/
 ObDeviceChannel::ObDeviceChannel()
   : is_inited_(false),
+    channel_type_(ObIOChannelType::AIO),
     allocator_(nullptr),
     device_handle_(nullptr),
     used_io_depth_(0),
@@ -1823,7 +2279,8 @@ int ObDeviceChannel::init(ObIODevice *device_handle,
                           const int64_t async_channel_count,
                           const int64_t sync_channel_count,
                           const int64_t max_io_depth,
-                          ObIAllocator &allocator)
+                          ObIAllocator &allocator,
+                          const ObIOChannelType channel_type)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(is_inited_)) {
@@ -1832,33 +2289,31 @@ int ObDeviceChannel::init(ObIODevice *device_handle,
   } else if (OB_UNLIKELY(nullptr == device_handle
         || async_channel_count <= 0
         || sync_channel_count <= 0
-        || max_io_depth <= 0)) {
+        || max_io_depth <= 0
+        || ObIOChannelType::MAX_TYPE == channel_type)) {
     ret = OB_INVALID_ARGUMENT;
-    LOG_WARN("invalid argument", K(ret), KP(device_handle), K(async_channel_count), K(sync_channel_count), K(max_io_depth));
+    LOG_WARN("invalid argument", K(ret), KP(device_handle), K(async_channel_count), K(sync_channel_count), K(max_io_depth),
+        "channel_type", get_io_channel_type_name(channel_type));
   } else {
     device_handle_ = device_handle;
     used_io_depth_ = 0;
     max_io_depth_ = max_io_depth;
     allocator_ = &allocator;
-    for (int64_t i = 0; OB_SUCC(ret) && i < async_channel_count; ++i) {
-      ObAsyncIOChannel *ch = nullptr;
-      void *buf = nullptr;
-      if (OB_ISNULL(buf = allocator.alloc(sizeof(ObAsyncIOChannel)))) {
-        ret = OB_ALLOCATE_MEMORY_FAILED;
-        LOG_WARN("alloc async channel failed", K(ret), K(i), K(async_channel_count));
-      } else if (FALSE_IT(ch = new (buf) ObAsyncIOChannel())) {
-      } else if (OB_FAIL(ch->init(this))) {
-        LOG_WARN("init async channel failed", K(ret));
-      } else if (OB_FAIL(ch->start_thread())) {
-        LOG_WARN("start thread failed", K(ret), KPC(ch));
-      } else if (OB_FAIL(async_channels_.push_back(ch))) {
-        LOG_WARN("push back async channel failed", K(ret), KPC(ch));
-      } else {
-        ch = nullptr;
+    channel_type_ = channel_type;
+    if (ObIOChannelType::AIO != channel_type) {
+      if (OB_FAIL(init_io_uring_channels(async_channel_count, ObIOChannelType::IO_URING_SQPOLL == channel_type))) {
+        if (OB_NOT_SUPPORTED == ret) {
+          LOG_WARN("io_uring is not supported, fallback to libaio", K(ret), "channel_type", get_io_channel_type_name(channel_type));
+          ret = OB_SUCCESS;
+          channel_type_ = ObIOChannelType::AIO;
+        } else {
+          LOG_WARN("init io_uring channels failed", K(ret), K(async_channel_count));
+        }
       }
-      if (OB_UNLIKELY(nullptr != ch)) {
-        ch->~ObAsyncIOChannel();
-        allocator.free(ch);
+    }
+    if (OB_SUCC(ret) && ObIOChannelType::AIO == channel_type_) {
+      if (OB_FAIL(init_aio_channels(async_channel_count))) {
+        LOG_WARN("init aio channels failed", K(ret), K(async_channel_count));
       }
     }
     for (int64_t i = 0; OB_SUCC(ret) && i < sync_channel_count; ++i) {
@@ -1892,16 +2347,87 @@ int ObDeviceChannel::init(ObIODevice *device_handle,
   return ret;
 }
 
+int ObDeviceChannel::init_aio_channels(const int64_t async_channel_count)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < async_channel_count; ++i) {
+    ObAsyncIOChannel *ch = nullptr;
+    void *buf = nullptr;
+    if (OB_ISNULL(buf = allocator_->alloc(sizeof(ObAsyncIOChannel)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc async channel failed", K(ret), K(i), K(async_channel_count));
+    } else if (FALSE_IT(ch = new (buf) ObAsyncIOChannel())) {
+    } else if (OB_FAIL(ch->init(this))) {
+      LOG_WARN("init async channel failed", K(ret));
+    } else if (OB_FAIL(ch->start_thread())) {
+      LOG_WARN("start thread failed", K(ret), KPC(ch));
+    } else if (OB_FAIL(async_channels_.push_back(ch))) {
+      LOG_WARN("push back async channel failed", K(ret), KPC(ch));
+    } else {
+      ch = nullptr;
+    }
+    if (OB_UNLIKELY(nullptr != ch)) {
+      ch->~ObAsyncIOChannel();
+      allocator_->free(ch);
+    }
+  }
+  return ret;
+}
+
+int ObDeviceChannel::init_io_uring_channels(const int64_t async_channel_count, const bool use_sq_poll)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < async_channel_count; ++i) {
+    ObIOUringChannel *ch = nullptr;
+    void *buf = nullptr;
+    if (OB_ISNULL(buf = allocator_->alloc(sizeof(ObIOUringChannel)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc io_uring channel failed", K(ret), K(i), K(async_channel_count));
+    } else if (FALSE_IT(ch = new (buf) ObIOUringChannel())) {
+    } else if (OB_FAIL(ch->init(this, use_sq_poll))) {
+      LOG_WARN("init io_uring channel failed", K(ret), K(use_sq_poll));
+    } else if (OB_FAIL(ch->start_thread())) {
+      LOG_WARN("start thread failed", K(ret), KPC(ch));
+    } else if (OB_FAIL(async_channels_.push_back(ch))) {
+      LOG_WARN("push back io_uring channel failed", K(ret), KPC(ch));
+    } else {
+      ch = nullptr;
+    }
+    if (OB_UNLIKELY(nullptr != ch)) {
+      ch->~ObIOUringChannel();
+      allocator_->free(ch);
+    }
+  }
+  if (OB_FAIL(ret)) {
+    // release the channels already started, caller may fallback to libaio
+    for (int64_t i = 0; i < async_channels_.count(); ++i) {
+      ObIOUringChannel *ch = static_cast<ObIOUringChannel *>(async_channels_.at(i));
+      ch->stop();
+      ch->wait();
+      ch->~ObIOUringChannel();
+      allocator_->free(ch);
+    }
+    async_channels_.reset();
+  }
+  return ret;
+}
+
 void ObDeviceChannel::destroy()
 {
   is_inited_ = false;
   for (int64_t i = 0; i < async_channels_.count(); ++i) {
-    ObAsyncIOChannel *ch = static_cast<ObAsyncIOChannel *>(async_channels_.at(i));
-    ch->stop();
+    if (ObIOChannelType::AIO == channel_type_) {
+      static_cast<ObAsyncIOChannel *>(async_channels_.at(i))->stop();
+    } else {
+      static_cast<ObIOUringChannel *>(async_channels_.at(i))->stop();
+    }
   }
   for (int64_t i = 0; i < async_channels_.count(); ++i) {
-    ObAsyncIOChannel *ch = static_cast<ObAsyncIOChannel *>(async_channels_.at(i));
-    ch->wait();
+    if (ObIOChannelType::AIO == channel_type_) {
+      static_cast<ObAsyncIOChannel *>(async_channels_.at(i))->wait();
+    } else {
+      static_cast<ObIOUringChannel *>(async_channels_.at(i))->wait();
+    }
   }
   for (int64_t i = 0; i < async_channels_.count(); ++i) {
     ObIOChannel *ch = async_channels_.at(i);
@@ -1919,6 +2445,7 @@ void ObDeviceChannel::destroy()
     }
   }
   sync_channels_.destroy();
+  channel_type_ = ObIOChannelType::AIO;
   allocator_ = nullptr;
 }
 
@@ -1941,6 +2468,50 @@ int ObDeviceChannel::submit(ObIORequest &req)
   return ret;
 }
 
+int ObDeviceChannel::register_fixed_buffer(char *buf, const int64_t buf_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(nullptr == buf || buf_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_size));
+  } else if (ObIOChannelType::AIO == channel_type_) {
+    // libaio has no fixed buffer
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < async_channels_.count(); ++i) {
+      ObIOUringChannel *ch = static_cast<ObIOUringChannel *>(async_channels_.at(i));
+      if (OB_FAIL(ch->register_fixed_buffer(buf, buf_size))) {
+        LOG_WARN("register fixed buffer failed", K(ret), KP(buf), K(buf_size), KPC(ch));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDeviceChannel::unregister_fixed_buffer(char *buf)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (ObIOChannelType::AIO == channel_type_) {
+    // libaio has no fixed buffer
+  } else {
+    // unregister from all channels whatever happens
+    for (int64_t i = 0; i < async_channels_.count(); ++i) {
+      int tmp_ret = OB_SUCCESS;
+      ObIOUringChannel *ch = static_cast<ObIOUringChannel *>(async_channels_.at(i));
+      if (OB_UNLIKELY(OB_SUCCESS != (tmp_ret = ch->unregister_fixed_buffer(buf)))) {
+        LOG_WARN("unregister fixed buffer failed", K(tmp_ret), KP(buf), KPC(ch));
+        ret = OB_SUCC(ret) ? tmp_ret : ret;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObDeviceChannel::get_random_io_channel(ObIArray<ObIOChannel *> &io_channels, ObIOChannel *&ch)
 {
   int ret = OB_SUCCESS;
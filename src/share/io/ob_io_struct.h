@@ -23,6 +23,7 @@
 #include "lib/container/ob_array_wrap.h"
 #include "lib/lock/ob_spin_lock.h"
 #include "share/io/ob_io_define.h"
+#include "share/io/ob_io_uring.h"
 #include "share/io/io_schedule/ob_io_mclock.h"  
 
 namespace oceanbase
@@ -71,6 +72,8 @@ public:
   int free(void *ptr);
   bool contain(void *ptr);
   int64_t get_block_size() const { return SIZE; }
+  char *get_begin_ptr() const { return begin_ptr_; }
+  int64_t get_total_size() const { return capacity_ * SIZE; }
 private:
   bool is_inited_;
   int64_t capacity_;
@@ -89,6 +92,9 @@ public:
   void destroy();
   int update_memory_limit(const int64_t memory_limit);
   int64_t get_allocated_size() const;
+  // the pre-allocated memory for macro block io, which can be pinned by io_uring
+  char *get_macro_pool_begin() const { return macro_pool_.get_begin_ptr(); }
+  int64_t get_macro_pool_size() const { return macro_pool_.get_total_size(); }
   virtual void *alloc(const int64_t size, const lib::ObMemAttr &attr) override;
   virtual void *alloc(const int64_t size) override;
   virtual void free(void *ptr) override;
@@ -281,6 +287,15 @@ public:
   virtual int64_t get_queue_count() const = 0;
   TO_STRING_KV(K(is_inited_), KP(device_handle_), K(tg_id_), "queue_count", get_queue_count());
 
+protected:
+  // handle the result returned by file system of an async io request
+  void on_io_event(ObIORequest &req, const int system_errno, const int64_t complete_size);
+  int on_full_return(ObIORequest &req);
+  int on_partial_return(ObIORequest &req, const int64_t complete_size);
+  int on_partial_retry(ObIORequest &req, const int64_t complete_size);
+  int on_full_retry(ObIORequest &req);
+  int on_failed(ObIORequest &req, const ObIORetCode &ret_code);
+
 protected:
   bool is_inited_;
   int tg_id_; // thread group id
@@ -307,11 +322,6 @@ public:
 
 private:
   void get_events();
-  int on_full_return(ObIORequest &req);
-  int on_partial_return(ObIORequest &req, const int64_t complete_size);
-  int on_partial_retry(ObIORequest &req, const int64_t complete_size);
-  int on_full_retry(ObIORequest &req);
-  int on_failed(ObIORequest &req, const ObIORetCode &ret_code);
 
 private:
   static const int32_t MAX_AIO_EVENT_CNT = 512;
@@ -344,8 +354,66 @@ private:
   bool is_wait_;
 };
 
+/**
+ * async io channel based on io_uring.
+ * requests submitted by several sender threads are staged in a queue, whoever holds the submit lock
+ * moves all staged requests into the submission queue and enters kernel once for the whole batch.
+ * read/write buffers inside registered io memory pools are issued as fixed buffer io.
+ */
+class ObIOUringChannel : public ObIOChannel
+{
+public:
+  ObIOUringChannel();
+  virtual ~ObIOUringChannel();
+
+  int init(ObDeviceChannel *device_channel, const bool use_sq_poll);
+  void stop();
+  void wait();
+  void destroy();
+  virtual void run1() override;
+  virtual int submit(ObIORequest &req) override;
+  virtual void cancel(ObIORequest &req) override;
+  virtual int64_t get_queue_count() const override;
+  int register_fixed_buffer(char *buf, const int64_t buf_size);
+  int unregister_fixed_buffer(char *buf);
+  INHERIT_TO_STRING_KV("IOChannel", ObIOChannel, K(ring_), K(submit_count_), K(pending_queue_.get_total()),
+      K(fixed_buffer_cnt_));
+
+private:
+  void try_flush();
+  int flush();
+  int submit_ring();
+  void fail_unsubmitted(const int ret_code);
+  int prepare_sqe(ObIORequest &req, ObIOUringSqe &sqe);
+  void get_events();
+  int wakeup_getevents();
+  int refresh_fixed_buffers();
+  int wait_sqes_consumed(const uint32_t sqe_tail);
+
+private:
+  static const int32_t MAX_URING_EVENT_CNT = 512;
+  static const int64_t MAX_FIXED_BUFFER_CNT = 64;
+  static const int64_t SQ_THREAD_IDLE_MS = 10;
+  static const int64_t RESUBMIT_INTERVAL_US = 100;
+  static const int64_t WAIT_SQES_CONSUMED_TIMEOUT_US = 10L * 1000L * 1000L; // 10s
+  ObIOUring ring_;
+  ObFixedQueue<ObIORequest> pending_queue_;
+  ObSpinLock submit_lock_;
+  int64_t submit_count_;
+  // buffers registered in kernel and used by prepare_sqe, protected by submit_lock_
+  int64_t fixed_buffer_cnt_;
+  struct iovec fixed_buffers_[MAX_FIXED_BUFFER_CNT];
+  // buffers to register, protected by buffer_set_lock_. kernel registration is done out of
+  // submit_lock_ and only when the set changes.
+  lib::ObMutex buffer_set_lock_;
+  int64_t buffer_set_cnt_;
+  struct iovec buffer_set_[MAX_FIXED_BUFFER_CNT];
+  ObIOUringCqe *cqes_[MAX_URING_EVENT_CNT];
+  uint64_t reclaimed_user_datas_[MAX_URING_EVENT_CNT];
+};
+
 // each device has several channels, including async channels and sync channels.
-// this interface better in ObIODevice and can be replaced by io_uring.
+// async channels are based on libaio or io_uring according to the channel type.
 class ObDeviceChannel final
 {
 public:
@@ -355,18 +423,28 @@ public:
            const int64_t async_channel_count,
            const int64_t sync_channel_count,
            const int64_t max_io_depth,
-           ObIAllocator &allocator);
+           ObIAllocator &allocator,
+           const ObIOChannelType channel_type = ObIOChannelType::AIO);
   void destroy();
   int submit(ObIORequest &req);
-  TO_STRING_KV(K(is_inited_), KP(allocator_), K(async_channels_), K(sync_channels_));
+  // pin buffers of io memory pool for fixed buffer io, only take effect on io_uring channels
+  int register_fixed_buffer(char *buf, const int64_t buf_size);
+  int unregister_fixed_buffer(char *buf);
+  ObIOChannelType get_channel_type() const { return channel_type_; }
+  TO_STRING_KV(K(is_inited_), KP(allocator_), "channel_type", get_io_channel_type_name(channel_type_),
+      K(async_channels_), K(sync_channels_));
 private:
   int get_random_io_channel(ObIArray<ObIOChannel *> &io_channels, ObIOChannel *&ch);
+  int init_aio_channels(const int64_t async_channel_count);
+  int init_io_uring_channels(const int64_t async_channel_count, const bool use_sq_poll);
 
 private:
   friend class ObIOChannel;
   friend class ObAsyncIOChannel;
   friend class ObSyncIOChannel;
+  friend class ObIOUringChannel;
   bool is_inited_;
+  ObIOChannelType channel_type_;
   ObIAllocator *allocator_;
   ObSEArray<ObIOChannel *, 8> async_channels_;
   ObSEArray<ObIOChannel *, 8> sync_channels_;
@@ -0,0 +1,457 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+
+#include "share/io/ob_io_uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "lib/oblog/ob_log.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/utility/utility.h"
+
+// syscall numbers of io_uring are unified among all architectures
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+using namespace oceanbase::common;
+
+namespace
+{
+struct ObIOSqringOffsets
+{
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t flags_;
+  uint32_t dropped_;
+  uint32_t array_;
+  uint32_t resv1_;
+  uint64_t resv2_;
+};
+
+struct ObIOCqringOffsets
+{
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t overflow_;
+  uint32_t cqes_;
+  uint32_t flags_;
+  uint32_t resv1_;
+  uint64_t resv2_;
+};
+
+struct ObIOUringParams
+{
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  uint32_t flags_;
+  uint32_t sq_thread_cpu_;
+  uint32_t sq_thread_idle_;
+  uint32_t features_;
+  uint32_t wq_fd_;
+  uint32_t resv_[3];
+  ObIOSqringOffsets sq_off_;
+  ObIOCqringOffsets cq_off_;
+};
+
+STATIC_ASSERT(sizeof(ObIOUringParams) == 120, "io_uring params size mismatch");
+
+static const uint32_t IO_URING_SETUP_SQPOLL = 1U << 1;
+static const uint32_t IO_URING_FEAT_SINGLE_MMAP = 1U << 0;
+static const uint32_t IO_URING_FEAT_RW_CUR_POS = 1U << 3; // IORING_OP_READ/WRITE are supported since then
+static const uint32_t IO_URING_ENTER_GETEVENTS = 1U << 0;
+static const uint32_t IO_URING_ENTER_SQ_WAKEUP = 1U << 1;
+static const uint32_t IO_URING_SQ_NEED_WAKEUP = 1U << 0;
+static const uint32_t IO_URING_REGISTER_BUFFERS = 0;
+static const uint32_t IO_URING_UNREGISTER_BUFFERS = 1;
+static const int64_t IO_URING_OFF_SQ_RING = 0;
+static const int64_t IO_URING_OFF_CQ_RING = 0x8000000LL;
+static const int64_t IO_URING_OFF_SQES = 0x10000000LL;
+}
+
+ObIOUring::ObIOUring()
+  : is_inited_(false),
+    use_sq_poll_(false),
+    has_registered_buffers_(false),
+    ring_fd_(-1),
+    sq_entries_(0),
+    cq_entries_(0),
+    sq_ring_ptr_(nullptr),
+    sq_ring_size_(0),
+    sq_khead_(nullptr),
+    sq_ktail_(nullptr),
+    sq_kmask_(nullptr),
+    sq_kflags_(nullptr),
+    sq_array_(nullptr),
+    sqes_(nullptr),
+    sqes_size_(0),
+    sqe_head_(0),
+    sqe_tail_(0),
+    cq_ring_ptr_(nullptr),
+    cq_ring_size_(0),
+    cq_khead_(nullptr),
+    cq_ktail_(nullptr),
+    cq_kmask_(nullptr),
+    cqes_(nullptr)
+{
+}
+
+ObIOUring::~ObIOUring()
+{
+  destroy();
+}
+
+int ObIOUring::init(const uint32_t entries, const bool use_sq_poll, const int64_t sq_thread_idle_ms)
+{
+  int ret = OB_SUCCESS;
+  ObIOUringParams params;
+  MEMSET(&params, 0, sizeof(params));
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(0 == entries || sq_thread_idle_ms < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(entries), K(sq_thread_idle_ms));
+  } else {
+    if (use_sq_poll) {
+      params.flags_ |= IO_URING_SETUP_SQPOLL;
+      params.sq_thread_idle_ = static_cast<uint32_t>(sq_thread_idle_ms);
+    }
+    const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+      ret = convert_sys_errno(errno);
+      LOG_WARN("io_uring setup failed", K(ret), K(errno), K(entries), K(use_sq_poll));
+    } else if (FALSE_IT(ring_fd_ = fd)) {
+    } else if (OB_UNLIKELY(0 == (params.features_ & IO_URING_FEAT_RW_CUR_POS))) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("io_uring of current kernel is too old", K(ret), K(params.features_));
+    } else if (OB_FAIL(map_rings(&params))) {
+      LOG_WARN("map io_uring rings failed", K(ret));
+    } else {
+      use_sq_poll_ = use_sq_poll;
+      sq_entries_ = params.sq_entries_;
+      cq_entries_ = params.cq_entries_;
+      sqe_head_ = 0;
+      sqe_tail_ = 0;
+      is_inited_ = true;
+      LOG_INFO("io_uring setup succ", K(*this), K(params.features_));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+int ObIOUring::map_rings(const void *params_ptr)
+{
+  int ret = OB_SUCCESS;
+  const ObIOUringParams &params = *static_cast<const ObIOUringParams *>(params_ptr);
+  const bool single_mmap = 0 != (params.features_ & IO_URING_FEAT_SINGLE_MMAP);
+  sq_ring_size_ = params.sq_off_.array_ + params.sq_entries_ * sizeof(uint32_t);
+  cq_ring_size_ = params.cq_off_.cqes_ + params.cq_entries_ * sizeof(ObIOUringCqe);
+  if (single_mmap) {
+    sq_ring_size_ = max(sq_ring_size_, cq_ring_size_);
+    cq_ring_size_ = sq_ring_size_;
+  }
+  sqes_size_ = params.sq_entries_ * sizeof(ObIOUringSqe);
+  void *ptr = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ring_fd_, IO_URING_OFF_SQ_RING);
+  if (MAP_FAILED == ptr) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("mmap sq ring failed", K(ret), K(errno), K(sq_ring_size_));
+  } else if (FALSE_IT(sq_ring_ptr_ = ptr)) {
+  } else if (single_mmap) {
+    cq_ring_ptr_ = sq_ring_ptr_;
+  } else if (MAP_FAILED == (ptr = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, ring_fd_, IO_URING_OFF_CQ_RING))) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("mmap cq ring failed", K(ret), K(errno), K(cq_ring_size_));
+  } else {
+    cq_ring_ptr_ = ptr;
+  }
+  if (OB_FAIL(ret)) {
+  } else if (MAP_FAILED == (ptr = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, ring_fd_, IO_URING_OFF_SQES))) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("mmap sqes failed", K(ret), K(errno), K(sqes_size_));
+  } else {
+    char *sq_ptr = static_cast<char *>(sq_ring_ptr_);
+    char *cq_ptr = static_cast<char *>(cq_ring_ptr_);
+    sqes_ = static_cast<ObIOUringSqe *>(ptr);
+    sq_khead_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off_.head_);
+    sq_ktail_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off_.tail_);
+    sq_kmask_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off_.ring_mask_);
+    sq_kflags_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off_.flags_);
+    sq_array_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off_.array_);
+    cq_khead_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off_.head_);
+    cq_ktail_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off_.tail_);
+    cq_kmask_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off_.ring_mask_);
+    cqes_ = reinterpret_cast<ObIOUringCqe *>(cq_ptr + params.cq_off_.cqes_);
+  }
+  return ret;
+}
+
+void ObIOUring::unmap_rings()
+{
+  if (nullptr != sqes_) {
+    ::munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (nullptr != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  cq_ring_ptr_ = nullptr;
+  if (nullptr != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+    sq_ring_ptr_ = nullptr;
+  }
+  sq_khead_ = nullptr;
+  sq_ktail_ = nullptr;
+  sq_kmask_ = nullptr;
+  sq_kflags_ = nullptr;
+  sq_array_ = nullptr;
+  cq_khead_ = nullptr;
+  cq_ktail_ = nullptr;
+  cq_kmask_ = nullptr;
+  cqes_ = nullptr;
+  sq_ring_size_ = 0;
+  cq_ring_size_ = 0;
+  sqes_size_ = 0;
+}
+
+void ObIOUring::destroy()
+{
+  unmap_rings();
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_); // registered buffers are released with the ring
+    ring_fd_ = -1;
+  }
+  use_sq_poll_ = false;
+  has_registered_buffers_ = false;
+  sq_entries_ = 0;
+  cq_entries_ = 0;
+  sqe_head_ = 0;
+  sqe_tail_ = 0;
+  is_inited_ = false;
+}
+
+ObIOUringSqe *ObIOUring::get_sqe()
+{
+  ObIOUringSqe *sqe = nullptr;
+  if (OB_LIKELY(is_inited_)) {
+    const uint32_t head = ATOMIC_LOAD_ACQ(sq_khead_);
+    if (sqe_tail_ - head < sq_entries_) {
+      sqe = &sqes_[sqe_tail_ & *sq_kmask_];
+      ++sqe_tail_;
+      MEMSET(sqe, 0, sizeof(ObIOUringSqe));
+    }
+  }
+  return sqe;
+}
+
+int ObIOUring::flush_sq(uint32_t &to_submit)
+{
+  int ret = OB_SUCCESS;
+  const uint32_t mask = *sq_kmask_;
+  uint32_t ktail = *sq_ktail_;
+  while (sqe_head_ != sqe_tail_) {
+    sq_array_[ktail & mask] = sqe_head_ & mask;
+    ++ktail;
+    ++sqe_head_;
+  }
+  ATOMIC_STORE_REL(sq_ktail_, ktail);
+  // sqes published before but not consumed by kernel (such as -EAGAIN of last enter) are resubmitted too
+  to_submit = ktail - ATOMIC_LOAD_ACQ(sq_khead_);
+  return ret;
+}
+
+int ObIOUring::submit(int64_t &submitted_cnt)
+{
+  int ret = OB_SUCCESS;
+  uint32_t to_submit = 0;
+  int sys_ret = 0;
+  submitted_cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(flush_sq(to_submit))) {
+    LOG_WARN("flush submission queue failed", K(ret));
+  } else if (0 == to_submit) {
+    // nothing to submit
+  } else if (use_sq_poll_) {
+    // the kernel thread polls the submission queue, enter only when it has gone to sleep
+    submitted_cnt = to_submit;
+    if (0 != (ATOMIC_LOAD_ACQ(sq_kflags_) & IO_URING_SQ_NEED_WAKEUP)
+        && OB_FAIL(enter(0, 0, IO_URING_ENTER_SQ_WAKEUP, sys_ret))) {
+      LOG_WARN("wakeup sq poll thread failed", K(ret), K(sys_ret));
+    }
+  } else if (OB_FAIL(enter(to_submit, 0, 0, sys_ret))) {
+    if (OB_EAGAIN != ret) {
+      LOG_WARN("io_uring enter failed", K(ret), K(sys_ret), K(to_submit));
+    }
+  } else {
+    submitted_cnt = sys_ret;
+  }
+  return ret;
+}
+
+int ObIOUring::wait_cqe()
+{
+  int ret = OB_SUCCESS;
+  int sys_ret = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (ATOMIC_LOAD_ACQ(cq_ktail_) != *cq_khead_) {
+    // completions are ready, no need to enter kernel
+  } else {
+    uint32_t flags = IO_URING_ENTER_GETEVENTS;
+    if (use_sq_poll_ && 0 != (ATOMIC_LOAD_ACQ(sq_kflags_) & IO_URING_SQ_NEED_WAKEUP)) {
+      // the wakeup of submit() may have failed, wake up the sq thread before waiting
+      flags |= IO_URING_ENTER_SQ_WAKEUP;
+    }
+    if (OB_FAIL(enter(0, 1/*min_complete*/, flags, sys_ret))) {
+      LOG_WARN("wait io_uring completion failed", K(ret), K(sys_ret));
+    }
+  }
+  return ret;
+}
+
+int64_t ObIOUring::reclaim_unsubmitted(uint64_t *user_datas, const int64_t max_cnt)
+{
+  int64_t cnt = 0;
+  if (OB_LIKELY(is_inited_) && !use_sq_poll_ && OB_NOT_NULL(user_datas)) {
+    // sqe_head_ and sq tail of kernel move together, see flush_sq
+    const uint32_t mask = *sq_kmask_;
+    const uint32_t khead = ATOMIC_LOAD_ACQ(sq_khead_);
+    for (uint32_t i = khead; i != sqe_tail_ && cnt < max_cnt; ++i) {
+      user_datas[cnt++] = sqes_[i & mask].user_data_;
+    }
+    ATOMIC_STORE_REL(sq_ktail_, khead);
+    sqe_head_ = khead;
+    sqe_tail_ = khead;
+  }
+  return cnt;
+}
+
+int64_t ObIOUring::peek_cqes(ObIOUringCqe **cqes, const int64_t max_cnt)
+{
+  int64_t cnt = 0;
+  if (OB_LIKELY(is_inited_) && OB_NOT_NULL(cqes)) {
+    const uint32_t mask = *cq_kmask_;
+    const uint32_t head = *cq_khead_;
+    const uint32_t ready = ATOMIC_LOAD_ACQ(cq_ktail_) - head;
+    cnt = min(static_cast<int64_t>(ready), max_cnt);
+    for (int64_t i = 0; i < cnt; ++i) {
+      cqes[i] = &cqes_[(head + i) & mask];
+    }
+  }
+  return cnt;
+}
+
+void ObIOUring::advance_cq(const int64_t cnt)
+{
+  if (OB_LIKELY(is_inited_) && cnt > 0) {
+    ATOMIC_STORE_REL(cq_khead_, *cq_khead_ + static_cast<uint32_t>(cnt));
+  }
+}
+
+int ObIOUring::register_buffers(const struct iovec *iovecs, const int64_t iovec_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(nullptr == iovecs || iovec_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(iovecs), K(iovec_cnt));
+  } else if (OB_UNLIKELY(has_registered_buffers_)) {
+    ret = OB_ENTRY_EXIST;
+    LOG_WARN("buffers have been registered", K(ret));
+  } else if (0 != ::syscall(__NR_io_uring_register, ring_fd_, IO_URING_REGISTER_BUFFERS,
+                            iovecs, static_cast<uint32_t>(iovec_cnt))) {
+    // usually limited by RLIMIT_MEMLOCK on old kernels
+    ret = convert_sys_errno(errno);
+    LOG_WARN("register io_uring buffers failed", K(ret), K(errno), K(iovec_cnt));
+  } else {
+    has_registered_buffers_ = true;
+  }
+  return ret;
+}
+
+int ObIOUring::unregister_buffers()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (!has_registered_buffers_) {
+    // do nothing
+  } else if (0 != ::syscall(__NR_io_uring_register, ring_fd_, IO_URING_UNREGISTER_BUFFERS, nullptr, 0)) {
+    ret = convert_sys_errno(errno);
+    LOG_WARN("unregister io_uring buffers failed", K(ret), K(errno));
+  } else {
+    has_registered_buffers_ = false;
+  }
+  return ret;
+}
+
+int ObIOUring::enter(const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags, int &sys_ret)
+{
+  int ret = OB_SUCCESS;
+  while ((sys_ret = static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete,
+                                               flags, nullptr, 0))) < 0 && EINTR == errno); // ignore EINTR
+  if (sys_ret < 0) {
+    ret = convert_sys_errno(errno);
+  }
+  return ret;
+}
+
+int ObIOUring::convert_sys_errno(const int sys_errno)
+{
+  int ret = OB_IO_ERROR;
+  switch (sys_errno) {
+    case ENOSYS:
+    case EPERM:
+      ret = OB_NOT_SUPPORTED;
+      break;
+    case EAGAIN:
+    case EBUSY:
+      ret = OB_EAGAIN;
+      break;
+    case ENOMEM:
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      break;
+    case EINVAL:
+    case EFAULT:
+      ret = OB_INVALID_ARGUMENT;
+      break;
+    default:
+      ret = OB_IO_ERROR;
+      break;
+  }
+  return ret;
+}
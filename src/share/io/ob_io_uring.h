@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SHARE_IO_OB_IO_URING_H
+#define OCEANBASE_SHARE_IO_OB_IO_URING_H
+
+#include <sys/uio.h>
+#include "lib/ob_define.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/utility/ob_print_utils.h"
+#include "lib/utility/ob_template_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+/**
+ * Minimal io_uring ABI, the kernel headers of the build toolchain may predate linux 5.1,
+ * so the structures are declared here and the ring is driven by raw syscalls.
+ * Layouts must be kept identical to include/uapi/linux/io_uring.h.
+ */
+struct ObIOUringSqe final
+{
+  uint8_t opcode_;
+  uint8_t flags_;
+  uint16_t ioprio_;
+  int32_t fd_;
+  uint64_t off_;
+  uint64_t addr_;
+  uint32_t len_;
+  uint32_t rw_flags_;
+  uint64_t user_data_;
+  uint16_t buf_index_;
+  uint16_t personality_;
+  int32_t splice_fd_in_;
+  uint64_t pad_[2];
+};
+
+struct ObIOUringCqe final
+{
+  uint64_t user_data_;
+  int32_t res_;
+  uint32_t flags_;
+};
+
+STATIC_ASSERT(sizeof(ObIOUringSqe) == 64, "io_uring sqe size mismatch");
+STATIC_ASSERT(sizeof(ObIOUringCqe) == 16, "io_uring cqe size mismatch");
+
+enum ObIOUringOpcode : uint8_t
+{
+  IO_URING_OP_NOP = 0,
+  IO_URING_OP_READ_FIXED = 4,
+  IO_URING_OP_WRITE_FIXED = 5,
+  IO_URING_OP_READ = 22,
+  IO_URING_OP_WRITE = 23,
+};
+
+/**
+ * A single io_uring instance.
+ * Submission side (get_sqe/submit) must be serialized by the caller,
+ * completion side (wait_cqe/peek_cqes/advance_cq) must be driven by one thread,
+ * the two sides can run concurrently.
+ */
+class ObIOUring final
+{
+public:
+  ObIOUring();
+  ~ObIOUring();
+  int init(const uint32_t entries, const bool use_sq_poll, const int64_t sq_thread_idle_ms);
+  void destroy();
+  bool is_inited() const { return is_inited_; }
+  bool is_sq_poll() const { return use_sq_poll_; }
+  bool has_registered_buffers() const { return has_registered_buffers_; }
+  uint32_t get_sq_entries() const { return sq_entries_; }
+  // returns nullptr if the submission queue is full
+  ObIOUringSqe *get_sqe();
+  // publish all prepared sqes to kernel, and enter kernel if needed
+  int submit(int64_t &submitted_cnt);
+  // take back the sqes not consumed by kernel and return their user data, used to fail the
+  // requests after submit() failed. not supported in SQPOLL mode, the kernel thread consumes
+  // published sqes by itself.
+  int64_t reclaim_unsubmitted(uint64_t *user_datas, const int64_t max_cnt);
+  uint32_t get_sqe_tail() const { return sqe_tail_; }
+  // whether the sqes before @tail have been consumed by kernel
+  bool is_consumed(const uint32_t tail) const
+  { return static_cast<int32_t>(ATOMIC_LOAD_ACQ(sq_khead_) - tail) >= 0; }
+  // sqes published to kernel but not entered, left by -EAGAIN/-EBUSY of last enter. always
+  // false in SQPOLL mode, the kernel thread consumes published sqes by itself.
+  bool has_unsubmitted() const
+  { return !use_sq_poll_ && ATOMIC_LOAD_ACQ(sq_ktail_) != ATOMIC_LOAD_ACQ(sq_khead_); }
+  bool has_cqe() const { return ATOMIC_LOAD_ACQ(cq_ktail_) != *cq_khead_; }
+  // block until at least one completion is available
+  int wait_cqe();
+  int64_t peek_cqes(ObIOUringCqe **cqes, const int64_t max_cnt);
+  void advance_cq(const int64_t cnt);
+  int register_buffers(const struct iovec *iovecs, const int64_t iovec_cnt);
+  int unregister_buffers();
+  TO_STRING_KV(K(is_inited_), K(ring_fd_), K(use_sq_poll_), K(sq_entries_), K(cq_entries_), K(has_registered_buffers_));
+
+private:
+  int flush_sq(uint32_t &to_submit);
+  int enter(const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags, int &sys_ret);
+  int map_rings(const void *params);
+  void unmap_rings();
+  static int convert_sys_errno(const int sys_errno);
+
+private:
+  bool is_inited_;
+  bool use_sq_poll_;
+  bool has_registered_buffers_;
+  int ring_fd_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  // submission ring
+  void *sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  uint32_t *sq_khead_;
+  uint32_t *sq_ktail_;
+  uint32_t *sq_kmask_;
+  uint32_t *sq_kflags_;
+  uint32_t *sq_array_;
+  ObIOUringSqe *sqes_;
+  int64_t sqes_size_;
+  uint32_t sqe_head_; // first prepared sqe not published yet
+  uint32_t sqe_tail_; // next free sqe
+  // completion ring
+  void *cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  uint32_t *cq_khead_;
+  uint32_t *cq_ktail_;
+  uint32_t *cq_kmask_;
+  ObIOUringCqe *cqes_;
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} // namespace common
+} // namespace oceanbase
+
+#endif // OCEANBASE_SHARE_IO_OB_IO_URING_H
@@ -1279,6 +1279,34 @@ void ObLocalDevice::free_io_events(common::ObIOEvents *io_event)
   }
 }
 
+int ObLocalDevice::get_sys_io_target(
+    const common::ObIOFd &fd,
+    const int64_t offset,
+    int64_t &sys_fd,
+    int64_t &sys_offset) const
+{
+  int ret = OB_SUCCESS;
+  sys_fd = -1;
+  sys_offset = -1;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "The ObLocalDevice has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(offset < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid argument, ", K(ret), K(fd), K(offset));
+  } else if (OB_UNLIKELY(fd.is_super_block())) {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(WARN, "server entry doesn't support AIO", K(ret), K(fd));
+  } else if (fd.is_block_file()) {
+    sys_fd = block_fd_;
+    sys_offset = get_block_file_offset(fd, offset);
+  } else {
+    sys_fd = fd.second_id_;
+    sys_offset = offset;
+  }
+  return ret;
+}
+
 int64_t ObLocalDevice::get_total_block_size() const
 {
   return block_file_size_;
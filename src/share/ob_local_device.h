@@ -159,6 +159,11 @@ public:
   virtual common::ObIOEvents *alloc_io_events(const uint32_t max_events) override;
   virtual void free_iocb(common::ObIOCB *iocb) override;
   virtual void free_io_events(common::ObIOEvents *io_event) override;
+  virtual int get_sys_io_target(
+    const common::ObIOFd &fd,
+    const int64_t offset,
+    int64_t &sys_fd,
+    int64_t &sys_offset) const override;
 
   // space management interface
   virtual int64_t get_total_block_size() const override;
@@ -186,7 +191,7 @@ private:
     const int64_t reserved_size,
     bool &is_exist);
   int resize_block_file(const int64_t new_size);
-  int64_t get_block_file_offset(const common::ObIOFd &fd, const int64_t offset);
+  int64_t get_block_file_offset(const common::ObIOFd &fd, const int64_t offset) const;
   int try_punch_hole(const int64_t block_index);
   static int pread_impl(const int64_t fd, void *buf, const int64_t size, const int64_t offset, int64_t &read_size);
   static int pwrite_impl(const int64_t fd, const void *buf, const int64_t size, const int64_t offset, int64_t &write_size);
@@ -215,7 +220,7 @@ private:
   bool is_fs_support_punch_hole_;
 };
 
-OB_INLINE int64_t ObLocalDevice::get_block_file_offset(const common::ObIOFd &fd, const int64_t offset)
+OB_INLINE int64_t ObLocalDevice::get_block_file_offset(const common::ObIOFd &fd, const int64_t offset) const
 {
   return fd.second_id_ * block_size_ + offset;
 }
@@ -231,6 +231,15 @@ DEF_CAP(_sort_area_size, OB_TENANT_PARAMETER, "128M", "[2M,]",
 DEF_CAP(_hash_area_size, OB_TENANT_PARAMETER, "100M", "[4M,]",
         "size of maximum memory that could be used by HASH JOIN. Range: [4M,+∞)",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_sql_spill_compress_func, OB_TENANT_PARAMETER, "none",
+                     common::ObConfigCompressFuncChecker,
+                     "compressor used for blocks dumped to temp file by sql operators. "
+                     "Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0, zstd_1.3.8",
+                     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_sql_spill_checksum, OB_TENANT_PARAMETER, "False",
+         "verify checksum of blocks dumped to temp file by sql operators when they are read back. "
+         "Value: True: enable checksum False: disable checksum",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //https://yuque.antfin-inc.com/ob/product_functionality_review/gxmqcg
 DEF_BOOL(_enable_partition_level_retry, OB_CLUSTER_PARAMETER, "True",
@@ -707,7 +716,35 @@ DEF_INT(bf_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "bf cache priority
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(bf_cache_miss_count_threshold, OB_CLUSTER_PARAMETER, "100", "[0,)", "bf cache miss count threshold, 0 means disable bf cache. Range:[0, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_bloom_filter_rowkey_prefix, OB_TENANT_PARAMETER, "0", "[0,64]",
+        "rowkey prefix length of the bloom filters built for macro blocks during minor compaction, "
+        "0 means they are only built for tables using bloom filter. Range:[0, 64]",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(fuse_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "fuse row cache priority. Range:[1, )", ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR(_cache_tinylfu_admission, OB_CLUSTER_PARAMETER, "",
+        "comma separated names of kv caches using frequency based admission, e.g. "
+        "user_block_cache,index_block_cache. Blocks filled by keys rarely accessed recently, "
+        "such as by full table scans, are washed before blocks of frequent keys",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_micro_block_flash_cache_size, OB_CLUSTER_PARAMETER, "0M", "[0M,)",
+        "size of the local file caching micro blocks washed out of index and user block cache, "
+        "0 means disable the flash cache. Range: [0M, +∞)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_STR(_micro_block_flash_cache_path, OB_CLUSTER_PARAMETER, "",
+        "path of the micro block flash cache file, preferably on a fast local ssd. "
+        "Empty means flash_cache under the sstable directory",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_micro_block_cache_manifest_size, OB_CLUSTER_PARAMETER, "0M", "[0M,)",
+        "size of the hottest micro blocks of index and user block cache each, recorded in the "
+        "warm-up manifest and reloaded after restart, 0 means disable cache warm-up. Range: [0M, +∞)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_micro_block_cache_manifest_interval, OB_CLUSTER_PARAMETER, "10m", "[1m,)",
+        "the interval of persisting the micro block cache warm-up manifest. Range: [1m, +∞)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_micro_block_cache_warm_up_bandwidth, OB_CLUSTER_PARAMETER, "64M", "[1M,)",
+        "io bandwidth per second used to reload micro blocks of the warm-up manifest after restart. "
+        "Range: [1M, +∞)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //background limit config
 DEF_TIME(_data_storage_io_timeout, OB_CLUSTER_PARAMETER, "120s", "[5s,600s]",
@@ -735,6 +772,13 @@ DEF_INT_WITH_CHECKER(disk_io_thread_count, OB_CLUSTER_PARAMETER, "8",
 DEF_INT(_io_callback_thread_count, OB_TENANT_PARAMETER, "8", "[1,64]",
         "The number of io callback threads. The default value is 8. Range: [1,64] in integer",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_io_channel_type, OB_CLUSTER_PARAMETER, "aio",
+                     common::ObConfigIOChannelTypeChecker,
+                     "the way async io of data storage is delivered to kernel. "
+                     "aio: libaio; io_uring: io_uring with batched submission and fixed buffers; "
+                     "io_uring_sqpoll: io_uring with kernel submission polling thread. "
+                     "Falls back to aio if io_uring is not supported by the kernel. The default value is aio",
+                     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_STR(io_category_config, OB_TENANT_PARAMETER, "other: 100,100,100",
         "configs for different category of io request. specify with category name, minimal percentage, maximal percentage, weight percentage. devide the category with semicolon",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -746,6 +790,12 @@ DEF_BOOL(_enable_parallel_minor_merge, OB_TENANT_PARAMETER, "True",
          "specifies whether enable parallel minor merge. "
          "Value: True:turned on;  False: turned off",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_skip_index_column_count, OB_TENANT_PARAMETER, "16", "[0,64]",
+        "the number of leading columns of a table for which major compaction records "
+        "min/max/null count of each micro block in the index tree, so that scans with "
+        "pushdown filters can skip micro blocks without decoding them. "
+        "0 means skip index is disabled. Range: [0,64] in integer",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(compaction_low_thread_score, OB_TENANT_PARAMETER, "0", "[0,100]",
         "the current work thread score of low priority compaction. Range: [0,100] in integer. Especially, 0 means default value",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -781,6 +831,11 @@ DEF_CAP(_private_buffer_size, OB_CLUSTER_PARAMETER, "256K", "[0B,)"
          "the trigger remaining data size within transaction for immediate logging, 0B represents not trigger immediate logging"
          "Range: [0B, total size of memory]",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_tx_max_pending_redo_log_count, OB_CLUSTER_PARAMETER, "8", "[3,16]",
+        "the max count of redo logs of a transaction that are submitted but not synced yet, "
+        "larger value lets big transactions fill redo while previous redo logs are syncing. "
+        "Range: [3,16] in integer",
+        ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_fast_commit_callback_count, OB_CLUSTER_PARAMETER, "10000", "[0,)"
         "trigger max callback count allowed within transaction for durable callback checkpoint, 0 represents not allow durable callback"
         "Range: [0, not limited callback count",
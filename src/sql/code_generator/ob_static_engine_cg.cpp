@@ -5991,6 +5991,16 @@ int ObStaticEngineCG::set_other_properties(const ObLogPlan &log_plan, ObPhysical
     phy_plan.set_minimal_worker_count(log_plan.get_optimizer_context().get_minimal_worker_count());
     phy_plan.set_is_batched_multi_stmt(log_plan.get_optimizer_context().is_batched_multi_stmt());
     phy_plan.set_need_consistent_snapshot(log_plan.need_consistent_read());
+    if (OB_SUCC(ret)) {
+      int64_t weak_read_max_staleness = 0;
+      const ObOptParamHint &opt_params = log_plan.get_stmt()->get_query_ctx()->get_global_hint().opt_params_;
+      if (OB_FAIL(opt_params.get_integer_opt_param(ObOptParamHint::WEAK_READ_MAX_STALENESS,
+                                                   weak_read_max_staleness))) {
+        LOG_WARN("fail to get weak read max staleness", K(ret));
+      } else {
+        phy_plan.set_weak_read_max_staleness(weak_read_max_staleness);
+      }
+    }
     if (OB_FAIL(phy_plan.set_expected_worker_map(log_plan.get_optimizer_context().get_expected_worker_map()))) {
       LOG_WARN("set expected worker map", K(ret));
     } else if (OB_FAIL(phy_plan.set_minimal_worker_map(log_plan.get_optimizer_context().get_minimal_worker_map()))) {
@@ -76,10 +76,50 @@ int ObGroupRowHashTable::init(ObIAllocator *allocator,
     gby_exprs_ = &gby_exprs;
     eval_ctx_ = eval_ctx;
     cmp_funcs_ = cmp_funcs;
+    enable_inline_key_ = (1 == gby_exprs.count() && nullptr != gby_exprs.at(0)
+                          && nullptr != cmp_funcs && 1 == cmp_funcs->count());
   }
   return ret;
 }
 
+int ObGroupRowHashTable::set(ObGroupRowItem &item)
+{
+  if (enable_inline_key_) {
+    // the group by datum of a new group is either still in the expr or already in the store row
+    const ObDatum *datum = nullptr;
+    if (item.is_expr_row_) {
+      datum = &gby_exprs_->at(0)->locate_expr_datum(*eval_ctx_, item.batch_idx_);
+    } else if (nullptr != item.groupby_store_row_) {
+      datum = &item.groupby_store_row_->cells()[0];
+    }
+    if (nullptr != datum && !datum->is_null() && ObDatumDesc::NONE == datum->flag_
+        && datum->len_ <= sizeof(item.inline_key_)) {
+      MEMCPY(&item.inline_key_, datum->ptr_, datum->len_);
+      item.inline_key_len_ = static_cast<int8_t>(datum->len_);
+    }
+  }
+  return ObExtendHashTable<ObGroupRowItem>::set(item);
+}
+
+bool ObGroupRowHashTable::inline_key_equal(
+  const ObGroupRowItem &left, const ObGroupRowItem &right) const
+{
+  bool result = false;
+  const ObDatum &r = gby_exprs_->at(0)->locate_expr_datum(*eval_ctx_, right.batch_idx_);
+  if (r.is_null()) {
+    result = false;
+  } else if (r.len_ == left.inline_key_len_
+             && 0 == memcmp(&left.inline_key_, r.ptr_, r.len_)) {
+    result = true;
+  } else {
+    ObDatum l;
+    l.ptr_ = reinterpret_cast<const char *>(&left.inline_key_);
+    l.len_ = left.inline_key_len_;
+    result = (0 == cmp_funcs_->at(0).cmp_func_(l, r));
+  }
+  return result;
+}
+
 bool ObGroupRowHashTable::likely_equal(
   const ObGroupRowItem &left, const ObGroupRowItem &right) const
 {
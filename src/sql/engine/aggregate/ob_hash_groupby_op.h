@@ -81,7 +81,9 @@ public:
       group_row_(NULL),
       groupby_store_row_(NULL),
       group_row_count_in_batch_(0),
-      group_row_offset_in_selector_(0)
+      group_row_offset_in_selector_(0),
+      inline_key_len_(-1),
+      inline_key_(0)
   {
   }
 
@@ -108,15 +110,21 @@ public:
 
   uint16_t group_row_count_in_batch_;
   uint16_t group_row_offset_in_selector_;
+  // a group by key no wider than 8 bytes is copied into the item, so that probing the
+  // hash table compares it without touching the group by store row, -1 for none
+  int8_t inline_key_len_;
+  uint64_t inline_key_;
 };
 
 
 class ObGroupRowHashTable : public ObExtendHashTable<ObGroupRowItem>
 {
 public:
-  ObGroupRowHashTable() : ObExtendHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr) {}
+  ObGroupRowHashTable()
+    : ObExtendHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr), enable_inline_key_(false) {}
 
   OB_INLINE const ObGroupRowItem *get(const ObGroupRowItem &item) const;
+  int set(ObGroupRowItem &item);
   OB_INLINE void prefetch(const ObBatchRows &brs, uint64_t *hash_vals) const;
   int init(ObIAllocator *allocator,
           lib::ObMemAttr &mem_attr,
@@ -126,10 +134,13 @@ public:
           int64_t initial_size = INITIAL_SIZE);
 private:
   bool likely_equal(const ObGroupRowItem &left, const ObGroupRowItem &right) const;
+  bool inline_key_equal(const ObGroupRowItem &left, const ObGroupRowItem &right) const;
 private:
   const common::ObIArray<ObExpr *> *gby_exprs_;
   ObEvalCtx *eval_ctx_;
   const common::ObIArray<ObCmpFunc> *cmp_funcs_;
+  // only for one group by expr
+  bool enable_inline_key_;
   static const int64_t HASH_BUCKET_PREFETCH_MAGIC_NUM = 4 * 1024;
 };
 
@@ -142,7 +153,7 @@ OB_INLINE const ObGroupRowItem *ObGroupRowHashTable::get(const ObGroupRowItem &i
     const uint64_t hash_val = item.hash();
     ObGroupRowItem *it = locate_bucket(*buckets_, hash_val).item_;
     while (NULL != it) {
-      if (likely_equal(*it, item)) {
+      if (it->inline_key_len_ >= 0 ? inline_key_equal(*it, item) : likely_equal(*it, item)) {
         res = it;
         break;
       }
@@ -176,7 +187,8 @@ OB_INLINE void ObGroupRowHashTable::prefetch(const ObBatchRows &brs, uint64_t *h
     }
     for(auto i = 0; i < brs.size_; i++) {
       auto item = buckets_->at(hash_vals[i] & mask).item_;
-      if (brs.skip_->at(i) || OB_ISNULL(item) || OB_ISNULL(item->groupby_store_row_)) {
+      if (brs.skip_->at(i) || OB_ISNULL(item) || OB_ISNULL(item->groupby_store_row_)
+          || item->inline_key_len_ >= 0) {
         continue;
       }
       __builtin_prefetch(item->groupby_store_row_,
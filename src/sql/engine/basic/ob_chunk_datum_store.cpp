@@ -19,6 +19,9 @@
 #include "lib/container/ob_se_array_iterator.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "share/config/ob_server_config.h"
+#include "lib/checksum/ob_crc64.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -470,7 +473,10 @@ ObChunkDatumStore::ObChunkDatumStore(common::ObIAllocator *alloc /* = NULL */)
     mem_hold_(0), mem_used_(0), max_hold_mem_(0),
     allocator_(NULL == alloc ? &inner_allocator_ : alloc),
     row_extend_size_(0), callback_(nullptr), batch_ctx_(NULL),
-    tmp_dump_blk_(nullptr)
+    tmp_dump_blk_(nullptr), raw_file_size_(0), dump_format_inited_(false), dump_with_header_(false),
+    dump_checksum_(false),
+    compressor_(NULL), compress_buf_(NULL), compress_buf_size_(0), compress_skip_cnt_(0),
+    compress_poor_cnt_(0)
 {
   io_.fd_ = -1;
   io_.dir_id_ = -1;
@@ -518,6 +524,13 @@ void ObChunkDatumStore::reset()
   }
   file_size_ = 0;
   n_block_in_file_ = 0;
+  raw_file_size_ = 0;
+  dump_format_inited_ = false;
+  dump_with_header_ = false;
+  dump_checksum_ = false;
+  compressor_ = NULL;
+  compress_skip_cnt_ = 0;
+  compress_poor_cnt_ = 0;
 
   while (!blocks_.is_empty()) {
     Block *item = blocks_.remove_first();
@@ -535,6 +548,9 @@ void ObChunkDatumStore::reset()
   cur_blk_buffer_ = nullptr;
   free_block(tmp_dump_blk_);
   tmp_dump_blk_ = nullptr;
+  free_blk_mem(compress_buf_, compress_buf_size_);
+  compress_buf_ = NULL;
+  compress_buf_size_ = 0;
   while (!free_list_.is_empty()) {
     Block *item = free_list_.remove_first();
     mem_hold_ -= item->get_buffer()->mem_size();
@@ -731,8 +747,14 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
     LOG_WARN("unexpected: dump zero", K(item), K(item->cur_pos_));
   }
   item->block->magic_ = Block::MAGIC;
-  if (OB_FAIL(item->get_block()->unswizzling())) {
+  if (!dump_format_inited_ && OB_FAIL(init_dump_format())) {
+    LOG_WARN("init dump format failed", K(ret));
+  } else if (OB_FAIL(item->get_block()->unswizzling())) {
     LOG_WARN("convert block to copyable failed", K(ret));
+  } else if (dump_with_header_) {
+    if (OB_FAIL(dump_one_block_with_header(item))) {
+      LOG_WARN("dump block with header failed", K(ret));
+    }
   } else if (item->capacity() < min_block_size) {
     if (OB_ISNULL(tmp_dump_blk_)) {
       if (OB_FAIL(alloc_block_buffer(tmp_dump_blk_, default_block_size_, false))) {
@@ -757,6 +779,8 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
   }
   if (OB_SUCC(ret)) {
     n_block_in_file_++;
+    raw_file_size_ += dump_with_header_
+        ? item->capacity() : std::max(item->capacity(), min_block_size);
     LOG_DEBUG("RowStore Dumpped block", K_(item->block->rows),
       K_(item->cur_pos), K(item->capacity()));
   }
@@ -766,6 +790,114 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
   return ret;
 }
 
+int ObChunkDatumStore::init_dump_format()
+{
+  int ret = OB_SUCCESS;
+  ObCompressorType compressor_type = NONE_COMPRESSOR;
+  bool checksum = false;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+  if (!tenant_config.is_valid()) {
+    // dump without header
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor_type(
+      tenant_config->_sql_spill_compress_func.str(), compressor_type))) {
+    LOG_WARN("get compressor type failed", K(ret));
+  } else {
+    checksum = tenant_config->_enable_sql_spill_checksum;
+  }
+  if (OB_SUCC(ret) && OB_FAIL(set_dump_format(compressor_type, checksum))) {
+    LOG_WARN("set dump format failed", K(ret), K(compressor_type), K(checksum));
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::set_dump_format(const ObCompressorType compressor_type,
+                                       const bool checksum)
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  if (OB_UNLIKELY(is_file_open())) {
+    ret = OB_STATE_NOT_MATCH;
+    LOG_WARN("blocks have been dumped", K(ret), K_(io_.fd));
+  } else if (NONE_COMPRESSOR != compressor_type
+      && OB_FAIL(ObCompressorPool::get_instance().get_compressor(compressor_type, compressor))) {
+    LOG_WARN("get compressor failed", K(ret), K(compressor_type));
+  } else {
+    compressor_ = compressor;
+    dump_checksum_ = checksum;
+    dump_with_header_ = NULL != compressor_ || dump_checksum_;
+    compress_skip_cnt_ = 0;
+    compress_poor_cnt_ = 0;
+    dump_format_inited_ = true;
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::dump_one_block_with_header(BlockBuffer *item)
+{
+  int ret = OB_SUCCESS;
+  Block *blk = item->get_block();
+  const int64_t data_size = item->data_size() - BlockBuffer::HEAD_SIZE;
+  int64_t max_overflow_size = 0;
+  if (NULL != compressor_
+      && OB_FAIL(compressor_->get_max_overflow_size(data_size, max_overflow_size))) {
+    LOG_WARN("get max overflow size failed", K(ret), K(data_size));
+  } else {
+    const int64_t buf_size = sizeof(DumpHeader) + data_size + max_overflow_size;
+    if (buf_size > compress_buf_size_) {
+      free_blk_mem(compress_buf_, compress_buf_size_);
+      compress_buf_size_ = 0;
+      if (OB_ISNULL(compress_buf_ = static_cast<char *>(alloc_blk_mem(buf_size, false)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret), K(buf_size));
+      } else {
+        compress_buf_size_ = buf_size;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    DumpHeader *header = new (compress_buf_) DumpHeader();
+    char *payload = compress_buf_ + sizeof(DumpHeader);
+    int64_t payload_size = data_size;
+    header->blk_size_ = blk->blk_size_;
+    header->rows_ = blk->rows_;
+    header->data_size_ = static_cast<uint32>(data_size);
+    if (NULL != compressor_ && compress_skip_cnt_ > 0) {
+      compress_skip_cnt_--;
+    } else if (NULL != compressor_) {
+      int64_t compressed_size = 0;
+      if (OB_FAIL(compressor_->compress(blk->payload_, data_size, payload,
+                                        compress_buf_size_ - sizeof(DumpHeader),
+                                        compressed_size))) {
+        LOG_WARN("compress block failed", K(ret), K(data_size));
+      } else if (compressed_size * 100 <= data_size * POOR_COMPRESS_PERCENT) {
+        payload_size = compressed_size;
+        header->flag_ |= DumpHeader::COMPRESSED;
+        compress_poor_cnt_ = 0;
+      } else {
+        // the data does not compress well, skip 2, 4, ... blocks before trying again
+        compress_poor_cnt_ = MIN(compress_poor_cnt_ + 1, MAX_COMPRESS_SKIP_SHIFT);
+        compress_skip_cnt_ = 1L << compress_poor_cnt_;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      if (!header->is_compressed()) {
+        MEMCPY(payload, blk->payload_, data_size);
+      }
+      header->payload_size_ = static_cast<uint32>(payload_size);
+      if (dump_checksum_) {
+        header->flag_ |= DumpHeader::CHECKSUM;
+        header->checksum_ = static_cast<int64_t>(ob_crc64(payload, payload_size));
+      }
+      if (OB_FAIL(write_file(compress_buf_, sizeof(DumpHeader) + payload_size))) {
+        LOG_WARN("write block to file failed", K(ret));
+      } else if (nullptr != callback_) {
+        callback_->dumped_raw(item->capacity());
+      }
+    }
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::clean_block(Block *clean_block)
 {
   int ret = OB_SUCCESS;
@@ -1957,6 +2089,157 @@ int ObChunkDatumStore::ChunkIterator::prefetch_next_blk()
   return ret;
 }
 
+int ObChunkDatumStore::ChunkIterator::read_next_dumped_blk()
+{
+  int ret = OB_SUCCESS;
+  char *data = NULL;
+  DumpHeader header;
+  Block *blk = NULL;
+  if (OB_FAIL(read_ahead(sizeof(header), data))) {
+    LOG_WARN("read dump header failed", K(ret));
+  } else {
+    // %data may be unaligned
+    MEMCPY(&header, data, sizeof(header));
+    if (!header.magic_check()
+        || header.data_size_ + BlockBuffer::HEAD_SIZE > header.blk_size_
+        || (!header.is_compressed() && header.payload_size_ != header.data_size_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("read corrupt data", K(ret), K(header), K(file_size_), K(read_ahead_pos()));
+    } else if (OB_FAIL(read_ahead(header.payload_size_, data))) {
+      LOG_WARN("read dumped block payload failed", K(ret), K(header));
+    } else if (header.has_checksum()
+        && header.checksum_ != static_cast<int64_t>(ob_crc64(data, header.payload_size_))) {
+      ret = OB_CHECKSUM_ERROR;
+      LOG_ERROR("dumped block checksum mismatch", K(ret), K(header), K(read_ahead_pos()));
+    } else if (OB_FAIL(alloc_block(blk, header.blk_size_ + sizeof(BlockBuffer)))) {
+      LOG_WARN("alloc block failed", K(ret), K(header));
+    } else {
+      BlockBuffer *blk_buf = blk->get_buffer();
+      blk->magic_ = Block::MAGIC;
+      blk->blk_size_ = header.blk_size_;
+      blk->rows_ = header.rows_;
+      if (header.is_compressed()) {
+        int64_t data_size = 0;
+        if (OB_ISNULL(store_->compressor_)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("compressor is null", K(ret), K(header));
+        } else if (OB_FAIL(store_->compressor_->decompress(data, header.payload_size_,
+                                                           blk->payload_, header.data_size_,
+                                                           data_size))) {
+          LOG_WARN("decompress block failed", K(ret), K(header));
+        } else if (data_size != header.data_size_) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("decompressed size mismatch", K(ret), K(data_size), K(header));
+        }
+      } else {
+        MEMCPY(blk->payload_, data, header.data_size_);
+      }
+      if (OB_FAIL(ret)) {
+        free_block(blk, blk_buf->mem_size(), true);
+      } else {
+        if (NULL != read_blk_) {
+          free_block(read_blk_, read_blk_buf_->mem_size());
+        }
+        read_blk_ = blk;
+        read_blk_buf_ = blk_buf;
+        if (OB_FAIL(read_blk_->swizzling(NULL))) {
+          LOG_WARN("swizzling failed", K(ret));
+        } else {
+          cur_chunk_n_blocks_ = 1;
+          cur_nth_blk_ += 1;
+          read_blk_->next_ = NULL;
+          cur_iter_blk_ = read_blk_;
+          chunk_n_rows_ = cur_iter_blk_->rows_;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+// Return %size bytes of the file from the read ahead buffers, %data is valid until next call.
+int ObChunkDatumStore::ChunkIterator::read_ahead(const int64_t size, char *&data)
+{
+  int ret = OB_SUCCESS;
+  int64_t copied = 0;
+  data = NULL;
+  if (ra_end_ - ra_pos_ >= size) {
+    data = ra_bufs_[ra_idx_] + ra_pos_;
+    ra_pos_ += size;
+  } else if (size > ra_copy_buf_size_) {
+    if (NULL != ra_copy_buf_) {
+      store_->allocator_->free(ra_copy_buf_);
+      store_->callback_free(ra_copy_buf_size_);
+      ra_copy_buf_size_ = 0;
+    }
+    if (OB_ISNULL(ra_copy_buf_ = static_cast<char *>(store_->alloc_blk_mem(size, true)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc memory failed", K(ret), K(size));
+    } else {
+      ra_copy_buf_size_ = size;
+    }
+  }
+  while (OB_SUCC(ret) && NULL == data) {
+    if (ra_pos_ < ra_end_) {
+      const int64_t len = MIN(size - copied, ra_end_ - ra_pos_);
+      MEMCPY(ra_copy_buf_ + copied, ra_bufs_[ra_idx_] + ra_pos_, len);
+      copied += len;
+      ra_pos_ += len;
+      if (copied == size) {
+        data = ra_copy_buf_;
+      }
+    } else if (0 == ra_pending_) {
+      if (cur_iter_pos_ >= file_size_) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected end of file", K(ret), K(size), K(copied), K(*this));
+      } else if (OB_FAIL(prefetch_read_ahead_buf())) {
+        LOG_WARN("prefetch read ahead buffer failed", K(ret));
+      }
+    } else if (OB_FAIL(aio_wait())) {
+      LOG_WARN("aio wait failed", K(ret));
+    } else {
+      // consume the loaded buffer and start reading the next part of file into the other one
+      ra_idx_ = 1 - ra_idx_;
+      ra_pos_ = 0;
+      ra_end_ = ra_pending_;
+      ra_pending_ = 0;
+      if (OB_FAIL(prefetch_read_ahead_buf())) {
+        LOG_WARN("prefetch read ahead buffer failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::ChunkIterator::prefetch_read_ahead_buf()
+{
+  int ret = OB_SUCCESS;
+  CK(0 == ra_pending_);
+  if (OB_FAIL(ret) || cur_iter_pos_ >= file_size_) {
+  } else {
+    if (NULL == ra_bufs_[0]) {
+      ra_buf_size_ = chunk_read_size_ > 0 ? chunk_read_size_ / 2 : READ_AHEAD_SIZE;
+      ra_buf_size_ = MIN(MAX(ra_buf_size_, default_block_size_), file_size_);
+      for (int64_t i = 0; OB_SUCC(ret) && i < 2; i++) {
+        if (OB_ISNULL(ra_bufs_[i] = static_cast<char *>(
+            store_->alloc_blk_mem(ra_buf_size_, true)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("alloc memory failed", K(ret), K(ra_buf_size_));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      const int64_t size = MIN(ra_buf_size_, file_size_ - cur_iter_pos_);
+      if (OB_FAIL(aio_read(ra_bufs_[1 - ra_idx_], size))) {
+        LOG_WARN("aio read failed", K(ret), K(size));
+      } else {
+        ra_pending_ = size;
+      }
+    }
+  }
+  return ret;
+}
+
 // assume we have written blk(0)~blk(9) to the datum store
 // blk(0)~blk(n) will be read from disk first,
 // blk(n+1)~blk(9) will be read from memory then.
@@ -1975,7 +2258,14 @@ int ObChunkDatumStore::ChunkIterator::load_next_block()
     LOG_WARN("row should be saved", K(ret), K_(cur_nth_blk), K_(store_->n_blocks));
   } else if (store_->is_file_open() && !read_file_iter_end()) {
     uint64_t begin_io_read_time = rdtsc();
-    if (chunk_read_size_ > store_->max_blk_size_) {
+    if (store_->dump_with_header_) {
+      // return at least one block when read file not end (!read_file_iter_end())
+      if (OB_FAIL(read_next_dumped_blk())) {
+        LOG_WARN("read next dumped blk failed", K(ret));
+      } else if (read_ahead_pos() >= file_size_) {
+        set_read_file_iter_end();
+      }
+    } else if (chunk_read_size_ > store_->max_blk_size_) {
       // may return OB_ITER_END when read file not end (!read_file_iter_end())
       if (OB_FAIL(store_->load_next_chunk_blocks(*this)) && OB_ITER_END != ret) {
         LOG_WARN("RowStore iter load next chunk blocks failed", K(ret));
@@ -2108,8 +2398,17 @@ ObChunkDatumStore::ChunkIterator::ChunkIterator()
     read_blk_buf_(NULL),
     aio_blk_(NULL),
     aio_blk_buf_(NULL),
+    ra_buf_size_(0),
+    ra_idx_(0),
+    ra_pos_(0),
+    ra_end_(0),
+    ra_pending_(0),
+    ra_copy_buf_(NULL),
+    ra_copy_buf_size_(0),
     age_(NULL)
 {
+  ra_bufs_[0] = NULL;
+  ra_bufs_[1] = NULL;
 }
 
 int ObChunkDatumStore::ChunkIterator::init(ObChunkDatumStore *store,
@@ -2157,6 +2456,25 @@ void ObChunkDatumStore::ChunkIterator::reset_cursor(const int64_t file_size)
   read_blk_ = NULL;
   read_blk_buf_ = NULL;
 
+  for (int64_t i = 0; i < 2; i++) {
+    if (NULL != ra_bufs_[i]) {
+      store_->allocator_->free(ra_bufs_[i]);
+      store_->callback_free(ra_buf_size_);
+      ra_bufs_[i] = NULL;
+    }
+  }
+  if (NULL != ra_copy_buf_) {
+    store_->allocator_->free(ra_copy_buf_);
+    store_->callback_free(ra_copy_buf_size_);
+    ra_copy_buf_ = NULL;
+  }
+  ra_buf_size_ = 0;
+  ra_copy_buf_size_ = 0;
+  ra_idx_ = 0;
+  ra_pos_ = 0;
+  ra_end_ = 0;
+  ra_pending_ = 0;
+
   while (NULL != cached_.get_first()) {
     free_block(cached_.remove_first(), default_block_size_, force_free);
   }
@@ -2883,6 +3201,11 @@ void ObChunkDatumStore::free_tmp_dump_blk()
     free_block(tmp_dump_blk_);
     tmp_dump_blk_ = nullptr;
   }
+  if (NULL != compress_buf_) {
+    free_blk_mem(compress_buf_, compress_buf_size_);
+    compress_buf_ = NULL;
+    compress_buf_size_ = 0;
+  }
 }
 
 } // end namespace sql
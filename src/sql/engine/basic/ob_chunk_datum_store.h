@@ -22,6 +22,7 @@
 #include "common/row/ob_row_iterator.h"
 #include "share/datum/ob_datum.h"
 #include "sql/engine/expr/ob_expr.h"
+#include "lib/compress/ob_compressor.h"
 #include "storage/blocksstable/ob_tmp_file.h"
 #include "sql/engine/basic/ob_sql_mem_callback.h"
 #include "sql/engine/basic/ob_batch_result_holder.h"
@@ -473,6 +474,31 @@ public:
     char payload_[0];
   } __attribute__((packed));
 
+  // Header of a block dumped with spill compression or checksum enabled. The payload of the
+  // block follows the header in file, compressed or not, instead of the whole block buffer.
+  struct DumpHeader
+  {
+    static const int64_t MAGIC = 0x5a3c7e1f90b2d46b;
+    static const int32_t COMPRESSED = 0x1;
+    static const int32_t CHECKSUM = 0x2;
+    DumpHeader() : magic_(MAGIC), blk_size_(0), rows_(0), data_size_(0), payload_size_(0),
+                   flag_(0), reserved_(0), checksum_(0) {}
+    inline bool magic_check() const { return MAGIC == magic_; }
+    inline bool is_compressed() const { return flag_ & COMPRESSED; }
+    inline bool has_checksum() const { return flag_ & CHECKSUM; }
+    TO_STRING_KV(K_(magic), K_(blk_size), K_(rows), K_(data_size), K_(payload_size), K_(flag),
+                 K_(checksum));
+
+    int64_t magic_;
+    uint32 blk_size_;     // blk_size_ of the block in memory
+    uint32 rows_;
+    uint32 data_size_;    // used size of block payload
+    uint32 payload_size_; // size of the payload in file
+    int32_t flag_;
+    int32_t reserved_;
+    int64_t checksum_;    // crc64 of the payload in file
+  };
+
   struct BlockList
   {
   public:
@@ -715,12 +741,19 @@ public:
 
      TO_STRING_KV(KP_(store), KP_(cur_iter_blk),
          K_(cur_chunk_n_blocks), K_(cur_iter_pos), K_(file_size), K_(chunk_read_size),
-         KP_(chunk_mem), KP_(read_blk), KP_(read_blk_buf), KP_(aio_blk), KP_(aio_blk_buf));
+         KP_(chunk_mem), KP_(read_blk), KP_(read_blk_buf), KP_(aio_blk), KP_(aio_blk_buf),
+         K_(ra_buf_size), K_(ra_idx), K_(ra_pos), K_(ra_end), K_(ra_pending));
   private:
      void reset_cursor(const int64_t file_size);
      int load_next_block();
      int prefetch_next_blk();
      int read_next_blk();
+     // read blocks dumped with DumpHeader
+     int read_next_dumped_blk();
+     int read_ahead(const int64_t size, char *&data);
+     int prefetch_read_ahead_buf();
+     int64_t read_ahead_pos() const
+     { return cur_iter_pos_ - ra_pending_ - (ra_end_ - ra_pos_); }
      int aio_read(char *buf, const int64_t size);
      int aio_wait();
      int alloc_block(Block *&blk, const int64_t size);
@@ -746,6 +779,18 @@ public:
     Block *aio_blk_; // not null means aio is reading.
     BlockBuffer *aio_blk_buf_;
 
+    // Blocks dumped with DumpHeader are variable sized, the file is read sequentially into two
+    // buffers: one is consumed while the next part of the file is read into the other.
+    char *ra_bufs_[2];
+    int64_t ra_buf_size_;
+    int64_t ra_idx_;      // the buffer being consumed
+    int64_t ra_pos_;
+    int64_t ra_end_;
+    int64_t ra_pending_;  // size of aio reading into the other buffer
+    // for data crossing the two buffers
+    char *ra_copy_buf_;
+    int64_t ra_copy_buf_size_;
+
     BlockList free_list_;
     // cached blocks for batch iterate
     BlockList cached_;
@@ -838,6 +883,10 @@ public:
 public:
   const static int64_t BLOCK_SIZE = (64L << 10);
   const static int64_t MIN_BLOCK_SIZE = (4L << 10);
+  const static int64_t READ_AHEAD_SIZE = (1L << 20);
+  // compression result larger than this percent of raw data is treated as poor
+  const static int64_t POOR_COMPRESS_PERCENT = 90;
+  const static int64_t MAX_COMPRESS_SKIP_SHIFT = 6;
   static const int32_t DATUM_SIZE = sizeof(common::ObDatum);
 
   explicit ObChunkDatumStore(common::ObIAllocator *alloc = NULL);
@@ -925,7 +974,9 @@ public:
   inline int64_t get_max_hold_mem() const { return max_hold_mem_; }
   inline int64_t get_file_fd() const { return io_.fd_; }
   inline int64_t get_file_dir_id() const { return io_.dir_id_; }
-  inline int64_t get_file_size() const { return file_size_; }
+  // size of the dumped blocks in memory, which is larger than the size on disk when dumped
+  // with compression
+  inline int64_t get_file_size() const { return raw_file_size_; }
   inline int64_t min_blk_size(const int64_t row_store_size)
   {
     int64_t size = std::max(default_block_size_, row_store_size);
@@ -951,7 +1002,11 @@ public:
   void set_dir_id(int64_t dir_id) { io_.dir_id_ = dir_id; }
   int alloc_dir_id();
   TO_STRING_KV(K_(tenant_id), K_(label), K_(ctx_id),  K_(mem_limit),
-      K_(row_cnt), K_(file_size), K_(enable_dump));
+      K_(row_cnt), K_(file_size), K_(raw_file_size), K_(dump_with_header), K_(enable_dump));
+
+  // dump with @compressor_type and @checksum instead of the tenant config, must be called
+  // before the first block is dumped
+  int set_dump_format(const common::ObCompressorType compressor_type, const bool checksum);
 
   int append_datum_store(const ObChunkDatumStore &other_store);
   int assign(const ObChunkDatumStore &other_store);
@@ -1007,6 +1062,9 @@ private:
       mem_used_ += used;
     }
   inline int dump_one_block(BlockBuffer *item);
+  // decide the dump format by tenant config
+  int init_dump_format();
+  int dump_one_block_with_header(BlockBuffer *item);
 
   int write_file(void *buf, int64_t size);
   int read_file(
@@ -1102,6 +1160,19 @@ private:
   BatchCtx *batch_ctx_;
   Block *tmp_dump_blk_;
 
+  // spill compression and checksum, decided by tenant config or set_dump_format() before the
+  // first dump
+  int64_t raw_file_size_;
+  bool dump_format_inited_;
+  bool dump_with_header_;
+  bool dump_checksum_;
+  common::ObCompressor *compressor_;
+  char *compress_buf_;
+  int64_t compress_buf_size_;
+  // blocks to dump without compression, after compression ratio is poor
+  int64_t compress_skip_cnt_;
+  int64_t compress_poor_cnt_;
+
   DISALLOW_COPY_AND_ASSIGN(ObChunkDatumStore);
 };
 
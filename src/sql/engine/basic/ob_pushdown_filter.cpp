@@ -14,6 +14,7 @@
 #include "ob_pushdown_filter.h"
 #include "sql/engine/ob_physical_plan.h"
 #include "sql/engine/ob_exec_context.h"
+#include "sql/engine/expr/ob_expr_join_filter.h"
 #include "sql/resolver/expr/ob_raw_expr_util.h"
 #include "sql/code_generator/ob_static_engine_cg.h"
 #include "storage/blocksstable/encoding/ob_encoding_query_util.h"
@@ -1046,6 +1047,13 @@ ObBlackFilterExecutor::~ObBlackFilterExecutor()
   }
 }
 
+int ObBlackFilterExecutor::get_join_key_range(
+    const ObExpr &expr,
+    const common::ObJoinKeyRange *&key_range)
+{
+  return ObExprJoinFilter::get_key_range(expr, op_.get_eval_ctx(), key_range);
+}
+
 int ObBlackFilterExecutor::filter(ObEvalCtx &eval_ctx, bool &filtered)
 {
   int ret = OB_SUCCESS;
@@ -18,6 +18,7 @@
 #include "lib/hash/ob_hashset.h"
 #include "common/object/ob_obj_compare.h"
 #include "share/datum/ob_datum.h"
+#include "share/datum/ob_join_key_range.h"
 #include "sql/engine/expr/ob_expr.h"
 #include "sql/engine/ob_operator.h"
 
@@ -398,6 +399,8 @@ public:
   ~ObBlackFilterExecutor();
 
   OB_INLINE ObPushdownBlackFilterNode &get_filter_node() { return filter_; }
+  // key range of the runtime join filter @expr, null if it is not ready or not usable
+  int get_join_key_range(const ObExpr &expr, const common::ObJoinKeyRange *&key_range);
   OB_INLINE virtual common::ObIArray<uint64_t> &get_col_ids() override
   { return filter_.get_col_ids(); }
   int filter(common::ObObj *objs, int64_t col_cnt, bool &ret_val);
@@ -28,6 +28,9 @@ public:
   virtual void alloc(int64_t size) = 0;
   virtual void free(int64_t size) = 0;
   virtual void dumped(int64_t size) = 0;
+  // size of dumped data before compression, reported with dumped() when spill compression
+  // is enabled
+  virtual void dumped_raw(int64_t size) { UNUSED(size); }
 };
 
 } // end namespace sql
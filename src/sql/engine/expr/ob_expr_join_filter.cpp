@@ -123,12 +123,19 @@ int ObExprJoinFilter::eval_bloom_filter(const ObExpr &expr, ObEvalCtx &ctx,
             hash_val = hash_func.hash_func_(*datum, hash_val);
           }
         }
-        if (OB_SUCC(ret)) {
-          if (OB_FAIL(bloom_filter_ptr_->might_contain(hash_val, is_match))) {
-            LOG_WARN("fail to check filter might contain value", K(ret), K(hash_val));
-          } else {
-            join_filter_ctx->check_count_++;
-          }
+        const ObPxBFKeyRange *key_range = get_usable_key_range(expr, *bloom_filter_ptr_);
+        if (OB_FAIL(ret)) {
+        } else if (OB_NOT_NULL(key_range) &&
+                   !key_range->might_contain(*datum, expr.args_[0]->basic_funcs_->null_first_cmp_)) {
+          is_match = false;
+          join_filter_ctx->check_count_++;
+        } else if (OB_NOT_NULL(key_range) && key_range->has_in_set()) {
+          // the in set holds every build side value, no need to probe the bloom filter
+          join_filter_ctx->check_count_++;
+        } else if (OB_FAIL(bloom_filter_ptr_->might_contain(hash_val, is_match))) {
+          LOG_WARN("fail to check filter might contain value", K(ret), K(hash_val));
+        } else {
+          join_filter_ctx->check_count_++;
         }
       }
     }
@@ -229,13 +236,37 @@ int ObExprJoinFilter::eval_bloom_filter_batch(
             }
           }
         }
-        if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
+        const ObPxBFKeyRange *key_range = get_usable_key_range(expr, *bloom_filter_ptr_);
+        const ObDatum *key_datums = expr.args_[0]->locate_batch_datums(ctx);
+        const bool is_batch_key = expr.args_[0]->is_batch_result();
+        ObDatumCmpFuncType cmp_func = expr.args_[0]->basic_funcs_->null_first_cmp_;
+        if (OB_FAIL(ret)) {
+        } else if (OB_NOT_NULL(key_range) && key_range->has_in_set()) {
+          // the in set holds every build side value, no need to probe the bloom filter
+          if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
+              [&](int64_t idx) __attribute__((always_inline)) {
+                is_match = key_range->might_contain(key_datums[is_batch_key ? idx : 0], cmp_func);
+                ++join_filter_ctx->check_count_;
+                ++join_filter_ctx->total_count_;
+                join_filter_ctx->filter_count_ += !is_match;
+                eval_flags.set(idx);
+                results[idx].set_int(is_match);
+                return OB_SUCCESS;
+              }))) {
+            LOG_WARN("failed to check key range", K(ret));
+          }
+        } else if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
               [&](int64_t idx) __attribute__((always_inline)) {
                 bloom_filter_ptr_->prefetch_bits_block(hash_values[idx]); return OB_SUCCESS;
               }))) {
         } else if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
             [&](int64_t idx) __attribute__((always_inline)) {
-              ret = bloom_filter_ptr_->might_contain(hash_values[idx], is_match);
+              if (OB_NOT_NULL(key_range) &&
+                  !key_range->might_contain(key_datums[is_batch_key ? idx : 0], cmp_func)) {
+                is_match = false;
+              } else {
+                ret = bloom_filter_ptr_->might_contain(hash_values[idx], is_match);
+              }
               ++join_filter_ctx->check_count_;
               ++join_filter_ctx->total_count_;
               join_filter_ctx->filter_count_ += !is_match;
@@ -262,6 +293,44 @@ int ObExprJoinFilter::eval_bloom_filter_batch(
   return ret;
 }
 
+const ObPxBFKeyRange *ObExprJoinFilter::get_usable_key_range(const ObExpr &expr,
+                                                              const ObPxBloomFilter &bloom_filter)
+{
+  const ObPxBFKeyRange *key_range = &bloom_filter.get_key_range();
+  if (1 != expr.arg_cnt_ || !key_range->is_valid() ||
+      key_range->get_type() != expr.args_[0]->datum_meta_.type_ ||
+      OB_ISNULL(expr.args_[0]->basic_funcs_)) {
+    key_range = NULL;
+  }
+  return key_range;
+}
+
+int ObExprJoinFilter::get_key_range(const ObExpr &expr, ObEvalCtx &ctx,
+                                    const ObPxBFKeyRange *&key_range)
+{
+  int ret = OB_SUCCESS;
+  ObExprJoinFilterContext *join_filter_ctx = NULL;
+  key_range = NULL;
+  if (T_OP_JOIN_BLOOM_FILTER != expr.type_) {
+  } else if (OB_ISNULL(join_filter_ctx = static_cast<ObExprJoinFilterContext *>(
+             ctx.exec_ctx_.get_expr_op_ctx(expr.expr_ctx_id_)))) {
+    // join filter ctx may be null in das.
+  } else {
+    ObPxBloomFilter *&bloom_filter_ptr_ = join_filter_ctx->bloom_filter_ptr_;
+    if (OB_ISNULL(bloom_filter_ptr_)) {
+      if (OB_FAIL(ObPxBloomFilterManager::instance().get_px_bloom_filter(join_filter_ctx->bf_key_,
+            bloom_filter_ptr_))) {
+        ret = OB_SUCCESS;
+      }
+    }
+    if (OB_NOT_NULL(bloom_filter_ptr_) &&
+        (join_filter_ctx->is_ready_ || bloom_filter_ptr_->check_ready())) {
+      key_range = get_usable_key_range(expr, *bloom_filter_ptr_);
+    }
+  }
+  return ret;
+}
+
 int ObExprJoinFilter::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const
 {
@@ -50,12 +50,17 @@ public:
   static int eval_bloom_filter(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res);
   static int eval_bloom_filter_batch(
              const ObExpr &expr, ObEvalCtx &ctx, const ObBitVector &skip, const int64_t batch_size);
+  // key range of the ready join filter of @expr, null if there is none usable on its only arg,
+  // so that storage can skip micro blocks by it
+  static int get_key_range(const ObExpr &expr, ObEvalCtx &ctx, const ObPxBFKeyRange *&key_range);
   virtual int cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   virtual bool need_rt_ctx() const override { return true; }
   // hard code seed, 32 bit max prime number
   static const int64_t JOIN_FILTER_SEED = 4294967279;
 private:
+  static const ObPxBFKeyRange *get_usable_key_range(const ObExpr &expr,
+                                                     const ObPxBloomFilter &bloom_filter);
   static const int64_t CHECK_TIMES = 127;
   DISALLOW_COPY_AND_ASSIGN(ObExprJoinFilter);
 };
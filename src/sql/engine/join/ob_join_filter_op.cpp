@@ -194,7 +194,8 @@ ObJoinFilterOp::ObJoinFilterOp(ObExecContext &exec_ctx, const ObOpSpec &spec, Ob
     filter_use_(NULL),
     filter_create_(NULL),
     bf_ch_sets_(NULL),
-    batch_hash_values_(NULL)
+    batch_hash_values_(NULL),
+    key_range_()
 {
 }
 
@@ -231,6 +232,15 @@ int ObJoinFilterOp::inner_open()
       ret = OB_NOT_INIT;
       LOG_WARN("the bloom filter is not init", K(ret));
     }
+    if (OB_SUCC(ret)) {
+      // min/max and in set are kept for a single join key of fixed length type only
+      if (MY_SPEC.is_partition_filter() || 1 != MY_SPEC.join_keys_.count() ||
+          !ObPxBFKeyRange::is_supported_type(MY_SPEC.join_keys_.at(0)->obj_datum_map_)) {
+        key_range_.invalidate();
+      } else {
+        key_range_.reset();
+      }
+    }
     if (OB_SUCC(ret) && MY_SPEC.max_batch_size_ > 0) {
       if (OB_ISNULL(batch_hash_values_ =
               (uint64_t *)ctx_.get_allocator().alloc(sizeof(uint64_t) * MY_SPEC.max_batch_size_))) {
@@ -278,6 +288,9 @@ int ObJoinFilterOp::do_create_filter_rescan()
     LOG_WARN("filter create is unexpected", K(ret));
   } else {
     filter_create_->reset_filter();
+    if (!key_range_.is_invalid()) {
+      key_range_.reset();
+    }
   }
   return ret;
 }
@@ -322,7 +335,9 @@ int ObJoinFilterOp::inner_get_next_row()
         // 说明本 sqc 上的 filter 数据已经收集完毕，可以执行发送。
         // 对于local filter计划, 将filter写入manager
         // 对于shuffle filter计划, 将filter信息写入exec_ctx,由recieve算子发送rpc.
-        if (OB_FAIL(filter_input_->check_finish(all_is_finished, MY_SPEC.is_shared_join_filter()))) {
+        if (OB_FAIL(filter_create_->merge_key_range(key_range_))) {
+          LOG_WARN("fail to merge key range", K(ret));
+        } else if (OB_FAIL(filter_input_->check_finish(all_is_finished, MY_SPEC.is_shared_join_filter()))) {
           LOG_WARN("fail to check all worker end", K(ret));
         } else if (all_is_finished && OB_FAIL(send_filter())) {
           LOG_WARN("fail to send bloom filter to use filter", K(ret));
@@ -412,7 +427,9 @@ int ObJoinFilterOp::inner_get_next_batch(const int64_t max_row_cnt)
   if (OB_SUCC(ret) && brs_.end_) {
     if (MY_SPEC.is_create_mode()) {
       bool all_is_finished = false;
-      if (OB_FAIL(filter_input_->check_finish(all_is_finished, MY_SPEC.is_shared_join_filter()))) {
+      if (OB_FAIL(filter_create_->merge_key_range(key_range_))) {
+        LOG_WARN("fail to merge key range", K(ret));
+      } else if (OB_FAIL(filter_input_->check_finish(all_is_finished, MY_SPEC.is_shared_join_filter()))) {
         LOG_WARN("fail to check all worker end", K(ret));
       } else if (all_is_finished && OB_FAIL(send_filter())) {
         LOG_WARN("fail to send bloom filter to use filter", K(ret));
@@ -579,6 +596,22 @@ int ObJoinFilterOp::insert_by_row()
     /*do nothing*/
   } else if (OB_FAIL(filter_create_->put(hash_value))) {
     LOG_WARN("fail to put  hash value to px bloom filter", K(ret));
+  } else if (!key_range_.is_invalid() &&
+             OB_FAIL(add_key_range(MY_SPEC.join_keys_.at(0)->locate_expr_datum(eval_ctx_)))) {
+    LOG_WARN("fail to add key range", K(ret));
+  }
+  return ret;
+}
+
+int ObJoinFilterOp::add_key_range(const ObDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  ObObj obj;
+  const ObExpr *expr = MY_SPEC.join_keys_.at(0);
+  if (OB_FAIL(datum.to_obj(obj, expr->obj_meta_, expr->obj_datum_map_))) {
+    LOG_WARN("fail to convert datum to obj", K(ret), K(datum));
+  } else if (OB_FAIL(key_range_.add(obj))) {
+    LOG_WARN("fail to add key to range", K(ret), K(obj));
   }
   return ret;
 }
@@ -632,6 +665,11 @@ int ObJoinFilterOp::insert_by_row_batch(const ObBatchRows *child_brs)
           continue;
         } else if (OB_FAIL(filter_create_->put(batch_hash_values_[i]))) {
           LOG_WARN("fail to put  hash value to px bloom filter", K(ret));
+        } else if (!key_range_.is_invalid()) {
+          ObExpr *expr = MY_SPEC.join_keys_.at(0);
+          if (OB_FAIL(add_key_range(expr->locate_batch_datums(eval_ctx_)[expr->is_batch_result() ? i : 0]))) {
+            LOG_WARN("fail to add key range", K(ret));
+          }
         }
       }
     }
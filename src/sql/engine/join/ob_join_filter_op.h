@@ -150,6 +150,7 @@ private:
 
   int insert_by_row();
   int insert_by_row_batch(const ObBatchRows *child_brs);
+  int add_key_range(const common::ObDatum &datum);
   int check_contain_row(bool &match);
   int calc_hash_value(uint64_t &hash_value, bool &ignore);
   int calc_hash_value(uint64_t &hash_value);
@@ -161,6 +162,8 @@ public:
   ObPxBloomFilter *filter_create_;
   ObPxBloomFilterChSets *bf_ch_sets_;
   uint64_t *batch_hash_values_;
+  // bounds of the join key seen by this worker, merged into filter_create_ when the child ends
+  ObPxBFKeyRange key_range_;
 };
 
 }
@@ -117,6 +117,7 @@ ObPhysicalPlan::ObPhysicalPlan(MemoryContext &mem_context /* = CURRENT_CONTEXT *
     ddl_table_id_(0),
     ddl_execution_id_(-1),
     ddl_task_id_(0),
+    weak_read_max_staleness_(0),
     is_packed_(false),
     has_instead_of_trigger_(false)
 {
@@ -200,6 +201,7 @@ void ObPhysicalPlan::reset()
   contain_pl_udf_or_trigger_ = false;
   is_packed_ = false;
   has_instead_of_trigger_ = false;
+  weak_read_max_staleness_ = 0;
   stat_.expected_worker_map_.destroy();
   stat_.minimal_worker_map_.destroy();
 }
@@ -743,7 +745,8 @@ OB_SERIALIZE_MEMBER(ObPhysicalPlan,
                     is_plain_insert_,
                     ddl_execution_id_,
                     ddl_task_id_,
-                    stat_.plan_id_);
+                    stat_.plan_id_,
+                    weak_read_max_staleness_);
 
 int ObPhysicalPlan::set_table_locations(const ObTablePartitionInfoArray &infos,
                                         ObSchemaGetterGuard &schema_guard)
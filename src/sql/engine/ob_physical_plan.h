@@ -335,6 +335,8 @@ public:
   inline int64_t get_ddl_execution_id() const { return ddl_execution_id_; }
   inline void set_ddl_task_id(const int64_t ddl_task_id) { ddl_task_id_ = ddl_task_id; }
   inline int64_t get_ddl_task_id() const { return ddl_task_id_; }
+  inline void set_weak_read_max_staleness(const int64_t staleness) { weak_read_max_staleness_ = staleness; }
+  inline int64_t get_weak_read_max_staleness() const { return weak_read_max_staleness_; }
 public:
   int inc_concurrent_num();
   void dec_concurrent_num();
@@ -586,6 +588,9 @@ public:
   int64_t ddl_table_id_;
   int64_t ddl_execution_id_;
   int64_t ddl_task_id_;
+  // weak read snapshot is chosen from the replay progress of the local log
+  // streams touched if it is no more stale than this (us), 0 means disabled
+  int64_t weak_read_max_staleness_;
   //parallel encoding of output_expr in advance to speed up packet response
   bool is_packed_;
   bool has_instead_of_trigger_; // mask if has instead of trigger on view
@@ -118,6 +118,12 @@ public:
       mem_callback_->dumped(size);
     }
   }
+
+  void dumped_raw(int64_t size)
+  {
+    op_monitor_info_.otherstat_5_id_ = ObSqlMonitorStatIds::MEMORY_DUMP_RAW;
+    op_monitor_info_.otherstat_5_value_ += size;
+  }
   int64_t get_dumped_size() const { return profile_.dumped_size_; }
   void reset_delta_size() { profile_.delta_size_ = 0; }
   void reset_mem_used() { profile_.mem_used_ = 0; }
@@ -37,7 +37,8 @@ using namespace obrpc;
 
 ObPxBloomFilter::ObPxBloomFilter() : data_length_(0), bits_count_(0), fpp_(0.0),
     hash_func_count_(0), is_inited_(false), bits_array_length_(0),
-    bits_array_(NULL), true_count_(0), begin_idx_(0), end_idx_(0), allocator_(),
+    bits_array_(NULL), true_count_(0), begin_idx_(0), end_idx_(0), key_range_(),
+    key_range_lock_(), allocator_(),
     px_bf_recieve_count_(0), px_bf_recieve_size_(0), px_bf_merge_filter_count_(0)
 {
 
@@ -93,12 +94,15 @@ int ObPxBloomFilter::init(ObPxBloomFilter *filter)
     bits_array_ = filter->bits_array_;
     true_count_ = filter->true_count_;
     might_contain_ = filter->might_contain_;
+    ObSpinLockGuard guard(filter->key_range_lock_);
+    key_range_ = filter->key_range_;
   }
   return ret;
 }
 void ObPxBloomFilter::reset_filter()
 {
   MEMSET(bits_array_, 0, bits_array_length_ * sizeof(int64_t));
+  key_range_.reset();
   px_bf_recieve_count_ = 0;
   px_bf_recieve_size_ = 0;
 }
@@ -203,10 +207,20 @@ int ObPxBloomFilter::merge_filter(ObPxBloomFilter *filter)
         new_v = old_v | filter->bits_array_[i];
       } while(ATOMIC_CAS(&bits_array_[i + filter->begin_idx_], old_v, new_v) != old_v);
     }
+    // every piece of a filter carries the whole key range of its sender
+    if (OB_FAIL(merge_key_range(filter->key_range_))) {
+      LOG_WARN("fail to merge key range", K(ret));
+    }
   }
   return ret;
 }
 
+int ObPxBloomFilter::merge_key_range(const ObPxBFKeyRange &key_range)
+{
+  ObSpinLockGuard guard(key_range_lock_);
+  return key_range_.merge(key_range);
+}
+
 bool ObPxBloomFilter::check_ready()
 {
   return px_bf_recieve_count_ > 0 &&
@@ -320,6 +334,7 @@ OB_DEF_SERIALIZE(ObPxBloomFilter)
       LOG_WARN("fail to encode bits data", K(ret), K(bits_array_[i]));
     }
   }
+  OB_UNIS_ENCODE(key_range_);
   return ret;
 }
 
@@ -358,6 +373,12 @@ OB_DEF_DESERIALIZE(ObPxBloomFilter)
                        : &ObPxBloomFilter::might_contain_nonsimd;
     }
   }
+  // filters of older versions carry no key range
+  if (OB_SUCC(ret) && pos < data_len) {
+    OB_UNIS_DECODE(key_range_);
+  } else {
+    key_range_.invalidate();
+  }
   return ret;
 }
 
@@ -377,6 +398,7 @@ OB_DEF_SERIALIZE_SIZE(ObPxBloomFilter)
   for (int i = begin_idx_; i <= end_idx_; ++i) {
     len += serialization::encoded_length(bits_array_[i]);
   }
+  OB_UNIS_ADD_LEN(key_range_);
   return len;
 }
 
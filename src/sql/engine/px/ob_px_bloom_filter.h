@@ -17,6 +17,7 @@
 #include "lib/hash/ob_hashmap.h"
 #include "lib/container/ob_se_array.h"
 #include "lib/lock/ob_spin_lock.h"
+#include "share/datum/ob_join_key_range.h"
 #include "share/config/ob_server_config.h"
 #include "observer/ob_server_struct.h"
 #ifndef __SQL_ENG_PX_BLOOM_FILTER_H__
@@ -52,6 +53,8 @@ struct BloomFilterIndex
   TO_STRING_KV(K_(begin_idx), K_(end_idx));
 };
 
+typedef common::ObJoinKeyRange ObPxBFKeyRange;
+
 class ObPxBloomFilter
 {
 OB_UNIS_VERSION_V(1);
@@ -67,6 +70,8 @@ public:
   int put(uint64_t hash);
   int put_batch(ObPxBFHashArray &hash_val_array);
   int merge_filter(ObPxBloomFilter *filter);
+  int merge_key_range(const ObPxBFKeyRange &key_range);
+  const ObPxBFKeyRange &get_key_range() const { return key_range_; }
   int64_t get_value_true_count() const { return true_count_; };
   void dump_filter();      //for debug
   bool check_ready();
@@ -90,7 +95,7 @@ public:
   int generate_receive_count_array();
   void reset();
   TO_STRING_KV(K_(data_length), K_(bits_count), K_(fpp), K_(hash_func_count), K_(is_inited),
-      K_(bits_array_length), K_(true_count));
+      K_(bits_array_length), K_(true_count), K_(key_range));
 private:
   bool get(uint64_t pos, uint64_t index) { return (bits_array_[pos] & index) != 0; }
   bool set(uint64_t block_begin, uint64_t index);
@@ -111,6 +116,8 @@ private:
   int64_t begin_idx_;            // join filter begin position
   int64_t end_idx_;              // join filter end position
   GetFunc might_contain_;       // function pointer for might contain
+  ObPxBFKeyRange key_range_;     // bounds of the join key, merged along with the bits
+  common::ObSpinLock key_range_lock_;
 private:
   common::ObArenaAllocator allocator_;
 public:
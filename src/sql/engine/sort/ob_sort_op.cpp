@@ -16,6 +16,7 @@
 #include "sql/engine/px/ob_px_util.h"
 #include "sql/engine/aggregate/ob_hash_groupby_op.h"
 #include "sql/engine/window_function/ob_window_function_op.h"
+#include "sql/engine/table/ob_table_scan_op.h"
 
 namespace oceanbase
 {
@@ -61,6 +62,7 @@ ObSortOp::ObSortOp(ObExecContext &ctx_, const ObOpSpec &spec, ObOpInput *input)
   sort_impl_(),
   prefix_sort_impl_(),
   topn_sort_(),
+  topn_filter_(),
   read_func_(&ObSortOp::sort_impl_next),
   read_batch_func_(&ObSortOp::sort_impl_next_batch),
   sort_row_count_(0),
@@ -91,6 +93,7 @@ void ObSortOp::reset()
   sort_impl_.reset();
   prefix_sort_impl_.reset();
   topn_sort_.reset();
+  topn_filter_.reset();
   read_func_ = &ObSortOp::sort_impl_next;
   read_batch_func_ = &ObSortOp::sort_impl_next_batch;
   sort_row_count_ = 0;
@@ -105,6 +108,7 @@ void ObSortOp::destroy()
   prefix_sort_impl_.unregister_profile_if_necessary();
   prefix_sort_impl_.~ObPrefixSortImpl();
   topn_sort_.~ObInMemoryTopnSortImpl();
+  topn_filter_.destroy();
   read_func_ = nullptr;
   read_batch_func_ = nullptr;
   sort_row_count_ = 0;
@@ -261,6 +265,48 @@ int ObSortOp::process_sort()
   return ret;
 }
 
+int ObSortOp::init_topn_filter()
+{
+  int ret = OB_SUCCESS;
+  ObOperator *op = child_;
+  while (NULL != op && PHY_GRANULE_ITERATOR == op->get_spec().type_) {
+    op = op->get_child();
+  }
+  if (NULL == op || PHY_TABLE_SCAN != op->get_spec().type_
+      || MY_SPEC.part_cnt_ > 0 || MY_SPEC.sort_collations_.empty()) {
+    // only rows read directly from a table scan are filtered
+  } else {
+    const ObSortFieldCollation &collation = MY_SPEC.sort_collations_.at(0);
+    const ObExpr *key_expr = MY_SPEC.all_exprs_.at(collation.field_idx_);
+    bool is_set = false;
+    if (T_REF_COLUMN != key_expr->type_) {
+      // key evaluated above the scan
+    } else if (OB_FAIL(topn_filter_.init(ctx_.get_my_session()->get_effective_tenant_id(),
+                                         key_expr, collation, MY_SPEC.sort_cmp_funs_.at(0)))) {
+      LOG_WARN("failed to init topn filter", K(ret));
+    } else if (OB_FAIL(static_cast<ObTableScanOp *>(op)->set_topn_filter(&topn_filter_,
+                                                                          is_set))) {
+      LOG_WARN("failed to set topn filter", K(ret));
+    } else if (!is_set) {
+      topn_filter_.destroy();
+    }
+  }
+  return ret;
+}
+
+int ObSortOp::update_topn_filter()
+{
+  int ret = OB_SUCCESS;
+  const ObChunkDatumStore::StoredRow *top = NULL;
+  if (!topn_filter_.is_inited() || OB_ISNULL(top = topn_sort_.get_heap_top())) {
+    // no table scan to filter or heap is not full yet
+  } else if (OB_FAIL(topn_filter_.update(
+      top->cells()[MY_SPEC.sort_collations_.at(0).field_idx_]))) {
+    LOG_WARN("failed to update topn filter", K(ret));
+  }
+  return ret;
+}
+
 int ObSortOp::process_sort_batch()
 {
   int ret = OB_SUCCESS;
@@ -286,6 +332,7 @@ int ObSortOp::process_sort_batch()
                 - input_brs->skip_->accumulate_bit_cnt(input_brs->size_);
             OZ(topn_sort_.add_batch(
                     MY_SPEC.all_exprs_, *input_brs->skip_, input_brs->size_, need_sort));
+            OZ(update_topn_filter());
             // Topn prefix sort may stop get child rows and start output rows,
             // when enough row fetched. Since no more rows from child needed, there is no
             // expression datum overwrite problem here.
@@ -553,6 +600,9 @@ int ObSortOp::inner_get_next_batch(const int64_t max_row_cnt)
         &MY_SPEC.sort_cmp_funs_, &eval_ctx_, &ctx_));
       topn_sort_.set_fetch_with_ties(MY_SPEC.is_fetch_with_ties_);
       read_batch_func_ = &ObSortOp::topn_sort_next_batch;
+      if (OB_SUCC(ret) && !topn_filter_.is_inited() && OB_FAIL(init_topn_filter())) {
+        LOG_WARN("failed to init topn filter", K(ret));
+      }
     } else if (MY_SPEC.prefix_pos_ > 0) {
       OZ(prefix_sort_impl_.init(tenant_id, MY_SPEC.prefix_pos_, MY_SPEC.all_exprs_,
           &MY_SPEC.sort_collations_, &MY_SPEC.sort_cmp_funs_, &eval_ctx_, child_,
@@ -18,6 +18,7 @@
 #include "common/object/ob_object.h"
 #include "share/datum/ob_datum_funcs.h"
 #include "sql/engine/sort/ob_sort_basic_info.h"
+#include "sql/engine/sort/ob_topn_filter.h"
 
 namespace oceanbase
 {
@@ -127,6 +128,9 @@ private:
 
   int get_int_value(const ObExpr *in_val, int64_t &out_val);
   int get_topn_count(int64_t &topn_cnt);
+  // publish the boundary of the topn heap to the table scan below, if any
+  int init_topn_filter();
+  int update_topn_filter();
   int process_sort();
   int process_sort_batch();
   int scan_all_then_sort();
@@ -135,6 +139,7 @@ private:
   ObSortOpImpl sort_impl_;
   ObPrefixSortImpl prefix_sort_impl_;
   ObInMemoryTopnSortImpl topn_sort_;
+  ObTopnFilter topn_filter_;
   int (ObSortOp::*read_func_)();
   int (ObSortOp::*read_batch_func_)(const int64_t max_cnt);
   int64_t sort_row_count_;
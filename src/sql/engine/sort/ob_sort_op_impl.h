@@ -177,6 +177,10 @@ public:
   {
     info.otherstat_6_id_ = op_monitor_info_.otherstat_6_id_;
     info.otherstat_6_value_ = op_monitor_info_.otherstat_6_value_;
+    if (ObSqlMonitorStatIds::MEMORY_DUMP_RAW == op_monitor_info_.otherstat_5_id_) {
+      info.otherstat_5_id_ = op_monitor_info_.otherstat_5_id_;
+      info.otherstat_5_value_ = op_monitor_info_.otherstat_5_value_;
+    }
   }
   inline void set_io_event_observer(ObIOEventObserver *observer)
   {
@@ -643,6 +647,9 @@ public:
   inline  int64_t get_row_count() const;
   void set_topn(int64_t topn) { topn_cnt_ = topn; }
   int64_t get_topn_cnt() { return topn_cnt_; }
+  // worst row kept by the heap once it is full, null before
+  const ObChunkDatumStore::StoredRow *get_heap_top()
+  { return (topn_cnt_ > 0 && heap_.count() >= topn_cnt_) ? heap_.top() : NULL; }
   inline void set_fetch_with_ties(bool is_fetch_with_ties)
   { is_fetch_with_ties_ = is_fetch_with_ties; }
   //TO_STRING_KV(K_(sort_array_pos));
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/sort/ob_topn_filter.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+ObTopnFilter::ObTopnFilter()
+  : is_inited_(false),
+    is_ready_(false),
+    is_ascending_(true),
+    tenant_id_(OB_INVALID_TENANT_ID),
+    key_expr_(NULL),
+    cmp_func_(NULL),
+    boundary_(),
+    buf_(NULL),
+    buf_size_(0),
+    update_cnt_(0),
+    filter_cnt_(0)
+{
+}
+
+int ObTopnFilter::init(const uint64_t tenant_id,
+                       const ObExpr *key_expr,
+                       const ObSortFieldCollation &sort_collation,
+                       const ObSortCmpFunc &sort_cmp_func)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("topn filter has been inited", K(ret));
+  } else if (OB_ISNULL(key_expr) || OB_ISNULL(sort_cmp_func.cmp_func_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(key_expr), KP(sort_cmp_func.cmp_func_));
+  } else {
+    tenant_id_ = tenant_id;
+    key_expr_ = key_expr;
+    cmp_func_ = sort_cmp_func.cmp_func_;
+    is_ascending_ = sort_collation.is_ascending_;
+    is_ready_ = false;
+    update_cnt_ = 0;
+    filter_cnt_ = 0;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObTopnFilter::reset()
+{
+  is_ready_ = false;
+  boundary_.set_null();
+}
+
+void ObTopnFilter::destroy()
+{
+  if (NULL != buf_) {
+    ob_free(buf_);
+    buf_ = NULL;
+  }
+  buf_size_ = 0;
+  boundary_.set_null();
+  key_expr_ = NULL;
+  cmp_func_ = NULL;
+  is_ready_ = false;
+  is_inited_ = false;
+}
+
+int ObTopnFilter::update(const ObDatum &key)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("topn filter is not inited", K(ret));
+  } else if (is_ready_ && 0 == cmp_func_(key, boundary_)) {
+    // heap top changed, but the first key did not
+  } else {
+    const int64_t len = key.is_null() ? 0 : key.len_;
+    if (len > buf_size_ || NULL == buf_) {
+      const int64_t new_size = MAX(len, MAX(buf_size_ * 2, 64));
+      char *new_buf = NULL;
+      if (OB_ISNULL(new_buf = static_cast<char *>(
+          ob_malloc(new_size, ObMemAttr(tenant_id_, "SqlTopnFilter"))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret), K(new_size));
+      } else {
+        if (NULL != buf_) {
+          ob_free(buf_);
+        }
+        buf_ = new_buf;
+        buf_size_ = new_size;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      int64_t pos = 0;
+      if (OB_FAIL(boundary_.deep_copy(key, buf_, buf_size_, pos))) {
+        LOG_WARN("deep copy boundary failed", K(ret), K(key));
+        is_ready_ = false;
+      } else {
+        is_ready_ = true;
+        ++update_cnt_;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObTopnFilter::filter_batch(ObEvalCtx &eval_ctx, ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("topn filter is not inited", K(ret));
+  } else if (!is_ready_) {
+    // heap is not full yet
+  } else if (OB_FAIL(key_expr_->eval_batch(eval_ctx, skip, batch_size))) {
+    LOG_WARN("eval topn filter key failed", K(ret));
+  } else {
+    const ObDatum *datums = key_expr_->locate_batch_datums(eval_ctx);
+    const bool is_batch_result = key_expr_->is_batch_result();
+    for (int64_t i = 0; i < batch_size; ++i) {
+      if (skip.at(i)) {
+        continue;
+      } else if (can_filter(datums[is_batch_result ? i : 0])) {
+        skip.set(i);
+        ++filter_cnt_;
+      }
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
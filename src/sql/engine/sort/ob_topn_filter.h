@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_SORT_OB_TOPN_FILTER_H_
+#define OCEANBASE_SQL_ENGINE_SORT_OB_TOPN_FILTER_H_
+
+#include "share/datum/ob_datum_funcs.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/sort/ob_sort_basic_info.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Boundary of a top-n sort, published to the table scan below it.
+//
+// Once the heap of the sort is full, a row whose first sort key is strictly worse than the
+// first sort key of the heap top can never get into the result, with or without ties. The
+// sort copies that key into the filter as the heap improves, and the table scan drops such
+// rows before they are filtered, projected and compared by the operators above.
+class ObTopnFilter
+{
+public:
+  ObTopnFilter();
+  ~ObTopnFilter() { destroy(); }
+  int init(const uint64_t tenant_id,
+           const ObExpr *key_expr,
+           const ObSortFieldCollation &sort_collation,
+           const ObSortCmpFunc &sort_cmp_func);
+  // forget the boundary, e.g. on rescan of the sort
+  void reset();
+  void destroy();
+  // tighten the boundary to @key, the first sort key of the heap top
+  int update(const common::ObDatum &key);
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  OB_INLINE bool is_ready() const { return is_ready_; }
+  OB_INLINE const ObExpr *get_key_expr() const { return key_expr_; }
+  OB_INLINE bool can_filter(const common::ObDatum &key) const
+  {
+    const int cmp = cmp_func_(key, boundary_);
+    return is_ascending_ ? cmp > 0 : cmp < 0;
+  }
+  // set skip of rows in the batch that cannot get into the top-n
+  int filter_batch(ObEvalCtx &eval_ctx, ObBitVector &skip, const int64_t batch_size);
+  TO_STRING_KV(K_(is_inited), K_(is_ready), K_(is_ascending), K_(boundary), K_(update_cnt),
+      K_(filter_cnt));
+private:
+  bool is_inited_;
+  bool is_ready_;
+  bool is_ascending_;
+  uint64_t tenant_id_;
+  const ObExpr *key_expr_;
+  common::ObDatumCmpFuncType cmp_func_;
+  common::ObDatum boundary_;
+  char *buf_;
+  int64_t buf_size_;
+  int64_t update_cnt_;
+  int64_t filter_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObTopnFilter);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* OCEANBASE_SQL_ENGINE_SORT_OB_TOPN_FILTER_H_ */
@@ -18,6 +18,7 @@
 #include "sql/das/ob_das_group_scan_op.h"
 #include "sql/das/ob_das_define.h"
 #include "sql/das/ob_das_utils.h"
+#include "sql/engine/sort/ob_topn_filter.h"
 #include "lib/profile/ob_perf_event.h"
 #include "share/ob_ddl_checksum.h"
 #include "storage/access/ob_table_scan_iterator.h"
@@ -568,7 +569,8 @@ ObTableScanOp::ObTableScanOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOp
     range_buffers_(NULL),
     range_buffer_idx_(0),
     group_size_(0),
-    max_group_size_(0)
+    max_group_size_(0),
+    topn_filter_(NULL)
 {
 }
 
@@ -1072,6 +1074,23 @@ void ObTableScanOp::replace_bnlj_param(int64_t batch_idx)
   }
 }
 
+int ObTableScanOp::set_topn_filter(ObTopnFilter *topn_filter, bool &is_set)
+{
+  int ret = OB_SUCCESS;
+  is_set = false;
+  if (OB_ISNULL(topn_filter) || OB_UNLIKELY(!topn_filter->is_inited())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid topn filter", K(ret), KP(topn_filter));
+  } else if (MY_SPEC.is_vt_mapping_) {
+    // output of virtual agent table is converted after the scan
+  } else if (has_exist_in_array(MY_CTDEF.get_das_output_exprs(),
+                                const_cast<ObExpr *>(topn_filter->get_key_expr()))) {
+    topn_filter_ = topn_filter;
+    is_set = true;
+  }
+  return ret;
+}
+
 int ObTableScanOp::init_converter()
 {
   int ret = OB_SUCCESS;
@@ -1244,6 +1263,7 @@ void ObTableScanOp::destroy()
     vt_result_converter_->~ObVirtualTableResultConverter();
     vt_result_converter_ = nullptr;
   }
+  topn_filter_ = NULL;
 }
 
 int ObTableScanOp::fill_storage_feedback_info()
@@ -1739,6 +1759,13 @@ int ObTableScanOp::inner_get_next_batch(const int64_t max_row_cnt)
     }
   }
 
+  if (OB_SUCC(ret) && NULL != topn_filter_ && topn_filter_->is_ready() && brs_.size_ > 0) {
+    // rows worse than the boundary of the top-n sort above never get into its result
+    if (OB_FAIL(topn_filter_->filter_batch(eval_ctx_, *brs_.skip_, brs_.size_))) {
+      LOG_WARN("topn filter batch failed", K(ret), KPC_(topn_filter));
+    }
+  }
+
   if (OB_SUCC(ret) && brs_.end_ && das_ref_.has_task()) {
 //    ObIPartitionGroup *partition = NULL;
 //    ObIPartitionGroupGuard *guard = NULL;
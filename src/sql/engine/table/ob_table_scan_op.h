@@ -37,6 +37,7 @@ namespace sql
 
 class ObTableScanOp;
 class ObDASScanOp;
+class ObTopnFilter;
 
 struct FlashBackItem
 {
@@ -346,6 +347,8 @@ public:
   int init_converter();
 
   void set_report_checksum(bool flag) { report_checksum_ = flag; }
+  // accept the boundary of the top-n sort above, if its key is produced by this scan
+  int set_topn_filter(ObTopnFilter *topn_filter, bool &is_set);
   int reset_sample_scan() { tsc_rtdef_.scan_rtdef_.sample_info_ = nullptr; return close_and_reopen(); }
   virtual void set_need_sample(bool flag) { UNUSED(flag); }
   static int transform_physical_rowid(common::ObIAllocator &allocator,
@@ -469,6 +472,8 @@ protected:
   // for equal_query_range opt end
   int64_t group_size_;
   int64_t max_group_size_;
+  // boundary of the top-n sort above, owned by the sort
+  ObTopnFilter *topn_filter_;
 };
 
 } // end namespace sql
@@ -317,6 +317,176 @@ DEF_TO_STRING(ObWindowFunctionOp::AggrCell)
   return pos;
 }
 
+bool ObWindowFunctionOp::SegmentTree::is_supported(const WinFuncInfo &wf_info)
+{
+  const ObItemType func_type = wf_info.func_type_;
+  return (T_FUN_MIN == func_type || T_FUN_MAX == func_type
+          || T_FUN_SYS_BIT_AND == func_type || T_FUN_SYS_BIT_OR == func_type)
+      && 1 == wf_info.aggr_info_.param_exprs_.count()
+      && !wf_info.aggr_info_.has_distinct_
+      && !wf_info.upper_.is_unbounded_;
+}
+
+int64_t ObWindowFunctionOp::SegmentTree::identity() const
+{
+  int64_t res = INVALID_IDX;
+  if (T_FUN_SYS_BIT_AND == wf_info_->func_type_) {
+    res = static_cast<int64_t>(UINT64_MAX);
+  } else if (T_FUN_SYS_BIT_OR == wf_info_->func_type_) {
+    res = 0;
+  }
+  return res;
+}
+
+int64_t ObWindowFunctionOp::SegmentTree::merge(const int64_t left, const int64_t right) const
+{
+  int64_t res = left;
+  switch (wf_info_->func_type_) {
+    case T_FUN_SYS_BIT_AND: {
+      res = left & right;
+      break;
+    }
+    case T_FUN_SYS_BIT_OR: {
+      res = left | right;
+      break;
+    }
+    default: {
+      // MIN/MAX, null arguments are ignored
+      if (INVALID_IDX == left) {
+        res = right;
+      } else if (INVALID_IDX != right) {
+        const int cmp = wf_info_->aggr_info_.expr_->basic_funcs_->null_first_cmp_(
+            values_[left], values_[right]);
+        res = (T_FUN_MAX == wf_info_->func_type_ ? cmp < 0 : cmp > 0) ? right : left;
+      }
+      break;
+    }
+  }
+  return res;
+}
+
+int ObWindowFunctionOp::SegmentTree::build(ObWindowFunctionOp &op,
+                                           WinFuncInfo &wf_info,
+                                           const int64_t begin_idx,
+                                           const int64_t end_idx)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  const int64_t row_cnt = end_idx - begin_idx + 1;
+  const bool is_bit_aggr = T_FUN_SYS_BIT_AND == wf_info.func_type_
+                           || T_FUN_SYS_BIT_OR == wf_info.func_type_;
+  if (!is_supported(wf_info) || row_cnt < MIN_PART_ROW_CNT) {
+    // the incremental aggregation is good enough
+  } else if (FALSE_IT(allocator_.set_tenant_id(
+      op.ctx_.get_my_session()->get_effective_tenant_id()))) {
+  } else if (OB_ISNULL(nodes_ = static_cast<int64_t *>(
+      allocator_.alloc(2 * row_cnt * sizeof(int64_t))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate segment tree nodes failed", K(ret), K(row_cnt));
+  } else if (!is_bit_aggr && OB_ISNULL(values_ = static_cast<ObDatum *>(
+      allocator_.alloc(row_cnt * sizeof(ObDatum))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate segment tree values failed", K(ret), K(row_cnt));
+  } else {
+    wf_info_ = &wf_info;
+    begin_idx_ = begin_idx;
+    leaf_cnt_ = row_cnt;
+    ObExpr *param = wf_info.aggr_info_.param_exprs_.at(0);
+    const ObRADatumStore::StoredRow *row = NULL;
+    ObDatum *datum = NULL;
+    bool too_large = false;
+    for (int64_t i = 0; OB_SUCC(ret) && !too_large && i < row_cnt; ++i) {
+      int64_t &leaf = nodes_[row_cnt + i];
+      if (OB_FAIL(op.input_rows_.cur_->get_row(begin_idx + i, row))) {
+        LOG_WARN("get row failed", K(ret), K(begin_idx), K(i));
+      } else if (FALSE_IT(op.clear_evaluated_flag())) {
+      } else if (OB_FAIL(row->to_expr(op.get_all_expr(), op.eval_ctx_))) {
+        LOG_WARN("to expr failed", K(ret));
+      } else if (OB_FAIL(param->eval(op.eval_ctx_, datum))) {
+        LOG_WARN("eval aggr param failed", K(ret));
+      } else if (datum->is_null()) {
+        leaf = identity();
+      } else if (is_bit_aggr) {
+        leaf = static_cast<int64_t>(datum->get_uint());
+      } else if (OB_FAIL(values_[i].deep_copy(*datum, allocator_))) {
+        LOG_WARN("deep copy aggr param failed", K(ret));
+      } else {
+        leaf = i;
+        too_large = allocator_.used() > MAX_MEM_SIZE;
+      }
+    }
+    if (OB_SUCC(ret) && !too_large) {
+      build_inner_nodes();
+    }
+  }
+  if (OB_FAIL(ret) || !is_built_) {
+    reset();
+  }
+  return ret;
+}
+
+void ObWindowFunctionOp::SegmentTree::build_inner_nodes()
+{
+  for (int64_t i = leaf_cnt_ - 1; i > 0; --i) {
+    nodes_[i] = merge(nodes_[2 * i], nodes_[2 * i + 1]);
+  }
+  is_built_ = true;
+}
+
+int ObWindowFunctionOp::SegmentTree::query(const Frame &frame,
+                                           ObEvalCtx &eval_ctx,
+                                           ObDatum &val) const
+{
+  int ret = OB_SUCCESS;
+  int64_t l = frame.head_ - begin_idx_;
+  int64_t r = frame.tail_ - begin_idx_ + 1;
+  if (OB_UNLIKELY(!is_built_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("segment tree is not built", K(ret));
+  } else if (OB_UNLIKELY(l < 0 || l >= r || r > leaf_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("frame out of segment tree", K(ret), K(frame), KPC(this));
+  } else {
+    int64_t res = identity();
+    for (l += leaf_cnt_, r += leaf_cnt_; l < r; l >>= 1, r >>= 1) {
+      if (l & 1) {
+        res = merge(res, nodes_[l++]);
+      }
+      if (r & 1) {
+        res = merge(res, nodes_[--r]);
+      }
+    }
+    if (T_FUN_SYS_BIT_AND == wf_info_->func_type_ || T_FUN_SYS_BIT_OR == wf_info_->func_type_) {
+      ObDatum &expr_datum = wf_info_->aggr_info_.expr_->locate_datum_for_write(eval_ctx);
+      expr_datum.set_uint(static_cast<uint64_t>(res));
+      wf_info_->aggr_info_.expr_->set_evaluated_flag(eval_ctx);
+      val = expr_datum;
+    } else if (INVALID_IDX == res) {
+      val.set_null();
+    } else {
+      val = values_[res];
+    }
+  }
+  return ret;
+}
+
+void ObWindowFunctionOp::SegmentTree::reset()
+{
+  is_built_ = false;
+  wf_info_ = NULL;
+  begin_idx_ = 0;
+  leaf_cnt_ = 0;
+  values_ = NULL;
+  nodes_ = NULL;
+  allocator_.reset_remain_one_page();
+}
+
+void ObWindowFunctionOp::SegmentTree::destroy()
+{
+  reset();
+  allocator_.reset();
+}
+
 template <typename OP>
 int ObWindowFunctionOp::foreach_stores(OP op)
 {
@@ -1406,7 +1576,15 @@ int ObWindowFunctionOp::compute(RowsReader &row_reader, WinFuncCell &wf_cell,
               K(row_idx), K(upper_has_null), K(lower_has_null), K(wf_cell));
     if (!upper_has_null && !lower_has_null && Frame::valid_frame(part_frame, new_frame)) {
       Frame::prune_frame(part_frame, new_frame);
-      if (wf_cell.is_aggr()) {
+      if (wf_cell.is_aggr() && static_cast<AggrCell *>(&wf_cell)->seg_tree_.is_built()) {
+        // sliding frame of an aggregate without inverse, no restart over the frame
+        if (OB_FAIL(static_cast<AggrCell *>(&wf_cell)->seg_tree_.query(new_frame, eval_ctx_,
+                                                                       val))) {
+          LOG_WARN("query segment tree failed", K(ret), K(new_frame));
+        } else {
+          last_valid_frame = new_frame;
+        }
+      } else if (wf_cell.is_aggr()) {
         AggrCell *aggr_func = static_cast<AggrCell *>(&wf_cell);
         const ObRADatumStore::StoredRow *cur_row = NULL;
         if (!Frame::same_frame(last_valid_frame, new_frame)) {
@@ -2573,6 +2751,12 @@ int ObWindowFunctionOp::compute_wf_values(const WinFuncCell *end, int64_t &check
     wf->reset_for_restart();
     ObDatum result_datum;
     RowsReader row_reader(*input_rows_.cur_);
+    if (wf->is_aggr()
+        && OB_FAIL(static_cast<AggrCell *>(wf)->seg_tree_.build(*this, wf->wf_info_,
+                                                                 wf->part_first_row_idx_,
+                                                                 get_part_end_idx()))) {
+      LOG_WARN("build segment tree failed", K(ret));
+    }
     if (wf == wf_list_.get_last()) {
       // record the last computed partition row count
       const int v = input_rows_.cur_->count() - wf->part_first_row_idx_;
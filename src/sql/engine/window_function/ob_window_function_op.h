@@ -441,6 +441,53 @@ public:
     Frame last_valid_frame_;
   };
 
+  // Segment tree over the aggregate argument of one partition.
+  //
+  // MIN, MAX, BIT_AND and BIT_OR have no inverse, so when a row slides out of the frame the
+  // incremental aggregation restarts over the whole frame. The tree answers any frame of the
+  // partition in O(log n) instead: leaves of MIN/MAX keep the index of a non-null argument
+  // (deep copied into %values_), inner nodes the index of the extremum of their children;
+  // leaves of BIT_AND/BIT_OR keep the argument bits, inner nodes the combined bits.
+  class SegmentTree
+  {
+  public:
+    SegmentTree()
+      : allocator_(common::ObModIds::OB_SQL_WINDOW_FUNC), wf_info_(NULL), begin_idx_(0),
+        leaf_cnt_(0), values_(NULL), nodes_(NULL), is_built_(false)
+    {}
+    ~SegmentTree() { destroy(); }
+    // frame head must move, otherwise the incremental aggregation never restarts
+    static bool is_supported(const WinFuncInfo &wf_info);
+    // build over rows [begin_idx, end_idx] of the current partition, the tree is not built
+    // for small partitions or arguments too large to copy
+    int build(ObWindowFunctionOp &op, WinFuncInfo &wf_info,
+              const int64_t begin_idx, const int64_t end_idx);
+    int query(const Frame &frame, ObEvalCtx &eval_ctx, common::ObDatum &val) const;
+    void reset();
+    void destroy();
+    OB_INLINE bool is_built() const { return is_built_; }
+    TO_STRING_KV(K_(is_built), K_(begin_idx), K_(leaf_cnt));
+  public:
+    static const int64_t MIN_PART_ROW_CNT = 64;
+    static const int64_t MAX_MEM_SIZE = 64L << 20;
+  private:
+    static const int64_t INVALID_IDX = -1;
+    int64_t identity() const;
+    int64_t merge(const int64_t left, const int64_t right) const;
+    // all the leaves are set
+    void build_inner_nodes();
+  private:
+    common::ObArenaAllocator allocator_;
+    const WinFuncInfo *wf_info_;
+    int64_t begin_idx_;
+    int64_t leaf_cnt_;
+    common::ObDatum *values_;
+    // [1, leaf_cnt_) inner nodes, [leaf_cnt_, 2 * leaf_cnt_) leaves
+    int64_t *nodes_;
+    bool is_built_;
+    DISALLOW_COPY_AND_ASSIGN(SegmentTree);
+  };
+
   class AggrCell : public WinFuncCell
   {
   public:
@@ -450,9 +497,10 @@ public:
         aggr_processor_(op_.eval_ctx_, aggr_infos, "WindowAggProc"),
         result_(),
         got_result_(false),
-        remove_type_(wf_info.remove_type_)
+        remove_type_(wf_info.remove_type_),
+        seg_tree_()
     {}
-    virtual ~AggrCell() { aggr_processor_.destroy(); }
+    virtual ~AggrCell() { aggr_processor_.destroy(); seg_tree_.destroy(); }
     int trans(const ObRADatumStore::StoredRow &row)
     {
       return trans_self(row);
@@ -494,6 +542,7 @@ public:
     ObDatum result_;
     bool got_result_;
     uint64_t remove_type_;
+    SegmentTree seg_tree_;
   };
 
   class NonAggrCell : public WinFuncCell
@@ -576,7 +576,34 @@ int ObSqlTransControl::stmt_setup_snapshot_(ObSQLSessionInfo *session,
   auto &snapshot = das_ctx.get_snapshot();
   if (cl == ObConsistencyLevel::WEAK || cl == ObConsistencyLevel::FROZEN) {
     SCN snapshot_version = SCN::min_scn();
-    if (OB_FAIL(txs->get_weak_read_snapshot_version(snapshot_version))) {
+    share::ObLSArray ls_ids;
+    bool use_ls_version = false;
+    // with max staleness specified, a local plan reads at the replay progress
+    // of the log streams it touches rather than the server or cluster version
+    if (cl == ObConsistencyLevel::WEAK
+        && plan->get_weak_read_max_staleness() > 0
+        && OB_PHY_PLAN_LOCAL == plan->get_location_type()) {
+      if (OB_FAIL(das_ctx.get_all_lsid(ls_ids))) {
+        LOG_WARN("fail to get ls ids of plan", K(ret));
+      } else {
+        use_ls_version = !ls_ids.empty();
+      }
+    }
+    if (OB_SUCC(ret) && use_ls_version) {
+      ret = txs->get_ls_weak_read_snapshot_version(ls_ids,
+                                                   plan->get_weak_read_max_staleness(),
+                                                   snapshot_version);
+      if (OB_LS_NOT_EXIST == ret || OB_NOT_SUPPORTED == ret) {
+        // location is stale or monotonic read is required, fallback to the
+        // weak read service
+        ret = OB_SUCCESS;
+        use_ls_version = false;
+      } else if (OB_FAIL(ret)) {
+        TRANS_LOG(WARN, "get ls weak read snapshot fail", K(ret), K(ls_ids));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (!use_ls_version && OB_FAIL(txs->get_weak_read_snapshot_version(snapshot_version))) {
       TRANS_LOG(WARN, "get weak read snapshot fail", KPC(txs));
     } else {
       snapshot.init_weak_read(snapshot_version);
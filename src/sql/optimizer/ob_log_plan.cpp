@@ -6704,25 +6704,65 @@ int ObLogPlan::check_scalar_groupby_pushdown(const ObIArray<ObAggFunRawExpr *> &
     if (OB_ISNULL(cur_aggr = aggrs.at(i))) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("get unexpected null", K(ret));
-    } else if (T_FUN_COUNT != cur_aggr->get_expr_type()) {
+    } else if (T_FUN_COUNT != cur_aggr->get_expr_type() &&
+               T_FUN_MIN != cur_aggr->get_expr_type() &&
+               T_FUN_MAX != cur_aggr->get_expr_type() &&
+               T_FUN_SUM != cur_aggr->get_expr_type()) {
       can_push = false;
     } else if (cur_aggr->is_param_distinct() || 1 < cur_aggr->get_real_param_count()) {
       /* mysql mode, support count(distinct c1, c2). if this distinct can be eliminated,
            the count(c1, c2) can not push down*/
       can_push = false;
     } else if (cur_aggr->get_real_param_exprs().empty()) {
-      /* do nothing */
+      /* count(*), min/max/sum always have one param */
+      can_push = T_FUN_COUNT == cur_aggr->get_expr_type();
     } else if (OB_ISNULL(first_param = cur_aggr->get_param_expr(0))) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("get unexpected null", K(ret));
     } else if (!first_param->is_column_ref_expr() ||
                table_item->table_id_ != static_cast<ObColumnRefRawExpr*>(first_param)->get_table_id()) {
       can_push = false;
+    } else if (T_FUN_COUNT != cur_aggr->get_expr_type()) {
+      can_push = is_aggr_param_type_supported_to_push(*cur_aggr, *first_param);
     }
   }
   return ret;
 }
 
+// min/max are evaluated by storage with datum compare functions of the column,
+// sum is only supported for accurate numeric columns with number result
+bool ObLogPlan::is_aggr_param_type_supported_to_push(const ObAggFunRawExpr &aggr,
+                                                     const ObRawExpr &param)
+{
+  bool bret = false;
+  const ObObjTypeClass param_tc = param.get_result_type().get_type_class();
+  if (T_FUN_SUM == aggr.get_expr_type()) {
+    bret = (ObIntTC == param_tc || ObUIntTC == param_tc || ObNumberTC == param_tc) &&
+           ob_is_number_tc(aggr.get_result_type().get_type());
+  } else {
+    switch (param_tc) {
+      case ObIntTC:
+      case ObUIntTC:
+      case ObFloatTC:
+      case ObDoubleTC:
+      case ObNumberTC:
+      case ObDateTimeTC:
+      case ObDateTC:
+      case ObTimeTC:
+      case ObYearTC:
+      case ObStringTC:
+      case ObOTimestampTC: {
+        bret = true;
+        break;
+      }
+      default: {
+        bret = false;
+      }
+    }
+  }
+  return bret;
+}
+
 int ObLogPlan::check_can_pullup_gi(ObLogicalOperator &top,
                                    bool is_partition_wise,
                                    bool need_sort,
@@ -808,6 +808,8 @@ public:
 
   int check_scalar_groupby_pushdown(const ObIArray<ObAggFunRawExpr *> &aggrs,
                                     bool &can_push);
+  static bool is_aggr_param_type_supported_to_push(const ObAggFunRawExpr &aggr,
+                                                  const ObRawExpr &param);
 
   int check_basic_groupby_pushdown(const ObIArray<ObAggFunRawExpr*> &aggr_items,
                                    const EqualSets &equal_sets,
@@ -608,6 +608,10 @@ bool ObOptParamHint::is_param_val_valid(const OptParamType param_type, const ObO
       is_valid = val.is_int() && (0 < val.get_int());
       break;
     }
+    case WEAK_READ_MAX_STALENESS: {
+      is_valid = val.is_int() && (0 <= val.get_int());
+      break;
+    }
     default:
       LOG_TRACE("invalid opt param val", K(param_type), K(val));
       break;
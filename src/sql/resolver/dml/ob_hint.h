@@ -72,6 +72,7 @@ struct ObOptParamHint
     DEF(ROWSETS_MAX_ROWS,)                \
     DEF(DDL_EXECUTION_ID,)                \
     DEF(DDL_TASK_ID,)                     \
+    DEF(WEAK_READ_MAX_STALENESS,)         \
 
   DECLARE_ENUM(OptParamType, opt_param, OPT_PARAM_TYPE_DEF, static);
 
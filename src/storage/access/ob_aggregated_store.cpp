@@ -25,12 +25,79 @@ namespace oceanbase
 namespace storage
 {
 
+ObAggDatumBuf::ObAggDatumBuf(common::ObIAllocator &allocator)
+    : size_(0), datums_(nullptr), buf_(nullptr), cell_datas_(nullptr), allocator_(allocator)
+{
+}
+
+int ObAggDatumBuf::init(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  if (OB_UNLIKELY(size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(size));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(common::ObDatum) * size))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Failed to alloc datums", K(ret), K(size));
+  } else if (FALSE_IT(datums_ = static_cast<common::ObDatum *>(buf))) {
+  } else if (OB_ISNULL(buf_ = static_cast<char *>(
+      allocator_.alloc(common::OBJ_DATUM_NUMBER_RES_SIZE * size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Failed to alloc datum buf", K(ret), K(size));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(char *) * size))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Failed to alloc cell datas", K(ret), K(size));
+  } else {
+    cell_datas_ = reinterpret_cast<const char **>(buf);
+    for (int64_t i = 0; i < size; ++i) {
+      new (datums_ + i) common::ObDatum();
+    }
+    size_ = size;
+    reuse(size);
+  }
+  if (OB_FAIL(ret)) {
+    reset();
+  }
+  return ret;
+}
+
+void ObAggDatumBuf::reset()
+{
+  if (nullptr != datums_) {
+    allocator_.free(datums_);
+    datums_ = nullptr;
+  }
+  if (nullptr != buf_) {
+    allocator_.free(buf_);
+    buf_ = nullptr;
+  }
+  if (nullptr != cell_datas_) {
+    allocator_.free(cell_datas_);
+    cell_datas_ = nullptr;
+  }
+  size_ = 0;
+}
+
+void ObAggDatumBuf::reuse(const int64_t count)
+{
+  for (int64_t i = 0; i < count && i < size_; ++i) {
+    datums_[i].ptr_ = buf_ + i * common::OBJ_DATUM_NUMBER_RES_SIZE;
+  }
+}
+
 ObAggCell::ObAggCell(
     const int32_t col_idx,
+    const int32_t store_col_idx,
     const share::schema::ObColumnParam *col_param,
     sql::ObExpr *expr,
     common::ObIAllocator &allocator)
-    : col_idx_(col_idx), datum_(), col_param_(col_param), expr_(expr), allocator_(allocator)
+    : col_idx_(col_idx),
+      store_col_idx_(store_col_idx),
+      datum_(),
+      col_param_(col_param),
+      expr_(expr),
+      allocator_(allocator)
 {
 }
 
@@ -42,6 +109,7 @@ ObAggCell::~ObAggCell()
 void ObAggCell::reset()
 {
   col_idx_ = -1;
+  store_col_idx_ = -1;
   expr_ = nullptr;
 }
 
@@ -100,12 +168,44 @@ int ObAggCell::pad_column_if_need(blocksstable::ObStorageDatum &datum)
   return ret;
 }
 
+int ObAggCell::read_index_agg(
+    const blocksstable::ObMicroIndexInfo &index_info,
+    const blocksstable::ObAggColHeader *&col_header,
+    common::ObDatum &min,
+    common::ObDatum &max,
+    common::ObDatum &sum) const
+{
+  int ret = OB_SUCCESS;
+  blocksstable::ObAggRowReader agg_reader;
+  col_header = nullptr;
+  if (store_col_idx_ < 0 || nullptr == col_param_ || !index_info.has_agg_data()) {
+    // no skip index
+  } else if (OB_FAIL(agg_reader.init(index_info.agg_row_buf_, index_info.agg_buf_size_))) {
+    LOG_WARN("Failed to init agg row reader", K(ret), K(index_info));
+  } else if (OB_FAIL(agg_reader.read(store_col_idx_, col_header, min, max, sum))) {
+    LOG_WARN("Failed to read agg column", K(ret), K_(store_col_idx), K(agg_reader));
+  } else if (nullptr != col_header &&
+             col_header->obj_type_ != static_cast<uint8_t>(col_param_->get_meta_type().get_type())) {
+    // column type changed after the block was written
+    col_header = nullptr;
+  }
+  return ret;
+}
+
+OB_INLINE static bool is_all_null(
+    const blocksstable::ObAggColHeader &col_header,
+    const blocksstable::ObMicroIndexInfo &index_info)
+{
+  return col_header.is_null_count_valid() && col_header.null_count_ == index_info.get_row_count();
+}
+
 ObFirstRowAggCell::ObFirstRowAggCell(
     const int32_t col_idx,
+    const int32_t store_col_idx,
     const share::schema::ObColumnParam *col_param,
     sql::ObExpr *expr,
     common::ObIAllocator &allocator)
-    : ObAggCell(col_idx, col_param, expr, allocator), aggregated_(false)
+    : ObAggCell(col_idx, store_col_idx, col_param, expr, allocator), aggregated_(false)
 {
 }
 
@@ -168,11 +268,12 @@ int ObFirstRowAggCell::fill_result(sql::ObEvalCtx &ctx, bool need_padding)
 
 ObCountAggCell::ObCountAggCell(
     const int32_t col_idx,
+    const int32_t store_col_idx,
     const share::schema::ObColumnParam *col_param,
     sql::ObExpr *expr,
     common::ObIAllocator &allocator,
     bool exclude_null)
-    : ObAggCell(col_idx, col_param, expr, allocator), exclude_null_(exclude_null), row_count_(0)
+    : ObAggCell(col_idx, store_col_idx, col_param, expr, allocator), exclude_null_(exclude_null), row_count_(0)
 {
 }
 
@@ -237,14 +338,38 @@ int ObCountAggCell::process(const blocksstable::ObMicroIndexInfo &index_info)
   } else if (!exclude_null_) {
     row_count_ += index_info.get_row_count();
   } else {
-    // TODO, extract from pre-agginfo
-    ret = OB_NOT_SUPPORTED;
-    LOG_WARN("exclude null is not supported", K(ret));
+    const blocksstable::ObAggColHeader *col_header = nullptr;
+    common::ObDatum min;
+    common::ObDatum max;
+    common::ObDatum sum;
+    if (OB_FAIL(read_index_agg(index_info, col_header, min, max, sum))) {
+      LOG_WARN("Failed to read index agg", K(ret), K(index_info));
+    } else if (OB_UNLIKELY(nullptr == col_header || !col_header->is_null_count_valid())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected, null count of index info is invalid", K(ret), KPC(col_header), K(index_info));
+    } else {
+      row_count_ += index_info.get_row_count() - col_header->null_count_;
+    }
   }
   LOG_DEBUG("after count index info", K(ret), K(index_info.get_row_count()), K(row_count_));
   return ret;
 }
 
+bool ObCountAggCell::can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const
+{
+  bool bret = !exclude_null_;
+  if (!bret) {
+    const blocksstable::ObAggColHeader *col_header = nullptr;
+    common::ObDatum min;
+    common::ObDatum max;
+    common::ObDatum sum;
+    bret = OB_SUCCESS == read_index_agg(index_info, col_header, min, max, sum)
+        && nullptr != col_header
+        && col_header->is_null_count_valid();
+  }
+  return bret;
+}
+
 int ObCountAggCell::fill_result(sql::ObEvalCtx &ctx, bool need_padding)
 {
   UNUSED(need_padding);
@@ -269,9 +394,448 @@ int ObCountAggCell::fill_result(sql::ObEvalCtx &ctx, bool need_padding)
   return ret;
 }
 
+ObBatchedAggCell::ObBatchedAggCell(
+    const int32_t col_idx,
+    const int32_t store_col_idx,
+    const share::schema::ObColumnParam *col_param,
+    sql::ObExpr *expr,
+    common::ObIAllocator &allocator,
+    ObAggDatumBuf &agg_datum_buf)
+    : ObAggCell(col_idx, store_col_idx, col_param, expr, allocator),
+      agg_datum_buf_(agg_datum_buf),
+      default_datum_()
+{
+}
+
+void ObBatchedAggCell::reset()
+{
+  ObAggCell::reset();
+  default_datum_.set_nop();
+}
+
+int ObBatchedAggCell::get_default_datum(const common::ObDatum *&datum)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(col_param_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected, col param is null", K(ret), K(col_idx_));
+  } else if (default_datum_.is_nop()) {
+    const ObObj &def_cell = col_param_->get_orig_default_value();
+    if (def_cell.is_nop_value()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected, virtual column is not supported", K(ret), K(col_idx_));
+    } else if (OB_FAIL(default_datum_.from_obj_enhance(def_cell))) {
+      LOG_WARN("Failed to transfer obj to datum", K(ret), K(def_cell));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    datum = &default_datum_;
+  }
+  return ret;
+}
+
+int ObBatchedAggCell::process(blocksstable::ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  blocksstable::ObStorageDatum &datum = row.storage_datums_[col_idx_];
+  if (OB_FAIL(fill_default_if_need(datum))) {
+    LOG_WARN("Failed to fill default", K(ret), K(*this));
+  } else if (OB_FAIL(eval(datum))) {
+    LOG_WARN("Failed to eval datum", K(ret), K(datum), K(*this));
+  }
+  return ret;
+}
+
+int ObBatchedAggCell::process(
+    blocksstable::ObIMicroBlockReader *reader,
+    int64_t *row_ids,
+    const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  if (0 == row_count) {
+  } else if (OB_UNLIKELY(nullptr == reader || nullptr == row_ids ||
+                         row_count > agg_datum_buf_.get_size())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected argument to aggregate rows", K(ret), KP(reader), KP(row_ids), K(row_count),
+             K_(agg_datum_buf));
+  } else {
+    common::ObDatum *datums = agg_datum_buf_.get_datums();
+    agg_datum_buf_.reuse(row_count);
+    if (OB_FAIL(reader->get_column_datum(col_idx_, row_ids, agg_datum_buf_.get_cell_datas(),
+                                         row_count, datums))) {
+      LOG_WARN("Failed to get column datum", K(ret), K(*this), K(row_count));
+    } else {
+      const common::ObDatum *datum = nullptr;
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+        datum = &datums[i];
+        if (datum->is_ext() && OB_FAIL(get_default_datum(datum))) {
+          LOG_WARN("Failed to get default datum", K(ret), K(i), K(*this));
+        } else if (OB_FAIL(eval(*datum))) {
+          LOG_WARN("Failed to eval datum", K(ret), K(i), KPC(datum), K(*this));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+ObMinMaxAggCell::ObMinMaxAggCell(
+    const int32_t col_idx,
+    const int32_t store_col_idx,
+    const share::schema::ObColumnParam *col_param,
+    sql::ObExpr *expr,
+    common::ObIAllocator &allocator,
+    ObAggDatumBuf &agg_datum_buf,
+    const bool is_min)
+    : ObBatchedAggCell(col_idx, store_col_idx, col_param, expr, allocator, agg_datum_buf),
+      is_min_(is_min),
+      cmp_func_(nullptr),
+      buf_(nullptr),
+      buf_size_(0)
+{
+  datum_.set_null();
+}
+
+int ObMinMaxAggCell::init()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(col_param_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected, col param is null", K(ret), K(col_idx_));
+  } else {
+    const common::ObObjMeta &meta = col_param_->get_meta_type();
+    cmp_func_ = common::ObDatumFuncs::get_nullsafe_cmp_func(meta.get_type(),
+                                                            meta.get_type(),
+                                                            common::NULL_LAST,
+                                                            meta.get_collation_type(),
+                                                            lib::is_oracle_mode());
+    if (OB_ISNULL(cmp_func_)) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Not supported column type to min/max", K(ret), K(meta));
+    } else if (OB_ISNULL(buf_ = static_cast<char *>(allocator_.alloc(common::OBJ_DATUM_NUMBER_RES_SIZE)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Failed to alloc datum buf", K(ret));
+    } else {
+      buf_size_ = common::OBJ_DATUM_NUMBER_RES_SIZE;
+    }
+  }
+  return ret;
+}
+
+void ObMinMaxAggCell::reset()
+{
+  ObBatchedAggCell::reset();
+  if (nullptr != buf_) {
+    allocator_.free(buf_);
+    buf_ = nullptr;
+  }
+  buf_size_ = 0;
+  cmp_func_ = nullptr;
+  datum_.set_null();
+}
+
+void ObMinMaxAggCell::reuse()
+{
+  datum_.set_null();
+}
+
+int ObMinMaxAggCell::eval(const common::ObDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  if (datum.is_null()) {
+  } else if (!datum_.is_null() &&
+             (is_min_ ? cmp_func_(datum, datum_) >= 0 : cmp_func_(datum, datum_) <= 0)) {
+  } else {
+    if (datum.len_ > buf_size_) {
+      char *buf = nullptr;
+      const int64_t buf_size = MAX(datum.len_, buf_size_ * 2);
+      if (OB_ISNULL(buf = static_cast<char *>(allocator_.alloc(buf_size)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("Failed to alloc datum buf", K(ret), K(buf_size));
+      } else {
+        allocator_.free(buf_);
+        buf_ = buf;
+        buf_size_ = buf_size;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      MEMCPY(buf_, datum.ptr_, datum.len_);
+      datum_.set_string(buf_, datum.len_);
+    }
+  }
+  return ret;
+}
+
+int ObMinMaxAggCell::process(const blocksstable::ObMicroIndexInfo &index_info)
+{
+  int ret = OB_SUCCESS;
+  const blocksstable::ObAggColHeader *col_header = nullptr;
+  common::ObDatum min;
+  common::ObDatum max;
+  common::ObDatum sum;
+  if (OB_FAIL(read_index_agg(index_info, col_header, min, max, sum))) {
+    LOG_WARN("Failed to read index agg", K(ret), K(index_info));
+  } else if (OB_ISNULL(col_header)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected, column is not aggregated in index info", K(ret), K(index_info), K(*this));
+  } else if (is_all_null(*col_header, index_info)) {
+  } else if (OB_UNLIKELY(!col_header->is_min_max_valid())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected, min/max of index info is invalid", K(ret), KPC(col_header), K(index_info));
+  } else if (OB_FAIL(eval(is_min_ ? min : max))) {
+    LOG_WARN("Failed to eval index agg datum", K(ret), K(min), K(max), K(*this));
+  }
+  return ret;
+}
+
+bool ObMinMaxAggCell::can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const
+{
+  const blocksstable::ObAggColHeader *col_header = nullptr;
+  common::ObDatum min;
+  common::ObDatum max;
+  common::ObDatum sum;
+  return OB_SUCCESS == read_index_agg(index_info, col_header, min, max, sum)
+      && nullptr != col_header
+      && (col_header->is_min_max_valid() || is_all_null(*col_header, index_info));
+}
+
+ObSumAggCell::ObSumAggCell(
+    const int32_t col_idx,
+    const int32_t store_col_idx,
+    const share::schema::ObColumnParam *col_param,
+    sql::ObExpr *expr,
+    common::ObIAllocator &allocator,
+    ObAggDatumBuf &agg_datum_buf)
+    : ObBatchedAggCell(col_idx, store_col_idx, col_param, expr, allocator, agg_datum_buf),
+      column_tc_(common::ObMaxTC),
+      sum_int_(0),
+      sum_uint_(0),
+      has_value_(false),
+      has_nmb_sum_(false),
+      nmb_sum_()
+{
+}
+
+int ObSumAggCell::init()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(col_param_) || OB_ISNULL(expr_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected null col param or expr", K(ret), K(col_idx_), KP_(expr));
+  } else {
+    column_tc_ = col_param_->get_meta_type().get_type_class();
+    if (OB_UNLIKELY(common::ObIntTC != column_tc_ &&
+                    common::ObUIntTC != column_tc_ &&
+                    common::ObNumberTC != column_tc_)) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Not supported column type to sum", K(ret), K_(column_tc));
+    } else if (OB_UNLIKELY(!ob_is_number_tc(expr_->datum_meta_.type_))) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Not supported sum result type", K(ret), K(expr_->datum_meta_));
+    }
+  }
+  return ret;
+}
+
+void ObSumAggCell::reset()
+{
+  ObBatchedAggCell::reset();
+  column_tc_ = common::ObMaxTC;
+  reuse();
+}
+
+void ObSumAggCell::reuse()
+{
+  sum_int_ = 0;
+  sum_uint_ = 0;
+  has_value_ = false;
+  has_nmb_sum_ = false;
+}
+
+int ObSumAggCell::add_int(const int64_t value)
+{
+  int ret = OB_SUCCESS;
+  int64_t sum = 0;
+  if (!__builtin_add_overflow(sum_int_, value, &sum)) {
+    sum_int_ = sum;
+  } else {
+    common::number::ObNumber nmb;
+    char buf_alloc[common::number::ObNumber::MAX_BYTE_LEN];
+    common::ObDataBuffer allocator(buf_alloc, common::number::ObNumber::MAX_BYTE_LEN);
+    if (OB_FAIL(nmb.from(sum_int_, allocator))) {
+      LOG_WARN("Failed to cons number from int", K(ret), K_(sum_int));
+    } else if (OB_FAIL(add_number(nmb))) {
+      LOG_WARN("Failed to add number", K(ret), K(nmb));
+    } else {
+      sum_int_ = value;
+    }
+  }
+  return ret;
+}
+
+int ObSumAggCell::add_uint(const uint64_t value)
+{
+  int ret = OB_SUCCESS;
+  uint64_t sum = 0;
+  if (!__builtin_add_overflow(sum_uint_, value, &sum)) {
+    sum_uint_ = sum;
+  } else {
+    common::number::ObNumber nmb;
+    char buf_alloc[common::number::ObNumber::MAX_BYTE_LEN];
+    common::ObDataBuffer allocator(buf_alloc, common::number::ObNumber::MAX_BYTE_LEN);
+    if (OB_FAIL(nmb.from(sum_uint_, allocator))) {
+      LOG_WARN("Failed to cons number from uint", K(ret), K_(sum_uint));
+    } else if (OB_FAIL(add_number(nmb))) {
+      LOG_WARN("Failed to add number", K(ret), K(nmb));
+    } else {
+      sum_uint_ = value;
+    }
+  }
+  return ret;
+}
+
+int ObSumAggCell::add_number(const common::number::ObNumber &nmb)
+{
+  int ret = OB_SUCCESS;
+  common::ObDataBuffer nmb_alloc(nmb_buf_, common::number::ObNumber::MAX_CALC_BYTE_LEN);
+  if (!has_nmb_sum_) {
+    if (OB_FAIL(nmb_sum_.from(nmb, nmb_alloc))) {
+      LOG_WARN("Failed to copy number", K(ret), K(nmb));
+    } else {
+      has_nmb_sum_ = true;
+    }
+  } else {
+    common::number::ObNumber result_nmb;
+    char buf_alloc[common::number::ObNumber::MAX_CALC_BYTE_LEN];
+    common::ObDataBuffer allocator(buf_alloc, common::number::ObNumber::MAX_CALC_BYTE_LEN);
+    const bool strict_mode = false; // tmp allocator, see ObAggregateProcessor
+    if (OB_FAIL(nmb_sum_.add_v3(nmb, result_nmb, allocator, strict_mode))) {
+      LOG_WARN("Failed to add number", K(ret), K_(nmb_sum), K(nmb));
+    } else if (OB_FAIL(nmb_sum_.from(result_nmb, nmb_alloc))) {
+      LOG_WARN("Failed to copy number", K(ret), K(result_nmb));
+    }
+  }
+  return ret;
+}
+
+int ObSumAggCell::eval(const common::ObDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  if (datum.is_null()) {
+  } else {
+    switch (column_tc_) {
+      case common::ObIntTC: {
+        ret = add_int(datum.get_int());
+        break;
+      }
+      case common::ObUIntTC: {
+        ret = add_uint(datum.get_uint64());
+        break;
+      }
+      case common::ObNumberTC: {
+        ret = add_number(common::number::ObNumber(datum.get_number()));
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpected column type class", K(ret), K_(column_tc));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("Failed to sum datum", K(ret), K(datum), K(*this));
+    } else {
+      has_value_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObSumAggCell::process(const blocksstable::ObMicroIndexInfo &index_info)
+{
+  int ret = OB_SUCCESS;
+  const blocksstable::ObAggColHeader *col_header = nullptr;
+  common::ObDatum min;
+  common::ObDatum max;
+  common::ObDatum sum;
+  if (OB_FAIL(read_index_agg(index_info, col_header, min, max, sum))) {
+    LOG_WARN("Failed to read index agg", K(ret), K(index_info));
+  } else if (OB_ISNULL(col_header)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected, column is not aggregated in index info", K(ret), K(index_info), K(*this));
+  } else if (is_all_null(*col_header, index_info)) {
+  } else if (OB_UNLIKELY(!col_header->is_sum_valid())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected, sum of index info is invalid", K(ret), KPC(col_header), K(index_info));
+  } else if (OB_FAIL(eval(sum))) {
+    LOG_WARN("Failed to eval index agg sum", K(ret), K(sum), K(*this));
+  }
+  return ret;
+}
+
+bool ObSumAggCell::can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const
+{
+  const blocksstable::ObAggColHeader *col_header = nullptr;
+  common::ObDatum min;
+  common::ObDatum max;
+  common::ObDatum sum;
+  return OB_SUCCESS == read_index_agg(index_info, col_header, min, max, sum)
+      && nullptr != col_header
+      && (col_header->is_sum_valid() || is_all_null(*col_header, index_info));
+}
+
+int ObSumAggCell::get_sum(common::number::ObNumber &nmb, common::ObIAllocator &allocator) const
+{
+  int ret = OB_SUCCESS;
+  common::number::ObNumber tiny_nmb;
+  char buf_alloc[common::number::ObNumber::MAX_BYTE_LEN];
+  common::ObDataBuffer tiny_alloc(buf_alloc, common::number::ObNumber::MAX_BYTE_LEN);
+  if (common::ObNumberTC == column_tc_) {
+    if (OB_FAIL(nmb.from(nmb_sum_, allocator))) {
+      LOG_WARN("Failed to copy number", K(ret), K_(nmb_sum));
+    }
+  } else if (common::ObIntTC == column_tc_ && OB_FAIL(tiny_nmb.from(sum_int_, tiny_alloc))) {
+    LOG_WARN("Failed to cons number from int", K(ret), K_(sum_int));
+  } else if (common::ObUIntTC == column_tc_ && OB_FAIL(tiny_nmb.from(sum_uint_, tiny_alloc))) {
+    LOG_WARN("Failed to cons number from uint", K(ret), K_(sum_uint));
+  } else if (!has_nmb_sum_) {
+    if (OB_FAIL(nmb.from(tiny_nmb, allocator))) {
+      LOG_WARN("Failed to copy number", K(ret), K(tiny_nmb));
+    }
+  } else if (OB_FAIL(nmb_sum_.add_v3(tiny_nmb, nmb, allocator, false))) {
+    LOG_WARN("Failed to add number", K(ret), K_(nmb_sum), K(tiny_nmb));
+  }
+  return ret;
+}
+
+int ObSumAggCell::fill_result(sql::ObEvalCtx &ctx, bool need_padding)
+{
+  UNUSED(need_padding);
+  int ret = OB_SUCCESS;
+  ObDatum &result = expr_->locate_datum_for_write(ctx);
+  sql::ObEvalInfo &eval_info = expr_->get_eval_info(ctx);
+  if (!has_value_) {
+    result.set_null();
+    eval_info.evaluated_ = true;
+  } else {
+    common::number::ObNumber result_nmb;
+    char buf_alloc[common::number::ObNumber::MAX_CALC_BYTE_LEN];
+    common::ObDataBuffer allocator(buf_alloc, common::number::ObNumber::MAX_CALC_BYTE_LEN);
+    if (OB_FAIL(get_sum(result_nmb, allocator))) {
+      LOG_WARN("Failed to get sum", K(ret), K(*this));
+    } else {
+      result.set_number(result_nmb);
+      eval_info.evaluated_ = true;
+    }
+  }
+  LOG_DEBUG("fill result", K(ret), K(result));
+  return ret;
+}
+
 ObAggRow::ObAggRow(common::ObIAllocator &allocator) :
     agg_cells_(allocator),
     need_exclude_null_(false),
+    need_access_data_(false),
+    agg_datum_buf_(allocator),
     allocator_(allocator)
 {
 }
@@ -285,11 +849,14 @@ void ObAggRow::reset()
 {
   for (int64_t i = 0; i < agg_cells_.count(); ++i) {
     if (agg_cells_.at(i)) {
+      agg_cells_.at(i)->~ObAggCell();
       allocator_.free(agg_cells_.at(i));
     }
   }
   agg_cells_.reset();
+  agg_datum_buf_.reset();
   need_exclude_null_ = false;
+  need_access_data_ = false;
 }
 
 void ObAggRow::reuse()
@@ -301,13 +868,14 @@ void ObAggRow::reuse()
   }
 }
 
-int ObAggRow::init(const ObTableAccessParam &param)
+int ObAggRow::init(const ObTableAccessParam &param, const int64_t batch_size)
 {
   int ret = OB_SUCCESS;
   const common::ObIArray<share::schema::ObColumnParam *> *out_cols_param = param.iter_param_.get_col_params();
-  if (OB_ISNULL(out_cols_param)) {
+  const ObTableReadInfo *read_info = param.iter_param_.get_read_info();
+  if (OB_ISNULL(out_cols_param) || OB_ISNULL(read_info)) {
     ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("unexpected null out cols param", K(ret), K_(param.iter_param));
+    LOG_WARN("unexpected null out cols param or read info", K(ret), K_(param.iter_param));
   } else if (OB_FAIL(agg_cells_.init(param.output_exprs_->count() + param.aggregate_exprs_->count()))) {
     LOG_WARN("Failed to init agg cells array", K(ret), K(param.output_exprs_->count()));
   } else {
@@ -316,10 +884,11 @@ int ObAggRow::init(const ObTableAccessParam &param)
     for (int64_t i = 0; OB_SUCC(ret) && i < param.output_exprs_->count(); ++i) {
       // mysql compatibility, select a,count(a), output first value of a
       int32_t col_idx = param.iter_param_.out_cols_project_->at(i);
+      int32_t store_col_idx = read_info->get_columns_index().at(col_idx);
       const share::schema::ObColumnParam *col_param = out_cols_param->at(col_idx);
       sql::ObExpr *expr = param.output_exprs_->at(i);
       if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObFirstRowAggCell))) ||
-          OB_ISNULL(cell = new(buf) ObFirstRowAggCell(col_idx, col_param, expr, allocator_))) {
+          OB_ISNULL(cell = new(buf) ObFirstRowAggCell(col_idx, store_col_idx, col_param, expr, allocator_))) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
         LOG_WARN("Failed to alloc memroy for agg cell", K(ret), K(i));
       } else if (OB_FAIL(agg_cells_.push_back(cell))) {
@@ -329,27 +898,66 @@ int ObAggRow::init(const ObTableAccessParam &param)
     if (OB_SUCC(ret)) {
       for (int64_t i = 0; OB_SUCC(ret) && i < param.aggregate_exprs_->count(); ++i) {
         int32_t col_idx = param.iter_param_.agg_cols_project_->at(i);
+        int32_t store_col_idx = -1;
         sql::ObExpr *expr = param.aggregate_exprs_->at(i);
+        const share::schema::ObColumnParam *col_param = nullptr;
+        cell = nullptr;
+        if (OB_COUNT_AGG_PD_COLUMN_ID != col_idx) {
+          col_param = out_cols_param->at(col_idx);
+          store_col_idx = read_info->get_columns_index().at(col_idx);
+        }
         if (T_FUN_COUNT == expr->type_) {
           bool exclude_null = false;
-          const share::schema::ObColumnParam *col_param = nullptr;
           if (OB_COUNT_AGG_PD_COLUMN_ID != col_idx) {
-            col_param = out_cols_param->at(col_idx);
             exclude_null = col_param->is_nullable_for_write();
           } else {
             exclude_null = false;
           }
           need_exclude_null_ = need_exclude_null_ || exclude_null;
           if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObCountAggCell))) ||
-              OB_ISNULL(cell = new(buf) ObCountAggCell(col_idx, col_param, expr, allocator_, exclude_null))) {
+              OB_ISNULL(cell = new(buf) ObCountAggCell(col_idx, store_col_idx, col_param, expr, allocator_, exclude_null))) {
             ret = OB_ALLOCATE_MEMORY_FAILED;
             LOG_WARN("Failed to alloc memroy for agg cell", K(ret), K(i));
-          } else if (OB_FAIL(agg_cells_.push_back(cell))) {
-            LOG_WARN("Failed to push back agg cell", K(ret), K(i));
           }
-        } else {
+        } else if (T_FUN_MIN != expr->type_ && T_FUN_MAX != expr->type_ && T_FUN_SUM != expr->type_) {
           ret = OB_NOT_SUPPORTED;
-          LOG_WARN("Agg min/max/sum is not supported", K(ret));
+          LOG_WARN("Agg function is not supported", K(ret), K(expr->type_));
+        } else if (OB_ISNULL(col_param)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("Unexpected null col param", K(ret), K(i), K(col_idx));
+        } else if (!agg_datum_buf_.is_inited() && OB_FAIL(agg_datum_buf_.init(batch_size))) {
+          LOG_WARN("Failed to init agg datum buf", K(ret), K(batch_size));
+        } else if (T_FUN_SUM == expr->type_) {
+          ObSumAggCell *sum_cell = nullptr;
+          if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObSumAggCell))) ||
+              OB_ISNULL(cell = sum_cell = new(buf) ObSumAggCell(
+                  col_idx, store_col_idx, col_param, expr, allocator_, agg_datum_buf_))) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            LOG_WARN("Failed to alloc memroy for agg cell", K(ret), K(i));
+          } else if (OB_FAIL(sum_cell->init())) {
+            LOG_WARN("Failed to init sum agg cell", K(ret), K(i));
+          }
+        } else {
+          ObMinMaxAggCell *min_max_cell = nullptr;
+          if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObMinMaxAggCell))) ||
+              OB_ISNULL(cell = min_max_cell = new(buf) ObMinMaxAggCell(
+                  col_idx, store_col_idx, col_param, expr, allocator_, agg_datum_buf_, T_FUN_MIN == expr->type_))) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            LOG_WARN("Failed to alloc memroy for agg cell", K(ret), K(i));
+          } else if (OB_FAIL(min_max_cell->init())) {
+            LOG_WARN("Failed to init min/max agg cell", K(ret), K(i));
+          }
+        }
+        if (OB_SUCC(ret) && OB_FAIL(agg_cells_.push_back(cell))) {
+          LOG_WARN("Failed to push back agg cell", K(ret), K(i));
+        }
+        if (OB_FAIL(ret)) {
+          if (nullptr != cell) {
+            cell->~ObAggCell();
+            allocator_.free(cell);
+          }
+        } else {
+          need_access_data_ = need_access_data_ || cell->need_access_data();
         }
       }
     }
@@ -357,6 +965,15 @@ int ObAggRow::init(const ObTableAccessParam &param)
   return ret;
 }
 
+bool ObAggRow::can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const
+{
+  bool bret = true;
+  for (int64_t i = 0; bret && i < agg_cells_.count(); ++i) {
+    bret = agg_cells_.at(i)->can_agg_index_info(index_info);
+  }
+  return bret;
+}
+
 ObAggregatedStore::ObAggregatedStore(const int64_t batch_size, sql::ObEvalCtx &eval_ctx, ObTableAccessContext &context)
     : ObBlockBatchedRowStore(batch_size, eval_ctx, context),
       is_firstrow_aggregated_(false),
@@ -402,7 +1019,7 @@ int ObAggregatedStore::init(const ObTableAccessParam &param)
         K(param.aggregate_exprs_->count()), K(param.iter_param_.agg_cols_project_->count()));
   } else if (OB_FAIL(ObBlockBatchedRowStore::init(param))) {
     LOG_WARN("Failed to init ObBlockBatchedRowStore", K(ret));
-  } else if (OB_FAIL(agg_row_.init(param))) {
+  } else if (OB_FAIL(agg_row_.init(param, batch_size_))) {
     LOG_WARN("Failed to init agg cells", K(ret));
   }
   if (OB_FAIL(ret)) {
@@ -450,7 +1067,8 @@ int ObAggregatedStore::fill_rows(
     int64_t micro_row_count = 0;
     if (OB_FAIL(reader->get_row_count(micro_row_count))) {
       LOG_WARN("Failed to get micro row count", K(ret));
-    } else if(FALSE_IT(need_get_row_ids = agg_row_.need_exclude_null() || micro_row_count != covered_row_count)) {
+    } else if(FALSE_IT(need_get_row_ids = agg_row_.need_exclude_null() || agg_row_.need_access_data() ||
+                                 micro_row_count != covered_row_count)) {
     } else if (!need_get_row_ids) {
       row_count = nullptr == bitmap ? covered_row_count : bitmap->popcnt();
       for (int64_t i = 0; OB_SUCC(ret) && i < agg_row_.get_agg_count(); ++i) {
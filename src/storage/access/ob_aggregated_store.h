@@ -13,11 +13,13 @@
 #ifndef OB_STORAGE_OB_AGGREGATED_STORE_H_
 #define OB_STORAGE_OB_AGGREGATED_STORE_H_
 
+#include "lib/number/ob_number_v2.h"
 #include "sql/engine/expr/ob_expr.h"
 #include "storage/ob_i_store.h"
 #include "ob_block_batched_row_store.h"
 #include "storage/blocksstable/ob_datum_row.h"
 #include "storage/blocksstable/ob_index_block_row_struct.h"
+#include "storage/blocksstable/ob_index_block_aggregator.h"
 
 namespace oceanbase
 {
@@ -29,11 +31,35 @@ struct ObMicroIndexInfo;
 namespace storage
 {
 
+// datums with their own cell buffers, shared by agg cells decoding column values of a batch
+class ObAggDatumBuf
+{
+public:
+  ObAggDatumBuf(common::ObIAllocator &allocator);
+  ~ObAggDatumBuf() { reset(); }
+  int init(const int64_t size);
+  void reset();
+  // point datums back to the inner cell buffers, decoders may have redirected them
+  void reuse(const int64_t count);
+  OB_INLINE bool is_inited() const { return nullptr != datums_; }
+  OB_INLINE int64_t get_size() const { return size_; }
+  OB_INLINE common::ObDatum *get_datums() { return datums_; }
+  OB_INLINE const char **get_cell_datas() { return cell_datas_; }
+  TO_STRING_KV(K_(size), KP_(datums), KP_(buf), KP_(cell_datas));
+private:
+  int64_t size_;
+  common::ObDatum *datums_;
+  char *buf_;
+  const char **cell_datas_;
+  common::ObIAllocator &allocator_;
+};
+
 class ObAggCell
 {
 public:
   ObAggCell(
       const int32_t col_idx,
+      const int32_t store_col_idx,
       const share::schema::ObColumnParam *col_param,
       sql::ObExpr *expr,
       common::ObIAllocator &allocator);
@@ -47,11 +73,28 @@ public:
       const int64_t row_count) = 0;
   virtual int process(const blocksstable::ObMicroIndexInfo &index_info) = 0;
   virtual int fill_result(sql::ObEvalCtx &ctx, bool need_padding);
-  TO_STRING_KV(K_(col_idx), K_(datum), KPC(col_param_), K_(expr));
+  // whether the whole micro/macro block can be aggregated by its index info
+  virtual bool can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const
+  {
+    UNUSED(index_info);
+    return true;
+  }
+  // whether column values are needed when aggregating rows of micro block
+  virtual bool need_access_data() const { return false; }
+  TO_STRING_KV(K_(col_idx), K_(store_col_idx), K_(datum), KPC(col_param_), K_(expr));
 protected:
   int fill_default_if_need(blocksstable::ObStorageDatum &datum);
   int pad_column_if_need(blocksstable::ObStorageDatum &datum);
+  // read skip index of the column, col_header is nullptr if not aggregated
+  int read_index_agg(
+      const blocksstable::ObMicroIndexInfo &index_info,
+      const blocksstable::ObAggColHeader *&col_header,
+      common::ObDatum &min,
+      common::ObDatum &max,
+      common::ObDatum &sum) const;
   int32_t col_idx_;
+  // column index in micro block, -1 for count(*)
+  int32_t store_col_idx_;
   blocksstable::ObStorageDatum datum_;
   const share::schema::ObColumnParam *col_param_;
   sql::ObExpr *expr_;
@@ -64,6 +107,7 @@ class ObFirstRowAggCell : public ObAggCell
 public:
   ObFirstRowAggCell(
       const int32_t col_idx,
+      const int32_t store_col_idx,
       const share::schema::ObColumnParam *col_param,
       sql::ObExpr *expr,
       common::ObIAllocator &allocator);
@@ -86,6 +130,7 @@ class ObCountAggCell : public ObAggCell
 public:
   ObCountAggCell(
       const int32_t col_idx,
+      const int32_t store_col_idx,
       const share::schema::ObColumnParam *col_param,
       sql::ObExpr *expr,
       common::ObIAllocator &allocator,
@@ -100,12 +145,106 @@ public:
       const int64_t row_count) override;
   virtual int process(const blocksstable::ObMicroIndexInfo &index_info) override;
    virtual int fill_result(sql::ObEvalCtx &ctx, bool need_padding) override;
+  virtual bool can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const override;
    TO_STRING_KV(K_(col_idx), K_(datum), K_(col_param), K_(expr), K_(exclude_null), K_(row_count));
 private:
   bool exclude_null_;
   int64_t row_count_;
 };
-// TODO sum/min/max
+
+// base of agg cells which aggregate on column values
+class ObBatchedAggCell : public ObAggCell
+{
+public:
+  ObBatchedAggCell(
+      const int32_t col_idx,
+      const int32_t store_col_idx,
+      const share::schema::ObColumnParam *col_param,
+      sql::ObExpr *expr,
+      common::ObIAllocator &allocator,
+      ObAggDatumBuf &agg_datum_buf);
+  virtual ~ObBatchedAggCell() { reset(); }
+  virtual void reset() override;
+  virtual int process(blocksstable::ObDatumRow &row) override;
+  virtual int process(
+      blocksstable::ObIMicroBlockReader *reader,
+      int64_t *row_ids,
+      const int64_t row_count) override;
+  virtual bool need_access_data() const override { return true; }
+  INHERIT_TO_STRING_KV("ObAggCell", ObAggCell, K_(agg_datum_buf));
+protected:
+  // aggregate a non-ext datum
+  virtual int eval(const common::ObDatum &datum) = 0;
+  int get_default_datum(const common::ObDatum *&datum);
+  ObAggDatumBuf &agg_datum_buf_;
+  blocksstable::ObStorageDatum default_datum_;
+};
+
+class ObMinMaxAggCell : public ObBatchedAggCell
+{
+public:
+  ObMinMaxAggCell(
+      const int32_t col_idx,
+      const int32_t store_col_idx,
+      const share::schema::ObColumnParam *col_param,
+      sql::ObExpr *expr,
+      common::ObIAllocator &allocator,
+      ObAggDatumBuf &agg_datum_buf,
+      const bool is_min);
+  virtual ~ObMinMaxAggCell() { reset(); }
+  int init();
+  virtual void reset() override;
+  virtual void reuse() override;
+  using ObBatchedAggCell::process;
+  virtual int process(const blocksstable::ObMicroIndexInfo &index_info) override;
+  virtual bool can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const override;
+  INHERIT_TO_STRING_KV("ObBatchedAggCell", ObBatchedAggCell, K_(is_min), K_(buf_size));
+protected:
+  virtual int eval(const common::ObDatum &datum) override;
+private:
+  bool is_min_;
+  common::ObDatumCmpFuncType cmp_func_;
+  char *buf_;
+  int64_t buf_size_;
+};
+
+// sum of integer or number column, result is number
+class ObSumAggCell : public ObBatchedAggCell
+{
+public:
+  ObSumAggCell(
+      const int32_t col_idx,
+      const int32_t store_col_idx,
+      const share::schema::ObColumnParam *col_param,
+      sql::ObExpr *expr,
+      common::ObIAllocator &allocator,
+      ObAggDatumBuf &agg_datum_buf);
+  virtual ~ObSumAggCell() { reset(); }
+  int init();
+  virtual void reset() override;
+  virtual void reuse() override;
+  using ObBatchedAggCell::process;
+  virtual int process(const blocksstable::ObMicroIndexInfo &index_info) override;
+  virtual int fill_result(sql::ObEvalCtx &ctx, bool need_padding) override;
+  virtual bool can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const override;
+  INHERIT_TO_STRING_KV("ObBatchedAggCell", ObBatchedAggCell, K_(column_tc), K_(sum_int), K_(sum_uint),
+      K_(has_value), K_(has_nmb_sum));
+protected:
+  virtual int eval(const common::ObDatum &datum) override;
+private:
+  int add_int(const int64_t value);
+  int add_uint(const uint64_t value);
+  int add_number(const common::number::ObNumber &nmb);
+  int get_sum(common::number::ObNumber &nmb, common::ObIAllocator &allocator) const;
+  common::ObObjTypeClass column_tc_;
+  // integers are summed in 8 bytes until overflow, see ObAggregateProcessor tiny num
+  int64_t sum_int_;
+  uint64_t sum_uint_;
+  bool has_value_;
+  bool has_nmb_sum_;
+  common::number::ObNumber nmb_sum_;
+  char nmb_buf_[common::number::ObNumber::MAX_CALC_BYTE_LEN];
+};
 
 class ObAggRow
 {
@@ -114,16 +253,20 @@ public:
   ~ObAggRow();
   void reset();
   void reuse();
-  int init(const ObTableAccessParam &param);
+  int init(const ObTableAccessParam &param, const int64_t batch_size);
   int64_t get_agg_count() const { return agg_cells_.count(); }
   bool need_exclude_null() const { return need_exclude_null_; };
+  bool need_access_data() const { return need_access_data_; }
+  bool can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const;
   // void set_firstrow_aggregated(bool aggregated) { is_firstrow_aggregated_ = aggregated; }
   // bool is_firstrow_aggregated() const { return is_firstrow_aggregated_; }
   ObAggCell* at(int64_t idx) { return agg_cells_.at(idx); }
-  TO_STRING_KV(K_(agg_cells));
+  TO_STRING_KV(K_(agg_cells), K_(need_exclude_null), K_(need_access_data));
 private:
   common::ObFixedArray<ObAggCell *, common::ObIAllocator> agg_cells_;
   bool need_exclude_null_;
+  bool need_access_data_;
+  ObAggDatumBuf agg_datum_buf_;
   common::ObIAllocator &allocator_;
 };
 
@@ -152,10 +295,11 @@ public:
   OB_INLINE bool can_batched_aggregate() const { return is_firstrow_aggregated_; }
   OB_INLINE bool can_agg_index_info(const blocksstable::ObMicroIndexInfo &index_info) const
   { 
-    return filter_is_null() && !agg_row_.need_exclude_null() && can_batched_aggregate() &&
+    return filter_is_null() && can_batched_aggregate() &&
            index_info.can_blockscan() &&
            !index_info.is_left_border() &&
-           !index_info.is_right_border();
+           !index_info.is_right_border() &&
+           agg_row_.can_agg_index_info(index_info);
   }
   OB_INLINE void set_end() { iter_end_flag_ = IterEndState::ITER_END; }
   TO_STRING_KV(K_(agg_row));
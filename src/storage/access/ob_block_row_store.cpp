@@ -15,10 +15,12 @@
 #include "lib/stat/ob_diagnose_info.h"
 #include "common/sql_mode/ob_sql_mode_utils.h"
 #include "sql/engine/basic/ob_pushdown_filter.h"
+#include "share/datum/ob_join_key_range.h"
 #include "storage/ob_i_store.h"
 #include "storage/blocksstable/encoding/ob_micro_block_decoder.h"
 #include "storage/blocksstable/ob_micro_block_reader.h"
 #include "storage/blocksstable/ob_micro_block_row_scanner.h"
+#include "storage/blocksstable/ob_index_block_aggregator.h"
 #include "storage/access/ob_table_access_context.h"
 
 namespace oceanbase
@@ -32,6 +34,7 @@ namespace storage
 ObBlockRowStore::ObBlockRowStore(ObTableAccessContext &context)
     : is_inited_(false),
     context_(context),
+    read_info_(nullptr),
     can_blockscan_(false),
     filter_applied_(false),
     disabled_(false)
@@ -56,6 +59,7 @@ void ObBlockRowStore::reset()
   }
   pd_filter_info_.col_capacity_ = 0;
   pd_filter_info_.filter_ = nullptr;
+  read_info_ = nullptr;
   disabled_ = false;
 }
 
@@ -101,6 +105,7 @@ int ObBlockRowStore::init(const ObTableAccessParam &param)
   } else {
     pd_filter_info_.filter_ = iter_param.pushdown_filter_;
     pd_filter_info_.col_capacity_ = out_col_cnt;
+    read_info_ = iter_param.get_read_info();
     is_inited_ = true;
   }
 
@@ -216,6 +221,249 @@ int ObBlockRowStore::filter_micro_block(
   return ret;
 }
 
+int ObBlockRowStore::check_skip_by_index(
+    const blocksstable::ObMicroIndexInfo &index_info,
+    bool &can_skip)
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  ObAggRowReader agg_reader;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObBlockRowStore is not inited", K(ret), K(*this));
+  } else if (disabled_ || !can_skip_by_index() || !index_info.can_blockscan() || !index_info.has_agg_data() || 0 == index_info.get_row_count()) {
+  } else if (OB_FAIL(agg_reader.init(index_info.agg_row_buf_, index_info.agg_buf_size_))) {
+    LOG_WARN("Fail to init aggregated row reader", K(ret), K(index_info));
+  } else if (OB_FAIL(check_skip_by_index(agg_reader,
+                                         index_info.get_row_count(),
+                                         pd_filter_info_.filter_,
+                                         can_skip))) {
+    LOG_WARN("Fail to check skip index", K(ret), K(agg_reader), K(index_info));
+  } else if (can_skip) {
+    EVENT_INC(ObStatEventIds::SKIP_INDEX_SKIP_BLOCK_CNT);
+    LOG_DEBUG("[SKIP INDEX] micro block skipped", K(index_info), K(agg_reader));
+  }
+  return ret;
+}
+
+int ObBlockRowStore::check_skip_by_index(
+    const blocksstable::ObAggRowReader &agg_reader,
+    const int64_t row_count,
+    sql::ObPushdownFilterExecutor *filter,
+    bool &can_skip)
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  if (OB_ISNULL(filter)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(filter));
+  } else if (filter->is_filter_white_node()) {
+    if (OB_FAIL(check_white_filter_by_index(agg_reader,
+                                            row_count,
+                                            *static_cast<sql::ObWhiteFilterExecutor *>(filter),
+                                            can_skip))) {
+      LOG_WARN("Fail to check white filter by skip index", K(ret), KPC(filter));
+    }
+  } else if (filter->is_filter_black_node()) {
+    if (OB_FAIL(check_black_filter_by_index(agg_reader,
+                                            row_count,
+                                            *static_cast<sql::ObBlackFilterExecutor *>(filter),
+                                            can_skip))) {
+      LOG_WARN("Fail to check black filter by skip index", K(ret), KPC(filter));
+    }
+  } else if (filter->is_logic_op_node()) {
+    sql::ObPushdownFilterExecutor **children = filter->get_childs();
+    const bool is_and = filter->is_logic_and_node();
+    // AND is skipped if any child is skipped, OR only if all children are skipped
+    can_skip = !is_and;
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter->get_child_count(); i++) {
+      bool child_skip = false;
+      if (OB_FAIL(check_skip_by_index(agg_reader, row_count, children[i], child_skip))) {
+        LOG_WARN("Fail to check skip index", K(ret), K(i));
+      } else if (is_and && child_skip) {
+        can_skip = true;
+        break;
+      } else if (!is_and && !child_skip) {
+        can_skip = false;
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObBlockRowStore::check_white_filter_by_index(
+    const blocksstable::ObAggRowReader &agg_reader,
+    const int64_t row_count,
+    const sql::ObWhiteFilterExecutor &filter,
+    bool &can_skip)
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  const common::ObIArray<ObObj> &ref_objs = filter.get_objs();
+  const ObAggColHeader *col_header = nullptr;
+  ObDatum min_datum;
+  ObDatum max_datum;
+  int64_t col_offset = 0;
+  int64_t store_idx = 0;
+  if (1 != filter.get_col_count() || nullptr != filter.get_col_params().at(0)) {
+    // need padding
+  } else if (FALSE_IT(col_offset = filter.get_col_offsets().at(0))) {
+  } else if (OB_UNLIKELY(col_offset < 0 || col_offset >= read_info_->get_request_count())) {
+    ret = OB_INDEX_OUT_OF_RANGE;
+    LOG_WARN("Filter column offset out of range", K(ret), K(col_offset), KPC_(read_info));
+  } else if (FALSE_IT(store_idx = read_info_->get_columns_index().at(col_offset))) {
+  } else if (store_idx < 0 || store_idx >= agg_reader.get_col_cnt()) {
+  } else if (filter.null_param_contained() &&
+             sql::WHITE_OP_NU != op_type &&
+             sql::WHITE_OP_NN != op_type &&
+             sql::WHITE_OP_IN != op_type) {
+  } else if (OB_FAIL(agg_reader.read(store_idx, col_header, min_datum, max_datum))) {
+    LOG_WARN("Fail to read aggregated column", K(ret), K(store_idx), K(agg_reader));
+  } else if (OB_ISNULL(col_header)) {
+  } else {
+    const ObObjMeta &col_meta = read_info_->get_columns_desc().at(col_offset).col_type_;
+    const bool all_null = col_header->is_null_count_valid() && col_header->null_count_ == row_count;
+    const bool min_max_valid = col_header->is_min_max_valid() && !all_null
+        && col_header->obj_type_ == static_cast<uint8_t>(col_meta.get_type());
+    ObObj min_obj;
+    ObObj max_obj;
+    if (sql::WHITE_OP_NU == op_type) {
+      can_skip = col_header->is_null_count_valid() && 0 == col_header->null_count_;
+    } else if (all_null) {
+      // all predicates except is null are not true on null
+      can_skip = true;
+    } else if (!min_max_valid || sql::WHITE_OP_NN == op_type) {
+    } else if (ref_objs.count() < (sql::WHITE_OP_BT == op_type ? 2 : 1)) {
+    } else if (OB_FAIL(min_datum.to_obj(min_obj, col_meta))) {
+      LOG_WARN("Fail to convert min datum to obj", K(ret), K(min_datum), K(col_meta));
+    } else if (OB_FAIL(max_datum.to_obj(max_obj, col_meta))) {
+      LOG_WARN("Fail to convert max datum to obj", K(ret), K(max_datum), K(col_meta));
+    } else {
+      const ObCollationType cs_type = min_obj.get_collation_type();
+      switch (op_type) {
+        case sql::WHITE_OP_EQ: {
+          can_skip = ObObjCmpFuncs::compare_oper_nullsafe(max_obj, ref_objs.at(0), cs_type, CO_LT)
+              || ObObjCmpFuncs::compare_oper_nullsafe(min_obj, ref_objs.at(0), cs_type, CO_GT);
+          break;
+        }
+        case sql::WHITE_OP_NE: {
+          can_skip = ObObjCmpFuncs::compare_oper_nullsafe(min_obj, ref_objs.at(0), cs_type, CO_EQ)
+              && ObObjCmpFuncs::compare_oper_nullsafe(max_obj, ref_objs.at(0), cs_type, CO_EQ);
+          break;
+        }
+        case sql::WHITE_OP_LT: {
+          can_skip = ObObjCmpFuncs::compare_oper_nullsafe(min_obj, ref_objs.at(0), cs_type, CO_GE);
+          break;
+        }
+        case sql::WHITE_OP_LE: {
+          can_skip = ObObjCmpFuncs::compare_oper_nullsafe(min_obj, ref_objs.at(0), cs_type, CO_GT);
+          break;
+        }
+        case sql::WHITE_OP_GT: {
+          can_skip = ObObjCmpFuncs::compare_oper_nullsafe(max_obj, ref_objs.at(0), cs_type, CO_LE);
+          break;
+        }
+        case sql::WHITE_OP_GE: {
+          can_skip = ObObjCmpFuncs::compare_oper_nullsafe(max_obj, ref_objs.at(0), cs_type, CO_LT);
+          break;
+        }
+        case sql::WHITE_OP_BT: {
+          can_skip = ObObjCmpFuncs::compare_oper_nullsafe(max_obj, ref_objs.at(0), cs_type, CO_LT)
+              || ObObjCmpFuncs::compare_oper_nullsafe(min_obj, ref_objs.at(1), cs_type, CO_GT);
+          break;
+        }
+        case sql::WHITE_OP_IN: {
+          can_skip = true;
+          for (int64_t i = 0; can_skip && i < ref_objs.count(); ++i) {
+            const ObObj &ref_obj = ref_objs.at(i);
+            if ((lib::is_mysql_mode() && ref_obj.is_null())
+                || (lib::is_oracle_mode() && ref_obj.is_null_oracle())) {
+            } else if (!ObObjCmpFuncs::compare_oper_nullsafe(max_obj, ref_obj, cs_type, CO_LT)
+                && !ObObjCmpFuncs::compare_oper_nullsafe(min_obj, ref_obj, cs_type, CO_GT)) {
+              can_skip = false;
+            }
+          }
+          break;
+        }
+        default: {
+          break;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObBlockRowStore::check_black_filter_by_index(
+    const blocksstable::ObAggRowReader &agg_reader,
+    const int64_t row_count,
+    sql::ObBlackFilterExecutor &filter,
+    bool &can_skip)
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  const sql::ObPushdownBlackFilterNode &filter_node = filter.get_filter_node();
+  // rows are filtered out if any of the filter exprs is false
+  for (int64_t i = 0; OB_SUCC(ret) && !can_skip && i < filter_node.filter_exprs_.count(); ++i) {
+    const sql::ObExpr *expr = filter_node.filter_exprs_.at(i);
+    const ObJoinKeyRange *key_range = nullptr;
+    const ObAggColHeader *col_header = nullptr;
+    ObDatum min_datum;
+    ObDatum max_datum;
+    int64_t col_idx = OB_INVALID_INDEX;
+    int64_t col_offset = 0;
+    int64_t store_idx = 0;
+    if (OB_ISNULL(expr) || T_OP_JOIN_BLOOM_FILTER != expr->type_ || 1 != expr->arg_cnt_) {
+    } else if (OB_FAIL(filter.get_join_key_range(*expr, key_range))) {
+      LOG_WARN("Fail to get key range of join filter", K(ret));
+    } else if (nullptr == key_range) {
+    } else {
+      for (int64_t j = 0; OB_INVALID_INDEX == col_idx && j < filter_node.column_exprs_.count(); ++j) {
+        if (filter_node.column_exprs_.at(j) == expr->args_[0]) {
+          col_idx = j;
+        }
+      }
+      if (OB_INVALID_INDEX == col_idx || col_idx >= filter.get_col_offsets().count()) {
+      } else if (nullptr != filter.get_col_params().at(col_idx)) {
+        // need padding
+      } else if (FALSE_IT(col_offset = filter.get_col_offsets().at(col_idx))) {
+      } else if (OB_UNLIKELY(col_offset < 0 || col_offset >= read_info_->get_request_count())) {
+        ret = OB_INDEX_OUT_OF_RANGE;
+        LOG_WARN("Filter column offset out of range", K(ret), K(col_offset), KPC_(read_info));
+      } else if (FALSE_IT(store_idx = read_info_->get_columns_index().at(col_offset))) {
+      } else if (store_idx < 0 || store_idx >= agg_reader.get_col_cnt()) {
+      } else if (OB_FAIL(agg_reader.read(store_idx, col_header, min_datum, max_datum))) {
+        LOG_WARN("Fail to read aggregated column", K(ret), K(store_idx), K(agg_reader));
+      } else if (OB_ISNULL(col_header)) {
+      } else {
+        const ObObjMeta &col_meta = read_info_->get_columns_desc().at(col_offset).col_type_;
+        const bool null_count_valid = col_header->is_null_count_valid();
+        const bool all_null = null_count_valid && col_header->null_count_ == row_count;
+        // null keys only find a match if the build side has null keys, e.g. for <=>
+        const bool null_skippable = !key_range->has_null() || (null_count_valid && 0 == col_header->null_count_);
+        ObObj min_obj;
+        ObObj max_obj;
+        if (!null_skippable) {
+        } else if (all_null) {
+          can_skip = true;
+        } else if (!col_header->is_min_max_valid() ||
+                   col_header->obj_type_ != static_cast<uint8_t>(col_meta.get_type()) ||
+                   key_range->get_type() != col_meta.get_type()) {
+        } else if (OB_FAIL(min_datum.to_obj(min_obj, col_meta))) {
+          LOG_WARN("Fail to convert min datum to obj", K(ret), K(min_datum), K(col_meta));
+        } else if (OB_FAIL(max_datum.to_obj(max_obj, col_meta))) {
+          LOG_WARN("Fail to convert max datum to obj", K(ret), K(max_datum), K(col_meta));
+        } else {
+          can_skip = !key_range->might_intersect(min_obj, max_obj);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObBlockRowStore::get_result_bitmap(const common::ObBitmap *&bitmap)
 {
   int ret = OB_SUCCESS;
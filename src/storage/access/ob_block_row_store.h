@@ -24,15 +24,19 @@ namespace sql
 {
 class ObPushdownFilterExecutor;
 class ObBlackFilterExecutor;
+class ObWhiteFilterExecutor;
 }
 namespace blocksstable
 {
 class ObIMicroBlockRowScanner;
 class ObMicroBlockDecoder;
 class ObStorageDatum;
+struct ObMicroIndexInfo;
+class ObAggRowReader;
 }
 namespace storage
 {
+class ObTableReadInfo;
 struct ObTableAccessContext;
 struct ObTableAccessParam;
 struct ObTableIterParam;
@@ -80,6 +84,9 @@ public:
       const bool can_pushdown,
       ObTableStoreStat &table_store_stat);
   int get_result_bitmap(const common::ObBitmap *&bitmap);
+  // for skip index, can_skip is set if no row of the micro block can pass the pushdown filter
+  OB_INLINE bool can_skip_by_index() const { return nullptr != pd_filter_info_.filter_ && nullptr != read_info_; }
+  int check_skip_by_index(const blocksstable::ObMicroIndexInfo &index_info, bool &can_skip);
   virtual bool is_end() const { return false; }
   virtual bool is_empty() const { return true; }
   virtual int filter_micro_block_batch(
@@ -98,9 +105,26 @@ protected:
       blocksstable::ObIMicroBlockRowScanner &micro_scanner,
       sql::ObPushdownFilterExecutor *parent,
       sql::ObPushdownFilterExecutor *filter);
+  int check_skip_by_index(
+      const blocksstable::ObAggRowReader &agg_reader,
+      const int64_t row_count,
+      sql::ObPushdownFilterExecutor *filter,
+      bool &can_skip);
+  int check_white_filter_by_index(
+      const blocksstable::ObAggRowReader &agg_reader,
+      const int64_t row_count,
+      const sql::ObWhiteFilterExecutor &filter,
+      bool &can_skip);
+  // a black filter is skipped by the key range of the runtime join filters in it
+  int check_black_filter_by_index(
+      const blocksstable::ObAggRowReader &agg_reader,
+      const int64_t row_count,
+      sql::ObBlackFilterExecutor &filter,
+      bool &can_skip);
   bool is_inited_;
   PushdownFilterInfo pd_filter_info_;
   ObTableAccessContext &context_;
+  const ObTableReadInfo *read_info_;
 private:
   bool can_blockscan_;
   bool filter_applied_;
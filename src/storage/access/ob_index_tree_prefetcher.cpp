@@ -264,8 +264,10 @@ int ObIndexTreePrefetcher::check_bloom_filter(const ObMicroIndexInfo &index_info
     bool is_contain = true;
     if (OB_UNLIKELY(OB_SUCCESS != (temp_ret = OB_STORE_CACHE.get_bf_cache().may_contain(
         MTL_ID(),
+        iter_param_->tablet_id_,
         index_info.get_macro_id(),
         *read_handle.rowkey_,
+        read_handle.rowkey_->get_datum_cnt(),
         index_read_info_->get_datum_utils(),
         is_contain)))) {
       if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != temp_ret)) {
@@ -287,6 +289,57 @@ int ObIndexTreePrefetcher::check_bloom_filter(const ObMicroIndexInfo &index_info
   return ret;
 }
 
+int ObIndexTreePrefetcher::check_bloom_filter(const ObMicroIndexInfo &index_info, bool &is_filtered)
+{
+  int ret = OB_SUCCESS;
+  is_filtered = false;
+  if (!index_info.is_valid() || index_info.is_get() || !index_info.is_macro_node()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(index_info));
+  } else if (!access_ctx_->query_flag_.is_index_back() && access_ctx_->enable_bf_cache()) {
+    const ObDatumRange &range = index_info.get_query_range();
+    const ObDatumRowkey &start_key = range.get_start_key();
+    const ObDatumRowkey &end_key = range.get_end_key();
+    const ObStoreCmpFuncs &cmp_funcs = index_read_info_->get_datum_utils().get_cmp_funcs();
+    const int64_t max_cnt = MIN(MIN(start_key.get_datum_cnt(), end_key.get_datum_cnt()), cmp_funcs.count());
+    int64_t prefix_len = 0;
+    int cmp_ret = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_ret && i < max_cnt; ++i) {
+      if (start_key.datums_[i].is_ext() || end_key.datums_[i].is_ext()) {
+        cmp_ret = 1;
+      } else if (OB_FAIL(cmp_funcs.at(i).compare(start_key.datums_[i], end_key.datums_[i], cmp_ret))) {
+        LOG_WARN("Failed to compare datum", K(ret), K(i), K(range));
+      } else if (0 == cmp_ret) {
+        ++prefix_len;
+      }
+    }
+    if (OB_SUCC(ret) && prefix_len > 0) {
+      int temp_ret = OB_SUCCESS;
+      bool is_contain = true;
+      if (OB_UNLIKELY(OB_SUCCESS != (temp_ret = OB_STORE_CACHE.get_bf_cache().may_contain(
+          MTL_ID(),
+          iter_param_->tablet_id_,
+          index_info.get_macro_id(),
+          start_key,
+          prefix_len,
+          index_read_info_->get_datum_utils(),
+          is_contain)))) {
+        if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != temp_ret)) {
+          LOG_WARN("Fail to check bloomfilter", K(temp_ret));
+        }
+      } else {
+        if (!is_contain) {
+          is_filtered = true;
+          ++access_ctx_->table_store_stat_.bf_filter_cnt_;
+        }
+        ++access_ctx_->table_store_stat_.bf_access_cnt_;
+      }
+      LOG_DEBUG("check bloomfilter for range", K(ret), K(range), K(prefix_len), K(is_contain));
+    }
+  }
+  return ret;
+}
+
 int ObIndexTreePrefetcher::prefetch_block_data(
     blocksstable::ObMicroIndexInfo &index_block_info,
     ObMicroBlockDataHandle &micro_handle,
@@ -294,6 +347,26 @@ int ObIndexTreePrefetcher::prefetch_block_data(
 {
   int ret = OB_SUCCESS;
   bool need_submit_io = false;
+  if (OB_FAIL(lookup_block_data(index_block_info, micro_handle, is_data, need_submit_io))) {
+    LOG_WARN("Fail to lookup block data", K(ret), K(index_block_info));
+  } else if (need_submit_io && OB_FAIL(submit_block_io(index_block_info, micro_handle, is_data))) {
+    LOG_WARN("Fail to submit block io", K(ret), K(index_block_info));
+  } else if (is_data) {
+    EVENT_INC(ObStatEventIds::DATA_BLOCK_READ_CNT);
+  } else {
+    EVENT_INC(ObStatEventIds::INDEX_BLOCK_READ_CNT);
+  }
+  return ret;
+}
+
+int ObIndexTreePrefetcher::lookup_block_data(
+    blocksstable::ObMicroIndexInfo &index_block_info,
+    ObMicroBlockDataHandle &micro_handle,
+    const bool is_data,
+    bool &need_submit_io)
+{
+  int ret = OB_SUCCESS;
+  need_submit_io = false;
   uint64_t tenant_id = MTL_ID();
   const MacroBlockId &macro_id = index_block_info.get_macro_id();
   const int64_t offset = index_block_info.get_block_offset();
@@ -334,47 +407,49 @@ int ObIndexTreePrefetcher::prefetch_block_data(
   if (OB_SUCC(ret)) {
     micro_handle.micro_info_.offset_ = offset;
     micro_handle.micro_info_.size_ = index_block_info.get_block_size();
-    if (need_submit_io) {
-      ObMacroBlockHandle macro_handle;
-      if (is_data) {
-        const ObTableReadInfo *data_read_info = iter_param_->get_full_read_info();
-        if (OB_ISNULL(data_read_info)) {
-          ret = OB_ERR_UNEXPECTED;
-          LOG_WARN("Unexpected null full_col_descs", K(ret), KPC_(iter_param));
-        } else if (OB_FAIL(data_block_cache_->prefetch(
-                    tenant_id,
-                    macro_id,
-                    index_block_info,
-                    access_ctx_->query_flag_,
-                    *data_read_info,
-                    iter_param_->tablet_handle_,
-                    macro_handle))) {
-          LOG_WARN("Fail to prefetch micro block", K(ret), K(index_block_info), K(macro_handle), K(micro_handle), KPC(data_read_info));
-        }
-      } else if (OB_FAIL(index_block_cache_->prefetch(
-                  tenant_id,
-                  macro_id,
-                  index_block_info,
-                  access_ctx_->query_flag_,
-                  *index_read_info_,
-                  iter_param_->tablet_handle_,
-                  macro_handle))) {
-        LOG_WARN("Fail to prefetch micro block", K(ret), K(index_block_info), K(micro_handle), KPC_(index_read_info));
-      }
-      if (OB_SUCC(ret) && ObSSTableMicroBlockState::UNKNOWN_STATE == micro_handle.block_state_) {
-        micro_handle.tenant_id_ = tenant_id;
-        micro_handle.macro_block_id_ = macro_id;
-        micro_handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
-        micro_handle.io_handle_ = macro_handle;
-      }
-    }
   }
-  if (OB_SUCC(ret)) {
-    if (is_data) {
-      EVENT_INC(ObStatEventIds::DATA_BLOCK_READ_CNT);
-    } else {
-      EVENT_INC(ObStatEventIds::INDEX_BLOCK_READ_CNT);
+  return ret;
+}
+
+int ObIndexTreePrefetcher::submit_block_io(
+    blocksstable::ObMicroIndexInfo &index_block_info,
+    ObMicroBlockDataHandle &micro_handle,
+    const bool is_data)
+{
+  int ret = OB_SUCCESS;
+  uint64_t tenant_id = MTL_ID();
+  const MacroBlockId &macro_id = index_block_info.get_macro_id();
+  ObMacroBlockHandle macro_handle;
+  if (is_data) {
+    const ObTableReadInfo *data_read_info = iter_param_->get_full_read_info();
+    if (OB_ISNULL(data_read_info)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected null full_col_descs", K(ret), KPC_(iter_param));
+    } else if (OB_FAIL(data_block_cache_->prefetch(
+                tenant_id,
+                macro_id,
+                index_block_info,
+                access_ctx_->query_flag_,
+                *data_read_info,
+                iter_param_->tablet_handle_,
+                macro_handle))) {
+      LOG_WARN("Fail to prefetch micro block", K(ret), K(index_block_info), K(macro_handle), K(micro_handle), KPC(data_read_info));
     }
+  } else if (OB_FAIL(index_block_cache_->prefetch(
+              tenant_id,
+              macro_id,
+              index_block_info,
+              access_ctx_->query_flag_,
+              *index_read_info_,
+              iter_param_->tablet_handle_,
+              macro_handle))) {
+    LOG_WARN("Fail to prefetch micro block", K(ret), K(index_block_info), K(micro_handle), KPC_(index_read_info));
+  }
+  if (OB_SUCC(ret) && ObSSTableMicroBlockState::UNKNOWN_STATE == micro_handle.block_state_) {
+    micro_handle.tenant_id_ = tenant_id;
+    micro_handle.macro_block_id_ = macro_id;
+    micro_handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
+    micro_handle.io_handle_ = macro_handle;
   }
   return ret;
 }
@@ -400,6 +475,7 @@ void ObIndexTreeMultiPassPrefetcher::reset()
   micro_data_prefetch_idx_ = 0;
   row_lock_check_version_ = transaction::ObTransVersion::INVALID_TRANS_VERSION;
   agg_row_store_ = nullptr;
+  skip_index_row_store_ = nullptr;
   max_micro_handle_cnt_ = 0;
   iter_type_ = 0;
   cur_level_ = 0;
@@ -410,6 +486,8 @@ void ObIndexTreeMultiPassPrefetcher::reset()
   border_rowkey_.reset();
   read_handles_.reset();
   tree_handles_.reset();
+  pending_io_idxs_.reset();
+  coalesce_io_infos_.reset();
 }
 
 void ObIndexTreeMultiPassPrefetcher::reuse()
@@ -424,8 +502,11 @@ void ObIndexTreeMultiPassPrefetcher::reuse()
   micro_data_prefetch_idx_ = 0;
   row_lock_check_version_ = transaction::ObTransVersion::INVALID_TRANS_VERSION;
   agg_row_store_ = nullptr;
+  skip_index_row_store_ = nullptr;
   prefetch_depth_ = 1;
   total_micro_data_cnt_ = 0;
+  pending_io_idxs_.reuse();
+  coalesce_io_infos_.reuse();
   for (int64_t i = 0; i < tree_handles_.count(); i++) {
     tree_handles_.at(i).reuse();
   }
@@ -730,6 +811,7 @@ int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
         while (OB_SUCC(ret) && prefetched_cnt < prefetch_depth) {
           prefetch_micro_idx = micro_data_prefetch_idx_ % max_micro_handle_cnt_;
           ObMicroIndexInfo &block_info = micro_data_infos_[prefetch_micro_idx];
+          bool can_skip = false;
           if (OB_FAIL(tree_handles_[cur_level_].get_next_data_row(block_info))) {
             if (OB_UNLIKELY(OB_ITER_END != ret)) {
               LOG_WARN("fail to get next", K(ret), K(cur_level_), K(tree_handles_[cur_level_]));
@@ -738,6 +820,11 @@ int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
               ret = OB_SUCCESS;
               break;
             }
+          } else if (nullptr != skip_index_row_store_ &&
+                     OB_FAIL(skip_index_row_store_->check_skip_by_index(block_info, can_skip))) {
+            LOG_WARN("Fail to check skip index", K(ret), K(block_info), KPC(this));
+          } else if (can_skip) {
+            continue;
           } else if (nullptr != agg_row_store_ && agg_row_store_->can_agg_index_info(block_info)) {
             if (OB_FAIL(agg_row_store_->fill_index_info(block_info))) {
               LOG_WARN("Fail to agg index info", K(ret), K(block_info), KPC(this));
@@ -749,8 +836,8 @@ int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
             if (OB_UNLIKELY(OB_ITER_END != ret)) {
               LOG_WARN("Fail to check row lock", K(ret), K(block_info), KPC(this));
             }
-          } else if (OB_FAIL(prefetch_block_data(block_info, micro_data_handles_[prefetch_micro_idx]))) {
-            LOG_WARN("fail to prefetch_block_data", K(ret), K(block_info));
+          } else if (OB_FAIL(prefetch_data_block(prefetch_micro_idx))) {
+            LOG_WARN("fail to prefetch data block", K(ret), K(block_info));
           }
 
           if (OB_SUCC(ret)) {
@@ -776,10 +863,194 @@ int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
       }
     }
   }
+  if (pending_io_idxs_.count() > 0) {
+    // blocks prefetched before iter end still need their io
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCC(ret) || OB_ITER_END == ret) {
+      if (OB_SUCCESS != (tmp_ret = submit_pending_io())) {
+        ret = tmp_ret;
+        LOG_WARN("Fail to submit pending io", K(ret));
+      }
+    }
+    pending_io_idxs_.reuse();
+  }
   LOG_DEBUG("[INDEX BLOCK] prefetched info", K(ret),  KPC(this));
   return ret;
 }
 
+int ObIndexTreeMultiPassPrefetcher::prefetch_data_block(const int64_t prefetch_micro_idx)
+{
+  int ret = OB_SUCCESS;
+  bool need_submit_io = false;
+  ObMicroIndexInfo &block_info = micro_data_infos_[prefetch_micro_idx];
+  ObMicroBlockDataHandle &micro_handle = micro_data_handles_[prefetch_micro_idx];
+  if (!need_coalesce_io()) {
+    if (OB_FAIL(prefetch_block_data(block_info, micro_handle))) {
+      LOG_WARN("Fail to prefetch block data", K(ret), K(block_info));
+    }
+  } else if (OB_FAIL(lookup_block_data(block_info, micro_handle, true, need_submit_io))) {
+    LOG_WARN("Fail to lookup block data", K(ret), K(block_info));
+  } else if (!need_submit_io) {
+  } else if (ObSSTableMicroBlockState::UNKNOWN_STATE != micro_handle.block_state_) {
+    if (OB_FAIL(submit_block_io(block_info, micro_handle, true))) {
+      LOG_WARN("Fail to submit block io", K(ret), K(block_info));
+    }
+  } else if (OB_FAIL(pending_io_idxs_.push_back(prefetch_micro_idx))) {
+    LOG_WARN("Fail to push back pending io idx", K(ret), K(prefetch_micro_idx));
+  }
+  if (OB_SUCC(ret) && need_coalesce_io()) {
+    EVENT_INC(ObStatEventIds::DATA_BLOCK_READ_CNT);
+  }
+  return ret;
+}
+
+class ObPendingIOComparator
+{
+public:
+  explicit ObPendingIOComparator(ObMicroIndexInfo *micro_infos) : micro_infos_(micro_infos) {}
+  ~ObPendingIOComparator() {}
+  inline bool operator() (const int64_t left_idx, const int64_t right_idx)
+  {
+    bool bret = false;
+    ObMicroIndexInfo &left = micro_infos_[left_idx];
+    ObMicroIndexInfo &right = micro_infos_[right_idx];
+    if (left.get_macro_id() != right.get_macro_id()) {
+      bret = left.get_macro_id() < right.get_macro_id();
+    } else if (left.get_block_offset() != right.get_block_offset()) {
+      bret = left.get_block_offset() < right.get_block_offset();
+    } else {
+      bret = left_idx < right_idx;
+    }
+    return bret;
+  }
+private:
+  ObMicroIndexInfo *micro_infos_;
+};
+
+int ObIndexTreeMultiPassPrefetcher::submit_pending_io()
+{
+  int ret = OB_SUCCESS;
+  const int64_t pending_cnt = pending_io_idxs_.count();
+  // only the io order changes, rows are still fetched in the order of rowkeys
+  sort_pending_io(micro_data_infos_, pending_io_idxs_);
+  int64_t start_pos = 0;
+  while (OB_SUCC(ret) && start_pos < pending_cnt) {
+    const int64_t end_pos = get_coalesced_io_end(micro_data_infos_, pending_io_idxs_, start_pos);
+    if (OB_FAIL(submit_coalesced_io(start_pos, end_pos))) {
+      LOG_WARN("Fail to submit coalesced io", K(ret), K(start_pos), K(end_pos));
+    } else {
+      start_pos = end_pos;
+    }
+  }
+  return ret;
+}
+
+void ObIndexTreeMultiPassPrefetcher::sort_pending_io(
+    ObMicroIndexInfo *micro_infos,
+    PendingIOIdxArray &pending_io_idxs)
+{
+  std::sort(pending_io_idxs.begin(), pending_io_idxs.end(), ObPendingIOComparator(micro_infos));
+}
+
+int64_t ObIndexTreeMultiPassPrefetcher::get_coalesced_io_end(
+    ObMicroIndexInfo *micro_infos,
+    const PendingIOIdxArray &pending_io_idxs,
+    const int64_t start_pos)
+{
+  const int64_t pending_cnt = pending_io_idxs.count();
+  ObMicroIndexInfo &start_info = micro_infos[pending_io_idxs.at(start_pos)];
+  const int64_t io_offset = start_info.get_block_offset();
+  int64_t io_end = io_offset + start_info.get_block_size();
+  int64_t end_pos = start_pos + 1;
+  for (; end_pos < pending_cnt; ++end_pos) {
+    ObMicroIndexInfo &info = micro_infos[pending_io_idxs.at(end_pos)];
+    const int64_t block_offset = info.get_block_offset();
+    const int64_t block_end = block_offset + info.get_block_size();
+    if (info.get_macro_id() != start_info.get_macro_id()
+        || block_offset > io_end + MAX_COALESCE_IO_GAP
+        || block_end - io_offset > MAX_COALESCE_IO_SIZE) {
+      break;
+    } else {
+      io_end = MAX(io_end, block_end);
+    }
+  }
+  return end_pos;
+}
+
+// blocks in [start_pos, end_pos) of pending_io_idxs_ are in the same macro block and sorted by
+// offset, rowkeys in the same micro block share one block
+int ObIndexTreeMultiPassPrefetcher::submit_coalesced_io(const int64_t start_pos, const int64_t end_pos)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = MTL_ID();
+  ObMicroIndexInfo &start_info = micro_data_infos_[pending_io_idxs_.at(start_pos)];
+  const MacroBlockId macro_id = start_info.get_macro_id();
+  const ObTableReadInfo *data_read_info = iter_param_->get_full_read_info();
+  ObMacroBlockHandle macro_handle;
+  coalesce_io_infos_.reuse();
+  for (int64_t pos = start_pos; OB_SUCC(ret) && pos < end_pos; ++pos) {
+    ObMicroIndexInfo &info = micro_data_infos_[pending_io_idxs_.at(pos)];
+    if (coalesce_io_infos_.empty()
+        || info.get_block_offset() != coalesce_io_infos_.at(coalesce_io_infos_.count() - 1).get_block_offset()) {
+      if (OB_FAIL(coalesce_io_infos_.push_back(info))) {
+        LOG_WARN("Fail to push back micro index info", K(ret), K(info));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_ISNULL(data_read_info)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected null full_col_descs", K(ret), KPC_(iter_param));
+  } else if (1 == coalesce_io_infos_.count()) {
+    if (OB_FAIL(data_block_cache_->prefetch(
+                tenant_id,
+                macro_id,
+                start_info,
+                access_ctx_->query_flag_,
+                *data_read_info,
+                iter_param_->tablet_handle_,
+                macro_handle))) {
+      LOG_WARN("Fail to prefetch micro block", K(ret), K(start_info), K(macro_handle));
+    }
+  } else {
+    ObMultiBlockIOParam io_param;
+    io_param.micro_index_infos_ = &coalesce_io_infos_;
+    io_param.start_index_ = 0;
+    io_param.block_count_ = coalesce_io_infos_.count();
+    if (OB_FAIL(data_block_cache_->prefetch(
+                tenant_id,
+                macro_id,
+                io_param,
+                access_ctx_->query_flag_,
+                *data_read_info,
+                macro_handle))) {
+      LOG_WARN("Fail to prefetch multi micro blocks", K(ret), K(io_param), K(macro_handle));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    const bool is_multi_block_io = coalesce_io_infos_.count() > 1;
+    int64_t block_index = -1;
+    int64_t prev_offset = -1;
+    for (int64_t pos = start_pos; pos < end_pos; ++pos) {
+      const int64_t micro_idx = pending_io_idxs_.at(pos);
+      ObMicroBlockDataHandle &micro_handle = micro_data_handles_[micro_idx];
+      const int64_t block_offset = micro_data_infos_[micro_idx].get_block_offset();
+      if (block_offset != prev_offset) {
+        prev_offset = block_offset;
+        ++block_index;
+      }
+      micro_handle.tenant_id_ = tenant_id;
+      micro_handle.macro_block_id_ = macro_id;
+      micro_handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
+      micro_handle.block_index_ = is_multi_block_io ? block_index : -1;
+      micro_handle.io_handle_ = macro_handle;
+    }
+    LOG_DEBUG("[INDEX BLOCK] submit coalesced io", K(macro_id), K(start_pos), K(end_pos),
+              "block_cnt", coalesce_io_infos_.count());
+  }
+  return ret;
+}
+
 // drill down to get next valid index micro block
 int ObIndexTreeMultiPassPrefetcher::drill_down()
 {
@@ -1162,11 +1433,16 @@ int ObIndexTreeMultiPassPrefetcher::ObIndexTreeLevelHandle::prefetch(
         }
       } else {
         ObSSTableReadHandle &read_handle = prefetcher.read_handles_[index_info.range_idx() % prefetcher.max_range_prefetching_cnt_];
+        bool is_filtered = false;
         if (index_info.is_get() && index_info.is_macro_node() && OB_FAIL(prefetcher.check_bloom_filter(index_info, read_handle))) {
           LOG_WARN("Fail to check bloom filter", K(ret), K(index_info), K(prefetcher.current_read_handle()));
+        } else if (!index_info.is_get() && index_info.is_macro_node() && OB_FAIL(prefetcher.check_bloom_filter(index_info, is_filtered))) {
+          LOG_WARN("Fail to check bloom filter for range", K(ret), K(index_info));
         } else if (level == prefetcher.index_tree_height_ -1 && !index_info.is_leaf_block()) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("Unexpected unbalanced index tree", K(ret), K(level), K(index_info), K(parent));
+        } else if (is_filtered) {
+          // no row of the range in this macro block
         } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_) {
           if (OB_FAIL(prefetcher.prefetch_block_data(index_info, index_block_read_handles_[prefetch_idx].data_handle_, false))) {
             LOG_WARN("Fail to prefetch block data", K(ret), KPC(this));
@@ -28,6 +28,7 @@ namespace oceanbase {
 using namespace blocksstable;
 namespace storage {
 class ObAggregatedStore;
+class ObBlockRowStore;
 
 struct ObSSTableRowState {
   enum ObSSTableRowStateEnum {
@@ -159,10 +160,22 @@ protected:
         sstable_->get_macro_offset());
   }
   int check_bloom_filter(const ObMicroIndexInfo &index_info, ObSSTableReadHandle &read_handle);
+  // probe bloom filter with the rowkey prefix shared by all rows in the scan range
+  int check_bloom_filter(const ObMicroIndexInfo &index_info, bool &is_filtered);
   int prefetch_block_data(
       ObMicroIndexInfo &index_block_info,
       ObMicroBlockDataHandle &micro_handle,
       const bool is_data = true);
+  // find the block in handle mgr and block cache, need_submit_io is set on cache miss
+  int lookup_block_data(
+      ObMicroIndexInfo &index_block_info,
+      ObMicroBlockDataHandle &micro_handle,
+      const bool is_data,
+      bool &need_submit_io);
+  int submit_block_io(
+      ObMicroIndexInfo &index_block_info,
+      ObMicroBlockDataHandle &micro_handle,
+      const bool is_data);
   int lookup_in_cache(ObSSTableReadHandle &read_handle);
 private:
   int lookup_in_index_tree(ObSSTableReadHandle &read_handle);
@@ -204,6 +217,7 @@ public:
       micro_data_prefetch_idx_(0),
       row_lock_check_version_(transaction::ObTransVersion::INVALID_TRANS_VERSION),
       agg_row_store_(nullptr),
+      skip_index_row_store_(nullptr),
       can_blockscan_(false),
       iter_type_(0),
       cur_level_(0),
@@ -215,7 +229,9 @@ public:
       query_range_(nullptr),
       border_rowkey_(),
       read_handles_(),
-      tree_handles_()
+      tree_handles_(),
+      pending_io_idxs_(),
+      coalesce_io_infos_()
   {}
   virtual ~ObIndexTreeMultiPassPrefetcher()
   {}
@@ -275,6 +291,13 @@ private:
   struct ObIndexTreeLevelHandle;
   int prefetch_index_tree();
   int prefetch_micro_data();
+  int prefetch_data_block(const int64_t prefetch_micro_idx);
+  // submit io of the cache missed data blocks of multi get, neighbour blocks of the same
+  // macro block are read by one io
+  int submit_pending_io();
+  int submit_coalesced_io(const int64_t start_pos, const int64_t end_pos);
+  OB_INLINE bool need_coalesce_io() const
+  { return ObStoreRowIterator::IteratorMultiGet == iter_type_; }
   int try_add_query_range(ObIndexTreeLevelHandle &tree_handle);
   int drill_down();
   int prepare_read_handle(
@@ -296,6 +319,18 @@ private:
 
   static const int32_t DEFAULT_SCAN_RANGE_PREFETCH_CNT = 4;
   static const int32_t DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT = 32;
+  // cache missed blocks are read together if the gap between them is small
+  static const int64_t MAX_COALESCE_IO_GAP = 16 * 1024;
+  static const int64_t MAX_COALESCE_IO_SIZE = 2 * 1024 * 1024;
+  typedef common::ObSEArray<int64_t, DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT> PendingIOIdxArray;
+  // sort the pending blocks by macro block and offset
+  static void sort_pending_io(ObMicroIndexInfo *micro_infos, PendingIOIdxArray &pending_io_idxs);
+  // end position of the io starting at start_pos of the sorted pending blocks, the blocks of one io
+  // are in the same macro block, at most MAX_COALESCE_IO_GAP apart and MAX_COALESCE_IO_SIZE in total
+  static int64_t get_coalesced_io_end(
+      ObMicroIndexInfo *micro_infos,
+      const PendingIOIdxArray &pending_io_idxs,
+      const int64_t start_pos);
   static const int32_t INDEX_TREE_PREFETCH_DEPTH = 3;
   struct ObIndexBlockReadHandle {
     ObIndexBlockReadHandle() :
@@ -450,6 +485,8 @@ public:
   int64_t micro_data_prefetch_idx_;
   int64_t row_lock_check_version_;
   ObAggregatedStore *agg_row_store_;
+  // micro blocks filtered out by skip index are not prefetched
+  ObBlockRowStore *skip_index_row_store_;
 private:
   bool can_blockscan_;
   int16_t iter_type_;
@@ -470,6 +507,9 @@ private:
   IndexTreeLevelHandleArray tree_handles_;
   ObMicroIndexInfo micro_data_infos_[DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT];
   ObMicroBlockDataHandle micro_data_handles_[DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT];
+  // ring buffer positions of the data blocks waiting for coalesced io
+  PendingIOIdxArray pending_io_idxs_;
+  common::ObSEArray<ObMicroIndexInfo, DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT> coalesce_io_infos_;
 };
 
 }
@@ -39,6 +39,9 @@ const uint8_t NEON_CMP_MASK_POWER_16[16]
 const uint16_t NEON_CMP_MASK_POWER_8[8]
     = {1, 2, 4, 8, 16, 32, 64, 128};
 
+const uint32_t NEON_CMP_MASK_POWER_4[4]
+    = {1, 2, 4, 8};
+
 
 // comparison wrap up for 16 1-byte data
 template <>
@@ -186,6 +189,43 @@ uint16x8_t neon_cmp_int<uint16x8_t, int16x8_t, sql::WHITE_OP_NE>(int16x8_t left,
   return ~vceqq_s16(left, right);
 }
 
+// comparison wrap up for 4 4-bytes unsigned data
+template <>
+uint32x4_t neon_cmp_int<uint32x4_t, uint32x4_t, sql::WHITE_OP_EQ>(uint32x4_t left, uint32x4_t right)
+{
+  return vceqq_u32(left, right);
+}
+
+template <>
+uint32x4_t neon_cmp_int<uint32x4_t, uint32x4_t, sql::WHITE_OP_LT>(uint32x4_t left, uint32x4_t right)
+{
+  return vcltq_u32(left, right);
+}
+
+template <>
+uint32x4_t neon_cmp_int<uint32x4_t, uint32x4_t, sql::WHITE_OP_LE>(uint32x4_t left, uint32x4_t right)
+{
+  return vcleq_u32(left, right);
+}
+
+template <>
+uint32x4_t neon_cmp_int<uint32x4_t, uint32x4_t, sql::WHITE_OP_GE>(uint32x4_t left, uint32x4_t right)
+{
+  return vcgeq_u32(left, right);
+}
+
+template <>
+uint32x4_t neon_cmp_int<uint32x4_t, uint32x4_t, sql::WHITE_OP_GT>(uint32x4_t left, uint32x4_t right)
+{
+  return vcgtq_u32(left, right);
+}
+
+template <>
+uint32x4_t neon_cmp_int<uint32x4_t, uint32x4_t, sql::WHITE_OP_NE>(uint32x4_t left, uint32x4_t right)
+{
+  return ~vceqq_u32(left, right);
+}
+
 #endif
 
 
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#if defined ( __ARM_NEON )
+#include <arm_neon.h>
+#endif
+
+#include "storage/blocksstable/encoding/ob_encoding_query_util.h"
+#include "storage/blocksstable/encoding/ob_integer_base_diff_decoder.h"
+#include "ob_encoding_neon_util.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+template <int32_t LEN_TAG, int32_t CMP_TYPE>
+struct IntDiffFixFilterNeonFunc_T : public RawFixFilterFunc_T<false, LEN_TAG, CMP_TYPE>
+{};
+
+#if defined ( __ARM_NEON ) && defined ( __aarch64__ )
+
+template <int CMP_TYPE>
+struct IntDiffFixFilterNeonFunc_T<0, CMP_TYPE>
+{
+  // Fast filter with Neon for 1 byte deltas
+  static void fix_filter_func(
+      const int64_t row_cnt,
+      const unsigned char *col_data,
+      const uint64_t node_value,
+      sql::ObBitVector &res)
+  {
+    const uint8_t *stored_values = reinterpret_cast<const uint8_t *>(col_data);
+    uint8_t casted_node_value = static_cast<uint8_t>(node_value);
+
+    uint8x16_t power_vec = vld1q_u8(NEON_CMP_MASK_POWER_16);
+    uint8x16_t node_value_vec = vdupq_n_u8(casted_node_value);
+    for (int64_t i = 0; i < row_cnt / 16; i++) {
+      uint8x16_t data_vec = vld1q_u8(stored_values + i * 16);
+      uint8x16_t cmp_res = neon_cmp_int<uint8x16_t, uint8x16_t, CMP_TYPE>(data_vec, node_value_vec);
+      // generate result bitmap from compare result
+      uint64x2_t bi_mask = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vandq_u8(cmp_res, power_vec))));
+      uint64_t mask = vgetq_lane_u64(bi_mask, 0) + (vgetq_lane_u64(bi_mask, 1) << 8);
+      res.reinterpret_data<uint16_t>()[i] = static_cast<uint16_t>(mask);
+    }
+
+    for (int64_t row_id = row_cnt / 16 * 16; row_id < row_cnt; row_id++) {
+      if (value_cmp_t<uint8_t, CMP_TYPE>(stored_values[row_id], casted_node_value)) {
+        res.set(row_id);
+      }
+    }
+  }
+};
+
+template <int CMP_TYPE>
+struct IntDiffFixFilterNeonFunc_T<1, CMP_TYPE>
+{
+  // Fast filter with Neon for 2 byte deltas
+  static void fix_filter_func(
+      const int64_t row_cnt,
+      const unsigned char *col_data,
+      const uint64_t node_value,
+      sql::ObBitVector &res)
+  {
+    const uint16_t *stored_values = reinterpret_cast<const uint16_t *>(col_data);
+    uint16_t casted_node_value = static_cast<uint16_t>(node_value);
+
+    uint16x8_t power_vec = vld1q_u16(NEON_CMP_MASK_POWER_8);
+    uint16x8_t node_value_vec = vdupq_n_u16(casted_node_value);
+    for (int64_t i = 0; i < row_cnt / 8; ++i) {
+      uint16x8_t data_vec = vld1q_u16(stored_values + i * 8);
+      uint16x8_t cmp_res = neon_cmp_int<uint16x8_t, uint16x8_t, CMP_TYPE>(data_vec, node_value_vec);
+      // generate result bitmap from compare result
+      uint64_t mask = vpaddd_u64(vpaddlq_u32(vpaddlq_u16(vandq_u16(cmp_res, power_vec))));
+      res.reinterpret_data<uint8_t>()[i] = static_cast<uint8_t>(mask);
+    }
+
+    for (int64_t row_id = row_cnt / 8 * 8; row_id < row_cnt; row_id++) {
+      if (value_cmp_t<uint16_t, CMP_TYPE>(stored_values[row_id], casted_node_value)) {
+        res.set(row_id);
+      }
+    }
+  }
+};
+
+template <int CMP_TYPE>
+struct IntDiffFixFilterNeonFunc_T<2, CMP_TYPE>
+{
+  // Fast filter with Neon for 4 byte deltas, also used on unpacked bit packing deltas
+  static void fix_filter_func(
+      const int64_t row_cnt,
+      const unsigned char *col_data,
+      const uint64_t node_value,
+      sql::ObBitVector &res)
+  {
+    const uint32_t *stored_values = reinterpret_cast<const uint32_t *>(col_data);
+    uint32_t casted_node_value = static_cast<uint32_t>(node_value);
+
+    uint32x4_t power_vec = vld1q_u32(NEON_CMP_MASK_POWER_4);
+    uint32x4_t node_value_vec = vdupq_n_u32(casted_node_value);
+    for (int64_t i = 0; i < row_cnt / 8; ++i) {
+      uint32x4_t low_res = neon_cmp_int<uint32x4_t, uint32x4_t, CMP_TYPE>(
+          vld1q_u32(stored_values + i * 8), node_value_vec);
+      uint32x4_t high_res = neon_cmp_int<uint32x4_t, uint32x4_t, CMP_TYPE>(
+          vld1q_u32(stored_values + i * 8 + 4), node_value_vec);
+      // generate result bitmap from compare result
+      uint64_t low_mask = vaddvq_u32(vandq_u32(low_res, power_vec));
+      uint64_t high_mask = vaddvq_u32(vandq_u32(high_res, power_vec));
+      res.reinterpret_data<uint8_t>()[i] = static_cast<uint8_t>(low_mask | (high_mask << 4));
+    }
+
+    for (int64_t row_id = row_cnt / 8 * 8; row_id < row_cnt; row_id++) {
+      if (value_cmp_t<uint32_t, CMP_TYPE>(stored_values[row_id], casted_node_value)) {
+        res.set(row_id);
+      }
+    }
+  }
+};
+#endif
+
+template <int32_t LEN_TAG, int32_t CMP_TYPE>
+struct IntDiffFixFilterNeonArrayInit
+{
+  bool operator()()
+  {
+    int_diff_fix_filter_funcs[LEN_TAG][CMP_TYPE]
+        = &(IntDiffFixFilterNeonFunc_T<LEN_TAG, CMP_TYPE>::fix_filter_func);
+    return true;
+  }
+};
+
+bool init_int_diff_neon_simd_funcs()
+{
+  return ObNDArrayIniter<IntDiffFixFilterNeonArrayInit, 4, 6>::apply();
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -29,6 +29,7 @@ int64_t size_array [] = {                \
   sizeof(ObStringPrefix##Item),          \
   sizeof(ObColumnEqual##Item),           \
   sizeof(ObInterColSubStr##Item),        \
+  sizeof(ObFsstString##Item),            \
 }                                        \
 
 DEF_SIZE_ARRAY(Encoder, encoder_sizes);
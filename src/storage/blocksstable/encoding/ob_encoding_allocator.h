@@ -27,6 +27,7 @@
 #include "ob_string_prefix_encoder.h"
 #include "ob_column_equal_encoder.h"
 #include "ob_inter_column_substring_encoder.h"
+#include "ob_fsst_string_encoder.h"
 #include "ob_raw_decoder.h"
 #include "ob_dict_decoder.h"
 #include "ob_rle_decoder.h"
@@ -37,6 +38,7 @@
 #include "ob_string_prefix_decoder.h"
 #include "ob_column_equal_decoder.h"
 #include "ob_inter_column_substring_decoder.h"
+#include "ob_fsst_string_decoder.h"
 
 namespace oceanbase
 {
@@ -88,6 +90,7 @@ private:
   Pool str_prefix_pool_;
   Pool column_equal_pool_;
   Pool column_substr_pool_;
+  Pool fsst_str_pool_;
   Pool *pools_[ObColumnHeader::MAX_TYPE];
   int64_t pool_cnt_;
 };
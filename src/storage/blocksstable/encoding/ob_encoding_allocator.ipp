@@ -79,6 +79,7 @@ ObEncodingAllocator<EncodingItem>::ObEncodingAllocator(const int64_t *size_array
     str_prefix_pool_(size_array[size_index_++], label),
     column_equal_pool_(size_array[size_index_++], label),
     column_substr_pool_(size_array[size_index_++], label),
+    fsst_str_pool_(size_array[size_index_++], label),
     pool_cnt_(0)
 {
   for (int64_t i = 0; i < ObColumnHeader::MAX_TYPE; i++) {
@@ -102,7 +103,8 @@ int ObEncodingAllocator<EncodingItem>::init()
         || OB_FAIL(add_pool(&hex_str_pool_))
         || OB_FAIL(add_pool(&str_prefix_pool_))
         || OB_FAIL(add_pool(&column_equal_pool_))
-        || OB_FAIL(add_pool(&column_substr_pool_))) {
+        || OB_FAIL(add_pool(&column_substr_pool_))
+        || OB_FAIL(add_pool(&fsst_str_pool_))) {
       STORAGE_LOG(WARN, "add_pool failed", K(ret));
     } else if (pool_cnt_ != size_index_) {
       ret = common::OB_INNER_STAT_ERROR;
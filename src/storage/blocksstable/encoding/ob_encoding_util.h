@@ -32,6 +32,7 @@ extern const char* OB_ENCODING_LABEL_ROW_BUFFER;
 extern const char* OB_ENCODING_LABEL_MULTI_PREFIX_TREE;
 extern const char* OB_ENCODING_LABEL_PREFIX_TREE_FACTORY;
 extern const char* OB_ENCODING_LABEL_STRING_DIFF;
+extern const char* OB_ENCODING_LABEL_FSST;
 
 #define ENCODING_ADAPT_MEMCPY(dst, src, len) \
   switch (len) { \
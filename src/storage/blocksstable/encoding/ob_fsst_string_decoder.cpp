@@ -0,0 +1,280 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_fsst_string_decoder.h"
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "lib/charset/ob_charset.h"
+#include "ob_bit_stream.h"
+#include "ob_raw_decoder.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+const ObColumnHeader::Type ObFsstStringDecoder::type_;
+
+ObFsstStringDecoder::ObFsstStringDecoder() : header_(NULL)
+{
+}
+
+ObFsstStringDecoder::~ObFsstStringDecoder()
+{
+}
+
+int ObFsstStringDecoder::decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+    const ObBitStream &bs, const char *data, const int64_t len) const
+{
+  UNUSED(row_id);
+  int ret = OB_SUCCESS;
+  uint64_t val = STORED_NOT_EXT;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(nullptr == data || len < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(data), K(len));
+  } else if (ctx.has_extend_value()) {
+    if (OB_FAIL(bs.get(ctx.col_header_->extend_value_index_,
+                       ctx.micro_block_header_->extend_value_bit_,
+                       val))) {
+      LOG_WARN("get extend value failed", K(ret), K(bs), K(ctx));
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (STORED_NOT_EXT != val) {
+    set_stored_ext_value(cell, static_cast<ObStoredExtValue>(val));
+  } else {
+    if (cell.get_meta() != ctx.obj_meta_) {
+      cell.set_meta_type(ctx.obj_meta_);
+    }
+    // only the cell itself is decompressed, no need to touch other rows in micro block
+    const char *cell_data = NULL;
+    int64_t cell_len = 0;
+    char *buf = NULL;
+    if (OB_FAIL(ObRawDecoder::locate_cell_data(cell_data, cell_len, data, len,
+            *ctx.micro_block_header_, *ctx.col_header_, *header_))) {
+      LOG_WARN("locate cell data failed", K(ret), K(len), K(ctx), "header", *header_);
+    } else if (OB_ISNULL(buf = static_cast<char *>(
+        ctx.allocator_->alloc(get_decompress_buf_size(cell_len))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate memory", K(ret), K(cell_len));
+    } else {
+      const int64_t str_len = ObFsstSymbolTable::decompress(
+          header_->symbols(), header_->symbol_lens(),
+          reinterpret_cast<const unsigned char *>(cell_data), cell_len,
+          reinterpret_cast<unsigned char *>(buf));
+      cell.val_len_ = static_cast<int32_t>(str_len);
+      cell.v_.string_ = buf;
+    }
+  }
+  return ret;
+}
+
+int ObFsstStringDecoder::update_pointer(const char *old_block, const char *cur_block)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(old_block) || OB_ISNULL(cur_block)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(old_block), KP(cur_block));
+  } else {
+    ObIColumnDecoder::update_pointer(header_, old_block, cur_block);
+  }
+  return ret;
+}
+
+/**
+ * Internal call, not check parameters for performance
+ */
+int ObFsstStringDecoder::batch_decode(
+    const ObColumnDecoderCtx &ctx,
+    const ObIRowIndex* row_index,
+    const int64_t *row_ids,
+    const char **cell_datas,
+    const int64_t row_cap,
+    common::ObDatum *datums) const
+{
+  UNUSED(cell_datas);
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not init", K(ret));
+  } else if (ctx.has_extend_value() && OB_FAIL(set_null_datums_from_var_column(
+      ctx, row_index, row_ids, row_cap, datums))) {
+    LOG_WARN("Failed to set null datums from var data", K(ret), K(ctx));
+  } else {
+    const unsigned char *symbols = header_->symbols();
+    const uint8_t *symbol_lens = header_->symbol_lens();
+    const char *cell_data = nullptr;
+    const char *row_data = nullptr;
+    int64_t row_len = 0;
+    int64_t cell_len = 0;
+    char *buf = nullptr;
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cap; ++i) {
+      if (ctx.has_extend_value() && datums[i].is_null()) {
+        // Skip
+      } else if (OB_FAIL(locate_row_data(ctx, row_index, row_ids[i], row_data, row_len))) {
+        LOG_WARN("Failed to read row data from row index", K(ret), KP(row_index), K(i));
+      } else if (OB_FAIL(ObRawDecoder::locate_cell_data(cell_data, cell_len,
+          row_data, row_len, *ctx.micro_block_header_, *ctx.col_header_, *header_))) {
+        LOG_WARN("Failed to locate cell data", K(ret), K(row_len), KP(row_data), K(i), K(ctx));
+      } else if (OB_ISNULL(buf = static_cast<char *>(
+          ctx.allocator_->alloc(get_decompress_buf_size(cell_len))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("Failed to allocate memory", K(ret), K(cell_len));
+      } else {
+        datums[i].pack_ = static_cast<uint32_t>(ObFsstSymbolTable::decompress(
+            symbols, symbol_lens, reinterpret_cast<const unsigned char *>(cell_data), cell_len,
+            reinterpret_cast<unsigned char *>(buf)));
+        datums[i].ptr_ = buf;
+      }
+    }
+  }
+  return ret;
+}
+
+// Equal strings are compressed to equal bytes with the same symbol table, so EQ / NE
+// can be evaluated on compressed data if bytes comparison is same as the collation.
+bool ObFsstStringDecoder::compressed_compare_valid(
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter) const
+{
+  bool valid = false;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  if ((sql::WHITE_OP_EQ == op_type || sql::WHITE_OP_NE == op_type)
+      && 1 == filter.get_objs().count()
+      && !filter.null_param_contained()
+      && ObStringSC == get_store_class_map()[col_ctx.obj_meta_.get_type_class()]
+      && !col_ctx.obj_meta_.is_fixed_len_char_type()) {
+    const ObObj &ref_obj = filter.get_objs().at(0);
+    const ObCollationType cs_type = col_ctx.obj_meta_.get_collation_type();
+    if (ref_obj.is_string_type() && ref_obj.get_collation_type() == cs_type) {
+      const ObString ref_str = ref_obj.get_string();
+      const bool ref_trailing_space = ref_str.length() > 0
+          && ' ' == ref_str.ptr()[ref_str.length() - 1];
+      valid = CS_TYPE_BINARY == cs_type
+          || (ObCharset::is_bin_sort(cs_type)
+              && !header_->has_trailing_space()
+              && !ref_trailing_space);
+    }
+  }
+  return valid;
+}
+
+int ObFsstStringDecoder::compressed_equal_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const ObIRowIndex* row_index,
+    ObBitmap &result_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  ObFsstSymbolTable symbol_table;
+  const ObString ref_str = filter.get_objs().at(0).get_string();
+  const int64_t buf_size = ref_str.length() * 2 + 1;
+  unsigned char *ref_data = nullptr;
+  if (OB_FAIL(symbol_table.load(*header_))) {
+    LOG_WARN("Failed to load symbol table", K(ret), KPC_(header));
+  } else if (OB_ISNULL(ref_data = static_cast<unsigned char *>(
+      col_ctx.allocator_->alloc(buf_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Failed to allocate memory", K(ret), K(buf_size));
+  } else {
+    const int64_t ref_len = symbol_table.compress(
+        reinterpret_cast<const unsigned char *>(ref_str.ptr()), ref_str.length(), ref_data);
+    const bool is_eq = sql::WHITE_OP_EQ == filter.get_op_type();
+    const bool null_value_contained = result_bitmap.popcnt() > 0;
+    const char *row_data = nullptr;
+    const char *cell_data = nullptr;
+    int64_t row_len = 0;
+    int64_t cell_len = 0;
+    for (int64_t row_id = 0;
+        OB_SUCC(ret) && row_id < col_ctx.micro_block_header_->row_count_;
+        ++row_id) {
+      if (nullptr != parent && parent->can_skip_filter(row_id)) {
+        continue;
+      } else if (null_value_contained && result_bitmap.test(row_id)) {
+        if (OB_FAIL(result_bitmap.set(row_id, false))) {
+          LOG_WARN("Failed to set null value to false", K(ret), K(row_id));
+        }
+      } else if (OB_FAIL(locate_row_data(col_ctx, row_index, row_id, row_data, row_len))) {
+        LOG_WARN("Failed to read row data from row index", K(ret), K(row_id));
+      } else if (OB_FAIL(ObRawDecoder::locate_cell_data(cell_data, cell_len, row_data, row_len,
+          *col_ctx.micro_block_header_, *col_ctx.col_header_, *header_))) {
+        LOG_WARN("Failed to locate cell data", K(ret), K(row_len), K(row_id));
+      } else {
+        const bool equal = cell_len == ref_len && 0 == MEMCMP(cell_data, ref_data, ref_len);
+        if (equal == is_eq && OB_FAIL(result_bitmap.set(row_id))) {
+          LOG_WARN("Failed to set result bitmap", K(ret), K(row_id));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFsstStringDecoder::pushdown_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const char* meta_data,
+    const ObIRowIndex* row_index,
+    ObBitmap &result_bitmap) const
+{
+  // EQ / NE on compressed data, is null / not null with extend value bits.
+  // Other pushdown operators will retrograde to row-wise decode and compare
+  UNUSED(meta_data);
+  int ret = OB_SUCCESS;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  if (OB_UNLIKELY(op_type >= sql::WHITE_OP_MAX) || OB_ISNULL(row_index)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid op type for pushed down white filter", K(ret), K(op_type));
+  } else if (sql::WHITE_OP_NU != op_type
+      && sql::WHITE_OP_NN != op_type
+      && !compressed_compare_valid(col_ctx, filter)) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (OB_FAIL(get_is_null_bitmap_from_var_column(col_ctx, row_index, result_bitmap))) {
+    LOG_WARN("Failed to get isnull bitmap from variable column", K(ret));
+  } else {
+    switch (op_type) {
+      case sql::WHITE_OP_NU: {
+        break;
+      }
+      case sql::WHITE_OP_NN: {
+        if (OB_FAIL(result_bitmap.bit_not())) {
+          LOG_WARN("Failed to flip bits for result bitmap", K(ret), K(result_bitmap.size()));
+        }
+        break;
+      }
+      case sql::WHITE_OP_EQ:
+      case sql::WHITE_OP_NE: {
+        if (OB_FAIL(compressed_equal_operator(parent, col_ctx, filter, row_index, result_bitmap))) {
+          LOG_WARN("Failed on compressed equal operator", K(ret), K(col_ctx));
+        }
+        break;
+      }
+      default: {
+        ret = OB_NOT_SUPPORTED;
+      }
+    }
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
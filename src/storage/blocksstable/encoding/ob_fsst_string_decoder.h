@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_FSST_STRING_DECODER_H_
+#define OCEANBASE_ENCODING_OB_FSST_STRING_DECODER_H_
+
+#include "ob_icolumn_decoder.h"
+#include "ob_encoding_util.h"
+#include "storage/blocksstable/ob_data_buffer.h"
+#include "ob_fsst_string_encoder.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+struct ObColumnHeader;
+struct ObFsstStringHeader;
+
+class ObFsstStringDecoder : public ObIColumnDecoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::STRING_FSST;
+  ObFsstStringDecoder();
+  ~ObFsstStringDecoder();
+
+  OB_INLINE int init(
+      const ObMicroBlockHeader &micro_block_header,
+      const ObColumnHeader &column_header,
+      const char *meta);
+
+  virtual int decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+      const ObBitStream &bs, const char *data, const int64_t len) const override;
+
+  virtual int update_pointer(const char *old_block, const char *cur_block) override;
+
+  void reset() { this->~ObFsstStringDecoder(); new (this) ObFsstStringDecoder(); }
+  OB_INLINE void reuse() { header_ = NULL; }
+  virtual ObColumnHeader::Type get_type() const override { return type_; }
+
+  bool is_inited() const { return NULL != header_; }
+
+  virtual int batch_decode(
+      const ObColumnDecoderCtx &ctx,
+      const ObIRowIndex* row_index,
+      const int64_t *row_ids,
+      const char **cell_datas,
+      const int64_t row_cap,
+      common::ObDatum *datums) const override;
+
+  virtual int pushdown_operator(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter_node,
+      const char* meta_data,
+      const ObIRowIndex* row_index,
+      ObBitmap &result_bitmap) const override;
+private:
+  OB_INLINE int64_t get_decompress_buf_size(const int64_t cell_len) const
+  {
+    return std::min(static_cast<int64_t>(header_->max_string_size_),
+        cell_len * ObFsstSymbolTable::MAX_SYMBOL_LEN) + ObFsstSymbolTable::MAX_SYMBOL_LEN;
+  }
+  bool compressed_compare_valid(
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter) const;
+  int compressed_equal_operator(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter,
+      const ObIRowIndex* row_index,
+      ObBitmap &result_bitmap) const;
+private:
+  const ObFsstStringHeader *header_;
+};
+
+OB_INLINE int ObFsstStringDecoder::init(
+    const ObMicroBlockHeader &micro_block_header,
+    const ObColumnHeader &column_header,
+    const char *meta)
+{
+  // performance critical, don't check params, already checked upper layer
+  UNUSEDx(micro_block_header);
+  int ret = common::OB_SUCCESS;
+  if (is_inited()) {
+    ret = common::OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "init twice", K(ret));
+  } else {
+    meta += column_header.offset_;
+    header_ = reinterpret_cast<const ObFsstStringHeader *>(meta);
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_FSST_STRING_DECODER_H_
@@ -0,0 +1,483 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_fsst_string_encoder.h"
+
+#include <algorithm>
+#include "lib/container/ob_array_iterator.h"
+#include "storage/blocksstable/ob_data_buffer.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+const int64_t ObFsstSymbolTable::MAX_SYMBOL_CNT;
+const int64_t ObFsstSymbolTable::MAX_SYMBOL_LEN;
+const uint8_t ObFsstSymbolTable::ESCAPE_CODE;
+
+void ObFsstSymbolTable::reset()
+{
+  symbol_cnt_ = 0;
+  MEMSET(symbols_, 0, sizeof(symbols_));
+  MEMSET(symbol_lens_, 0, sizeof(symbol_lens_));
+  MEMSET(sorted_codes_, 0, sizeof(sorted_codes_));
+  MEMSET(first_byte_begin_, 0, sizeof(first_byte_begin_));
+}
+
+OB_INLINE int64_t ObFsstSymbolTable::find_longest(
+    const unsigned char *str, const int64_t len, uint8_t &code) const
+{
+  int64_t match_len = 0;
+  uint64_t value = 0;
+  MEMCPY(&value, str, len < MAX_SYMBOL_LEN ? len : MAX_SYMBOL_LEN);
+  const uint8_t first_byte = str[0];
+  for (int64_t i = first_byte_begin_[first_byte]; i < first_byte_begin_[first_byte + 1]; ++i) {
+    const uint8_t c = sorted_codes_[i];
+    const int64_t symbol_len = symbol_lens_[c];
+    if (symbol_len <= len && (value & INTEGER_MASK_TABLE[symbol_len]) == symbols_[c]) {
+      code = c;
+      match_len = symbol_len;
+      break;
+    }
+  }
+  return match_len;
+}
+
+void ObFsstSymbolTable::count_candidate(Candidate *candidates, const uint64_t symbol, const int64_t len)
+{
+  static const int64_t MAX_PROBE_CNT = 16;
+  uint64_t pos = ((symbol * 0x9E3779B97F4A7C15ULL) ^ static_cast<uint64_t>(len))
+      & (CANDIDATE_SLOT_CNT - 1);
+  for (int64_t i = 0; i < MAX_PROBE_CNT; ++i, pos = (pos + 1) & (CANDIDATE_SLOT_CNT - 1)) {
+    Candidate &c = candidates[pos];
+    if (0 == c.len_) {
+      c.symbol_ = symbol;
+      c.len_ = static_cast<uint8_t>(len);
+      c.cnt_ = 1;
+      break;
+    } else if (c.symbol_ == symbol && c.len_ == len) {
+      c.cnt_++;
+      break;
+    }
+  }
+  // candidate dropped if no free slot nearby, only affects compression ratio
+}
+
+void ObFsstSymbolTable::add_symbol(const uint64_t symbol, const int64_t len)
+{
+  symbols_[symbol_cnt_] = symbol & INTEGER_MASK_TABLE[len];
+  symbol_lens_[symbol_cnt_] = static_cast<uint8_t>(len);
+  ++symbol_cnt_;
+}
+
+void ObFsstSymbolTable::build_index()
+{
+  for (int64_t i = 0; i < symbol_cnt_; ++i) {
+    sorted_codes_[i] = static_cast<uint8_t>(i);
+  }
+  std::sort(sorted_codes_, sorted_codes_ + symbol_cnt_,
+      [this](const uint8_t l, const uint8_t r) {
+        const uint8_t l_first = static_cast<uint8_t>(symbols_[l] & 0xFF);
+        const uint8_t r_first = static_cast<uint8_t>(symbols_[r] & 0xFF);
+        return l_first < r_first
+            || (l_first == r_first && symbol_lens_[l] > symbol_lens_[r])
+            || (l_first == r_first && symbol_lens_[l] == symbol_lens_[r] && l < r);
+      });
+  MEMSET(first_byte_begin_, 0, sizeof(first_byte_begin_));
+  for (int64_t i = 0; i < symbol_cnt_; ++i) {
+    first_byte_begin_[(symbols_[i] & 0xFF) + 1]++;
+  }
+  for (int64_t i = 1; i < ARRAYSIZEOF(first_byte_begin_); ++i) {
+    first_byte_begin_[i] = static_cast<uint16_t>(first_byte_begin_[i] + first_byte_begin_[i - 1]);
+  }
+}
+
+int ObFsstSymbolTable::build(
+    const ObString *samples,
+    const int64_t sample_cnt,
+    ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  Candidate *candidates = NULL;
+  const int64_t candidates_size = sizeof(Candidate) * CANDIDATE_SLOT_CNT;
+  reset();
+  if (OB_UNLIKELY(sample_cnt < 0 || (sample_cnt > 0 && NULL == samples))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(samples), K(sample_cnt));
+  } else if (OB_ISNULL(candidates = static_cast<Candidate *>(allocator.alloc(candidates_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", K(ret), K(candidates_size));
+  } else {
+    // Each round compresses the samples with current table, counts used symbols and
+    // concatenation of adjacent symbols, then keeps the candidates with highest gain.
+    // Symbol length may double every round.
+    for (int64_t round = 0; round < BUILD_ROUND; ++round) {
+      MEMSET(candidates, 0, candidates_size);
+      for (int64_t i = 0; i < sample_cnt; ++i) {
+        const unsigned char *str = reinterpret_cast<const unsigned char *>(samples[i].ptr());
+        const int64_t len = samples[i].length();
+        uint64_t prev_symbol = 0;
+        int64_t prev_len = 0;
+        for (int64_t pos = 0; pos < len;) {
+          uint8_t code = ESCAPE_CODE;
+          uint64_t symbol = 0;
+          int64_t match_len = find_longest(str + pos, len - pos, code);
+          if (0 == match_len) {
+            match_len = 1;
+            symbol = str[pos];
+          } else {
+            symbol = symbols_[code];
+          }
+          count_candidate(candidates, symbol, match_len);
+          if (prev_len > 0 && prev_len + match_len <= MAX_SYMBOL_LEN) {
+            count_candidate(candidates, prev_symbol | (symbol << (prev_len * CHAR_BIT)),
+                prev_len + match_len);
+          }
+          prev_symbol = symbol;
+          prev_len = match_len;
+          pos += match_len;
+        }
+      }
+
+      Candidate *end = std::remove_if(candidates, candidates + CANDIDATE_SLOT_CNT,
+          [](const Candidate &c) { return 0 == c.len_ || (c.len_ > 1 && c.cnt_ < 2); });
+      std::sort(candidates, end, [](const Candidate &l, const Candidate &r) {
+            return l.gain() > r.gain()
+                || (l.gain() == r.gain() && l.len_ > r.len_)
+                || (l.gain() == r.gain() && l.len_ == r.len_ && l.symbol_ < r.symbol_);
+          });
+      symbol_cnt_ = 0;
+      for (Candidate *c = candidates; c < end && symbol_cnt_ < MAX_SYMBOL_CNT; ++c) {
+        add_symbol(c->symbol_, c->len_);
+      }
+      build_index();
+    }
+    allocator.free(candidates);
+  }
+  return ret;
+}
+
+int ObFsstSymbolTable::load(const ObFsstStringHeader &header)
+{
+  int ret = OB_SUCCESS;
+  const uint8_t *symbol_lens = header.symbol_lens();
+  reset();
+  for (int64_t i = 0; OB_SUCC(ret) && i < header.symbol_cnt_; ++i) {
+    if (OB_UNLIKELY(0 == symbol_lens[i] || symbol_lens[i] > MAX_SYMBOL_LEN)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid symbol length", K(ret), K(i), "len", symbol_lens[i], K(header));
+    } else {
+      uint64_t symbol = 0;
+      MEMCPY(&symbol, header.symbols() + i * MAX_SYMBOL_LEN, MAX_SYMBOL_LEN);
+      add_symbol(symbol, symbol_lens[i]);
+    }
+  }
+  if (OB_SUCC(ret)) {
+    build_index();
+  }
+  return ret;
+}
+
+void ObFsstSymbolTable::store(ObFsstStringHeader &header) const
+{
+  header.symbol_cnt_ = static_cast<uint8_t>(symbol_cnt_);
+  unsigned char *symbols = header.symbol_array_;
+  MEMCPY(symbols, symbols_, symbol_cnt_ * MAX_SYMBOL_LEN);
+  MEMCPY(symbols + symbol_cnt_ * MAX_SYMBOL_LEN, symbol_lens_, symbol_cnt_);
+}
+
+int64_t ObFsstSymbolTable::compress(
+    const unsigned char *str, const int64_t len, unsigned char *buf) const
+{
+  // performance critical, don't check params
+  unsigned char *p = buf;
+  for (int64_t pos = 0; pos < len;) {
+    uint8_t code = ESCAPE_CODE;
+    const int64_t match_len = find_longest(str + pos, len - pos, code);
+    if (match_len > 0) {
+      *p++ = code;
+      pos += match_len;
+    } else {
+      *p++ = ESCAPE_CODE;
+      *p++ = str[pos++];
+    }
+  }
+  return p - buf;
+}
+
+const ObColumnHeader::Type ObFsstStringEncoder::type_;
+
+ObFsstStringEncoder::ObFsstStringEncoder()
+  : max_string_size_(0), null_cnt_(0), nope_cnt_(0), compressed_size_(0),
+    has_trailing_space_(false), cell_offsets_(NULL), compressed_data_(NULL),
+    header_(NULL), symbol_table_(),
+    allocator_(blocksstable::OB_ENCODING_LABEL_FSST)
+{
+}
+
+int ObFsstStringEncoder::init(
+    const ObColumnEncodingCtx &ctx,
+    const int64_t column_index,
+    const ObConstDatumRowArray &rows)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(ObIColumnEncoder::init(ctx, column_index, rows))) {
+    LOG_WARN("init base column encoder failed",
+        K(ret), K(ctx), K(column_index), "row count", rows.count());
+  } else {
+    column_header_.type_ = type_;
+    const ObObjTypeStoreClass sc = get_store_class_map()[
+        ob_obj_type_class(column_type_.get_type())];
+    if (OB_UNLIKELY(!is_string_encoding_valid(sc))) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("not supported type for fsst string", K(ret), K(sc), K_(column_index));
+    }
+  }
+  return ret;
+}
+
+int ObFsstStringEncoder::traverse(bool &suitable)
+{
+  int ret = OB_SUCCESS;
+  suitable = false;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    int64_t sum_size = 0;
+    FOREACH_X(r, *rows_, OB_SUCC(ret)) {
+      const ObDatum &datum = r->get_datum(column_index_);
+      if (datum.is_null()) {
+        null_cnt_++;
+      } else if (datum.is_nop()) {
+        nope_cnt_++;
+      } else if (datum.is_ext()) {
+        ret = OB_NOT_SUPPORTED;
+        LOG_WARN("not supported extend object type",
+            K(ret), K(datum), K_(column_type), K_(column_index));
+      } else {
+        sum_size += datum.len_;
+        max_string_size_ = std::max(max_string_size_, static_cast<int64_t>(datum.len_));
+        if (datum.len_ > 0 && ' ' == datum.ptr_[datum.len_ - 1]) {
+          has_trailing_space_ = true;
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (rows_->count() - null_cnt_ - nope_cnt_ <= 1 || max_string_size_ > UINT32_MAX) {
+    } else if (OB_FAIL(build_symbol_table(sum_size))) {
+      LOG_WARN("build symbol table failed", K(ret), K(sum_size));
+    } else if (OB_FAIL(compress_all(sum_size))) {
+      LOG_WARN("compress column data failed", K(ret), K(sum_size));
+    } else {
+      suitable = true;
+      desc_.is_var_data_ = true;
+      desc_.need_data_store_ = true;
+      desc_.has_null_ = null_cnt_ > 0;
+      desc_.has_nope_ = nope_cnt_ > 0;
+      desc_.need_extend_value_bit_store_ = desc_.has_null_ || desc_.has_nope_;
+      if (desc_.need_extend_value_bit_store_) {
+        column_header_.set_has_extend_value_attr();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFsstStringEncoder::build_symbol_table(const int64_t sum_size)
+{
+  int ret = OB_SUCCESS;
+  // sample rows evenly across the micro block
+  const int64_t step = sum_size / ObFsstSymbolTable::MAX_SAMPLE_SIZE + 1;
+  const int64_t max_sample_cnt = rows_->count() / step + 1;
+  ObString *samples = NULL;
+  int64_t sample_cnt = 0;
+  if (OB_ISNULL(samples = static_cast<ObString *>(
+      allocator_.alloc(sizeof(ObString) * max_sample_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", K(ret), K(max_sample_cnt));
+  } else {
+    for (int64_t row_id = 0; row_id < rows_->count() && sample_cnt < max_sample_cnt;
+        row_id += step) {
+      const ObDatum &datum = rows_->at(row_id).get_datum(column_index_);
+      if (!datum.is_null() && !datum.is_nop()) {
+        samples[sample_cnt++].assign_ptr(datum.ptr_, datum.len_);
+      }
+    }
+    if (OB_FAIL(symbol_table_.build(samples, sample_cnt, allocator_))) {
+      LOG_WARN("build fsst symbol table failed", K(ret), K(sample_cnt));
+    }
+  }
+  return ret;
+}
+
+int ObFsstStringEncoder::compress_all(const int64_t sum_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_cnt = rows_->count();
+  // every byte costs 2 bytes at most
+  const int64_t buf_size = sum_size * 2 + 1;
+  if (OB_ISNULL(cell_offsets_ = static_cast<uint32_t *>(
+      allocator_.alloc(sizeof(uint32_t) * (row_cnt + 1))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", K(ret), K(row_cnt));
+  } else if (OB_ISNULL(compressed_data_ = static_cast<unsigned char *>(
+      allocator_.alloc(buf_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", K(ret), K(buf_size));
+  } else {
+    int64_t pos = 0;
+    for (int64_t row_id = 0; row_id < row_cnt; ++row_id) {
+      const ObDatum &datum = rows_->at(row_id).get_datum(column_index_);
+      cell_offsets_[row_id] = static_cast<uint32_t>(pos);
+      if (!datum.is_null() && !datum.is_nop()) {
+        pos += symbol_table_.compress(reinterpret_cast<const unsigned char *>(datum.ptr_),
+            datum.len_, compressed_data_ + pos);
+      }
+    }
+    cell_offsets_[row_cnt] = static_cast<uint32_t>(pos);
+    compressed_size_ = pos;
+  }
+  return ret;
+}
+
+int ObFsstStringEncoder::store_meta(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    header_ = reinterpret_cast<ObFsstStringHeader *>(buf_writer.current());
+    const int64_t size = ObFsstStringHeader::get_size(symbol_table_.get_symbol_cnt());
+    if (OB_FAIL(buf_writer.advance_zero(size))) {
+      LOG_WARN("advance meta store size failed", K(ret), K(size));
+    } else {
+      header_->reset();
+      header_->max_string_size_ = static_cast<uint32_t>(max_string_size_);
+      if (has_trailing_space_) {
+        header_->flags_ |= ObFsstStringHeader::HAS_TRAILING_SPACE;
+      }
+      symbol_table_.store(*header_);
+    }
+  }
+  return ret;
+}
+
+int ObFsstStringEncoder::store_data(
+    const int64_t row_id, ObBitStream &bs, char *buf, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_id < 0 || row_id >= rows_->count() || len < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_id), K(len));
+  } else {
+    const ObDatum &datum = rows_->at(row_id).get_datum(column_index_);
+    const ObStoredExtValue ext_val = get_stored_ext_value(datum);
+    if (STORED_NOT_EXT != ext_val) {
+      if (OB_FAIL(bs.set(column_header_.extend_value_index_,
+          extend_value_bit_, static_cast<int64_t>(ext_val)))) {
+        LOG_WARN("store extend value bit failed",
+            K(ret), K_(column_header), K_(extend_value_bit), K(ext_val));
+      }
+    } else {
+      const int64_t cell_len = cell_offsets_[row_id + 1] - cell_offsets_[row_id];
+      if (OB_UNLIKELY(cell_len > len)) {
+        ret = OB_BUF_NOT_ENOUGH;
+        LOG_WARN("buffer not enough", K(ret), K(row_id), K(cell_len), K(len));
+      } else {
+        MEMCPY(buf, compressed_data_ + cell_offsets_[row_id], cell_len);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFsstStringEncoder::set_data_pos(const int64_t offset, const int64_t length)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(header_)) {
+    ret = OB_INNER_STAT_ERROR;
+    LOG_WARN("call set data pos before store meta", K(ret));
+  } else if (offset < 0 || length < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid data position",
+        K(ret), K(offset), K(length), K(desc_), K_(column_header));
+  } else {
+    header_->offset_ = static_cast<uint32_t>(offset);
+    header_->length_ = static_cast<uint32_t>(length);
+  }
+  return ret;
+}
+
+int ObFsstStringEncoder::get_var_length(const int64_t row_id, int64_t &length)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_id < 0 || row_id >= rows_->count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_id));
+  } else {
+    // null and nop are compressed to empty string
+    length = cell_offsets_[row_id + 1] - cell_offsets_[row_id];
+  }
+  return ret;
+}
+
+int64_t ObFsstStringEncoder::calc_size() const
+{
+  int64_t size = INT64_MAX;
+  if (is_inited_) {
+    size = ObFsstStringHeader::get_size(symbol_table_.get_symbol_cnt())
+        + DEF_VAR_INDEX_BYTE * rows_->count() + compressed_size_;
+  }
+  return size;
+}
+
+void ObFsstStringEncoder::reuse()
+{
+  ObIColumnEncoder::reuse();
+  max_string_size_ = 0;
+  null_cnt_ = 0;
+  nope_cnt_ = 0;
+  compressed_size_ = 0;
+  has_trailing_space_ = false;
+  cell_offsets_ = NULL;
+  compressed_data_ = NULL;
+  header_ = NULL;
+  symbol_table_.reset();
+  allocator_.reuse();
+}
+
+int ObFsstStringEncoder::store_fix_data(ObBufferWriter &buf_writer)
+{
+  UNUSED(buf_writer);
+  return OB_NOT_SUPPORTED;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_FSST_STRING_ENCODER_H_
+#define OCEANBASE_ENCODING_OB_FSST_STRING_ENCODER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "ob_icolumn_encoder.h"
+#include "ob_encoding_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+struct ObFsstStringHeader
+{
+  static constexpr uint8_t OB_FSST_STRING_HEADER_V1 = 0;
+  // some stored string ends with space, bytes comparison not equal to PAD SPACE comparison
+  static constexpr uint8_t HAS_TRAILING_SPACE = 0x1;
+
+  void reset() { memset(this, 0, sizeof(*this)); }
+  // symbol_cnt_ symbols in 8 bytes slots, followed by symbol_cnt_ symbol lengths
+  OB_INLINE const unsigned char *symbols() const { return symbol_array_; }
+  OB_INLINE const uint8_t *symbol_lens() const { return symbol_array_ + symbol_cnt_ * sizeof(uint64_t); }
+  OB_INLINE bool has_trailing_space() const { return flags_ & HAS_TRAILING_SPACE; }
+  OB_INLINE static int64_t get_size(const int64_t symbol_cnt)
+  {
+    return sizeof(ObFsstStringHeader) + symbol_cnt * (sizeof(uint64_t) + sizeof(uint8_t));
+  }
+
+  uint8_t version_;
+  uint8_t symbol_cnt_;
+  uint8_t flags_;
+  uint32_t offset_;
+  uint32_t length_;
+  uint32_t max_string_size_;
+  unsigned char symbol_array_[0];
+
+  TO_STRING_KV(K_(version), K_(symbol_cnt), K_(flags), K_(offset), K_(length), K_(max_string_size));
+} __attribute__((packed));
+
+// Static symbol table of FSST (Fast Static Symbol Table) compression.
+// Up to 255 symbols of 1 ~ 8 bytes are coded with one byte, other bytes are
+// stored as escape code followed by the byte itself. Every string is compressed
+// independently, so single value can be decoded without touching its neighbors.
+// Compression is greedy longest match, equal strings are always compressed
+// to equal bytes under the same table.
+class ObFsstSymbolTable
+{
+public:
+  static const int64_t MAX_SYMBOL_CNT = 255;
+  static const int64_t MAX_SYMBOL_LEN = sizeof(uint64_t);
+  static const uint8_t ESCAPE_CODE = 255;
+  static const int64_t BUILD_ROUND = 5;
+  static const int64_t MAX_SAMPLE_SIZE = 16 << 10;
+
+  ObFsstSymbolTable() { reset(); }
+  void reset();
+  int build(const common::ObString *samples, const int64_t sample_cnt,
+      common::ObIAllocator &allocator);
+  int load(const ObFsstStringHeader &header);
+  void store(ObFsstStringHeader &header) const;
+
+  // @buf should be at least 2 * @len bytes
+  int64_t compress(const unsigned char *str, const int64_t len, unsigned char *buf) const;
+  // @buf should be at least decompressed length + MAX_SYMBOL_LEN bytes
+  OB_INLINE static int64_t decompress(
+      const unsigned char *symbols,
+      const uint8_t *symbol_lens,
+      const unsigned char *data,
+      const int64_t len,
+      unsigned char *buf);
+
+  OB_INLINE int64_t get_symbol_cnt() const { return symbol_cnt_; }
+
+  TO_STRING_KV(K_(symbol_cnt));
+private:
+  struct Candidate
+  {
+    uint64_t symbol_;
+    uint32_t cnt_;
+    uint8_t len_;
+    OB_INLINE int64_t gain() const { return static_cast<int64_t>(cnt_) * len_; }
+  };
+  static const int64_t CANDIDATE_SLOT_CNT = 1 << 12;
+
+  OB_INLINE int64_t find_longest(const unsigned char *str, const int64_t len, uint8_t &code) const;
+  static void count_candidate(Candidate *candidates, const uint64_t symbol, const int64_t len);
+  void add_symbol(const uint64_t symbol, const int64_t len);
+  void build_index();
+
+private:
+  int64_t symbol_cnt_;
+  uint64_t symbols_[MAX_SYMBOL_CNT];
+  uint8_t symbol_lens_[MAX_SYMBOL_CNT];
+  // codes sorted by first byte and symbol length in descending order
+  uint8_t sorted_codes_[MAX_SYMBOL_CNT];
+  uint16_t first_byte_begin_[(1 << CHAR_BIT) + 1];
+};
+
+OB_INLINE int64_t ObFsstSymbolTable::decompress(
+    const unsigned char *symbols,
+    const uint8_t *symbol_lens,
+    const unsigned char *data,
+    const int64_t len,
+    unsigned char *buf)
+{
+  // performance critical, don't check params
+  unsigned char *p = buf;
+  const unsigned char *end = data + len;
+  while (data < end) {
+    const uint8_t code = *data++;
+    if (OB_LIKELY(ESCAPE_CODE != code)) {
+      // always copy the whole slot, then advance with the real symbol length
+      MEMCPY(p, symbols + code * MAX_SYMBOL_LEN, MAX_SYMBOL_LEN);
+      p += symbol_lens[code];
+    } else {
+      *p++ = *data++;
+    }
+  }
+  return p - buf;
+}
+
+class ObFsstStringEncoder : public ObIColumnEncoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::STRING_FSST;
+  ObFsstStringEncoder();
+  virtual ~ObFsstStringEncoder() {}
+
+  virtual int init(
+      const ObColumnEncodingCtx &ctx,
+      const int64_t column_index,
+      const ObConstDatumRowArray &rows) override;
+
+  virtual int set_data_pos(const int64_t offset, const int64_t length) override;
+  virtual int get_var_length(const int64_t row_id, int64_t &length) override;
+  virtual int store_meta(ObBufferWriter &buf_writer) override;
+  virtual int store_data(
+      const int64_t row_id, ObBitStream &bs, char *buf, const int64_t len) override;
+
+  virtual int traverse(bool &suitable) override;
+  virtual int64_t calc_size() const override;
+  virtual ObColumnHeader::Type get_type() const override { return type_; }
+
+  virtual void reuse() override;
+  virtual int store_fix_data(ObBufferWriter &buf_writer) override;
+
+private:
+  int build_symbol_table(const int64_t sum_size);
+  int compress_all(const int64_t sum_size);
+
+private:
+  int64_t max_string_size_;
+  int64_t null_cnt_;
+  int64_t nope_cnt_;
+  int64_t compressed_size_;
+  bool has_trailing_space_;
+  // compressed value of row i is [cell_offsets_[i], cell_offsets_[i + 1]) in compressed_data_
+  uint32_t *cell_offsets_;
+  unsigned char *compressed_data_;
+  ObFsstStringHeader *header_;
+  ObFsstSymbolTable symbol_table_;
+  common::ObArenaAllocator allocator_;
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+#endif // OCEANBASE_ENCODING_OB_FSST_STRING_ENCODER_H_
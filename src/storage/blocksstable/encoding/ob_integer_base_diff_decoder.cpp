@@ -24,6 +24,104 @@ namespace blocksstable
 {
 using namespace common;
 const ObColumnHeader::Type ObIntegerBaseDiffDecoder::type_;
+const int64_t ObIntegerBaseDiffDecoder::MAX_FAST_UNPACK_LEN;
+const int64_t ObIntegerBaseDiffDecoder::UNPACK_BATCH_SIZE;
+
+static void int_diff_bp_unpack_generic(
+    const unsigned char *col_data,
+    const int64_t data_offset,
+    const int64_t bs_len,
+    const int64_t packed_len,
+    const int64_t start,
+    const int64_t cnt,
+    uint32_t *deltas)
+{
+  int64_t value = 0;
+  for (int64_t i = 0; i < cnt; ++i) {
+    ObBitStream::get<ObBitStream::PACKED_LEN_LESS_THAN_26>(
+        col_data, data_offset + (start + i) * packed_len, packed_len, bs_len, value);
+    deltas[i] = static_cast<uint32_t>(value);
+  }
+}
+
+template <bool HAS_NULL, int32_t STORE_LEN_TAG, int32_t DATUM_LEN_TAG>
+struct IntDiffFixBatchDecodeFunc_T
+{
+  static void int_diff_fix_batch_decode_func(
+      const uint64_t base,
+      const unsigned char *col_data,
+      const int64_t *row_ids,
+      const int64_t row_cap,
+      common::ObDatum *datums)
+  {
+    typedef typename ObEncodingTypeInference<0, STORE_LEN_TAG>::Type StoreType;
+    typedef typename ObEncodingTypeInference<0, DATUM_LEN_TAG>::Type DatumType;
+    const StoreType *deltas = reinterpret_cast<const StoreType *>(col_data);
+    for (int64_t i = 0; i < row_cap; ++i) {
+      if (HAS_NULL && datums[i].is_null()) {
+        // Skip
+      } else {
+        *reinterpret_cast<DatumType *>(const_cast<char *>(datums[i].ptr_))
+            = static_cast<DatumType>(base + deltas[row_ids[i]]);
+        datums[i].pack_ = sizeof(DatumType);
+      }
+    }
+  }
+};
+
+static ObMultiDimArray_T<int_diff_fix_batch_decode_func, 2, 4, 4> int_diff_fix_batch_decode_funcs;
+
+template <int32_t HAS_NULL, int32_t STORE_LEN_TAG, int32_t DATUM_LEN_TAG>
+struct IntDiffFixDecoderArrayInit
+{
+  bool operator()()
+  {
+    int_diff_fix_batch_decode_funcs[HAS_NULL][STORE_LEN_TAG][DATUM_LEN_TAG]
+        = &(IntDiffFixBatchDecodeFunc_T<HAS_NULL, STORE_LEN_TAG, DATUM_LEN_TAG>::int_diff_fix_batch_decode_func);
+    return true;
+  }
+};
+
+static bool int_diff_fix_batch_decode_funcs_inited
+    = ObNDArrayIniter<IntDiffFixDecoderArrayInit, 2, 4, 4>::apply();
+
+ObMultiDimArray_T<fix_filter_func, 4, 6> int_diff_fix_filter_funcs;
+int_diff_bp_unpack_func int_diff_bp_unpack = nullptr;
+
+bool init_int_diff_avx2_simd_funcs();
+bool init_int_diff_neon_simd_funcs();
+
+// Deltas are always stored unsigned
+template <int32_t LEN_TAG, int32_t CMP_TYPE>
+struct IntDiffFixFilterArrayInit
+{
+  bool operator()()
+  {
+    int_diff_fix_filter_funcs[LEN_TAG][CMP_TYPE]
+        = &(RawFixFilterFunc_T<false, LEN_TAG, CMP_TYPE>::fix_filter_func);
+    return true;
+  }
+};
+
+bool init_int_diff_fast_funcs()
+{
+  bool res = false;
+  int_diff_bp_unpack = &int_diff_bp_unpack_generic;
+  res = ObNDArrayIniter<IntDiffFixFilterArrayInit, 4, 6>::apply();
+  // Dispatch simd version unpack and cmp funcs
+#if defined ( __x86_64__ )
+  if (res && is_avx2_valid()) {
+    res = init_int_diff_avx2_simd_funcs();
+  }
+#elif defined ( __aarch64__ ) && defined ( __ARM_NEON )
+  if (res) {
+    res = init_int_diff_neon_simd_funcs();
+  }
+#endif
+  return res;
+}
+
+bool int_diff_fast_funcs_inited = init_int_diff_fast_funcs();
 
 int ObIntegerBaseDiffDecoder::decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
     const ObBitStream &bs, const char *data, const int64_t len) const
@@ -154,8 +252,54 @@ int ObIntegerBaseDiffDecoder::batch_get_bitpacked_values(
 
 #undef INT_DIFF_UNPACK_REFS
 
+// Row ids should be continuous and ascending
+int ObIntegerBaseDiffDecoder::batch_unpack_continuous_values(
+    const ObColumnDecoderCtx &ctx,
+    const int64_t *row_ids,
+    const int64_t row_cap,
+    const int64_t datum_len,
+    const int64_t data_offset,
+    common::ObDatum *datums) const
+{
+  int ret = OB_SUCCESS;
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_)
+                                  + ctx.col_header_->length_;
+  const int64_t packed_len = header_->length_;
+  const int64_t bs_len = data_offset + ctx.micro_block_header_->row_count_ * packed_len;
+  const bool has_ext_val = ctx.has_extend_value();
+  uint32_t deltas[UNPACK_BATCH_SIZE];
+  uint64_t value = 0;
+  for (int64_t start = 0; start < row_cap; start += UNPACK_BATCH_SIZE) {
+    const int64_t cnt = MIN(UNPACK_BATCH_SIZE, row_cap - start);
+    int_diff_bp_unpack(col_data, data_offset, bs_len, packed_len, row_ids[start], cnt, deltas);
+    for (int64_t i = 0; i < cnt; ++i) {
+      ObDatum &datum = datums[start + i];
+      if (has_ext_val && datum.is_null()) {
+        // Skip
+      } else {
+        value = base_ + deltas[i];
+        ENCODING_ADAPT_MEMCPY(const_cast<char *>(datum.ptr_), &value, datum_len);
+        datum.pack_ = static_cast<uint32_t>(datum_len);
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObIntegerBaseDiffDecoder::fast_decode_valid(const ObColumnDecoderCtx &ctx) const
+{
+  bool valid = false;
+  if (ctx.is_bit_packing()) {
+    valid = header_->length_ <= MAX_FAST_UNPACK_LEN && int_diff_fast_funcs_inited;
+  } else {
+    const int64_t store_size = header_->length_;
+    valid = (store_size == 1 || store_size == 2 || store_size == 4 || store_size == 8)
+        && int_diff_fix_batch_decode_funcs_inited;
+  }
+  return valid;
+}
+
 // Internal call, not check parameters for performance
-// Potential optimization: SIMD batch add @base_ to packed delta values
 int ObIntegerBaseDiffDecoder::batch_decode(
     const ObColumnDecoderCtx &ctx,
     const ObIRowIndex* row_index,
@@ -189,10 +333,23 @@ int ObIntegerBaseDiffDecoder::batch_decode(
         datum_len))) {
       LOG_WARN("Failed to get datum length of int/uint data", K(ret));
     } else if (ctx.is_bit_packing()) {
-      if (OB_FAIL(batch_get_bitpacked_values(
+      if (fast_decode_valid(ctx) && row_cap > 0
+          && row_ids[row_cap - 1] - row_ids[0] == row_cap - 1) {
+        if (OB_FAIL(batch_unpack_continuous_values(
+            ctx, row_ids, row_cap, datum_len, data_offset, datums))) {
+          LOG_WARN("Failed to batch unpack continuous delta values", K(ret), K(ctx));
+        }
+      } else if (OB_FAIL(batch_get_bitpacked_values(
           ctx, row_ids, row_cap, datum_len, data_offset, datums))) {
         LOG_WARN("Failed to batch unpack delta values", K(ret), K(ctx));
       }
+    } else if (fast_decode_valid(ctx)) {
+      data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
+      int_diff_fix_batch_decode_func decode_func = int_diff_fix_batch_decode_funcs
+          [ctx.has_extend_value()]
+          [get_value_len_tag_map()[header_->length_]]
+          [get_value_len_tag_map()[datum_len]];
+      decode_func(base_, col_data + data_offset, row_ids, row_cap, datums);
     } else {
       // Fixed store data
       data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
@@ -395,6 +552,11 @@ int ObIntegerBaseDiffDecoder::comparison_operator(
       }
 
       if (OB_FAIL(ret)) {
+      } else if (fast_filter_valid(col_ctx)) {
+        if (OB_FAIL(fast_comparison_operator(col_ctx, col_data, param_delta_value,
+            filter.get_op_type(), result_bitmap))) {
+          LOG_WARN("Failed on fast comparison operator", K(ret), K(col_ctx));
+        }
       } else if (col_ctx.is_bit_packing()) {
         for (int64_t row_id = 0;
             OB_SUCC(ret) && row_id < col_ctx.micro_block_header_->row_count_;
@@ -442,6 +604,87 @@ int ObIntegerBaseDiffDecoder::comparison_operator(
   return ret;
 }
 
+bool ObIntegerBaseDiffDecoder::fast_filter_valid(const ObColumnDecoderCtx &ctx) const
+{
+  bool valid = false;
+  if (ctx.is_bit_packing()) {
+    valid = header_->length_ <= MAX_FAST_UNPACK_LEN;
+  } else {
+    const int64_t store_size = header_->length_;
+    valid = (store_size == 1 || store_size == 2 || store_size == 4 || store_size == 8);
+  }
+  return valid && int_diff_fast_funcs_inited;
+}
+
+int ObIntegerBaseDiffDecoder::fast_comparison_operator(
+    const ObColumnDecoderCtx &col_ctx,
+    const unsigned char* col_data,
+    const uint64_t param_delta,
+    const sql::ObWhiteFilterOperatorType op_type,
+    ObBitmap &result_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_cnt = col_ctx.micro_block_header_->row_count_;
+  const int64_t cell_len = header_->length_;
+  const uint64_t max_delta = col_ctx.is_bit_packing()
+      ? ((1UL << cell_len) - 1)
+      : INTEGER_MASK_TABLE[cell_len];
+  const bool null_value_contained = result_bitmap.popcnt() > 0;
+  if (param_delta > max_delta) {
+    // Filter value is larger than all stored values
+    if (sql::WHITE_OP_LT == op_type || sql::WHITE_OP_LE == op_type
+        || sql::WHITE_OP_NE == op_type) {
+      if (OB_FAIL(result_bitmap.bit_not())) {
+        LOG_WARN("Failed to set result bitmap to all true", K(ret));
+      }
+    } else {
+      result_bitmap.reuse();
+    }
+  } else {
+    int64_t data_offset = 0;
+    if (col_ctx.has_extend_value()) {
+      data_offset = row_cnt * col_ctx.micro_block_header_->extend_value_bit_;
+    }
+    const int64_t size = sql::ObBitVector::memory_size(row_cnt);
+    // Use BitVector to set the result of filter here because the memory of ObBitMap is not continuous
+    char buf[size];
+    sql::ObBitVector *bit_vec = sql::to_bit_vector(buf);
+    bit_vec->reset(row_cnt);
+    if (col_ctx.is_bit_packing()) {
+      const int64_t bs_len = data_offset + row_cnt * cell_len;
+      uint32_t deltas[UNPACK_BATCH_SIZE];
+      fix_filter_func filter_func = int_diff_fix_filter_funcs
+          [get_value_len_tag_map()[sizeof(uint32_t)]]
+          [op_type];
+      for (int64_t start = 0; start < row_cnt; start += UNPACK_BATCH_SIZE) {
+        const int64_t cnt = MIN(UNPACK_BATCH_SIZE, row_cnt - start);
+        int_diff_bp_unpack(col_data, data_offset, bs_len, cell_len, start, cnt, deltas);
+        filter_func(cnt, reinterpret_cast<const unsigned char *>(deltas), param_delta,
+            *sql::to_bit_vector(buf + start / CHAR_BIT));
+      }
+    } else {
+      data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
+      fix_filter_func filter_func = int_diff_fix_filter_funcs
+          [get_value_len_tag_map()[cell_len]]
+          [op_type];
+      filter_func(row_cnt, col_data + data_offset, param_delta, *bit_vec);
+    }
+
+    if (null_value_contained) {
+      // Deltas of null rows are meaningless, clear them with the null bitmap
+      uint64_t *words = reinterpret_cast<uint64_t *>(buf);
+      const int64_t word_cnt = sql::ObBitVector::word_count(row_cnt);
+      for (int64_t i = 0; i < word_cnt; ++i) {
+        words[i] &= ~result_bitmap.get_block(i * sql::ObBitVector::WORD_BITS);
+      }
+    }
+    if (OB_FAIL(result_bitmap.load_blocks_from_array(reinterpret_cast<uint64_t *>(buf), row_cnt))) {
+      LOG_WARN("Failed to load bitmap from array on stack", K(ret), KP(buf), K(row_cnt));
+    }
+  }
+  return ret;
+}
+
 int ObIntegerBaseDiffDecoder::bt_operator(
     const sql::ObPushdownFilterExecutor *parent,
     const ObColumnDecoderCtx &col_ctx,
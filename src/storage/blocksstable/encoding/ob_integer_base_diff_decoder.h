@@ -18,6 +18,7 @@
 #include "ob_encoding_util.h"
 #include "ob_integer_base_diff_encoder.h"
 #include "ob_bit_stream.h"
+#include "ob_raw_decoder.h"
 
 namespace oceanbase
 {
@@ -27,10 +28,32 @@ namespace blocksstable
 struct ObColumnHeader;
 struct ObIntegerBaseDiffHeader;
 
+// Unpack bit packed deltas of rows [start, start + cnt), @packed_len should not be larger than
+// MAX_FAST_UNPACK_LEN. @data_offset and @bs_len are bit offsets of the first delta and the end of
+// the bit stream.
+typedef void (*int_diff_bp_unpack_func)(
+    const unsigned char *col_data,
+    const int64_t data_offset,
+    const int64_t bs_len,
+    const int64_t packed_len,
+    const int64_t start,
+    const int64_t cnt,
+    uint32_t *deltas);
+
+typedef void (*int_diff_fix_batch_decode_func)(
+    const uint64_t base,
+    const unsigned char *col_data,
+    const int64_t *row_ids,
+    const int64_t row_cap,
+    common::ObDatum *datums);
+
 class ObIntegerBaseDiffDecoder : public ObIColumnDecoder
 {
 public:
   static const ObColumnHeader::Type type_ = ObColumnHeader::INTEGER_BASE_DIFF;
+  // bit packed deltas no longer than this are unpacked into uint32 in batch
+  static const int64_t MAX_FAST_UNPACK_LEN = 25;
+  static const int64_t UNPACK_BATCH_SIZE = 256;
   ObIntegerBaseDiffDecoder() : header_(NULL), base_(0)
   {}
   virtual ~ObIntegerBaseDiffDecoder() {}
@@ -81,6 +104,16 @@ private:
       const int64_t data_offset,
       common::ObDatum *datums) const;
 
+  int batch_unpack_continuous_values(
+      const ObColumnDecoderCtx &ctx,
+      const int64_t *row_ids,
+      const int64_t row_cap,
+      const int64_t datum_len,
+      const int64_t data_offset,
+      common::ObDatum *datums) const;
+
+  bool fast_decode_valid(const ObColumnDecoderCtx &ctx) const;
+
   template <typename T>
   inline int get_delta(const common::ObObj &cell, uint64_t &delta) const
   {
@@ -97,6 +130,16 @@ private:
       const sql::ObWhiteFilterExecutor &filter,
       ObBitmap &result_bitmap) const;
 
+  bool fast_filter_valid(const ObColumnDecoderCtx &ctx) const;
+
+  // Compare deltas with @param_delta without adding base back
+  int fast_comparison_operator(
+      const ObColumnDecoderCtx &col_ctx,
+      const unsigned char* col_data,
+      const uint64_t param_delta,
+      const sql::ObWhiteFilterOperatorType op_type,
+      ObBitmap &result_bitmap) const;
+
   int bt_operator(
       const sql::ObPushdownFilterExecutor *parent,
       const ObColumnDecoderCtx &col_ctx,
@@ -168,6 +211,12 @@ OB_INLINE void ObIntegerBaseDiffDecoder::reuse()
   base_ = 0;
   */
 }
+
+// Filter functions on fixed length unsigned deltas, indexed by [len_tag][op_type]
+extern ObMultiDimArray_T<fix_filter_func, 4, 6> int_diff_fix_filter_funcs;
+extern int_diff_bp_unpack_func int_diff_bp_unpack;
+extern bool int_diff_fast_funcs_inited;
+
 } // end namespace blocksstable
 } // end namespace oceanbase
 
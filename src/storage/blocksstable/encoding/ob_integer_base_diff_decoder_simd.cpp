@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_encoding_query_util.h"
+#include "ob_integer_base_diff_decoder.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+#if defined ( __AVX2__ )
+// AVX2 has no unsigned integer comparison, compare with sign bit flipped instead.
+template <int32_t LEN_TAG>
+struct IntDiffAVX2Ops {};
+
+template <>
+struct IntDiffAVX2Ops<0>
+{
+  typedef uint32_t MaskType;
+  static const int64_t VEC_PER_BATCH = 1;
+  OB_INLINE static __m256i set1(const uint64_t v) { return _mm256_set1_epi8(static_cast<int8_t>(v)); }
+  OB_INLINE static __m256i sign() { return _mm256_set1_epi8(INT8_MIN); }
+  OB_INLINE static __m256i eq(const __m256i l, const __m256i r) { return _mm256_cmpeq_epi8(l, r); }
+  OB_INLINE static __m256i gt(const __m256i l, const __m256i r) { return _mm256_cmpgt_epi8(l, r); }
+  OB_INLINE static MaskType movemask(const __m256i *cmp_res)
+  {
+    return static_cast<MaskType>(_mm256_movemask_epi8(cmp_res[0]));
+  }
+};
+
+template <>
+struct IntDiffAVX2Ops<1>
+{
+  typedef uint16_t MaskType;
+  static const int64_t VEC_PER_BATCH = 1;
+  OB_INLINE static __m256i set1(const uint64_t v) { return _mm256_set1_epi16(static_cast<int16_t>(v)); }
+  OB_INLINE static __m256i sign() { return _mm256_set1_epi16(INT16_MIN); }
+  OB_INLINE static __m256i eq(const __m256i l, const __m256i r) { return _mm256_cmpeq_epi16(l, r); }
+  OB_INLINE static __m256i gt(const __m256i l, const __m256i r) { return _mm256_cmpgt_epi16(l, r); }
+  OB_INLINE static MaskType movemask(const __m256i *cmp_res)
+  {
+    // narrow 16 lanes of 2 bytes to 16 bytes in the low 128 bits
+    const __m256i packed = _mm256_permute4x64_epi64(
+        _mm256_packs_epi16(cmp_res[0], _mm256_setzero_si256()), 0xD8);
+    return static_cast<MaskType>(_mm256_movemask_epi8(packed));
+  }
+};
+
+template <>
+struct IntDiffAVX2Ops<2>
+{
+  typedef uint8_t MaskType;
+  static const int64_t VEC_PER_BATCH = 1;
+  OB_INLINE static __m256i set1(const uint64_t v) { return _mm256_set1_epi32(static_cast<int32_t>(v)); }
+  OB_INLINE static __m256i sign() { return _mm256_set1_epi32(INT32_MIN); }
+  OB_INLINE static __m256i eq(const __m256i l, const __m256i r) { return _mm256_cmpeq_epi32(l, r); }
+  OB_INLINE static __m256i gt(const __m256i l, const __m256i r) { return _mm256_cmpgt_epi32(l, r); }
+  OB_INLINE static MaskType movemask(const __m256i *cmp_res)
+  {
+    return static_cast<MaskType>(_mm256_movemask_ps(_mm256_castsi256_ps(cmp_res[0])));
+  }
+};
+
+template <>
+struct IntDiffAVX2Ops<3>
+{
+  typedef uint8_t MaskType;
+  static const int64_t VEC_PER_BATCH = 2;
+  OB_INLINE static __m256i set1(const uint64_t v) { return _mm256_set1_epi64x(static_cast<int64_t>(v)); }
+  OB_INLINE static __m256i sign() { return _mm256_set1_epi64x(INT64_MIN); }
+  OB_INLINE static __m256i eq(const __m256i l, const __m256i r) { return _mm256_cmpeq_epi64(l, r); }
+  OB_INLINE static __m256i gt(const __m256i l, const __m256i r) { return _mm256_cmpgt_epi64(l, r); }
+  OB_INLINE static MaskType movemask(const __m256i *cmp_res)
+  {
+    return static_cast<MaskType>(_mm256_movemask_pd(_mm256_castsi256_pd(cmp_res[0]))
+        | (_mm256_movemask_pd(_mm256_castsi256_pd(cmp_res[1])) << 4));
+  }
+};
+
+// NE / LE / GE are evaluated as the negation of EQ / GT / LT
+template <int32_t CMP_TYPE>
+struct IntDiffAVX2NegateCmp
+{
+  constexpr static bool value_ = sql::WHITE_OP_NE == CMP_TYPE
+      || sql::WHITE_OP_LE == CMP_TYPE
+      || sql::WHITE_OP_GE == CMP_TYPE;
+};
+
+template <typename Ops, int32_t CMP_TYPE>
+OB_INLINE static __m256i int_diff_avx2_cmp(
+    const __m256i data,
+    const __m256i node,
+    const __m256i sign)
+{
+  __m256i res;
+  switch (CMP_TYPE) {
+    case sql::WHITE_OP_EQ:
+    case sql::WHITE_OP_NE:
+      res = Ops::eq(data, node);
+      break;
+    case sql::WHITE_OP_GT:
+    case sql::WHITE_OP_LE:
+      res = Ops::gt(_mm256_xor_si256(data, sign), _mm256_xor_si256(node, sign));
+      break;
+    default: // WHITE_OP_LT, WHITE_OP_GE
+      res = Ops::gt(_mm256_xor_si256(node, sign), _mm256_xor_si256(data, sign));
+      break;
+  }
+  return res;
+}
+
+template <int32_t LEN_TAG, int32_t CMP_TYPE>
+struct IntDiffFixFilterAVX2Func_T
+{
+  // Fast filter with AVX2 for unsigned deltas
+  static void fix_filter_func(
+      const int64_t row_cnt,
+      const unsigned char *col_data,
+      const uint64_t node_value,
+      sql::ObBitVector &res)
+  {
+    typedef IntDiffAVX2Ops<LEN_TAG> Ops;
+    typedef typename Ops::MaskType MaskType;
+    typedef typename ObEncodingTypeInference<0, LEN_TAG>::Type DataType;
+    constexpr static int64_t BATCH_BYTES = sizeof(__m256i) * Ops::VEC_PER_BATCH;
+    constexpr static int64_t BATCH_ROWS = BATCH_BYTES / sizeof(DataType);
+    const DataType *stored_values = reinterpret_cast<const DataType *>(col_data);
+    const DataType casted_node_value = static_cast<DataType>(node_value);
+    const __m256i node_value_vec = Ops::set1(casted_node_value);
+    const __m256i sign_vec = Ops::sign();
+    __m256i cmp_res[Ops::VEC_PER_BATCH];
+    for (int64_t i = 0; i < row_cnt / BATCH_ROWS; ++i) {
+      const __m256i *data = reinterpret_cast<const __m256i *>(col_data + i * BATCH_BYTES);
+      for (int64_t j = 0; j < Ops::VEC_PER_BATCH; ++j) {
+        cmp_res[j] = int_diff_avx2_cmp<Ops, CMP_TYPE>(
+            _mm256_loadu_si256(data + j), node_value_vec, sign_vec);
+      }
+      const MaskType mask = Ops::movemask(cmp_res);
+      res.reinterpret_data<MaskType>()[i]
+          = IntDiffAVX2NegateCmp<CMP_TYPE>::value_ ? static_cast<MaskType>(~mask) : mask;
+    }
+
+    for (int64_t row_id = row_cnt / BATCH_ROWS * BATCH_ROWS; row_id < row_cnt; ++row_id) {
+      if (value_cmp_t<DataType, CMP_TYPE>(stored_values[row_id], casted_node_value)) {
+        res.set(row_id);
+      }
+    }
+  }
+};
+
+// Unpack 8 deltas at a time: gather 4 bytes covering each delta, then shift and mask
+static void int_diff_bp_unpack_avx2(
+    const unsigned char *col_data,
+    const int64_t data_offset,
+    const int64_t bs_len,
+    const int64_t packed_len,
+    const int64_t start,
+    const int64_t cnt,
+    uint32_t *deltas)
+{
+  const __m256i mask_vec = _mm256_set1_epi32(static_cast<int32_t>((1U << packed_len) - 1));
+  const __m256i bit_mod_vec = _mm256_set1_epi32(CHAR_BIT - 1);
+  const __m256i lane_off_vec = _mm256_mullo_epi32(
+      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+      _mm256_set1_epi32(static_cast<int32_t>(packed_len)));
+  int64_t i = 0;
+  // 4 bytes read by the last lane should not exceed the bit stream
+  for (; i + 8 <= cnt && data_offset + (start + i + 7) * packed_len + 32 <= bs_len; i += 8) {
+    const int64_t offset = data_offset + (start + i) * packed_len;
+    const int *base_ptr = reinterpret_cast<const int *>(col_data + (offset >> 3));
+    const __m256i bit_off_vec = _mm256_add_epi32(
+        lane_off_vec, _mm256_set1_epi32(static_cast<int32_t>(offset & 7)));
+    __m256i v = _mm256_i32gather_epi32(base_ptr, _mm256_srli_epi32(bit_off_vec, 3), 1);
+    v = _mm256_srlv_epi32(v, _mm256_and_si256(bit_off_vec, bit_mod_vec));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(deltas + i), _mm256_and_si256(v, mask_vec));
+  }
+  int64_t value = 0;
+  for (; i < cnt; ++i) {
+    ObBitStream::get<ObBitStream::PACKED_LEN_LESS_THAN_26>(
+        col_data, data_offset + (start + i) * packed_len, packed_len, bs_len, value);
+    deltas[i] = static_cast<uint32_t>(value);
+  }
+}
+#else
+template <int32_t LEN_TAG, int32_t CMP_TYPE>
+struct IntDiffFixFilterAVX2Func_T : public RawFixFilterFunc_T<false, LEN_TAG, CMP_TYPE>
+{};
+#endif
+
+template <int32_t LEN_TAG, int32_t CMP_TYPE>
+struct IntDiffFixFilterAVX2ArrayInit
+{
+  bool operator()()
+  {
+    int_diff_fix_filter_funcs[LEN_TAG][CMP_TYPE]
+        = &(IntDiffFixFilterAVX2Func_T<LEN_TAG, CMP_TYPE>::fix_filter_func);
+    return true;
+  }
+};
+
+bool init_int_diff_avx2_simd_funcs()
+{
+#if defined ( __AVX2__ )
+  int_diff_bp_unpack = &int_diff_bp_unpack_avx2;
+#endif
+  return ObNDArrayIniter<IntDiffFixFilterAVX2ArrayInit, 4, 6>::apply();
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -271,7 +271,8 @@ ObIEncodeBlockReader::decode_acquire_func ObIEncodeBlockReader::acquire_funcs_[O
     acquire_decoder<ObHexStringDecoder>,
     acquire_decoder<ObStringPrefixDecoder>,
     acquire_decoder<ObColumnEqualDecoder>,
-    acquire_decoder<ObInterColSubStrDecoder>
+    acquire_decoder<ObInterColSubStrDecoder>,
+    acquire_decoder<ObFsstStringDecoder>
 };
 
 ObIEncodeBlockReader::ObIEncodeBlockReader()
@@ -1015,6 +1016,17 @@ int ObMicroBlockDecoder::acquire(
         }
         break;
       }
+      case ObColumnHeader::STRING_FSST: {
+        ObFsstStringDecoder *d = NULL;
+        if (OB_FAIL(allocator.alloc(d))) {
+          LOG_WARN("alloc failed", K(ret));
+        } else if (OB_FAIL(d->init(header, col_header, meta_data))) {
+          LOG_WARN("init fsst string decoder failed", K(ret));
+        } else {
+          decoder = d;
+        }
+        break;
+      }
       default:
         ret = OB_INNER_STAT_ERROR;
         LOG_WARN("unsupported encoding type", K(ret), "type", col_header.type_);
@@ -2036,43 +2048,10 @@ int ObMicroBlockDecoder::get_rows(
     LOG_WARN("invalid argument", K(ret), KP(row_ids), KP(cell_datas),
              K(cols.count()), K(datums.count()));
   } else {
-    common::ObObj cell;
     for (int64_t i = 0; OB_SUCC(ret) && i < cols.count(); i++) {
-      int32_t col_id = cols.at(i);
-      if (OB_UNLIKELY(col_id >= header_->column_count_)) {
-        ret = OB_INDEX_OUT_OF_RANGE;
-        LOG_WARN("Vector store col id greate than store cnt", K(ret), K(header_->column_count_), K(col_id));
-      } else if (!decoders_[col_id].decoder_->can_vectorized()) {
-        // normal path
-        int64_t row_len = 0;
-        const char *row_data = NULL;
-        const int row_header_size = ObRowHeader::get_serialized_size();
-        int64_t row_id = common::OB_INVALID_INDEX;
-        common::ObDatum *col_datums = datums.at(i);
-        for (int64_t idx = 0; OB_SUCC(ret) && idx < row_cap; idx++) {
-          row_id = row_ids[idx];
-          if (OB_FAIL(row_index_->get(row_id, row_data, row_len))) {
-            LOG_WARN("get row data failed", K(ret), K(row_id));
-          } else {
-            ObBitStream bs(reinterpret_cast<unsigned char *>(const_cast<char *>(row_data)), row_len);
-            if (OB_FAIL(decoders_[col_id].decode(cell, row_id, bs, row_data, row_len))) {
-              LOG_WARN("Decode cell failed", K(ret));
-            } else if (OB_FAIL(col_datums[idx].from_obj(cell))) {
-              LOG_WARN("Failed to convert object from datum", K(ret), K(cell));
-            }
-          }
-        }
-      } else if (OB_FAIL(decoders_[col_id].batch_decode(
-                  row_index_,
-                  row_ids,
-                  cell_datas,
-                  row_cap,
-                  datums.at(i)))) {
-        LOG_WARN("fail to get datums from decoder", K(ret), K(col_id), K(row_cap),
-                 "row_ids", common::ObArrayWrap<const int64_t>(row_ids, row_cap));
-      }
-
-      if (OB_SUCC(ret) && nullptr != col_params.at(i)) {
+      if (OB_FAIL(decode_column_datums(cols.at(i), row_ids, cell_datas, row_cap, datums.at(i)))) {
+        LOG_WARN("Fail to decode column datums", K(ret), K(i), K(cols.at(i)), K(row_cap));
+      } else if (nullptr != col_params.at(i)) {
         // need padding
         if (OB_FAIL(storage::pad_on_datums(
                     col_params.at(i)->get_accuracy(),
@@ -2088,6 +2067,69 @@ int ObMicroBlockDecoder::get_rows(
   return ret;
 }
 
+int ObMicroBlockDecoder::get_column_datum(
+    const int32_t col_id,
+    const int64_t *row_ids,
+    const char **cell_datas,
+    const int64_t row_cap,
+    common::ObDatum *datums)
+{
+  int ret = OB_SUCCESS;
+  decoder_allocator_.reuse();
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(nullptr == row_ids || nullptr == cell_datas || nullptr == datums)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(row_ids), KP(cell_datas), KP(datums));
+  } else if (OB_FAIL(decode_column_datums(col_id, row_ids, cell_datas, row_cap, datums))) {
+    LOG_WARN("Fail to decode column datums", K(ret), K(col_id), K(row_cap));
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::decode_column_datums(
+    const int32_t col_id,
+    const int64_t *row_ids,
+    const char **cell_datas,
+    const int64_t row_cap,
+    common::ObDatum *col_datums)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(col_id >= header_->column_count_)) {
+    ret = OB_INDEX_OUT_OF_RANGE;
+    LOG_WARN("Vector store col id greate than store cnt", K(ret), K(header_->column_count_), K(col_id));
+  } else if (!decoders_[col_id].decoder_->can_vectorized()) {
+    // normal path
+    common::ObObj cell;
+    int64_t row_len = 0;
+    const char *row_data = NULL;
+    int64_t row_id = common::OB_INVALID_INDEX;
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < row_cap; idx++) {
+      row_id = row_ids[idx];
+      if (OB_FAIL(row_index_->get(row_id, row_data, row_len))) {
+        LOG_WARN("get row data failed", K(ret), K(row_id));
+      } else {
+        ObBitStream bs(reinterpret_cast<unsigned char *>(const_cast<char *>(row_data)), row_len);
+        if (OB_FAIL(decoders_[col_id].decode(cell, row_id, bs, row_data, row_len))) {
+          LOG_WARN("Decode cell failed", K(ret));
+        } else if (OB_FAIL(col_datums[idx].from_obj(cell))) {
+          LOG_WARN("Failed to convert object from datum", K(ret), K(cell));
+        }
+      }
+    }
+  } else if (OB_FAIL(decoders_[col_id].batch_decode(
+              row_index_,
+              row_ids,
+              cell_datas,
+              row_cap,
+              col_datums))) {
+    LOG_WARN("fail to get datums from decoder", K(ret), K(col_id), K(row_cap),
+             "row_ids", common::ObArrayWrap<const int64_t>(row_ids, row_cap));
+  }
+  return ret;
+}
+
 int ObMicroBlockDecoder::get_row_count(
     int32_t col_id,
     const int64_t *row_ids,
@@ -260,6 +260,12 @@ public:
       const int64_t row_cap,
       const bool contains_null,
       int64_t &count) override final;
+  virtual int get_column_datum(
+      const int32_t col_id,
+      const int64_t *row_ids,
+      const char **cell_datas,
+      const int64_t row_cap,
+      common::ObDatum *datums) override final;
   virtual int64_t get_column_count() const override
   {
     OB_ASSERT(nullptr != header_);
@@ -288,6 +294,12 @@ private:
                   const common::ObObjMeta &obj_meta,
                   ObColumnDecoder &dest);
   void free_decoders();
+  int decode_column_datums(
+      const int32_t col_id,
+      const int64_t *row_ids,
+      const char **cell_datas,
+      const int64_t row_cap,
+      common::ObDatum *col_datums);
   int decode_cells(const uint64_t row_id,
                    const int64_t row_len,
                    const char *row_data,
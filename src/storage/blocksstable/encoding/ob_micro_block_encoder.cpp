@@ -31,6 +31,7 @@
 #include "ob_encoding_hash_util.h"
 #include "ob_string_prefix_encoder.h"
 #include "ob_inter_column_substring_encoder.h"
+#include "ob_fsst_string_encoder.h"
 
 namespace oceanbase
 {
@@ -1297,6 +1298,10 @@ int ObMicroBlockEncoder::try_encoder(ObIColumnEncoder *&e, const int64_t column_
               : try_span_column_encoder<ObInterColSubStrEncoder>(e, column_index);
         break;
       }
+      case ObColumnHeader::STRING_FSST: {
+        ret = try_encoder<ObFsstStringEncoder>(e, column_index);
+        break;
+      }
       default:
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("unknown encoding type", K(ret), K(type));
@@ -1665,6 +1670,26 @@ int ObMicroBlockEncoder::choose_encoder(const int64_t column_idx,
       }
     }
 
+    // STRING_FSST can not be decoded by servers before 4.2
+    if (OB_SUCC(ret) && try_more && ctx_.major_working_cluster_version_ >= CLUSTER_VERSION_4_2_0_0) {
+      if (is_string_encoding_valid(sc)) {
+        if (cc.detected_encoders_[ObFsstStringEncoder::type_]) {
+        } else if (OB_FAIL(try_encoder<ObFsstStringEncoder>(e, column_idx))) {
+          LOG_WARN("try fsst string encoder failed", K(ret), K(column_idx));
+        } else if (NULL != e) {
+          int64_t size = e->calc_size();
+          if (size < choose->calc_size()) {
+            free_encoder(choose);
+            choose = e;
+            try_more = size <= acceptable_size;
+          } else {
+            free_encoder(e);
+            e = NULL;
+          }
+        }
+      }
+    }
+
     if (OB_SUCC(ret)) {
       LOG_DEBUG("used encoder", K(column_idx),
           "column_header", choose->get_column_header(),
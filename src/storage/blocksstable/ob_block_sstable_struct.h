@@ -290,6 +290,7 @@ struct ObColumnHeader
     STRING_PREFIX,
     COLUMN_EQUAL,
     COLUMN_SUBSTR,
+    STRING_FSST,
     MAX_TYPE
   };
 
@@ -388,6 +389,7 @@ struct ObMicroBlockEncoderOpt
   bool &enable_rle() { return enable(ObColumnHeader::RLE); }
   bool &enable_const() { return enable(ObColumnHeader::CONST); }
   bool &enable_str_prefix() { return enable(ObColumnHeader::STRING_PREFIX); }
+  bool &enable_str_fsst() { return enable(ObColumnHeader::STRING_FSST); }
 
   const bool &enable_raw() const { return enable(ObColumnHeader::RAW); }
   const bool &enable_dict() const { return enable(ObColumnHeader::DICT); }
@@ -397,6 +399,7 @@ struct ObMicroBlockEncoderOpt
   const bool &enable_rle() const { return enable(ObColumnHeader::RLE); }
   const bool &enable_const() const { return enable(ObColumnHeader::CONST); }
   const bool &enable_str_prefix() const { return enable(ObColumnHeader::STRING_PREFIX); }
+  const bool &enable_str_fsst() const { return enable(ObColumnHeader::STRING_FSST); }
 
   ObMicroBlockEncoderOpt() { set_store_type(ENCODING_ROW_STORE); }
 
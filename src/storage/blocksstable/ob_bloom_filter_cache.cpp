@@ -10,6 +10,9 @@
  * See the Mulan PubL v2 for more details.
  */
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 #include "ob_bloom_filter_cache.h"
 #include "lib/stat/ob_diagnose_info.h"
 #include "share/rc/ob_tenant_base.h"
@@ -17,6 +20,7 @@
 #include "lib/atomic/ob_atomic.h"
 #include "storage/blocksstable/ob_storage_cache_suite.h"
 #include "ob_datum_rowkey.h"
+#include "share/ob_cluster_version.h"
 
 namespace oceanbase
 {
@@ -24,7 +28,13 @@ using namespace common;
 namespace blocksstable
 {
 
-ObBloomFilter::ObBloomFilter() : allocator_(ObModIds::OB_BLOOM_FILTER), nhash_(0), nbit_(0), bits_(NULL)
+const uint32_t ObBloomFilter::SPLIT_BLOCK_SALT[ObBloomFilter::SPLIT_BLOCK_WORDS] = {
+  0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+  0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+ObBloomFilter::ObBloomFilter()
+  : allocator_(ObModIds::OB_BLOOM_FILTER), nhash_(0), nbit_(0), bits_(NULL), is_split_block_(false)
 {
 }
 
@@ -46,6 +56,7 @@ int ObBloomFilter::deep_copy(const ObBloomFilter &other)
   } else {
     nbit_ = other.nbit_;
     nhash_ = other.nhash_;
+    is_split_block_ = other.is_split_block_;
     MEMCPY(bits_, other.bits_, calc_nbyte(nbit_));
   }
 
@@ -62,6 +73,7 @@ int ObBloomFilter::deep_copy(const ObBloomFilter &other, char *buffer)
   } else {
     nbit_ = other.nbit_;
     nhash_ = other.nhash_;
+    is_split_block_ = other.is_split_block_;
     bits_ = reinterpret_cast<uint8_t*>(buffer);
     MEMCPY(bits_, other.bits_, calc_nbyte(nbit_));
   }
@@ -80,7 +92,10 @@ int64_t ObBloomFilter::calc_nbyte(const int64_t nbit) const
   return (nbit / CHAR_BIT + (nbit % CHAR_BIT ? 1 : 0));
 }
 
-int ObBloomFilter::init(const int64_t element_count, const double false_positive_prob)
+int ObBloomFilter::init(
+    const int64_t element_count,
+    const double false_positive_prob,
+    const bool is_split_block)
 {
   int ret = OB_SUCCESS;
   if (element_count <= 0) {
@@ -93,6 +108,11 @@ int ObBloomFilter::init(const int64_t element_count, const double false_positive
     double num_hashes = -std::log(false_positive_prob) / std::log(2);
     int64_t num_bits = static_cast<int64_t>((static_cast<double>(element_count)
                                              * num_hashes / static_cast<double>(std::log(2))));
+    if (is_split_block) {
+      num_bits = static_cast<int64_t>(static_cast<double>(num_bits) * SPLIT_BLOCK_SIZE_FACTOR);
+      num_bits = (num_bits + SPLIT_BLOCK_BITS - 1) / SPLIT_BLOCK_BITS * SPLIT_BLOCK_BITS;
+      num_hashes = static_cast<double>(SPLIT_BLOCK_WORDS);
+    }
     int64_t num_bytes = calc_nbyte(num_bits);
     bits_ = (uint8_t *)allocator_.alloc(static_cast<int32_t>(num_bytes));
     if (NULL == bits_) {
@@ -102,6 +122,7 @@ int ObBloomFilter::init(const int64_t element_count, const double false_positive
       memset(bits_, 0, num_bytes);
       nhash_ = static_cast<int64_t>(num_hashes);
       nbit_ = num_bits;
+      is_split_block_ = is_split_block;
     }
   }
   return ret;
@@ -115,6 +136,7 @@ void ObBloomFilter::destroy()
     nhash_ = 0;
     nbit_ = 0;
   }
+  is_split_block_ = false;
 }
 
 void ObBloomFilter::clear()
@@ -130,6 +152,8 @@ int ObBloomFilter::insert(const uint32_t key_hash)
   if (!is_valid()) {
     ret = OB_NOT_INIT;
     LIB_LOG(WARN, "bloom filter has not inited", K_(bits), K_(nbit), K_(nhash), K(ret));
+  } else if (is_split_block_) {
+    split_block_insert(key_hash);
   } else {
     const uint64_t hash = key_hash;
     const uint64_t delta = ((hash >> 17) | (hash << 15)) % nbit_;
@@ -149,6 +173,8 @@ int ObBloomFilter::may_contain(const uint32_t key_hash, bool &is_contain) const
   if (!is_valid()) {
     ret = OB_NOT_INIT;
     LIB_LOG(WARN, "bloom filter has not inited, ", K_(bits), K_(nbit), K_(nhash), K(ret));
+  } else if (is_split_block_) {
+    is_contain = split_block_may_contain(key_hash);
   } else {
     const uint64_t hash = key_hash;
     const uint64_t delta = ((hash >> 17) | (hash << 15)) % nbit_;
@@ -164,6 +190,36 @@ int ObBloomFilter::may_contain(const uint32_t key_hash, bool &is_contain) const
   return ret;
 }
 
+void ObBloomFilter::split_block_insert(const uint32_t key_hash)
+{
+  const uint64_t hash = split_block_hash(key_hash);
+  uint32_t *block = get_split_block(hash);
+  const uint32_t bit_hash = static_cast<uint32_t>(hash);
+  for (int64_t i = 0; i < SPLIT_BLOCK_WORDS; ++i) {
+    block[i] |= 1U << ((bit_hash * SPLIT_BLOCK_SALT[i]) >> 27);
+  }
+}
+
+bool ObBloomFilter::split_block_may_contain(const uint32_t key_hash) const
+{
+  const uint64_t hash = split_block_hash(key_hash);
+  const uint32_t *block = get_split_block(hash);
+  const uint32_t bit_hash = static_cast<uint32_t>(hash);
+#if defined(__AVX2__)
+  const __m256i salt = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(SPLIT_BLOCK_SALT));
+  const __m256i shift = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(bit_hash), salt), 27);
+  const __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shift);
+  const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+  return 0 != _mm256_testc_si256(bits, mask);
+#else
+  bool is_contain = true;
+  for (int64_t i = 0; is_contain && i < SPLIT_BLOCK_WORDS; ++i) {
+    is_contain = 0 != (block[i] & (1U << ((bit_hash * SPLIT_BLOCK_SALT[i]) >> 27)));
+  }
+  return is_contain;
+#endif
+}
+
 int ObBloomFilter::serialize(char *buf, const int64_t buf_len, int64_t &pos) const
 {
   int ret = OB_SUCCESS;
@@ -385,15 +441,19 @@ int ObBloomFilterCacheValue::deep_copy(char *buf, const int64_t buf_len, common:
 int ObBloomFilterCacheValue::init(const int64_t rowkey_column_cnt, const int64_t row_cnt)
 {
   int ret = OB_SUCCESS;
+  // bloom filters are persisted in bloom filter macro blocks, servers before 4.2 can only
+  // read the classic layout
+  const bool is_split_block = GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_2_0_0;
   if (OB_UNLIKELY(rowkey_column_cnt <= 0 || row_cnt <= 0)) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "Invalid argument, ", K(rowkey_column_cnt), K(row_cnt), K(ret));
   } else if (OB_UNLIKELY(is_inited_)) {
     ret = OB_INIT_TWICE;
     STORAGE_LOG(WARN, "The bloom filter cache value has been inited, ", K(ret));
-  } else if (OB_FAIL(bloom_filter_.init(row_cnt))) {
+  } else if (OB_FAIL(bloom_filter_.init(row_cnt, ObBloomFilter::BLOOM_FILTER_FALSE_POSITIVE_PROB, is_split_block))) {
     STORAGE_LOG(WARN, "Fail to init bloom filter, ", K(ret));
   } else {
+    version_ = is_split_block ? SPLIT_BLOCK_BLOOM_FILTER_VERSION : BLOOM_FILTER_CACHE_VALUE_VERSION;
     rowkey_column_cnt_ = static_cast<int16_t>(rowkey_column_cnt);
     row_count_ = 0;
     is_inited_ = true;
@@ -519,7 +579,12 @@ DEFINE_DESERIALIZE(ObBloomFilterCacheValue)
       STORAGE_LOG(WARN, "Failed to decode row cnt", K(data_len), K(pos), K(ret));
     } else if (OB_FAIL(bloom_filter_.deserialize(buf, data_len, pos))) {
       STORAGE_LOG(WARN, "Failed to deserialize bloom_filter", K(data_len), K(pos), K(ret));
+    } else if (SPLIT_BLOCK_BLOOM_FILTER_VERSION == version_
+        && OB_UNLIKELY(0 != bloom_filter_.get_nbit() % ObBloomFilter::SPLIT_BLOCK_BITS)) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "Unexpected split block bloom filter size", K_(version), K_(bloom_filter), K(ret));
     } else {
+      bloom_filter_.set_split_block(SPLIT_BLOCK_BLOOM_FILTER_VERSION == version_);
       is_inited_ = true;
     }
   }
@@ -545,6 +610,7 @@ ObBloomFilterCache::ObBloomFilterCache()
     bucket_size_(DEFAULT_BUCKET_SIZE),
     bucket_magic_(DEFAULT_BUCKET_SIZE - 1)
 {
+  MEMSET(prefix_len_bitmaps_, 0, sizeof(prefix_len_bitmaps_));
 }
 
 ObBloomFilterCache::~ObBloomFilterCache()
@@ -553,6 +619,7 @@ ObBloomFilterCache::~ObBloomFilterCache()
 
 int ObBloomFilterCache::put_bloom_filter(
     const uint64_t tenant_id,
+    const ObTabletID &tablet_id,
     const MacroBlockId& macro_block_id,
     const ObBloomFilterCacheValue &bf_value,
     const bool adaptive)
@@ -565,6 +632,8 @@ int ObBloomFilterCache::put_bloom_filter(
     STORAGE_LOG(WARN, "Invalid argument, ", K(bf_key), K(bf_value), K(ret));
   } else if (OB_FAIL(put(bf_key, bf_value, overwrite))) {
     STORAGE_LOG(WARN, "Fail to put bloomfilter to cache, ", K(ret));
+  } else {
+    mark_prefix_len(tablet_id, bf_value.get_prefix_len());
   }
 
   if (OB_SUCC(ret) && adaptive) {
@@ -588,39 +657,74 @@ int ObBloomFilterCache::may_contain(
     const ObDatumRowkey &rowkey,
     const ObStorageDatumUtils &datum_utils,
     bool &is_contain)
+{
+  // only the bloom filter on the whole key
+  return may_contain(tenant_id, ObTabletID(), macro_block_id, rowkey, rowkey.get_datum_cnt(), datum_utils,
+      is_contain);
+}
+
+int ObBloomFilterCache::may_contain(
+    const uint64_t tenant_id,
+    const ObTabletID &tablet_id,
+    const MacroBlockId &macro_block_id,
+    const ObDatumRowkey &rowkey,
+    const int64_t max_prefix_len,
+    const ObStorageDatumUtils &datum_utils,
+    bool &is_contain)
 {
   int ret = OB_SUCCESS;
   is_contain = true;
-  ObBloomFilterCacheKey bf_key(tenant_id, macro_block_id, static_cast<int8_t>(rowkey.get_datum_cnt()) );
   const ObBloomFilterCacheValue *bf_value = NULL;
   ObKVCacheHandle handle;
   uint64_t key_hash = 0;
 
-  if (OB_UNLIKELY(!bf_key.is_valid() || !rowkey.is_valid())) {
+  if (OB_UNLIKELY(OB_INVALID_TENANT_ID == tenant_id || !macro_block_id.is_valid() || !rowkey.is_valid()
+      || max_prefix_len <= 0 || max_prefix_len > rowkey.get_datum_cnt())) {
     ret = OB_INVALID_ARGUMENT;
-    STORAGE_LOG(WARN, "Invalid argument, ", K(bf_key), K(rowkey), K(ret));
+    STORAGE_LOG(WARN, "Invalid argument, ", K(tenant_id), K(macro_block_id), K(rowkey), K(max_prefix_len), K(ret));
   } else if (0 == bf_cache_miss_count_threshold_) {
     //disable bf cache
-  } else if (OB_FAIL(get(bf_key, bf_value, handle))) {
-    if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
-      STORAGE_LOG(WARN, "Fail to get bloom filter cache, ", K(ret));
-    }
-    EVENT_INC(ObStatEventIds::BLOOM_FILTER_CACHE_MISS);
   } else {
-    EVENT_INC(ObStatEventIds::BLOOM_FILTER_CACHE_HIT);
-    if (OB_ISNULL(bf_value)) {
-      ret = OB_ERR_UNEXPECTED;
-      STORAGE_LOG(WARN, "Unexpected error, the bf_value is NULL, ", K(ret));
-    } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hash))) {
-      STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
-    } else if (OB_FAIL(bf_value->may_contain(static_cast<uint32_t>(key_hash), is_contain))) {
-      STORAGE_LOG(WARN, "Fail to check rowkey exist from bloom filter, ", K(ret));
+    // the longest prefix is always probed, shorter ones only if any bloom filter is built on them
+    const uint64_t prefix_len_bitmap = tablet_id.is_valid() ? ATOMIC_LOAD(get_prefix_len_bitmap(tablet_id)) : 0;
+    int64_t prefix_len = max_prefix_len;
+    ret = OB_ENTRY_NOT_EXIST;
+    while (OB_ENTRY_NOT_EXIST == ret && prefix_len > 0) {
+      ObBloomFilterCacheKey bf_key(tenant_id, macro_block_id, static_cast<int8_t>(prefix_len));
+      if (prefix_len < max_prefix_len
+          && (prefix_len >= MAX_MARKED_PREFIX_LEN || 0 == (prefix_len_bitmap & (1UL << prefix_len)))) {
+        // no bloom filter on this prefix
+      } else if (OB_FAIL(get(bf_key, bf_value, handle))) {
+        if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+          STORAGE_LOG(WARN, "Fail to get bloom filter cache, ", K(ret));
+        }
+      }
+      if (OB_ENTRY_NOT_EXIST == ret) {
+        --prefix_len;
+      }
+    }
+    if (OB_FAIL(ret)) {
+      EVENT_INC(ObStatEventIds::BLOOM_FILTER_CACHE_MISS);
     } else {
-      STORAGE_LOG(DEBUG, "debug bloom_filter may contain", K(ret), KP(bf_value), K(key_hash), K(is_contain), K(rowkey));
-      if (is_contain) {
-        EVENT_INC(ObStatEventIds::BLOOM_FILTER_PASSES);
+      EVENT_INC(ObStatEventIds::BLOOM_FILTER_CACHE_HIT);
+      ObDatumRowkey prefix_key;
+      if (OB_ISNULL(bf_value)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "Unexpected error, the bf_value is NULL, ", K(ret));
+      } else if (OB_FAIL(prefix_key.assign(rowkey.datums_, static_cast<int>(prefix_len)))) {
+        STORAGE_LOG(WARN, "Failed to assign prefix rowkey", K(ret), K(rowkey), K(prefix_len));
+      } else if (OB_FAIL(prefix_key.murmurhash(0, datum_utils, key_hash))) {
+        STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(prefix_key));
+      } else if (OB_FAIL(bf_value->may_contain(static_cast<uint32_t>(key_hash), is_contain))) {
+        STORAGE_LOG(WARN, "Fail to check rowkey exist from bloom filter, ", K(ret));
       } else {
-        EVENT_INC(ObStatEventIds::BLOOM_FILTER_FILTS);
+        STORAGE_LOG(DEBUG, "debug bloom_filter may contain", K(ret), KP(bf_value), K(key_hash), K(is_contain),
+            K(rowkey), K(prefix_len));
+        if (is_contain) {
+          EVENT_INC(ObStatEventIds::BLOOM_FILTER_PASSES);
+        } else {
+          EVENT_INC(ObStatEventIds::BLOOM_FILTER_FILTS);
+        }
       }
     }
   }
@@ -886,6 +990,7 @@ int ObMacroBloomFilterCacheWriter::merge(const ObMacroBloomFilterCacheWriter &ot
 
 int ObMacroBloomFilterCacheWriter::flush_to_cache(
     const uint64_t tenant_id,
+    const ObTabletID &tablet_id,
     const MacroBlockId& macro_id)
 {
   int ret = OB_SUCCESS;
@@ -894,7 +999,7 @@ int ObMacroBloomFilterCacheWriter::flush_to_cache(
     STORAGE_LOG(ERROR, "invalid argument,", K(ret), K(macro_id), K(*this));
   } else if (need_build_
       && OB_FAIL(ObStorageCacheSuite::get_instance().get_bf_cache().put_bloom_filter(
-          tenant_id, macro_id, bf_cache_value_))) {
+          tenant_id, tablet_id, macro_id, bf_cache_value_))) {
     STORAGE_LOG(WARN, "Fail to put value to bloom filter cache",
                 K(tenant_id), K(macro_id), K_(bf_cache_value), K(ret));
   }
@@ -22,12 +22,18 @@ namespace oceanbase
 namespace blocksstable
 {
 
+// Bits of a key are either spread over the whole filter, or all set in one 256 bit block
+// (split block layout), one bit in each 32 bit word of the block, so that a probe touches
+// one cache line and can be done with a few SIMD instructions.
 class ObBloomFilter
 {
 public:
   ObBloomFilter();
   ~ObBloomFilter();
-  int init(int64_t element_count, double false_positive_prob = BLOOM_FILTER_FALSE_POSITIVE_PROB);
+  int init(
+      int64_t element_count,
+      double false_positive_prob = BLOOM_FILTER_FALSE_POSITIVE_PROB,
+      const bool is_split_block = false);
   void destroy();
   void clear();
   int deep_copy(const ObBloomFilter &other);
@@ -37,20 +43,48 @@ public:
   int may_contain(const uint32_t key_hash, bool &is_contain) const;
   int64_t calc_nbyte(const int64_t nbit) const;
   OB_INLINE bool is_valid() const { return NULL != bits_ && nbit_ > 0 && nhash_ > 0; }
+  OB_INLINE bool is_split_block() const { return is_split_block_; }
+  // layout is not serialized, it is decided by the version of the owner
+  OB_INLINE void set_split_block(const bool is_split_block) { is_split_block_ = is_split_block; }
   OB_INLINE int64_t get_nhash() const { return nhash_; }
   OB_INLINE int64_t get_nbit() const { return nbit_; }
   OB_INLINE int64_t get_nbytes() const { return calc_nbyte(nbit_); }
   OB_INLINE uint8_t *get_bits() { return bits_; }
   OB_INLINE const uint8_t *get_bits() const { return bits_; }
-  TO_STRING_KV(K_(nhash), K_(nbit), KP_(bits));
+  TO_STRING_KV(K_(nhash), K_(nbit), K_(is_split_block), KP_(bits));
   INLINE_NEED_SERIALIZE_AND_DESERIALIZE;
+public:
+  static constexpr double BLOOM_FILTER_FALSE_POSITIVE_PROB = 0.01;
+  static const int64_t SPLIT_BLOCK_BITS = 256;
+  static const int64_t SPLIT_BLOCK_WORDS = 8;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObBloomFilter);
-  static constexpr double BLOOM_FILTER_FALSE_POSITIVE_PROB = 0.01;
+  // bits per key of a split block filter relative to a classic one of the same false positive rate
+  static constexpr double SPLIT_BLOCK_SIZE_FACTOR = 1.25;
+  static const uint32_t SPLIT_BLOCK_SALT[SPLIT_BLOCK_WORDS];
+  OB_INLINE static uint64_t split_block_hash(const uint32_t key_hash)
+  {
+    // only 32 bits of key hash, mix them to pick the block and the bits independently
+    uint64_t h = key_hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdUL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53UL;
+    h ^= h >> 33;
+    return h;
+  }
+  OB_INLINE uint32_t *get_split_block(const uint64_t hash) const
+  {
+    const uint64_t block_cnt = static_cast<uint64_t>(nbit_ / SPLIT_BLOCK_BITS);
+    return reinterpret_cast<uint32_t *>(bits_) + ((hash >> 32) * block_cnt >> 32) * SPLIT_BLOCK_WORDS;
+  }
+  void split_block_insert(const uint32_t key_hash);
+  bool split_block_may_contain(const uint32_t key_hash) const;
   common::ObArenaAllocator allocator_;
   int64_t nhash_;
   int64_t nbit_;
   uint8_t *bits_;
+  bool is_split_block_;
 };
 
 
@@ -66,6 +100,7 @@ public:
   virtual int deep_copy(char *buf, const int64_t buf_len, common::ObIKVCacheKey *&key) const;
   bool is_valid() const;
   inline int64_t get_prefix_rowkey_len() const { return prefix_rowkey_len_; }
+  inline const MacroBlockId &get_macro_block_id() const { return macro_block_id_; }
   TO_STRING_KV(K_(tenant_id), K_(macro_block_id), K_(prefix_rowkey_len) );
 private:
   uint64_t tenant_id_;
@@ -81,6 +116,8 @@ class ObBloomFilterCacheValue : public common::ObIKVCacheValue
 {
 public:
   static const int64_t BLOOM_FILTER_CACHE_VALUE_VERSION = 1;
+  // bloom filter in split block layout
+  static const int64_t SPLIT_BLOCK_BLOOM_FILTER_VERSION = 2;
   ObBloomFilterCacheValue();
   virtual ~ObBloomFilterCacheValue();
   void reset();
@@ -198,11 +235,14 @@ public:
   /**
    * put bloom filter to cache
    * @param [in] tenant_id
+   * @param [in] tablet_id: tablet of the macro block, invalid if the bloom filter is only probed
+   *                        with keys of its own prefix length
    * @param [in] macro_block_id
    * @param [in] bloom_filter
    */
   int put_bloom_filter(
       const uint64_t tenant_id,
+      const common::ObTabletID &tablet_id,
       const MacroBlockId& macro_block_id,
       const ObBloomFilterCacheValue &bloom_filter,
       const bool adaptive = false);
@@ -220,6 +260,26 @@ public:
       const ObDatumRowkey &rowkey,
       const ObStorageDatumUtils &datum_utils,
       bool &is_contain);
+  /**
+   * check if the macro block contains rows with the first @max_prefix_len columns of the rowkey,
+   * the bloom filter on @max_prefix_len columns or on any shorter rowkey prefix built before for
+   * the tablet is used
+   * @param [in] tenant_id
+   * @param [in] tablet_id
+   * @param [in] macro_block_id
+   * @param [in] rowkey
+   * @param [in] max_prefix_len
+   * @param [out] is_contain
+   * @return the error code
+   */
+  int may_contain(
+      const uint64_t tenant_id,
+      const common::ObTabletID &tablet_id,
+      const MacroBlockId &macro_block_id,
+      const ObDatumRowkey &rowkey,
+      const int64_t max_prefix_len,
+      const ObStorageDatumUtils &datum_utils,
+      bool &is_contain);
   /**
    * inc empty read count of the macro block, then try build build bloom filter for it if it is
    * necessary
@@ -265,6 +325,23 @@ public:
 
 private:
   int get_cell(const uint64_t hashcode, ObEmptyReadCell *&cell);
+  OB_INLINE uint64_t *get_prefix_len_bitmap(const common::ObTabletID &tablet_id)
+  {
+    const uint64_t id = tablet_id.id();
+    return &prefix_len_bitmaps_[common::murmurhash(&id, sizeof(id), 0) & (PREFIX_LEN_BITMAP_CNT - 1)];
+  }
+  OB_INLINE void mark_prefix_len(const common::ObTabletID &tablet_id, const int64_t prefix_len)
+  {
+    if (tablet_id.is_valid() && prefix_len > 0 && prefix_len < MAX_MARKED_PREFIX_LEN) {
+      uint64_t *bitmap = get_prefix_len_bitmap(tablet_id);
+      const uint64_t bit = 1UL << prefix_len;
+      if (0 == (ATOMIC_LOAD(bitmap) & bit)) {
+        (void) __sync_fetch_and_or(bitmap, bit);
+      }
+    }
+  }
+  static const int64_t MAX_MARKED_PREFIX_LEN = 64;
+  static const int64_t PREFIX_LEN_BITMAP_CNT = 1024;
   OB_INLINE uint64_t get_bucket_size() const { return bucket_size_; }
   OB_INLINE uint64_t get_bucket_magic() const { return bucket_magic_; }
   static const int64_t BF_BUILD_SPEED_SHIFT = 4;
@@ -277,6 +354,10 @@ private:
   ObEmptyReadCell *buckets_;
   uint64_t bucket_size_;
   uint64_t bucket_magic_;
+  // bit i of the bitmap of a tablet is set once a bloom filter on i rowkey columns is put for
+  // it, shorter prefixes than the query key are only probed if there may be bloom filters built
+  // on them, tablets hashed to the same bitmap share their bits
+  uint64_t prefix_len_bitmaps_[PREFIX_LEN_BITMAP_CNT];
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObBloomFilterCache);
@@ -307,7 +388,10 @@ public:
   int append(const common::ObArray<uint32_t> &hashs);
   bool can_merge(const ObMacroBloomFilterCacheWriter &other);
   int merge(const ObMacroBloomFilterCacheWriter &other);
-  int flush_to_cache(const uint64_t tenant_id, const MacroBlockId& macro_id);
+  int flush_to_cache(
+      const uint64_t tenant_id,
+      const common::ObTabletID &tablet_id,
+      const MacroBlockId& macro_id);
   OB_INLINE bool is_need_build() const { return is_inited_ && need_build_; }
   OB_INLINE bool is_valid() const { return is_inited_ && bf_cache_value_.is_valid(); }
   OB_INLINE int32_t get_row_count() const { return bf_cache_value_.get_row_count(); }
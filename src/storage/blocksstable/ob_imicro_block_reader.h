@@ -256,6 +256,19 @@ public:
     UNUSEDx(col_id, row_ids, row_cap, contains_null, count);
     return OB_NOT_SUPPORTED;
   }
+  // Decode column @col of rows @row_ids into @datums, ptr_ of each datum should point to
+  // a buffer of at least OBJ_DATUM_NUMBER_RES_SIZE bytes.
+  // Cells of columns not existing in the micro block are returned as ext(nop) datums.
+  virtual int get_column_datum(
+      const int32_t col,
+      const int64_t *row_ids,
+      const char **cell_datas,
+      const int64_t row_cap,
+      common::ObDatum *datums)
+  {
+    UNUSEDx(col, row_ids, cell_datas, row_cap, datums);
+    return OB_NOT_SUPPORTED;
+  }
   virtual int64_t get_column_count() const = 0;
 
 protected:
@@ -41,6 +41,8 @@ struct ObMicroBlockDesc
   MacroBlockId macro_id_;
   int64_t block_offset_;
   int64_t block_checksum_;
+  const char *aggregated_row_buf_; // skip index of the micro block, see ObAggRowHeader
+  int64_t aggregated_row_size_;
   int32_t row_count_delta_;
   bool contain_uncommitted_row_;
   bool can_mark_deletion_;
@@ -64,6 +66,8 @@ struct ObMicroBlockDesc
       K_(macro_id),
       K_(block_offset),
       K_(block_checksum),
+      KP_(aggregated_row_buf),
+      K_(aggregated_row_size),
       K_(row_count_delta),
       K_(contain_uncommitted_row),
       K_(can_mark_deletion),
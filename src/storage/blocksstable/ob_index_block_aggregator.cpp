@@ -0,0 +1,375 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_index_block_aggregator.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+void ObSkipIndexAggregator::ObColAggInfo::reuse()
+{
+  null_count_ = 0;
+  is_null_count_valid_ = true;
+  is_min_max_valid_ = true;
+  is_sum_valid_ = true;
+  has_value_ = false;
+  sum_ = 0;
+  min_.set_null();
+  max_.set_null();
+}
+
+int ObSkipIndexAggregator::ObColAggInfo::update(const ObDatum &datum, ObDatumCmpFuncType cmp_func)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(datum.len_ > MAX_AGG_DATUM_LEN || nullptr == cmp_func)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid datum to aggregate", K(ret), K(datum), KP(cmp_func));
+  } else if (!has_value_) {
+    MEMCPY(min_buf_, datum.ptr_, datum.len_);
+    MEMCPY(max_buf_, datum.ptr_, datum.len_);
+    min_.set_string(min_buf_, datum.len_);
+    max_.set_string(max_buf_, datum.len_);
+    has_value_ = true;
+  } else if (cmp_func(datum, min_) < 0) {
+    MEMCPY(min_buf_, datum.ptr_, datum.len_);
+    min_.set_string(min_buf_, datum.len_);
+  } else if (cmp_func(datum, max_) > 0) {
+    MEMCPY(max_buf_, datum.ptr_, datum.len_);
+    max_.set_string(max_buf_, datum.len_);
+  }
+  return ret;
+}
+
+void ObSkipIndexAggregator::ObColAggInfo::update_sum(const ObDatum &datum, const bool is_unsigned)
+{
+  if (is_unsigned) {
+    uint64_t sum = 0;
+    if (__builtin_add_overflow(static_cast<uint64_t>(sum_), datum.get_uint64(), &sum)) {
+      is_sum_valid_ = false;
+    } else {
+      sum_ = static_cast<int64_t>(sum);
+    }
+  } else if (__builtin_add_overflow(sum_, datum.get_int(), &sum_)) {
+    is_sum_valid_ = false;
+  }
+}
+
+ObSkipIndexAggregator::ObSkipIndexAggregator()
+  : allocator_(nullptr),
+    col_aggs_(nullptr),
+    cmp_funcs_(nullptr),
+    col_metas_(nullptr),
+    row_buf_(nullptr),
+    max_row_size_(0),
+    col_cnt_(0),
+    row_count_(0),
+    is_oracle_mode_(false),
+    is_inited_(false)
+{
+}
+
+ObSkipIndexAggregator::~ObSkipIndexAggregator()
+{
+  reset();
+}
+
+void ObSkipIndexAggregator::reset()
+{
+  if (nullptr != allocator_) {
+    if (nullptr != col_aggs_) {
+      allocator_->free(col_aggs_);
+    }
+    if (nullptr != cmp_funcs_) {
+      allocator_->free(cmp_funcs_);
+    }
+    if (nullptr != col_metas_) {
+      allocator_->free(col_metas_);
+    }
+    if (nullptr != row_buf_) {
+      allocator_->free(row_buf_);
+    }
+  }
+  allocator_ = nullptr;
+  col_aggs_ = nullptr;
+  cmp_funcs_ = nullptr;
+  col_metas_ = nullptr;
+  row_buf_ = nullptr;
+  max_row_size_ = 0;
+  col_cnt_ = 0;
+  row_count_ = 0;
+  is_oracle_mode_ = false;
+  is_inited_ = false;
+}
+
+void ObSkipIndexAggregator::reuse()
+{
+  for (int64_t i = 0; i < col_cnt_; ++i) {
+    col_aggs_[i].reuse();
+  }
+  row_count_ = 0;
+}
+
+bool ObSkipIndexAggregator::is_type_supported(const ObObjMeta &meta)
+{
+  bool bret = false;
+  switch (meta.get_type_class()) {
+    case ObIntTC:
+    case ObUIntTC:
+    case ObNumberTC:
+    case ObDateTimeTC:
+    case ObDateTC:
+    case ObTimeTC:
+    case ObYearTC:
+    case ObStringTC:
+    case ObOTimestampTC: {
+      bret = true;
+      break;
+    }
+    default: {
+      bret = false;
+    }
+  }
+  return bret;
+}
+
+bool ObSkipIndexAggregator::is_sum_supported(const ObObjMeta &meta)
+{
+  return ObIntTC == meta.get_type_class() || ObUIntTC == meta.get_type_class();
+}
+
+int ObSkipIndexAggregator::init(const ObDataStoreDesc &desc, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  const int64_t col_cnt = desc.skip_index_col_cnt_;
+  const int64_t trans_col_idx = desc.schema_rowkey_col_cnt_;
+  const int64_t sql_seq_col_idx = desc.schema_rowkey_col_cnt_ + 1;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("Init twice", K(ret));
+  } else if (OB_UNLIKELY(!desc.is_valid() || col_cnt <= 0 || col_cnt > desc.row_column_count_
+      || col_cnt > desc.col_desc_array_.count() || col_cnt > UINT16_MAX)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument to init skip index aggregator", K(ret), K(col_cnt), K(desc));
+  } else if (OB_ISNULL(col_aggs_ = static_cast<ObColAggInfo *>(
+      allocator.alloc(sizeof(ObColAggInfo) * col_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Fail to alloc col agg info", K(ret), K(col_cnt));
+  } else if (OB_ISNULL(cmp_funcs_ = static_cast<ObDatumCmpFuncType *>(
+      allocator.alloc(sizeof(ObDatumCmpFuncType) * col_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Fail to alloc cmp funcs", K(ret), K(col_cnt));
+  } else if (OB_ISNULL(col_metas_ = static_cast<ObObjMeta *>(
+      allocator.alloc(sizeof(ObObjMeta) * col_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Fail to alloc col metas", K(ret), K(col_cnt));
+  } else {
+    allocator_ = &allocator;
+    col_cnt_ = col_cnt;
+    is_oracle_mode_ = lib::is_oracle_mode();
+    max_row_size_ = sizeof(ObAggRowHeader)
+        + col_cnt * (sizeof(uint32_t) + sizeof(ObAggColHeader) + 2 * MAX_AGG_DATUM_LEN + sizeof(int64_t));
+    for (int64_t i = 0; i < col_cnt; ++i) {
+      const ObObjMeta &col_meta = desc.col_desc_array_.at(i).col_type_;
+      new (col_aggs_ + i) ObColAggInfo();
+      col_aggs_[i].reuse();
+      col_metas_[i] = col_meta;
+      cmp_funcs_[i] = nullptr;
+      if (trans_col_idx == i || sql_seq_col_idx == i || !is_type_supported(col_meta)) {
+        // multi-version columns are meaningless for queries
+      } else {
+        cmp_funcs_[i] = ObDatumFuncs::get_nullsafe_cmp_func(col_meta.get_type(),
+                                                            col_meta.get_type(),
+                                                            NULL_FIRST,
+                                                            col_meta.get_collation_type(),
+                                                            is_oracle_mode_);
+      }
+    }
+    if (OB_ISNULL(row_buf_ = static_cast<char *>(allocator.alloc(max_row_size_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Fail to alloc aggregated row buf", K(ret), K_(max_row_size));
+    } else {
+      is_inited_ = true;
+    }
+  }
+  if (OB_FAIL(ret)) {
+    if (nullptr == allocator_) {
+      allocator_ = &allocator;
+    }
+    reset();
+  }
+  return ret;
+}
+
+bool ObSkipIndexAggregator::is_oracle_null(const int64_t col_idx, const ObDatum &datum) const
+{
+  // keep the same with ObObj::is_null_oracle()
+  return is_oracle_mode_ && 0 == datum.len_
+      && col_metas_[col_idx].is_character_type() && !col_metas_[col_idx].is_lob();
+}
+
+int ObSkipIndexAggregator::eval(const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not inited", K(ret));
+  } else if (OB_UNLIKELY(!row.is_valid() || row.get_column_count() < col_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid row to aggregate", K(ret), K(row), K_(col_cnt));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < col_cnt_; ++i) {
+      const ObStorageDatum &datum = row.storage_datums_[i];
+      ObColAggInfo &col_agg = col_aggs_[i];
+      if (datum.is_ext()) {
+        // nop or min/max value, can not tell anything about this column
+        col_agg.is_null_count_valid_ = false;
+        col_agg.is_min_max_valid_ = false;
+        col_agg.is_sum_valid_ = false;
+      } else if (datum.is_null() || is_oracle_null(i, datum)) {
+        ++col_agg.null_count_;
+      } else {
+        if (col_agg.is_sum_valid_ && nullptr != cmp_funcs_[i] && is_sum_supported(col_metas_[i])) {
+          col_agg.update_sum(datum, ObUIntTC == col_metas_[i].get_type_class());
+        }
+        if (!col_agg.is_min_max_valid_) {
+        } else if (nullptr == cmp_funcs_[i] || datum.is_outrow() || datum.len_ > MAX_AGG_DATUM_LEN) {
+          col_agg.is_min_max_valid_ = false;
+        } else if (OB_FAIL(col_agg.update(datum, cmp_funcs_[i]))) {
+          LOG_WARN("Fail to update min max", K(ret), K(i), K(datum));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ++row_count_;
+    }
+  }
+  return ret;
+}
+
+int ObSkipIndexAggregator::get_aggregated_row(const char *&buf, int64_t &size)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not inited", K(ret));
+  } else {
+    ObAggRowHeader *header = reinterpret_cast<ObAggRowHeader *>(row_buf_);
+    uint32_t *col_offsets = reinterpret_cast<uint32_t *>(row_buf_ + sizeof(ObAggRowHeader));
+    int64_t pos = sizeof(ObAggRowHeader) + col_cnt_ * sizeof(uint32_t);
+    for (int64_t i = 0; i < col_cnt_; ++i) {
+      const ObColAggInfo &col_agg = col_aggs_[i];
+      ObAggColHeader *col_header = reinterpret_cast<ObAggColHeader *>(row_buf_ + pos);
+      col_offsets[i] = static_cast<uint32_t>(pos);
+      pos += sizeof(ObAggColHeader);
+      col_header->null_count_ = col_agg.null_count_;
+      col_header->obj_type_ = static_cast<uint8_t>(col_metas_[i].get_type());
+      col_header->flag_ = col_agg.is_null_count_valid_ ? ObAggColHeader::NULL_COUNT_VALID : 0;
+      col_header->min_len_ = 0;
+      col_header->max_len_ = 0;
+      if (col_agg.is_min_max_valid_ && col_agg.has_value_) {
+        col_header->flag_ |= ObAggColHeader::MIN_MAX_VALID;
+        col_header->min_len_ = static_cast<uint8_t>(col_agg.min_.len_);
+        col_header->max_len_ = static_cast<uint8_t>(col_agg.max_.len_);
+        MEMCPY(row_buf_ + pos, col_agg.min_.ptr_, col_agg.min_.len_);
+        pos += col_agg.min_.len_;
+        MEMCPY(row_buf_ + pos, col_agg.max_.ptr_, col_agg.max_.len_);
+        pos += col_agg.max_.len_;
+      }
+      if (col_agg.is_sum_valid_ && col_agg.has_value_ && nullptr != cmp_funcs_[i]
+          && is_sum_supported(col_metas_[i])) {
+        col_header->flag_ |= ObAggColHeader::SUM_VALID;
+        MEMCPY(row_buf_ + pos, &col_agg.sum_, sizeof(int64_t));
+        pos += sizeof(int64_t);
+      }
+    }
+    header->version_ = ObAggRowHeader::AGG_ROW_HEADER_V1;
+    header->col_cnt_ = static_cast<uint16_t>(col_cnt_);
+    header->length_ = static_cast<uint32_t>(pos);
+    buf = row_buf_;
+    size = pos;
+  }
+  return ret;
+}
+
+int ObAggRowReader::init(const char *buf, const int64_t buf_size)
+{
+  int ret = OB_SUCCESS;
+  const ObAggRowHeader *header = reinterpret_cast<const ObAggRowHeader *>(buf);
+  if (OB_UNLIKELY(nullptr == buf || buf_size < static_cast<int64_t>(sizeof(ObAggRowHeader)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid aggregated row buf", K(ret), KP(buf), K(buf_size));
+  } else if (OB_UNLIKELY(!header->is_valid() || header->length_ > buf_size)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("Invalid aggregated row header", K(ret), KPC(header), K(buf_size));
+  } else {
+    header_ = header;
+    buf_size_ = header->length_;
+  }
+  return ret;
+}
+
+int ObAggRowReader::read(
+    const int64_t col_idx,
+    const ObAggColHeader *&col_header,
+    ObDatum &min,
+    ObDatum &max) const
+{
+  ObDatum sum;
+  return read(col_idx, col_header, min, max, sum);
+}
+
+int ObAggRowReader::read(
+    const int64_t col_idx,
+    const ObAggColHeader *&col_header,
+    ObDatum &min,
+    ObDatum &max,
+    ObDatum &sum) const
+{
+  int ret = OB_SUCCESS;
+  col_header = nullptr;
+  if (OB_ISNULL(header_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not inited", K(ret));
+  } else if (OB_UNLIKELY(col_idx < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid column index", K(ret), K(col_idx));
+  } else if (col_idx >= header_->col_cnt_) {
+    // column not aggregated
+  } else {
+    const char *buf = reinterpret_cast<const char *>(header_);
+    const uint32_t offset = reinterpret_cast<const uint32_t *>(buf + sizeof(ObAggRowHeader))[col_idx];
+    const ObAggColHeader *tmp_header = reinterpret_cast<const ObAggColHeader *>(buf + offset);
+    if (OB_UNLIKELY(offset + sizeof(ObAggColHeader) > buf_size_
+        || offset + sizeof(ObAggColHeader) + tmp_header->min_len_ + tmp_header->max_len_
+           + tmp_header->get_sum_len() > buf_size_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("Invalid aggregated column offset", K(ret), K(col_idx), K(offset), K_(buf_size));
+    } else {
+      const char *min_ptr = buf + offset + sizeof(ObAggColHeader);
+      min.set_string(min_ptr, tmp_header->min_len_);
+      max.set_string(min_ptr + tmp_header->min_len_, tmp_header->max_len_);
+      if (tmp_header->is_sum_valid()) {
+        sum.set_string(min_ptr + tmp_header->min_len_ + tmp_header->max_len_, sizeof(int64_t));
+      }
+      col_header = tmp_header;
+    }
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
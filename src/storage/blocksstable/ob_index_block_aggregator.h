@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_INDEX_BLOCK_AGGREGATOR_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_INDEX_BLOCK_AGGREGATOR_H_
+
+#include "share/datum/ob_datum_funcs.h"
+#include "ob_datum_row.h"
+#include "ob_macro_block.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+/**
+ * Skip index of a data micro block, stored behind the header of its index row
+ * when ObIndexBlockRowHeader::is_pre_aggregated() is set:
+ *
+ *   ObAggRowHeader | uint32 col_offsets[col_cnt] | col_0 | col_1 | ...
+ *   col_i := ObAggColHeader | min bytes | max bytes [| int64 sum]
+ *
+ * The sum is only present for integer columns when SUM_VALID is set.
+ * Column i is the i-th stored column of the micro block, offsets are relative to
+ * the beginning of the aggregated row.
+ */
+struct ObAggRowHeader
+{
+  static const uint16_t AGG_ROW_HEADER_V1 = 1;
+  ObAggRowHeader() : version_(AGG_ROW_HEADER_V1), col_cnt_(0), length_(0) {}
+  OB_INLINE bool is_valid() const
+  {
+    return AGG_ROW_HEADER_V1 == version_
+        && length_ >= sizeof(ObAggRowHeader) + col_cnt_ * sizeof(uint32_t);
+  }
+  TO_STRING_KV(K_(version), K_(col_cnt), K_(length));
+
+  uint16_t version_;
+  uint16_t col_cnt_;
+  uint32_t length_;
+};
+
+struct ObAggColHeader
+{
+  static const uint8_t NULL_COUNT_VALID = 0x1;
+  static const uint8_t MIN_MAX_VALID = 0x2;
+  static const uint8_t SUM_VALID = 0x4;
+  OB_INLINE bool is_null_count_valid() const { return flag_ & NULL_COUNT_VALID; }
+  // min/max cover every non-null value of the column
+  OB_INLINE bool is_min_max_valid() const { return flag_ & MIN_MAX_VALID; }
+  // sum of every non-null value fits in 8 bytes, int64 or uint64 by column type
+  OB_INLINE bool is_sum_valid() const { return flag_ & SUM_VALID; }
+  OB_INLINE int64_t get_sum_len() const { return is_sum_valid() ? sizeof(int64_t) : 0; }
+  TO_STRING_KV(K_(null_count), K_(obj_type), K_(flag), K_(min_len), K_(max_len));
+
+  uint32_t null_count_;
+  uint8_t obj_type_;
+  uint8_t flag_;
+  uint8_t min_len_;
+  uint8_t max_len_;
+};
+
+STATIC_ASSERT(sizeof(ObAggRowHeader) == 8, "size of agg row header mismatch");
+STATIC_ASSERT(sizeof(ObAggColHeader) == 8, "size of agg col header mismatch");
+
+// Collects min/max/sum/null count of leading stored columns for the rows of a micro block
+class ObSkipIndexAggregator final
+{
+public:
+  // values longer than this are not tracked, min/max of the column becomes invalid
+  static const int64_t MAX_AGG_DATUM_LEN = 16;
+  ObSkipIndexAggregator();
+  ~ObSkipIndexAggregator();
+  int init(const ObDataStoreDesc &desc, common::ObIAllocator &allocator);
+  void reset();
+  void reuse();
+  int eval(const ObDatumRow &row);
+  // buf is valid until next reuse()
+  int get_aggregated_row(const char *&buf, int64_t &size);
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  OB_INLINE int64_t get_row_count() const { return row_count_; }
+  static bool is_type_supported(const common::ObObjMeta &meta);
+  static bool is_sum_supported(const common::ObObjMeta &meta);
+  TO_STRING_KV(K_(is_inited), K_(col_cnt), K_(row_count), K_(max_row_size), K_(is_oracle_mode));
+
+private:
+  struct ObColAggInfo
+  {
+    void reuse();
+    int update(const common::ObDatum &datum, common::ObDatumCmpFuncType cmp_func);
+    void update_sum(const common::ObDatum &datum, const bool is_unsigned);
+    uint32_t null_count_;
+    bool is_null_count_valid_;
+    bool is_min_max_valid_;
+    bool is_sum_valid_;
+    bool has_value_;
+    int64_t sum_;
+    common::ObDatum min_;
+    common::ObDatum max_;
+    char min_buf_[MAX_AGG_DATUM_LEN];
+    char max_buf_[MAX_AGG_DATUM_LEN];
+  };
+  bool is_oracle_null(const int64_t col_idx, const common::ObDatum &datum) const;
+
+private:
+  common::ObIAllocator *allocator_;
+  ObColAggInfo *col_aggs_;
+  common::ObDatumCmpFuncType *cmp_funcs_; // nullptr means min/max is not tracked
+  common::ObObjMeta *col_metas_;
+  char *row_buf_;
+  int64_t max_row_size_;
+  int64_t col_cnt_;
+  int64_t row_count_;
+  bool is_oracle_mode_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(ObSkipIndexAggregator);
+};
+
+class ObAggRowReader final
+{
+public:
+  ObAggRowReader() : header_(nullptr), buf_size_(0) {}
+  ~ObAggRowReader() = default;
+  int init(const char *buf, const int64_t buf_size);
+  OB_INLINE int64_t get_col_cnt() const { return nullptr == header_ ? 0 : header_->col_cnt_; }
+  // col_header is set to nullptr if the column is not aggregated
+  int read(
+      const int64_t col_idx,
+      const ObAggColHeader *&col_header,
+      common::ObDatum &min,
+      common::ObDatum &max) const;
+  // sum is set only if col_header->is_sum_valid()
+  int read(
+      const int64_t col_idx,
+      const ObAggColHeader *&col_header,
+      common::ObDatum &min,
+      common::ObDatum &max,
+      common::ObDatum &sum) const;
+  TO_STRING_KV(KPC_(header), K_(buf_size));
+
+private:
+  const ObAggRowHeader *header_;
+  int64_t buf_size_;
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+#endif // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_INDEX_BLOCK_AGGREGATOR_H_
@@ -1408,6 +1408,8 @@ void ObBaseIndexBlockBuilder::block_to_row_desc(
   row_desc.max_merged_trans_version_ = micro_block_desc.max_merged_trans_version_;
   row_desc.contain_uncommitted_row_ = micro_block_desc.contain_uncommitted_row_;
   row_desc.is_last_row_last_flag_ = micro_block_desc.is_last_row_last_flag_;
+  row_desc.aggregated_row_buf_ = micro_block_desc.aggregated_row_buf_;
+  row_desc.aggregated_row_size_ = micro_block_desc.aggregated_row_size_;
 }
 
 int ObBaseIndexBlockBuilder::meta_to_row_desc(
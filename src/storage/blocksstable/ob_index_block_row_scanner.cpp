@@ -136,20 +136,35 @@ int ObIndexBlockDataTransformer::update_index_block(
     int64_t buf_len)
 {
   int ret = OB_SUCCESS;
-  const ObMicroBlockHeader *micro_block_header =
-      reinterpret_cast<const ObMicroBlockHeader *>(micro_data);
-  if (OB_UNLIKELY(!src_idx_header.is_valid() || micro_data_size < 0 || buf_len < 0)
+  ObMicroBlockData target_block(micro_data, micro_data_size);
+  if (OB_UNLIKELY(!src_idx_header.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid src index block header", K(ret), K(src_idx_header));
+  } else if (OB_FAIL(transform(src_idx_header.col_meta_array_, target_block, transform_buf, buf_len))) {
+    LOG_WARN("Fail to re transform index block data", K(ret));
+  }
+  return ret;
+}
+
+int ObIndexBlockDataTransformer::transform(
+    const ObObjMeta *col_metas,
+    const ObMicroBlockData &block_data,
+    char *transform_buf,
+    int64_t buf_len)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockHeader *micro_block_header = block_data.get_micro_header();
+  if (OB_UNLIKELY(block_data.get_buf_size() < 0 || buf_len < 0)
+      || OB_ISNULL(col_metas)
       || OB_ISNULL(transform_buf)
-      || OB_ISNULL(micro_block_header)
-      || OB_UNLIKELY(!micro_block_header->is_valid())) {
+      || OB_ISNULL(micro_block_header)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("Invalid src micro block data", K(ret),
-        KP(micro_data), K(micro_data_size), KP(transform_buf), K(buf_len));
+        KP(col_metas), K(block_data), KP(transform_buf), K(buf_len));
   } else {
     ObArenaAllocator allocator;
     ObTableReadInfo index_read_info;
     ObSEArray<ObColDesc, OB_DEFAULT_SE_ARRAY_COUNT> index_col_desc;
-    ObMicroBlockData target_block(micro_data, micro_data_size);
     const int64_t schema_rowkey_cnt =
         micro_block_header->rowkey_column_count_ - ObMultiVersionRowkeyHelpper::get_extra_rowkey_col_cnt();
     if (OB_FAIL(index_col_desc.reserve(micro_block_header->column_count_))) {
@@ -158,7 +173,7 @@ int ObIndexBlockDataTransformer::update_index_block(
     ObColDesc col_desc;
     for (int64_t i = 0; OB_SUCC(ret) && i < micro_block_header->column_count_; ++i) {
       col_desc.reset();
-      col_desc.col_type_ = src_idx_header.col_meta_array_[i];
+      col_desc.col_type_ = col_metas[i];
       if (OB_FAIL(index_col_desc.push_back(col_desc))) {
         LOG_WARN("Fail to push col desc into array", K(ret));
       }
@@ -167,8 +182,8 @@ int ObIndexBlockDataTransformer::update_index_block(
     if (OB_FAIL(ret)) {
     } else if (OB_FAIL(index_read_info.init(allocator, schema_rowkey_cnt + 1, schema_rowkey_cnt, lib::is_oracle_mode(), index_col_desc, true))) {
       LOG_WARN("Fail to init column read info", K(ret), KPC(micro_block_header));
-    } else if (OB_FAIL(transform(index_read_info, target_block, transform_buf, buf_len))) {
-      LOG_WARN("Fail to re transform index block data", K(ret));
+    } else if (OB_FAIL(transform(index_read_info, block_data, transform_buf, buf_len))) {
+      LOG_WARN("Fail to transform index block data", K(ret));
     }
   }
   return ret;
@@ -355,6 +370,8 @@ int ObIndexBlockRowScanner::get_next(ObMicroIndexInfo &idx_block_row)
   const ObIndexBlockRowHeader *idx_row_header = nullptr;
   const ObIndexBlockRowMinorMetaInfo *idx_minor_info = nullptr;
   const char *idx_data_buf = nullptr;
+  const char *agg_row_buf = nullptr;
+  int64_t agg_buf_size = 0;
   int ret = OB_SUCCESS;
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
@@ -372,6 +389,8 @@ int ObIndexBlockRowScanner::get_next(ObMicroIndexInfo &idx_block_row)
     if (OB_FAIL(idx_row_parser_.get_minor_meta(idx_minor_info))) {
       LOG_WARN("Fail to get minor meta info", K(ret));
     }
+  } else if (OB_FAIL(idx_row_parser_.get_agg_row(agg_row_buf, agg_buf_size))) {
+    LOG_WARN("Fail to get aggregated row", K(ret));
   }
 
   if (OB_SUCC(ret)) {
@@ -379,6 +398,8 @@ int ObIndexBlockRowScanner::get_next(ObMicroIndexInfo &idx_block_row)
     idx_block_row.endkey_ = is_transformed_ ? &idx_data_header_->rowkey_array_[current_] : &endkey_;
     idx_block_row.row_header_ = idx_row_header;
     idx_block_row.minor_meta_info_ = idx_minor_info;
+    idx_block_row.agg_row_buf_ = agg_row_buf;
+    idx_block_row.agg_buf_size_ = agg_buf_size;
     idx_block_row.is_get_ = is_get_;
     idx_block_row.is_left_border_ = is_left_border_ && current_ == start_;
     idx_block_row.is_right_border_ = is_right_border_ && current_ == end_;
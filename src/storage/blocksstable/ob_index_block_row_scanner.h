@@ -71,6 +71,12 @@ public:
       const int64_t micro_data_size,
       char *transform_buf,
       int64_t buf_len);
+  // transform with column types of the index block, when the index read info is not at hand
+  int transform(
+      const ObObjMeta *col_metas,
+      const ObMicroBlockData &block_data,
+      char *transform_buf,
+      int64_t buf_len);
   static int64_t get_transformed_block_mem_size(const int64_t row_cnt, const int64_t idx_col_cnt);
   static int64_t get_transformed_block_mem_size(const ObMicroBlockData &block_data);
 private:
@@ -15,6 +15,7 @@
 #include "common/row/ob_row.h"
 #include "ob_index_block_row_struct.h"
 #include "ob_block_sstable_struct.h"
+#include "ob_index_block_aggregator.h"
 
 namespace oceanbase
 {
@@ -27,6 +28,7 @@ ObIndexBlockRowDesc::ObIndexBlockRowDesc()
   : data_store_desc_(nullptr), row_key_(), macro_id_(), block_offset_(0),
     row_count_(0), row_count_delta_(0), max_merged_trans_version_(0), block_size_(0),
     macro_block_count_(0), micro_block_count_(0),
+    aggregated_row_buf_(nullptr), aggregated_row_size_(0),
     is_deleted_(false), contain_uncommitted_row_(false), is_data_block_(false),
     is_secondary_meta_(false), is_macro_node_(false), has_out_row_column_(false),
     is_last_row_last_flag_(false) {}
@@ -35,6 +37,7 @@ ObIndexBlockRowDesc::ObIndexBlockRowDesc(ObDataStoreDesc &data_store_desc)
   : data_store_desc_(&data_store_desc), row_key_(), macro_id_(), block_offset_(0),
     row_count_(0), row_count_delta_(0), max_merged_trans_version_(0), block_size_(0),
     macro_block_count_(0), micro_block_count_(0),
+    aggregated_row_buf_(nullptr), aggregated_row_size_(0),
     is_deleted_(false), contain_uncommitted_row_(false), is_data_block_(false),
     is_secondary_meta_(false), is_macro_node_(false), has_out_row_column_(false),
     is_last_row_last_flag_(false) {}
@@ -247,10 +250,9 @@ int ObIndexBlockRowBuilder::calc_data_size(const ObIndexBlockRowDesc &desc, int6
     size = sizeof(ObIndexBlockRowHeader);
   } else if (MAJOR_MERGE == desc.data_store_desc_->merge_type_) {
     size = sizeof(ObIndexBlockRowHeader);
-    // if (desc.is_pre_aggregated_) {
-      // TODO: @saitong.zst Calculate aggregate size here
-      // size += aggregate_size;
-    // }
+    if (desc.is_data_block_ && nullptr != desc.aggregated_row_buf_) {
+      size += desc.aggregated_row_size_;
+    }
   } else {
     size = sizeof(ObIndexBlockRowHeader) + sizeof(ObIndexBlockRowMinorMetaInfo);
   }
@@ -270,6 +272,17 @@ int ObIndexBlockRowBuilder::calc_data_size(
     size = sizeof(ObIndexBlockRowHeader);
   } else if (idx_row_header.is_major_node()) {
     size = sizeof(ObIndexBlockRowHeader);
+    if (idx_row_header.is_pre_aggregated()) {
+      // aggregated row is laid right behind the header in the same buffer
+      const ObAggRowHeader *agg_header = reinterpret_cast<const ObAggRowHeader *>(
+          reinterpret_cast<const char *>(&idx_row_header) + sizeof(ObIndexBlockRowHeader));
+      if (OB_UNLIKELY(!agg_header->is_valid())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Invalid aggregated row header", K(ret), K(idx_row_header), KPC(agg_header));
+      } else {
+        size += agg_header->length_;
+      }
+    }
   } else {
     size = sizeof(ObIndexBlockRowHeader) + sizeof(ObIndexBlockRowMinorMetaInfo);
   }
@@ -293,7 +306,8 @@ int ObIndexBlockRowBuilder::append_header_and_meta(const ObIndexBlockRowDesc &de
     header_->is_leaf_block_ = desc.is_macro_node_;
     header_->is_macro_node_ = desc.is_macro_node_;
     header_->is_major_node_ = desc.data_store_desc_->merge_type_ == MAJOR_MERGE;
-    // header_->is_pre_aggregated_ =
+    header_->is_pre_aggregated_ = header_->is_major_node_ && desc.is_data_block_
+        && nullptr != desc.aggregated_row_buf_;
     header_->is_deleted_ = desc.is_deleted_;
     header_->macro_id_ =(desc.is_data_block_ && is_data_mid_micro_block)
         ? ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID : desc.macro_id_;
@@ -327,20 +341,25 @@ int ObIndexBlockRowBuilder::append_header_and_meta(const ObIndexBlockRowDesc &de
 int ObIndexBlockRowBuilder::append_aggregate_data(const ObIndexBlockRowDesc &desc)
 {
   int ret = OB_SUCCESS;
-  UNUSED(desc);
   if (OB_ISNULL(header_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Fail to append aggregation data to buffer", K(ret), KP_(header));
   } else if (!header_->is_pre_aggregated()) {
+  } else if (OB_UNLIKELY(nullptr == desc.aggregated_row_buf_
+      || desc.aggregated_row_size_ < static_cast<int64_t>(sizeof(ObAggRowHeader)))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected aggregated row", K(ret), K(desc));
   } else {
-    // TODO: @saitong.zst Write aggregate data here
+    MEMCPY(data_buf_ + write_pos_, desc.aggregated_row_buf_, desc.aggregated_row_size_);
+    write_pos_ += desc.aggregated_row_size_;
   }
   return ret;
 }
 
 
 ObIndexBlockRowParser::ObIndexBlockRowParser()
-  : header_(nullptr), minor_meta_info_(nullptr), is_inited_(false) {}
+  : header_(nullptr), minor_meta_info_(nullptr), agg_row_buf_(nullptr), agg_buf_size_(0),
+    is_inited_(false) {}
 
 int ObIndexBlockRowParser::init(const int64_t rowkey_column_count, const ObDatumRow &row)
 {
@@ -366,6 +385,9 @@ int ObIndexBlockRowParser::init(const int64_t rowkey_column_count, const ObDatum
 int ObIndexBlockRowParser::init(const char *data_buf)
 {
   int ret = OB_SUCCESS;
+  minor_meta_info_ = nullptr;
+  agg_row_buf_ = nullptr;
+  agg_buf_size_ = 0;
   if (OB_ISNULL(data_buf)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("Unexpected null data buffer for index block row data", K(ret));
@@ -380,10 +402,19 @@ int ObIndexBlockRowParser::init(const char *data_buf)
     const int64_t minor_meta_offset = sizeof(ObIndexBlockRowHeader);
     minor_meta_info_ = reinterpret_cast<const ObIndexBlockRowMinorMetaInfo *>(
       data_buf + minor_meta_offset);
+  } else if (header_->is_pre_aggregated()) {
+    const char *agg_row_buf = data_buf + sizeof(ObIndexBlockRowHeader);
+    const ObAggRowHeader *agg_header = reinterpret_cast<const ObAggRowHeader *>(agg_row_buf);
+    if (OB_UNLIKELY(!agg_header->is_valid())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("Invalid aggregated row header parsed from data", K(ret), KPC(header_), KPC(agg_header));
+      header_ = nullptr;
+    } else {
+      agg_row_buf_ = agg_row_buf;
+      agg_buf_size_ = agg_header->length_;
+    }
   }
 
-  // TODO: @saitong.zst locate aggregated data logic here
-
   if (OB_SUCC(ret)) {
     is_inited_ = true;
   }
@@ -417,6 +448,19 @@ int ObIndexBlockRowParser::get_minor_meta(const ObIndexBlockRowMinorMetaInfo *&m
   return ret;
 }
 
+int ObIndexBlockRowParser::get_agg_row(const char *&agg_row_buf, int64_t &agg_buf_size) const
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not inited", K(ret));
+  } else {
+    agg_row_buf = agg_row_buf_;
+    agg_buf_size = agg_buf_size_;
+  }
+  return ret;
+}
+
 int ObIndexBlockRowParser::is_macro_node(bool &is_macro_node) const
 {
   int ret = OB_SUCCESS;
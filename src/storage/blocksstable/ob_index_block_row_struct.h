@@ -60,6 +60,8 @@ struct ObIndexBlockRowDesc
   int64_t block_size_;
   int64_t macro_block_count_;
   int64_t micro_block_count_;
+  const char *aggregated_row_buf_; // skip index of data block, nullptr if not aggregated
+  int64_t aggregated_row_size_;
   bool is_deleted_;
   bool contain_uncommitted_row_;
   bool is_data_block_;
@@ -72,6 +74,7 @@ struct ObIndexBlockRowDesc
       K_(block_offset), K_(row_count), K_(row_count_delta),
       K_(max_merged_trans_version), K_(block_size),
       K_(macro_block_count), K_(micro_block_count),
+      KP_(aggregated_row_buf), K_(aggregated_row_size),
       K_(is_deleted), K_(contain_uncommitted_row), K_(is_data_block),
       K_(is_secondary_meta), K_(is_macro_node), K_(has_out_row_column),
       K_(is_last_row_last_flag));
@@ -197,6 +200,8 @@ public:
   ObMicroIndexInfo()
     : row_header_(nullptr),
       minor_meta_info_(nullptr),
+      agg_row_buf_(nullptr),
+      agg_buf_size_(0),
       endkey_(nullptr),
       query_range_(nullptr),
       flag_(0),
@@ -209,6 +214,8 @@ public:
   {
     row_header_ = nullptr;
     minor_meta_info_ = nullptr;
+    agg_row_buf_ = nullptr;
+    agg_buf_size_ = 0;
     endkey_ = nullptr;
     query_range_ = nullptr;
     flag_ = 0;
@@ -348,15 +355,20 @@ public:
   {
     return is_filter_applied_ && !is_left_border_ && !is_right_border_;
   }
+  OB_INLINE bool has_agg_data() const
+  {
+    return nullptr != agg_row_buf_ && agg_buf_size_ > 0;
+  }
 
-  TO_STRING_KV(KP_(query_range), KPC_(row_header), KPC_(minor_meta_info), KPC_(endkey),
-      K_(flag), K_(range_idx), K_(parent_macro_id), K_(nested_offset));
+  TO_STRING_KV(KP_(query_range), KPC_(row_header), KPC_(minor_meta_info), KP_(agg_row_buf),
+      K_(agg_buf_size), KPC_(endkey), K_(flag), K_(range_idx), K_(parent_macro_id), K_(nested_offset));
 
 public:
   const ObIndexBlockRowHeader *row_header_;
   const ObIndexBlockRowMinorMetaInfo *minor_meta_info_;
+  const char *agg_row_buf_;
+  int64_t agg_buf_size_;
   const ObDatumRowkey *endkey_;
-  // ObPreAggDataStore *pre_agg_data_;
   union {
     const ObDatumRowkey *rowkey_;
     const ObDatumRange *range_;
@@ -425,16 +437,18 @@ public:
   int init(const char *data_buf);
   int get_header(const ObIndexBlockRowHeader *&header) const;
   int get_minor_meta(const ObIndexBlockRowMinorMetaInfo *&meta) const;
+  int get_agg_row(const char *&agg_row_buf, int64_t &agg_buf_size) const;
   int is_macro_node(bool &is_macro_node) const;
   int64_t get_snapshot_version() const;
   int64_t get_max_merged_trans_version() const;
   int64_t get_row_count_delta() const;
-  TO_STRING_KV(K_(is_inited), KPC(header_));
+  TO_STRING_KV(K_(is_inited), KPC(header_), KP_(agg_row_buf), K_(agg_buf_size));
 
 private:
   const ObIndexBlockRowHeader *header_;
   const ObIndexBlockRowMinorMetaInfo *minor_meta_info_;
-  // Aggregate data read struct
+  const char *agg_row_buf_;
+  int64_t agg_buf_size_;
   bool is_inited_;
 };
 
@@ -1123,6 +1123,9 @@ int ObIndexBlockTreeCursor::get_micro_block_infos(
       index_info.row_header_ = idx_row_header;
       index_info.parent_macro_id_ = curr_path_item_->macro_block_id_;
       if (!idx_row_header->is_data_index() || idx_row_header->is_major_node()) {
+        if (OB_FAIL(idx_row_parser_.get_agg_row(index_info.agg_row_buf_, index_info.agg_buf_size_))) {
+          LOG_WARN("Fail to get aggregated row", K(ret));
+        }
       } else if (OB_FAIL(idx_row_parser_.get_minor_meta(index_info.minor_meta_info_))) {
         LOG_WARN("Fail to get minor meta info", K(ret));
       }
@@ -16,6 +16,7 @@
 #include "ob_block_manager.h"
 #include "ob_macro_block.h"
 #include "observer/ob_server_struct.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "share/ob_encryption_util.h"
 #include "share/ob_force_print_log.h"
 #include "share/ob_task_define.h"
@@ -141,6 +142,27 @@ int ObDataStoreDesc::cal_row_store_type(const share::schema::ObMergeSchema &merg
   return ret;
 }
 
+void ObDataStoreDesc::cal_skip_index_col_cnt()
+{
+  // skip index is only kept in index rows of major sstable, and only once all the servers can
+  // rebuild reused index rows with the aggregated payload
+  int64_t skip_index_col_cnt = 0;
+  skip_index_col_cnt_ = 0;
+  if (MAJOR_MERGE == merge_type_ && major_working_cluster_version_ >= CLUSTER_VERSION_4_2_0_0) {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    if (tenant_config.is_valid()) {
+      skip_index_col_cnt = tenant_config->_skip_index_column_count;
+    }
+  }
+  if (skip_index_col_cnt > 0) {
+    if (skip_index_col_cnt > schema_rowkey_col_cnt_) {
+      // multi-version columns are stored behind rowkey columns
+      skip_index_col_cnt += ObMultiVersionRowkeyHelpper::get_extra_rowkey_col_cnt();
+    }
+    skip_index_col_cnt_ = MIN(skip_index_col_cnt, row_column_count_);
+  }
+}
+
 int ObDataStoreDesc::init(
     const ObMergeSchema &merge_schema,
     const share::ObLSID &ls_id,
@@ -231,6 +253,9 @@ int ObDataStoreDesc::init(
       }
       STORAGE_LOG(INFO, "success to set major working cluster version", K(tmp_ret), K(merge_type), K(cluster_version), K(major_working_cluster_version_));
     }
+    if (OB_SUCC(ret)) {
+      cal_skip_index_col_cnt();
+    }
 
     if (OB_FAIL(ret)) {
     } else if (OB_FAIL(col_desc_array_.init(row_column_count_))) {
@@ -291,6 +316,7 @@ void ObDataStoreDesc::reset()
   major_working_cluster_version_ = 0;
   sstable_index_builder_ = nullptr;
   is_ddl_ = false;
+  skip_index_col_cnt_ = 0;
   col_desc_array_.reset();
   datum_utils_.reset();
   allocator_.reset();
@@ -323,6 +349,7 @@ int ObDataStoreDesc::assign(const ObDataStoreDesc &desc)
   MEMCPY(encrypt_key_, desc.encrypt_key_, sizeof(encrypt_key_));
   major_working_cluster_version_ = desc.major_working_cluster_version_;
   is_ddl_ = desc.is_ddl_;
+  skip_index_col_cnt_ = desc.skip_index_col_cnt_;
   col_desc_array_.reset();
   datum_utils_.reset();
   sstable_index_builder_ = desc.sstable_index_builder_;
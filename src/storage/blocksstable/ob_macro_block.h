@@ -77,6 +77,9 @@ struct ObDataStoreDesc
   // which still use freezeinfo without cluster version
   int64_t major_working_cluster_version_;
   bool is_ddl_;
+  // count of leading stored columns to build skip index (min/max/null count) for
+  // each micro block, 0 means no skip index
+  int64_t skip_index_col_cnt_;
   common::ObArenaAllocator allocator_;
   common::ObFixedArray<share::schema::ObColDesc, common::ObIAllocator> col_desc_array_;
   blocksstable::ObStorageDatumUtils datum_utils_;
@@ -123,6 +126,7 @@ struct ObDataStoreDesc
       K_(major_working_cluster_version),
       KP_(sstable_index_builder),
       K_(is_ddl),
+      K_(skip_index_col_cnt),
       K_(col_desc_array));
 
 private:
@@ -130,6 +134,7 @@ private:
       const share::schema::ObMergeSchema &schema,
       const storage::ObMergeType merge_type);
   int get_emergency_row_store_type();
+  void cal_skip_index_col_cnt();
 private:
   DISALLOW_COPY_AND_ASSIGN(ObDataStoreDesc);
 };
@@ -372,7 +372,8 @@ ObMacroBlockWriter::ObMacroBlockWriter()
    datum_row_(),
    check_datum_row_(),
    callback_(nullptr),
-   builder_(NULL)
+   builder_(NULL),
+   skip_index_aggregator_()
 {
   //macro_blocks_, macro_handles_
 }
@@ -413,6 +414,7 @@ void ObMacroBlockWriter::reset()
     builder_ = nullptr;
   }
   micro_block_adaptive_splitter_.reset();
+  skip_index_aggregator_.reset();
   allocator_.reset();
   rowkey_allocator_.reset();
 }
@@ -477,6 +479,11 @@ int ObMacroBlockWriter::open(
           STORAGE_LOG(WARN, "Failed to init micro block adaptive split", K(ret), K(data_store_desc.macro_store_size_));
         }
       }
+      if (OB_SUCC(ret) && nullptr != builder_ && data_store_desc_->skip_index_col_cnt_ > 0) {
+        if (OB_FAIL(skip_index_aggregator_.init(*data_store_desc_, allocator_))) {
+          STORAGE_LOG(WARN, "Failed to init skip index aggregator", K(ret), KPC_(data_store_desc));
+        }
+      }
       if (OB_SUCC(ret) && data_store_desc_->is_major_merge()) {
         if (OB_ISNULL(curr_micro_column_checksum_ = static_cast<int64_t *>(
             allocator_.alloc(sizeof(int64_t) * data_store_desc_->row_column_count_)))) {
@@ -534,6 +541,8 @@ int ObMacroBlockWriter::append_row(const ObDatumRow &row, const int64_t split_si
           STORAGE_LOG(WARN, "Fail to build micro block, ", K(ret));
         } else if (OB_FAIL(micro_writer_->append_row(*row_to_append))) {
           STORAGE_LOG(ERROR, "Fail to append row to micro block, ", K(ret), K(row));
+        } else if (OB_FAIL(eval_skip_index(*row_to_append))) {
+          STORAGE_LOG(WARN, "Fail to eval skip index, ", K(ret), K(row));
         } else if (OB_FAIL(save_last_key(*row_to_append))) {
           STORAGE_LOG(WARN, "Fail to save last key, ", K(ret), K(row));
         }
@@ -569,6 +578,8 @@ int ObMacroBlockWriter::append_row(const ObDatumRow &row, const int64_t split_si
         }
       }
       if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(eval_skip_index(*row_to_append))) {
+        STORAGE_LOG(WARN, "Fail to eval skip index, ", K(ret), K(row));
       } else if (OB_FAIL(save_last_key(*row_to_append))) {
         STORAGE_LOG(WARN, "Fail to save last key, ", K(ret), K(row));
       } else if (OB_FAIL(micro_block_adaptive_splitter_.check_need_split(micro_writer_->get_block_size(), micro_writer_->get_row_count(),
@@ -875,6 +886,8 @@ int ObMacroBlockWriter::build_micro_block()
   } else if (OB_FAIL(micro_writer_->build_micro_block_desc(micro_block_desc))) {
     STORAGE_LOG(WARN, "failed to build micro block desc", K(ret));
   } else if (FALSE_IT(micro_block_desc.last_rowkey_ = last_key_)) {
+  } else if (OB_FAIL(build_skip_index(micro_block_desc))) {
+    STORAGE_LOG(WARN, "failed to build skip index", K(ret), K(micro_block_desc));
   } else if (FALSE_IT(block_size = micro_block_desc.buf_size_)) {
   } else if (OB_FAIL(micro_helper_.compress_encrypt_micro_block(micro_block_desc))) {
     micro_writer_->dump_diagnose_info(); // ignore dump error
@@ -889,6 +902,9 @@ int ObMacroBlockWriter::build_micro_block()
   }
   if (OB_SUCC(ret)) {
     micro_writer_->reuse();
+    if (skip_index_aggregator_.is_inited()) {
+      skip_index_aggregator_.reuse();
+    }
     if (data_store_desc_->need_prebuild_bloomfilter_ && micro_rowkey_hashs_.count() > 0) {
       micro_rowkey_hashs_.reuse();
     }
@@ -948,6 +964,7 @@ int ObMacroBlockWriter::build_micro_block_desc_with_reuse(
     micro_block_desc.buf_size_ = header.data_zlength_;
     micro_block_desc.has_out_row_column_ = micro_block.micro_index_info_->has_out_row_column();
     micro_block_desc.original_size_ = header.original_length_;
+    reuse_skip_index(micro_block, micro_block_desc);
   }
   STORAGE_LOG(DEBUG, "build micro block desc reuse", K(data_store_desc_->tablet_id_), K(micro_block_desc), "lbt", lbt(), K(ret));
   return ret;
@@ -1007,6 +1024,8 @@ int ObMacroBlockWriter::build_micro_block_desc_with_rewrite(
       micro_block_desc.column_count_ = header.column_count_;
       micro_block_desc.row_count_ = header.row_count_;
       micro_block_desc.has_out_row_column_ = micro_block.micro_index_info_->has_out_row_column();
+      // data is not rewritten, skip index of existing columns still holds
+      reuse_skip_index(micro_block, micro_block_desc);
       if (header.has_column_checksum_) {
         MEMSET(curr_micro_column_checksum_, 0, sizeof(int64_t) * data_store_desc_->row_column_count_);
         if (OB_FAIL(calc_micro_column_checksum(header.column_count_, *reader, curr_micro_column_checksum_))) {
@@ -1019,6 +1038,38 @@ int ObMacroBlockWriter::build_micro_block_desc_with_rewrite(
   return ret;
 }
 
+int ObMacroBlockWriter::eval_skip_index(const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  if (skip_index_aggregator_.is_inited() && OB_FAIL(skip_index_aggregator_.eval(row))) {
+    STORAGE_LOG(WARN, "Fail to aggregate row for skip index", K(ret), K(row));
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::build_skip_index(ObMicroBlockDesc &micro_block_desc)
+{
+  int ret = OB_SUCCESS;
+  if (!skip_index_aggregator_.is_inited()) {
+  } else if (OB_UNLIKELY(skip_index_aggregator_.get_row_count() != micro_block_desc.row_count_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "Row count of skip index mismatch with micro block", K(ret),
+        K_(skip_index_aggregator), K(micro_block_desc));
+  } else if (OB_FAIL(skip_index_aggregator_.get_aggregated_row(
+      micro_block_desc.aggregated_row_buf_, micro_block_desc.aggregated_row_size_))) {
+    STORAGE_LOG(WARN, "Fail to get aggregated row", K(ret), K_(skip_index_aggregator));
+  }
+  return ret;
+}
+
+void ObMacroBlockWriter::reuse_skip_index(const ObMicroBlock &micro_block, ObMicroBlockDesc &micro_block_desc)
+{
+  if (skip_index_aggregator_.is_inited() && micro_block.micro_index_info_->has_agg_data()) {
+    micro_block_desc.aggregated_row_buf_ = micro_block.micro_index_info_->agg_row_buf_;
+    micro_block_desc.aggregated_row_size_ = micro_block.micro_index_info_->agg_buf_size_;
+  }
+}
+
 int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
 {
   int ret = OB_SUCCESS;
@@ -1491,7 +1542,7 @@ int ObMacroBlockWriter::flush_bf_to_cache(ObMacroBloomFilterCacheWriter &bf_writ
         bf_cache_writer_[1].set_not_need_build();
       }
     } else if (bf_writer.is_need_build() && bf_writer.get_row_count() == row_count) {
-      if (OB_FAIL(bf_writer.flush_to_cache(MTL_ID(), macro_handle.get_macro_id()))) {
+      if (OB_FAIL(bf_writer.flush_to_cache(MTL_ID(), data_store_desc_->tablet_id_, macro_handle.get_macro_id()))) {
         STORAGE_LOG(WARN, "bloomfilter cache writer failed flush to cache, ", K(ret), K(bf_writer));
       } else if (OB_NOT_NULL(data_store_desc_->merge_info_)) {
         data_store_desc_->merge_info_->macro_bloomfilter_count_++;
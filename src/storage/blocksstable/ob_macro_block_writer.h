@@ -18,6 +18,7 @@
 #include "lib/compress/ob_compressor.h"
 #include "lib/container/ob_array_wrap.h"
 #include "ob_block_manager.h"
+#include "ob_index_block_aggregator.h"
 #include "ob_index_block_row_struct.h"
 #include "ob_macro_block_checker.h"
 #include "ob_macro_block_reader.h"
@@ -168,6 +169,9 @@ private:
       ObMicroBlockDesc &micro_block_desc,
       ObMicroBlockHeader &header);
   int build_micro_block_desc_with_reuse(const ObMicroBlock &micro_block, ObMicroBlockDesc &micro_block_desc);
+  int eval_skip_index(const ObDatumRow &row);
+  int build_skip_index(ObMicroBlockDesc &micro_block_desc);
+  void reuse_skip_index(const ObMicroBlock &micro_block, ObMicroBlockDesc &micro_block_desc);
   int write_micro_block(ObMicroBlockDesc &micro_block_desc);
   int check_micro_block_need_merge(const ObMicroBlock &micro_block, bool &need_merge);
   int merge_micro_block(const ObMicroBlock &micro_block);
@@ -221,6 +225,7 @@ private:
   ObIMacroBlockFlushCallback *callback_;
   ObDataIndexBlockBuilder *builder_;
   ObMicroBlockAdaptiveSplitter micro_block_adaptive_splitter_;
+  ObSkipIndexAggregator skip_index_aggregator_;
 };
 
 }//end namespace blocksstable
@@ -18,6 +18,7 @@
 #include "encoding/ob_micro_block_decoder.h"
 #include "storage/blocksstable/ob_index_block_row_struct.h"
 #include "storage/blocksstable/ob_micro_block_cache.h"
+#include "storage/blocksstable/ob_micro_block_flash_cache.h"
 #include "storage/blocksstable/ob_block_manager.h"
 #include "storage/blocksstable/ob_macro_block_handle.h"
 #include "storage/blocksstable/ob_shared_macro_block_manager.h"
@@ -328,11 +329,17 @@ int ObIMicroBlockCache::get_cache_block(
     STORAGE_LOG(WARN, "get_cache failed", K(ret));
   } else {
     ObMicroBlockCacheKey key(tenant_id, block_id, offset, size);
+    ObMicroBlockFlashCache *flash_cache = ATOMIC_LOAD(&flash_cache_);
     if (OB_FAIL(cache->get(key, handle.micro_block_, handle.handle_))) {
       if (OB_ENTRY_NOT_EXIST != ret) {
         STORAGE_LOG(WARN, "Fail to get micro block from block cache, ", K(ret));
+      } else if (OB_NOT_NULL(flash_cache)
+          && OB_SUCC(flash_cache->get(key, *this, handle.micro_block_, handle.handle_))) {
+        // promoted from flash cache, no io needed
+      }
+      if (OB_FAIL(ret)) {
+        EVENT_INC(ObStatEventIds::BLOCK_CACHE_MISS);
       }
-      EVENT_INC(ObStatEventIds::BLOCK_CACHE_MISS);
     } else {
       EVENT_INC(ObStatEventIds::BLOCK_CACHE_HIT);
     }
@@ -618,6 +625,8 @@ int ObIMicroBlockCache::ObIMicroBlockIOCallback::process_block(
           }
         }
         if (OB_FAIL(ret)) {
+          // pair stays in mem block, invalidate it so that it's never demoted
+          micro_data.reset();
           handle.reset();
           micro_block = nullptr;
         }
@@ -1048,6 +1057,11 @@ int ObDataMicroBlockCache::ObMultiDataBlockIOCallback::inner_process(const bool
     allocator_->free(io_buffer_);
     io_buffer_ = nullptr;
   }
+  if (OB_NOT_NULL(allocator_) && OB_NOT_NULL(io_ctx_.micro_index_infos_)) {
+    // deep copied in inner_deep_copy, only needed to split the io buffer
+    allocator_->free(io_ctx_.micro_index_infos_);
+    io_ctx_.micro_index_infos_ = nullptr;
+  }
 
   if (OB_FAIL(ret)) {
     io_result_.ret_code_ = ret;
@@ -1116,12 +1130,20 @@ int ObDataMicroBlockCache::ObMultiDataBlockIOCallback::deep_copy_ctx(
   } else {
     void *ptr = nullptr;
     int64_t alloc_size = sizeof(ObMicroIndexInfo) * io_ctx.block_count_;
-    if (OB_ISNULL(ptr = allocator_->alloc(alloc_size))) {
+    // row headers are copied too, the index blocks they point to may be released before io done
+    const int64_t header_size = sizeof(ObIndexBlockRowHeader) * io_ctx.block_count_;
+    if (OB_ISNULL(ptr = allocator_->alloc(alloc_size + header_size))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
-      LOG_WARN("alloc memory failed", K(ret), K(alloc_size));
+      LOG_WARN("alloc memory failed", K(ret), K(alloc_size), K(header_size));
     } else {
       io_ctx_.micro_index_infos_ = reinterpret_cast<ObMicroIndexInfo *>(ptr);
       MEMCPY(io_ctx_.micro_index_infos_, io_ctx.micro_index_infos_, alloc_size);
+      ObIndexBlockRowHeader *row_headers = reinterpret_cast<ObIndexBlockRowHeader *>(
+          static_cast<char *>(ptr) + alloc_size);
+      for (int64_t i = 0; i < io_ctx.block_count_; ++i) {
+        MEMCPY(&row_headers[i], io_ctx.micro_index_infos_[i].row_header_, sizeof(ObIndexBlockRowHeader));
+        io_ctx_.micro_index_infos_[i].row_header_ = &row_headers[i];
+      }
     }
 
     if (OB_SUCC(ret)) {
@@ -48,6 +48,7 @@ public:
            const MacroBlockId &block_id,
            const int64_t offset,
            const int64_t size);
+  inline const ObMicroBlockId &get_micro_block_id() const { return block_id_; }
   TO_STRING_KV(K_(tenant_id), K_(block_id));
 private:
   uint64_t tenant_id_;
@@ -141,10 +142,15 @@ public:
   virtual int add_put_size(const int64_t put_size) = 0;
 };
 
+class ObMicroBlockFlashCache;
+
 class ObIMicroBlockCache : public ObIPutSizeStat
 {
 public:
   typedef common::ObIKVCache<ObMicroBlockCacheKey, ObMicroBlockCacheValue> BaseBlockCache;
+  ObIMicroBlockCache() : flash_cache_(nullptr) {}
+  // blocks missed in memory are looked up in @flash_cache before macro block io
+  void set_flash_cache(ObMicroBlockFlashCache *flash_cache) { ATOMIC_STORE(&flash_cache_, flash_cache); }
   int get_cache_block(
       const uint64_t tenant_id,
       const MacroBlockId block_id,
@@ -246,6 +252,8 @@ protected:
       const ObQueryFlag &flag,
       ObMacroBlockHandle &macro_handle,
       ObIMicroBlockIOCallback &callback);
+protected:
+  ObMicroBlockFlashCache *flash_cache_;
 };
 
 class ObDataMicroBlockCache
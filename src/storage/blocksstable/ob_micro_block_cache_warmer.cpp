@@ -0,0 +1,815 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <algorithm>
+#include "lib/checksum/ob_crc64.h"
+#include "lib/file/file_directory_utils.h"
+#include "lib/thread/ob_thread_name.h"
+#include "lib/utility/ob_utility.h"
+#include "share/config/ob_server_config.h"
+#include "storage/blocksstable/ob_block_manager.h"
+#include "storage/blocksstable/ob_macro_block_common_header.h"
+#include "storage/blocksstable/ob_macro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_header.h"
+#include "storage/blocksstable/ob_micro_block_cache_warmer.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+/*-----------------------------------ObMicroBlockCacheManifestHeader------------------------------------*/
+ObMicroBlockCacheManifestHeader::ObMicroBlockCacheManifestHeader()
+  : magic_(MANIFEST_MAGIC),
+    version_(MANIFEST_VERSION),
+    index_entry_cnt_(0),
+    data_entry_cnt_(0),
+    bf_entry_cnt_(0),
+    bf_data_size_(0),
+    checksum_(0),
+    create_ts_(0)
+{
+}
+
+bool ObMicroBlockCacheManifestHeader::is_valid() const
+{
+  return MANIFEST_MAGIC == magic_
+      && MANIFEST_VERSION == version_
+      && index_entry_cnt_ >= 0
+      && data_entry_cnt_ >= 0
+      && bf_entry_cnt_ >= 0
+      && bf_data_size_ >= 0;
+}
+
+/*-----------------------------------ObMicroBlockCacheManifestEntry-------------------------------------*/
+ObMicroBlockCacheManifestEntry::ObMicroBlockCacheManifestEntry()
+  : tenant_id_(OB_INVALID_TENANT_ID),
+    offset_(0),
+    size_(0),
+    data_checksum_(0)
+{
+  macro_id_[0] = 0;
+  macro_id_[1] = 0;
+  macro_id_[2] = 0;
+}
+
+ObMicroBlockCacheManifestEntry::ObMicroBlockCacheManifestEntry(
+    const ObMicroBlockCacheKey &key,
+    const int64_t data_checksum)
+  : tenant_id_(key.get_tenant_id()),
+    offset_(key.get_micro_block_id().offset_),
+    size_(key.get_micro_block_id().size_),
+    data_checksum_(data_checksum)
+{
+  const MacroBlockId &macro_id = key.get_micro_block_id().macro_id_;
+  macro_id_[0] = macro_id.first_id();
+  macro_id_[1] = macro_id.second_id();
+  macro_id_[2] = macro_id.third_id();
+}
+
+bool ObMicroBlockCacheManifestEntry::is_valid() const
+{
+  return OB_INVALID_TENANT_ID != tenant_id_
+      && get_macro_id().is_valid()
+      && offset_ > 0
+      && size_ > 0;
+}
+
+bool ObMicroBlockCacheManifestEntry::operator <(const ObMicroBlockCacheManifestEntry &other) const
+{
+  const MacroBlockId macro_id = get_macro_id();
+  const MacroBlockId other_macro_id = other.get_macro_id();
+  return macro_id < other_macro_id || (macro_id == other_macro_id && offset_ < other.offset_);
+}
+
+/*-------------------------------------ObBloomFilterManifestEntry--------------------------------------*/
+ObBloomFilterManifestEntry::ObBloomFilterManifestEntry()
+  : tenant_id_(OB_INVALID_TENANT_ID),
+    macro_data_checksum_(0),
+    value_size_(0)
+{
+  macro_id_[0] = 0;
+  macro_id_[1] = 0;
+  macro_id_[2] = 0;
+}
+
+ObBloomFilterManifestEntry::ObBloomFilterManifestEntry(
+    const ObBloomFilterCacheKey &key,
+    const int64_t value_size)
+  : tenant_id_(key.get_tenant_id()),
+    macro_data_checksum_(0),
+    value_size_(value_size)
+{
+  const MacroBlockId &macro_id = key.get_macro_block_id();
+  macro_id_[0] = macro_id.first_id();
+  macro_id_[1] = macro_id.second_id();
+  macro_id_[2] = macro_id.third_id();
+}
+
+bool ObBloomFilterManifestEntry::is_valid() const
+{
+  return OB_INVALID_TENANT_ID != tenant_id_
+      && get_macro_id().is_valid()
+      && value_size_ > 0;
+}
+
+/*-------------------------------------ObMicroBlockCacheWarmer-----------------------------------------*/
+int ObMicroBlockCacheWarmer::HotKeyCollector::visit(
+    const ObIKVCacheKey &key,
+    const ObIKVCacheValue &value)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockCacheKey &block_key = static_cast<const ObMicroBlockCacheKey &>(key);
+  const ObMicroBlockData &block_data
+      = static_cast<const ObMicroBlockCacheValue &>(value).get_block_data();
+  ObMicroBlockHeader header;
+  int64_t pos = 0;
+  if (!block_data.is_valid()) {
+    // skip
+  } else if (OB_SUCCESS != header.deserialize(block_data.get_buf(), block_data.get_buf_size(), pos)) {
+    // skip
+  } else if (OB_FAIL(entries_.push_back(ObMicroBlockCacheManifestEntry(block_key, header.data_checksum_)))) {
+    LOG_WARN("fail to push back manifest entry", K(ret), K(block_key));
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::HotBloomFilterCollector::visit(
+    const ObIKVCacheKey &key,
+    const ObIKVCacheValue &value)
+{
+  int ret = OB_SUCCESS;
+  const ObBloomFilterCacheKey &bf_key = static_cast<const ObBloomFilterCacheKey &>(key);
+  const ObBloomFilterCacheValue &bf_value = static_cast<const ObBloomFilterCacheValue &>(value);
+  const int64_t value_size = bf_value.get_serialize_size();
+  const int64_t pair_size = sizeof(ObBloomFilterManifestEntry) + value_size;
+  char *buf = nullptr;
+  int64_t pos = sizeof(ObBloomFilterManifestEntry);
+  if (!bf_value.is_valid() || bf_value.is_empty()) {
+    // skip
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator_.alloc(pair_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate bloom filter buf", K(ret), K(pair_size));
+  } else if (OB_FAIL(bf_value.serialize(buf, pair_size, pos))) {
+    LOG_WARN("fail to serialize bloom filter", K(ret), K(bf_key));
+  } else {
+    new (buf) ObBloomFilterManifestEntry(bf_key, value_size);
+    if (OB_FAIL(values_.push_back(ObString(pair_size, buf)))) {
+      LOG_WARN("fail to push back bloom filter", K(ret), K(bf_key));
+    }
+  }
+  return ret;
+}
+
+ObMicroBlockCacheWarmer::ObMicroBlockCacheWarmer()
+  : is_inited_(false),
+    index_block_cache_(nullptr),
+    user_block_cache_(nullptr),
+    bf_cache_(nullptr),
+    cond_(),
+    warm_up_done_(false),
+    load_cnt_(0),
+    skip_cnt_(0),
+    load_size_(0),
+    bf_load_cnt_(0),
+    io_size_(0)
+{
+  manifest_path_[0] = '\0';
+}
+
+ObMicroBlockCacheWarmer::~ObMicroBlockCacheWarmer()
+{
+  destroy();
+}
+
+int ObMicroBlockCacheWarmer::init(
+    const char *manifest_path,
+    ObIndexMicroBlockCache &index_block_cache,
+    ObDataMicroBlockCache &user_block_cache,
+    ObBloomFilterCache &bf_cache)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("micro block cache warmer init twice", K(ret));
+  } else if (OB_ISNULL(manifest_path) || OB_UNLIKELY(0 == STRLEN(manifest_path))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(manifest_path));
+  } else if (OB_FAIL(databuff_printf(manifest_path_, sizeof(manifest_path_), "%s", manifest_path))) {
+    LOG_WARN("fail to copy manifest path", K(ret), K(manifest_path));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("fail to init thread cond", K(ret));
+  } else {
+    index_block_cache_ = &index_block_cache;
+    user_block_cache_ = &user_block_cache;
+    bf_cache_ = &bf_cache;
+    warm_up_done_ = false;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::start()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block cache warmer not init", K(ret));
+  } else if (OB_FAIL(share::ObThreadPool::start())) {
+    LOG_WARN("fail to start micro block cache warmer", K(ret));
+  }
+  return ret;
+}
+
+void ObMicroBlockCacheWarmer::stop()
+{
+  share::ObThreadPool::stop();
+  if (is_inited_) {
+    ObThreadCondGuard guard(cond_);
+    cond_.signal();
+  }
+}
+
+void ObMicroBlockCacheWarmer::wait()
+{
+  share::ObThreadPool::wait();
+}
+
+void ObMicroBlockCacheWarmer::destroy()
+{
+  if (is_inited_) {
+    stop();
+    wait();
+    cond_.destroy();
+  }
+  is_inited_ = false;
+  index_block_cache_ = nullptr;
+  user_block_cache_ = nullptr;
+  bf_cache_ = nullptr;
+  manifest_path_[0] = '\0';
+}
+
+void ObMicroBlockCacheWarmer::run1()
+{
+  int ret = OB_SUCCESS;
+  lib::set_thread_name("MicroCacheWarmer");
+  if (OB_FAIL(warm_up())) {
+    LOG_WARN("fail to warm up micro block cache", K(ret));
+  }
+  int64_t last_dump_ts = ObTimeUtility::current_time();
+  while (!has_set_stop()) {
+    {
+      ObThreadCondGuard guard(cond_);
+      if (!has_set_stop()) {
+        cond_.wait(CHECK_INTERVAL_MS);
+      }
+    }
+    const int64_t now = ObTimeUtility::current_time();
+    if (!has_set_stop() && now - last_dump_ts >= GCONF._micro_block_cache_manifest_interval) {
+      if (OB_FAIL(dump_manifest())) {
+        LOG_WARN("fail to dump micro block cache manifest", K(ret));
+      }
+      last_dump_ts = now;
+    }
+  }
+  // record the latest hot blocks before shutdown
+  if (OB_FAIL(dump_manifest())) {
+    LOG_WARN("fail to dump micro block cache manifest", K(ret));
+  }
+}
+
+int ObMicroBlockCacheWarmer::dump_manifest()
+{
+  int ret = OB_SUCCESS;
+  const int64_t max_size = GCONF._micro_block_cache_manifest_size;
+  const int64_t start_ts = ObTimeUtility::current_time();
+  EntryArray index_entries;
+  EntryArray data_entries;
+  BloomFilters bloom_filters;
+  ObArray<ObString> bf_pairs;
+  HotKeyCollector index_collector(index_entries);
+  HotKeyCollector data_collector(data_entries);
+  HotBloomFilterCollector bf_collector(bf_pairs, bloom_filters.allocator_);
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block cache warmer not init", K(ret));
+  } else if (0 == max_size || !warm_up_done_) {
+    // disabled, or keep the old manifest until it's consumed
+  } else if (OB_FAIL(index_block_cache_->visit_hot_pairs(max_size, index_collector))) {
+    LOG_WARN("fail to collect hot index blocks", K(ret), K(max_size));
+  } else if (OB_FAIL(user_block_cache_->visit_hot_pairs(max_size, data_collector))) {
+    LOG_WARN("fail to collect hot data blocks", K(ret), K(max_size));
+  } else if (OB_FAIL(bf_cache_->visit_hot_pairs(max_size, bf_collector))) {
+    LOG_WARN("fail to collect hot bloom filters", K(ret), K(max_size));
+  } else if (OB_FAIL(build_bloom_filters(bf_pairs, bloom_filters))) {
+    LOG_WARN("fail to build bloom filter entries", K(ret));
+  } else if (OB_FAIL(write_manifest(index_entries, data_entries, bloom_filters))) {
+    LOG_WARN("fail to write manifest", K(ret), K_(manifest_path));
+  } else {
+    LOG_INFO("succeed to dump micro block cache manifest", K_(manifest_path), K(max_size),
+        "index_entry_cnt", index_entries.count(), "data_entry_cnt", data_entries.count(),
+        "bf_entry_cnt", bloom_filters.entries_.count(),
+        "cost_us", ObTimeUtility::current_time() - start_ts);
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::build_bloom_filters(
+    const ObIArray<ObString> &pairs,
+    BloomFilters &bloom_filters)
+{
+  int ret = OB_SUCCESS;
+  int64_t total_size = 0;
+  for (int64_t i = 0; i < pairs.count(); ++i) {
+    total_size += pairs.at(i).length() - sizeof(ObBloomFilterManifestEntry);
+  }
+  if (0 == total_size) {
+  } else if (OB_ISNULL(bloom_filters.data_ = static_cast<char *>(bloom_filters.allocator_.alloc(total_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate bloom filter data", K(ret), K(total_size));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < pairs.count(); ++i) {
+    // bloom filters are built from all rows of a macro block, only the macro block id is in the
+    // key, which may be reused after restart, so the macro block checksum is checked on warm up
+    ObBloomFilterManifestEntry entry = *reinterpret_cast<const ObBloomFilterManifestEntry *>(pairs.at(i).ptr());
+    const char *value_buf = pairs.at(i).ptr() + sizeof(ObBloomFilterManifestEntry);
+    const MacroBlockId macro_id = entry.get_macro_id();
+    bool is_free = true;
+    ObSSTableMacroBlockHeader macro_header;
+    if (OB_FAIL(OB_SERVER_BLOCK_MGR.check_macro_block_free(macro_id, is_free))) {
+      LOG_WARN("fail to check macro block free", K(ret), K(macro_id));
+    } else if (is_free) {
+    } else if (OB_FAIL(read_macro_header(macro_id, macro_header))) {
+      LOG_WARN("fail to read macro block header", K(ret), K(macro_id));
+    } else if (FALSE_IT(entry.macro_data_checksum_ = macro_header.fixed_header_.data_checksum_)) {
+    } else if (OB_FAIL(bloom_filters.entries_.push_back(entry))) {
+      LOG_WARN("fail to push back bloom filter entry", K(ret), K(entry));
+    } else {
+      MEMCPY(bloom_filters.data_ + bloom_filters.data_size_, value_buf, entry.value_size_);
+      bloom_filters.data_size_ += entry.value_size_;
+    }
+    // a broken macro block only drops its bloom filter
+    if (OB_FAIL(ret) && OB_ALLOCATE_MEMORY_FAILED != ret) {
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::write_manifest(
+    const EntryArray &index_entries,
+    const EntryArray &data_entries,
+    const BloomFilters &bloom_filters)
+{
+  int ret = OB_SUCCESS;
+  char tmp_path[OB_MAX_FILE_NAME_LENGTH] = {0};
+  ObMicroBlockCacheManifestHeader header;
+  const int64_t entry_size = sizeof(ObMicroBlockCacheManifestEntry);
+  const int64_t index_size = index_entries.count() * entry_size;
+  const int64_t data_size = data_entries.count() * entry_size;
+  const int64_t bf_size = bloom_filters.entries_.count() * sizeof(ObBloomFilterManifestEntry);
+  const int64_t bf_data_offset = sizeof(header) + index_size + data_size + bf_size;
+  int fd = -1;
+  header.index_entry_cnt_ = index_entries.count();
+  header.data_entry_cnt_ = data_entries.count();
+  header.bf_entry_cnt_ = bloom_filters.entries_.count();
+  header.bf_data_size_ = bloom_filters.data_size_;
+  header.create_ts_ = ObTimeUtility::current_time();
+  if (index_size > 0) {
+    header.checksum_ = static_cast<int64_t>(ob_crc64(header.checksum_, &index_entries.at(0), index_size));
+  }
+  if (data_size > 0) {
+    header.checksum_ = static_cast<int64_t>(ob_crc64(header.checksum_, &data_entries.at(0), data_size));
+  }
+  if (bf_size > 0) {
+    header.checksum_ = static_cast<int64_t>(ob_crc64(header.checksum_, &bloom_filters.entries_.at(0), bf_size));
+    header.checksum_ = static_cast<int64_t>(ob_crc64(header.checksum_, bloom_filters.data_, bloom_filters.data_size_));
+  }
+
+  // write a temp file and rename it, so that the manifest is never torn
+  if (OB_FAIL(databuff_printf(tmp_path, sizeof(tmp_path), "%s.tmp", manifest_path_))) {
+    LOG_WARN("fail to build temp manifest path", K(ret), K_(manifest_path));
+  } else if ((fd = ::open(tmp_path, O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, S_IRUSR | S_IWUSR)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open manifest file", K(ret), K(tmp_path), K(errno));
+  } else if (sizeof(header) != ob_pwrite(fd, reinterpret_cast<const char *>(&header), sizeof(header), 0)
+      || (index_size > 0 && index_size != ob_pwrite(
+          fd, reinterpret_cast<const char *>(&index_entries.at(0)), index_size, sizeof(header)))
+      || (data_size > 0 && data_size != ob_pwrite(
+          fd, reinterpret_cast<const char *>(&data_entries.at(0)), data_size, sizeof(header) + index_size))
+      || (bf_size > 0 && bf_size != ob_pwrite(
+          fd, reinterpret_cast<const char *>(&bloom_filters.entries_.at(0)), bf_size,
+          sizeof(header) + index_size + data_size))
+      || (bloom_filters.data_size_ > 0 && bloom_filters.data_size_ != ob_pwrite(
+          fd, bloom_filters.data_, bloom_filters.data_size_, bf_data_offset))) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to write manifest file", K(ret), K(tmp_path), K(errno));
+  } else if (0 != ::fsync(fd)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to fsync manifest file", K(ret), K(tmp_path), K(errno));
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  if (OB_FAIL(ret)) {
+  } else if (0 != ::rename(tmp_path, manifest_path_)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to rename manifest file", K(ret), K(tmp_path), K_(manifest_path), K(errno));
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::read_manifest(
+    EntryArray &index_entries,
+    EntryArray &data_entries,
+    BloomFilters &bloom_filters)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockCacheManifestHeader header;
+  const int64_t entry_size = sizeof(ObMicroBlockCacheManifestEntry);
+  int64_t file_size = 0;
+  int fd = -1;
+  if (OB_FAIL(FileDirectoryUtils::get_file_size(manifest_path_, file_size))) {
+    LOG_WARN("fail to get manifest file size", K(ret), K_(manifest_path));
+  } else if ((fd = ::open(manifest_path_, O_RDONLY | O_CLOEXEC)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open manifest file", K(ret), K_(manifest_path), K(errno));
+  } else if (sizeof(header) != ob_pread(fd, reinterpret_cast<char *>(&header), sizeof(header), 0)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to read manifest header", K(ret), K_(manifest_path), K(errno));
+  } else if (OB_UNLIKELY(!header.is_valid()
+      || static_cast<int64_t>(sizeof(header))
+          + (header.index_entry_cnt_ + header.data_entry_cnt_) * entry_size
+          + header.bf_entry_cnt_ * static_cast<int64_t>(sizeof(ObBloomFilterManifestEntry))
+          + header.bf_data_size_ != file_size)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid manifest header", K(ret), K(header), K(file_size));
+  } else if (OB_FAIL(index_entries.prepare_allocate(header.index_entry_cnt_))) {
+    LOG_WARN("fail to allocate index entries", K(ret), K(header));
+  } else if (OB_FAIL(data_entries.prepare_allocate(header.data_entry_cnt_))) {
+    LOG_WARN("fail to allocate data entries", K(ret), K(header));
+  } else if (OB_FAIL(bloom_filters.entries_.prepare_allocate(header.bf_entry_cnt_))) {
+    LOG_WARN("fail to allocate bloom filter entries", K(ret), K(header));
+  } else if (header.bf_data_size_ > 0 && OB_ISNULL(bloom_filters.data_
+      = static_cast<char *>(bloom_filters.allocator_.alloc(header.bf_data_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate bloom filter data", K(ret), K(header));
+  } else {
+    const int64_t index_size = header.index_entry_cnt_ * entry_size;
+    const int64_t data_size = header.data_entry_cnt_ * entry_size;
+    const int64_t bf_size = header.bf_entry_cnt_ * sizeof(ObBloomFilterManifestEntry);
+    const int64_t bf_data_offset = sizeof(header) + index_size + data_size + bf_size;
+    int64_t checksum = 0;
+    bloom_filters.data_size_ = header.bf_data_size_;
+    if ((index_size > 0 && index_size != ob_pread(
+            fd, reinterpret_cast<char *>(&index_entries.at(0)), index_size, sizeof(header)))
+        || (data_size > 0 && data_size != ob_pread(
+            fd, reinterpret_cast<char *>(&data_entries.at(0)), data_size, sizeof(header) + index_size))
+        || (bf_size > 0 && bf_size != ob_pread(
+            fd, reinterpret_cast<char *>(&bloom_filters.entries_.at(0)), bf_size,
+            sizeof(header) + index_size + data_size))
+        || (bloom_filters.data_size_ > 0 && bloom_filters.data_size_ != ob_pread(
+            fd, bloom_filters.data_, bloom_filters.data_size_, bf_data_offset))) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to read manifest entries", K(ret), K_(manifest_path), K(errno));
+    } else {
+      if (index_size > 0) {
+        checksum = static_cast<int64_t>(ob_crc64(checksum, &index_entries.at(0), index_size));
+      }
+      if (data_size > 0) {
+        checksum = static_cast<int64_t>(ob_crc64(checksum, &data_entries.at(0), data_size));
+      }
+      if (bf_size > 0) {
+        checksum = static_cast<int64_t>(ob_crc64(checksum, &bloom_filters.entries_.at(0), bf_size));
+        checksum = static_cast<int64_t>(ob_crc64(checksum, bloom_filters.data_, bloom_filters.data_size_));
+      }
+      if (OB_UNLIKELY(checksum != header.checksum_)) {
+        ret = OB_CHECKSUM_ERROR;
+        LOG_WARN("manifest checksum mismatch", K(ret), K(checksum), K(header));
+      }
+    }
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::warm_up()
+{
+  int ret = OB_SUCCESS;
+  bool exist = false;
+  const int64_t start_ts = ObTimeUtility::current_time();
+  EntryArray index_entries;
+  EntryArray data_entries;
+  BloomFilters bloom_filters;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block cache warmer not init", K(ret));
+  } else if (0 == GCONF._micro_block_cache_manifest_size) {
+    // disabled
+  } else if (OB_FAIL(FileDirectoryUtils::is_exists(manifest_path_, exist))) {
+    LOG_WARN("fail to check manifest existence", K(ret), K_(manifest_path));
+  } else if (!exist) {
+    LOG_INFO("no micro block cache manifest, skip warm up", K_(manifest_path));
+  } else if (OB_FAIL(read_manifest(index_entries, data_entries, bloom_filters))) {
+    LOG_WARN("fail to read manifest, skip warm up", K(ret), K_(manifest_path));
+  } else if (OB_FAIL(warm_up_blocks(
+      *index_block_cache_, ObMicroBlockData::INDEX_BLOCK, start_ts, index_entries))) {
+    LOG_WARN("fail to warm up index block cache", K(ret));
+  } else if (OB_FAIL(warm_up_blocks(
+      *user_block_cache_, ObMicroBlockData::DATA_BLOCK, start_ts, data_entries))) {
+    LOG_WARN("fail to warm up user block cache", K(ret));
+  } else if (OB_FAIL(warm_up_bloom_filters(start_ts, bloom_filters))) {
+    LOG_WARN("fail to warm up bloom filter cache", K(ret));
+  } else {
+    LOG_INFO("finish warming up micro block cache", K(*this),
+        "index_entry_cnt", index_entries.count(), "data_entry_cnt", data_entries.count(),
+        "bf_entry_cnt", bloom_filters.entries_.count(),
+        "cost_us", ObTimeUtility::current_time() - start_ts);
+  }
+  warm_up_done_ = !has_set_stop();
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::warm_up_blocks(
+    ObIMicroBlockCache &block_cache,
+    const ObMicroBlockData::Type block_type,
+    const int64_t start_ts,
+    EntryArray &entries)
+{
+  int ret = OB_SUCCESS;
+  ObMacroBlockReader reader;
+  if (entries.count() > 0) {
+    std::sort(&entries.at(0), &entries.at(0) + entries.count());
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < entries.count() && !has_set_stop();) {
+    const MacroBlockId macro_id = entries.at(i).get_macro_id();
+    int64_t macro_end = i + 1;
+    while (macro_end < entries.count() && entries.at(macro_end).get_macro_id() == macro_id) {
+      ++macro_end;
+    }
+    bool is_free = true;
+    ObSSTableMacroBlockHeader macro_header;
+    if (!entries.at(i).is_valid()) {
+      skip_cnt_ += macro_end - i;
+    } else if (OB_FAIL(OB_SERVER_BLOCK_MGR.check_macro_block_free(macro_id, is_free))) {
+      LOG_WARN("fail to check macro block free", K(ret), K(macro_id));
+    } else if (is_free) {
+      skip_cnt_ += macro_end - i;
+    } else if (OB_FAIL(read_macro_header(macro_id, macro_header))) {
+      LOG_WARN("fail to read macro block header", K(ret), K(macro_id));
+    } else {
+      const ObMicroBlockDesMeta des_meta(
+          macro_header.fixed_header_.compressor_type_,
+          macro_header.fixed_header_.encrypt_id_,
+          macro_header.fixed_header_.master_key_id_,
+          macro_header.fixed_header_.encrypt_key_);
+      for (int64_t start = i; OB_SUCC(ret) && start < macro_end && !has_set_stop();) {
+        int64_t end = start + 1;
+        while (end < macro_end
+            && entries.at(end).offset_ - (entries.at(end - 1).offset_ + entries.at(end - 1).size_) <= MAX_MERGE_GAP
+            && entries.at(end).offset_ + entries.at(end).size_ - entries.at(start).offset_ <= MAX_MERGE_IO_SIZE) {
+          ++end;
+        }
+        if (OB_FAIL(load_blocks(block_cache, block_type, des_meta, entries, start, end, reader))) {
+          LOG_WARN("fail to load micro blocks", K(ret), K(macro_id), K(start), K(end));
+        }
+        throttle(start_ts);
+        start = end;
+      }
+    }
+    // a broken macro block never stops warm up
+    if (OB_FAIL(ret)) {
+      skip_cnt_ += macro_end - i;
+      ret = OB_SUCCESS;
+    }
+    i = macro_end;
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::warm_up_bloom_filters(
+    const int64_t start_ts,
+    const BloomFilters &bloom_filters)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < bloom_filters.entries_.count() && !has_set_stop(); ++i) {
+    const ObBloomFilterManifestEntry &entry = bloom_filters.entries_.at(i);
+    const MacroBlockId macro_id = entry.get_macro_id();
+    bool is_free = true;
+    ObSSTableMacroBlockHeader macro_header;
+    ObBloomFilterCacheValue bf_value;
+    int64_t value_pos = pos;
+    if (OB_UNLIKELY(!entry.is_valid() || pos + entry.value_size_ > bloom_filters.data_size_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid bloom filter entry", K(ret), K(entry), K(pos), K(bloom_filters.data_size_));
+    } else if (OB_FAIL(OB_SERVER_BLOCK_MGR.check_macro_block_free(macro_id, is_free))) {
+      LOG_WARN("fail to check macro block free", K(ret), K(macro_id));
+    } else if (is_free) {
+      ++skip_cnt_;
+    } else if (OB_FAIL(read_macro_header(macro_id, macro_header))) {
+      LOG_WARN("fail to read macro block header", K(ret), K(macro_id));
+    } else if (macro_header.fixed_header_.data_checksum_ != entry.macro_data_checksum_) {
+      // macro block id is reused by another macro block
+      ++skip_cnt_;
+    } else if (OB_FAIL(bf_value.deserialize(bloom_filters.data_, pos + entry.value_size_, value_pos))) {
+      LOG_WARN("fail to deserialize bloom filter", K(ret), K(entry));
+    } else if (OB_FAIL(bf_cache_->put_bloom_filter(
+        entry.tenant_id_, ObTabletID(macro_header.fixed_header_.tablet_id_), macro_id, bf_value))) {
+      LOG_WARN("fail to put bloom filter", K(ret), K(entry));
+    } else {
+      ++bf_load_cnt_;
+    }
+    if (OB_FAIL(ret) && OB_INVALID_DATA != ret) {
+      ++skip_cnt_;
+      ret = OB_SUCCESS;
+    }
+    pos += entry.value_size_;
+    throttle(start_ts);
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::read_macro_header(
+    const MacroBlockId &macro_id,
+    ObSSTableMacroBlockHeader &macro_header)
+{
+  int ret = OB_SUCCESS;
+  ObMacroBlockReadInfo read_info;
+  ObMacroBlockHandle macro_handle;
+  ObMacroBlockCommonHeader common_header;
+  int64_t pos = 0;
+  read_info.macro_block_id_ = macro_id;
+  read_info.offset_ = 0;
+  read_info.size_ = MACRO_HEADER_READ_SIZE;
+  read_info.io_desc_.set_category(ObIOCategory::PREWARM_IO);
+  read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  if (OB_FAIL(ObBlockManager::read_block(read_info, macro_handle))) {
+    LOG_WARN("fail to read macro block header", K(ret), K(read_info));
+  } else if (FALSE_IT(io_size_ += read_info.size_)) {
+  } else if (OB_FAIL(common_header.deserialize(
+      macro_handle.get_buffer(), macro_handle.get_data_size(), pos))) {
+    LOG_WARN("fail to deserialize common header", K(ret), K(macro_id));
+  } else if (OB_UNLIKELY(!common_header.is_sstable_data_block()
+      && !common_header.is_sstable_index_block())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("not sstable macro block", K(ret), K(macro_id), K(common_header));
+  } else if (OB_UNLIKELY(pos + ObSSTableMacroBlockHeader::get_fixed_header_size()
+      > macro_handle.get_data_size())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("macro block header is not read", K(ret), K(pos), K(macro_handle.get_data_size()));
+  } else {
+    // only the fixed part of sstable macro header is needed to deserialize micro blocks
+    MEMCPY(&macro_header.fixed_header_, macro_handle.get_buffer() + pos,
+        ObSSTableMacroBlockHeader::get_fixed_header_size());
+    if (OB_UNLIKELY(!macro_header.fixed_header_.is_valid())) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid macro block header", K(ret), K(macro_id), "fixed_header", macro_header.fixed_header_);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::load_blocks(
+    ObIMicroBlockCache &block_cache,
+    const ObMicroBlockData::Type block_type,
+    const ObMicroBlockDesMeta &des_meta,
+    const EntryArray &entries,
+    const int64_t start_idx,
+    const int64_t end_idx,
+    ObMacroBlockReader &reader)
+{
+  int ret = OB_SUCCESS;
+  ObMacroBlockReadInfo read_info;
+  ObMacroBlockHandle macro_handle;
+  const ObMicroBlockCacheManifestEntry &first = entries.at(start_idx);
+  const ObMicroBlockCacheManifestEntry &last = entries.at(end_idx - 1);
+  read_info.macro_block_id_ = first.get_macro_id();
+  read_info.offset_ = first.offset_;
+  read_info.size_ = last.offset_ + last.size_ - first.offset_;
+  read_info.io_desc_.set_category(ObIOCategory::PREWARM_IO);
+  read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  if (OB_FAIL(ObBlockManager::read_block(read_info, macro_handle))) {
+    LOG_WARN("fail to read micro blocks", K(ret), K(read_info));
+  } else {
+    io_size_ += read_info.size_;
+    for (int64_t i = start_idx; i < end_idx; ++i) {
+      const ObMicroBlockCacheManifestEntry &entry = entries.at(i);
+      int tmp_ret = OB_SUCCESS;
+      if (OB_UNLIKELY(entry.offset_ + entry.size_ > read_info.offset_ + macro_handle.get_data_size())) {
+        ++skip_cnt_;
+      } else if (OB_SUCCESS != (tmp_ret = load_block(block_cache, block_type, des_meta, entry,
+          macro_handle.get_buffer() + entry.offset_ - read_info.offset_, reader))) {
+        ++skip_cnt_;
+        LOG_DEBUG("fail to load micro block", K(tmp_ret), K(entry));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmer::load_block(
+    ObIMicroBlockCache &block_cache,
+    const ObMicroBlockData::Type block_type,
+    const ObMicroBlockDesMeta &des_meta,
+    const ObMicroBlockCacheManifestEntry &entry,
+    const char *buf,
+    ObMacroBlockReader &reader)
+{
+  int ret = OB_SUCCESS;
+  ObIMicroBlockCache::BaseBlockCache *cache = nullptr;
+  const ObMicroBlockCacheValue *value = nullptr;
+  ObKVCacheHandle handle;
+  ObMicroBlockHeader header;
+  int64_t pos = 0;
+  const char *uncomp_buf = nullptr;
+  int64_t uncomp_size = 0;
+  bool is_compressed = false;
+  const ObMicroBlockCacheKey key(entry.tenant_id_, entry.get_macro_id(), entry.offset_, entry.size_);
+  if (OB_FAIL(block_cache.get_cache(cache))) {
+    LOG_WARN("fail to get block cache", K(ret));
+  } else if (OB_SUCC(cache->get(key, value, handle))) {
+    // already cached
+  } else if (OB_ENTRY_NOT_EXIST != ret) {
+    LOG_WARN("fail to get micro block from cache", K(ret), K(key));
+  } else if (OB_FAIL(header.deserialize(buf, entry.size_, pos))) {
+    LOG_WARN("fail to deserialize micro block header", K(ret), K(entry));
+  } else if (OB_UNLIKELY(header.data_checksum_ != entry.data_checksum_)) {
+    // macro block was rewritten since the manifest was made
+    ret = OB_INVALID_DATA;
+  } else if (OB_FAIL(header.check_record(buf, entry.size_, MICRO_BLOCK_HEADER_MAGIC))) {
+    LOG_WARN("micro block data is corrupted", K(ret), K(entry));
+  } else if (OB_FAIL(reader.decrypt_and_decompress_data(
+      des_meta, buf, entry.size_, uncomp_buf, uncomp_size, is_compressed))) {
+    LOG_WARN("fail to decrypt and decompress micro block", K(ret), K(entry));
+  } else {
+    ObKVCachePair *kvpair = nullptr;
+    ObKVCacheInstHandle inst_handle;
+    const bool overwrite = false;
+    if (OB_FAIL(cache->alloc(
+        entry.tenant_id_,
+        sizeof(ObMicroBlockCacheKey),
+        sizeof(ObMicroBlockCacheValue) + uncomp_size,
+        kvpair,
+        handle,
+        inst_handle))) {
+      LOG_WARN("fail to alloc cache buf", K(ret), K(entry), K(uncomp_size));
+    } else {
+      char *block_buf = reinterpret_cast<char *>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
+      MEMCPY(block_buf, uncomp_buf, uncomp_size);
+      new (kvpair->key_) ObMicroBlockCacheKey(key);
+      ObMicroBlockCacheValue *cache_value
+          = new (kvpair->value_) ObMicroBlockCacheValue(block_buf, uncomp_size);
+      cache_value->get_block_data().type_ = block_type;
+      if (OB_FAIL(cache->put_kvpair(inst_handle, kvpair, handle, overwrite))) {
+        if (OB_ENTRY_EXIST != ret) {
+          LOG_WARN("fail to put micro block cache", K(ret), K(key));
+        } else {
+          ret = OB_SUCCESS;
+        }
+      } else {
+        const int64_t put_size = ObKVStoreMemBlock::get_align_size(key, *cache_value);
+        if (OB_FAIL(block_cache.add_put_size(put_size))) {
+          LOG_WARN("add_put_size failed", K(ret), K(put_size));
+        } else {
+          ++load_cnt_;
+          load_size_ += uncomp_size;
+        }
+      }
+      if (OB_FAIL(ret)) {
+        cache_value->get_block_data().reset();
+      }
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockCacheWarmer::throttle(const int64_t start_ts)
+{
+  const int64_t bandwidth = MAX(1, GCONF._micro_block_cache_warm_up_bandwidth.get_value());
+  const int64_t expect_ts = start_ts + io_size_ / bandwidth * 1000000 + io_size_ % bandwidth * 1000000 / bandwidth;
+  int64_t now = ObTimeUtility::current_time();
+  while (!has_set_stop() && now < expect_ts) {
+    ob_usleep(static_cast<uint32_t>(MIN(expect_ts - now, CHECK_INTERVAL_MS * 1000 / 10)));
+    now = ObTimeUtility::current_time();
+  }
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
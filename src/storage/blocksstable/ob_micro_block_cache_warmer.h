@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_CACHE_WARMER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_CACHE_WARMER_H_
+
+#include "lib/container/ob_array.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "share/ob_thread_pool.h"
+#include "share/cache/ob_kvcache_struct.h"
+#include "ob_micro_block_cache.h"
+#include "ob_bloom_filter_cache.h"
+#include "ob_sstable_macro_block_header.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+class ObMacroBlockReader;
+
+struct ObMicroBlockCacheManifestHeader
+{
+  static const int32_t MANIFEST_MAGIC = 0x4D42434D; // "MBCM"
+  static const int32_t MANIFEST_VERSION = 2;
+  ObMicroBlockCacheManifestHeader();
+  bool is_valid() const;
+
+  int32_t magic_;
+  int32_t version_;
+  int64_t index_entry_cnt_;
+  int64_t data_entry_cnt_;
+  int64_t bf_entry_cnt_;
+  // total size of serialized bloom filters following the bloom filter entries
+  int64_t bf_data_size_;
+  // crc64 of all entries and bloom filters
+  int64_t checksum_;
+  int64_t create_ts_;
+  TO_STRING_KV(K_(magic), K_(version), K_(index_entry_cnt), K_(data_entry_cnt), K_(bf_entry_cnt),
+      K_(bf_data_size), K_(checksum), K_(create_ts));
+};
+
+// A hot micro block recorded in the manifest, identified the same way as its cache key
+struct ObMicroBlockCacheManifestEntry
+{
+  ObMicroBlockCacheManifestEntry();
+  ObMicroBlockCacheManifestEntry(const ObMicroBlockCacheKey &key, const int64_t data_checksum);
+  bool is_valid() const;
+  MacroBlockId get_macro_id() const { return MacroBlockId(macro_id_[0], macro_id_[1], macro_id_[2]); }
+  bool operator <(const ObMicroBlockCacheManifestEntry &other) const;
+
+  uint64_t tenant_id_;
+  int64_t macro_id_[3];
+  int64_t offset_;
+  int64_t size_;
+  // data checksum in the micro block header, to detect blocks rewritten since recorded
+  int64_t data_checksum_;
+  TO_STRING_KV(K_(tenant_id), "macro_id", get_macro_id(), K_(offset), K_(size), K_(data_checksum));
+};
+
+// A hot bloom filter recorded in the manifest, its serialized value is saved in the manifest
+// as it's built from rows of the whole macro block
+struct ObBloomFilterManifestEntry
+{
+  ObBloomFilterManifestEntry();
+  ObBloomFilterManifestEntry(const ObBloomFilterCacheKey &key, const int64_t value_size);
+  bool is_valid() const;
+  MacroBlockId get_macro_id() const { return MacroBlockId(macro_id_[0], macro_id_[1], macro_id_[2]); }
+
+  uint64_t tenant_id_;
+  int64_t macro_id_[3];
+  // data checksum in the sstable macro block header, to detect macro block ids reused after restart
+  int64_t macro_data_checksum_;
+  int64_t value_size_;
+  TO_STRING_KV(K_(tenant_id), "macro_id", get_macro_id(), K_(macro_data_checksum), K_(value_size));
+};
+
+// Warms up index and user block cache after restart.
+//
+// The keys of the hottest micro blocks of both caches, ranked by the score of the kv cache
+// mem blocks holding them, are persisted into a manifest file periodically and at shutdown.
+// After restart the manifest is loaded and the blocks are read back into the block caches
+// by a background thread with prewarm io priority, throttled by
+// _micro_block_cache_warm_up_bandwidth. Index blocks are loaded before data blocks, and
+// blocks of the same macro block are read together in offset order.
+//
+// Loaded blocks carry no cached decoders or transformed index, like blocks promoted from
+// the flash cache. Blocks of freed macro blocks and blocks whose header checksum differs
+// from the manifest are skipped.
+//
+// Hot bloom filters are saved in the manifest together with the data checksum of their macro
+// block, and put back into the bloom filter cache after blocks are loaded if the macro block
+// still has the same checksum.
+class ObMicroBlockCacheWarmer : public share::ObThreadPool
+{
+public:
+  typedef common::ObArray<ObMicroBlockCacheManifestEntry> EntryArray;
+  typedef common::ObArray<ObBloomFilterManifestEntry> BFEntryArray;
+  ObMicroBlockCacheWarmer();
+  virtual ~ObMicroBlockCacheWarmer();
+  int init(
+      const char *manifest_path,
+      ObIndexMicroBlockCache &index_block_cache,
+      ObDataMicroBlockCache &user_block_cache,
+      ObBloomFilterCache &bf_cache);
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  virtual void run1() override;
+  // persist hot keys of the block caches into the manifest
+  int dump_manifest();
+  // reload blocks recorded in the manifest into the block caches
+  int warm_up();
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  TO_STRING_KV(K_(is_inited), K_(manifest_path), K_(warm_up_done), K_(load_cnt), K_(skip_cnt),
+      K_(load_size), K_(bf_load_cnt), K_(io_size));
+private:
+  // serialized bloom filters of the manifest, in the order of their entries
+  struct BloomFilters
+  {
+    BloomFilters() : allocator_("MicroCacheWarm"), entries_(), data_(nullptr), data_size_(0) {}
+    common::ObArenaAllocator allocator_;
+    BFEntryArray entries_;
+    char *data_;
+    int64_t data_size_;
+  };
+  class HotKeyCollector : public common::ObIKVCachePairVisitor
+  {
+  public:
+    explicit HotKeyCollector(EntryArray &entries) : entries_(entries) {}
+    virtual ~HotKeyCollector() {}
+    virtual int visit(const common::ObIKVCacheKey &key, const common::ObIKVCacheValue &value) override;
+  private:
+    EntryArray &entries_;
+  };
+  class HotBloomFilterCollector : public common::ObIKVCachePairVisitor
+  {
+  public:
+    explicit HotBloomFilterCollector(common::ObIArray<common::ObString> &values, common::ObIAllocator &allocator)
+      : values_(values), allocator_(allocator) {}
+    virtual ~HotBloomFilterCollector() {}
+    // save the key and the serialized value of each bloom filter
+    virtual int visit(const common::ObIKVCacheKey &key, const common::ObIKVCacheValue &value) override;
+  private:
+    common::ObIArray<common::ObString> &values_;
+    common::ObIAllocator &allocator_;
+  };
+  static const int64_t MACRO_HEADER_READ_SIZE = 4 * 1024;
+  // neighbour blocks of a macro block are read in one io if the gap between them is small
+  static const int64_t MAX_MERGE_GAP = 64 * 1024;
+  static const int64_t MAX_MERGE_IO_SIZE = 2 * 1024 * 1024;
+  static const int64_t CHECK_INTERVAL_MS = 1000;
+
+  // build bloom filter entries of collected pairs whose macro blocks are still in use
+  int build_bloom_filters(const common::ObIArray<common::ObString> &pairs, BloomFilters &bloom_filters);
+  int write_manifest(
+      const EntryArray &index_entries,
+      const EntryArray &data_entries,
+      const BloomFilters &bloom_filters);
+  int read_manifest(EntryArray &index_entries, EntryArray &data_entries, BloomFilters &bloom_filters);
+  int warm_up_bloom_filters(const int64_t start_ts, const BloomFilters &bloom_filters);
+  int warm_up_blocks(
+      ObIMicroBlockCache &block_cache,
+      const ObMicroBlockData::Type block_type,
+      const int64_t start_ts,
+      EntryArray &entries);
+  int read_macro_header(const MacroBlockId &macro_id, ObSSTableMacroBlockHeader &macro_header);
+  int load_blocks(
+      ObIMicroBlockCache &block_cache,
+      const ObMicroBlockData::Type block_type,
+      const ObMicroBlockDesMeta &des_meta,
+      const EntryArray &entries,
+      const int64_t start_idx,
+      const int64_t end_idx,
+      ObMacroBlockReader &reader);
+  int load_block(
+      ObIMicroBlockCache &block_cache,
+      const ObMicroBlockData::Type block_type,
+      const ObMicroBlockDesMeta &des_meta,
+      const ObMicroBlockCacheManifestEntry &entry,
+      const char *buf,
+      ObMacroBlockReader &reader);
+  // keep io of warm up since @start_ts under _micro_block_cache_warm_up_bandwidth
+  void throttle(const int64_t start_ts);
+
+private:
+  bool is_inited_;
+  char manifest_path_[common::OB_MAX_FILE_NAME_LENGTH];
+  ObIndexMicroBlockCache *index_block_cache_;
+  ObDataMicroBlockCache *user_block_cache_;
+  ObBloomFilterCache *bf_cache_;
+  common::ObThreadCond cond_;
+  // manifest is only rewritten after warm-up, an interrupted warm-up keeps the old one
+  bool warm_up_done_;
+  int64_t load_cnt_;
+  int64_t skip_cnt_;
+  int64_t load_size_;
+  int64_t bf_load_cnt_;
+  int64_t io_size_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCacheWarmer);
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_CACHE_WARMER_H_
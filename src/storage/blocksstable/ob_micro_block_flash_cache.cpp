@@ -0,0 +1,492 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+#include <fcntl.h>
+#include <unistd.h>
+#include "lib/checksum/ob_crc64.h"
+#include "lib/thread/ob_thread_name.h"
+#include "lib/utility/ob_utility.h"
+#include "storage/blocksstable/ob_micro_block_flash_cache.h"
+#include "storage/blocksstable/ob_index_block_row_scanner.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+/*----------------------------------------ObFlashCacheRecordHeader--------------------------------------*/
+ObFlashCacheRecordHeader::ObFlashCacheRecordHeader()
+  : magic_(FLASH_CACHE_RECORD_MAGIC),
+    data_size_(0),
+    block_type_(ObMicroBlockData::MAX_TYPE),
+    col_meta_cnt_(0),
+    extra_size_(0),
+    reserved_(0),
+    data_checksum_(0),
+    tenant_id_(OB_INVALID_TENANT_ID),
+    block_id_()
+{
+}
+
+bool ObFlashCacheRecordHeader::is_valid() const
+{
+  return FLASH_CACHE_RECORD_MAGIC == magic_
+      && data_size_ > 0
+      && block_type_ >= 0
+      && block_type_ < ObMicroBlockData::MAX_TYPE
+      && col_meta_cnt_ >= 0
+      && extra_size_ >= 0
+      && (0 == col_meta_cnt_ || ObMicroBlockData::INDEX_BLOCK == block_type_);
+}
+
+bool ObFlashCacheRecordHeader::match(const ObMicroBlockCacheKey &key) const
+{
+  return tenant_id_ == key.get_tenant_id() && block_id_ == key.get_micro_block_id();
+}
+
+/*-----------------------------------------ObMicroBlockFlashCache---------------------------------------*/
+ObMicroBlockFlashCache::ObMicroBlockFlashCache()
+  : is_inited_(false),
+    fd_(-1),
+    segment_cnt_(0),
+    flushing_seq_(0),
+    demote_cnt_(0),
+    drop_cnt_(0),
+    hit_cnt_(0),
+    miss_cnt_(0),
+    cond_(),
+    active_(nullptr),
+    segments_(),
+    index_(),
+    slot_keys_(nullptr),
+    allocator_("MicroFlashCache")
+{
+}
+
+ObMicroBlockFlashCache::~ObMicroBlockFlashCache()
+{
+  destroy();
+}
+
+int ObMicroBlockFlashCache::init(const char *file_path, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t segment_cnt = file_size / SEGMENT_SIZE;
+  void *buf = nullptr;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("micro block flash cache init twice", K(ret));
+  } else if (OB_ISNULL(file_path) || OB_UNLIKELY(segment_cnt < MIN_SEGMENT_CNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(file_path), K(file_size));
+  } else if (FALSE_IT(segment_cnt_ = segment_cnt)) {
+  } else if (OB_FAIL(open_file(file_path, segment_cnt * SEGMENT_SIZE))) {
+    LOG_WARN("fail to open flash cache file", K(ret), K(file_path), K(segment_cnt));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("fail to init thread cond", K(ret));
+  } else if (OB_FAIL(index_.create(
+      segment_cnt * SEGMENT_SIZE / AVG_MICRO_BLOCK_SIZE, "MicroFlashIdx", "MicroFlashIdx"))) {
+    LOG_WARN("fail to create flash cache index", K(ret), K(segment_cnt));
+  } else if (OB_ISNULL(segments_[0].buf_ = static_cast<char *>(allocator_.alloc(SEGMENT_SIZE)))
+      || OB_ISNULL(segments_[1].buf_ = static_cast<char *>(allocator_.alloc(SEGMENT_SIZE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate segment buffer", K(ret));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(SlotKeys) * segment_cnt))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate slot keys", K(ret), K(segment_cnt));
+  } else {
+    slot_keys_ = static_cast<SlotKeys *>(buf);
+    for (int64_t i = 0; i < segment_cnt; ++i) {
+      new (slot_keys_ + i) SlotKeys(OB_MALLOC_NORMAL_BLOCK_SIZE, ModulePageAllocator("MicroFlashKeys"));
+    }
+    segments_[0].reuse(0);
+    segments_[1].reuse(-1);
+    active_ = &segments_[0];
+    flushing_seq_ = 0;
+    is_inited_ = true;
+    LOG_INFO("succeed to init micro block flash cache", K(file_path), K(file_size), K(*this));
+  }
+  if (OB_FAIL(ret) && !is_inited_) {
+    destroy();
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::open_file(const char *file_path, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  // cached blocks are not recovered after restart: macro block write sequences are only
+  // unique within a process lifetime, so stale content is simply overwritten by the ring
+  if ((fd_ = ::open(file_path, O_CREAT | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open flash cache file", K(ret), K(file_path), K(errno));
+  } else if (0 != ::ftruncate(fd_, file_size)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to truncate flash cache file", K(ret), K(file_path), K(file_size), K(errno));
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::start()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block flash cache not init", K(ret));
+  } else if (OB_FAIL(share::ObThreadPool::start())) {
+    LOG_WARN("fail to start micro block flash cache writer", K(ret));
+  }
+  return ret;
+}
+
+void ObMicroBlockFlashCache::stop()
+{
+  share::ObThreadPool::stop();
+  ObThreadCondGuard guard(cond_);
+  cond_.signal();
+}
+
+void ObMicroBlockFlashCache::wait()
+{
+  share::ObThreadPool::wait();
+}
+
+void ObMicroBlockFlashCache::destroy()
+{
+  if (is_inited_) {
+    stop();
+    wait();
+  }
+  is_inited_ = false;
+  index_.destroy();
+  if (OB_NOT_NULL(slot_keys_)) {
+    for (int64_t i = 0; i < segment_cnt_; ++i) {
+      slot_keys_[i].~SlotKeys();
+    }
+    slot_keys_ = nullptr;
+  }
+  active_ = nullptr;
+  segments_[0] = Segment();
+  segments_[1] = Segment();
+  allocator_.reset();
+  cond_.destroy();
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  segment_cnt_ = 0;
+  flushing_seq_ = 0;
+}
+
+void ObMicroBlockFlashCache::on_wash(const ObIKVCacheKey &key, const ObIKVCacheValue &value)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockCacheKey &block_key = static_cast<const ObMicroBlockCacheKey &>(key);
+  const ObMicroBlockData &block_data
+      = static_cast<const ObMicroBlockCacheValue &>(value).get_block_data();
+  const ObIndexBlockDataHeader *idx_header = nullptr;
+  ObFlashCacheRecordHeader header;
+  header.data_size_ = static_cast<int32_t>(block_data.get_buf_size());
+  header.block_type_ = block_data.type_;
+  header.tenant_id_ = block_key.get_tenant_id();
+  header.block_id_ = block_key.get_micro_block_id();
+  if (ObMicroBlockData::INDEX_BLOCK == block_data.type_ && nullptr != block_data.get_extra_buf()) {
+    // index readers use the transformed block in extra buf, keep column types to rebuild it
+    idx_header = reinterpret_cast<const ObIndexBlockDataHeader *>(block_data.get_extra_buf());
+    header.col_meta_cnt_ = static_cast<int32_t>(idx_header->col_cnt_);
+    header.extra_size_ = static_cast<int32_t>(block_data.get_extra_size());
+  }
+  ObFlashCacheLocation location;
+  if (OB_UNLIKELY(!is_inited_ || !block_data.is_valid() || header.get_record_size() > MAX_RECORD_SIZE)) {
+    // skip
+  } else if (OB_SUCC(index_.get_refactored(block_key, location)) && !is_overwritten(location.seq_)) {
+    // still cached on flash, no need to write again
+  } else {
+    bool need_signal = false;
+    const bool demoted = demote(
+        header, block_data, nullptr == idx_header ? nullptr : idx_header->col_meta_array_, need_signal);
+    if (need_signal) {
+      ObThreadCondGuard guard(cond_);
+      cond_.signal();
+    }
+    if (demoted) {
+      ATOMIC_INC(&demote_cnt_);
+    } else {
+      // writer falls behind, drop the block rather than block washing
+      ATOMIC_INC(&drop_cnt_);
+    }
+  }
+}
+
+bool ObMicroBlockFlashCache::demote(
+    const ObFlashCacheRecordHeader &header,
+    const ObMicroBlockData &block_data,
+    const ObObjMeta *col_metas,
+    bool &need_signal)
+{
+  bool demoted = false;
+  const int64_t record_size = header.get_record_size();
+  Segment *segment = ATOMIC_LOAD(&active_);
+  ATOMIC_INC(&segment->ref_cnt_);
+  // the writer switches active segment before waiting for references, recheck after referenced
+  if (segment == ATOMIC_LOAD(&active_)) {
+    const int64_t pos = ATOMIC_FAA(&segment->pos_, record_size);
+    if (pos + record_size <= SEGMENT_SIZE) {
+      char *record_buf = segment->buf_ + pos;
+      MEMCPY(record_buf, &header, sizeof(header));
+      MEMCPY(record_buf + sizeof(header), block_data.get_buf(), block_data.get_buf_size());
+      if (header.col_meta_cnt_ > 0) {
+        MEMCPY(record_buf + header.get_col_meta_offset(), col_metas,
+            header.col_meta_cnt_ * sizeof(ObObjMeta));
+      }
+      demoted = true;
+    } else if (pos <= SEGMENT_SIZE) {
+      // the first reservation beyond segment end seals it and hands it to the writer
+      ATOMIC_STORE(&segment->sealed_pos_, pos);
+      need_signal = true;
+    }
+  }
+  ATOMIC_DEC(&segment->ref_cnt_);
+  return demoted;
+}
+
+int ObMicroBlockFlashCache::get(
+    const ObMicroBlockCacheKey &key,
+    ObIMicroBlockCache &block_cache,
+    const ObMicroBlockCacheValue *&value,
+    ObKVCacheHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObFlashCacheLocation location;
+  value = nullptr;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_FAIL(index_.get_refactored(key, location))) {
+    if (OB_HASH_NOT_EXIST == ret) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      LOG_WARN("fail to get flash cache location", K(ret), K(key));
+    }
+  } else if (is_overwritten(location.seq_)) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_FAIL(read_record(key, location, block_cache, value, handle))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("fail to read flash cache record", K(ret), K(key), K(location));
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    ATOMIC_INC(&hit_cnt_);
+  } else if (is_inited_) {
+    ATOMIC_INC(&miss_cnt_);
+    // any failure falls back to macro block io
+    ret = OB_ENTRY_NOT_EXIST;
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::read_record(
+    const ObMicroBlockCacheKey &key,
+    const ObFlashCacheLocation &location,
+    ObIMicroBlockCache &block_cache,
+    const ObMicroBlockCacheValue *&value,
+    ObKVCacheHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObIMicroBlockCache::BaseBlockCache *cache = nullptr;
+  ObKVCachePair *kvpair = nullptr;
+  ObKVCacheInstHandle inst_handle;
+  const bool overwrite = false;
+  ObIndexBlockDataTransformer *transformer = nullptr;
+  if (OB_FAIL(block_cache.get_cache(cache))) {
+    LOG_WARN("fail to get block cache", K(ret));
+  } else if (OB_FAIL(cache->alloc(
+      key.get_tenant_id(),
+      sizeof(ObMicroBlockCacheKey),
+      sizeof(ObMicroBlockCacheValue) + location.size_ + location.extra_size_,
+      kvpair,
+      handle,
+      inst_handle))) {
+    LOG_WARN("fail to alloc cache buf", K(ret), K(key), K(location));
+  } else {
+    // read the whole record behind the cache value, data is 8 bytes aligned after the header
+    char *record_buf = reinterpret_cast<char *>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
+    const ObFlashCacheRecordHeader *header
+        = reinterpret_cast<const ObFlashCacheRecordHeader *>(record_buf);
+    const char *data_buf = record_buf + sizeof(ObFlashCacheRecordHeader);
+    char *extra_buf = record_buf + location.size_;
+    new (kvpair->key_) ObMicroBlockCacheKey(key);
+    // keep value invalid until the record is verified, so that it's never demoted back
+    ObMicroBlockCacheValue *cache_value = new (kvpair->value_) ObMicroBlockCacheValue(nullptr, 0);
+    const int64_t read_size = ob_pread(
+        fd_, record_buf, location.size_, get_slot_offset(location.seq_) + location.offset_);
+    if (OB_UNLIKELY(read_size != location.size_)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to read flash cache file", K(ret), K(read_size), K(location), K(errno));
+    } else if (OB_UNLIKELY(is_overwritten(location.seq_)
+        || !header->is_valid()
+        || !header->match(key)
+        || header->get_record_size() != location.size_
+        || header->extra_size_ != location.extra_size_
+        || header->data_checksum_ != static_cast<int64_t>(ob_crc64(
+            data_buf, location.size_ - sizeof(ObFlashCacheRecordHeader))))) {
+      // slot was overwritten during read
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      ObMicroBlockData &block_data = cache_value->get_block_data();
+      block_data.buf_ = data_buf;
+      block_data.size_ = header->data_size_;
+      block_data.type_ = static_cast<ObMicroBlockData::Type>(header->block_type_);
+      if (header->col_meta_cnt_ <= 0) {
+      } else if (OB_ISNULL(transformer = GET_TSI_MULT(ObIndexBlockDataTransformer, 1))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to get thread local index block data transformer", K(ret));
+      } else if (OB_FAIL(transformer->transform(
+          reinterpret_cast<const ObObjMeta *>(record_buf + header->get_col_meta_offset()),
+          block_data,
+          extra_buf,
+          header->extra_size_))) {
+        LOG_WARN("fail to transform promoted index block", K(ret), KPC(header));
+      } else {
+        block_data.get_extra_buf() = extra_buf;
+        block_data.get_extra_size() = header->extra_size_;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      value = cache_value;
+      if (OB_FAIL(cache->put_kvpair(inst_handle, kvpair, handle, overwrite))) {
+        if (OB_ENTRY_EXIST != ret) {
+          LOG_WARN("fail to put micro block cache", K(ret), K(key));
+        } else {
+          ret = OB_SUCCESS;
+        }
+      } else {
+        const int64_t put_size = ObKVStoreMemBlock::get_align_size(key, *cache_value);
+        if (OB_FAIL(block_cache.add_put_size(put_size))) {
+          LOG_WARN("add_put_size failed", K(ret), K(put_size));
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+      cache_value->get_block_data().reset();
+      handle.reset();
+      value = nullptr;
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockFlashCache::run1()
+{
+  int ret = OB_SUCCESS;
+  lib::set_thread_name("MicroFlashCache");
+  while (!has_set_stop()) {
+    Segment *active = ATOMIC_LOAD(&active_);
+    if (ATOMIC_LOAD(&active->sealed_pos_) < 0) {
+      ObThreadCondGuard guard(cond_);
+      if (ATOMIC_LOAD(&active->sealed_pos_) < 0 && !has_set_stop()) {
+        cond_.wait(FLUSH_WAIT_MS);
+      }
+    }
+    if (ATOMIC_LOAD(&active->sealed_pos_) >= 0) {
+      Segment *sealed = switch_segment();
+      if (OB_FAIL(flush_segment(*sealed))) {
+        LOG_WARN("fail to flush flash cache segment", K(ret), K_(flushing_seq));
+      }
+    }
+    if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      LOG_INFO("micro block flash cache statistics", K(*this));
+    }
+  }
+}
+
+ObMicroBlockFlashCache::Segment *ObMicroBlockFlashCache::switch_segment()
+{
+  Segment *sealed = ATOMIC_LOAD(&active_);
+  Segment *spare = sealed == &segments_[0] ? &segments_[1] : &segments_[0];
+  spare->reuse(sealed->seq_ + 1);
+  ATOMIC_STORE(&active_, spare);
+  // washing threads referencing the sealed segment either see the switch and skip it, or
+  // finish copying their reserved records before releasing the reference
+  while (ATOMIC_LOAD(&sealed->ref_cnt_) > 0) {
+    PAUSE();
+  }
+  return sealed;
+}
+
+int ObMicroBlockFlashCache::flush_segment(Segment &segment)
+{
+  int ret = OB_SUCCESS;
+  const int64_t slot_offset = get_slot_offset(segment.seq_);
+  const int64_t write_size = segment.sealed_pos_;
+  for (int64_t pos = 0; pos < write_size; ) {
+    ObFlashCacheRecordHeader *header = reinterpret_cast<ObFlashCacheRecordHeader *>(segment.buf_ + pos);
+    const int64_t record_size = header->get_record_size();
+    header->data_checksum_ = static_cast<int64_t>(ob_crc64(
+        segment.buf_ + pos + sizeof(ObFlashCacheRecordHeader), record_size - sizeof(ObFlashCacheRecordHeader)));
+    pos += record_size;
+  }
+  // readers of the overwritten segment see flushing_seq_ first
+  ATOMIC_STORE(&flushing_seq_, segment.seq_);
+  recycle_slot(segment.seq_);
+  if (OB_UNLIKELY(write_size != ob_pwrite(fd_, segment.buf_, write_size, slot_offset))) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to write flash cache file", K(ret), K(write_size), K(errno));
+  } else {
+    // cached blocks are read by pread of single records, don't pollute os page cache
+    (void) ::posix_fadvise(fd_, slot_offset, write_size, POSIX_FADV_DONTNEED);
+    index_segment(segment);
+  }
+  return ret;
+}
+
+void ObMicroBlockFlashCache::recycle_slot(const int64_t seq)
+{
+  int ret = OB_SUCCESS;
+  const int64_t old_seq = seq - segment_cnt_;
+  SlotKeys &keys = slot_keys_[seq % segment_cnt_];
+  ObFlashCacheLocation location;
+  for (int64_t i = 0; i < keys.count(); ++i) {
+    if (OB_SUCC(index_.get_refactored(keys.at(i), location)) && old_seq == location.seq_) {
+      if (OB_FAIL(index_.erase_refactored(keys.at(i)))) {
+        LOG_WARN("fail to erase flash cache location", K(ret), K(keys.at(i)));
+      }
+    }
+  }
+  keys.reuse();
+}
+
+void ObMicroBlockFlashCache::index_segment(const Segment &segment)
+{
+  int ret = OB_SUCCESS;
+  const int32_t overwrite = 1;
+  SlotKeys &keys = slot_keys_[segment.seq_ % segment_cnt_];
+  int64_t pos = 0;
+  while (pos < segment.sealed_pos_) {
+    const ObFlashCacheRecordHeader *header
+        = reinterpret_cast<const ObFlashCacheRecordHeader *>(segment.buf_ + pos);
+    const int32_t record_size = static_cast<int32_t>(header->get_record_size());
+    ObMicroBlockCacheKey key(header->tenant_id_, header->block_id_);
+    ObFlashCacheLocation location(segment.seq_, static_cast<int32_t>(pos), record_size, header->extra_size_);
+    if (OB_FAIL(keys.push_back(key))) {
+      LOG_WARN("fail to record slot key", K(ret), K(key));
+    } else if (OB_FAIL(index_.set_refactored(key, location, overwrite))) {
+      LOG_WARN("fail to set flash cache location", K(ret), K(key), K(location));
+    }
+    pos += record_size;
+  }
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
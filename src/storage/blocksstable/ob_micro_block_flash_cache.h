@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_FLASH_CACHE_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_FLASH_CACHE_H_
+
+#include "lib/hash/ob_hashmap.h"
+#include "lib/container/ob_array.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "share/ob_thread_pool.h"
+#include "share/cache/ob_kvcache_struct.h"
+#include "ob_micro_block_cache.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+struct ObFlashCacheRecordHeader
+{
+  static const int32_t FLASH_CACHE_RECORD_MAGIC = 0x4D424643; // "MBFC"
+  ObFlashCacheRecordHeader();
+  bool is_valid() const;
+  bool match(const ObMicroBlockCacheKey &key) const;
+  // column types of index block are saved after the 8 bytes aligned micro block data
+  OB_INLINE int64_t get_col_meta_offset() const
+  {
+    return sizeof(ObFlashCacheRecordHeader)
+        + common::ObKVStoreMemBlock::upper_align(data_size_, sizeof(int64_t));
+  }
+  OB_INLINE int64_t get_record_size() const
+  {
+    return common::ObKVStoreMemBlock::upper_align(
+        get_col_meta_offset() + col_meta_cnt_ * sizeof(common::ObObjMeta), sizeof(int64_t));
+  }
+
+  int32_t magic_;
+  int32_t data_size_;
+  int32_t block_type_;
+  // count of column types saved to transform index block again on promotion
+  int32_t col_meta_cnt_;
+  // memory size of the transformed index block
+  int32_t extra_size_;
+  int32_t reserved_;
+  // checksum of the record after header, computed by the writer thread
+  int64_t data_checksum_;
+  uint64_t tenant_id_;
+  ObMicroBlockId block_id_;
+  TO_STRING_KV(K_(magic), K_(data_size), K_(block_type), K_(col_meta_cnt), K_(extra_size),
+      K_(data_checksum), K_(tenant_id), K_(block_id));
+};
+
+struct ObFlashCacheLocation
+{
+  ObFlashCacheLocation() : seq_(-1), offset_(0), size_(0), extra_size_(0) {}
+  ObFlashCacheLocation(
+      const int64_t seq,
+      const int32_t offset,
+      const int32_t size,
+      const int32_t extra_size)
+    : seq_(seq), offset_(offset), size_(size), extra_size_(extra_size) {}
+  // sequence of the segment holding the record, segment seq is stored at slot seq % segment_cnt
+  int64_t seq_;
+  int32_t offset_;
+  // record size including header
+  int32_t size_;
+  // memory size of the transformed index block, allocated behind the record on promotion
+  int32_t extra_size_;
+  TO_STRING_KV(K_(seq), K_(offset), K_(size), K_(extra_size));
+};
+
+// Second level cache of index and data micro blocks on local flash.
+//
+// Micro blocks washed out of the memory block caches are demoted here in decompressed
+// format. The cache file is a ring of fixed size segments written as a log: demoted
+// blocks are appended to an in-memory segment, which is written to the next slot of
+// the ring by a background thread once it's full, overwriting the oldest segment.
+// An in-memory hash index maps micro block keys to their record in the file, and
+// block cache misses consult it before issuing macro block io, a hit is read with
+// one pread and promoted back into the memory block cache.
+//
+// Micro block ids of a macro block never change, so cached blocks need no invalidation,
+// they just age out with the ring. Demotion never blocks washing: washing threads reserve
+// space in the active segment with an atomic add and copy the block without lock, and
+// blocks are dropped if the background writer falls behind.
+//
+// Index blocks are promoted with the transformed format rebuilt from the column types saved
+// with the record. Data blocks are promoted without cached decoders, decoders are built by
+// the reader on use, as for blocks cached with decoder cache disabled.
+class ObMicroBlockFlashCache : public common::ObIKVCacheVictimHandler, public share::ObThreadPool
+{
+public:
+  static const int64_t SEGMENT_SIZE = 2 * 1024 * 1024; // 2MB
+  static const int64_t MIN_SEGMENT_CNT = 4;
+  static const int64_t MAX_RECORD_SIZE = SEGMENT_SIZE / 4;
+  ObMicroBlockFlashCache();
+  virtual ~ObMicroBlockFlashCache();
+  int init(const char *file_path, const int64_t file_size);
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  virtual void run1() override;
+  virtual void on_wash(
+      const common::ObIKVCacheKey &key,
+      const common::ObIKVCacheValue &value) override;
+  // Promote micro block of @key from flash into @block_cache.
+  // Return OB_ENTRY_NOT_EXIST if the block is not cached.
+  int get(
+      const ObMicroBlockCacheKey &key,
+      ObIMicroBlockCache &block_cache,
+      const ObMicroBlockCacheValue *&value,
+      common::ObKVCacheHandle &handle);
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  TO_STRING_KV(K_(is_inited), K_(fd), K_(segment_cnt), K_(flushing_seq),
+      K_(demote_cnt), K_(drop_cnt), K_(hit_cnt), K_(miss_cnt));
+private:
+  struct Segment
+  {
+    Segment() : buf_(nullptr), pos_(0), sealed_pos_(-1), ref_cnt_(0), seq_(-1) {}
+    void reuse(const int64_t seq) { pos_ = 0; sealed_pos_ = -1; seq_ = seq; }
+    char *buf_;
+    // bytes reserved by washing threads, goes beyond SEGMENT_SIZE once the segment is full
+    int64_t pos_;
+    // size of records in the segment, set by the first reservation beyond SEGMENT_SIZE
+    int64_t sealed_pos_;
+    // washing threads copying into the segment
+    int64_t ref_cnt_;
+    int64_t seq_;
+  };
+  // Every operation on the index is guarded by bucket latches, as readers run concurrently
+  // with the writer thread indexing and recycling segments. A location got before its slot
+  // is recycled is detected by checking the record after pread.
+  typedef common::hash::ObHashMap<ObMicroBlockCacheKey, ObFlashCacheLocation,
+                                  common::hash::LatchReadWriteDefendMode> LocationMap;
+  typedef common::ObArray<ObMicroBlockCacheKey> SlotKeys;
+  static const int64_t AVG_MICRO_BLOCK_SIZE = 16 * 1024;
+  static const int64_t FLUSH_WAIT_MS = 100;
+
+  OB_INLINE int64_t get_slot_offset(const int64_t seq) const
+  {
+    return (seq % segment_cnt_) * SEGMENT_SIZE;
+  }
+  OB_INLINE bool is_overwritten(const int64_t seq) const
+  {
+    return seq + segment_cnt_ <= ATOMIC_LOAD(&flushing_seq_);
+  }
+  int open_file(const char *file_path, const int64_t file_size);
+  // copy the record into the active segment, return false if there is no space
+  bool demote(
+      const ObFlashCacheRecordHeader &header,
+      const ObMicroBlockData &block_data,
+      const common::ObObjMeta *col_metas,
+      bool &need_signal);
+  // activate the spare segment and return the sealed one after all copies into it finished
+  Segment *switch_segment();
+  int flush_segment(Segment &segment);
+  void recycle_slot(const int64_t seq);
+  void index_segment(const Segment &segment);
+  int read_record(
+      const ObMicroBlockCacheKey &key,
+      const ObFlashCacheLocation &location,
+      ObIMicroBlockCache &block_cache,
+      const ObMicroBlockCacheValue *&value,
+      common::ObKVCacheHandle &handle);
+
+private:
+  bool is_inited_;
+  int fd_;
+  int64_t segment_cnt_;
+  // seq of the segment being written to file, segments older than flushing_seq_ - segment_cnt_
+  // are overwritten
+  int64_t flushing_seq_;
+  int64_t demote_cnt_;
+  int64_t drop_cnt_;
+  int64_t hit_cnt_;
+  int64_t miss_cnt_;
+  common::ObThreadCond cond_;
+  // segment receiving washed blocks, the other one is owned by the writer thread
+  Segment *active_;
+  Segment segments_[2];
+  LocationMap index_;
+  // keys of records in every slot of the ring, to clean the index when slot is overwritten
+  SlotKeys *slot_keys_;
+  common::ObArenaAllocator allocator_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockFlashCache);
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_FLASH_CACHE_H_
@@ -657,5 +657,56 @@ int ObMicroBlockReader::get_row_count(
   return ret;
 }
 
+int ObMicroBlockReader::get_column_datum(
+    const int32_t col,
+    const int64_t *row_ids,
+    const char **cell_datas,
+    const int64_t row_cap,
+    common::ObDatum *datums)
+{
+  UNUSED(cell_datas);
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == header_ ||
+                  nullptr == read_info_ ||
+                  nullptr == row_ids ||
+                  nullptr == datums ||
+                  row_cap > header_->row_count_ ||
+                  col >= read_info_->get_request_count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KPC(header_), KPC_(read_info), KP(row_ids), KP(datums),
+             K(row_cap), K(col));
+  } else {
+    int64_t row_idx = common::OB_INVALID_INDEX;
+    const int64_t col_idx = read_info_->get_columns_index().at(col);
+    const ObObjDatumMapType map_type =
+        ObDatum::get_obj_datum_map_type(read_info_->get_columns_desc().at(col).col_type_.get_type());
+    common::ObObj nop_obj;
+    nop_obj.set_nop_value();
+    const bool is_col_exist = col_idx >= 0 && col_idx < header_->column_count_;
+    ObStorageDatum datum;
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cap; ++i) {
+      row_idx = row_ids[i];
+      if (!is_col_exist) {
+        datum.set_nop();
+      } else if (OB_FAIL(flat_row_reader_.read_column(
+          data_begin_ + index_data_[row_idx],
+          index_data_[row_idx + 1] - index_data_[row_idx],
+          col_idx,
+          datum))) {
+        LOG_WARN("fail to read column", K(ret), K(i), K(col_idx), K(row_idx));
+      }
+      if (OB_FAIL(ret)) {
+      } else if (datum.is_nop()) {
+        if (OB_FAIL(datums[i].from_obj(nop_obj, OBJ_DATUM_FULL))) {
+          LOG_WARN("Failed to set nop datum", K(ret), K(i), K(row_idx), K(col_idx));
+        }
+      } else if (OB_FAIL(datums[i].from_storage_datum(datum, map_type))) {
+        LOG_WARN("Failed to from storage datum", K(ret), K(i), K(row_idx), K(col_idx), K(datum));
+      }
+    }
+  }
+  return ret;
+}
+
 }
 }
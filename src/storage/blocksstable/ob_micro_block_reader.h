@@ -99,6 +99,12 @@ public:
       const int64_t row_cap,
       const bool contains_null,
       int64_t &count) override final;
+  virtual int get_column_datum(
+      const int32_t col,
+      const int64_t *row_ids,
+      const char **cell_datas,
+      const int64_t row_cap,
+      common::ObDatum *datums) override final;
   virtual int64_t get_column_count() const override
   {
     OB_ASSERT(nullptr != header_);
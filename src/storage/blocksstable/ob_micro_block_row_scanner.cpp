@@ -657,6 +657,7 @@ int ObMultiVersionMicroBlockRowScanner::switch_context(
       STORAGE_LOG(WARN, "Failed to switch context", K(ret));
     } else {
       version_range_ = context.trans_version_range_;
+      tx_state_cache_.reset();
     }
   } else if (OB_UNLIKELY(nullptr == param_ || nullptr == sstable)) {
     ret = OB_ERR_SYS;
@@ -678,6 +679,7 @@ int ObMultiVersionMicroBlockRowScanner::init(
 {
   int ret = OB_SUCCESS;
   reuse();
+  tx_state_cache_.reset();
   if (OB_FAIL(ObIMicroBlockRowScanner::init(param, context, sstable))) {
     LOG_WARN("base init failed", K(ret));
   } else if (!is_inited_) {
@@ -1274,12 +1276,41 @@ int ObMultiVersionMicroBlockRowScanner::lock_for_read(
   int ret = OB_SUCCESS;
   auto &tx_table_guard = context_->store_ctx_->mvcc_acc_ctx_.get_tx_table_guard();
   int64_t read_epoch = tx_table_guard.epoch();
-  SCN scn_trans_version = SCN::invalid_scn();
-  if (OB_FAIL(tx_table_guard.get_tx_table()->lock_for_read(
-        lock_for_read_arg, read_epoch, can_read, scn_trans_version, is_determined_state))) {
-    LOG_WARN("failed to check transaction status", K(ret));
+  const transaction::ObTransID &data_trans_id = lock_for_read_arg.data_trans_id_;
+  int32_t state = ObTxData::RUNNING;
+  int64_t commit_version = 0;
+  if (!tx_state_cache_.get(data_trans_id, state, commit_version)) {
+    // resolve the txn once for all its rows in this scan
+    int tmp_ret = OB_SUCCESS;
+    int64_t tmp_state = ObTxData::RUNNING;
+    SCN scn_commit_version;
+    bool is_decided = false;
+    if (OB_TMP_FAIL(tx_table_guard.get_tx_table()->get_decided_tx_state(
+          data_trans_id, read_epoch, tmp_state, scn_commit_version, is_decided))) {
+      LOG_DEBUG("failed to get decided tx state, check it by row", K(tmp_ret), K(data_trans_id));
+    } else {
+      state = is_decided ? static_cast<int32_t>(tmp_state) : ObTxData::RUNNING;
+      commit_version = is_decided ? scn_commit_version.get_val_for_tx() : 0;
+      tx_state_cache_.put(data_trans_id, state, commit_version);
+    }
+  }
+
+  if (ObTxData::COMMIT == state) {
+    can_read = true;
+    trans_version = commit_version;
+    is_determined_state = true;
+  } else if (ObTxData::ABORT == state) {
+    can_read = false;
+    trans_version = SCN::min_scn().get_val_for_tx();
+    is_determined_state = true;
   } else {
-    trans_version = scn_trans_version.get_val_for_tx();
+    SCN scn_trans_version = SCN::invalid_scn();
+    if (OB_FAIL(tx_table_guard.get_tx_table()->lock_for_read(
+          lock_for_read_arg, read_epoch, can_read, scn_trans_version, is_determined_state))) {
+      LOG_WARN("failed to check transaction status", K(ret));
+    } else {
+      trans_version = scn_trans_version.get_val_for_tx();
+    }
   }
   return ret;
 }
@@ -1334,6 +1365,7 @@ int ObMultiVersionMicroBlockMinorMergeRowScanner::init(
     const ObSSTable *sstable)
 {
   int ret = OB_SUCCESS;
+  tx_state_cache_.reset();
   if (OB_FAIL(ObIMicroBlockRowScanner::init(param, context, sstable))) {
     LOG_WARN("base init failed", K(ret));
   } else {
@@ -1996,11 +2028,18 @@ int ObMultiVersionMicroBlockMinorMergeRowScanner::get_trans_state(
   SCN scn_commit_trans_version = SCN::max_scn();
   auto &tx_table_guard = context_->store_ctx_->mvcc_acc_ctx_.get_tx_table_guard();
   int64_t read_epoch = tx_table_guard.epoch();;
-  if (OB_FAIL(tx_table_guard.get_tx_table()->get_tx_state_with_scn(
+  int32_t cached_state = ObTxData::RUNNING;
+  if (tx_state_cache_.get(trans_id, cached_state, commit_trans_version)) {
+    // decided before the merge scn, which is the same for the whole merge
+    state = cached_state;
+  } else if (OB_FAIL(tx_table_guard.get_tx_table()->get_tx_state_with_scn(
       trans_id, context_->merge_scn_, read_epoch, state, scn_commit_trans_version))) {
     LOG_WARN("get transaction status failed", K(ret), K(trans_id), K(state));
   } else {
     commit_trans_version = scn_commit_trans_version.get_val_for_tx();
+    if (ObTxData::COMMIT == state || ObTxData::ABORT == state) {
+      tx_state_cache_.put(trans_id, static_cast<int32_t>(state), commit_trans_version);
+    }
   }
   return ret;
 }
@@ -19,6 +19,7 @@
 #include "storage/blocksstable/ob_micro_block_reader.h"
 #include "storage/blocksstable/encoding/ob_micro_block_decoder.h"
 #include "storage/access/ob_index_sstable_estimator.h"
+#include "storage/tx_table/ob_tx_data_cache.h"
 
 namespace oceanbase
 {
@@ -249,6 +250,8 @@ private:
   transaction::ObTransID trans_id_;
   common::ObVersionRange version_range_;
   bool read_row_direct_flag_;
+  // decided txns met by the scan, kept across micro blocks
+  storage::ObTxStateCache tx_state_cache_;
 };
 
 // multi version sstable micro block scanner for minor merge
@@ -367,6 +370,8 @@ private:
   transaction::ObTransID last_trans_id_;
   bool first_rowkey_flag_;
   bool have_output_row_flag_;
+  // txns decided before the merge scn, kept during the whole merge
+  storage::ObTxStateCache tx_state_cache_;
 };
 
 }
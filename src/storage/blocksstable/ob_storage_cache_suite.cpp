@@ -24,6 +24,8 @@ ObStorageCacheSuite::ObStorageCacheSuite()
     user_row_cache_(),
     bf_cache_(),
     fuse_row_cache_(),
+    flash_cache_(),
+    cache_warmer_(),
     is_inited_(false)
 {
 }
@@ -108,13 +110,57 @@ int ObStorageCacheSuite::set_bf_cache_miss_count_threshold(const int64_t bf_cach
   return ret;
 }
 
+int ObStorageCacheSuite::init_flash_cache(const char *file_path, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cache suite has not been inited, ", K(ret));
+  } else if (OB_FAIL(flash_cache_.init(file_path, file_size))) {
+    STORAGE_LOG(WARN, "fail to init micro block flash cache", K(ret), K(file_path), K(file_size));
+  } else if (OB_FAIL(flash_cache_.start())) {
+    STORAGE_LOG(WARN, "fail to start micro block flash cache", K(ret));
+  } else if (OB_FAIL(index_block_cache_.set_victim_handler(&flash_cache_))) {
+    STORAGE_LOG(WARN, "fail to set victim handler of index block cache", K(ret));
+  } else if (OB_FAIL(user_block_cache_.set_victim_handler(&flash_cache_))) {
+    STORAGE_LOG(WARN, "fail to set victim handler of user block cache", K(ret));
+  } else {
+    index_block_cache_.set_flash_cache(&flash_cache_);
+    user_block_cache_.set_flash_cache(&flash_cache_);
+  }
+
+  if (OB_FAIL(ret)) {
+    index_block_cache_.set_victim_handler(nullptr);
+    user_block_cache_.set_victim_handler(nullptr);
+    flash_cache_.destroy();
+  }
+  return ret;
+}
+
+int ObStorageCacheSuite::init_cache_warmer(const char *manifest_path)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cache suite has not been inited, ", K(ret));
+  } else if (OB_FAIL(cache_warmer_.init(
+      manifest_path, index_block_cache_, user_block_cache_, bf_cache_))) {
+    STORAGE_LOG(WARN, "fail to init micro block cache warmer", K(ret), K(manifest_path));
+  }
+  return ret;
+}
+
 void ObStorageCacheSuite::destroy()
 {
+  cache_warmer_.destroy();
+  index_block_cache_.set_flash_cache(nullptr);
+  user_block_cache_.set_flash_cache(nullptr);
   index_block_cache_.destroy();
   user_block_cache_.destroy();
   user_row_cache_.destroy();
   bf_cache_.destroy();
   fuse_row_cache_.destroy();
+  flash_cache_.destroy();
   is_inited_ = false;
 }
 
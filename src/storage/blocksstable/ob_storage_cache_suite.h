@@ -15,6 +15,8 @@
 
 #include "share/schema/ob_table_schema.h"
 #include "ob_micro_block_cache.h"
+#include "ob_micro_block_flash_cache.h"
+#include "ob_micro_block_cache_warmer.h"
 #include "ob_row_cache.h"
 #include "ob_fuse_row_cache.h"
 #include "ob_bloom_filter_cache.h"
@@ -44,11 +46,17 @@ public:
       const int64_t fuse_row_cache_priority,
       const int64_t bf_cache_priority);
   int set_bf_cache_miss_count_threshold(const int64_t bf_cache_miss_count_threshold);
+  // demote micro blocks washed out of index and user block cache into a flash cache file
+  int init_flash_cache(const char *file_path, const int64_t file_size);
+  // record hot blocks of index and user block cache into @manifest_path, and reload them on start
+  int init_cache_warmer(const char *manifest_path);
   ObDataMicroBlockCache &get_block_cache() { return user_block_cache_; }
   ObIndexMicroBlockCache &get_index_block_cache() { return index_block_cache_; }
   ObRowCache &get_row_cache() { return user_row_cache_; }
   ObBloomFilterCache &get_bf_cache() { return bf_cache_; }
   ObFuseRowCache &get_fuse_row_cache() { return fuse_row_cache_; }
+  ObMicroBlockFlashCache &get_flash_cache() { return flash_cache_; }
+  ObMicroBlockCacheWarmer &get_cache_warmer() { return cache_warmer_; }
   void destroy();
   inline bool is_inited() const { return is_inited_; }
   TO_STRING_KV(K(is_inited_));
@@ -60,6 +68,8 @@ private:
   ObRowCache user_row_cache_;
   ObBloomFilterCache bf_cache_;
   ObFuseRowCache fuse_row_cache_;
+  ObMicroBlockFlashCache flash_cache_;
+  ObMicroBlockCacheWarmer cache_warmer_;
   bool is_inited_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObStorageCacheSuite);
@@ -14,6 +14,7 @@
 #include "ob_partition_merger.h"
 #include "lib/file/file_directory_utils.h"
 #include "logservice/ob_log_service.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "ob_tenant_tablet_scheduler.h"
 #include "ob_tablet_merge_task.h"
 #include "ob_tablet_merge_ctx.h"
@@ -867,16 +868,22 @@ int ObPartitionMinorMerger::check_need_prebuild_bloomfilter()
 {
   int ret = OB_SUCCESS;
 
-  if (merge_ctx_->parallel_merge_ctx_.get_concurrent_cnt() != 1) {
-    data_store_desc_.need_prebuild_bloomfilter_ = false;
-  } else if (MTL_ID() < OB_MAX_RESERVED_TENANT_ID) {
+  int64_t config_prefix = 0;
+  {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    if (tenant_config.is_valid()) {
+      config_prefix = tenant_config->_bloom_filter_rowkey_prefix;
+    }
+  }
+  if (MTL_ID() < OB_MAX_RESERVED_TENANT_ID) {
     // only check user table
     data_store_desc_.need_prebuild_bloomfilter_ = false;
-  } else if (data_store_desc_.need_prebuild_bloomfilter_) {
+  } else if (data_store_desc_.need_prebuild_bloomfilter_ || config_prefix > 0) {
+    // bloom filters of macro blocks are built by the macro block writer of each parallel task
     ObLS *ls = nullptr;
     common::ObRole curr_ls_role;
     int64_t proposal_id = OB_INVALID_TIMESTAMP;
-    int64_t optimal_prefix = 0;
+    int64_t optimal_prefix = MIN(config_prefix, data_store_desc_.schema_rowkey_col_cnt_);
     if (OB_ISNULL(ls = merge_ctx_->ls_handle_.get_ls())) {
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "Failed to get ls from merge ctx", K(ret));
@@ -886,13 +893,16 @@ int ObPartitionMinorMerger::check_need_prebuild_bloomfilter()
       data_store_desc_.need_prebuild_bloomfilter_ = false;
     } else if (!common::is_strong_leader(curr_ls_role)) {
       data_store_desc_.need_prebuild_bloomfilter_ = false;
-    } else if (OB_FAIL(ls->get_tablet_svr()->get_bf_optimal_prefix(optimal_prefix))) {
+    } else if (optimal_prefix <= 0 && OB_FAIL(ls->get_tablet_svr()->get_bf_optimal_prefix(optimal_prefix))) {
       STORAGE_LOG(WARN, "Failed to get optimal prefix", K(ret));
     } else if (optimal_prefix <= 0 || optimal_prefix > data_store_desc_.schema_rowkey_col_cnt_) {
       data_store_desc_.need_prebuild_bloomfilter_ = false;
     } else {
+      data_store_desc_.need_prebuild_bloomfilter_ = true;
       data_store_desc_.bloomfilter_rowkey_prefix_ = optimal_prefix;
-      if (OB_SUCCESS != init_bloomfilter_writer()) {
+      // the bloom filter of the whole sstable can only be built by a single task
+      if (merge_ctx_->parallel_merge_ctx_.get_concurrent_cnt() == 1
+          && OB_SUCCESS != init_bloomfilter_writer()) {
         STORAGE_LOG(WARN, "Failed to init bloom filter writer", K(ret));
       }
     }
@@ -965,6 +975,7 @@ int ObPartitionMinorMerger::close()
       STORAGE_LOG(WARN, "Unexpected macro block write ctx", K(ret));
     } else if (OB_FAIL(ObStorageCacheSuite::get_instance().get_bf_cache().put_bloom_filter(
                            MTL_ID(),
+                           data_store_desc_.tablet_id_,
                            bf_macro_writer_.get_block_write_ctx().macro_block_list_.at(0),
                            bf_macro_writer_.get_bloomfilter_cache_value()))) {
       if (OB_ENTRY_EXIST != ret) {
@@ -301,13 +301,14 @@ int ObParallelMergeCtx::init_parallel_mini_merge(compaction::ObTabletMergeCtx &m
       int32_t mini_merge_thread = 0;
       if (OB_FAIL(memtable->estimate_phy_size(nullptr, nullptr, total_bytes, total_rows))) {
         STORAGE_LOG(WARN, "Failed to get estimate size from memtable", K(ret));
-      } else if (MTL(ObTenantDagScheduler *)->get_up_limit(ObDagPrio::DAG_PRIO_COMPACTION_HIGH, mini_merge_thread)) {
+      } else if (OB_FAIL(MTL(ObTenantDagScheduler *)->get_up_limit(ObDagPrio::DAG_PRIO_COMPACTION_HIGH, mini_merge_thread))) {
         STORAGE_LOG(WARN, "failed to get uplimit", K(ret), K(mini_merge_thread));
       } else {
         ObArray<ObStoreRange> store_ranges;
-        mini_merge_thread = MAX(mini_merge_thread, PARALLEL_MERGE_TARGET_TASK_CNT);
-        concurrent_cnt_ = MIN((total_bytes + tablet_size - 1) / tablet_size, mini_merge_thread);
-        if (concurrent_cnt_ <= 1) {
+        if (OB_FAIL(get_mini_merge_concurrent_cnt(tablet_size, total_bytes, memtable->get_occupied_size(),
+                                                  mini_merge_thread, concurrent_cnt_))) {
+          STORAGE_LOG(WARN, "failed to get mini merge concurrent cnt", K(ret), K(tablet_size), K(total_bytes));
+        } else if (concurrent_cnt_ <= 1) {
           if (OB_FAIL(init_serial_merge())) {
             STORAGE_LOG(WARN, "Failed to init serialize merge", K(ret));
           }
@@ -426,6 +427,29 @@ int ObParallelMergeCtx::calc_mini_minor_parallel_degree(const int64_t tablet_siz
 }
 
 
+int ObParallelMergeCtx::get_mini_merge_concurrent_cnt(
+    const int64_t tablet_size,
+    const int64_t estimate_bytes,
+    const int64_t occupied_size,
+    const int64_t thread_limit,
+    int64_t &concurrent_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(tablet_size < 0 || estimate_bytes < 0 || occupied_size < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(tablet_size), K(estimate_bytes), K(occupied_size));
+  } else if (0 == tablet_size) {
+    concurrent_cnt = 1;
+  } else {
+    // the estimation of btree assumes a fixed row size, rows wider than that
+    // are accounted by the memory the memtable occupies
+    const int64_t total_bytes = MAX(estimate_bytes, occupied_size);
+    const int64_t max_thread = MAX(thread_limit, PARALLEL_MERGE_TARGET_TASK_CNT);
+    concurrent_cnt = MIN((total_bytes + tablet_size - 1) / tablet_size, max_thread);
+  }
+  return ret;
+}
+
 int ObParallelMergeCtx::get_concurrent_cnt(
     const int64_t tablet_size,
     const int64_t macro_block_cnt,
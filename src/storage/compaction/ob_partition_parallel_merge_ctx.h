@@ -58,6 +58,14 @@ public:
       const int64_t tablet_size,
       const int64_t macro_block_cnt,
       int64_t &concurrent_cnt);
+  // task count of the parallel mini merge of a memtable, by the larger of the
+  // btree estimation and the memory it occupies
+  static int get_mini_merge_concurrent_cnt(
+      const int64_t tablet_size,
+      const int64_t estimate_bytes,
+      const int64_t occupied_size,
+      const int64_t thread_limit,
+      int64_t &concurrent_cnt);
   TO_STRING_KV(K_(parallel_type), K_(range_array), K_(concurrent_cnt), K_(is_inited));
 private:
   static const int64_t MIN_PARALLEL_MINOR_MERGE_THREASHOLD = 2;
@@ -79,8 +79,10 @@ int ObMvccValueIterator::lock_for_read_(const ObQueryFlag &flag)
 {
   int ret = OB_SUCCESS;
   int64_t lock_start_time = OB_INVALID_TIMESTAMP;
-  // the head of the read position
-  ObMvccTransNode *iter = value_->get_list_head();
+  // the head of the read position, the read latest need see its own writes
+  ObMvccTransNode *iter = flag.is_read_latest()
+    ? value_->get_list_head()
+    : value_->get_read_start_node(ctx_->get_snapshot_version());
   // the resolved mvcc read position
   version_iter_ = NULL;
   lock_begin(lock_start_time);
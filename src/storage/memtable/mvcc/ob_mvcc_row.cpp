@@ -329,12 +329,47 @@ void ObMvccRow::reset()
   latest_compact_node_ = NULL;
   latest_compact_ts_ = 0;
   index_ = NULL;
+  version_index_ = NULL;
   total_trans_node_cnt_ = 0;
   last_compact_cnt_ = 0;
   max_modify_count_ = UINT32_MAX;
   min_modify_count_ = UINT32_MAX;
 }
 
+ObMvccTransNode *ObMvccRowVersionIndex::get_checkpoint(const SCN snapshot_version) const
+{
+  ObMvccTransNode *checkpoint = NULL;
+  const int64_t seq = ATOMIC_LOAD_ACQ(&seq_);
+  if (0 == (seq & 1)) {
+    // the commit versions on the chain are increasing from oldest to newest,
+    // so all the nodes newer than a checkpoint bigger than the snapshot are
+    // also bigger than the snapshot
+    for (int64_t i = ATOMIC_LOAD(&cnt_) - 1; NULL == checkpoint && i >= 0; --i) {
+      if (versions_[i] > snapshot_version) {
+        checkpoint = ATOMIC_LOAD(&nodes_[i]);
+      }
+    }
+    MEM_BARRIER();
+    if (seq != ATOMIC_LOAD(&seq_)) {
+      // rebuilt during the lookup, the checkpoint may be a torn one
+      checkpoint = NULL;
+    }
+  }
+  return checkpoint;
+}
+
+ObMvccTransNode *ObMvccRow::get_read_start_node(const SCN snapshot_version) const
+{
+  ObMvccTransNode *start = ATOMIC_LOAD(&list_head_);
+  const ObMvccRowVersionIndex *version_index = ATOMIC_LOAD(&version_index_);
+  ObMvccTransNode *checkpoint = NULL;
+  if (NULL != version_index
+      && NULL != (checkpoint = version_index->get_checkpoint(snapshot_version))) {
+    start = ATOMIC_LOAD(&(checkpoint->prev_));
+  }
+  return start;
+}
+
 int64_t ObMvccRow::to_string(char *buf, const int64_t buf_len) const
 {
   int64_t pos = 0;
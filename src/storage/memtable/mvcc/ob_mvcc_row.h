@@ -145,6 +145,35 @@ private:
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// ObMvccRowVersionIndex is the sparse checkpoints of committed tx nodes on a
+// long version chain ordered from newest to oldest. A read with an old snapshot
+// can skip the newer nodes before the oldest checkpoint bigger than its
+// snapshot instead of walking them one by one. A row allocates at most one
+// index, and the row compaction rebuilds it in place under the row latch.
+// seq_ is odd while it is being rebuilt, and readers that see it changed
+// during the lookup fall back to the head of the chain.
+struct ObMvccRowVersionIndex
+{
+  static const int64_t MAX_CHECKPOINT_CNT = 8;
+  static const int64_t MIN_STRIDE = 16;
+  // chains shorter than it are not indexed
+  static const int64_t MIN_INDEX_NODE_CNT = 64;
+
+  ObMvccRowVersionIndex() : seq_(0), cnt_(0), node_cnt_(0), stride_(0) {}
+  void begin_rebuild() { (void)ATOMIC_AAF(&seq_, 1); }
+  void end_rebuild() { (void)ATOMIC_AAF(&seq_, 1); }
+  // get the newest checkpoint that can be skipped by the snapshot, return
+  // NULL if there is none or the index is rebuilt concurrently
+  ObMvccTransNode *get_checkpoint(const share::SCN snapshot_version) const;
+  int64_t seq_;
+  int64_t cnt_;
+  // the tx node count of the row when built
+  int64_t node_cnt_;
+  int64_t stride_;
+  share::SCN versions_[MAX_CHECKPOINT_CNT];
+  ObMvccTransNode *nodes_[MAX_CHECKPOINT_CNT];
+};
+
 // ObMvccRow is the row contains all multi-version tx node for the specified
 // key, and all tx node is bidirectional linked and ordered with newest to
 // oldest.
@@ -197,6 +226,8 @@ struct ObMvccRow
   ObMvccTransNode *latest_compact_node_;
   // using for optimizing inserting trans node when replaying
   ObMvccRowIndex *index_;
+  // using for skipping newer trans nodes when reading with old snapshot
+  ObMvccRowVersionIndex *version_index_;
   int64_t total_trans_node_cnt_;
   int64_t latest_compact_ts_;
   int64_t last_compact_cnt_;
@@ -293,6 +324,9 @@ struct ObMvccRow
   bool is_empty() const { return (NULL == ATOMIC_LOAD(&list_head_)); }
   // get_list_head gets the head tx node
   ObMvccTransNode *get_list_head() const { return ATOMIC_LOAD(&list_head_); }
+  // get_read_start_node gets the tx node from which the snapshot read starts
+  // to search the version to read, all the newer ones are invisible to it
+  ObMvccTransNode *get_read_start_node(const share::SCN snapshot_version) const;
   // is_valid_replay_queue_index returns whether the index is a valid replay queue
   bool is_valid_replay_queue_index(const int64_t index) const;
 
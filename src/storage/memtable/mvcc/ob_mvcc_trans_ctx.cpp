@@ -320,6 +320,7 @@ int ObTransCallbackMgr::rollback_to(const int64_t to_seq_no,
   if (0 > to_seq_no || 0 > from_seq_no) {
     ret = OB_INVALID_ARGUMENT;
     TRANS_LOG(WARN, "invalid argument", K(ret), K(from_seq_no), K(to_seq_no));
+  } else if (FALSE_IT(merge_multi_callback_lists())) {
   } else if (OB_FAIL(callback_list_.remove_callbacks_for_rollback_to(to_seq_no))) {
     TRANS_LOG(WARN, "invalid argument", K(ret), K(from_seq_no), K(to_seq_no));
   }
@@ -329,15 +330,9 @@ int ObTransCallbackMgr::rollback_to(const int64_t to_seq_no,
 void ObTransCallbackMgr::merge_multi_callback_lists()
 {
   int64_t stat = ATOMIC_LOAD(&parallel_stat_);
-  int64_t cnt = 0;
-  if (PARALLEL_STMT == stat) {
+  if (PARALLEL_STMT == stat && has_unmerged_callbacks_()) {
     WRLockGuard guard(rwlock_);
-    if (OB_NOT_NULL(callback_lists_)) {
-      for (int64_t i = 0; i < MAX_CALLBACK_LIST_COUNT; ++i) {
-        cnt = callback_list_.concat_callbacks(callback_lists_[i]);
-        add_slave_list_merge_cnt(cnt);
-      }
-    }
+    merge_multi_callback_lists_();
 #ifndef NDEBUG
     TRANS_LOG(INFO, "merge callback lists to callback list", K(stat), K(host_.get_tx_id()));
 #endif
@@ -346,15 +341,19 @@ void ObTransCallbackMgr::merge_multi_callback_lists()
 
 void ObTransCallbackMgr::force_merge_multi_callback_lists()
 {
-  int64_t cnt = 0;
   WRLockGuard guard(rwlock_);
+  merge_multi_callback_lists_();
+  TRANS_LOG(DEBUG, "force merge callback lists to callback list", K(host_.get_tx_id()));
+}
+
+// The callbacks of all writers are merged by seq_no, which keeps the order of
+// callbacks on the same row, as a row is appended under its row latch before
+// it can be written again.
+void ObTransCallbackMgr::merge_multi_callback_lists_()
+{
   if (OB_NOT_NULL(callback_lists_)) {
-    for (int64_t i = 0; i < MAX_CALLBACK_LIST_COUNT; ++i) {
-      cnt = callback_list_.concat_callbacks(callback_lists_[i]);
-      add_slave_list_merge_cnt(cnt);
-    }
+    add_slave_list_merge_cnt(callback_list_.merge_callbacks(callback_lists_, MAX_CALLBACK_LIST_COUNT));
   }
-  TRANS_LOG(DEBUG, "force merge callback lists to callback list", K(host_.get_tx_id()));
 }
 
 transaction::ObPartTransCtx *ObTransCallbackMgr::get_trans_ctx() const
@@ -383,6 +382,7 @@ int ObTransCallbackMgr::remove_callbacks_for_fast_commit(bool &has_remove)
 {
   int ret = OB_SUCCESS;
 
+  merge_multi_callback_lists();
   if (OB_FAIL(callback_list_.remove_callbacks_for_fast_commit(has_remove))) {
     TRANS_LOG(WARN, "remove callbacks for fast commit fail", K(ret));
   }
@@ -397,6 +397,7 @@ int ObTransCallbackMgr::remove_callback_for_uncommited_txn(ObIMemtable *memtable
   if (OB_ISNULL(memtable)) {
     ret = OB_INVALID_ARGUMENT;
     TRANS_LOG(WARN, "memtable is null", K(ret));
+  } else if (FALSE_IT(merge_multi_callback_lists())) {
   } else if (OB_FAIL(callback_list_.remove_callbacks_for_remove_memtable(memtable))) {
     TRANS_LOG(WARN, "fifo remove callback fail", K(ret), K(*memtable));
   }
@@ -408,6 +409,7 @@ int ObTransCallbackMgr::clean_unlog_callbacks(int64_t &removed_cnt)
 {
   int ret = OB_SUCCESS;
 
+  merge_multi_callback_lists();
   if (OB_FAIL(callback_list_.clean_unlog_callbacks(removed_cnt))) {
     TRANS_LOG(WARN, "clean unlog callbacks failed", K(ret));
   }
@@ -424,6 +426,7 @@ int ObTransCallbackMgr::calc_checksum_before_scn(const SCN scn,
   if (SCN::max_scn() == scn) {
     ret = OB_ERR_UNEXPECTED;
     TRANS_LOG(ERROR, "log ts is invalid", K(scn));
+  } else if (FALSE_IT(merge_multi_callback_lists())) {
   } else if (OB_FAIL(callback_list_.tx_calc_checksum_before_scn(scn))) {
     TRANS_LOG(WARN, "calc checksum with minor freeze failed", K(ret), K(scn));
   } else {
@@ -480,6 +483,7 @@ int ObTransCallbackMgr::get_memtable_key_arr(ObMemtableKeyArray &memtable_key_ar
 {
   int ret = OB_SUCCESS;
 
+  merge_multi_callback_lists();
   if (OB_FAIL(callback_list_.get_memtable_key_arr_w_timeout(memtable_key_arr))) {
     if (OB_ITER_STOP == ret) {
       ret = OB_SUCCESS;
@@ -531,12 +535,9 @@ void ObTransCallbackMgr::revert_callback_list()
       UNUSED(ATOMIC_BCAS(&parallel_stat_, stat, stat - 1));
     }
   } else {
-    // We need merge callback list for causality bwteen them
-    WRLockGuard guard(rwlock_);
-    if (OB_NOT_NULL(callback_lists_)) {
-      cnt = callback_list_.concat_callbacks(callback_lists_[slot]);
-      add_slave_list_merge_cnt(cnt);
-    }
+    // The callbacks are kept in the list of the writer, so that parallel
+    // writers don't contend on the callback list and the redo generation.
+    // They are merged by seq_no before any traverse of the callback list.
   }
 }
 
@@ -560,6 +561,7 @@ void ObTransCallbackMgr::set_for_replay(const bool for_replay)
 
 int ObTransCallbackMgr::replay_fail(const SCN scn)
 {
+  merge_multi_callback_lists();
   return callback_list_.replay_fail(scn);
 }
 
@@ -577,10 +579,14 @@ int ObTransCallbackMgr::trans_end(const bool commit)
   // exists and some data is cached in callback_lists, we need merge them into
   // main callback_list
   merge_multi_callback_lists();
-  if (commit) {
-    ret = callback_list_.tx_commit();
-  } else {
-    ret = callback_list_.tx_abort();
+  {
+    // wakeup the waiters of the released rows in batches
+    ObLockWaitMgr::BatchWakeupGuard wakeup_guard;
+    if (commit) {
+      ret = callback_list_.tx_commit();
+    } else {
+      ret = callback_list_.tx_abort();
+    }
   }
   if (OB_SUCC(ret)) {
     wakeup_waiting_txns_();
@@ -590,16 +596,19 @@ int ObTransCallbackMgr::trans_end(const bool commit)
 
 void ObTransCallbackMgr::calc_checksum_all()
 {
+  merge_multi_callback_lists();
   callback_list_.tx_calc_checksum_all();
 }
 
 void ObTransCallbackMgr::print_callbacks()
 {
+  merge_multi_callback_lists();
   callback_list_.tx_print_callback();
 }
 
 void ObTransCallbackMgr::elr_trans_preparing()
 {
+  merge_multi_callback_lists();
   callback_list_.tx_elr_preparing();
 }
 
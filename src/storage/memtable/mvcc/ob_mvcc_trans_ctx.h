@@ -235,7 +235,8 @@ public:
   int64_t get_flushed_log_size() { return ATOMIC_LOAD(&flushed_log_size_); }
   bool is_all_redo_submitted(ObITransCallback *generate_cursor)
   {
-    return (ObITransCallback *)callback_list_.get_tail() == generate_cursor;
+    return (ObITransCallback *)callback_list_.get_tail() == generate_cursor
+      && !has_unmerged_callbacks_();
   }
   void merge_multi_callback_lists();
   void reset_pdml_stat();
@@ -279,6 +280,12 @@ private:
     return (ObMvccRowCallback *)callback_list_.get_tail() == generate_cursor;
   }
   void force_merge_multi_callback_lists();
+  void merge_multi_callback_lists_();
+  // whether some callbacks are still in the callback lists of parallel writers
+  bool has_unmerged_callbacks_() const
+  {
+    return ATOMIC_LOAD(&callback_slave_list_append_count_) != ATOMIC_LOAD(&callback_slave_list_merge_count_);
+  }
 private:
   ObITransCallback *get_guard_() { return callback_list_.get_guard(); }
 private:
@@ -82,6 +82,65 @@ int64_t ObTxCallbackList::concat_callbacks(ObTxCallbackList &that)
   return cnt;
 }
 
+int64_t ObTxCallbackList::merge_callbacks(ObTxCallbackList *others, const int64_t cnt)
+{
+  int64_t merge_cnt = 0;
+  ObITransCallback *heads[OB_MAX_CPU_NUM];
+  ObITransCallback *tails[OB_MAX_CPU_NUM];
+  int64_t list_cnt = 0;
+
+  if (OB_ISNULL(others) || cnt > OB_MAX_CPU_NUM) {
+    for (int64_t i = 0; OB_NOT_NULL(others) && i < cnt; ++i) {
+      merge_cnt += concat_callbacks(others[i]);
+    }
+  } else {
+    // detach the callbacks of others first, so appenders only wait for a
+    // short moment while they are merged into this list
+    for (int64_t i = 0; i < cnt; ++i) {
+      ObTxCallbackList &that = others[i];
+      if (!that.empty()) {
+        SpinLockGuard that_lock(that.latch_);
+        heads[list_cnt] = that.head_.get_next();
+        tails[list_cnt] = that.get_tail();
+        tails[list_cnt]->set_next(NULL);
+        merge_cnt += that.get_length();
+        ++list_cnt;
+        that.reset();
+      }
+    }
+
+    if (list_cnt > 0) {
+      SpinLockGuard this_lock(latch_);
+      while (list_cnt > 1) {
+        int64_t min_idx = 0;
+        for (int64_t i = 1; i < list_cnt; ++i) {
+          if (heads[i]->get_seq_no() < heads[min_idx]->get_seq_no()) {
+            min_idx = i;
+          }
+        }
+        ObITransCallback *node = heads[min_idx];
+        if (NULL == (heads[min_idx] = node->get_next())) {
+          heads[min_idx] = heads[list_cnt - 1];
+          tails[min_idx] = tails[list_cnt - 1];
+          --list_cnt;
+        }
+        node->set_prev(get_tail());
+        node->set_next(&head_);
+        get_tail()->set_next(node);
+        head_.set_prev(node);
+      }
+      // the remaining list is concated at once
+      heads[0]->set_prev(get_tail());
+      tails[0]->set_next(&head_);
+      get_tail()->set_next(heads[0]);
+      head_.set_prev(tails[0]);
+      length_ += merge_cnt;
+    }
+  }
+
+  return merge_cnt;
+}
+
 int ObTxCallbackList::callback_(ObITxCallbackFunctor &functor)
 {
   return callback_(functor, get_guard(), get_guard());
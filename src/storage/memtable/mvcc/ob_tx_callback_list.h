@@ -48,6 +48,13 @@ public:
   // other. And it will return the concat number during concat_callbacks.
   int64_t concat_callbacks(ObTxCallbackList &other);
 
+  // merge_callbacks will move all callbacks in the cnt lists of others into
+  // itself in the order of seq_no and reset them, each of them is required to
+  // be ordered by seq_no. It returns the number of moved callbacks. It can be
+  // called while the others are being appended, while concurrent merges need
+  // be serialized by the caller.
+  int64_t merge_callbacks(ObTxCallbackList *others, const int64_t cnt);
+
   // remove_callbacks_for_fast_commit will remove all callbacks according to the
   // parameter _fast_commit_callback_count. It will only remove callbacks
   // without removing data by calling checkpoint_callback. So user need
@@ -105,6 +105,27 @@ ObLockWaitMgr::ObLockWaitMgr()
 
 ObLockWaitMgr::~ObLockWaitMgr() {}
 
+ObLockWaitMgr::BatchWakeupGuard::BatchWakeupGuard()
+{
+  WakeupBatch &batch = get_thread_wakeup_batch();
+  if (0 == batch.depth_++) {
+    batch.mgr_ = MTL(ObLockWaitMgr*);
+    batch.cnt_ = 0;
+  }
+}
+
+ObLockWaitMgr::BatchWakeupGuard::~BatchWakeupGuard()
+{
+  WakeupBatch &batch = get_thread_wakeup_batch();
+  if (0 == --batch.depth_) {
+    if (OB_NOT_NULL(batch.mgr_) && batch.cnt_ > 0) {
+      batch.mgr_->batch_wakeup_(batch.hashes_, batch.cnt_);
+    }
+    batch.mgr_ = NULL;
+    batch.cnt_ = 0;
+  }
+}
+
 int ObLockWaitMgr::mtl_init(ObLockWaitMgr *&lock_wait_mgr)
 {
   return lock_wait_mgr->init();
@@ -365,7 +386,36 @@ void ObLockWaitMgr::wakeup(uint64_t hash)
   TRANS_LOG(TRACE, "LockWaitMgr.wakeup.done", K(hash));
 }
 
-ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target)
+void ObLockWaitMgr::batch_wakeup_(const uint64_t *hashes, const int64_t cnt)
+{
+  TRANS_LOG(TRACE, "LockWaitMgr.batch_wakeup.start", K(cnt));
+  Node *waiters[BATCH_WAKEUP_SIZE];
+  int64_t waiter_cnt = 0;
+  {
+    CriticalGuard(get_qs());
+    for (int64_t i = 0; i < cnt && i < BATCH_WAKEUP_SIZE; i++) {
+      if (NULL != (waiters[waiter_cnt] = fetch_waiter_(hashes[i]))) {
+        waiter_cnt++;
+      }
+    }
+  }
+  if (waiter_cnt > 0) {
+    WaitQuiescent(get_qs());
+  }
+  for (int64_t i = 0; i < waiter_cnt; i++) {
+    Node *node = waiters[i];
+    EVENT_INC(MEMSTORE_WRITE_LOCK_WAKENUP_COUNT);
+    EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, ObTimeUtility::current_time() - node->lock_ts_);
+    node->on_retry_lock(node->hash());
+    (void)repost(node);
+  }
+  TRANS_LOG(TRACE, "LockWaitMgr.batch_wakeup.done", K(cnt), K(waiter_cnt));
+}
+
+ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter,
+                                         Node* target,
+                                         uint64_t &queue_hash,
+                                         int64_t &queue_depth)
 {
   CriticalGuard(get_qs());
   if (NULL != (iter = hash_.next(iter))) {
@@ -377,6 +427,15 @@ ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target)
     if (NULL != node && node->hash() == target->hash()) {
       target->set_block_sessid(node->sessid_);
     }
+    // requests of the same queue are adjacent, so the queue is counted once
+    if (queue_hash != target->hash()) {
+      queue_hash = target->hash();
+      queue_depth = 0;
+      while (NULL != node && node->hash() == queue_hash) {
+        queue_depth++;
+        node = (Node*)link_next(node);
+      }
+    }
   } else {
     target = NULL;
   }
@@ -386,33 +445,41 @@ ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target)
 ObLockWaitMgr::Node* ObLockWaitMgr::fetch_waiter(uint64_t hash)
 {
   Node* ret = NULL;
-  Node* node = NULL;
   {
     CriticalGuard(get_qs());
-    ATOMIC_INC(&sequence_[(hash >> 1) % LOCK_BUCKET_COUNT]);
-    node = hash_.get_next_internal(hash);
-    // we do not need to wake up if the request is not running
-    while(NULL != node && node->hash() <= hash) {
-      if (node->hash() == hash) {
-        if (node->get_run_ts() > ObTimeUtility::current_time()) {
-          // wake up the first task whose execution time is not yet
-          break;
+    ret = fetch_waiter_(hash);
+  }
+  if (NULL != ret) {
+    WaitQuiescent(get_qs());
+  }
+  return ret;
+}
+
+ObLockWaitMgr::Node* ObLockWaitMgr::fetch_waiter_(uint64_t hash)
+{
+  Node* ret = NULL;
+  Node* node = NULL;
+  inc_seq_(hash);
+  node = hash_.get_next_internal(hash);
+  // requests waiting on the same key are ordered by their receive time, so the
+  // first one is handed over the key and the others are kept waiting
+  while(NULL != node && node->hash() <= hash) {
+    if (node->hash() == hash) {
+      if (node->get_run_ts() > ObTimeUtility::current_time()) {
+        // wake up the first task whose execution time is not yet
+        break;
+      } else {
+        int err = 0;
+        while(-EAGAIN == (err = hash_.del(node, ret)))
+          ;
+        if (0 != err) {
+          ret = NULL;
         } else {
-          int err = 0;
-          while(-EAGAIN == (err = hash_.del(node, ret)))
-            ;
-          if (0 != err) {
-            ret = NULL;
-          } else {
-            break;
-          }
+          break;
         }
       }
-      node = (Node*)link_next(node);
     }
-  }
-  if (NULL != ret) {
-    WaitQuiescent(get_qs());
+    node = (Node*)link_next(node);
   }
   return ret;
 }
@@ -422,6 +489,8 @@ ObLink* ObLockWaitMgr::check_timeout()
   ObLink* tail = NULL;
   Node* iter = NULL;
   Node* node2del = NULL;
+  // hash of the previous request, requests waiting on the same key are adjacent
+  uint64_t last_hash = 0;
   static int64_t last_check_session_idle_ts = 0;
   bool need_check_session = false;
   const int64_t MAX_WAIT_TIME_US = 10 * 1000 * 1000;
@@ -444,7 +513,9 @@ ObLink* ObLockWaitMgr::check_timeout()
       TRANS_LOG(TRACE, "LOCK_MGR: check", K(*iter));
       uint64_t hash = iter->hash();
       uint64_t last_lock_seq = iter->lock_seq_;
-      uint64_t curr_lock_seq = ATOMIC_LOAD(&sequence_[(hash >> 1)% LOCK_BUCKET_COUNT]);
+      uint64_t curr_lock_seq = get_seq(hash);
+      const bool is_queue_head = (hash != last_hash);
+      last_hash = hash;
       if (iter->is_timeout() || has_set_stop()) {
         TRANS_LOG(WARN, "LOCK_MGR: req wait lock timeout", K(curr_lock_seq), K(last_lock_seq), K(*iter));
         need_check_session = true;
@@ -489,8 +560,10 @@ ObLink* ObLockWaitMgr::check_timeout()
           // session is killed, just pop the request
           node2del = iter;
           TRANS_LOG(INFO, "session is killed, pop the request",  "sessid", iter->sessid_, K(*iter), K(tmp_ret));
-        } else if (NULL == node2del && curr_ts - iter->lock_ts_ > MAX_WAIT_TIME_US/2) {
-          // in order to prevent missing to wakeup request, so we force to wakeup every 5s
+        } else if (NULL == node2del && is_queue_head && curr_ts - iter->lock_ts_ > MAX_WAIT_TIME_US/2) {
+          // in order to prevent missing to wakeup request, so we force to wakeup every 5s.
+          // Only the head of a queue is woken up, the others are woken up one by one
+          // after it retries, rather than all retrying together on a hot key.
           node2del = iter;
           iter->on_retry_lock(hash);
           TRANS_LOG(WARN, "LOCK_MGR: req wait lock cost too much time", K(curr_lock_seq), K(last_lock_seq), K(*iter));
@@ -712,7 +785,23 @@ int ObLockWaitMgr::transform_row_lock_to_tx_lock(const ObTabletID &tablet_id,
 void ObLockWaitMgr::wakeup(const ObTabletID &tablet_id, const Key& key)
 {
   TRANS_LOG(TRACE, "LockWaitMgr.wakeup.byRowKey", K(tablet_id), K(key), K(lbt()));
-  wakeup(hash_rowkey(tablet_id, key));
+  const uint64_t hash = hash_rowkey(tablet_id, key);
+  WakeupBatch &batch = get_thread_wakeup_batch();
+  if (batch.depth_ > 0 && this == batch.mgr_) {
+    bool is_dup = false;
+    for (int64_t i = 0; !is_dup && i < batch.cnt_; i++) {
+      is_dup = (hash == batch.hashes_[i]);
+    }
+    if (!is_dup) {
+      batch.hashes_[batch.cnt_++] = hash;
+      if (batch.cnt_ >= BATCH_WAKEUP_SIZE) {
+        batch_wakeup_(batch.hashes_, batch.cnt_);
+        batch.cnt_ = 0;
+      }
+    }
+  } else {
+    wakeup(hash);
+  }
 }
 
 void ObLockWaitMgr::wakeup(const ObTransID &tx_id)
@@ -186,6 +186,7 @@ public:
 public:
   enum { LOCK_BUCKET_COUNT = 16384};
   static const int64_t OB_SESSPAIR_COUNT = 16;
+  static const int64_t BATCH_WAKEUP_SIZE = 32;
   typedef ObMemtableKey Key;
   typedef rpc::ObLockWaitNode Node;
   typedef FixedHash2<Node> Hash;
@@ -194,6 +195,17 @@ public:
     TO_STRING_KV(K(sess_id_));
   };
   typedef ObSEArray<SessPair, OB_SESSPAIR_COUNT> DeadlockedSessionArray;
+  // The row wakeups issued while the guard is alive, e.g. by the callbacks of a
+  // transaction end, are collected and flushed in batches, so the waiters of
+  // different rows are fetched within one critical section and one quiescent wait.
+  class BatchWakeupGuard
+  {
+  public:
+    BatchWakeupGuard();
+    ~BatchWakeupGuard();
+  private:
+    DISALLOW_COPY_AND_ASSIGN(BatchWakeupGuard);
+  };
 
 public:
   ObLockWaitMgr();
@@ -265,7 +277,9 @@ public:
   DELEGATE_WITH_RET(row_holder_mapper_, set_hash_holder, void);
   DELEGATE_WITH_RET(row_holder_mapper_, reset_hash_holder, void);
   
-  Node* next(Node*& iter, Node* target);
+  // @queue_hash and @queue_depth keep the depth of the wait queue the last
+  // returned request belongs to, which is counted once for the whole queue
+  Node* next(Node*& iter, Node* target, uint64_t &queue_hash, int64_t &queue_depth);
 
   static Node*& get_thread_node()
   {
@@ -274,8 +288,14 @@ public:
   }
 
 protected:
-  // obtain the request waiting on the row or transaction
+  // obtain the request waiting on the row or transaction. The requests waiting
+  // on a key are ordered by receive time and only the first one is woken up.
+  // NB: the row is not reserved for it in the memtable, a newcomer may lock the
+  // row before it retries, and it then waits again ahead of the later requests.
   Node* fetch_waiter(uint64_t hash);
+  // same as fetch_waiter, but must be called in the critical section of qsync,
+  // the caller need wait quiescent before visiting the returned request
+  Node* fetch_waiter_(uint64_t hash);
   // check whether there exits requests already timeoutt or need be
   // retried(session is killed, deadlocked or son on), and wakeup and retry them
   ObLink* check_timeout();
@@ -289,7 +309,22 @@ private:
   bool wait(Node* node);
   Node* get(uint64_t hash);
   void wakeup(uint64_t hash);
+  // wakeup the first request waiting on each of the rows
+  void batch_wakeup_(const uint64_t *hashes, const int64_t cnt);
 private:
+  struct WakeupBatch
+  {
+    WakeupBatch() : mgr_(NULL), depth_(0), cnt_(0) {}
+    ObLockWaitMgr *mgr_;
+    int64_t depth_;
+    int64_t cnt_;
+    uint64_t hashes_[BATCH_WAKEUP_SIZE];
+  };
+  static WakeupBatch& get_thread_wakeup_batch()
+  {
+    RLOCAL_INLINE(WakeupBatch, batch);
+    return batch;
+  }
 
   static uint64_t& get_thread_hold_key()
   {
@@ -313,26 +348,35 @@ private:
     return is_empty;
   }
 
+  // A wakeup bumps the sequences of both slots of the hash, the request is
+  // regarded as missing its wakeup only if both of them have changed, so that
+  // the wakeups of other keys colliding in one slot don't make it standalone.
   bool check_wakeup_seq(uint64_t hash, int64_t lock_seq, bool &standalone_task)
   {
-    bool bool_ret = (ATOMIC_LOAD(&sequence_[(hash >> 1)% LOCK_BUCKET_COUNT]) == lock_seq);
-    if (bool_ret) {
-      standalone_task = false;
-    } else {
-      bool_ret = true;
-      standalone_task = true;
-    }
-    return bool_ret;
+    const uint64_t curr_seq = get_seq(hash);
+    standalone_task = ((curr_seq >> 32) != ((uint64_t)lock_seq >> 32))
+                      && ((uint32_t)curr_seq != (uint32_t)lock_seq);
+    return true;
   }
   int64_t get_seq(uint64_t hash)
   {
-    return ATOMIC_LOAD(&sequence_[(hash >> 1) % LOCK_BUCKET_COUNT]);
+    return (int64_t)(((uint64_t)ATOMIC_LOAD(&sequence_[0][seq_pos_(hash, 0)]) << 32)
+                     | ATOMIC_LOAD(&sequence_[1][seq_pos_(hash, 1)]));
+  }
+  void inc_seq_(uint64_t hash)
+  {
+    ATOMIC_INC(&sequence_[0][seq_pos_(hash, 0)]);
+    ATOMIC_INC(&sequence_[1][seq_pos_(hash, 1)]);
+  }
+  static int64_t seq_pos_(uint64_t hash, int64_t idx)
+  {
+    return (0 == idx ? (hash >> 1) : (hash >> 32)) % LOCK_BUCKET_COUNT;
   }
 
 private:
   bool is_inited_;
   Hash hash_;
-  int64_t sequence_[LOCK_BUCKET_COUNT];
+  uint32_t sequence_[2][LOCK_BUCKET_COUNT];
   char hash_buf_[sizeof(SpHashNode) * LOCK_BUCKET_COUNT];
 
 public:
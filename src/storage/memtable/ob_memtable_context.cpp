@@ -634,6 +634,8 @@ int ObMemtableCtx::fill_redo_log(char *buf,
     TRANS_LOG(WARN, "invalid param");
     ret = OB_INVALID_ARGUMENT;
   } else {
+    // callbacks of parallel writers are merged lazily
+    trans_mgr_.merge_multi_callback_lists();
     if (OB_FAIL(log_gen_.fill_redo_log(buf,
                                        buf_len,
                                        buf_pos,
@@ -96,6 +96,9 @@ int ObMemtableRowCompactor::compact(const SCN snapshot_version)
 
     if (OB_NOT_NULL(compact_node)) {
       insert_compact_node_(compact_node, start);
+      if (!for_replay_) {
+        build_version_index_();
+      }
     }
     tg.click();
   }
@@ -386,5 +389,57 @@ void ObMemtableRowCompactor::insert_compact_node_(ObMvccTransNode *tx_node,
   ATOMIC_STORE(&(row_->update_since_compact_), 0);
 }
 
+// The version index is rebuilt once a stride of new tx nodes is linked since
+// the last build, so the cost of walking the chain is amortized among writes.
+// The index allocated by the first build is reused by the later ones, so a
+// row holds at most one index however long its chain grows.
+void ObMemtableRowCompactor::build_version_index_()
+{
+  ObMvccRowVersionIndex *index = row_->version_index_;
+  const int64_t node_cnt = row_->total_trans_node_cnt_;
+  void *buf = NULL;
+
+  if (node_cnt < ObMvccRowVersionIndex::MIN_INDEX_NODE_CNT) {
+    // chain is short enough
+  } else if (NULL != index && node_cnt - index->node_cnt_ < index->stride_) {
+    // index is fresh enough
+  } else if (NULL == index
+             && OB_ISNULL(buf = node_alloc_->alloc(sizeof(ObMvccRowVersionIndex)))) {
+    TRANS_LOG(WARN, "failed to alloc version index", K(node_cnt));
+  } else {
+    if (NULL == index) {
+      index = new (buf) ObMvccRowVersionIndex();
+    } else {
+      index->begin_rebuild();
+    }
+    index->cnt_ = 0;
+    index->node_cnt_ = node_cnt;
+    index->stride_ = MAX(ObMvccRowVersionIndex::MIN_STRIDE,
+                         node_cnt / (ObMvccRowVersionIndex::MAX_CHECKPOINT_CNT + 1));
+    SCN last_version = SCN::max_scn();
+    int64_t pos = 0;
+    for (ObMvccTransNode *iter = row_->list_head_;
+         NULL != iter && index->cnt_ < ObMvccRowVersionIndex::MAX_CHECKPOINT_CNT;
+         iter = iter->prev_) {
+      ++pos;
+      // only committed nodes whose version is decided are used as checkpoint
+      if (pos >= index->stride_ * (index->cnt_ + 1)
+          && iter->is_committed()
+          && SCN::max_scn() != iter->trans_version_
+          && iter->trans_version_ < last_version) {
+        last_version = iter->trans_version_;
+        index->versions_[index->cnt_] = last_version;
+        index->nodes_[index->cnt_] = iter;
+        index->cnt_++;
+      }
+    }
+    if (NULL == buf) {
+      index->end_rebuild();
+    } else {
+      ATOMIC_STORE(&(row_->version_index_), index);
+    }
+  }
+}
+
 }
 }
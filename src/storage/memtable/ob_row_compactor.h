@@ -65,6 +65,7 @@ private:
                                             ObMvccTransNode *tnode);
   void insert_compact_node_(ObMvccTransNode *trans_node,
                             ObMvccTransNode *save);
+  void build_version_index_();
 private:
   bool is_inited_;
   ObMvccRow *row_;
@@ -188,7 +188,8 @@ int ObBloomFilterBuildTask::build_bloom_filter()
         if (OB_UNLIKELY(OB_ITER_END != ret)) {
           LOG_WARN("Fail to iterate macro block", K(ret));
         } else if (OB_FAIL(ObStorageCacheSuite::get_instance().get_bf_cache().put_bloom_filter(
-            tenant_id_, macro_id_, bfcache_value, true/* adaptive */))) {
+            tenant_id_, ObTabletID(macro_header.fixed_header_.tablet_id_), macro_id_, bfcache_value,
+            true/* adaptive */))) {
           LOG_WARN("Fail to put value to bloom filter cache", K(ret), K_(tenant_id), K_(macro_id));
         }
       }
@@ -276,7 +277,7 @@ int ObBloomFilterLoadTask::process()
       LOG_WARN("Unexpected bloomfilter cache value", K_(tenant_id), K_(macro_id), K(bf_cache_value),
                 K(ret));
     } else if (OB_FAIL(ObStorageCacheSuite::get_instance().get_bf_cache().put_bloom_filter(
-        tenant_id_, macro_id_, bf_cache_value))) {
+        tenant_id_, ObTabletID(), macro_id_, bf_cache_value))) {
       LOG_WARN("Fail to put value to bloom filter cache",
           K_(tenant_id), K_(macro_id), K(bf_cache_value), K(ret));
     } else {
@@ -41,6 +41,7 @@ void ObGtsStatistics::reset()
   try_get_gts_with_stc_cnt_ = 0;
   wait_gts_elapse_cnt_ = 0;
   try_wait_gts_elapse_cnt_ = 0;
+  batched_gts_query_cnt_ = 0;
 }
 
 int ObGtsStatistics::init(const uint64_t tenant_id)
@@ -67,7 +68,8 @@ void ObGtsStatistics::statistics()
                       "try_get_gts_cache_cnt", ATOMIC_LOAD(&try_get_gts_cache_cnt_),
                       "try_get_gts_with_stc_cnt", ATOMIC_LOAD(&try_get_gts_with_stc_cnt_),
                       "wait_gts_elapse_cnt", ATOMIC_LOAD(&wait_gts_elapse_cnt_),
-                      "try_wait_gts_elapse_cnt", ATOMIC_LOAD(&try_wait_gts_elapse_cnt_));
+                      "try_wait_gts_elapse_cnt", ATOMIC_LOAD(&try_wait_gts_elapse_cnt_),
+                      "batched_gts_query_cnt", ATOMIC_LOAD(&batched_gts_query_cnt_));
       ATOMIC_STORE(&gts_rpc_cnt_, 0);
       ATOMIC_STORE(&get_gts_cache_cnt_, 0);
       ATOMIC_STORE(&get_gts_with_stc_cnt_, 0);
@@ -75,6 +77,7 @@ void ObGtsStatistics::statistics()
       ATOMIC_STORE(&try_get_gts_with_stc_cnt_, 0);
       ATOMIC_STORE(&wait_gts_elapse_cnt_, 0);
       ATOMIC_STORE(&try_wait_gts_elapse_cnt_, 0);
+      ATOMIC_STORE(&batched_gts_query_cnt_, 0);
     }
   }
 
@@ -177,12 +180,9 @@ int ObGtsSource::get_gts(ObTsCbTask *task, int64_t &gts)
       TRANS_LOG(ERROR, "gts task push error", "ret", tmp_ret, KP(task));
       //overwrite retcode
       ret = tmp_ret;
-    } else {
-      const bool need_refresh_gts_location = false;
-      if (OB_SUCCESS != (tmp_ret = refresh_gts_(need_refresh_gts_location))) {
-        if (EXECUTE_COUNT_PER_SEC(16)) {
-          TRANS_LOG(WARN, "refresh gts failed", K(tmp_ret));
-        }
+    } else if (OB_SUCCESS != (tmp_ret = refresh_gts_for_waiters_())) {
+      if (EXECUTE_COUNT_PER_SEC(16)) {
+        TRANS_LOG(WARN, "refresh gts failed", K(tmp_ret));
       }
     }
   }
@@ -422,10 +422,9 @@ int ObGtsSource::wait_gts_elapse(const int64_t ts, ObTsCbTask *task, bool &need_
       }
       if (OB_SUCCESS == ret) {
         // ignore error code
-        const bool need_refresh_gts_location = false;
-        if (OB_SUCCESS != (tmp_ret = refresh_gts_(need_refresh_gts_location))) {
+        if (OB_SUCCESS != (tmp_ret = refresh_gts_for_waiters_())) {
           if (EXECUTE_COUNT_PER_SEC(16)) {
-            TRANS_LOG(WARN, "refresh gts failed", K(tmp_ret), K(need_refresh_gts_location));
+            TRANS_LOG(WARN, "refresh gts failed", K(tmp_ret));
           }
         }
       }
@@ -508,6 +507,22 @@ int ObGtsSource::refresh_gts(const bool need_refresh)
   return ret;
 }
 
+int ObGtsSource::refresh_gts_for_waiters()
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "not inited", K(ret));
+  } else if (0 < get_task_count()) {
+    ret = refresh_gts_for_waiters_();
+  } else {
+    // do nothing
+  }
+
+  return ret;
+}
+
 int ObGtsSource::refresh_gts_cache_leader_()
 {
   int ret = OB_SUCCESS;
@@ -589,6 +604,26 @@ int ObGtsSource::refresh_gts_(const bool need_refresh)
   return ret;
 }
 
+// Every queued task is called back on any gts response, so a request sent by
+// an earlier committer and not answered yet is shared by the tasks queued
+// after it, instead of sending one request per task. Tasks which are still not
+// satisfied by that response are served by the next gts wait tick.
+int ObGtsSource::refresh_gts_for_waiters_()
+{
+  int ret = OB_SUCCESS;
+  const MonotonicTs srr = gts_local_cache_.get_srr();
+  const MonotonicTs latest_srr = gts_local_cache_.get_latest_srr();
+  const MonotonicTs now = MonotonicTs::current_time();
+
+  if (latest_srr > srr && now.mts_ - latest_srr.mts_ < GTS_QUERY_BATCH_WINDOW_US) {
+    gts_statistics_.inc_batched_gts_query_cnt();
+  } else {
+    ret = refresh_gts_(false);
+  }
+
+  return ret;
+}
+
 void ObGtsSource::statistics_()
 {
   gts_statistics_.statistics();
@@ -51,6 +51,7 @@ public:
   void inc_try_get_gts_with_stc_cnt() { ATOMIC_INC(&try_get_gts_with_stc_cnt_); }
   void inc_wait_gts_elapse_cnt() { ATOMIC_INC(&wait_gts_elapse_cnt_); }
   void inc_try_wait_gts_elapse_cnt() { ATOMIC_INC(&try_wait_gts_elapse_cnt_); }
+  void inc_batched_gts_query_cnt() { ATOMIC_INC(&batched_gts_query_cnt_); }
   void statistics();
 private:
   uint64_t tenant_id_;
@@ -64,6 +65,8 @@ private:
 
   int64_t wait_gts_elapse_cnt_;
   int64_t try_wait_gts_elapse_cnt_;
+  // gts queries of waiters served by a request already in flight
+  int64_t batched_gts_query_cnt_;
 };
 
 class ObGtsSource
@@ -90,6 +93,8 @@ public:
   int wait_gts_elapse(const int64_t ts, ObTsCbTask *task, bool &need_wait);
   int wait_gts_elapse(const int64_t ts);
   int refresh_gts(const bool need_refresh);
+  // query gts for the queued tasks, called by the gts wait tick of ObTsMgr
+  int refresh_gts_for_waiters();
   bool is_external_consistent() { return true; }
   int refresh_gts_location() { return refresh_gts_location_(); }
   TO_STRING_KV(K_(tenant_id), K_(gts_local_cache), K_(server), K_(gts_cache_leader));
@@ -98,6 +103,7 @@ private:
   int refresh_gts_location_();
   int refresh_gts_(const bool need_refresh);
   int query_gts_(const common::ObAddr &leader);
+  int refresh_gts_for_waiters_();
   void statistics_();
   int get_gts_from_local_timestamp_service_(int64_t &gts,
                                             MonotonicTs &receive_gts_ts);
@@ -107,6 +113,8 @@ public:
   static const int64_t WAIT_GTS_QUEUE_COUNT = 1;
   static const int64_t WAIT_GTS_QUEUE_START_INDEX = GET_GTS_QUEUE_COUNT;
   static const int64_t TOTAL_GTS_QUEUE_COUNT = GET_GTS_QUEUE_COUNT + WAIT_GTS_QUEUE_COUNT;
+  // queued tasks share a gts request sent within this window and not answered yet
+  static const int64_t GTS_QUERY_BATCH_WINDOW_US = 1000;
 private:
   bool is_inited_;
   int64_t tenant_id_;
@@ -68,7 +68,10 @@ int ObGTSTaskQueue::foreach_task(const MonotonicTs srr,
   } else {
     int64_t last_tenant_id = OB_INVALID_TENANT_ID;
     MAKE_TENANT_SWITCH_SCOPE_GUARD(ts_guard);
-    while (OB_SUCCESS == ret) {
+    // visit every task queued before the response once, a task which is not
+    // satisfied is pushed back without holding back the tasks behind it
+    const int64_t task_count = queue_.size();
+    for (int64_t i = 0; OB_SUCCESS == ret && i < task_count; ++i) {
       common::ObLink *data = NULL;
       (void)queue_.pop(data);
       ObTsCbTask *task = static_cast<ObTsCbTask *>(data);
@@ -114,7 +117,6 @@ int ObGTSTaskQueue::foreach_task(const MonotonicTs srr,
               TRANS_LOG(ERROR, "push gts task failed", KR(ret), KP(task));
             } else {
               TRANS_LOG(DEBUG, "push back gts task", KP(task));
-              break;
             }
           } else {
             if (GET_GTS == task_type_) {
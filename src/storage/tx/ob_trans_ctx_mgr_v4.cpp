@@ -38,6 +38,9 @@ namespace transaction
 {
 
 void ObLSTxCtxIterator::reset() {
+  if (is_ready_ && OB_NOT_NULL(ls_tx_ctx_mgr_)) {
+    ls_tx_ctx_mgr_->unpin_tx_ctx_map();
+  }
   is_ready_ = false;
   current_bucket_pos_ = -1;
   ls_tx_ctx_mgr_ = NULL;
@@ -52,7 +55,11 @@ int ObLSTxCtxIterator::set_ready(ObLSTxCtxMgr* ls_tx_ctx_mgr)
   if (is_ready_) {
     OB_LOG(WARN, "ObLSTxCtxIterator is already ready");
     ret = OB_ERR_UNEXPECTED;
+  } else if (OB_ISNULL(ls_tx_ctx_mgr)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret));
   } else {
+    ls_tx_ctx_mgr->pin_tx_ctx_map();
     is_ready_ = true;
     ls_tx_ctx_mgr_ = ls_tx_ctx_mgr;
     tx_id_iter_.set_ready();
@@ -123,7 +130,7 @@ int ObLSTxCtxIterator::get_next_tx_id_(ObTransID& tx_id)
     if (OB_FAIL(tx_id_iter_.get_next(tx_id))) {
       if (OB_ITER_END == ret) {
         ++ current_bucket_pos_;
-        if (current_bucket_pos_ >= BUCKETS_CNT_) {
+        if (current_bucket_pos_ >= ls_tx_ctx_mgr_->get_tx_ctx_map_active_buckets_cnt()) {
           ret = OB_ITER_END;
         } else {
           tx_id_iter_.reset();
@@ -82,7 +82,7 @@ typedef common::ObSimpleIterator<ObLSTxCtxMgrStat,
 typedef common::ObSimpleIterator<ObTxLockStat,
         ObModIds::OB_TRANS_VIRTUAL_TABLE_TRANS_STAT, 16> ObTxLockStatIterator;
 
-typedef ObTransHashMap<ObTransID, ObTransCtx, TransCtxAlloc, common::SpinRWLock, 1 << 14 /*bucket_num*/> ObLSTxCtxMap;
+typedef ObTransHashMap<ObTransID, ObTransCtx, TransCtxAlloc, common::SpinRWLock, 1 << 18 /*max bucket_num*/> ObLSTxCtxMap;
 
 typedef common::LinkHashNode<share::ObLSID> ObLSTxCtxMgrHashNode;
 typedef common::LinkHashValue<share::ObLSID> ObLSTxCtxMgrHashValue;
@@ -359,6 +359,16 @@ public:
   static int64_t get_tx_ctx_map_buckets_cnt()
   { return ObLSTxCtxMap::get_buckets_cnt(); }
 
+  // Get the buckets in use of ObLSTxCtxMgr'hashtable, which grows and shrinks with the
+  // count of TxCtx unless pinned;
+  int64_t get_tx_ctx_map_active_buckets_cnt() const
+  { return ls_tx_ctx_map_.get_active_buckets_cnt(); }
+
+  // Forbid TxCtx moving between buckets of ObLSTxCtxMgr'hashtable, so that iterating
+  // bucket by bucket visits every TxCtx exactly once;
+  void pin_tx_ctx_map() { ls_tx_ctx_map_.pin_buckets(); }
+  void unpin_tx_ctx_map() { ls_tx_ctx_map_.unpin_buckets(); }
+
   // Get the minimum value of rec_scn of TxCtx in this ObLSTxCtxMgr;
   // This value is used as the starting point of the redo replay required by the ObTxCtxTable file;
   // @param [out] rec_scnMIN(TxCtx's rec_scn in ObLSTxCtxMgr)
@@ -735,12 +745,13 @@ private:
 // When the tx_id in ObTxIDIterator is exhausted, go to the next hash bucket to batch out all tx_ids;
 //
 // In this way, the additional memory can be controlled on the number of tx_id of a single bucket;
-// the current hashmap is divided into 16384 buckets; it can achieve a small additional memory footprint;
+// the hashmap is pinned while iterating, it keeps one tx_ctx per bucket on average; it can achieve
+// a small additional memory footprint;
 class ObLSTxCtxIterator
 {
 public:
-  ObLSTxCtxIterator() : BUCKETS_CNT_(ObLSTxCtxMgr::get_tx_ctx_map_buckets_cnt()) { reset(); }
-  ~ObLSTxCtxIterator() {}
+  ObLSTxCtxIterator() : is_ready_(false), ls_tx_ctx_mgr_(NULL) { reset(); }
+  ~ObLSTxCtxIterator() { reset(); }
   void reset();
 
   int set_ready(ObLSTxCtxMgr* ls_tx_ctx_mgr);
@@ -755,7 +766,6 @@ private:
 private:
   bool is_ready_;
   int64_t current_bucket_pos_;
-  const int64_t BUCKETS_CNT_;
   ObLSTxCtxMgr* ls_tx_ctx_mgr_;
   ObTxIDIterator tx_id_iter_;
 };
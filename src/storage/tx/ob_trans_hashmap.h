@@ -16,6 +16,8 @@
 #include "lib/ob_define.h"
 #include "lib/utility/ob_print_utils.h"
 #include "lib/container/ob_se_array.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/allocator/ob_qsync.h"
 /*
  * For Example
  * 
@@ -72,10 +74,11 @@ template<typename Value>
 class ObTransHashLink
 {
 public:
-  ObTransHashLink() : ref_(0), prev_(NULL), next_(NULL) {}
+  ObTransHashLink() : ref_(0), bucket_hash_(0), prev_(NULL), next_(NULL) {}
   ~ObTransHashLink()
   {
     ref_ = 0;
+    bucket_hash_ = 0;
     prev_ = NULL;
     next_ = NULL;
   }
@@ -96,6 +99,8 @@ public:
   }
   int32_t get_ref() const { return ref_; }
   int32_t ref_;
+  // hash of the key, to find the bucket of the value when buckets are split or merged
+  uint64_t bucket_hash_;
   Value *prev_;
   Value *next_;
 };
@@ -104,10 +109,23 @@ template<typename Key, typename Value, typename AllocHandle, typename LockType,
 class ObTransHashMap
 {
  typedef common::ObSEArray<Value *, 32> ValueArray;
+ // Buckets are allocated by segments on demand. The map starts with one segment and grows
+ // by linear hashing: one bucket is split at a time, so a resize never rehashes the whole
+ // map and never blocks other buckets. BUCKETS_CNT is the upper limit of the bucket count.
+ static const int64_t SEGMENT_SIZE = BUCKETS_CNT < 512 ? BUCKETS_CNT : 512;
+ static const int64_t SEGMENT_CNT = BUCKETS_CNT / SEGMENT_SIZE;
+ static const int64_t MIN_BUCKETS_CNT = SEGMENT_SIZE;
+ // buckets split or merged by one insertion or deletion at most
+ static const int64_t RESIZE_STEP = 16;
+ // merge buckets if the average length of chains is below 1 / SHRINK_FACTOR
+ static const int64_t SHRINK_FACTOR = 4;
+ static_assert(BUCKETS_CNT > 0 && 0 == (BUCKETS_CNT & (BUCKETS_CNT - 1)),
+               "buckets cnt should be power of 2");
 public:
-  ObTransHashMap() : is_inited_(false), total_cnt_(0)
+  ObTransHashMap() : is_inited_(false), bucket_cnt_(0), total_cnt_(0),
+                     is_resizing_(false), pin_cnt_(0)
   {
-    OB_ASSERT(BUCKETS_CNT > 0);
+    MEMSET(segments_, 0, sizeof(segments_));
   }
   ~ObTransHashMap() { destroy(); }
   int64_t count() const { return ATOMIC_LOAD(&total_cnt_); }
@@ -118,23 +136,27 @@ public:
       // del all value from hash backet
       Value *curr = nullptr;
       Value *next = nullptr;
-      for (int64_t i = 0; i < BUCKETS_CNT; ++i) {
-        {
-          BucketWLockGuard guard(buckets_[i].lock_, get_itid());
-
-          curr = buckets_[i].next_;
-          while (OB_NOT_NULL(curr)) {
-            next = curr->next_;
-            del_from_bucket_(i, curr);
-            // dec ref and free curr value
-            revert(curr);
-            curr = next;
-          }
+      const int64_t bucket_cnt = ATOMIC_LOAD(&bucket_cnt_);
+      for (int64_t i = 0; i < bucket_cnt; ++i) {
+        BucketWLockGuard guard(get_bucket_(i).lock_, get_itid());
+
+        curr = get_bucket_(i).next_;
+        while (OB_NOT_NULL(curr)) {
+          next = curr->next_;
+          del_from_bucket_(i, curr);
+          // dec ref and free curr value
+          revert(curr);
+          curr = next;
         }
-        // reset bucket
-        buckets_[i].reset();
       }
+      // reset bucket
+      for (int64_t i = 0; i < SEGMENT_CNT; ++i) {
+        free_segment_(i);
+      }
+      bucket_cnt_ = 0;
       total_cnt_ = 0;
+      is_resizing_ = false;
+      pin_cnt_ = 0;
       is_inited_ = false;
     }
   }
@@ -149,16 +171,12 @@ public:
       ret = OB_INIT_TWICE;
       TRANS_LOG(WARN, "ObTransHashMap init twice", K(ret));
     } else {
-      // init bucket, init lock in bucket
-      for (int64_t i = 0 ; OB_SUCC(ret) && i < BUCKETS_CNT; ++i) {
-        if (OB_FAIL(buckets_[i].init(mem_attr))) {
-          TRANS_LOG(WARN, "ObTransHashMap bucket init fail", K(ret));
-          for (int64_t j = 0 ; j <= i; ++j) {
-            buckets_[j].destroy();
-          }
-        }
-      }
-      if (OB_SUCC(ret)) {
+      mem_attr_ = mem_attr;
+      // init the first segment, init lock in bucket
+      if (OB_FAIL(alloc_segment_(0))) {
+        TRANS_LOG(WARN, "ObTransHashMap bucket init fail", K(ret));
+      } else {
+        bucket_cnt_ = MIN_BUCKETS_CNT;
         is_inited_ = true;
       }
     }
@@ -180,41 +198,51 @@ public:
       ret = OB_INVALID_ARGUMENT;
       TRANS_LOG(WARN, "invalid argument", K(key), KP(value));
     } else {
-      int64_t pos = key.hash() % BUCKETS_CNT;
-      BucketWLockGuard guard(buckets_[pos].lock_, get_itid());
-      Value *curr = buckets_[pos].next_;
+      CriticalGuard(get_qsync_());
+      const uint64_t hash = key.hash();
+      bool locked = false;
+      while (!locked) {
+        const int64_t pos = calc_pos_(hash, ATOMIC_LOAD(&bucket_cnt_));
+        ObTransHashHeader &bucket = get_bucket_(pos);
+        BucketWLockGuard guard(bucket.lock_, get_itid());
+        // the bucket may be split or merged before locked
+        if (pos == calc_pos_(hash, ATOMIC_LOAD(&bucket_cnt_))) {
+          locked = true;
+          Value *curr = bucket.next_;
 
-      while (OB_NOT_NULL(curr)) {
-        if (curr->contain(key)) {
-          break;
-        } else {
-          curr = curr->next_;
-        }
-      }
-      if (OB_ISNULL(curr)) {
-        // inc ref when value in hashmap
-        value->inc_ref(ref);
-        if (NULL != buckets_[pos].next_) {
-          buckets_[pos].next_->prev_ = value;
-        }
-        value->next_ = buckets_[pos].next_;
-        value->prev_ = NULL;
-        buckets_[pos].next_ = value;
-        ATOMIC_INC(&total_cnt_);
-      } else {
-        ret = OB_ENTRY_EXIST;
-        if (old_value) {
-          curr->inc_ref(1);
-          *old_value = curr;
+          while (OB_NOT_NULL(curr)) {
+            if (curr->contain(key)) {
+              break;
+            } else {
+              curr = curr->next_;
+            }
+          }
+          if (OB_ISNULL(curr)) {
+            // inc ref when value in hashmap
+            value->inc_ref(ref);
+            value->bucket_hash_ = hash;
+            link_to_bucket_(bucket, value);
+            ATOMIC_INC(&total_cnt_);
+          } else {
+            ret = OB_ENTRY_EXIST;
+            if (old_value) {
+              curr->inc_ref(1);
+              *old_value = curr;
+            }
+          }
         }
       }
     }
+    if (OB_SUCC(ret) && need_split_()) {
+      try_resize_();
+    }
     return ret;
   }
 
   int del(const Key &key, Value *value)
   {
     int ret = OB_SUCCESS;
+    bool deleted = false;
 
     if (IS_NOT_INIT) {
       ret = OB_NOT_INIT;
@@ -223,14 +251,12 @@ public:
       ret = OB_INVALID_ARGUMENT;
       TRANS_LOG(ERROR, "invalid argument", K(key), KP(value));
     } else {
-      int64_t pos = key.hash() % BUCKETS_CNT;
-      BucketWLockGuard guard(buckets_[pos].lock_, get_itid());
-      if (buckets_[pos].next_ != value &&
-          (NULL == value->prev_ && NULL == value->next_)) {
-        // do nothing
-      } else {
-        del_from_bucket_(pos, value);
-        revert(value);
+      deleted = del_by_hash_(key.hash(), value);
+    }
+    if (deleted) {
+      revert(value);
+      if (need_merge_()) {
+        try_resize_();
       }
     }
     return ret;
@@ -238,21 +264,7 @@ public:
 
   void del_from_bucket_(const int64_t pos, Value *curr)
   {
-    if (curr == buckets_[pos].next_) {
-      if (NULL == curr->next_) {
-        buckets_[pos].next_ = NULL;
-      } else {
-        buckets_[pos].next_ = curr->next_;
-        curr->next_->prev_ = curr->prev_;
-      }
-    } else {
-      curr->prev_->next_ = curr->next_;
-      if (NULL != curr->next_) {
-        curr->next_->prev_ = curr->prev_;
-      }
-    }
-    curr->prev_ = NULL;
-    curr->next_ = NULL;
+    unlink_from_bucket_(get_bucket_(pos), curr);
     ATOMIC_DEC(&total_cnt_);
   }
 
@@ -267,27 +279,36 @@ public:
       ret = OB_INVALID_ARGUMENT;
       TRANS_LOG(WARN, "invalid argument", K(key));
     } else {
-      Value *tmp_value = NULL;
-      int64_t pos = key.hash() % BUCKETS_CNT;
-
-      BucketRLockGuard guard(buckets_[pos].lock_, get_itid());
+      CriticalGuard(get_qsync_());
+      const uint64_t hash = key.hash();
+      bool locked = false;
+      while (!locked) {
+        Value *tmp_value = NULL;
+        const int64_t pos = calc_pos_(hash, ATOMIC_LOAD(&bucket_cnt_));
+        ObTransHashHeader &bucket = get_bucket_(pos);
+
+        BucketRLockGuard guard(bucket.lock_, get_itid());
+
+        if (pos == calc_pos_(hash, ATOMIC_LOAD(&bucket_cnt_))) {
+          locked = true;
+          tmp_value = bucket.next_;
+          while (OB_NOT_NULL(tmp_value)) {
+            if (tmp_value->contain(key)) {
+              value = tmp_value;
+              break;
+            } else {
+              tmp_value = tmp_value->next_;
+            }
+          }
 
-      tmp_value = buckets_[pos].next_;
-      while (OB_NOT_NULL(tmp_value)) {
-        if (tmp_value->contain(key)) {
-          value = tmp_value;
-          break;
-        } else {
-          tmp_value = tmp_value->next_;
+          if (OB_ISNULL(tmp_value)) {
+            ret = OB_ENTRY_NOT_EXIST;
+          } else {
+            // inc ref when get value
+            value->inc_ref(1);
+          }
         }
       }
-
-      if (OB_ISNULL(tmp_value)) {
-        ret = OB_ENTRY_NOT_EXIST;
-      } else {
-        // inc ref when get value
-        value->inc_ref(1);
-      }
     }
     return ret;
   }
@@ -304,12 +325,16 @@ public:
   template <typename Function> int for_each(Function &fn)
   {
     int ret = common::OB_SUCCESS;
-    for (int64_t pos = 0 ; OB_SUCC(ret) && pos < BUCKETS_CNT; ++pos) {
+    pin_buckets();
+    for (int64_t pos = 0 ; OB_SUCC(ret) && pos < ATOMIC_LOAD(&bucket_cnt_); ++pos) {
       ret = for_each_in_one_bucket(fn, pos);
     }
+    unpin_buckets();
     return ret;
   }
 
+  // values may move between buckets while iterating bucket by bucket, pin the buckets
+  // during the iteration to visit every value exactly once
   template <typename Function> int for_each_in_one_bucket(Function& fn, int64_t bucket_pos)
   {
     int ret = common::OB_SUCCESS;
@@ -340,7 +365,8 @@ public:
     int ret = common::OB_SUCCESS;
 
     ValueArray array;
-    for (int64_t pos = 0 ; pos < BUCKETS_CNT; ++pos) {
+    pin_buckets();
+    for (int64_t pos = 0 ; pos < ATOMIC_LOAD(&bucket_cnt_); ++pos) {
       array.reset();
       if (OB_FAIL(generate_value_arr_(pos, array))) {
         TRANS_LOG(WARN, "generate value array error", K(ret));
@@ -348,13 +374,7 @@ public:
         const int64_t cnt = array.count();
         for (int64_t i = 0; i < cnt; ++i) {
           if (fn(array.at(i))) {
-            BucketWLockGuard guard(buckets_[pos].lock_, get_itid());
-            if (buckets_[pos].next_ != array.at(i)
-                && (NULL == array.at(i)->prev_ && NULL == array.at(i)->next_)) {
-              // do nothing
-            } else {
-              del_from_bucket_(pos, array.at(i));
-            }
+            (void)del_by_hash_(array.at(i)->bucket_hash_, array.at(i));
           }
           if (0 == array.at(i)->dec_ref(1)) {
             alloc_handle_.free_value(array.at(i));
@@ -362,29 +382,35 @@ public:
         }
       }
     }
+    unpin_buckets();
     return ret;
   }
 
   int generate_value_arr_(const int64_t bucket_pos, ValueArray &arr)
   {
     int ret = common::OB_SUCCESS;
-    // read lock
-    BucketRLockGuard guard(buckets_[bucket_pos].lock_, get_itid());
-    Value *val = buckets_[bucket_pos].next_;
-
-    while (OB_SUCC(ret) && OB_NOT_NULL(val)) {
-      val->inc_ref(1);
-      if (OB_FAIL(arr.push_back(val))) {
-        TRANS_LOG(WARN, "value array push back error", K(ret));
-        val->dec_ref(1);
+    CriticalGuard(get_qsync_());
+    if (bucket_pos < ATOMIC_LOAD(&bucket_cnt_)) {
+      ObTransHashHeader &bucket = get_bucket_(bucket_pos);
+      // read lock
+      BucketRLockGuard guard(bucket.lock_, get_itid());
+      // the bucket is merged before locked
+      Value *val = bucket_pos < ATOMIC_LOAD(&bucket_cnt_) ? bucket.next_ : NULL;
+
+      while (OB_SUCC(ret) && OB_NOT_NULL(val)) {
+        val->inc_ref(1);
+        if (OB_FAIL(arr.push_back(val))) {
+          TRANS_LOG(WARN, "value array push back error", K(ret));
+          val->dec_ref(1);
+        }
+        val = val->next_;
       }
-      val = val->next_;
-    }
 
-    if (OB_FAIL(ret)) {
-      const int64_t cnt = arr.count();
-      for (int64_t i = 0; i < cnt; ++i) {
-        arr.at(i)->dec_ref(1);
+      if (OB_FAIL(ret)) {
+        const int64_t cnt = arr.count();
+        for (int64_t i = 0; i < cnt; ++i) {
+          arr.at(i)->dec_ref(1);
+        }
       }
     }
     return ret;
@@ -410,9 +436,28 @@ public:
     return ATOMIC_LOAD(&total_cnt_);
   }
 
+  // the upper limit of bucket pos, buckets beyond the active ones are empty
   static int64_t get_buckets_cnt() {
     return BUCKETS_CNT;
   }
+
+  int64_t get_active_buckets_cnt() const {
+    return ATOMIC_LOAD(&bucket_cnt_);
+  }
+
+  // forbid splitting and merging buckets until unpinned
+  void pin_buckets()
+  {
+    ATOMIC_INC(&pin_cnt_);
+    while (ATOMIC_LOAD(&is_resizing_)) {
+      sched_yield();
+    }
+  }
+
+  void unpin_buckets()
+  {
+    ATOMIC_DEC(&pin_cnt_);
+  }
 private:
   struct ObTransHashHeader
   {
@@ -518,13 +563,252 @@ private:
     return node;
   }
 
+  // readers hold the qsync while touching buckets, so that the segment of merged buckets
+  // is freed after the readers computing their pos with the old bucket cnt leave
+  static common::ObQSync &get_qsync_()
+  {
+    static common::ObQSync qsync;
+    return qsync;
+  }
+
+  static int64_t floor_pow2_(const int64_t x)
+  {
+    return 1L << (63 - __builtin_clzll(x));
+  }
+
+  // linear hashing, buckets [0, bucket_cnt - low) have been split by the high bit
+  static int64_t calc_pos_(const uint64_t hash, const int64_t bucket_cnt)
+  {
+    const uint64_t low = floor_pow2_(bucket_cnt);
+    uint64_t pos = hash & (2 * low - 1);
+    if (pos >= static_cast<uint64_t>(bucket_cnt)) {
+      pos = hash & (low - 1);
+    }
+    return static_cast<int64_t>(pos);
+  }
+
+  ObTransHashHeader &get_bucket_(const int64_t pos) const
+  {
+    return ATOMIC_LOAD(&segments_[pos / SEGMENT_SIZE])[pos % SEGMENT_SIZE];
+  }
+
+  static void link_to_bucket_(ObTransHashHeader &bucket, Value *value)
+  {
+    if (NULL != bucket.next_) {
+      bucket.next_->prev_ = value;
+    }
+    value->next_ = bucket.next_;
+    value->prev_ = NULL;
+    bucket.next_ = value;
+  }
+
+  static void unlink_from_bucket_(ObTransHashHeader &bucket, Value *curr)
+  {
+    if (curr == bucket.next_) {
+      if (NULL == curr->next_) {
+        bucket.next_ = NULL;
+      } else {
+        bucket.next_ = curr->next_;
+        curr->next_->prev_ = curr->prev_;
+      }
+    } else {
+      curr->prev_->next_ = curr->next_;
+      if (NULL != curr->next_) {
+        curr->next_->prev_ = curr->prev_;
+      }
+    }
+    curr->prev_ = NULL;
+    curr->next_ = NULL;
+  }
+
+  bool del_by_hash_(const uint64_t hash, Value *value)
+  {
+    bool deleted = false;
+    CriticalGuard(get_qsync_());
+    bool locked = false;
+    while (!locked) {
+      const int64_t pos = calc_pos_(hash, ATOMIC_LOAD(&bucket_cnt_));
+      ObTransHashHeader &bucket = get_bucket_(pos);
+      BucketWLockGuard guard(bucket.lock_, get_itid());
+      if (pos == calc_pos_(hash, ATOMIC_LOAD(&bucket_cnt_))) {
+        locked = true;
+        if (bucket.next_ != value &&
+            (NULL == value->prev_ && NULL == value->next_)) {
+          // do nothing
+        } else {
+          del_from_bucket_(pos, value);
+          deleted = true;
+        }
+      }
+    }
+    return deleted;
+  }
+
+  bool need_split_() const
+  {
+    const int64_t bucket_cnt = ATOMIC_LOAD(&bucket_cnt_);
+    return bucket_cnt < BUCKETS_CNT && ATOMIC_LOAD(&total_cnt_) > bucket_cnt;
+  }
+
+  bool need_merge_() const
+  {
+    const int64_t bucket_cnt = ATOMIC_LOAD(&bucket_cnt_);
+    return bucket_cnt > MIN_BUCKETS_CNT && ATOMIC_LOAD(&total_cnt_) < bucket_cnt / SHRINK_FACTOR;
+  }
+
+  // split or merge at most RESIZE_STEP buckets, skip if someone else is resizing
+  void try_resize_()
+  {
+    if (ATOMIC_BCAS(&is_resizing_, false, true)) {
+      int64_t retired_segment = -1;
+      bool stop = ATOMIC_LOAD(&pin_cnt_) > 0;
+      for (int64_t i = 0; !stop && i < RESIZE_STEP; ++i) {
+        if (need_split_()) {
+          stop = OB_SUCCESS != split_bucket_();
+        } else if (need_merge_()) {
+          retired_segment = merge_bucket_();
+          stop = retired_segment >= 0;
+        } else {
+          stop = true;
+        }
+      }
+      if (retired_segment >= 0) {
+        WaitQuiescent(get_qsync_());
+        free_segment_(retired_segment);
+      }
+      ATOMIC_STORE(&is_resizing_, false);
+    }
+  }
+
+  // move values of the bucket [bucket_cnt - low] whose hash has the high bit into the
+  // new bucket [bucket_cnt]
+  int split_bucket_()
+  {
+    int ret = OB_SUCCESS;
+    const int64_t bucket_cnt = ATOMIC_LOAD(&bucket_cnt_);
+    const int64_t new_pos = bucket_cnt;
+    const int64_t old_pos = new_pos - floor_pow2_(new_pos);
+    const int64_t segment_idx = new_pos / SEGMENT_SIZE;
+
+    if (OB_ISNULL(segments_[segment_idx]) && OB_FAIL(alloc_segment_(segment_idx))) {
+      TRANS_LOG(WARN, "alloc bucket segment failed", K(ret), K(segment_idx));
+    } else {
+      ObTransHashHeader &old_bucket = get_bucket_(old_pos);
+      ObTransHashHeader &new_bucket = get_bucket_(new_pos);
+      // lock buckets in the order of pos
+      if (OB_FAIL(old_bucket.lock_.wrlock())) {
+        TRANS_LOG(WARN, "lock old bucket failed", K(ret), K(old_pos));
+      } else {
+        if (OB_FAIL(new_bucket.lock_.wrlock())) {
+          TRANS_LOG(WARN, "lock new bucket failed", K(ret), K(new_pos));
+        } else {
+          Value *curr = old_bucket.next_;
+          while (OB_NOT_NULL(curr)) {
+            Value *next = curr->next_;
+            if (new_pos == calc_pos_(curr->bucket_hash_, bucket_cnt + 1)) {
+              unlink_from_bucket_(old_bucket, curr);
+              link_to_bucket_(new_bucket, curr);
+            }
+            curr = next;
+          }
+          ATOMIC_STORE(&bucket_cnt_, bucket_cnt + 1);
+          new_bucket.lock_.wrunlock();
+        }
+        old_bucket.lock_.wrunlock();
+      }
+    }
+    return ret;
+  }
+
+  // move all values of the last bucket back into the bucket it was split from,
+  // return the segment idx if the whole segment is no longer used
+  int64_t merge_bucket_()
+  {
+    int ret = OB_SUCCESS;
+    int64_t retired_segment = -1;
+    const int64_t bucket_cnt = ATOMIC_LOAD(&bucket_cnt_);
+    const int64_t src_pos = bucket_cnt - 1;
+    const int64_t dst_pos = src_pos - floor_pow2_(src_pos);
+    ObTransHashHeader &dst_bucket = get_bucket_(dst_pos);
+    ObTransHashHeader &src_bucket = get_bucket_(src_pos);
+
+    if (OB_FAIL(dst_bucket.lock_.wrlock())) {
+      TRANS_LOG(WARN, "lock dst bucket failed", K(ret), K(dst_pos));
+    } else {
+      if (OB_FAIL(src_bucket.lock_.wrlock())) {
+        TRANS_LOG(WARN, "lock src bucket failed", K(ret), K(src_pos));
+      } else {
+        Value *curr = src_bucket.next_;
+        while (OB_NOT_NULL(curr)) {
+          Value *next = curr->next_;
+          unlink_from_bucket_(src_bucket, curr);
+          link_to_bucket_(dst_bucket, curr);
+          curr = next;
+        }
+        ATOMIC_STORE(&bucket_cnt_, bucket_cnt - 1);
+        if (0 == src_pos % SEGMENT_SIZE) {
+          retired_segment = src_pos / SEGMENT_SIZE;
+        }
+        src_bucket.lock_.wrunlock();
+      }
+      dst_bucket.lock_.wrunlock();
+    }
+    return retired_segment;
+  }
+
+  int alloc_segment_(const int64_t segment_idx)
+  {
+    int ret = OB_SUCCESS;
+    ObTransHashHeader *segment = NULL;
+    if (OB_ISNULL(segment = static_cast<ObTransHashHeader *>(
+        ob_malloc(sizeof(ObTransHashHeader) * SEGMENT_SIZE, mem_attr_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      TRANS_LOG(WARN, "alloc bucket segment failed", K(ret), K(segment_idx));
+    } else {
+      for (int64_t i = 0; i < SEGMENT_SIZE; ++i) {
+        new (segment + i) ObTransHashHeader();
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < SEGMENT_SIZE; ++i) {
+        if (OB_FAIL(segment[i].init(mem_attr_))) {
+          TRANS_LOG(WARN, "ObTransHashMap bucket init fail", K(ret));
+        }
+      }
+      if (OB_FAIL(ret)) {
+        for (int64_t i = 0; i < SEGMENT_SIZE; ++i) {
+          segment[i].~ObTransHashHeader();
+        }
+        ob_free(segment);
+      } else {
+        ATOMIC_STORE(&segments_[segment_idx], segment);
+      }
+    }
+    return ret;
+  }
+
+  void free_segment_(const int64_t segment_idx)
+  {
+    ObTransHashHeader *segment = segments_[segment_idx];
+    if (OB_NOT_NULL(segment)) {
+      ATOMIC_STORE(&segments_[segment_idx], NULL);
+      for (int64_t i = 0; i < SEGMENT_SIZE; ++i) {
+        segment[i].~ObTransHashHeader();
+      }
+      ob_free(segment);
+    }
+  }
+
 private:
-  // sizeof(ObTransHashMap) = BUCKETS_CNT * sizeof(LockType);
+  // sizeof(ObTransHashHeader) = 16B + sizeof(LockType);
   // sizeof(SpinRWLock) = 20B;
   // sizeof(QsyncLock) = 4K;
+  // only the segments covering the active buckets are allocated
   bool is_inited_;
-  ObTransHashHeader buckets_[BUCKETS_CNT];
+  lib::ObMemAttr mem_attr_;
+  ObTransHashHeader *segments_[SEGMENT_CNT];
+  int64_t bucket_cnt_;
   int64_t total_cnt_;
+  bool is_resizing_;
+  int64_t pin_cnt_;
   AllocHandle alloc_handle_;
 };
 
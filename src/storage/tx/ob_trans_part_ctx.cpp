@@ -201,6 +201,7 @@ void ObPartTransCtx::destroy()
                 K(busy_cbs_.get_size()));
     }
 
+    reset_log_cbs_();
     ctx_tx_data_.destroy();
 
     if (NULL == ls_tx_ctx_mgr_) {
@@ -311,6 +312,13 @@ int ObPartTransCtx::init_log_cbs_(const ObLSID &ls_id, const ObTransID &tx_id)
 
 void ObPartTransCtx::reset_log_cbs_()
 {
+  // unlink all log cbs before they are reset or freed
+  while (!free_cbs_.is_empty()) {
+    free_cbs_.remove_first();
+  }
+  while (!busy_cbs_.is_empty()) {
+    busy_cbs_.remove_first();
+  }
   for (int64_t i = 0; i < OB_TX_MAX_LOG_CBS; ++i) {
     if (OB_NOT_NULL(log_cbs_[i].get_tx_data())) {
       ObTxData *tx_data = log_cbs_[i].get_tx_data();
@@ -325,8 +333,71 @@ void ObPartTransCtx::reset_log_cbs_()
     final_log_cb_.set_tx_data(nullptr);
   }
   final_log_cb_.reset();
-  free_cbs_.reset();
-  busy_cbs_.reset();
+  free_extra_log_cbs_();
+}
+
+// A big transaction may keep more redo logs in flight than the preallocated
+// log callbacks, so that filling the next redo log overlaps with the syncing
+// of the previous ones instead of waiting for them.
+int ObPartTransCtx::extend_log_cbs_()
+{
+  int ret = OB_SUCCESS;
+  const int64_t max_extra_cnt = MIN(OB_TX_MAX_EXTRA_LOG_CBS,
+                                    GCONF._tx_max_pending_redo_log_count - OB_TX_MAX_LOG_CBS);
+  ObTxLogCb *log_cb = NULL;
+  void *buf = NULL;
+  if (extra_log_cb_cnt_ >= max_extra_cnt || !mt_ctx_.pending_log_size_too_large()) {
+    ret = OB_TX_NOLOGCB;
+  } else if (OB_ISNULL(buf = ob_malloc(sizeof(ObTxLogCb), ObMemAttr(tenant_id_, "TxExtraLogCb")))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "alloc log cb failed", KR(ret), K(*this));
+  } else if (FALSE_IT(log_cb = new (buf) ObTxLogCb())) {
+  } else if (OB_FAIL(log_cb->init(ls_id_, trans_id_, this))) {
+    TRANS_LOG(WARN, "log cb init failed", KR(ret), K(*this));
+  } else if (!free_cbs_.add_last(log_cb)) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(WARN, "add to free list failed", KR(ret), K(*this));
+  } else {
+    extra_log_cbs_[extra_log_cb_cnt_++] = log_cb;
+  }
+  if (OB_FAIL(ret) && OB_NOT_NULL(log_cb)) {
+    log_cb->~ObTxLogCb();
+    ob_free(log_cb);
+  }
+  return ret;
+}
+
+void ObPartTransCtx::free_extra_log_cbs_()
+{
+  for (int64_t i = 0; i < extra_log_cb_cnt_; ++i) {
+    ObTxLogCb *log_cb = extra_log_cbs_[i];
+    if (OB_NOT_NULL(log_cb->get_tx_data())) {
+      ObTxData *tx_data = log_cb->get_tx_data();
+      ctx_tx_data_.free_tmp_tx_data(tx_data);
+      log_cb->set_tx_data(nullptr);
+    }
+    log_cb->~ObTxLogCb();
+    ob_free(log_cb);
+    extra_log_cbs_[i] = NULL;
+  }
+  extra_log_cb_cnt_ = 0;
+}
+
+// free the returned log cb if it is an extra one, the log cb should have been
+// unlinked from busy_cbs_
+int ObPartTransCtx::free_extra_log_cb_(ObTxLogCb *log_cb)
+{
+  int ret = OB_ENTRY_NOT_EXIST;
+  for (int64_t i = 0; OB_ENTRY_NOT_EXIST == ret && i < extra_log_cb_cnt_; ++i) {
+    if (log_cb == extra_log_cbs_[i]) {
+      extra_log_cbs_[i] = extra_log_cbs_[--extra_log_cb_cnt_];
+      extra_log_cbs_[extra_log_cb_cnt_] = NULL;
+      log_cb->~ObTxLogCb();
+      ob_free(log_cb);
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
 }
 
 // thread-unsafe
@@ -3277,6 +3348,14 @@ int ObPartTransCtx::get_log_cb_(const bool need_final_cb, ObTxLogCb *&log_cb)
       log_cb = &final_log_cb_;
     }
   } else {
+    if (free_cbs_.get_size() <= RESERVE_LOG_CALLBACK_COUNT_FOR_FREEZING
+        && OB_FAIL(extend_log_cbs_())) {
+      if (OB_TX_NOLOGCB != ret) {
+        TRANS_LOG(WARN, "extend log cbs failed", K(ret), K(*this));
+      }
+      // use the preallocated ones
+      ret = OB_SUCCESS;
+    }
     if (free_cbs_.is_empty()) {
       ret = OB_TX_NOLOGCB;
       //TRANS_LOG(INFO, "all log cbs are busy now, try again later", K(ret), K(*this));
@@ -3304,7 +3383,13 @@ int ObPartTransCtx::return_log_cb_(ObTxLogCb *log_cb)
   if (NULL != log_cb) {
     busy_cbs_.remove(log_cb);
     log_cb->reuse();
-    if ((&final_log_cb_) != log_cb) {
+    if ((&final_log_cb_) == log_cb) {
+      // do nothing
+    } else if (extra_log_cb_cnt_ > 0
+               && !mt_ctx_.pending_log_size_too_large()
+               && OB_SUCCESS == free_extra_log_cb_(log_cb)) {
+      // the pending redo is drained, shrink back to the preallocated log cbs
+    } else {
       free_cbs_.add_first(log_cb);
     }
   }
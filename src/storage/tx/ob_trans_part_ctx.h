@@ -82,6 +82,8 @@ namespace transaction
 {
 
 const static int64_t OB_TX_MAX_LOG_CBS = 3;
+// log callbacks allocated on demand for big transactions, see _tx_max_pending_redo_log_count
+const static int64_t OB_TX_MAX_EXTRA_LOG_CBS = 13;
 const static int64_t RESERVE_LOG_CALLBACK_COUNT_FOR_FREEZING = 1;
 
 // participant transaction context
@@ -100,6 +102,7 @@ public:
       : ObTransCtx("participant", ObTransCtxType::PARTICIPANT), ObTsCbTask(),
         ObTxCycleTwoPhaseCommitter(), is_inited_(false), mt_ctx_(), exec_info_(reserve_allocator_),
         mds_cache_(reserve_allocator_),
+        extra_log_cb_cnt_(0),
         role_state_(TxCtxRoleState::FOLLOWER),
         coord_prepare_info_arr_(OB_MALLOC_NORMAL_BLOCK_SIZE,
                                 ModulePageAllocator(reserve_allocator_, "PREPARE_INFO"))
@@ -495,6 +498,9 @@ private:
 
   int init_log_cbs_(const share::ObLSID&ls_id, const ObTransID &tx_id);
   void reset_log_cbs_();
+  int extend_log_cbs_();
+  void free_extra_log_cbs_();
+  int free_extra_log_cb_(ObTxLogCb *log_cb);
   int prepare_log_cb_(const bool need_final_cb, ObTxLogCb *&log_cb);
   int get_log_cb_(const bool need_final_cb, ObTxLogCb *&log_cb);
   int return_log_cb_(ObTxLogCb *log_cb);
@@ -718,6 +724,8 @@ private:
   // sub_state_ is volatile
   ObTxSubState sub_state_;
   ObTxLogCb log_cbs_[OB_TX_MAX_LOG_CBS];
+  ObTxLogCb *extra_log_cbs_[OB_TX_MAX_EXTRA_LOG_CBS];
+  int64_t extra_log_cb_cnt_;
   common::ObDList<ObTxLogCb> free_cbs_;
   common::ObDList<ObTxLogCb> busy_cbs_;
   ObTxLogCb final_log_cb_;
@@ -165,8 +165,9 @@ int ObTxLogCb::on_success()
       check_warn_();
       ObPartTransCtx *part_ctx = static_cast<ObPartTransCtx *>(ctx_);
 
+      // an extra log cb may be freed by on_success, don't touch it after the call
       if (OB_FAIL(part_ctx->on_success(this))) {
-        TRANS_LOG(WARN, "sync log success callback error", K(ret), K(trans_id_));
+        TRANS_LOG(WARN, "sync log success callback error", K(ret), K(tx_id));
       }
     }
   }
@@ -195,8 +196,9 @@ int ObTxLogCb::on_failure()
       // TODO. iterate all log type
       ObPartTransCtx *part_ctx = static_cast<ObPartTransCtx *>(ctx_);
 
+      // an extra log cb may be freed by on_failure, don't touch it after the call
       if (OB_FAIL(part_ctx->on_failure(this))) {
-        TRANS_LOG(WARN, "sync log success callback error", KR(ret), K(trans_id_));
+        TRANS_LOG(WARN, "sync log success callback error", KR(ret), K(tx_id));
       }
     }
   }
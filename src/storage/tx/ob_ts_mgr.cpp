@@ -140,7 +140,10 @@ int ObTsMgr::init(const ObAddr &server,
     TRANS_LOG(WARN, "response rpc init failed", KR(ret), K(server));
   } else if (OB_FAIL(lock_.init(lib::ObMemAttr(OB_SERVER_TENANT_ID, "TsMgr")))) {
     TRANS_LOG(WARN, "ObQSyncLock init failed", KR(ret), K(OB_SERVER_TENANT_ID));
+  } else if (OB_FAIL(gts_wait_tw_.init(GTS_WAIT_TICK_US, 1, "GtsWaitTick"))) {
+    TRANS_LOG(WARN, "gts wait time wheel init failed", KR(ret));
   } else {
+    gts_wait_tick_task_.set_ts_mgr(this);
     server_ = server;
     location_adapter_ = &location_adapter_def_;
     is_inited_ = true;
@@ -166,6 +169,7 @@ void ObTsMgr::reset()
   is_inited_ = false;
   is_running_ = false;
   ts_source_info_map_.reset();
+  gts_wait_tick_armed_ = false;
   server_.reset();
   location_adapter_ = NULL;
   gts_request_rpc_proxy_ = NULL;
@@ -190,6 +194,8 @@ int ObTsMgr::start()
     // 启动gts任务刷新线程
   } else if (OB_FAIL(share::ObThreadPool::start())) {
     TRANS_LOG(ERROR, "GTS local cache manager refresh worker thread start error", KR(ret));
+  } else if (OB_FAIL(gts_wait_tw_.start())) {
+    TRANS_LOG(ERROR, "gts wait time wheel start error", KR(ret));
   } else {
     is_running_ = true;
     TRANS_LOG(INFO, "ObTsMgr start success");
@@ -209,6 +215,7 @@ void ObTsMgr::stop()
   } else {
     (void)share::ObThreadPool::stop();
     (void)ts_worker_.stop();
+    (void)gts_wait_tw_.stop();
     is_running_ = false;
     TRANS_LOG(INFO, "ObTsMgr stop success");
   }
@@ -229,6 +236,7 @@ void ObTsMgr::wait()
   } else {
     (void)share::ObThreadPool::wait();
     (void)ts_worker_.wait();
+    (void)gts_wait_tw_.wait();
     TRANS_LOG(INFO, "ObTsMgr wait success");
   }
 }
@@ -240,6 +248,7 @@ void ObTsMgr::destroy()
       stop();
       wait();
     }
+    gts_wait_tw_.destroy();
     is_inited_ = false;
     TRANS_LOG(INFO, "ObTsMgr destroyed");
   }
@@ -292,6 +301,38 @@ void ObTsMgr::run1()
   }
 }
 
+void ObGtsWaitTickTask::runTimerTask()
+{
+  if (OB_NOT_NULL(ts_mgr_)) {
+    ts_mgr_->handle_gts_wait_tick_();
+  }
+}
+
+void ObTsMgr::arm_gts_wait_tick_()
+{
+  int ret = OB_SUCCESS;
+  if (is_running_ && !ATOMIC_LOAD(&gts_wait_tick_armed_)
+      && ATOMIC_BCAS(&gts_wait_tick_armed_, false, true)) {
+    if (OB_FAIL(gts_wait_tw_.schedule(&gts_wait_tick_task_, GTS_WAIT_TICK_US))) {
+      ATOMIC_STORE(&gts_wait_tick_armed_, false);
+      TRANS_LOG(WARN, "schedule gts wait tick failed", KR(ret));
+    }
+  }
+}
+
+// Queued tasks are called back when the response of the gts request arrives,
+// the tick only makes sure a request is sent for them in every tick until all
+// of them are done, without any check per task.
+void ObTsMgr::handle_gts_wait_tick_()
+{
+  ObGtsWaitTickFunctor gts_wait_tick_functor;
+  ATOMIC_STORE(&gts_wait_tick_armed_, false);
+  ts_source_info_map_.for_each(gts_wait_tick_functor);
+  if (gts_wait_tick_functor.has_waiter()) {
+    arm_gts_wait_tick_();
+  }
+}
+
 int ObTsMgr::handle_gts_err_response(const ObGtsErrResponse &msg)
 {
   int ret = OB_SUCCESS;
@@ -601,6 +642,8 @@ int ObTsMgr::get_gts(const uint64_t tenant_id, ObTsCbTask *task, SCN &scn)
       } else if (OB_FAIL(ts_source->get_gts(task, gts))) {
         if (OB_EAGAIN != ret) {
           TRANS_LOG(WARN, "get gts error", K(ret), K(tenant_id), KP(task));
+        } else if (NULL != task) {
+          arm_gts_wait_tick_();
         }
       }
     }
@@ -649,6 +692,8 @@ int ObTsMgr::get_gts(const uint64_t tenant_id,
       } else if (OB_FAIL(ts_source->get_gts(stc, task, gts, receive_gts_ts))) {
         if (OB_EAGAIN != ret) {
           TRANS_LOG(WARN, "get gts error", K(ret), K(tenant_id), K(stc), KP(task));
+        } else if (NULL != task) {
+          arm_gts_wait_tick_();
         }
       }
     }
@@ -788,6 +833,8 @@ int ObTsMgr::wait_gts_elapse(const uint64_t tenant_id, const SCN &scn,
         TRANS_LOG(WARN, "ts source is NULL", K(ret));
       } else if (OB_FAIL(ts_source->wait_gts_elapse(ts, task, need_wait))) {
         TRANS_LOG(WARN, "wait gts elapse failed", K(ret), K(ts), KP(task));
+      } else if (need_wait) {
+        arm_gts_wait_tick_();
       }
     }
   }
@@ -27,6 +27,7 @@
 #include "ob_gts_source.h"
 #include "ob_gts_define.h"
 #include "ob_ts_worker.h"
+#include "ob_time_wheel.h"
 #include "ob_location_adapter.h"
 
 #define REFRESH_GTS_INTERVEL_US  (100 * 1000)
@@ -238,7 +239,53 @@ private:
   common::ObIArray<uint64_t> &array_;
 };
 
+// Queries gts for the tenants with queued tasks
+class ObGtsWaitTickFunctor
+{
+public:
+  ObGtsWaitTickFunctor() : has_waiter_(false) {}
+  ~ObGtsWaitTickFunctor() {}
+  bool operator()(const ObTsTenantInfo &gts_tenant_info, ObTsSourceInfo *ts_source_info)
+  {
+    int ret = common::OB_SUCCESS;
+    ObGtsSource *gts_source = NULL;
+    if (OB_ISNULL(ts_source_info)) {
+      ret = common::OB_ERR_UNEXPECTED;
+      TRANS_LOG(ERROR, "ts source info is null", KR(ret));
+    } else if (NULL == (gts_source = (ts_source_info->get_gts_source()))) {
+      ret = common::OB_ERR_UNEXPECTED;
+      TRANS_LOG(ERROR, "gts cache queue is null", KR(ret), K(gts_tenant_info));
+    } else if (0 < gts_source->get_task_count()) {
+      has_waiter_ = true;
+      if (OB_FAIL(gts_source->refresh_gts_for_waiters())) {
+        if (EXECUTE_COUNT_PER_SEC(1)) {
+          TRANS_LOG(WARN, "refresh gts for waiters failed", KR(ret), K(gts_tenant_info));
+        }
+      }
+    }
+    return true;
+  }
+  bool has_waiter() const { return has_waiter_; }
+private:
+  bool has_waiter_;
+};
+
 class ObTsMgr;
+// A single tick shared by all tenants. It is armed when a task is queued and
+// keeps ticking while any tenant has queued tasks, so the queued tasks are
+// served by one gts request per tenant per tick.
+class ObGtsWaitTickTask : public common::ObTimeWheelTask
+{
+public:
+  ObGtsWaitTickTask() : ts_mgr_(NULL) {}
+  ~ObGtsWaitTickTask() {}
+  void set_ts_mgr(ObTsMgr *ts_mgr) { ts_mgr_ = ts_mgr; }
+  virtual void runTimerTask() override;
+  virtual uint64_t hash() const override { return 0; }
+private:
+  ObTsMgr *ts_mgr_;
+};
+
 class ObTsSourceInfoGuard
 {
 public:
@@ -265,6 +312,7 @@ typedef common::ObLinkHashMap<ObTsTenantInfo, ObTsSourceInfo, ObTsSourceInfoAllo
 class ObTsMgr : public share::ObThreadPool, public ObITsMgr
 {
   friend class ObTsSourceInfoGuard;
+  friend class ObGtsWaitTickTask;
 public:
   ObTsMgr() { reset(); }
   ~ObTsMgr() { destroy(); }
@@ -309,6 +357,7 @@ public:
 private:
   static const int64_t TS_SOURCE_INFO_OBSOLETE_TIME = 120 * 1000 * 1000;
   static const int64_t TS_SOURCE_INFO_CACHE_NUM = 4096;
+  static const int64_t GTS_WAIT_TICK_US = 1000;
 private:
   int get_ts_source_info_opt_(const uint64_t tenant_id, ObTsSourceInfoGuard &guard,
       const bool need_create_tenant, const bool need_update_access_ts);
@@ -318,6 +367,8 @@ private:
   int add_tenant_(const uint64_t tenant_id);
   int delete_tenant_(const uint64_t tenant_id);
   int remove_dropped_tenant_(const uint64_t tenant_id);
+  void arm_gts_wait_tick_();
+  void handle_gts_wait_tick_();
   static ObTsMgr* &get_instance_inner();
 private:
   bool is_inited_;
@@ -329,6 +380,9 @@ private:
   ObLocationAdapter *location_adapter_;
   ObLocationAdapter location_adapter_def_;
   ObTsWorker ts_worker_;
+  common::ObTimeWheel gts_wait_tw_;
+  ObGtsWaitTickTask gts_wait_tick_task_;
+  bool gts_wait_tick_armed_;
   common::ObQSyncLock lock_;
   ObTsSourceInfo *ts_source_infos_[TS_SOURCE_INFO_CACHE_NUM];
 };
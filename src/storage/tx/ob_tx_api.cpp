@@ -17,6 +17,8 @@
 #include "storage/tx/ob_tx_log.h"
 #include "storage/tx/wrs/ob_weak_read_service.h"
 #include "storage/tx/wrs/ob_weak_read_util.h"
+#include "storage/tx_storage/ob_ls_service.h"
+#include "storage/ls/ob_ls.h"
 #include "ob_xa_service.h"
 // ------------------------------------------------------------------------------------------
 // Implimentation notes:
@@ -697,6 +699,51 @@ int ObTransService::get_weak_read_snapshot_version(SCN &snapshot)
   return ret;
 }
 
+int ObTransService::get_ls_weak_read_snapshot_version(const share::ObLSArray &ls_ids,
+                                                      const int64_t max_staleness,
+                                                      SCN &snapshot)
+{
+  int ret = OB_SUCCESS;
+  ObLSService *ls_svr = MTL(ObLSService *);
+  SCN min_version;
+  min_version.set_max();
+  if (OB_UNLIKELY(ls_ids.empty() || max_staleness <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), K(ls_ids), K(max_staleness));
+  } else if (ObWeakReadUtil::enable_monotonic_weak_read(tenant_id_)) {
+    // the replay progress of different log streams may go backward between
+    // statements, so it is only used when monotonic read is not required
+    ret = OB_NOT_SUPPORTED;
+    TRANS_LOG(TRACE, "ls weak read version is not monotonic", K(ret), K(ls_ids));
+  } else if (OB_ISNULL(ls_svr)) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(WARN, "log stream service is NULL", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < ls_ids.count(); i++) {
+    ObLSHandle handle;
+    ObLS *ls = NULL;
+    if (OB_FAIL(ls_svr->get_ls(ls_ids.at(i), handle, ObLSGetMod::TRANS_MOD))) {
+      TRANS_LOG(TRACE, "get ls failed", K(ret), K(ls_ids.at(i)));
+    } else if (OB_ISNULL(ls = handle.get_ls())) {
+      ret = OB_ERR_UNEXPECTED;
+      TRANS_LOG(WARN, "ls is NULL", K(ret), K(ls_ids.at(i)));
+    } else {
+      min_version = SCN::min(min_version, ls->get_ls_wrs_handler()->get_ls_weak_read_ts());
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(ObWeakReadUtil::check_weak_read_version_staleness(min_version,
+                                                                       max_staleness,
+                                                                       ObClockGenerator::getClock()))) {
+    TRANS_LOG(WARN, "ls weak read version too stale", K(ret), K(ls_ids), K(min_version),
+              K(max_staleness));
+  } else {
+    snapshot = min_version;
+  }
+  TRANS_LOG(TRACE, "get ls weak-read snapshot", K(ret), K(snapshot), K(ls_ids), K(max_staleness));
+  return ret;
+}
+
 int ObTransService::release_snapshot(ObTxDesc &tx)
 {
   int ret = OB_SUCCESS;
@@ -233,6 +233,28 @@ int get_ls_read_snapshot_version(const share::ObLSID &local_ls_id,
  * OB_REPLICA_NOT_READABLE - snapshot is too stale
  */
 int get_weak_read_snapshot_version(share::SCN &snapshot_version);
+/**
+ * get_ls_weak_read_snapshot_version - get snapshot version for weak read
+ *                                     from replay progress of local replicas
+ *
+ * the snapshot is the min weak read version of the local replicas of
+ * @ls_ids, so the read is not held back by log streams it doesn't touch.
+ * it may go backward across statements, so it is only available when
+ * monotonic weak read is disabled
+ *
+ * @ls_ids:                        the LogStreams to be read, all local
+ * @max_staleness:                 microseconds the snapshot may lag behind
+ * @snapshot_version:              the snapshot acquired
+ *
+ * Return:
+ * OB_SUCCESS              - OK
+ * OB_NOT_SUPPORTED        - monotonic weak read is enabled
+ * OB_LS_NOT_EXIST         - some of @ls_ids has no local replica
+ * OB_REPLICA_NOT_READABLE - replicas are more stale than @max_staleness
+ */
+int get_ls_weak_read_snapshot_version(const share::ObLSArray &ls_ids,
+                                      const int64_t max_staleness,
+                                      share::SCN &snapshot_version);
 /*
  * release_snapshot - release snapshot
  *
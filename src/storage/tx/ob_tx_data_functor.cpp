@@ -182,6 +182,28 @@ int GetTxStateWithSCNFunctor::operator()(const ObTxData &tx_data, ObTxCCCtx *tx_
 }
 
 
+int GetDecidedTxStateFunctor::operator()(const ObTxData &tx_data, ObTxCCCtx *tx_cc_ctx)
+{
+  UNUSED(tx_cc_ctx);
+  int ret = OB_SUCCESS;
+  const int32_t state = ATOMIC_LOAD(&tx_data.state_);
+  const SCN commit_version = tx_data.commit_version_.atomic_load();
+
+  state_ = state;
+  commit_version_ = commit_version;
+  if (ObTxData::COMMIT == state) {
+    // undo actions can not be added after commit
+    is_decided_ = OB_ISNULL(ATOMIC_LOAD(&tx_data.undo_status_list_.head_));
+  } else if (ObTxData::ABORT == state) {
+    commit_version_ = SCN::min_scn();
+    is_decided_ = true;
+  } else {
+    is_decided_ = false;
+  }
+
+  return ret;
+}
+
 int LockForReadFunctor::inner_lock_for_read(const ObTxData &tx_data, ObTxCCCtx *tx_cc_ctx)
 {
   int ret = OB_SUCCESS;
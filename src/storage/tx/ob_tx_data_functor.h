@@ -147,6 +147,26 @@ public:
   share::SCN &trans_version_;
 };
 
+// fetch the state and commit version of txn DATA_TRANS_ID if it is decided and
+// the visibility of its rows no longer depends on the sql sequence, that is, it
+// is aborted or it is committed without any undo action
+// return IS_DECIDED false if the txn is running or has undo actions
+class GetDecidedTxStateFunctor : public ObITxDataCheckFunctor
+{
+public:
+  GetDecidedTxStateFunctor(int64_t &state,
+                           share::SCN &commit_version,
+                           bool &is_decided)
+    : state_(state), commit_version_(commit_version), is_decided_(is_decided) {}
+  virtual ~GetDecidedTxStateFunctor() {}
+  virtual int operator()(const ObTxData &tx_data, ObTxCCCtx *tx_cc_ctx = nullptr) override;
+  TO_STRING_KV(K(state_), K(commit_version_), K(is_decided_));
+public:
+  int64_t &state_;
+  share::SCN &commit_version_;
+  bool &is_decided_;
+};
+
 // the txn READ_TRANS_ID use SNAPSHOT_VERSION to read the data,
 // and check whether the data is locked, readable or unreadable
 // by txn DATA_TRANS_ID.
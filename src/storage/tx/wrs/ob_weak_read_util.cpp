@@ -130,5 +130,18 @@ bool ObWeakReadUtil::check_weak_read_service_available()
   return true;
 }
 
+int ObWeakReadUtil::check_weak_read_version_staleness(const SCN &version,
+                                                      const int64_t max_staleness,
+                                                      const int64_t now)
+{
+  int ret = OB_SUCCESS;
+  if (!version.is_valid_and_not_min()
+      || SCN::max_scn() == version
+      || version.convert_to_ts() < now - max_staleness) {
+    ret = OB_REPLICA_NOT_READABLE;
+  }
+  return ret;
+}
+
 }// transaction
 }// oceanbase
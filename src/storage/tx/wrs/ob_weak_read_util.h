@@ -35,6 +35,11 @@ public:
   static bool enable_monotonic_weak_read(const uint64_t tenant_id);
   static int64_t max_stale_time_for_weak_consistency(const uint64_t tenant_id, int64_t ignore_warn = 0);
   static bool check_weak_read_service_available();
+  // check the weak read @version lags behind @now for no more than @max_staleness,
+  // returns OB_REPLICA_NOT_READABLE if not
+  static int check_weak_read_version_staleness(const share::SCN &version,
+                                               const int64_t max_staleness,
+                                               const int64_t now);
   static int64_t default_max_stale_time_for_weak_consistency() {
     return DEFAULT_MAX_STALE_TIME_FOR_WEAK_CONSISTENCY; };
 
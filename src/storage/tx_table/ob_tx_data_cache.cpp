@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/tx_table/ob_tx_data_cache.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/atomic/ob_atomic.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+
+namespace storage
+{
+
+int ObTxDataCache::init(const uint64_t tenant_id, const int64_t slot_cnt)
+{
+  int ret = OB_SUCCESS;
+  void *buf = NULL;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "tx data cache init twice", KR(ret));
+  } else if (OB_UNLIKELY(slot_cnt <= 0 || 0 != (slot_cnt & (slot_cnt - 1)))) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "slot cnt should be power of 2", KR(ret), K(slot_cnt));
+  } else if (OB_ISNULL(buf = ob_malloc(sizeof(Slot) * slot_cnt, ObMemAttr(tenant_id, "TxDataCache")))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "alloc tx data cache failed", KR(ret), K(slot_cnt));
+  } else {
+    slots_ = static_cast<Slot *>(buf);
+    for (int64_t i = 0; i < slot_cnt; ++i) {
+      slots_[i].seq_ = 0;
+      new (&slots_[i].commit_data_) ObTxCommitData();
+    }
+    slot_cnt_ = slot_cnt;
+    hit_cnt_ = 0;
+    miss_cnt_ = 0;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObTxDataCache::destroy()
+{
+  if (OB_NOT_NULL(slots_)) {
+    ob_free(slots_);
+    slots_ = NULL;
+  }
+  slot_cnt_ = 0;
+  is_inited_ = false;
+}
+
+void ObTxDataCache::reuse()
+{
+  for (int64_t i = 0; IS_INIT && i < slot_cnt_; ++i) {
+    Slot &slot = slots_[i];
+    bool done = false;
+    while (!done) {
+      const int64_t seq = ATOMIC_LOAD(&slot.seq_);
+      if (0 == (seq & 1) && ATOMIC_BCAS(&slot.seq_, seq, seq + 1)) {
+        slot.commit_data_.reset();
+        ATOMIC_STORE(&slot.seq_, seq + 2);
+        done = true;
+      } else {
+        PAUSE();
+      }
+    }
+  }
+}
+
+int ObTxDataCache::get(const ObTransID tx_id, ObTxCommitData &commit_data)
+{
+  int ret = OB_ENTRY_NOT_EXIST;
+  if (IS_INIT) {
+    const Slot &slot = get_slot_(tx_id);
+    const int64_t seq = ATOMIC_LOAD(&slot.seq_);
+    if (0 == (seq & 1)) {
+      commit_data = slot.commit_data_;
+      MEM_BARRIER();
+      if (seq == ATOMIC_LOAD(&slot.seq_) && commit_data.tx_id_ == tx_id) {
+        ret = OB_SUCCESS;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ATOMIC_INC(&hit_cnt_);
+    } else {
+      ATOMIC_INC(&miss_cnt_);
+    }
+  }
+  return ret;
+}
+
+void ObTxDataCache::put(const ObTxData &tx_data)
+{
+  if (IS_INIT && can_cache(tx_data)) {
+    Slot &slot = get_slot_(tx_data.tx_id_);
+    const int64_t seq = ATOMIC_LOAD(&slot.seq_);
+    if (0 == (seq & 1) && ATOMIC_BCAS(&slot.seq_, seq, seq + 1)) {
+      slot.commit_data_ = static_cast<const ObTxCommitData &>(tx_data);
+      ATOMIC_STORE(&slot.seq_, seq + 2);
+    }
+  }
+}
+
+bool ObTxDataCache::can_cache(const ObTxData &tx_data)
+{
+  const int32_t state = ATOMIC_LOAD(&tx_data.state_);
+  return tx_data.tx_id_.is_valid()
+      && ((ObTxData::COMMIT == state && OB_ISNULL(ATOMIC_LOAD(&tx_data.undo_status_list_.head_)))
+          || ObTxData::ABORT == state);
+}
+
+}  // namespace storage
+}  // namespace oceanbase
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_OB_TX_DATA_CACHE
+#define OCEANBASE_STORAGE_OB_TX_DATA_CACHE
+
+#include "storage/tx/ob_tx_data_define.h"
+
+namespace oceanbase
+{
+namespace storage
+{
+
+// Commit data of the decided transactions read from the tx data sstables of a log stream.
+//
+// Rows dumped before their transactions were decided are resolved through the tx data table,
+// and once the tx data memtables are frozen and dumped, every lookup reads the tx data
+// sstable. The commit data of a decided transaction never changes, so it is kept in a direct
+// mapped cache and later lookups of the same transaction skip the memtables and the sstable.
+//
+// Only committed transactions without undo actions and aborted transactions are cached, whose
+// commit data alone decides the visibility of all their rows. Each slot is guarded by a
+// sequence number: a reader seeing the slot being written treats it as a miss, and a writer
+// finding the slot busy gives up.
+class ObTxDataCache
+{
+public:
+  static const int64_t DEFAULT_SLOT_CNT = 1L << 11;
+
+  ObTxDataCache() : is_inited_(false), slots_(NULL), slot_cnt_(0), hit_cnt_(0), miss_cnt_(0) {}
+  ~ObTxDataCache() { destroy(); }
+  int init(const uint64_t tenant_id, const int64_t slot_cnt = DEFAULT_SLOT_CNT);
+  void destroy();
+  // drop all cached transactions
+  void reuse();
+  // @return OB_ENTRY_NOT_EXIST if @tx_id is not cached
+  int get(const transaction::ObTransID tx_id, ObTxCommitData &commit_data);
+  void put(const ObTxData &tx_data);
+  static bool can_cache(const ObTxData &tx_data);
+  TO_STRING_KV(K_(is_inited), K_(slot_cnt), K_(hit_cnt), K_(miss_cnt));
+private:
+  struct Slot
+  {
+    // odd while being written
+    int64_t seq_;
+    ObTxCommitData commit_data_;
+  };
+  Slot &get_slot_(const transaction::ObTransID tx_id) const
+  {
+    return slots_[static_cast<uint64_t>(tx_id.get_id()) & (slot_cnt_ - 1)];
+  }
+private:
+  bool is_inited_;
+  Slot *slots_;
+  int64_t slot_cnt_;
+  int64_t hit_cnt_;
+  int64_t miss_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObTxDataCache);
+};
+
+// Decided transactions resolved by one scan, so that the rows of the same transaction in the
+// following rows and micro blocks of the scan need no tx table lookup at all. Transactions
+// which are not decided are kept too, to send their rows to the tx table directly.
+class ObTxStateCache
+{
+public:
+  static const int64_t SLOT_CNT = 16;
+
+  ObTxStateCache() { reset(); }
+  ~ObTxStateCache() {}
+  void reset()
+  {
+    for (int64_t i = 0; i < SLOT_CNT; ++i) {
+      slots_[i].tx_id_.reset();
+    }
+  }
+  // @return true if @tx_id has been resolved by the scan
+  OB_INLINE bool get(const transaction::ObTransID tx_id, int32_t &state, int64_t &commit_version) const
+  {
+    const Slot &slot = slots_[static_cast<uint64_t>(tx_id.get_id()) & (SLOT_CNT - 1)];
+    const bool found = slot.tx_id_ == tx_id;
+    if (found) {
+      state = slot.state_;
+      commit_version = slot.commit_version_;
+    }
+    return found;
+  }
+  OB_INLINE void put(const transaction::ObTransID tx_id, const int32_t state, const int64_t commit_version)
+  {
+    Slot &slot = slots_[static_cast<uint64_t>(tx_id.get_id()) & (SLOT_CNT - 1)];
+    slot.tx_id_ = tx_id;
+    slot.state_ = state;
+    slot.commit_version_ = commit_version;
+  }
+private:
+  struct Slot
+  {
+    transaction::ObTransID tx_id_;
+    int32_t state_;
+    int64_t commit_version_;
+  };
+  Slot slots_[SLOT_CNT];
+};
+
+}  // namespace storage
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_OB_TX_DATA_CACHE
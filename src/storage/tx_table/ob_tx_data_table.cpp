@@ -62,6 +62,8 @@ int ObTxDataTable::init(ObLS *ls, ObTxCtxTable *tx_ctx_table)
   } else if (FALSE_IT(arena_allocator_.set_attr(mem_attr_))) {
   } else if (OB_FAIL(init_tx_data_read_schema_())) {
     STORAGE_LOG(WARN, "init tx data read ctx failed.", KR(ret), K(tablet_id_));
+  } else if (OB_FAIL(tx_data_cache_.init(mem_attr_.tenant_id_))) {
+    STORAGE_LOG(WARN, "init tx data cache failed.", KR(ret), K(tablet_id_));
   } else {
     slice_allocator_.set_nway(ObTxDataTable::TX_DATA_MAX_CONCURRENCY);
 
@@ -186,6 +188,7 @@ void ObTxDataTable::reset()
   calc_upper_info_.reset();
   calc_upper_trans_version_cache_.reset();
   memtables_cache_.reuse();
+  tx_data_cache_.destroy();
   slice_allocator_.purge_extra_cached_block(0);
   is_started_ = false;
   is_inited_ = false;
@@ -211,6 +214,7 @@ int ObTxDataTable::offline()
   } else {
     calc_upper_info_.reset();
     calc_upper_trans_version_cache_.reset();
+    tx_data_cache_.reuse();
   }
   return ret;
 }
@@ -501,6 +505,12 @@ int ObTxDataTable::check_with_tx_data(const ObTransID tx_id, ObITxDataCheckFunct
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "tx data table is not init.", KR(ret), KP(this), K(tx_id));
+  } else if (OB_SUCC(check_tx_data_in_cache_(tx_id, fn))) {
+    // the tx is decided and has been read from sstable before, check done
+    STORAGE_LOG(DEBUG, "tx data table check with tx data cache succeed", K(tx_id), K(fn));
+  } else if (OB_ENTRY_NOT_EXIST != ret) {
+    STORAGE_LOG(WARN, "check with tx data cache fail.", KR(ret), K(tx_id), KP(this),
+                K(tablet_id_));
   } else if (OB_SUCC(check_tx_data_in_memtable_(tx_id, fn))) {
     // successfully do check function in memtable, check done
     STORAGE_LOG(DEBUG, "tx data table check with tx memtable data succeed", K(tx_id), K(fn));
@@ -515,6 +525,23 @@ int ObTxDataTable::check_with_tx_data(const ObTransID tx_id, ObITxDataCheckFunct
   return ret;
 }
 
+int ObTxDataTable::check_tx_data_in_cache_(const ObTransID tx_id, ObITxDataCheckFunctor &fn)
+{
+  int ret = OB_SUCCESS;
+  ObTxCommitData commit_data;
+  if (OB_FAIL(tx_data_cache_.get(tx_id, commit_data))) {
+    // not cached
+  } else {
+    // cached tx data has no undo status
+    ObTxData tx_data;
+    tx_data = commit_data;
+    if (OB_FAIL(fn(tx_data))) {
+      STORAGE_LOG(WARN, "do data check function fail.", KR(ret), KP(this), K(tablet_id_), K(tx_data));
+    }
+  }
+  return ret;
+}
+
 int ObTxDataTable::check_tx_data_in_memtable_(const ObTransID tx_id, ObITxDataCheckFunctor &fn)
 {
   int ret = OB_SUCCESS;
@@ -651,6 +678,7 @@ int ObTxDataTable::check_tx_data_in_sstable_(const ObTransID tx_id, ObITxDataChe
 
   if (OB_FAIL(get_tx_data_in_sstable_(tx_id, tx_data))) {
     STORAGE_LOG(WARN, "get tx data from sstable failed.", KR(ret), K(tx_id));
+  } else if (FALSE_IT(tx_data_cache_.put(tx_data))) {
   } else if (OB_FAIL(fn(tx_data))) {
     STORAGE_LOG(WARN, "check tx data in sstable failed.", KR(ret), KP(this), K(tablet_id_));
   }
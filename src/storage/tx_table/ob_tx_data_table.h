@@ -15,6 +15,7 @@
 
 #include "storage/meta_mem/ob_tablet_handle.h"
 #include "lib/future/ob_future.h"
+#include "storage/tx_table/ob_tx_data_cache.h"
 #include "storage/tx_table/ob_tx_data_memtable_mgr.h"
 #include "storage/tx_table/ob_tx_table_define.h"
 #include "share/ob_occam_timer.h"
@@ -136,7 +137,8 @@ public:  // ObTxDataTable
       read_schema_(),
       calc_upper_info_(),
       calc_upper_trans_version_cache_(),
-      memtables_cache_() {}
+      memtables_cache_(),
+      tx_data_cache_() {}
   ~ObTxDataTable() {}
 
   virtual int init(ObLS *ls, ObTxCtxTable *tx_ctx_table);
@@ -239,6 +241,7 @@ public:  // ObTxDataTable
                K_(tablet_id),
                K_(calc_upper_info),
                K_(memtables_cache),
+               K_(tx_data_cache),
                KP_(ls),
                KP_(ls_tablet_svr),
                KP_(memtable_mgr),
@@ -263,6 +266,8 @@ private:
 
   int check_tx_data_in_sstable_(const transaction::ObTransID tx_id, ObITxDataCheckFunctor &fn);
 
+  int check_tx_data_in_cache_(const transaction::ObTransID tx_id, ObITxDataCheckFunctor &fn);
+
   int get_tx_data_in_cache_(const transaction::ObTransID tx_id, ObTxData *&tx_data);
 
   int get_tx_data_in_sstable_(const transaction::ObTransID tx_id, ObTxData &tx_data);
@@ -357,6 +362,8 @@ private:
   CalcUpperInfo calc_upper_info_;
   CalcUpperTransSCNCache calc_upper_trans_version_cache_;
   MemtableHandlesCache memtables_cache_;
+  // decided tx data read from the tx data sstables
+  ObTxDataCache tx_data_cache_;
 };  // tx_table
 
 
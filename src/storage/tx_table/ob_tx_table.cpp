@@ -943,6 +943,18 @@ int ObTxTable::get_tx_state_with_scn(const transaction::ObTransID &data_trans_id
   return ret;
 }
 
+int ObTxTable::get_decided_tx_state(const transaction::ObTransID &data_trans_id,
+                                    const int64_t read_epoch,
+                                    int64_t &state,
+                                    SCN &commit_version,
+                                    bool &is_decided)
+{
+  GetDecidedTxStateFunctor fn(state, commit_version, is_decided);
+  int ret = check_with_tx_data(data_trans_id, fn, read_epoch);
+  LOG_DEBUG("finish get decided tx state", K(data_trans_id), K(state), K(commit_version), K(is_decided));
+  return ret;
+}
+
 int ObTxTable::try_get_tx_state(const transaction::ObTransID tx_id,
                                 const int64_t read_epoch,
                                 int64_t &state,
@@ -156,6 +156,22 @@ public:
                                int64_t &state,
                                share::SCN &trans_version);
 
+  /**
+   * @brief fetch the state and commit version of txn DATA_TRANS_ID if it is decided and its rows
+   * can be judged without sql sequence, so that the result can be reused for all its rows
+   *
+   * @param[in] data_trans_id
+   * @param[in] read_epoch
+   * @param[out] state, COMMIT or ABORT if decided
+   * @param[out] commit_version
+   * @param[out] is_decided, false if the txn is running or has undo actions
+   */
+  int get_decided_tx_state(const transaction::ObTransID &data_trans_id,
+                           const int64_t read_epoch,
+                           int64_t &state,
+                           share::SCN &commit_version,
+                           bool &is_decided);
+
   /**
    * @brief Try to get a tx data from tx_data_table. This function used in special situation when the trans service do
    * not be sure if the tx dat is existed or not. This function will not report error log if the tx data is not existed.
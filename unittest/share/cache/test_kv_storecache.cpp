@@ -11,6 +11,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 #define private public
 #define protected public
 #include "share/ob_thread_mgr.h"
@@ -174,6 +176,64 @@ TEST(ObKVGlobalCache, normal)
   ObKVGlobalCache::get_instance().destroy();
 }
 
+TEST(ObKVCacheFrequencySketch, normal)
+{
+  ObKVCacheFrequencySketch sketch;
+  const int64_t counter_cnt = 1024;
+  ASSERT_EQ(0, sketch.estimate(1));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, sketch.init(1000));
+  ASSERT_EQ(OB_SUCCESS, sketch.init(counter_cnt));
+  ASSERT_EQ(OB_INIT_TWICE, sketch.init(counter_cnt));
+
+  // the first access only reaches the doorkeeper
+  sketch.record(1);
+  ASSERT_EQ(1, sketch.estimate(1));
+  for (int64_t i = 0; i < 100; ++i) {
+    sketch.record(2);
+  }
+  ASSERT_EQ(ObKVCacheFrequencySketch::MAX_FREQUENCY + 1, sketch.estimate(2));
+
+  // counters are halved and the doorkeeper is cleared after a full sample
+  for (int64_t i = 0; i < 10 * counter_cnt; ++i) {
+    sketch.record(3);
+  }
+  ASSERT_EQ(ObKVCacheFrequencySketch::MAX_FREQUENCY / 2, sketch.estimate(2));
+  ASSERT_EQ(0, sketch.estimate(1));
+  sketch.destroy();
+}
+
+TEST(ObKVCacheFrequencySketch, concurrent_record)
+{
+  ObKVCacheFrequencySketch sketch;
+  const int64_t counter_cnt = 1024;
+  const int64_t thread_cnt = 8;
+  const int64_t record_cnt = 8 * 10 * counter_cnt;
+  ASSERT_EQ(OB_SUCCESS, sketch.init(counter_cnt));
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < thread_cnt; ++i) {
+    threads.push_back(std::thread([&sketch, i, record_cnt]() {
+      for (int64_t j = 0; j < record_cnt; ++j) {
+        sketch.record(i * record_cnt + j);
+      }
+    }));
+  }
+  for (int64_t i = 0; i < thread_cnt; ++i) {
+    threads[i].join();
+  }
+  // samples may only be lost by threads sharing a slot, which delays aging
+  const int64_t sample_size = 10 * counter_cnt;
+  ASSERT_GE(sketch.reset_cnt_, thread_cnt * record_cnt / sample_size / 2);
+  ASSERT_LE(sketch.reset_cnt_, thread_cnt * record_cnt / sample_size);
+  ASSERT_LT(sketch.sample_cnt_, sample_size);
+
+  // the counters are still usable after concurrent aging
+  for (int64_t i = 0; i < 100; ++i) {
+    sketch.record(thread_cnt * record_cnt);
+  }
+  ASSERT_GE(sketch.estimate(thread_cnt * record_cnt), ObKVCacheFrequencySketch::MAX_FREQUENCY / 2);
+  sketch.destroy();
+}
+
 /*
 TEST(TestKVCacheValue, wash_stress)
 {
@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/aggregate/ob_hash_groupby_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "share/datum/ob_datum.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+static int bytes_cmp(const ObDatum &l, const ObDatum &r)
+{
+  int cmp = MEMCMP(l.ptr_, r.ptr_, MIN(l.len_, r.len_));
+  if (0 == cmp) {
+    cmp = l.len_ < r.len_ ? -1 : (l.len_ > r.len_ ? 1 : 0);
+  }
+  return cmp;
+}
+
+class TestGroupRowHashTable : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 8;
+  static const int64_t MAX_COL_CNT = 2;
+  TestGroupRowHashTable()
+    : alloc_(ObModIds::TEST), exec_ctx_(alloc_), eval_ctx_(exec_ctx_) {}
+  virtual void SetUp() override
+  {
+    eval_ctx_.frames_ = static_cast<char **>(alloc_.alloc(sizeof(char *)));
+    ASSERT_NE(nullptr, eval_ctx_.frames_);
+    const int64_t frame_size = (sizeof(ObDatum) + sizeof(ObEvalInfo) + 16 * BATCH_SIZE) * MAX_COL_CNT
+                               + sizeof(ObDatum) * BATCH_SIZE * MAX_COL_CNT;
+    eval_ctx_.frames_[0] = static_cast<char *>(alloc_.alloc(frame_size));
+    ASSERT_NE(nullptr, eval_ctx_.frames_[0]);
+    memset(eval_ctx_.frames_[0], 0, frame_size);
+    eval_ctx_.set_max_batch_size(BATCH_SIZE);
+    int64_t pos = 0;
+    for (int64_t i = 0; i < MAX_COL_CNT; ++i) {
+      ObExpr *expr = new (alloc_.alloc(sizeof(ObExpr))) ObExpr();
+      expr->frame_idx_ = 0;
+      expr->batch_result_ = true;
+      expr->batch_idx_mask_ = UINT64_MAX;
+      expr->datum_off_ = pos;
+      pos += sizeof(ObDatum) * BATCH_SIZE;
+      expr->eval_info_off_ = pos;
+      pos += sizeof(ObEvalInfo);
+      ObDatum *datums = expr->locate_batch_datums(eval_ctx_);
+      for (int64_t j = 0; j < BATCH_SIZE; ++j) {
+        datums[j].ptr_ = eval_ctx_.frames_[0] + pos;
+        pos += 16;
+      }
+      exprs_[i] = expr;
+      cmp_funcs_[i].cmp_func_ = bytes_cmp;
+    }
+  }
+  virtual void TearDown() override
+  {
+    alloc_.reset();
+  }
+protected:
+  void init_table(const int64_t col_cnt, ObGroupRowHashTable &table)
+  {
+    lib::ObMemAttr attr(OB_SYS_TENANT_ID, ObModIds::TEST);
+    for (int64_t i = 0; i < col_cnt; ++i) {
+      ASSERT_EQ(OB_SUCCESS, gby_exprs_.push_back(exprs_[i]));
+      ASSERT_EQ(OB_SUCCESS, gby_cmp_funcs_.push_back(cmp_funcs_[i]));
+    }
+    ASSERT_EQ(OB_SUCCESS, table.init(&alloc_, attr, gby_exprs_, &eval_ctx_, &gby_cmp_funcs_));
+  }
+  void set_key(const int64_t col_idx, const int64_t batch_idx, const char *key, const int64_t len)
+  {
+    ObDatum &datum = exprs_[col_idx]->locate_expr_datum(eval_ctx_, batch_idx);
+    MEMCPY(const_cast<char *>(datum.ptr_), key, len);
+    datum.pack_ = static_cast<uint32_t>(len);
+  }
+  void make_item(const int64_t batch_idx, const uint64_t hash, ObGroupRowItem &item)
+  {
+    item.batch_idx_ = batch_idx;
+    item.is_expr_row_ = true;
+    item.hash_ = hash;
+  }
+
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObExpr *exprs_[MAX_COL_CNT];
+  ObCmpFunc cmp_funcs_[MAX_COL_CNT];
+  ObSEArray<ObExpr *, MAX_COL_CNT> gby_exprs_;
+  ObSEArray<ObCmpFunc, MAX_COL_CNT> gby_cmp_funcs_;
+};
+
+TEST_F(TestGroupRowHashTable, item_size)
+{
+  // the inline key costs 8 bytes per group
+  ASSERT_EQ(48, static_cast<int64_t>(sizeof(ObGroupRowItem)));
+}
+
+TEST_F(TestGroupRowHashTable, inline_key_of_one_group_by_expr)
+{
+  ObGroupRowHashTable table;
+  init_table(1, table);
+  ASSERT_TRUE(table.enable_inline_key_);
+
+  ObGroupRowItem group1;
+  ObGroupRowItem group2;
+  ObGroupRowItem group3;
+  set_key(0, 0, "12345678", 8);
+  make_item(0, 1, group1);
+  ASSERT_EQ(OB_SUCCESS, table.set(group1));
+  ASSERT_EQ(8, group1.inline_key_len_);
+  // keys wider than 8 bytes and null keys are compared through the datums
+  set_key(0, 1, "123456789", 9);
+  make_item(1, 2, group2);
+  ASSERT_EQ(OB_SUCCESS, table.set(group2));
+  ASSERT_EQ(-1, group2.inline_key_len_);
+  exprs_[0]->locate_expr_datum(eval_ctx_, 2).set_null();
+  make_item(2, 3, group3);
+  ASSERT_EQ(OB_SUCCESS, table.set(group3));
+  ASSERT_EQ(-1, group3.inline_key_len_);
+
+  // the group by datum of the first group is gone, the probe only reads the inline key
+  set_key(0, 0, "xxxxxxxx", 8);
+  ObGroupRowItem probe;
+  set_key(0, 3, "12345678", 8);
+  make_item(3, 1, probe);
+  ASSERT_EQ(&group1, table.get(probe));
+  set_key(0, 3, "12345679", 8);
+  ASSERT_EQ(nullptr, table.get(probe));
+  set_key(0, 3, "1234567", 7);
+  ASSERT_EQ(nullptr, table.get(probe));
+  exprs_[0]->locate_expr_datum(eval_ctx_, 3).set_null();
+  ASSERT_EQ(nullptr, table.get(probe));
+
+  set_key(0, 4, "123456789", 9);
+  make_item(4, 2, probe);
+  ASSERT_EQ(&group2, table.get(probe));
+  exprs_[0]->locate_expr_datum(eval_ctx_, 4).set_null();
+  make_item(4, 3, probe);
+  ASSERT_EQ(&group3, table.get(probe));
+  table.destroy();
+}
+
+TEST_F(TestGroupRowHashTable, no_inline_key_of_multiple_group_by_exprs)
+{
+  ObGroupRowHashTable table;
+  init_table(2, table);
+  ASSERT_FALSE(table.enable_inline_key_);
+
+  ObGroupRowItem group;
+  set_key(0, 0, "1234", 4);
+  set_key(1, 0, "5678", 4);
+  make_item(0, 1, group);
+  ASSERT_EQ(OB_SUCCESS, table.set(group));
+  ASSERT_EQ(-1, group.inline_key_len_);
+
+  // all the group by columns are compared
+  ObGroupRowItem probe;
+  set_key(0, 1, "1234", 4);
+  set_key(1, 1, "5678", 4);
+  make_item(1, 1, probe);
+  ASSERT_EQ(&group, table.get(probe));
+  set_key(1, 1, "5679", 4);
+  ASSERT_EQ(nullptr, table.get(probe));
+  table.destroy();
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_group_row_hash_table.log*");
+  OB_LOGGER.set_file_name("test_group_row_hash_table.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -13,6 +13,8 @@
 #define USING_LOG_PREFIX SQL
 
 #include <gtest/gtest.h>
+#define private public
+#define protected public
 #include "lib/alloc/ob_malloc_allocator.h"
 #include "lib/allocator/ob_malloc.h"
 #include "storage/blocksstable/ob_data_file_prepare.h"
@@ -372,6 +374,49 @@ public:
   }
 
   void with_or_without_chunk(bool is_with);
+  // replace the temp file of the store by a copy with one byte flipped
+  void corrupt_file(ObChunkDatumStore &rs, const int64_t offset)
+  {
+    const int64_t size = rs.file_size_;
+    ASSERT_LT(offset, size);
+    char *buf = static_cast<char *>(alloc_.alloc(size));
+    ASSERT_NE(nullptr, buf);
+    blocksstable::ObTmpFileIOHandle handle;
+    int64_t tmp_file_size = 0;
+    ASSERT_EQ(OB_SUCCESS, rs.read_file(buf, size, 0, handle, size, 0, tmp_file_size));
+    buf[offset] ^= 0x1;
+    rs.aio_write_handle_.reset();
+    ASSERT_EQ(OB_SUCCESS, FILE_MANAGER_INSTANCE_V2.remove(rs.io_.fd_));
+    rs.io_.fd_ = -1;
+    ASSERT_EQ(OB_SUCCESS, rs.write_file(buf, size));
+    ASSERT_EQ(size, rs.file_size_);
+  }
+  void dump_and_verify(const ObCompressorType compressor_type, const bool checksum)
+  {
+    ObChunkDatumStore rs;
+    ObChunkDatumStore::Iterator it;
+    ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+    ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+    ASSERT_EQ(OB_SUCCESS, rs.set_dump_format(compressor_type, checksum));
+    rs.set_mem_limit(1L << 30);
+    CALL(append_rows, rs, 10000);
+    ASSERT_EQ(OB_SUCCESS, rs.dump(false, true));
+    ASSERT_EQ(OB_SUCCESS, rs.finish_add_row());
+    ASSERT_EQ(OB_STATE_NOT_MATCH, rs.set_dump_format(compressor_type, checksum));
+    LOG_INFO("dumped", K(compressor_type), K(checksum), K(rs.file_size_), K(rs.get_file_size()));
+    if (NONE_COMPRESSOR != compressor_type) {
+      // the rows share long prefixes of the same string
+      ASSERT_LT(rs.file_size_ * 2, rs.get_file_size());
+    } else if (!checksum) {
+      ASSERT_FALSE(rs.dump_with_header_);
+      ASSERT_EQ(rs.file_size_, rs.get_file_size());
+    }
+    CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true);
+    it.reset();
+    CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, ObChunkDatumStore::BLOCK_SIZE);
+    it.reset();
+    rs.reset();
+  }
 protected:
   const static int64_t COLS = 3;
   bool enable_big_row_ = false;
@@ -1064,6 +1109,69 @@ TEST_F(TestChunkDatumStore, test_append_block)
   rs2.reset();
 }
 
+
+TEST_F(TestChunkDatumStore, dump_with_compression)
+{
+  CALL(dump_and_verify, NONE_COMPRESSOR, false);
+  CALL(dump_and_verify, LZ4_COMPRESSOR, false);
+  CALL(dump_and_verify, LZ4_COMPRESSOR, true);
+  CALL(dump_and_verify, ZSTD_COMPRESSOR, false);
+}
+
+TEST_F(TestChunkDatumStore, dump_checksum_mismatch)
+{
+  ObChunkDatumStore rs;
+  ObChunkDatumStore::Iterator it;
+  ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+  ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+  ASSERT_EQ(OB_SUCCESS, rs.set_dump_format(NONE_COMPRESSOR, true));
+  rs.set_mem_limit(1L << 30);
+  CALL(append_rows, rs, 1000);
+  ASSERT_EQ(OB_SUCCESS, rs.dump(false, true));
+  ASSERT_EQ(OB_SUCCESS, rs.finish_add_row());
+  ASSERT_TRUE(rs.dump_with_header_);
+
+  // flip a byte of the payload of the first block
+  CALL(corrupt_file, rs, sizeof(ObChunkDatumStore::DumpHeader) + 16);
+  ASSERT_EQ(OB_SUCCESS, rs.begin(it));
+  ASSERT_EQ(OB_CHECKSUM_ERROR, it.get_next_row(ver_cells_, eval_ctx_));
+  it.reset();
+  rs.reset();
+}
+
+TEST_F(TestChunkDatumStore, dump_read_ahead_across_blocks)
+{
+  ObChunkDatumStore rs;
+  ObChunkDatumStore::Iterator it;
+  ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+  ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+  ASSERT_EQ(OB_SUCCESS, rs.set_dump_format(NONE_COMPRESSOR, true));
+  rs.set_mem_limit(1L << 30);
+  // blocks of a few rows larger than the read ahead buffers
+  for (int64_t i = 0; i < 3000; i++) {
+    gen_row(i);
+    if (0 == i % 500) {
+      cells_.at(2)->locate_batch_datums(eval_ctx_)[0].set_string(str_buf_, 200 << 10);
+    }
+    ASSERT_EQ(OB_SUCCESS, rs.add_row(cells_, &eval_ctx_));
+  }
+  ASSERT_EQ(OB_SUCCESS, rs.dump(false, true));
+  ASSERT_EQ(OB_SUCCESS, rs.finish_add_row());
+
+  // blocks are not aligned to the read ahead buffers of one block size, most of them cross
+  // the two buffers
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, 2 * ObChunkDatumStore::BLOCK_SIZE);
+  ASSERT_EQ(static_cast<int64_t>(ObChunkDatumStore::BLOCK_SIZE), it.chunk_it_.ra_buf_size_);
+  ASSERT_GE(it.chunk_it_.ra_copy_buf_size_, 200 << 10);
+  ASSERT_EQ(OB_ITER_END, it.get_next_row(ver_cells_, eval_ctx_));
+  it.reset();
+  // and read with the default read ahead size
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true);
+  ASSERT_EQ(OB_ITER_END, it.get_next_row(ver_cells_, eval_ctx_));
+  it.reset();
+  rs.reset();
+}
+
 } // end namespace sql
 } // end namespace oceanbase
 
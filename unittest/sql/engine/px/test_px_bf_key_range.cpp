@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+
+#include "sql/ob_sql_init.h"
+#include "sql/engine/px/ob_px_bloom_filter.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObPxBFKeyRangeTest : public ::testing::Test
+{
+public:
+  ObPxBFKeyRangeTest() = default;
+  virtual ~ObPxBFKeyRangeTest() = default;
+  virtual void SetUp()
+  {
+    cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(ObIntType, ObIntType, NULL_FIRST,
+                                                    CS_TYPE_BINARY, false);
+    ASSERT_TRUE(NULL != cmp_func_);
+  }
+  virtual void TearDown() {};
+  bool contain(const ObPxBFKeyRange &range, const int64_t value)
+  {
+    ObObj obj;
+    ObDatum datum;
+    obj.set_int(value);
+    datum.from_obj(obj);
+    return range.might_contain(datum, cmp_func_);
+  }
+  bool intersect(const ObPxBFKeyRange &range, const int64_t min, const int64_t max)
+  {
+    ObObj min_obj;
+    ObObj max_obj;
+    min_obj.set_int(min);
+    max_obj.set_int(max);
+    return range.might_intersect(min_obj, max_obj);
+  }
+  void add(ObPxBFKeyRange &range, const int64_t value)
+  {
+    ObObj obj;
+    obj.set_int(value);
+    ASSERT_EQ(OB_SUCCESS, range.add(obj));
+  }
+protected:
+  ObDatumCmpFuncType cmp_func_;
+};
+
+TEST_F(ObPxBFKeyRangeTest, in_set)
+{
+  ObPxBFKeyRange range;
+  ObDatum null_datum;
+  null_datum.set_null();
+  ASSERT_FALSE(range.is_valid());
+  ASSERT_TRUE(contain(range, 100));
+
+  add(range, 10);
+  add(range, 30);
+  add(range, 10);
+  ASSERT_TRUE(range.is_valid());
+  ASSERT_TRUE(range.has_in_set());
+  ASSERT_TRUE(contain(range, 10));
+  ASSERT_TRUE(contain(range, 30));
+  ASSERT_FALSE(contain(range, 20));
+  ASSERT_FALSE(contain(range, 40));
+  ASSERT_FALSE(range.might_contain(null_datum, cmp_func_));
+
+  ASSERT_TRUE(intersect(range, 0, 10));
+  ASSERT_TRUE(intersect(range, 25, 35));
+  ASSERT_FALSE(intersect(range, 11, 29));
+  ASSERT_FALSE(intersect(range, 31, 100));
+
+  ObObj null_obj;
+  null_obj.set_null();
+  ASSERT_EQ(OB_SUCCESS, range.add(null_obj));
+  ASSERT_TRUE(range.has_null());
+  ASSERT_TRUE(range.might_contain(null_datum, cmp_func_));
+}
+
+TEST_F(ObPxBFKeyRangeTest, min_max)
+{
+  ObPxBFKeyRange range;
+  for (int64_t i = 0; i <= ObPxBFKeyRange::MAX_IN_SET_COUNT; ++i) {
+    add(range, 100 + i * 10);
+  }
+  ASSERT_TRUE(range.is_valid());
+  ASSERT_FALSE(range.has_in_set());
+  ASSERT_TRUE(contain(range, 100));
+  ASSERT_TRUE(contain(range, 105));
+  ASSERT_FALSE(contain(range, 99));
+  ASSERT_FALSE(contain(range, 100 + ObPxBFKeyRange::MAX_IN_SET_COUNT * 10 + 1));
+  ASSERT_TRUE(intersect(range, 0, 100));
+  ASSERT_FALSE(intersect(range, 0, 99));
+}
+
+TEST_F(ObPxBFKeyRangeTest, merge)
+{
+  ObPxBFKeyRange range;
+  ObPxBFKeyRange other;
+  ObPxBFKeyRange empty;
+  add(range, 10);
+  add(other, 50);
+  ASSERT_EQ(OB_SUCCESS, range.merge(empty));
+  ASSERT_EQ(OB_SUCCESS, range.merge(other));
+  ASSERT_TRUE(range.has_in_set());
+  ASSERT_TRUE(contain(range, 10));
+  ASSERT_TRUE(contain(range, 50));
+  ASSERT_FALSE(contain(range, 30));
+
+  ASSERT_EQ(OB_SUCCESS, empty.merge(range));
+  ASSERT_TRUE(empty.is_valid());
+  ASSERT_FALSE(contain(empty, 30));
+
+  // a sender that does not track the key disables the range
+  ObPxBFKeyRange invalid;
+  invalid.invalidate();
+  ASSERT_EQ(OB_SUCCESS, range.merge(invalid));
+  ASSERT_TRUE(range.is_invalid());
+  ASSERT_EQ(OB_SUCCESS, range.merge(other));
+  ASSERT_TRUE(range.is_invalid());
+  ASSERT_TRUE(contain(range, 30));
+}
+
+TEST_F(ObPxBFKeyRangeTest, serialize)
+{
+  ObPxBFKeyRange range;
+  ObPxBFKeyRange result;
+  char buf[1024];
+  int64_t pos = 0;
+  add(range, -5);
+  add(range, 7);
+  ASSERT_EQ(OB_SUCCESS, range.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(pos, range.get_serialize_size());
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, result.deserialize(buf, sizeof(buf), pos));
+  ASSERT_TRUE(result.is_valid());
+  ASSERT_TRUE(result.has_in_set());
+  ASSERT_TRUE(contain(result, -5));
+  ASSERT_TRUE(contain(result, 7));
+  ASSERT_FALSE(contain(result, 0));
+}
+
+TEST_F(ObPxBFKeyRangeTest, serialize_min_max)
+{
+  ObPxBFKeyRange range;
+  ObPxBFKeyRange result;
+  char buf[1024];
+  int64_t pos = 0;
+  for (int64_t i = 0; i <= ObPxBFKeyRange::MAX_IN_SET_COUNT; ++i) {
+    add(range, -100 + i * 10);
+  }
+  ASSERT_EQ(OB_SUCCESS, range.serialize(buf, sizeof(buf), pos));
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, result.deserialize(buf, sizeof(buf), pos));
+  // the bounds of a received range are probed as datums as well
+  ASSERT_FALSE(result.has_in_set());
+  ASSERT_TRUE(contain(result, -100));
+  ASSERT_TRUE(contain(result, -100 + ObPxBFKeyRange::MAX_IN_SET_COUNT * 10));
+  ASSERT_FALSE(contain(result, -101));
+  ASSERT_FALSE(contain(result, -100 + ObPxBFKeyRange::MAX_IN_SET_COUNT * 10 + 1));
+}
+
+TEST_F(ObPxBFKeyRangeTest, four_byte_key)
+{
+  ObDatumCmpFuncType cmp_func = ObDatumFuncs::get_nullsafe_cmp_func(ObFloatType, ObFloatType,
+                                                                    NULL_FIRST, CS_TYPE_BINARY, false);
+  ASSERT_TRUE(NULL != cmp_func);
+  ObPxBFKeyRange range;
+  ObObj obj;
+  obj.set_float(1.5);
+  ASSERT_EQ(OB_SUCCESS, range.add(obj));
+  obj.set_float(-2.5);
+  ASSERT_EQ(OB_SUCCESS, range.add(obj));
+  ObDatum datum;
+  obj.set_float(-2.5);
+  ASSERT_EQ(OB_SUCCESS, datum.from_obj(obj));
+  ASSERT_TRUE(range.might_contain(datum, cmp_func));
+  obj.set_float(0.5);
+  ASSERT_EQ(OB_SUCCESS, datum.from_obj(obj));
+  ASSERT_FALSE(range.might_contain(datum, cmp_func));
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  init_sql_factories();
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/sort/ob_topn_filter.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "share/datum/ob_datum_funcs.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+class TestTopnFilter : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 8;
+  TestTopnFilter()
+    : alloc_(ObModIds::TEST), exec_ctx_(alloc_), eval_ctx_(exec_ctx_), key_expr_(NULL), skip_(NULL) {}
+  virtual void SetUp() override
+  {
+    eval_ctx_.frames_ = static_cast<char **>(alloc_.alloc(sizeof(char *)));
+    ASSERT_NE(nullptr, eval_ctx_.frames_);
+    const int64_t frame_size = (sizeof(ObDatum) + sizeof(int64_t)) * BATCH_SIZE + sizeof(ObEvalInfo);
+    eval_ctx_.frames_[0] = static_cast<char *>(alloc_.alloc(frame_size));
+    ASSERT_NE(nullptr, eval_ctx_.frames_[0]);
+    memset(eval_ctx_.frames_[0], 0, frame_size);
+    eval_ctx_.set_max_batch_size(BATCH_SIZE);
+    key_expr_ = new (alloc_.alloc(sizeof(ObExpr))) ObExpr();
+    key_expr_->type_ = T_REF_COLUMN;
+    key_expr_->frame_idx_ = 0;
+    key_expr_->batch_result_ = true;
+    key_expr_->batch_idx_mask_ = UINT64_MAX;
+    key_expr_->datum_off_ = 0;
+    key_expr_->eval_info_off_ = sizeof(ObDatum) * BATCH_SIZE;
+    int64_t pos = key_expr_->eval_info_off_ + sizeof(ObEvalInfo);
+    ObDatum *datums = key_expr_->locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      datums[i].ptr_ = eval_ctx_.frames_[0] + pos;
+      pos += sizeof(int64_t);
+    }
+    skip_ = to_bit_vector(alloc_.alloc(ObBitVector::memory_size(BATCH_SIZE)));
+    ASSERT_NE(nullptr, skip_);
+    skip_->reset(BATCH_SIZE);
+    cmp_func_.cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(ObIntType, ObIntType, NULL_FIRST,
+                                                              CS_TYPE_BINARY, false);
+    ASSERT_NE(nullptr, cmp_func_.cmp_func_);
+  }
+  virtual void TearDown() override
+  {
+    alloc_.reset();
+  }
+protected:
+  void init_filter(const bool is_ascending, ObTopnFilter &filter)
+  {
+    ObSortFieldCollation collation(0, CS_TYPE_BINARY, is_ascending,
+                                   is_ascending ? NULL_FIRST : NULL_LAST);
+    ASSERT_EQ(OB_SUCCESS, filter.init(OB_SYS_TENANT_ID, key_expr_, collation, cmp_func_));
+  }
+  void set_keys(const int64_t *keys, const int64_t cnt)
+  {
+    ObDatum *datums = key_expr_->locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < cnt; ++i) {
+      datums[i].set_int(keys[i]);
+    }
+  }
+  void update(ObTopnFilter &filter, const int64_t key)
+  {
+    int64_t v = key;
+    ObDatum datum;
+    datum.ptr_ = reinterpret_cast<const char *>(&v);
+    datum.pack_ = sizeof(v);
+    ASSERT_EQ(OB_SUCCESS, filter.update(datum));
+    // the filter keeps its own copy of the boundary, the heap top may be freed
+    v = 0;
+    ASSERT_EQ(key, filter.boundary_.get_int());
+  }
+
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObExpr *key_expr_;
+  ObBitVector *skip_;
+  ObSortCmpFunc cmp_func_;
+};
+
+TEST_F(TestTopnFilter, ascending)
+{
+  ObTopnFilter filter;
+  init_filter(true, filter);
+  const int64_t keys[] = { 50, 100, 101, 200 };
+  set_keys(keys, 4);
+
+  // nothing is filtered before the heap is full
+  ASSERT_FALSE(filter.is_ready());
+  ASSERT_EQ(OB_SUCCESS, filter.filter_batch(eval_ctx_, *skip_, 4));
+  ASSERT_EQ(0, skip_->accumulate_bit_cnt(4));
+
+  // ties of the heap top are kept for fetch with ties
+  update(filter, 100);
+  ASSERT_TRUE(filter.is_ready());
+  ASSERT_EQ(OB_SUCCESS, filter.filter_batch(eval_ctx_, *skip_, 4));
+  ASSERT_FALSE(skip_->at(0));
+  ASSERT_FALSE(skip_->at(1));
+  ASSERT_TRUE(skip_->at(2));
+  ASSERT_TRUE(skip_->at(3));
+  ASSERT_EQ(2, filter.filter_cnt_);
+
+  // the boundary is tightened as the heap improves, skipped rows are not counted again
+  update(filter, 60);
+  ASSERT_EQ(OB_SUCCESS, filter.filter_batch(eval_ctx_, *skip_, 4));
+  ASSERT_FALSE(skip_->at(0));
+  ASSERT_TRUE(skip_->at(1));
+  ASSERT_EQ(3, filter.filter_cnt_);
+  ASSERT_EQ(2, filter.update_cnt_);
+  // a new heap top with the same first key doesn't copy the key again
+  update(filter, 60);
+  ASSERT_EQ(2, filter.update_cnt_);
+
+  // rescan of the sort forgets the boundary
+  filter.reset();
+  ASSERT_FALSE(filter.is_ready());
+  filter.destroy();
+}
+
+TEST_F(TestTopnFilter, descending)
+{
+  ObTopnFilter filter;
+  init_filter(false, filter);
+  const int64_t keys[] = { 50, 100, 101, 200 };
+  set_keys(keys, 4);
+  update(filter, 100);
+  ASSERT_EQ(OB_SUCCESS, filter.filter_batch(eval_ctx_, *skip_, 4));
+  ASSERT_TRUE(skip_->at(0));
+  ASSERT_FALSE(skip_->at(1));
+  ASSERT_FALSE(skip_->at(2));
+  ASSERT_FALSE(skip_->at(3));
+
+  // null sorts last in descending order and is worse than any boundary
+  ObDatum null_datum;
+  null_datum.set_null();
+  ASSERT_TRUE(filter.can_filter(null_datum));
+  filter.destroy();
+}
+
+TEST_F(TestTopnFilter, not_inited)
+{
+  ObTopnFilter filter;
+  ObDatum datum;
+  datum.set_int(1);
+  ASSERT_EQ(OB_NOT_INIT, filter.update(datum));
+  ASSERT_EQ(OB_NOT_INIT, filter.filter_batch(eval_ctx_, *skip_, 4));
+  init_filter(true, filter);
+  ObSortFieldCollation collation;
+  ASSERT_EQ(OB_INIT_TWICE, filter.init(OB_SYS_TENANT_ID, key_expr_, collation, cmp_func_));
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_topn_filter.log*");
+  OB_LOGGER.set_file_name("test_topn_filter.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
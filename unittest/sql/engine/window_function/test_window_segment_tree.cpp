@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/window_function/ob_window_function_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "share/datum/ob_datum_funcs.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+typedef ObWindowFunctionOp::SegmentTree SegmentTree;
+typedef ObWindowFunctionOp::Frame Frame;
+
+class TestWindowSegmentTree : public ::testing::Test
+{
+public:
+  // rows of the partition don't start at the first row of the store
+  static const int64_t BEGIN_IDX = 10;
+  static const int64_t ROW_CNT = 100;
+  TestWindowSegmentTree()
+    : alloc_(ObModIds::TEST), exec_ctx_(alloc_), eval_ctx_(exec_ctx_), param_expr_(NULL),
+      aggr_expr_(NULL) {}
+  virtual void SetUp() override
+  {
+    eval_ctx_.frames_ = static_cast<char **>(alloc_.alloc(sizeof(char *)));
+    ASSERT_NE(nullptr, eval_ctx_.frames_);
+    const int64_t frame_size = sizeof(ObDatum) + sizeof(ObEvalInfo) + sizeof(int64_t);
+    eval_ctx_.frames_[0] = static_cast<char *>(alloc_.alloc(frame_size));
+    ASSERT_NE(nullptr, eval_ctx_.frames_[0]);
+    memset(eval_ctx_.frames_[0], 0, frame_size);
+    param_expr_ = new (alloc_.alloc(sizeof(ObExpr))) ObExpr();
+    aggr_expr_ = new (alloc_.alloc(sizeof(ObExpr))) ObExpr();
+    aggr_expr_->frame_idx_ = 0;
+    aggr_expr_->batch_idx_mask_ = 0;
+    aggr_expr_->datum_off_ = 0;
+    aggr_expr_->eval_info_off_ = sizeof(ObDatum);
+    aggr_expr_->res_buf_off_ = sizeof(ObDatum) + sizeof(ObEvalInfo);
+    aggr_expr_->res_buf_len_ = sizeof(int64_t);
+    aggr_expr_->basic_funcs_ = ObDatumFuncs::get_basic_func(ObIntType, CS_TYPE_BINARY, false);
+    ASSERT_NE(nullptr, aggr_expr_->basic_funcs_);
+    for (int64_t i = 0; i < ROW_CNT; ++i) {
+      is_null_[i] = (0 == i % 13) || (i >= 40 && i < 46);
+      values_[i] = (i * 7919) % 1000 - 500;
+      bits_[i] = (static_cast<uint64_t>(i) * 2654435761UL) | (1UL << (i % 64));
+    }
+  }
+  virtual void TearDown() override
+  {
+    alloc_.reset();
+  }
+protected:
+  void init_info(const ObItemType func_type, WinFuncInfo &wf_info)
+  {
+    wf_info.func_type_ = func_type;
+    wf_info.upper_.is_preceding_ = true;
+    wf_info.set_allocator(&alloc_);
+    wf_info.aggr_info_.expr_ = aggr_expr_;
+    ASSERT_EQ(OB_SUCCESS, wf_info.aggr_info_.param_exprs_.init(1));
+    ASSERT_EQ(OB_SUCCESS, wf_info.aggr_info_.param_exprs_.push_back(param_expr_));
+  }
+  // set the leaves like SegmentTree::build does with the rows of the partition
+  void build_tree(const WinFuncInfo &wf_info, SegmentTree &tree)
+  {
+    const bool is_bit_aggr = is_bit(wf_info);
+    tree.wf_info_ = &wf_info;
+    tree.begin_idx_ = BEGIN_IDX;
+    tree.leaf_cnt_ = ROW_CNT;
+    tree.nodes_ = static_cast<int64_t *>(tree.allocator_.alloc(2 * ROW_CNT * sizeof(int64_t)));
+    ASSERT_NE(nullptr, tree.nodes_);
+    tree.values_ = static_cast<ObDatum *>(tree.allocator_.alloc(ROW_CNT * sizeof(ObDatum)));
+    ASSERT_NE(nullptr, tree.values_);
+    for (int64_t i = 0; i < ROW_CNT; ++i) {
+      int64_t &leaf = tree.nodes_[ROW_CNT + i];
+      if (is_null_[i]) {
+        leaf = tree.identity();
+      } else if (is_bit_aggr) {
+        leaf = static_cast<int64_t>(bits_[i]);
+      } else {
+        ObDatum datum;
+        datum.ptr_ = reinterpret_cast<const char *>(&values_[i]);
+        datum.pack_ = sizeof(int64_t);
+        ASSERT_EQ(OB_SUCCESS, tree.values_[i].deep_copy(datum, tree.allocator_));
+        leaf = i;
+      }
+    }
+    tree.build_inner_nodes();
+    ASSERT_TRUE(tree.is_built());
+  }
+  static bool is_bit(const WinFuncInfo &wf_info)
+  {
+    return T_FUN_SYS_BIT_AND == wf_info.func_type_ || T_FUN_SYS_BIT_OR == wf_info.func_type_;
+  }
+  // aggregate rows [head, tail] of the partition one by one
+  void check_all_frames(const WinFuncInfo &wf_info, const SegmentTree &tree)
+  {
+    for (int64_t head = 0; head < ROW_CNT; ++head) {
+      bool has_value = false;
+      int64_t extremum = 0;
+      uint64_t bits = T_FUN_SYS_BIT_AND == wf_info.func_type_ ? UINT64_MAX : 0;
+      for (int64_t tail = head; tail < ROW_CNT; ++tail) {
+        if (is_null_[tail]) {
+        } else if (T_FUN_SYS_BIT_AND == wf_info.func_type_) {
+          bits &= bits_[tail];
+        } else if (T_FUN_SYS_BIT_OR == wf_info.func_type_) {
+          bits |= bits_[tail];
+        } else if (!has_value) {
+          extremum = values_[tail];
+          has_value = true;
+        } else if (T_FUN_MIN == wf_info.func_type_) {
+          extremum = MIN(extremum, values_[tail]);
+        } else {
+          extremum = MAX(extremum, values_[tail]);
+        }
+        ObDatum val;
+        ASSERT_EQ(OB_SUCCESS, tree.query(Frame(BEGIN_IDX + head, BEGIN_IDX + tail), eval_ctx_, val));
+        if (is_bit(wf_info)) {
+          ASSERT_EQ(bits, val.get_uint()) << head << " " << tail;
+        } else if (!has_value) {
+          ASSERT_TRUE(val.is_null()) << head << " " << tail;
+        } else {
+          ASSERT_FALSE(val.is_null()) << head << " " << tail;
+          ASSERT_EQ(extremum, val.get_int()) << head << " " << tail;
+        }
+      }
+    }
+  }
+
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObExpr *param_expr_;
+  ObExpr *aggr_expr_;
+  bool is_null_[ROW_CNT];
+  int64_t values_[ROW_CNT];
+  uint64_t bits_[ROW_CNT];
+};
+
+TEST_F(TestWindowSegmentTree, is_supported)
+{
+  WinFuncInfo wf_info;
+  init_info(T_FUN_MIN, wf_info);
+  ASSERT_TRUE(SegmentTree::is_supported(wf_info));
+  wf_info.func_type_ = T_FUN_SYS_BIT_OR;
+  ASSERT_TRUE(SegmentTree::is_supported(wf_info));
+  // SUM and COUNT have an inverse
+  wf_info.func_type_ = T_FUN_SUM;
+  ASSERT_FALSE(SegmentTree::is_supported(wf_info));
+  wf_info.func_type_ = T_FUN_MAX;
+  wf_info.aggr_info_.has_distinct_ = true;
+  ASSERT_FALSE(SegmentTree::is_supported(wf_info));
+  wf_info.aggr_info_.has_distinct_ = false;
+  // the frame head never moves, neither does the aggregation restart
+  wf_info.upper_.is_unbounded_ = true;
+  ASSERT_FALSE(SegmentTree::is_supported(wf_info));
+}
+
+TEST_F(TestWindowSegmentTree, min_max)
+{
+  WinFuncInfo min_info;
+  init_info(T_FUN_MIN, min_info);
+  SegmentTree min_tree;
+  build_tree(min_info, min_tree);
+  check_all_frames(min_info, min_tree);
+
+  WinFuncInfo max_info;
+  init_info(T_FUN_MAX, max_info);
+  SegmentTree max_tree;
+  build_tree(max_info, max_tree);
+  check_all_frames(max_info, max_tree);
+}
+
+TEST_F(TestWindowSegmentTree, bit_and_or)
+{
+  WinFuncInfo and_info;
+  init_info(T_FUN_SYS_BIT_AND, and_info);
+  SegmentTree and_tree;
+  build_tree(and_info, and_tree);
+  check_all_frames(and_info, and_tree);
+
+  WinFuncInfo or_info;
+  init_info(T_FUN_SYS_BIT_OR, or_info);
+  SegmentTree or_tree;
+  build_tree(or_info, or_tree);
+  check_all_frames(or_info, or_tree);
+}
+
+TEST_F(TestWindowSegmentTree, invalid_frame)
+{
+  WinFuncInfo wf_info;
+  init_info(T_FUN_MIN, wf_info);
+  SegmentTree tree;
+  ObDatum val;
+  ASSERT_EQ(OB_NOT_INIT, tree.query(Frame(BEGIN_IDX, BEGIN_IDX), eval_ctx_, val));
+  build_tree(wf_info, tree);
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.query(Frame(BEGIN_IDX - 1, BEGIN_IDX), eval_ctx_, val));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.query(Frame(BEGIN_IDX, BEGIN_IDX + ROW_CNT), eval_ctx_, val));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.query(Frame(BEGIN_IDX + 1, BEGIN_IDX), eval_ctx_, val));
+  // a new partition needs a new build
+  tree.reset();
+  ASSERT_FALSE(tree.is_built());
+  ASSERT_EQ(OB_NOT_INIT, tree.query(Frame(BEGIN_IDX, BEGIN_IDX), eval_ctx_, val));
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_window_segment_tree.log*");
+  OB_LOGGER.set_file_name("test_window_segment_tree.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
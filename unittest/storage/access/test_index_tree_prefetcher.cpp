@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define USING_LOG_PREFIX STORAGE
+
+#define protected public
+#define private public
+
+#include "storage/access/ob_index_tree_prefetcher.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+
+namespace unittest
+{
+class TestIndexTreePrefetcher : public ::testing::Test
+{
+public:
+  typedef ObIndexTreeMultiPassPrefetcher::PendingIOIdxArray PendingIOIdxArray;
+  static const int64_t MAX_BLOCK_CNT = 32;
+  TestIndexTreePrefetcher() : block_cnt_(0) {}
+  virtual ~TestIndexTreePrefetcher() = default;
+  virtual void SetUp() override { block_cnt_ = 0; }
+  virtual void TearDown() override {}
+protected:
+  // add a pending data block of macro block with the block index @macro_idx
+  void add_block(
+      const int64_t macro_idx,
+      const int64_t offset,
+      const int64_t size,
+      PendingIOIdxArray &pending_io_idxs);
+  // cut the pending blocks into ios and return the io end positions
+  void split_io(PendingIOIdxArray &pending_io_idxs, ObIArray<int64_t> &io_ends);
+  int64_t block_cnt_;
+  ObIndexBlockRowHeader row_headers_[MAX_BLOCK_CNT];
+  ObMicroIndexInfo micro_infos_[MAX_BLOCK_CNT];
+};
+
+void TestIndexTreePrefetcher::add_block(
+    const int64_t macro_idx,
+    const int64_t offset,
+    const int64_t size,
+    PendingIOIdxArray &pending_io_idxs)
+{
+  ASSERT_LT(block_cnt_, static_cast<int64_t>(MAX_BLOCK_CNT));
+  ObIndexBlockRowHeader &row_header = row_headers_[block_cnt_];
+  row_header.set_data_block();
+  row_header.block_offset_ = static_cast<int32_t>(offset);
+  row_header.block_size_ = static_cast<int32_t>(size);
+  ObMicroIndexInfo &micro_info = micro_infos_[block_cnt_];
+  micro_info.row_header_ = &row_header;
+  micro_info.parent_macro_id_ = MacroBlockId(0, macro_idx + 1, 0);
+  ASSERT_EQ(OB_SUCCESS, pending_io_idxs.push_back(block_cnt_));
+  ++block_cnt_;
+}
+
+void TestIndexTreePrefetcher::split_io(PendingIOIdxArray &pending_io_idxs, ObIArray<int64_t> &io_ends)
+{
+  ObIndexTreeMultiPassPrefetcher::sort_pending_io(micro_infos_, pending_io_idxs);
+  int64_t start_pos = 0;
+  while (start_pos < pending_io_idxs.count()) {
+    start_pos = ObIndexTreeMultiPassPrefetcher::get_coalesced_io_end(micro_infos_, pending_io_idxs, start_pos);
+    ASSERT_EQ(OB_SUCCESS, io_ends.push_back(start_pos));
+  }
+}
+
+TEST_F(TestIndexTreePrefetcher, test_sort_pending_io)
+{
+  PendingIOIdxArray pending_io_idxs;
+  add_block(1, 8192, 4096, pending_io_idxs);
+  add_block(0, 4096, 4096, pending_io_idxs);
+  add_block(1, 0, 4096, pending_io_idxs);
+  add_block(0, 0, 4096, pending_io_idxs);
+  // rowkeys in the same micro block stay in rowkey order
+  add_block(0, 4096, 4096, pending_io_idxs);
+  ObIndexTreeMultiPassPrefetcher::sort_pending_io(micro_infos_, pending_io_idxs);
+  const int64_t expected[] = {3, 1, 4, 2, 0};
+  ASSERT_EQ(5, pending_io_idxs.count());
+  for (int64_t i = 0; i < pending_io_idxs.count(); ++i) {
+    ASSERT_EQ(expected[i], pending_io_idxs.at(i));
+  }
+}
+
+TEST_F(TestIndexTreePrefetcher, test_coalesce_neighbour_blocks)
+{
+  PendingIOIdxArray pending_io_idxs;
+  ObSEArray<int64_t, 8> io_ends;
+  // adjacent blocks and blocks within the gap are read by one io
+  add_block(0, 0, 4096, pending_io_idxs);
+  add_block(0, 4096, 4096, pending_io_idxs);
+  add_block(0, 8192 + ObIndexTreeMultiPassPrefetcher::MAX_COALESCE_IO_GAP, 4096, pending_io_idxs);
+  // rowkeys in the same micro block share the io
+  add_block(0, 4096, 4096, pending_io_idxs);
+  split_io(pending_io_idxs, io_ends);
+  ASSERT_EQ(1, io_ends.count());
+  ASSERT_EQ(4, io_ends.at(0));
+}
+
+TEST_F(TestIndexTreePrefetcher, test_coalesce_boundary)
+{
+  PendingIOIdxArray pending_io_idxs;
+  ObSEArray<int64_t, 8> io_ends;
+  // gap one byte over the limit
+  add_block(0, 0, 4096, pending_io_idxs);
+  add_block(0, 4096 + ObIndexTreeMultiPassPrefetcher::MAX_COALESCE_IO_GAP + 1, 4096, pending_io_idxs);
+  // another macro block
+  add_block(1, 0, 4096, pending_io_idxs);
+  add_block(1, 4096, 4096, pending_io_idxs);
+  split_io(pending_io_idxs, io_ends);
+  ASSERT_EQ(3, io_ends.count());
+  ASSERT_EQ(1, io_ends.at(0));
+  ASSERT_EQ(2, io_ends.at(1));
+  ASSERT_EQ(4, io_ends.at(2));
+}
+
+TEST_F(TestIndexTreePrefetcher, test_coalesce_io_size_limit)
+{
+  PendingIOIdxArray pending_io_idxs;
+  ObSEArray<int64_t, 8> io_ends;
+  const int64_t block_size = 512 * 1024;
+  const int64_t max_block_cnt = ObIndexTreeMultiPassPrefetcher::MAX_COALESCE_IO_SIZE / block_size;
+  for (int64_t i = 0; i < max_block_cnt + 1; ++i) {
+    add_block(0, i * block_size, block_size, pending_io_idxs);
+  }
+  split_io(pending_io_idxs, io_ends);
+  ASSERT_EQ(2, io_ends.count());
+  ASSERT_EQ(max_block_cnt, io_ends.at(0));
+  ASSERT_EQ(max_block_cnt + 1, io_ends.at(1));
+}
+
+TEST_F(TestIndexTreePrefetcher, test_coalesce_single_block)
+{
+  PendingIOIdxArray pending_io_idxs;
+  ObSEArray<int64_t, 8> io_ends;
+  add_block(0, 0, ObIndexTreeMultiPassPrefetcher::MAX_COALESCE_IO_SIZE + 4096, pending_io_idxs);
+  add_block(0, ObIndexTreeMultiPassPrefetcher::MAX_COALESCE_IO_SIZE + 4096, 4096, pending_io_idxs);
+  split_io(pending_io_idxs, io_ends);
+  // a block larger than the io size limit is still read alone
+  ASSERT_EQ(2, io_ends.count());
+  ASSERT_EQ(1, io_ends.at(0));
+  ASSERT_EQ(2, io_ends.at(1));
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_index_tree_prefetcher.log*");
+  OB_LOGGER.set_file_name("test_index_tree_prefetcher.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
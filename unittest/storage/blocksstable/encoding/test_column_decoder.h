@@ -175,7 +175,8 @@ void TestColumnDecoder::SetUp()
     set_column_type_integer();
   } else if (column_encoding_type_ == ObColumnHeader::Type::HEX_PACKING
       || column_encoding_type_ == ObColumnHeader::Type::STRING_DIFF
-      || column_encoding_type_ == ObColumnHeader::Type::STRING_PREFIX) {
+      || column_encoding_type_ == ObColumnHeader::Type::STRING_PREFIX
+      || column_encoding_type_ == ObColumnHeader::Type::STRING_FSST) {
     set_column_type_string();
   } else {
     set_column_type_default();
@@ -81,6 +81,13 @@ public:
   virtual ~TestStringPrefixDecoder() {}
 };
 
+class TestFsstStringDecoder : public TestColumnDecoder
+{
+public:
+  TestFsstStringDecoder() : TestColumnDecoder(ObColumnHeader::Type::STRING_FSST) {}
+  virtual ~TestFsstStringDecoder() {}
+};
+
 TEST_F(TestIntBaseDiffDecoder, filter_pushdown_comaprison_neg_test)
 {
   filter_pushdown_comaprison_neg_test();
@@ -116,6 +123,56 @@ TEST_F(TestIntBaseDiffDecoder, batch_decode_to_datum_test)
   batch_decode_to_datum_test();
 }
 
+TEST_F(TestIntBaseDiffDecoder, fast_filter_and_unpack_test)
+{
+  ASSERT_TRUE(int_diff_fast_funcs_inited);
+  const int64_t row_cnt = ObIntegerBaseDiffDecoder::UNPACK_BATCH_SIZE + 37;
+  const int64_t data_offset = 3;
+  char col_data[row_cnt * sizeof(uint64_t)];
+  char bv_buf[sql::ObBitVector::memory_size(row_cnt)];
+  uint32_t deltas[row_cnt];
+  sql::ObBitVector *bit_vec = sql::to_bit_vector(bv_buf);
+
+  // packed-domain filters on every fixed delta length
+  for (int64_t len_tag = 0; len_tag < 4; ++len_tag) {
+    const int64_t len = 1L << len_tag;
+    const uint64_t mask = INTEGER_MASK_TABLE[len];
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      const uint64_t v = (0 == i % 3) ? mask : static_cast<uint64_t>(ObRandom::rand(0, 100)) & mask;
+      MEMCPY(col_data + i * len, &v, len);
+    }
+    const uint64_t param = 50;
+    for (int32_t op = sql::WHITE_OP_EQ; op <= sql::WHITE_OP_NE; ++op) {
+      bit_vec->reset(row_cnt);
+      int_diff_fix_filter_funcs[len_tag][op](
+          row_cnt, reinterpret_cast<const unsigned char *>(col_data), param, *bit_vec);
+      for (int64_t i = 0; i < row_cnt; ++i) {
+        uint64_t v = 0;
+        MEMCPY(&v, col_data + i * len, len);
+        ASSERT_EQ(fp_int_cmp<uint64_t>(v, param, static_cast<ObFPIntCmpOpType>(op)),
+            bit_vec->at(i)) << "len: " << len << " op: " << op << " row: " << i;
+      }
+    }
+  }
+
+  // bit packed deltas behind extend value bits
+  for (int64_t packed_len = 1; packed_len <= ObIntegerBaseDiffDecoder::MAX_FAST_UNPACK_LEN; ++packed_len) {
+    MEMSET(col_data, 0, sizeof(col_data));
+    const int64_t bs_len = data_offset + row_cnt * packed_len;
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      const uint64_t v = static_cast<uint64_t>(i * 7919) & ObBitStream::get_mask(packed_len);
+      ObBitStream::memory_safe_set(reinterpret_cast<unsigned char *>(col_data),
+          data_offset + i * packed_len, packed_len, v);
+    }
+    int_diff_bp_unpack(reinterpret_cast<const unsigned char *>(col_data),
+        data_offset, bs_len, packed_len, 1, row_cnt - 1, deltas);
+    for (int64_t i = 1; i < row_cnt; ++i) {
+      ASSERT_EQ(static_cast<uint64_t>(i * 7919) & ObBitStream::get_mask(packed_len), deltas[i - 1])
+          << "packed_len: " << packed_len << " row: " << i;
+    }
+  }
+}
+
 TEST_F(TestHexDecoder, batch_decode_to_datum_test)
 {
   batch_decode_to_datum_test();
@@ -131,6 +188,58 @@ TEST_F(TestStringPrefixDecoder, batch_decode_to_datum_test)
   batch_decode_to_datum_test();
 }
 
+TEST_F(TestFsstStringDecoder, basic_filter_pushdown_op_test_eq_ne_nu_nn)
+{
+  basic_filter_pushdown_eq_ne_nu_nn_test();
+}
+
+TEST_F(TestFsstStringDecoder, batch_decode_to_datum_test)
+{
+  batch_decode_to_datum_test();
+}
+
+TEST_F(TestFsstStringDecoder, symbol_table_test)
+{
+  const char *values[] = {"http://www.oceanbase.com/index", "http://www.oceanbase.com/docs",
+      "http://www.example.com/index", "", "oceanbase", "http://", "\xff\xfe escape bytes"};
+  const int64_t value_cnt = ARRAYSIZEOF(values);
+  ObString samples[value_cnt];
+  for (int64_t i = 0; i < value_cnt; ++i) {
+    samples[i].assign_ptr(values[i], static_cast<int32_t>(strlen(values[i])));
+  }
+  ObFsstSymbolTable table;
+  ASSERT_EQ(OB_SUCCESS, table.build(samples, value_cnt, allocator_));
+  ASSERT_GT(table.get_symbol_cnt(), 0);
+  ASSERT_LE(table.get_symbol_cnt(), ObFsstSymbolTable::MAX_SYMBOL_CNT);
+
+  char header_buf[ObFsstStringHeader::get_size(ObFsstSymbolTable::MAX_SYMBOL_CNT)];
+  ObFsstStringHeader *header = reinterpret_cast<ObFsstStringHeader *>(header_buf);
+  header->reset();
+  table.store(*header);
+  ObFsstSymbolTable loaded_table;
+  ASSERT_EQ(OB_SUCCESS, loaded_table.load(*header));
+
+  int64_t raw_size = 0;
+  int64_t compressed_size = 0;
+  for (int64_t i = 0; i < value_cnt; ++i) {
+    const int64_t len = samples[i].length();
+    const unsigned char *str = reinterpret_cast<const unsigned char *>(samples[i].ptr());
+    unsigned char compressed[len * 2 + 1];
+    unsigned char reloaded[len * 2 + 1];
+    unsigned char decompressed[len + ObFsstSymbolTable::MAX_SYMBOL_LEN];
+    const int64_t compressed_len = table.compress(str, len, compressed);
+    // compression is deterministic, filter constant is compressed with the loaded table
+    ASSERT_EQ(compressed_len, loaded_table.compress(str, len, reloaded));
+    ASSERT_EQ(0, MEMCMP(compressed, reloaded, compressed_len));
+    ASSERT_EQ(len, ObFsstSymbolTable::decompress(header->symbols(), header->symbol_lens(),
+        compressed, compressed_len, decompressed));
+    ASSERT_EQ(0, MEMCMP(str, decompressed, len));
+    raw_size += len;
+    compressed_size += compressed_len;
+  }
+  ASSERT_LT(compressed_size, raw_size);
+}
+
 // TEST_F(TestDictDecoder, batch_decode_perf_test)
 // {
 //   batch_get_row_perf_test();
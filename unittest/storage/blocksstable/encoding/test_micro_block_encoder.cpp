@@ -221,6 +221,46 @@ TEST_F(TestDictLargeVarchar, test_dict_large_varchar)
   ASSERT_TRUE(ObDatum::binary_equal(row.storage_datums_[3], read_row.storage_datums_[3]));
 }
 
+TEST_F(TestDictLargeVarchar, test_fsst_cluster_version)
+{
+  // fsst is only chosen after the whole cluster can decode it
+  const int64_t row_cnt = 256;
+  const int64_t versions[] = { cal_version(3, 1, 0, 0), CLUSTER_VERSION_4_1_0_0, CLUSTER_VERSION_4_2_0_0 };
+  for (int64_t v = 0; v < ARRAYSIZEOF(versions); ++v) {
+    ctx_.major_working_cluster_version_ = versions[v];
+    ObMicroBlockEncoder encoder;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+    ObDatumRow row;
+    ASSERT_EQ(OB_SUCCESS, row.init(allocator_, full_column_cnt_));
+    char str_buf[row_cnt][128];
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      const int64_t len = snprintf(str_buf[i], sizeof(str_buf[i]),
+          "https://www.example.com/catalog/item_%ld/detail?ref=search&page=%ld", i * 7919, i % 13);
+      row.storage_datums_[0].set_int(i);
+      row.storage_datums_[1].set_int(-1);
+      row.storage_datums_[2].set_int(0);
+      row.storage_datums_[3].set_string(str_buf[i], len);
+      ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+    }
+    char *buf = nullptr;
+    int64_t size = 0;
+    ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+
+    ObMicroBlockData micro_data(buf, size);
+    ObMicroBlockDecoder decoder;
+    ObDatumRow read_row;
+    ASSERT_EQ(OB_SUCCESS, read_row.init(full_column_cnt_));
+    ASSERT_EQ(OB_SUCCESS, decoder.init(micro_data, read_info_));
+    if (versions[v] < CLUSTER_VERSION_4_2_0_0) {
+      ASSERT_NE(ObColumnHeader::STRING_FSST, decoder.col_header_[3].type_);
+    }
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, read_row));
+      ASSERT_EQ(0, read_row.storage_datums_[3].get_string().compare(str_buf[i]));
+    }
+  }
+}
+
 class TestEncodingRowBufHolder : public ::testing::Test
 {
 public:
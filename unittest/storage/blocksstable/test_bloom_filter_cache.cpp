@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define USING_LOG_PREFIX STORAGE
+
+#define protected public
+#define private public
+
+#include "ob_data_file_prepare.h"
+#include "storage/blocksstable/ob_bloom_filter_cache.h"
+#include "share/ob_cluster_version.h"
+#include "share/ob_simple_mem_limit_getter.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace blocksstable;
+static ObSimpleMemLimitGetter getter;
+
+namespace unittest
+{
+class TestBloomFilterCache : public TestDataFilePrepare
+{
+public:
+  static const int64_t ROWKEY_CNT = 2;
+  static const int64_t ROW_CNT = 1000;
+  TestBloomFilterCache();
+  virtual ~TestBloomFilterCache() = default;
+  virtual void SetUp() override;
+  virtual void TearDown() override;
+protected:
+  void make_rowkey(const int64_t c1, const int64_t c2, ObDatumRowkey &rowkey);
+  // bloom filter on the first column of rowkeys (i, i) for i in [0, ROW_CNT)
+  void prepare_prefix_bloom_filter(ObBloomFilterCacheValue &bf_value);
+  ObStorageDatum datums_[ROWKEY_CNT];
+  ObStorageDatumUtils datum_utils_;
+};
+
+TestBloomFilterCache::TestBloomFilterCache()
+  : TestDataFilePrepare(&getter, "TestBloomFilterCache", 2 * 1024 * 1024, 100)
+{
+}
+
+void TestBloomFilterCache::SetUp()
+{
+  ASSERT_EQ(OB_SUCCESS, getter.add_tenant(TENANT_ID, 512L * 1024L * 1024L, 1024L * 1024L * 1024L));
+  TestDataFilePrepare::SetUp();
+  ObSEArray<schema::ObColDesc, ROWKEY_CNT> col_descs;
+  for (int64_t i = 0; i < ROWKEY_CNT; ++i) {
+    schema::ObColDesc col_desc;
+    col_desc.col_id_ = OB_APP_MIN_COLUMN_ID + i;
+    col_desc.col_type_.set_int();
+    ASSERT_EQ(OB_SUCCESS, col_descs.push_back(col_desc));
+  }
+  ASSERT_EQ(OB_SUCCESS, datum_utils_.init(col_descs, ROWKEY_CNT, false, allocator_));
+  ObClusterVersion::get_instance().update_cluster_version(CLUSTER_VERSION_4_2_0_0);
+}
+
+void TestBloomFilterCache::TearDown()
+{
+  datum_utils_.reset();
+  TestDataFilePrepare::TearDown();
+  getter.reset();
+}
+
+void TestBloomFilterCache::make_rowkey(const int64_t c1, const int64_t c2, ObDatumRowkey &rowkey)
+{
+  datums_[0].set_int(c1);
+  datums_[1].set_int(c2);
+  ASSERT_EQ(OB_SUCCESS, rowkey.assign(datums_, ROWKEY_CNT));
+}
+
+void TestBloomFilterCache::prepare_prefix_bloom_filter(ObBloomFilterCacheValue &bf_value)
+{
+  ASSERT_EQ(OB_SUCCESS, bf_value.init(1, ROW_CNT));
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    ObDatumRowkey rowkey;
+    ObDatumRowkey prefix_key;
+    uint64_t key_hash = 0;
+    make_rowkey(i, i, rowkey);
+    ASSERT_EQ(OB_SUCCESS, prefix_key.assign(rowkey.datums_, 1));
+    ASSERT_EQ(OB_SUCCESS, prefix_key.murmurhash(0, datum_utils_, key_hash));
+    ASSERT_EQ(OB_SUCCESS, bf_value.insert(static_cast<uint32_t>(key_hash)));
+  }
+}
+
+TEST_F(TestBloomFilterCache, test_split_block_cluster_version)
+{
+  // servers before 4.2 can not read split block bloom filters
+  ObClusterVersion::get_instance().update_cluster_version(CLUSTER_VERSION_4_1_0_0);
+  ObBloomFilterCacheValue classic_value;
+  ASSERT_EQ(OB_SUCCESS, classic_value.init(ROWKEY_CNT, ROW_CNT));
+  ASSERT_EQ(static_cast<int64_t>(ObBloomFilterCacheValue::BLOOM_FILTER_CACHE_VALUE_VERSION), classic_value.version_);
+  ASSERT_FALSE(classic_value.bloom_filter_.is_split_block());
+
+  ObClusterVersion::get_instance().update_cluster_version(CLUSTER_VERSION_4_2_0_0);
+  ObBloomFilterCacheValue split_value;
+  ASSERT_EQ(OB_SUCCESS, split_value.init(ROWKEY_CNT, ROW_CNT));
+  ASSERT_EQ(static_cast<int64_t>(ObBloomFilterCacheValue::SPLIT_BLOCK_BLOOM_FILTER_VERSION), split_value.version_);
+  ASSERT_TRUE(split_value.bloom_filter_.is_split_block());
+  // filters of different layouts are never merged
+  ASSERT_FALSE(split_value.could_merge_bloom_filter(classic_value));
+
+  // the layout survives serialization
+  const ObBloomFilterCacheValue *values[] = { &classic_value, &split_value };
+  for (int64_t i = 0; i < 2; ++i) {
+    const int64_t buf_size = values[i]->get_serialize_size();
+    char *buf = static_cast<char *>(allocator_.alloc(buf_size));
+    ASSERT_NE(nullptr, buf);
+    int64_t pos = 0;
+    ASSERT_EQ(OB_SUCCESS, values[i]->serialize(buf, buf_size, pos));
+    ObBloomFilterCacheValue value;
+    pos = 0;
+    ASSERT_EQ(OB_SUCCESS, value.deserialize(buf, buf_size, pos));
+    ASSERT_EQ(values[i]->version_, value.version_);
+    ASSERT_EQ(values[i]->bloom_filter_.is_split_block(), value.bloom_filter_.is_split_block());
+  }
+}
+
+TEST_F(TestBloomFilterCache, test_prefix_len_per_tablet)
+{
+  ObBloomFilterCache &bf_cache = OB_STORE_CACHE.get_bf_cache();
+  const ObTabletID tablet_id(200001);
+  ObTabletID other_tablet_id(200002);
+  while (bf_cache.get_prefix_len_bitmap(other_tablet_id) == bf_cache.get_prefix_len_bitmap(tablet_id)) {
+    other_tablet_id = ObTabletID(other_tablet_id.id() + 1);
+  }
+  const MacroBlockId macro_id(0, 1, 0);
+  ObBloomFilterCacheValue bf_value;
+  prepare_prefix_bloom_filter(bf_value);
+  ASSERT_EQ(OB_SUCCESS, bf_cache.put_bloom_filter(TENANT_ID, tablet_id, macro_id, bf_value));
+  ASSERT_NE(0UL, *bf_cache.get_prefix_len_bitmap(tablet_id) & (1UL << 1));
+  ASSERT_EQ(0UL, *bf_cache.get_prefix_len_bitmap(other_tablet_id));
+
+  // probes of the full rowkey fall back to the prefix filter of the tablet
+  ObDatumRowkey rowkey;
+  bool is_contain = false;
+  make_rowkey(1, 100, rowkey);
+  ASSERT_EQ(OB_SUCCESS, bf_cache.may_contain(TENANT_ID, tablet_id, macro_id, rowkey, ROWKEY_CNT,
+      datum_utils_, is_contain));
+  ASSERT_TRUE(is_contain);
+  int64_t filter_cnt = 0;
+  for (int64_t i = ROW_CNT; i < 2 * ROW_CNT; ++i) {
+    make_rowkey(i, i, rowkey);
+    ASSERT_EQ(OB_SUCCESS, bf_cache.may_contain(TENANT_ID, tablet_id, macro_id, rowkey, ROWKEY_CNT,
+        datum_utils_, is_contain));
+    if (!is_contain) {
+      ++filter_cnt;
+    }
+  }
+  ASSERT_GT(filter_cnt, ROW_CNT / 2);
+
+  // other tablets and probes without tablet only look up the filter on the full rowkey
+  make_rowkey(1, 100, rowkey);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, bf_cache.may_contain(TENANT_ID, other_tablet_id, macro_id, rowkey,
+      ROWKEY_CNT, datum_utils_, is_contain));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, bf_cache.may_contain(TENANT_ID, macro_id, rowkey, datum_utils_, is_contain));
+  ASSERT_TRUE(is_contain);
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_bloom_filter_cache.log*");
+  OB_LOGGER.set_file_name("test_bloom_filter_cache.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
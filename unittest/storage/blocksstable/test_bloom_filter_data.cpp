@@ -324,6 +324,35 @@ TEST_F(TestBloomFilterDataReaderWriter, test_cache_value_merge)
   EXPECT_EQ(OB_SUCCESS, ret);
 }
 
+TEST_F(TestBloomFilterDataReaderWriter, test_split_block_bloom_filter)
+{
+  const int64_t element_cnt = 10000;
+  ObBloomFilter bf;
+  bool is_contain = false;
+  int64_t false_positive_cnt = 0;
+
+  ASSERT_EQ(OB_SUCCESS, bf.init(element_cnt, ObBloomFilter::BLOOM_FILTER_FALSE_POSITIVE_PROB, true));
+  ASSERT_TRUE(bf.is_split_block());
+  ASSERT_EQ(0, bf.get_nbit() % ObBloomFilter::SPLIT_BLOCK_BITS);
+  for (int64_t i = 0; i < element_cnt; ++i) {
+    const uint64_t key = static_cast<uint64_t>(i);
+    ASSERT_EQ(OB_SUCCESS, bf.insert(static_cast<uint32_t>(murmurhash(&key, sizeof(key), 0))));
+  }
+  for (int64_t i = 0; i < element_cnt; ++i) {
+    const uint64_t key = static_cast<uint64_t>(i);
+    ASSERT_EQ(OB_SUCCESS, bf.may_contain(static_cast<uint32_t>(murmurhash(&key, sizeof(key), 0)), is_contain));
+    ASSERT_TRUE(is_contain);
+  }
+  for (int64_t i = element_cnt; i < element_cnt * 2; ++i) {
+    const uint64_t key = static_cast<uint64_t>(i);
+    ASSERT_EQ(OB_SUCCESS, bf.may_contain(static_cast<uint32_t>(murmurhash(&key, sizeof(key), 0)), is_contain));
+    if (is_contain) {
+      ++false_positive_cnt;
+    }
+  }
+  EXPECT_LT(false_positive_cnt, element_cnt * 2 / 100);
+}
+
 TEST_F(TestBloomFilterDataReaderWriter, test_writer_reader)
 {
   int ret = OB_SUCCESS;
@@ -0,0 +1,427 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_index_block_aggregator.h"
+#include "storage/access/ob_aggregated_store.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace share::schema;
+using namespace storage;
+
+namespace unittest
+{
+class TestIndexBlockAggregator : public ::testing::Test
+{
+public:
+  // c0(int, rowkey) | trans version | sql sequence | c1(varchar) | c2(int)
+  static const int64_t ROWKEY_CNT = 1;
+  static const int64_t COLUMN_CNT = 5;
+public:
+  TestIndexBlockAggregator() : allocator_(ObModIds::TEST) {}
+  void SetUp();
+  virtual void TearDown() { desc_.reset(); }
+  void fill_row(const int64_t key, const char *str, const bool c2_null, ObDatumRow &row);
+  // build a micro index info with the skip index of rows evaluated by the aggregator
+  void build_index_info(
+      ObSkipIndexAggregator &aggregator,
+      ObIndexBlockRowHeader &row_header,
+      ObMicroIndexInfo &index_info);
+  void check_number(const char *expect, const ObSumAggCell &sum_cell);
+protected:
+  ObArenaAllocator allocator_;
+  ObDataStoreDesc desc_;
+};
+
+void TestIndexBlockAggregator::SetUp()
+{
+  ObColDesc col_desc;
+  desc_.micro_block_size_ = 16 * 1024;
+  desc_.micro_block_size_limit_ = 16 * 1024;
+  desc_.row_column_count_ = COLUMN_CNT;
+  desc_.rowkey_column_count_ = ROWKEY_CNT + 2;
+  desc_.schema_rowkey_col_cnt_ = ROWKEY_CNT;
+  desc_.schema_version_ = 1;
+  desc_.ls_id_ = share::ObLSID(1001);
+  desc_.tablet_id_ = ObTabletID(200001);
+  desc_.compressor_type_ = ObCompressorType::NONE_COMPRESSOR;
+  desc_.snapshot_version_ = 10;
+  desc_.skip_index_col_cnt_ = COLUMN_CNT;
+  ASSERT_EQ(OB_SUCCESS, desc_.col_desc_array_.init(COLUMN_CNT));
+  for (int64_t i = 0; i < COLUMN_CNT; ++i) {
+    col_desc.col_id_ = OB_APP_MIN_COLUMN_ID + i;
+    if (3 == i) {
+      col_desc.col_type_.set_varchar();
+      col_desc.col_type_.set_collation_type(CS_TYPE_UTF8MB4_BIN);
+    } else {
+      col_desc.col_type_.set_int();
+    }
+    ASSERT_EQ(OB_SUCCESS, desc_.col_desc_array_.push_back(col_desc));
+  }
+}
+
+void TestIndexBlockAggregator::fill_row(
+    const int64_t key,
+    const char *str,
+    const bool c2_null,
+    ObDatumRow &row)
+{
+  row.storage_datums_[0].set_int(key);
+  row.storage_datums_[1].set_int(-10);
+  row.storage_datums_[2].set_int(0);
+  if (nullptr == str) {
+    row.storage_datums_[3].set_null();
+  } else {
+    row.storage_datums_[3].set_string(str, static_cast<int32_t>(strlen(str)));
+  }
+  if (c2_null) {
+    row.storage_datums_[4].set_null();
+  } else {
+    row.storage_datums_[4].set_int(key * 10);
+  }
+  row.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+}
+
+void TestIndexBlockAggregator::build_index_info(
+    ObSkipIndexAggregator &aggregator,
+    ObIndexBlockRowHeader &row_header,
+    ObMicroIndexInfo &index_info)
+{
+  const char *agg_buf = nullptr;
+  int64_t agg_size = 0;
+  ASSERT_EQ(OB_SUCCESS, aggregator.get_aggregated_row(agg_buf, agg_size));
+  row_header.row_count_ = aggregator.get_row_count();
+  index_info.reset();
+  index_info.row_header_ = &row_header;
+  index_info.agg_row_buf_ = agg_buf;
+  index_info.agg_buf_size_ = agg_size;
+}
+
+void TestIndexBlockAggregator::check_number(const char *expect, const ObSumAggCell &sum_cell)
+{
+  ObArenaAllocator allocator;
+  number::ObNumber expect_nmb;
+  number::ObNumber sum_nmb;
+  ASSERT_EQ(OB_SUCCESS, expect_nmb.from(expect, allocator));
+  ASSERT_EQ(OB_SUCCESS, sum_cell.get_sum(sum_nmb, allocator));
+  ASSERT_TRUE(sum_nmb.is_equal(expect_nmb)) << "expect: " << expect;
+}
+
+TEST_F(TestIndexBlockAggregator, test_eval_and_read)
+{
+  ObSkipIndexAggregator aggregator;
+  ObDatumRow row;
+  const char *agg_buf = nullptr;
+  int64_t agg_size = 0;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, COLUMN_CNT));
+  ASSERT_EQ(OB_SUCCESS, aggregator.init(desc_, allocator_));
+
+  fill_row(5, "bbb", true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(3, "a string longer than sixteen bytes", true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(9, nullptr, true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  ASSERT_EQ(3, aggregator.get_row_count());
+  ASSERT_EQ(OB_SUCCESS, aggregator.get_aggregated_row(agg_buf, agg_size));
+
+  ObAggRowReader reader;
+  const ObAggColHeader *col_header = nullptr;
+  ObDatum min;
+  ObDatum max;
+  ObDatum sum;
+  ASSERT_EQ(OB_SUCCESS, reader.init(agg_buf, agg_size));
+  ASSERT_EQ(COLUMN_CNT, reader.get_col_cnt());
+
+  // rowkey column
+  ASSERT_EQ(OB_SUCCESS, reader.read(0, col_header, min, max, sum));
+  ASSERT_TRUE(nullptr != col_header);
+  ASSERT_TRUE(col_header->is_min_max_valid());
+  ASSERT_TRUE(col_header->is_sum_valid());
+  ASSERT_EQ(0, col_header->null_count_);
+  ASSERT_EQ(3, min.get_int());
+  ASSERT_EQ(9, max.get_int());
+  ASSERT_EQ(17, sum.get_int());
+
+  // multi-version column is not tracked
+  ASSERT_EQ(OB_SUCCESS, reader.read(1, col_header, min, max));
+  ASSERT_TRUE(nullptr != col_header);
+  ASSERT_FALSE(col_header->is_min_max_valid());
+
+  // long string invalidates min/max
+  ASSERT_EQ(OB_SUCCESS, reader.read(3, col_header, min, max));
+  ASSERT_TRUE(nullptr != col_header);
+  ASSERT_TRUE(col_header->is_null_count_valid());
+  ASSERT_FALSE(col_header->is_min_max_valid());
+  ASSERT_FALSE(col_header->is_sum_valid());
+  ASSERT_EQ(1, col_header->null_count_);
+
+  // all null column
+  ASSERT_EQ(OB_SUCCESS, reader.read(4, col_header, min, max));
+  ASSERT_TRUE(nullptr != col_header);
+  ASSERT_TRUE(col_header->is_null_count_valid());
+  ASSERT_FALSE(col_header->is_sum_valid());
+  ASSERT_EQ(3, col_header->null_count_);
+
+  // out of aggregated columns
+  ASSERT_EQ(OB_SUCCESS, reader.read(COLUMN_CNT, col_header, min, max));
+  ASSERT_TRUE(nullptr == col_header);
+
+  // reuse for next micro block
+  aggregator.reuse();
+  fill_row(20, "ccc", false, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(11, "abc", false, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  row.storage_datums_[4].set_nop();
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  ASSERT_EQ(OB_SUCCESS, aggregator.get_aggregated_row(agg_buf, agg_size));
+  ASSERT_EQ(OB_SUCCESS, reader.init(agg_buf, agg_size));
+
+  ASSERT_EQ(OB_SUCCESS, reader.read(3, col_header, min, max));
+  ASSERT_TRUE(col_header->is_min_max_valid());
+  ASSERT_EQ(0, col_header->null_count_);
+  ASSERT_EQ(0, min.get_string().compare("abc"));
+  ASSERT_EQ(0, max.get_string().compare("ccc"));
+
+  // nop invalidates null count, min/max and sum
+  ASSERT_EQ(OB_SUCCESS, reader.read(4, col_header, min, max));
+  ASSERT_FALSE(col_header->is_null_count_valid());
+  ASSERT_FALSE(col_header->is_min_max_valid());
+  ASSERT_FALSE(col_header->is_sum_valid());
+
+  // overflow invalidates sum only
+  aggregator.reuse();
+  fill_row(INT64_MAX, "a", true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(1, "b", true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  ASSERT_EQ(OB_SUCCESS, aggregator.get_aggregated_row(agg_buf, agg_size));
+  ASSERT_EQ(OB_SUCCESS, reader.init(agg_buf, agg_size));
+  ASSERT_EQ(OB_SUCCESS, reader.read(0, col_header, min, max, sum));
+  ASSERT_TRUE(col_header->is_min_max_valid());
+  ASSERT_FALSE(col_header->is_sum_valid());
+  ASSERT_EQ(1, min.get_int());
+  ASSERT_EQ(INT64_MAX, max.get_int());
+}
+
+TEST_F(TestIndexBlockAggregator, test_invalid_agg_row)
+{
+  ObAggRowReader reader;
+  ObAggRowHeader header;
+  header.col_cnt_ = 2;
+  header.length_ = sizeof(ObAggRowHeader);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, reader.init(nullptr, 0));
+  ASSERT_EQ(OB_INVALID_DATA, reader.init(reinterpret_cast<const char *>(&header), sizeof(header)));
+}
+
+TEST_F(TestIndexBlockAggregator, test_min_max_agg_cell)
+{
+  ObColumnParam col_param(allocator_);
+  col_param.set_meta_type(desc_.col_desc_array_.at(4).col_type_);
+  ObAggDatumBuf datum_buf(allocator_);
+  ObMinMaxAggCell min_cell(4, 4, &col_param, nullptr, allocator_, datum_buf, true);
+  ObMinMaxAggCell max_cell(4, 4, &col_param, nullptr, allocator_, datum_buf, false);
+  ASSERT_EQ(OB_SUCCESS, min_cell.init());
+  ASSERT_EQ(OB_SUCCESS, max_cell.init());
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, COLUMN_CNT));
+
+  // nulls are ignored, the result is null without values
+  fill_row(1, "a", true, row);
+  ASSERT_EQ(OB_SUCCESS, min_cell.process(row));
+  ASSERT_EQ(OB_SUCCESS, max_cell.process(row));
+  ASSERT_TRUE(min_cell.datum_.is_null());
+  ASSERT_TRUE(max_cell.datum_.is_null());
+  fill_row(5, "a", false, row);
+  ASSERT_EQ(OB_SUCCESS, min_cell.process(row));
+  ASSERT_EQ(OB_SUCCESS, max_cell.process(row));
+  fill_row(2, "a", true, row);
+  ASSERT_EQ(OB_SUCCESS, min_cell.process(row));
+  ASSERT_EQ(OB_SUCCESS, max_cell.process(row));
+  ASSERT_EQ(50, min_cell.datum_.get_int());
+  ASSERT_EQ(50, max_cell.datum_.get_int());
+
+  // skip index of a whole block, c2 is 30, 70, 90
+  ObSkipIndexAggregator aggregator;
+  ObIndexBlockRowHeader row_header;
+  ObMicroIndexInfo index_info;
+  ASSERT_EQ(OB_SUCCESS, aggregator.init(desc_, allocator_));
+  fill_row(3, "b", false, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(7, "b", false, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(9, "b", false, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  build_index_info(aggregator, row_header, index_info);
+  ASSERT_TRUE(min_cell.can_agg_index_info(index_info));
+  ASSERT_TRUE(max_cell.can_agg_index_info(index_info));
+  ASSERT_EQ(OB_SUCCESS, min_cell.process(index_info));
+  ASSERT_EQ(OB_SUCCESS, max_cell.process(index_info));
+  ASSERT_EQ(30, min_cell.datum_.get_int());
+  ASSERT_EQ(90, max_cell.datum_.get_int());
+
+  // rows after the skip index
+  fill_row(1, "c", false, row);
+  ASSERT_EQ(OB_SUCCESS, min_cell.process(row));
+  ASSERT_EQ(OB_SUCCESS, max_cell.process(row));
+  fill_row(20, "c", false, row);
+  ASSERT_EQ(OB_SUCCESS, min_cell.process(row));
+  ASSERT_EQ(OB_SUCCESS, max_cell.process(row));
+  ASSERT_EQ(10, min_cell.datum_.get_int());
+  ASSERT_EQ(200, max_cell.datum_.get_int());
+
+  // all null block can be skipped without changing the result
+  aggregator.reuse();
+  fill_row(4, "d", true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(6, "d", true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  build_index_info(aggregator, row_header, index_info);
+  ASSERT_TRUE(min_cell.can_agg_index_info(index_info));
+  ASSERT_EQ(OB_SUCCESS, min_cell.process(index_info));
+  ASSERT_EQ(OB_SUCCESS, max_cell.process(index_info));
+  ASSERT_EQ(10, min_cell.datum_.get_int());
+  ASSERT_EQ(200, max_cell.datum_.get_int());
+
+  // block with a nop row has no min/max, must be descended
+  aggregator.reuse();
+  fill_row(4, "e", false, row);
+  row.storage_datums_[4].set_nop();
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  build_index_info(aggregator, row_header, index_info);
+  ASSERT_FALSE(min_cell.can_agg_index_info(index_info));
+  ASSERT_FALSE(max_cell.can_agg_index_info(index_info));
+
+  // skip index of another column type is not used
+  ObColumnParam varchar_param(allocator_);
+  varchar_param.set_meta_type(desc_.col_desc_array_.at(3).col_type_);
+  ObMinMaxAggCell type_changed_cell(4, 4, &varchar_param, nullptr, allocator_, datum_buf, true);
+  aggregator.reuse();
+  fill_row(4, "f", false, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  build_index_info(aggregator, row_header, index_info);
+  ASSERT_FALSE(type_changed_cell.can_agg_index_info(index_info));
+
+  min_cell.reuse();
+  ASSERT_TRUE(min_cell.datum_.is_null());
+}
+
+TEST_F(TestIndexBlockAggregator, test_sum_agg_cell)
+{
+  ObColumnParam col_param(allocator_);
+  col_param.set_meta_type(desc_.col_desc_array_.at(4).col_type_);
+  sql::ObExpr expr;
+  expr.datum_meta_.type_ = ObNumberType;
+  ObAggDatumBuf datum_buf(allocator_);
+  ObSumAggCell sum_cell(4, 4, &col_param, &expr, allocator_, datum_buf);
+  ASSERT_EQ(OB_SUCCESS, sum_cell.init());
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, COLUMN_CNT));
+
+  // nulls only, no value
+  fill_row(1, "a", true, row);
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(row));
+  ASSERT_FALSE(sum_cell.has_value_);
+
+  // rows and skip index mixed, 10 + (30 + 70) + 20
+  fill_row(1, "a", false, row);
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(row));
+  ObSkipIndexAggregator aggregator;
+  ObIndexBlockRowHeader row_header;
+  ObMicroIndexInfo index_info;
+  ASSERT_EQ(OB_SUCCESS, aggregator.init(desc_, allocator_));
+  fill_row(3, "b", false, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(7, "b", false, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  fill_row(8, "b", true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  build_index_info(aggregator, row_header, index_info);
+  ASSERT_TRUE(sum_cell.can_agg_index_info(index_info));
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(index_info));
+  fill_row(2, "c", false, row);
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(row));
+  ASSERT_TRUE(sum_cell.has_value_);
+  ASSERT_FALSE(sum_cell.has_nmb_sum_);
+  check_number("130", sum_cell);
+
+  // all null block does not produce a value
+  sum_cell.reuse();
+  aggregator.reuse();
+  fill_row(4, "d", true, row);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  build_index_info(aggregator, row_header, index_info);
+  ASSERT_TRUE(sum_cell.can_agg_index_info(index_info));
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(index_info));
+  ASSERT_FALSE(sum_cell.has_value_);
+
+  // overflow of the integer sum moves to number
+  sum_cell.reuse();
+  row.storage_datums_[4].set_int(INT64_MAX);
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(row));
+  row.storage_datums_[4].set_int(INT64_MAX);
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(row));
+  ASSERT_TRUE(sum_cell.has_nmb_sum_);
+  row.storage_datums_[4].set_int(2);
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(row));
+  check_number("18446744073709551616", sum_cell);
+  row.storage_datums_[4].set_int(INT64_MIN);
+  ASSERT_EQ(OB_SUCCESS, sum_cell.process(row));
+  check_number("9223372036854775808", sum_cell);
+
+  // block whose integer sum overflowed has no sum in skip index, must be descended
+  aggregator.reuse();
+  fill_row(5, "e", false, row);
+  row.storage_datums_[4].set_int(INT64_MAX);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  row.storage_datums_[4].set_int(1);
+  ASSERT_EQ(OB_SUCCESS, aggregator.eval(row));
+  build_index_info(aggregator, row_header, index_info);
+  ASSERT_FALSE(sum_cell.can_agg_index_info(index_info));
+
+  // unsigned overflow
+  ObColumnParam uint_param(allocator_);
+  ObObjMeta uint_meta;
+  uint_meta.set_uint64();
+  uint_param.set_meta_type(uint_meta);
+  ObSumAggCell uint_cell(4, 4, &uint_param, &expr, allocator_, datum_buf);
+  ASSERT_EQ(OB_SUCCESS, uint_cell.init());
+  row.storage_datums_[4].set_uint(UINT64_MAX);
+  ASSERT_EQ(OB_SUCCESS, uint_cell.process(row));
+  row.storage_datums_[4].set_uint(3);
+  ASSERT_EQ(OB_SUCCESS, uint_cell.process(row));
+  check_number("18446744073709551618", uint_cell);
+
+  // sum of varchar is not supported
+  ObColumnParam varchar_param(allocator_);
+  varchar_param.set_meta_type(desc_.col_desc_array_.at(3).col_type_);
+  ObSumAggCell varchar_cell(3, 3, &varchar_param, &expr, allocator_, datum_buf);
+  ASSERT_EQ(OB_NOT_SUPPORTED, varchar_cell.init());
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_index_block_aggregator.log*");
+  OB_LOGGER.set_file_name("test_index_block_aggregator.log", true, true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
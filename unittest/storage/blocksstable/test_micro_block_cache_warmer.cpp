@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define USING_LOG_PREFIX STORAGE
+
+#define protected public
+#define private public
+
+#include "ob_data_file_prepare.h"
+#include "storage/blocksstable/ob_micro_block_cache_warmer.h"
+#include "storage/blocksstable/ob_macro_block_common_header.h"
+#include "storage/blocksstable/ob_sstable_macro_block_header.h"
+#include "share/ob_simple_mem_limit_getter.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace storage;
+using namespace blocksstable;
+static ObSimpleMemLimitGetter getter;
+
+namespace unittest
+{
+class TestMicroBlockCacheWarmer : public TestDataFilePrepare
+{
+public:
+  static const int64_t MACRO_BLOCK_CNT = 3;
+  static const int64_t BF_ROW_CNT = 100000;
+  static const int64_t FILLER_BF_CNT = 32;
+  static const uint64_t TABLET_ID = 200001;
+  static constexpr const char *MANIFEST_PATH = "./test_micro_block_cache_warmer.manifest";
+  TestMicroBlockCacheWarmer();
+  virtual ~TestMicroBlockCacheWarmer() = default;
+  virtual void SetUp() override;
+  virtual void TearDown() override;
+protected:
+  void write_macro_block(const int64_t data_checksum, ObMacroBlockHandle &macro_handle);
+  void put_bloom_filter(const MacroBlockId &macro_id, const uint32_t hash_base);
+  void wait_warm_up(ObMicroBlockCacheWarmer &warmer);
+  ObMacroBlockHandle macro_handles_[MACRO_BLOCK_CNT];
+};
+
+TestMicroBlockCacheWarmer::TestMicroBlockCacheWarmer()
+  : TestDataFilePrepare(&getter, "TestMicroBlockCacheWarmer", 64 * 1024, 100)
+{
+}
+
+void TestMicroBlockCacheWarmer::SetUp()
+{
+  ASSERT_EQ(OB_SUCCESS, getter.add_tenant(TENANT_ID, 512L * 1024L * 1024L, 1024L * 1024L * 1024L));
+  TestDataFilePrepare::SetUp();
+  GCONF._micro_block_cache_manifest_size.set_value("64M");
+  ::unlink(MANIFEST_PATH);
+  for (int64_t i = 0; i < MACRO_BLOCK_CNT; ++i) {
+    write_macro_block(i + 1, macro_handles_[i]);
+  }
+}
+
+void TestMicroBlockCacheWarmer::TearDown()
+{
+  for (int64_t i = 0; i < MACRO_BLOCK_CNT; ++i) {
+    macro_handles_[i].reset();
+  }
+  ::unlink(MANIFEST_PATH);
+  GCONF._micro_block_cache_manifest_size.set_value("0M");
+  TestDataFilePrepare::TearDown();
+  getter.reset();
+}
+
+void TestMicroBlockCacheWarmer::write_macro_block(
+    const int64_t data_checksum,
+    ObMacroBlockHandle &macro_handle)
+{
+  const int64_t buf_size = 64 * 1024;
+  char *buf = static_cast<char *>(allocator_.alloc(buf_size));
+  ASSERT_NE(nullptr, buf);
+  MEMSET(buf, 0, buf_size);
+  ObMacroBlockCommonHeader common_header;
+  common_header.reset();
+  common_header.attr_ = ObMacroBlockCommonHeader::SSTableData;
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, common_header.serialize(buf, buf_size, pos));
+  ObSSTableMacroBlockHeader::FixedHeader fixed_header;
+  fixed_header.header_size_ = ObSSTableMacroBlockHeader::get_fixed_header_size();
+  fixed_header.tablet_id_ = TABLET_ID;
+  fixed_header.column_count_ = 1;
+  fixed_header.rowkey_column_count_ = 1;
+  fixed_header.row_count_ = BF_ROW_CNT;
+  fixed_header.occupy_size_ = buf_size;
+  fixed_header.micro_block_count_ = 1;
+  fixed_header.micro_block_data_offset_ = pos + fixed_header.header_size_;
+  fixed_header.micro_block_data_size_ = 1;
+  fixed_header.data_checksum_ = data_checksum;
+  fixed_header.compressor_type_ = ObCompressorType::NONE_COMPRESSOR;
+  ASSERT_TRUE(fixed_header.is_valid());
+  MEMCPY(buf + pos, &fixed_header, ObSSTableMacroBlockHeader::get_fixed_header_size());
+
+  ObMacroBlockWriteInfo write_info;
+  write_info.io_desc_.set_category(ObIOCategory::SYS_IO);
+  write_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_COMPACT_WRITE);
+  write_info.buffer_ = buf;
+  write_info.size_ = buf_size;
+  ASSERT_EQ(OB_SUCCESS, ObBlockManager::write_block(write_info, macro_handle));
+}
+
+void TestMicroBlockCacheWarmer::put_bloom_filter(const MacroBlockId &macro_id, const uint32_t hash_base)
+{
+  ObBloomFilterCacheValue bf_value;
+  ASSERT_EQ(OB_SUCCESS, bf_value.init(1, BF_ROW_CNT));
+  for (uint32_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(OB_SUCCESS, bf_value.insert(hash_base + i));
+  }
+  ASSERT_EQ(OB_SUCCESS, OB_STORE_CACHE.get_bf_cache().put_bloom_filter(
+      TENANT_ID, ObTabletID(TABLET_ID), macro_id, bf_value));
+}
+
+void TestMicroBlockCacheWarmer::wait_warm_up(ObMicroBlockCacheWarmer &warmer)
+{
+  const int64_t start_ts = ObTimeUtility::current_time();
+  while (!ATOMIC_LOAD(&warmer.warm_up_done_)
+      && ObTimeUtility::current_time() - start_ts < 10 * 1000 * 1000) {
+    ob_usleep(10 * 1000);
+  }
+  ASSERT_TRUE(ATOMIC_LOAD(&warmer.warm_up_done_));
+}
+
+TEST_F(TestMicroBlockCacheWarmer, test_warm_up_bloom_filter)
+{
+  ObBloomFilterCache &bf_cache = OB_STORE_CACHE.get_bf_cache();
+  ObMicroBlockCacheWarmer warmer;
+  ASSERT_EQ(OB_SUCCESS, warmer.init(MANIFEST_PATH, OB_STORE_CACHE.get_index_block_cache(),
+      OB_STORE_CACHE.get_block_cache(), bf_cache));
+  // no manifest to warm up from
+  ASSERT_EQ(OB_SUCCESS, warmer.start());
+  wait_warm_up(warmer);
+  ASSERT_EQ(0, warmer.bf_load_cnt_);
+
+  // bloom filters of the macro blocks, followed by ones of freed macro blocks to fill up
+  // kv cache mem blocks, pairs of the mem block in use are not recorded
+  for (int64_t i = 0; i < MACRO_BLOCK_CNT; ++i) {
+    put_bloom_filter(macro_handles_[i].get_macro_id(), static_cast<uint32_t>(i * 1000));
+  }
+  const MacroBlockId &macro_id = macro_handles_[0].get_macro_id();
+  for (int64_t i = 0; i < FILLER_BF_CNT; ++i) {
+    put_bloom_filter(MacroBlockId(macro_id.first_id(), 10000 + i, 0), 0);
+  }
+  // manifest is dumped at shutdown
+  warmer.stop();
+  warmer.wait();
+  ObMicroBlockCacheWarmer::EntryArray index_entries;
+  ObMicroBlockCacheWarmer::EntryArray data_entries;
+  ObMicroBlockCacheWarmer::BloomFilters bloom_filters;
+  ASSERT_EQ(OB_SUCCESS, warmer.read_manifest(index_entries, data_entries, bloom_filters));
+  ASSERT_EQ(static_cast<int64_t>(MACRO_BLOCK_CNT), bloom_filters.entries_.count());
+  for (int64_t i = 0; i < bloom_filters.entries_.count(); ++i) {
+    const ObBloomFilterManifestEntry &entry = bloom_filters.entries_.at(i);
+    ASSERT_TRUE(entry.is_valid());
+    ASSERT_EQ(TENANT_ID, entry.tenant_id_);
+    bool found = false;
+    for (int64_t j = 0; j < MACRO_BLOCK_CNT; ++j) {
+      if (entry.get_macro_id() == macro_handles_[j].get_macro_id()) {
+        ASSERT_EQ(j + 1, entry.macro_data_checksum_);
+        found = true;
+      }
+    }
+    ASSERT_TRUE(found);
+  }
+  // the last macro block is rewritten after the manifest is made
+  for (int64_t i = 0; i < bloom_filters.entries_.count(); ++i) {
+    ObBloomFilterManifestEntry &entry = bloom_filters.entries_.at(i);
+    if (entry.get_macro_id() == macro_handles_[MACRO_BLOCK_CNT - 1].get_macro_id()) {
+      entry.macro_data_checksum_ = 0;
+    }
+  }
+  ASSERT_EQ(OB_SUCCESS, warmer.write_manifest(index_entries, data_entries, bloom_filters));
+  warmer.destroy();
+
+  // restart with empty bloom filter cache
+  ObKVCacheHandle handle;
+  const ObBloomFilterCacheValue *bf_value = nullptr;
+  for (int64_t i = 0; i < MACRO_BLOCK_CNT; ++i) {
+    ObBloomFilterCacheKey bf_key(TENANT_ID, macro_handles_[i].get_macro_id(), 1);
+    ASSERT_EQ(OB_SUCCESS, bf_cache.erase(bf_key));
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, bf_cache.get(bf_key, bf_value, handle));
+  }
+  ASSERT_EQ(OB_SUCCESS, warmer.init(MANIFEST_PATH, OB_STORE_CACHE.get_index_block_cache(),
+      OB_STORE_CACHE.get_block_cache(), bf_cache));
+  ASSERT_EQ(OB_SUCCESS, warmer.start());
+  wait_warm_up(warmer);
+  ASSERT_EQ(MACRO_BLOCK_CNT - 1, warmer.bf_load_cnt_);
+  ASSERT_EQ(1, warmer.skip_cnt_);
+
+  int64_t hit_cnt = 0;
+  for (int64_t i = 0; i < MACRO_BLOCK_CNT; ++i) {
+    ObBloomFilterCacheKey bf_key(TENANT_ID, macro_handles_[i].get_macro_id(), 1);
+    if (OB_SUCCESS == bf_cache.get(bf_key, bf_value, handle)) {
+      ++hit_cnt;
+      for (uint32_t j = 0; j < 100; ++j) {
+        bool is_contain = false;
+        ASSERT_EQ(OB_SUCCESS, bf_value->may_contain(static_cast<uint32_t>(i * 1000 + j), is_contain));
+        ASSERT_TRUE(is_contain);
+      }
+      handle.reset();
+    } else {
+      ASSERT_EQ(MACRO_BLOCK_CNT - 1, i);
+    }
+  }
+  ASSERT_EQ(MACRO_BLOCK_CNT - 1, hit_cnt);
+  warmer.destroy();
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_cache_warmer.log*");
+  OB_LOGGER.set_file_name("test_micro_block_cache_warmer.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_micro_block_flash_cache.h"
+#include "storage/blocksstable/ob_micro_block_writer.h"
+#include "storage/blocksstable/ob_index_block_row_scanner.h"
+#include "share/ob_simple_mem_limit_getter.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+static ObSimpleMemLimitGetter getter;
+
+namespace unittest
+{
+class TestMicroBlockFlashCache : public ::testing::Test
+{
+public:
+  static const uint64_t TENANT_ID = 1;
+  static const int64_t BLOCK_SIZE = 200 * 1024;
+  static const int64_t SEGMENT_CNT = ObMicroBlockFlashCache::MIN_SEGMENT_CNT;
+  static constexpr const char *FILE_PATH = "./test_micro_block_flash_cache.file";
+  TestMicroBlockFlashCache() : allocator_(ObModIds::TEST), block_buf_(nullptr) {}
+  virtual void SetUp();
+  virtual void TearDown();
+protected:
+  static ObMicroBlockCacheKey get_key(const int64_t idx);
+  void fill_block(const int64_t idx, char *buf);
+  bool check_block(const int64_t idx, const ObMicroBlockData &block_data);
+  // demote data block @idx and flush full segment like the writer thread
+  void demote(const int64_t idx);
+  ObMicroBlockFlashCache flash_cache_;
+  ObDataMicroBlockCache block_cache_;
+  ObArenaAllocator allocator_;
+  char *block_buf_;
+};
+
+void TestMicroBlockFlashCache::SetUp()
+{
+  const int64_t bucket_num = 1024;
+  const int64_t max_cache_size = 1024L * 1024L * 1024L;
+  const int64_t block_size = lib::ACHUNK_SIZE;
+  ASSERT_EQ(OB_SUCCESS, getter.add_tenant(TENANT_ID, 256L * 1024L * 1024L, 512L * 1024L * 1024L));
+  int ret = ObKVGlobalCache::get_instance().init(&getter, bucket_num, max_cache_size, block_size);
+  if (OB_INIT_TWICE == ret) {
+    ret = OB_SUCCESS;
+  }
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(OB_SUCCESS, block_cache_.init("data_block_cache", 1));
+  ASSERT_EQ(OB_SUCCESS, flash_cache_.init(FILE_PATH, SEGMENT_CNT * ObMicroBlockFlashCache::SEGMENT_SIZE));
+  ASSERT_NE(nullptr, block_buf_ = static_cast<char *>(allocator_.alloc(BLOCK_SIZE)));
+}
+
+void TestMicroBlockFlashCache::TearDown()
+{
+  flash_cache_.destroy();
+  block_cache_.destroy();
+  ObKVGlobalCache::get_instance().destroy();
+  getter.reset();
+  allocator_.reset();
+  ::unlink(FILE_PATH);
+}
+
+ObMicroBlockCacheKey TestMicroBlockFlashCache::get_key(const int64_t idx)
+{
+  return ObMicroBlockCacheKey(TENANT_ID, MacroBlockId(0, 1, 0), idx + 1, BLOCK_SIZE);
+}
+
+void TestMicroBlockFlashCache::fill_block(const int64_t idx, char *buf)
+{
+  MEMSET(buf, 'a' + idx % 26, BLOCK_SIZE);
+  MEMCPY(buf, &idx, sizeof(idx));
+}
+
+bool TestMicroBlockFlashCache::check_block(const int64_t idx, const ObMicroBlockData &block_data)
+{
+  bool equal = block_data.get_buf_size() == BLOCK_SIZE
+      && ObMicroBlockData::DATA_BLOCK == block_data.type_
+      && 0 == MEMCMP(block_data.get_buf(), &idx, sizeof(idx));
+  for (int64_t i = sizeof(idx); equal && i < BLOCK_SIZE; ++i) {
+    equal = block_data.get_buf()[i] == 'a' + idx % 26;
+  }
+  return equal;
+}
+
+void TestMicroBlockFlashCache::demote(const int64_t idx)
+{
+  fill_block(idx, block_buf_);
+  ObMicroBlockCacheKey key = get_key(idx);
+  ObMicroBlockCacheValue value(block_buf_, BLOCK_SIZE);
+  const int64_t demote_cnt = flash_cache_.demote_cnt_;
+  flash_cache_.on_wash(key, value);
+  if (demote_cnt == flash_cache_.demote_cnt_) {
+    ASSERT_GE(flash_cache_.active_->sealed_pos_, 0);
+    ASSERT_EQ(OB_SUCCESS, flash_cache_.flush_segment(*flash_cache_.switch_segment()));
+    flash_cache_.on_wash(key, value);
+    ASSERT_EQ(demote_cnt + 1, flash_cache_.demote_cnt_);
+  }
+}
+
+TEST_F(TestMicroBlockFlashCache, test_segment_wraparound)
+{
+  const ObMicroBlockCacheValue *value = nullptr;
+  ObKVCacheHandle handle;
+  // blocks not flushed yet are not visible
+  demote(0);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, flash_cache_.get(get_key(0), block_cache_, value, handle));
+
+  // fill the ring twice
+  int64_t block_cnt = 0;
+  while (flash_cache_.active_->seq_ < 2 * SEGMENT_CNT) {
+    demote(block_cnt++);
+  }
+  const int64_t flushed_seq = flash_cache_.flushing_seq_;
+  ASSERT_EQ(2 * SEGMENT_CNT - 1, flushed_seq);
+  ASSERT_EQ(0, flash_cache_.segments_[0].ref_cnt_);
+  ASSERT_EQ(0, flash_cache_.segments_[1].ref_cnt_);
+  ASSERT_TRUE(flash_cache_.is_overwritten(flushed_seq - SEGMENT_CNT));
+  ASSERT_FALSE(flash_cache_.is_overwritten(flushed_seq - SEGMENT_CNT + 1));
+
+  int64_t hit_cnt = 0;
+  for (int64_t idx = 0; idx < block_cnt; ++idx) {
+    ObFlashCacheLocation location;
+    const ObMicroBlockCacheKey key = get_key(idx);
+    const int ret = flash_cache_.index_.get_refactored(key, location);
+    if (OB_HASH_NOT_EXIST == ret) {
+      // recycled with its slot, or still in the active segment
+      ASSERT_EQ(OB_ENTRY_NOT_EXIST, flash_cache_.get(key, block_cache_, value, handle));
+    } else {
+      ASSERT_EQ(OB_SUCCESS, ret);
+      ASSERT_GT(location.seq_, flushed_seq - SEGMENT_CNT);
+      ASSERT_EQ(OB_SUCCESS, flash_cache_.get(key, block_cache_, value, handle));
+      ASSERT_TRUE(check_block(idx, value->get_block_data())) << "idx: " << idx;
+      handle.reset();
+      ++hit_cnt;
+    }
+  }
+  // the ring keeps segment_cnt - 1 flushed segments besides the one being overwritten
+  ASSERT_GT(hit_cnt, (SEGMENT_CNT - 1) * (ObMicroBlockFlashCache::SEGMENT_SIZE / BLOCK_SIZE - 1));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, flash_cache_.get(get_key(0), block_cache_, value, handle));
+  for (int64_t i = 0; i < SEGMENT_CNT; ++i) {
+    ASSERT_GT(flash_cache_.slot_keys_[i].count(), 0);
+  }
+
+  // recycled blocks can be demoted again
+  demote(0);
+  while (flash_cache_.active_->seq_ < 2 * SEGMENT_CNT + 1) {
+    demote(block_cnt++);
+  }
+  ASSERT_EQ(OB_SUCCESS, flash_cache_.get(get_key(0), block_cache_, value, handle));
+  ASSERT_TRUE(check_block(0, value->get_block_data()));
+  handle.reset();
+}
+
+TEST_F(TestMicroBlockFlashCache, test_get_race_with_recycle)
+{
+  const int64_t reader_cnt = 4;
+  const int64_t block_cnt = 8 * SEGMENT_CNT * (ObMicroBlockFlashCache::SEGMENT_SIZE / BLOCK_SIZE);
+  int64_t demoted_idx = -1;
+  int64_t hit_cnt = 0;
+  int64_t miss_cnt = 0;
+  int64_t error_cnt = 0;
+  bool stop = false;
+  ASSERT_EQ(OB_SUCCESS, flash_cache_.start());
+
+  std::vector<std::thread> readers;
+  for (int64_t i = 0; i < reader_cnt; ++i) {
+    readers.push_back(std::thread([&, i]() {
+      const ObMicroBlockCacheValue *value = nullptr;
+      ObKVCacheHandle handle;
+      int64_t seed = i;
+      while (!ATOMIC_LOAD(&stop)) {
+        const int64_t max_idx = ATOMIC_LOAD(&demoted_idx);
+        if (max_idx < 0) {
+          continue;
+        }
+        // bias reads to the oldest blocks which are being recycled
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        const int64_t idx = seed % (max_idx + 1);
+        const int ret = flash_cache_.get(get_key(idx), block_cache_, value, handle);
+        if (OB_SUCCESS == ret) {
+          if (!check_block(idx, value->get_block_data())) {
+            ATOMIC_INC(&error_cnt);
+          }
+          ATOMIC_INC(&hit_cnt);
+          handle.reset();
+        } else if (OB_ENTRY_NOT_EXIST == ret) {
+          ATOMIC_INC(&miss_cnt);
+        } else {
+          ATOMIC_INC(&error_cnt);
+        }
+      }
+    }));
+  }
+
+  ObMicroBlockCacheValue value(block_buf_, BLOCK_SIZE);
+  for (int64_t idx = 0; idx < block_cnt; ++idx) {
+    fill_block(idx, block_buf_);
+    const ObMicroBlockCacheKey key = get_key(idx);
+    int64_t demote_cnt = flash_cache_.demote_cnt_;
+    flash_cache_.on_wash(key, value);
+    while (demote_cnt == ATOMIC_LOAD(&flash_cache_.demote_cnt_)) {
+      // writer thread falls behind
+      ob_usleep(1000);
+      flash_cache_.on_wash(key, value);
+    }
+    ATOMIC_STORE(&demoted_idx, idx);
+  }
+  ATOMIC_STORE(&stop, true);
+  for (int64_t i = 0; i < reader_cnt; ++i) {
+    readers[i].join();
+  }
+  flash_cache_.stop();
+  flash_cache_.wait();
+
+  ASSERT_EQ(0, error_cnt);
+  ASSERT_GT(hit_cnt, 0);
+  ASSERT_GT(miss_cnt, 0);
+  ASSERT_GE(flash_cache_.flushing_seq_, 7 * SEGMENT_CNT);
+}
+
+TEST_F(TestMicroBlockFlashCache, test_promote_index_block)
+{
+  // index block has rowkey with multi version columns and an index info column
+  const int64_t rowkey_cnt = 3;
+  const int64_t column_cnt = rowkey_cnt + 1;
+  const int64_t row_cnt = 100;
+  ObMicroBlockWriter writer;
+  ObDatumRow row;
+  char index_info[16];
+  ASSERT_EQ(OB_SUCCESS, writer.init(ObMicroBlockFlashCache::MAX_RECORD_SIZE, rowkey_cnt, column_cnt));
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, column_cnt));
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    row.storage_datums_[0].set_int(i * 2);
+    row.storage_datums_[1].set_int(-1);
+    row.storage_datums_[2].set_int(0);
+    snprintf(index_info, sizeof(index_info), "info%ld", i);
+    row.storage_datums_[3].set_string(index_info, static_cast<int32_t>(strlen(index_info)));
+    ASSERT_EQ(OB_SUCCESS, writer.append_row(row));
+  }
+  char *block_buf = nullptr;
+  int64_t block_size = 0;
+  ASSERT_EQ(OB_SUCCESS, writer.build_block(block_buf, block_size));
+
+  // cached index block is transformed into extra buf
+  ObObjMeta col_metas[column_cnt];
+  for (int64_t i = 0; i < rowkey_cnt; ++i) {
+    col_metas[i].set_int();
+  }
+  col_metas[rowkey_cnt].set_varchar();
+  col_metas[rowkey_cnt].set_collation_type(CS_TYPE_BINARY);
+  ObMicroBlockData block_data(block_buf, block_size);
+  const int64_t extra_size = ObIndexBlockDataTransformer::get_transformed_block_mem_size(block_data);
+  char *extra_buf = static_cast<char *>(allocator_.alloc(extra_size));
+  ASSERT_NE(nullptr, extra_buf);
+  ObIndexBlockDataTransformer transformer;
+  ASSERT_EQ(OB_SUCCESS, transformer.transform(col_metas, block_data, extra_buf, extra_size));
+  ObMicroBlockCacheValue value(
+      block_buf, block_size, extra_buf, extra_size, ObMicroBlockData::INDEX_BLOCK);
+  ObMicroBlockCacheKey key = get_key(0);
+  flash_cache_.on_wash(key, value);
+  ASSERT_EQ(1, flash_cache_.demote_cnt_);
+  ASSERT_EQ(OB_SUCCESS, flash_cache_.flush_segment(*flash_cache_.switch_segment()));
+
+  // promoted index block is transformed again
+  const ObMicroBlockCacheValue *promoted = nullptr;
+  ObKVCacheHandle handle;
+  ASSERT_EQ(OB_SUCCESS, flash_cache_.get(key, block_cache_, promoted, handle));
+  const ObMicroBlockData &promoted_data = promoted->get_block_data();
+  ASSERT_EQ(ObMicroBlockData::INDEX_BLOCK, promoted_data.type_);
+  ASSERT_EQ(block_size, promoted_data.get_buf_size());
+  ASSERT_EQ(0, MEMCMP(block_buf, promoted_data.get_buf(), block_size));
+  ASSERT_NE(nullptr, promoted_data.get_extra_buf());
+  ASSERT_EQ(extra_size, promoted_data.get_extra_size());
+  const ObIndexBlockDataHeader *src_header = reinterpret_cast<const ObIndexBlockDataHeader *>(extra_buf);
+  const ObIndexBlockDataHeader *idx_header
+      = reinterpret_cast<const ObIndexBlockDataHeader *>(promoted_data.get_extra_buf());
+  ASSERT_TRUE(idx_header->is_valid());
+  ASSERT_EQ(row_cnt, idx_header->row_cnt_);
+  ASSERT_EQ(column_cnt, idx_header->col_cnt_);
+  // transformed block points into the promoted cache value
+  ASSERT_GE(reinterpret_cast<const char *>(idx_header->rowkey_array_), promoted_data.get_extra_buf());
+  ASSERT_LT(reinterpret_cast<const char *>(idx_header->rowkey_array_),
+      promoted_data.get_extra_buf() + extra_size);
+  for (int64_t i = 0; i < column_cnt; ++i) {
+    ASSERT_EQ(col_metas[i], idx_header->col_meta_array_[i]);
+  }
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_EQ(i * 2, idx_header->rowkey_array_[i].datums_[0].get_int());
+    ASSERT_TRUE(src_header->datum_array_[i * column_cnt + rowkey_cnt]
+        == idx_header->datum_array_[i * column_cnt + rowkey_cnt]);
+  }
+  handle.reset();
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_flash_cache.log*");
+  OB_LOGGER.set_file_name("test_micro_block_flash_cache.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,6 +18,7 @@
 #include "storage/memtable/ob_memtable.h"
 #include "storage/memtable/mvcc/ob_mvcc_trans_ctx.h"
 #include "storage/memtable/ob_memtable_context.h"
+#include "storage/tx/ob_trans_part_ctx.h"
 #include "lib/random/ob_random.h"
 
 namespace oceanbase
@@ -173,6 +174,40 @@ public:
     return seq_counter_;
   }
 
+  // make mgr_ run in parallel mode with the slave lists of writers
+  void create_slave_lists()
+  {
+    const int64_t list_cnt = ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT;
+    ObTxCallbackList *lists = (ObTxCallbackList *)ob_malloc(sizeof(ObTxCallbackList) * list_cnt,
+                                                            ObNewModIds::TEST);
+    ASSERT_NE(nullptr, lists);
+    for (int64_t i = 0; i < list_cnt; ++i) {
+      new (lists + i) ObTxCallbackList(mgr_);
+    }
+    mgr_.callback_lists_ = lists;
+    mgr_.parallel_stat_ = ObTransCallbackMgr::PARALLEL_STMT;
+    // the merge logs the tx id of the trans ctx
+    mt_ctx_.ctx_ = &trans_ctx_;
+  }
+
+  void append_to_slave_list(const int64_t slot, ObITransCallback *cb)
+  {
+    EXPECT_EQ(OB_SUCCESS, mgr_.callback_lists_[slot].append_callback(cb));
+    mgr_.add_slave_list_append_cnt();
+  }
+
+  void destroy_slave_lists()
+  {
+    for (int64_t i = 0; i < ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT; ++i) {
+      EXPECT_TRUE(mgr_.callback_lists_[i].empty());
+      mgr_.callback_lists_[i].~ObTxCallbackList();
+    }
+    ob_free(mgr_.callback_lists_);
+    mgr_.callback_lists_ = NULL;
+    mgr_.parallel_stat_ = 0;
+    mt_ctx_.ctx_ = NULL;
+  }
+
   bool is_checksum_equal(int64_t no, ObMockBitSet &res)
   {
     ObMockBitSet other;
@@ -192,6 +227,7 @@ public:
 
   int64_t seq_counter_;
   int64_t mt_counter_;
+  transaction::ObPartTransCtx trans_ctx_;
   ObMemtableCtx mt_ctx_;
   ObMemtableCtxCbAllocator cb_allocator_;
   ObTransCallbackMgr mgr_;
@@ -495,6 +531,124 @@ TEST_F(TestTxCallbackList, remove_callback_by_rollback_to)
   EXPECT_EQ(9, rollback_cnt_);
 }
 
+TEST_F(TestTxCallbackList, merge_callbacks_by_seq_no)
+{
+  ObMemtable *memtable = create_memtable();
+  const int64_t list_cnt = 3;
+  ObTxCallbackList *lists = (ObTxCallbackList *)ob_malloc(sizeof(ObTxCallbackList) * list_cnt,
+                                                          ObNewModIds::TEST);
+  ASSERT_NE(nullptr, lists);
+  for (int64_t i = 0; i < list_cnt; ++i) {
+    new (lists + i) ObTxCallbackList(mgr_);
+  }
+
+  create_and_append_callback(memtable);
+  // seq_no interleaves between the writers
+  for (int64_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(OB_SUCCESS, lists[i % list_cnt].append_callback(create_callback(memtable)));
+  }
+  // the last list is empty
+  for (int64_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(OB_SUCCESS, lists[i % (list_cnt - 1)].append_callback(create_callback(memtable)));
+  }
+
+  EXPECT_EQ(15, callback_list_.merge_callbacks(lists, list_cnt));
+  EXPECT_EQ(16, callback_list_.get_length());
+  for (int64_t i = 0; i < list_cnt; ++i) {
+    EXPECT_TRUE(lists[i].empty());
+  }
+
+  int64_t seq_no = 0;
+  int64_t cnt = 0;
+  for (ObITransCallback *iter = callback_list_.get_guard()->get_next();
+       iter != callback_list_.get_guard();
+       iter = iter->get_next()) {
+    EXPECT_EQ(iter, iter->get_next()->get_prev());
+    EXPECT_LT(seq_no, iter->get_seq_no());
+    seq_no = iter->get_seq_no();
+    cnt++;
+  }
+  EXPECT_EQ(16, cnt);
+  EXPECT_EQ(get_seq_no(), seq_no);
+
+  for (int64_t i = 0; i < list_cnt; ++i) {
+    lists[i].~ObTxCallbackList();
+  }
+  ob_free(lists);
+}
+
+TEST_F(TestTxCallbackList, remove_callback_by_release_memtable_before_merge)
+{
+  TRANS_LOG(INFO, "CASE: remove_callback_by_release_memtable_before_merge");
+  ObMemtable memtable1;
+  ObMemtable memtable2;
+  share::SCN scn_1;
+  share::SCN scn_2;
+  share::SCN scn_3;
+  scn_1.convert_for_logservice(1);
+  scn_2.convert_for_logservice(2);
+  scn_3.convert_for_logservice(3);
+  memtable1.key_.scn_range_.end_scn_ = scn_3;
+  memtable2.key_.scn_range_.end_scn_ = scn_3;
+
+  create_slave_lists();
+  EXPECT_EQ(OB_SUCCESS, mgr_.callback_list_.append_callback(create_callback(&memtable1,
+      false, /*need_submit_log*/
+      false, /*need_fill_redo*/
+      scn_1/*scn*/)));
+  append_to_slave_list(0, create_callback(&memtable2, false, false, scn_1));
+  append_to_slave_list(1, create_callback(&memtable1, false, false, scn_2));
+  append_to_slave_list(0, create_callback(&memtable2, false, false, scn_2));
+  append_to_slave_list(1, create_callback(&memtable1, false, false, scn_3));
+  EXPECT_EQ(1, mgr_.get_main_list_length());
+
+  // callbacks of the released memtable in the slave lists are removed too
+  EXPECT_EQ(OB_SUCCESS, mgr_.remove_callback_for_uncommited_txn(&memtable2));
+  EXPECT_FALSE(mgr_.has_unmerged_callbacks_());
+  EXPECT_EQ(3, mgr_.get_main_list_length());
+  EXPECT_EQ(2, mgr_.get_callback_remove_for_remove_memtable_count());
+  EXPECT_EQ(2, checkpoint_cnt_);
+  EXPECT_EQ(true, is_checksum_equal(5, checksum_));
+
+  EXPECT_EQ(OB_SUCCESS, mgr_.remove_callback_for_uncommited_txn(&memtable1));
+  EXPECT_EQ(0, mgr_.get_main_list_length());
+  EXPECT_EQ(5, checkpoint_cnt_);
+
+  destroy_slave_lists();
+}
+
+TEST_F(TestTxCallbackList, checksum_before_scn_before_merge)
+{
+  TRANS_LOG(INFO, "CASE: checksum_before_scn_before_merge");
+  ObMemtable *memtable = create_memtable();
+  share::SCN scn_1;
+  share::SCN scn_2;
+  share::SCN scn_3;
+  scn_1.convert_for_logservice(1);
+  scn_2.convert_for_logservice(2);
+  scn_3.convert_for_logservice(3);
+
+  create_slave_lists();
+  EXPECT_EQ(OB_SUCCESS, mgr_.callback_list_.append_callback(create_callback(memtable,
+      false, /*need_submit_log*/
+      false, /*need_fill_redo*/
+      scn_1/*scn*/)));
+  append_to_slave_list(0, create_callback(memtable, false, false, scn_1));
+  append_to_slave_list(1, create_callback(memtable, false, false, scn_2));
+  append_to_slave_list(0, create_callback(memtable, false, false, scn_2));
+  append_to_slave_list(1, create_callback(memtable, false, false, scn_3));
+
+  // the callbacks of all writers before the scn are checksumed
+  uint64_t checksum = 0;
+  share::SCN checksum_scn;
+  EXPECT_EQ(OB_SUCCESS, mgr_.calc_checksum_before_scn(scn_2, checksum, checksum_scn));
+  EXPECT_FALSE(mgr_.has_unmerged_callbacks_());
+  EXPECT_EQ(5, mgr_.get_main_list_length());
+  EXPECT_EQ(true, is_checksum_equal(4, checksum_));
+
+  destroy_slave_lists();
+}
+
 TEST_F(TestTxCallbackList, remove_callback_by_clean_unlog_callbacks)
 {
   ObMemtable *memtable1 = create_memtable();
@@ -10,9 +10,11 @@
  * See the Mulan PubL v2 for more details.
  */
 
-#include "storage/memtable/mvcc/ob_mvcc_row.h"
-
 #include <gtest/gtest.h>
+#define private public
+#include "storage/memtable/mvcc/ob_mvcc_row.h"
+#include "storage/memtable/ob_row_compactor.h"
+#include "lib/allocator/page_arena.h"
 
 namespace oceanbase
 {
@@ -29,6 +31,129 @@ TEST(TestObMemtableValue, smoke_test)
   fprintf(stdout, "mr=[%s]\n", to_cstring(mr, true));
 }
 
+TEST(TestObMemtableValue, read_start_node)
+{
+  const int64_t node_cnt = 100;
+  ObMvccRow mr;
+  ObMvccTransNode nodes[node_cnt];
+  ObMvccRowVersionIndex version_index;
+
+  // nodes[i] is committed with version i + 1, nodes[node_cnt - 1] is the head
+  for (int64_t i = 0; i < node_cnt; ++i) {
+    nodes[i].trans_version_.convert_for_tx(i + 1);
+    nodes[i].prev_ = (0 == i) ? NULL : &nodes[i - 1];
+    nodes[i].next_ = (node_cnt - 1 == i) ? NULL : &nodes[i + 1];
+  }
+  mr.list_head_ = &nodes[node_cnt - 1];
+
+  share::SCN snapshot;
+  snapshot.convert_for_tx(10);
+  EXPECT_EQ(&nodes[node_cnt - 1], mr.get_read_start_node(snapshot));
+
+  // checkpoints at versions 80, 50 and 20
+  for (int64_t i = 0; i < 3; ++i) {
+    const int64_t idx = 79 - i * 30;
+    version_index.versions_[i] = nodes[idx].trans_version_;
+    version_index.nodes_[i] = &nodes[idx];
+  }
+  version_index.cnt_ = 3;
+  mr.version_index_ = &version_index;
+
+  snapshot.convert_for_tx(10);
+  EXPECT_EQ(&nodes[18], mr.get_read_start_node(snapshot));
+  snapshot.convert_for_tx(20);
+  EXPECT_EQ(&nodes[48], mr.get_read_start_node(snapshot));
+  snapshot.convert_for_tx(79);
+  EXPECT_EQ(&nodes[78], mr.get_read_start_node(snapshot));
+  snapshot.convert_for_tx(80);
+  EXPECT_EQ(&nodes[node_cnt - 1], mr.get_read_start_node(snapshot));
+}
+
+// nodes[i] is committed with version i + 1, the read of any snapshot must not
+// skip its visible node nodes[snapshot - 1]
+void check_version_index(const ObMvccRow &mr, ObMvccTransNode *nodes, const int64_t node_cnt)
+{
+  const ObMvccRowVersionIndex *index = mr.version_index_;
+  ASSERT_EQ(0, index->seq_ & 1);
+  ASSERT_GT(index->cnt_, 0);
+  ASSERT_LE(index->cnt_, static_cast<int64_t>(ObMvccRowVersionIndex::MAX_CHECKPOINT_CNT));
+  for (int64_t i = 0; i < index->cnt_; ++i) {
+    ASSERT_EQ(index->versions_[i], index->nodes_[i]->trans_version_);
+    if (i > 0) {
+      ASSERT_LT(index->versions_[i], index->versions_[i - 1]);
+    }
+  }
+  share::SCN snapshot;
+  for (int64_t v = 1; v <= node_cnt; ++v) {
+    snapshot.convert_for_tx(v);
+    const ObMvccTransNode *start = mr.get_read_start_node(snapshot);
+    ASSERT_NE(nullptr, start);
+    ASSERT_GE(start - nodes, v - 1) << "node_cnt=" << node_cnt << " snapshot=" << v;
+  }
+  // the oldest snapshot skips at least the nodes above the newest checkpoint
+  snapshot.convert_for_tx(1);
+  ASSERT_LT(mr.get_read_start_node(snapshot), index->nodes_[0]);
+}
+
+TEST(TestObMemtableValue, rebuild_version_index)
+{
+  const int64_t max_node_cnt = 400;
+  ObArenaAllocator allocator;
+  ObMvccRow mr;
+  ObMvccTransNode nodes[max_node_cnt];
+  ObMemtableRowCompactor compactor;
+  compactor.row_ = &mr;
+  compactor.node_alloc_ = &allocator;
+
+  ObMvccRowVersionIndex *first_index = NULL;
+  int64_t used = 0;
+  int64_t build_cnt = 0;
+  int64_t last_build_node_cnt = 0;
+  // link the nodes one by one and try to rebuild the index after each write
+  for (int64_t node_cnt = 1; node_cnt <= max_node_cnt; ++node_cnt) {
+    ObMvccTransNode &node = nodes[node_cnt - 1];
+    node.trans_version_.convert_for_tx(node_cnt);
+    node.set_committed();
+    node.prev_ = (1 == node_cnt) ? NULL : &nodes[node_cnt - 2];
+    if (node_cnt > 1) {
+      nodes[node_cnt - 2].next_ = &node;
+    }
+    mr.list_head_ = &node;
+    mr.total_trans_node_cnt_ = node_cnt;
+    compactor.build_version_index_();
+
+    if (node_cnt < ObMvccRowVersionIndex::MIN_INDEX_NODE_CNT) {
+      ASSERT_EQ(nullptr, mr.version_index_);
+    } else {
+      if (NULL == first_index) {
+        first_index = mr.version_index_;
+        ASSERT_NE(nullptr, first_index);
+        used = allocator.used();
+      }
+      // rebuilds reuse the index allocated by the first build
+      ASSERT_EQ(first_index, mr.version_index_);
+      ASSERT_EQ(used, allocator.used());
+      if (first_index->node_cnt_ != last_build_node_cnt) {
+        ASSERT_EQ(node_cnt, first_index->node_cnt_);
+        last_build_node_cnt = node_cnt;
+        ++build_cnt;
+      }
+      ASSERT_LT(node_cnt - first_index->node_cnt_, first_index->stride_);
+      check_version_index(mr, nodes, node_cnt);
+    }
+  }
+  ASSERT_GT(build_cnt, 10);
+  ASSERT_EQ(2 * (build_cnt - 1), first_index->seq_);
+
+  // readers fall back to the head of the chain during a rebuild
+  share::SCN snapshot;
+  snapshot.convert_for_tx(1);
+  first_index->begin_rebuild();
+  ASSERT_EQ(&nodes[max_node_cnt - 1], mr.get_read_start_node(snapshot));
+  first_index->end_rebuild();
+  ASSERT_NE(&nodes[max_node_cnt - 1], mr.get_read_start_node(snapshot));
+}
+
 }
 }
 
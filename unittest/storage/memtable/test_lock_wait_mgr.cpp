@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "storage/memtable/ob_lock_wait_mgr.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+
+class TestLockWaitMgr : public ::testing::Test
+{
+public:
+  typedef ObLockWaitMgr::Node Node;
+  static const int64_t MAX_NODE_CNT = 8;
+  TestLockWaitMgr() : mgr_(NULL), node_cnt_(0) {}
+  virtual void SetUp() override
+  {
+    mgr_ = new ObLockWaitMgr();
+    node_cnt_ = 0;
+  }
+  virtual void TearDown() override
+  {
+    delete mgr_;
+    mgr_ = NULL;
+  }
+  static uint64_t make_hash(const uint64_t key)
+  {
+    return (key << 33) | 1;
+  }
+  // add a request waiting on @hash, received at @recv_ts
+  Node *add_waiter(const uint64_t hash, const int64_t recv_ts)
+  {
+    Node *node = NULL;
+    EXPECT_LT(node_cnt_, static_cast<int64_t>(MAX_NODE_CNT));
+    if (node_cnt_ < MAX_NODE_CNT) {
+      node = &nodes_[node_cnt_++];
+      node->change_hash(hash, mgr_->get_seq(hash));
+      node->recv_ts_ = recv_ts;
+      node->abs_timeout_ = INT64_MAX;
+      int err = 0;
+      while (-EAGAIN == (err = mgr_->hash_.insert(node)))
+        ;
+      EXPECT_EQ(0, err);
+    }
+    return node;
+  }
+  void wakeup_row(const ObTabletID &tablet_id, const int64_t c1)
+  {
+    ObObj obj;
+    obj.set_int(c1);
+    ObStoreRowkey rowkey(&obj, 1);
+    ObMemtableKey key(&rowkey);
+    mgr_->wakeup(tablet_id, key);
+  }
+
+  ObLockWaitMgr *mgr_;
+  int64_t node_cnt_;
+  Node nodes_[MAX_NODE_CNT];
+};
+
+TEST_F(TestLockWaitMgr, wakeup_seq_of_colliding_keys)
+{
+  // both keys fall into the same slot of the first sequence array
+  const uint64_t hash1 = (1UL << 32) | 3;
+  const uint64_t hash2 = (2UL << 32) | 3;
+  ASSERT_EQ(ObLockWaitMgr::seq_pos_(hash1, 0), ObLockWaitMgr::seq_pos_(hash2, 0));
+  ASSERT_NE(ObLockWaitMgr::seq_pos_(hash1, 1), ObLockWaitMgr::seq_pos_(hash2, 1));
+
+  const int64_t lock_seq = mgr_->get_seq(hash1);
+  bool standalone_task = true;
+  ASSERT_TRUE(mgr_->check_wakeup_seq(hash1, lock_seq, standalone_task));
+  ASSERT_FALSE(standalone_task);
+  // the wakeup of the other key doesn't make the request standalone
+  mgr_->inc_seq_(hash2);
+  ASSERT_TRUE(mgr_->check_wakeup_seq(hash1, lock_seq, standalone_task));
+  ASSERT_FALSE(standalone_task);
+  // while the wakeup of its own key does
+  mgr_->inc_seq_(hash1);
+  ASSERT_TRUE(mgr_->check_wakeup_seq(hash1, lock_seq, standalone_task));
+  ASSERT_TRUE(standalone_task);
+}
+
+TEST_F(TestLockWaitMgr, fetch_waiter_in_fifo_order)
+{
+  const uint64_t hash = make_hash(1);
+  Node *node3 = add_waiter(hash, 300);
+  Node *node1 = add_waiter(hash, 100);
+  Node *node2 = add_waiter(hash, 200);
+  add_waiter(make_hash(2), 50);
+
+  // each wakeup hands the row to the earliest request only
+  ASSERT_EQ(node1, mgr_->fetch_waiter(hash));
+  ASSERT_EQ(node2, mgr_->fetch_waiter(hash));
+  ASSERT_EQ(node3, mgr_->fetch_waiter(hash));
+  ASSERT_EQ(nullptr, mgr_->fetch_waiter(hash));
+}
+
+TEST_F(TestLockWaitMgr, batch_wakeup)
+{
+  const uint64_t hash1 = make_hash(1);
+  const uint64_t hash2 = make_hash(2);
+  const uint64_t hash3 = make_hash(3);
+  add_waiter(hash1, 100);
+  Node *node12 = add_waiter(hash1, 200);
+  add_waiter(hash2, 100);
+
+  // the heads of all the rows are fetched in one pass, the rows without
+  // requests are skipped
+  const uint64_t hashes[] = { hash1, hash2, hash3 };
+  mgr_->batch_wakeup_(hashes, 3);
+  ASSERT_EQ(nullptr, mgr_->fetch_waiter(hash2));
+  ASSERT_EQ(node12, mgr_->fetch_waiter(hash1));
+  ASSERT_EQ(nullptr, mgr_->fetch_waiter(hash1));
+}
+
+TEST_F(TestLockWaitMgr, collect_row_wakeups)
+{
+  ObLockWaitMgr::WakeupBatch &batch = ObLockWaitMgr::get_thread_wakeup_batch();
+  batch.depth_ = 1;
+  batch.mgr_ = mgr_;
+  batch.cnt_ = 0;
+  const ObTabletID tablet_id(200001);
+
+  // duplicated wakeups of a row are collected once
+  for (int64_t i = 0; i < ObLockWaitMgr::BATCH_WAKEUP_SIZE - 1; ++i) {
+    wakeup_row(tablet_id, i);
+    wakeup_row(tablet_id, i);
+  }
+  ASSERT_EQ(ObLockWaitMgr::BATCH_WAKEUP_SIZE - 1, batch.cnt_);
+  // and they are flushed once the batch is full
+  const uint64_t first_hash = batch.hashes_[0];
+  add_waiter(first_hash, 100);
+  wakeup_row(tablet_id, ObLockWaitMgr::BATCH_WAKEUP_SIZE);
+  ASSERT_EQ(0, batch.cnt_);
+  ASSERT_EQ(nullptr, mgr_->fetch_waiter(first_hash));
+
+  batch.depth_ = 0;
+  batch.mgr_ = NULL;
+}
+
+TEST_F(TestLockWaitMgr, wait_queue_depth)
+{
+  add_waiter(make_hash(1), 100);
+  add_waiter(make_hash(1), 200);
+  add_waiter(make_hash(1), 300);
+  add_waiter(make_hash(2), 100);
+
+  Node *iter = NULL;
+  Node cur_node;
+  uint64_t queue_hash = 0;
+  int64_t queue_depth = 0;
+  int64_t cnt = 0;
+  while (NULL != mgr_->next(iter, &cur_node, queue_hash, queue_depth)) {
+    ASSERT_EQ(make_hash(1) == cur_node.hash() ? 3 : 1, queue_depth);
+    ++cnt;
+  }
+  ASSERT_EQ(4, cnt);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -rf test_lock_wait_mgr.log*");
+  OB_LOGGER.set_file_name("test_lock_wait_mgr.log");
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -668,6 +668,213 @@ TEST_F(TestIOStruct, IOManager)
   ASSERT_FALSE(io_mgr.is_inited_);
 }
 
+TEST_F(TestIOStruct, IOUring)
+{
+  ASSERT_EQ(ObIOChannelType::AIO, get_io_channel_type_enum("aio"));
+  ASSERT_EQ(ObIOChannelType::IO_URING_SQPOLL, get_io_channel_type_enum("IO_URING_SQPOLL"));
+  ASSERT_EQ(ObIOChannelType::MAX_TYPE, get_io_channel_type_enum("uring"));
+  ASSERT_EQ(0, strcmp("IO_URING", get_io_channel_type_name(ObIOChannelType::IO_URING)));
+
+  ObIOUring ring;
+  ASSERT_FALSE(ring.is_inited());
+  int ret = ring.init(64, false/*use_sq_poll*/, 0);
+  if (OB_NOT_SUPPORTED == ret) {
+    LOG_INFO("io_uring not supported by kernel, skip");
+  } else {
+    ASSERT_SUCC(ret);
+    ASSERT_TRUE(ring.is_inited());
+    ASSERT_FAIL(ring.init(64, false, 0));
+    // submit nops and reap them
+    const int64_t nop_cnt = 8;
+    for (int64_t i = 0; i < nop_cnt; ++i) {
+      ObIOUringSqe *sqe = ring.get_sqe();
+      ASSERT_NE(nullptr, sqe);
+      sqe->opcode_ = IO_URING_OP_NOP;
+      sqe->user_data_ = i + 1;
+    }
+    int64_t submitted_cnt = 0;
+    ASSERT_SUCC(ring.submit(submitted_cnt));
+    ASSERT_EQ(nop_cnt, submitted_cnt);
+    int64_t reaped_cnt = 0;
+    ObIOUringCqe *cqes[nop_cnt] = { nullptr };
+    while (reaped_cnt < nop_cnt) {
+      ASSERT_SUCC(ring.wait_cqe());
+      const int64_t cnt = ring.peek_cqes(cqes, nop_cnt);
+      for (int64_t i = 0; i < cnt; ++i) {
+        ASSERT_EQ(0, cqes[i]->res_);
+      }
+      ring.advance_cq(cnt);
+      reaped_cnt += cnt;
+    }
+    ASSERT_EQ(nop_cnt, reaped_cnt);
+    ring.destroy();
+    ASSERT_FALSE(ring.is_inited());
+  }
+}
+
+
+TEST_F(TestIOStruct, IOUringReadWrite)
+{
+  ObIOUring ring;
+  int ret = ring.init(64, false/*use_sq_poll*/, 0);
+  if (OB_NOT_SUPPORTED == ret) {
+    LOG_INFO("io_uring not supported by kernel, skip");
+  } else {
+    ASSERT_SUCC(ret);
+    const int fd = ::open(TEST_ROOT_DIR "/test_io_uring_file", O_CREAT | O_TRUNC | O_RDWR, 0644);
+    ASSERT_LE(0, fd);
+    const int64_t io_size = 4096;
+    char write_buf[io_size];
+    char read_buf[io_size];
+    memset(write_buf, 'x', io_size);
+    memset(read_buf, 0, io_size);
+    ObIOUringCqe *cqes[1] = { nullptr };
+    int64_t submitted_cnt = 0;
+
+    // write and read back
+    ObIOUringSqe *sqe = ring.get_sqe();
+    ASSERT_NE(nullptr, sqe);
+    sqe->opcode_ = IO_URING_OP_WRITE;
+    sqe->fd_ = fd;
+    sqe->addr_ = reinterpret_cast<uint64_t>(write_buf);
+    sqe->len_ = io_size;
+    sqe->off_ = 0;
+    sqe->user_data_ = 1;
+    ASSERT_SUCC(ring.submit(submitted_cnt));
+    ASSERT_SUCC(ring.wait_cqe());
+    ASSERT_EQ(1, ring.peek_cqes(cqes, 1));
+    ASSERT_EQ(1, cqes[0]->user_data_);
+    ASSERT_EQ(io_size, cqes[0]->res_);
+    ring.advance_cq(1);
+
+    sqe = ring.get_sqe();
+    ASSERT_NE(nullptr, sqe);
+    sqe->opcode_ = IO_URING_OP_READ;
+    sqe->fd_ = fd;
+    sqe->addr_ = reinterpret_cast<uint64_t>(read_buf);
+    sqe->len_ = io_size;
+    sqe->off_ = 0;
+    sqe->user_data_ = 2;
+    ASSERT_SUCC(ring.submit(submitted_cnt));
+    ASSERT_SUCC(ring.wait_cqe());
+    ASSERT_EQ(1, ring.peek_cqes(cqes, 1));
+    ASSERT_EQ(2, cqes[0]->user_data_);
+    ASSERT_EQ(io_size, cqes[0]->res_);
+    ring.advance_cq(1);
+    ASSERT_EQ(0, memcmp(write_buf, read_buf, io_size));
+
+    // error is returned by cqe
+    sqe = ring.get_sqe();
+    ASSERT_NE(nullptr, sqe);
+    sqe->opcode_ = IO_URING_OP_READ;
+    sqe->fd_ = -1;
+    sqe->addr_ = reinterpret_cast<uint64_t>(read_buf);
+    sqe->len_ = io_size;
+    sqe->off_ = 0;
+    sqe->user_data_ = 3;
+    ASSERT_SUCC(ring.submit(submitted_cnt));
+    ASSERT_SUCC(ring.wait_cqe());
+    ASSERT_EQ(1, ring.peek_cqes(cqes, 1));
+    ASSERT_EQ(3, cqes[0]->user_data_);
+    ASSERT_EQ(-EBADF, cqes[0]->res_);
+    ring.advance_cq(1);
+
+    ::close(fd);
+    ring.destroy();
+  }
+}
+
+TEST_F(TestIOStruct, IOUringReclaim)
+{
+  ObIOUring ring;
+  int ret = ring.init(64, false/*use_sq_poll*/, 0);
+  if (OB_NOT_SUPPORTED == ret) {
+    LOG_INFO("io_uring not supported by kernel, skip");
+  } else {
+    ASSERT_SUCC(ret);
+    // prepared sqes not entered into kernel are taken back with their user data
+    const int64_t prepare_cnt = 4;
+    const uint32_t tail = ring.get_sqe_tail();
+    for (int64_t i = 0; i < prepare_cnt; ++i) {
+      ObIOUringSqe *sqe = ring.get_sqe();
+      ASSERT_NE(nullptr, sqe);
+      sqe->opcode_ = IO_URING_OP_NOP;
+      sqe->user_data_ = i + 100;
+    }
+    ASSERT_FALSE(ring.is_consumed(ring.get_sqe_tail()));
+    uint64_t user_datas[prepare_cnt * 2] = { 0 };
+    ASSERT_EQ(prepare_cnt, ring.reclaim_unsubmitted(user_datas, prepare_cnt * 2));
+    for (int64_t i = 0; i < prepare_cnt; ++i) {
+      ASSERT_EQ(i + 100, user_datas[i]);
+    }
+    ASSERT_EQ(tail, ring.get_sqe_tail());
+    ASSERT_TRUE(ring.is_consumed(tail));
+    ASSERT_EQ(0, ring.reclaim_unsubmitted(user_datas, prepare_cnt * 2));
+
+    // the ring still works after reclaim
+    ObIOUringSqe *sqe = ring.get_sqe();
+    ASSERT_NE(nullptr, sqe);
+    sqe->opcode_ = IO_URING_OP_NOP;
+    sqe->user_data_ = 1;
+    int64_t submitted_cnt = 0;
+    ASSERT_SUCC(ring.submit(submitted_cnt));
+    ASSERT_EQ(1, submitted_cnt);
+    ASSERT_TRUE(ring.is_consumed(ring.get_sqe_tail()));
+    ASSERT_SUCC(ring.wait_cqe());
+    ObIOUringCqe *cqes[1] = { nullptr };
+    ASSERT_EQ(1, ring.peek_cqes(cqes, 1));
+    ASSERT_EQ(1, cqes[0]->user_data_);
+    ring.advance_cq(1);
+    ring.destroy();
+  }
+}
+
+
+TEST_F(TestIOStruct, IOUringUnsubmitted)
+{
+  ObIOUring ring;
+  int ret = ring.init(64, false/*use_sq_poll*/, 0);
+  if (OB_NOT_SUPPORTED == ret) {
+    LOG_INFO("io_uring not supported by kernel, skip");
+  } else {
+    ASSERT_SUCC(ret);
+    const int64_t prepare_cnt = 4;
+    for (int64_t i = 0; i < prepare_cnt; ++i) {
+      ObIOUringSqe *sqe = ring.get_sqe();
+      ASSERT_NE(nullptr, sqe);
+      sqe->opcode_ = IO_URING_OP_NOP;
+      sqe->user_data_ = i + 100;
+    }
+    ASSERT_FALSE(ring.has_unsubmitted());
+    // published without entering kernel, like an enter failed with -EAGAIN
+    uint32_t to_submit = 0;
+    ASSERT_SUCC(ring.flush_sq(to_submit));
+    ASSERT_EQ(prepare_cnt, to_submit);
+    ASSERT_TRUE(ring.has_unsubmitted());
+    ASSERT_FALSE(ring.has_cqe());
+
+    // the next enter takes the left sqes even without new ones
+    int64_t submitted_cnt = 0;
+    ASSERT_SUCC(ring.submit(submitted_cnt));
+    ASSERT_EQ(prepare_cnt, submitted_cnt);
+    ASSERT_FALSE(ring.has_unsubmitted());
+    int64_t reaped_cnt = 0;
+    ObIOUringCqe *cqes[prepare_cnt] = { nullptr };
+    while (reaped_cnt < prepare_cnt) {
+      ASSERT_SUCC(ring.wait_cqe());
+      ASSERT_TRUE(ring.has_cqe());
+      const int64_t cnt = ring.peek_cqes(cqes, prepare_cnt);
+      for (int64_t i = 0; i < cnt; ++i) {
+        ASSERT_EQ(reaped_cnt + i + 100, cqes[i]->user_data_);
+      }
+      ring.advance_cq(cnt);
+      reaped_cnt += cnt;
+    }
+    ASSERT_FALSE(ring.has_cqe());
+    ring.destroy();
+  }
+}
+
 
 class TestIOManager : public TestIOStruct
 {
@@ -796,6 +1003,64 @@ TEST_F(TestIOManager, simple)
 }
 
 
+TEST_F(TestIOManager, io_uring)
+{
+  ObIOManager &io_mgr = ObIOManager::get_instance();
+  ASSERT_SUCC(io_mgr.remove_device_channel(THE_IO_DEVICE));
+  ASSERT_SUCC(io_mgr.add_device_channel(THE_IO_DEVICE, 2, 2, 1024, ObIOChannelType::IO_URING));
+  ObDeviceChannel *device_channel = nullptr;
+  ASSERT_SUCC(io_mgr.get_device_channel(THE_IO_DEVICE, device_channel));
+  if (ObIOChannelType::IO_URING != device_channel->get_channel_type()) {
+    LOG_INFO("io_uring not supported by kernel, skip");
+  } else {
+    ObIOFd fd;
+    ASSERT_SUCC(THE_IO_DEVICE->open(TEST_ROOT_DIR "/test_io_uring_file", O_CREAT | O_DIRECT | O_TRUNC | O_RDWR, 0644, fd));
+    const int64_t FILE_SIZE = 1024 * 1024;
+    ASSERT_SUCC(THE_IO_DEVICE->fallocate(fd, 0, 0, FILE_SIZE));
+
+    // registering the same buffer twice does not change the set, unknown buffer is ignored
+    const int64_t fixed_buf_size = DIO_READ_ALIGN_SIZE * 4;
+    char *fixed_buf = static_cast<char *>(ob_malloc_align(DIO_READ_ALIGN_SIZE, fixed_buf_size, "IOUringTest"));
+    ASSERT_NE(nullptr, fixed_buf);
+    ASSERT_SUCC(device_channel->register_fixed_buffer(fixed_buf, fixed_buf_size));
+    ASSERT_SUCC(device_channel->register_fixed_buffer(fixed_buf, fixed_buf_size));
+    ASSERT_SUCC(device_channel->unregister_fixed_buffer(fixed_buf + DIO_READ_ALIGN_SIZE));
+
+    // write and read back through the channel
+    const int64_t io_timeout_ms = 1000L * 5L;
+    const int64_t io_size = DIO_READ_ALIGN_SIZE * 2;
+    memset(fixed_buf, 'u', io_size);
+    ObIOInfo io_info;
+    io_info.tenant_id_ = OB_SERVER_TENANT_ID;
+    io_info.fd_ = fd;
+    io_info.flag_.set_write();
+    io_info.flag_.set_category(ObIOCategory::USER_IO);
+    io_info.flag_.set_wait_event(100);
+    io_info.offset_ = 0;
+    io_info.size_ = io_size;
+    io_info.buf_ = fixed_buf;
+    ASSERT_SUCC(io_mgr.write(io_info, io_timeout_ms));
+    io_info.flag_.set_read();
+    ObIOHandle io_handle;
+    ASSERT_SUCC(io_mgr.read(io_info, io_handle, io_timeout_ms));
+    ASSERT_EQ(io_size, io_handle.get_data_size());
+    ASSERT_EQ(0, memcmp(fixed_buf, io_handle.get_buffer(), io_size));
+
+    // failed io is completed with error rather than hanging until timeout
+    io_handle.reset();
+    io_info.offset_ = FILE_SIZE;
+    io_info.size_ = DIO_READ_ALIGN_SIZE;
+    const int64_t begin_ts = ObTimeUtility::current_time();
+    ASSERT_NE(OB_SUCCESS, io_mgr.read(io_info, io_handle, io_timeout_ms));
+    ASSERT_LT(ObTimeUtility::current_time() - begin_ts, io_timeout_ms * 1000L);
+
+    ASSERT_SUCC(device_channel->unregister_fixed_buffer(fixed_buf));
+    ob_free_align(fixed_buf);
+    ASSERT_SUCC(THE_IO_DEVICE->close(fd));
+  }
+}
+
+
 struct IOPerfDevice
 {
   IOPerfDevice() : device_id_(0), media_id_(0), async_channel_count_(0), sync_channel_count_(0), max_io_depth_(0),
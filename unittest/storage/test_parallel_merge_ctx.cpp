@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define protected public
+#define private public
+#include "storage/compaction/ob_partition_parallel_merge_ctx.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+
+namespace unittest
+{
+
+class TestParallelMergeCtx : public ::testing::Test
+{
+public:
+  static const int64_t TABLET_SIZE = 128L * 1024L * 1024L;
+  TestParallelMergeCtx() {}
+  virtual ~TestParallelMergeCtx() {}
+};
+
+TEST_F(TestParallelMergeCtx, mini_merge_concurrent_cnt)
+{
+  const int64_t tablet_size = TABLET_SIZE;
+  const int64_t target_task_cnt = ObParallelMergeCtx::PARALLEL_MERGE_TARGET_TASK_CNT;
+  int64_t concurrent_cnt = 0;
+
+  // a memtable smaller than the tablet size is dumped serially
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::get_mini_merge_concurrent_cnt(
+      tablet_size, tablet_size / 2, tablet_size, 8, concurrent_cnt));
+  ASSERT_EQ(1, concurrent_cnt);
+
+  // wide rows, the btree estimation only covers a tablet while the memtable occupies four
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::get_mini_merge_concurrent_cnt(
+      tablet_size, tablet_size, 4 * tablet_size, 8, concurrent_cnt));
+  ASSERT_EQ(4, concurrent_cnt);
+  // and the estimation is used when it is the larger one
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::get_mini_merge_concurrent_cnt(
+      tablet_size, 3 * tablet_size + 1, tablet_size, 8, concurrent_cnt));
+  ASSERT_EQ(4, concurrent_cnt);
+
+  // the task count is capped by the compaction threads, but never below the target task count
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::get_mini_merge_concurrent_cnt(
+      tablet_size, 0, 100 * tablet_size, 8, concurrent_cnt));
+  ASSERT_EQ(target_task_cnt, concurrent_cnt);
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::get_mini_merge_concurrent_cnt(
+      tablet_size, 0, 100 * tablet_size, target_task_cnt + 10, concurrent_cnt));
+  ASSERT_EQ(target_task_cnt + 10, concurrent_cnt);
+
+  // tablets without a tablet size are not split
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::get_mini_merge_concurrent_cnt(
+      0, tablet_size, 100 * tablet_size, 8, concurrent_cnt));
+  ASSERT_EQ(1, concurrent_cnt);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ObParallelMergeCtx::get_mini_merge_concurrent_cnt(
+      tablet_size, -1, tablet_size, 8, concurrent_cnt));
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_parallel_merge_ctx.log*");
+  OB_LOGGER.set_file_name("test_parallel_merge_ctx.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define private public
+#include "storage/tx/ob_ts_mgr.h"
+#include "storage/tx/ob_gts_source.h"
+#include "storage/tx/ob_gts_task_queue.h"
+#undef private
+#include <gtest/gtest.h>
+#include "share/ob_errno.h"
+#include "share/rc/ob_tenant_base.h"
+#include "lib/oblog/ob_log.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace transaction;
+namespace unittest
+{
+
+// a committer waiting for gts to reach @ts
+class MockGtsTask : public ObTsCbTask
+{
+public:
+  explicit MockGtsTask(const int64_t ts) : ts_(ts), callback_cnt_(0), done_(false) {}
+  virtual ~MockGtsTask() {}
+  virtual int gts_callback_interrupted(const int errcode) override
+  {
+    UNUSED(errcode);
+    done_ = true;
+    return OB_SUCCESS;
+  }
+  virtual int get_gts_callback(const MonotonicTs srr, const SCN &gts, const MonotonicTs receive_gts_ts) override
+  {
+    UNUSED(receive_gts_ts);
+    return gts_elapse_callback(srr, gts);
+  }
+  virtual int gts_elapse_callback(const MonotonicTs srr, const SCN &gts) override
+  {
+    int ret = OB_SUCCESS;
+    UNUSED(srr);
+    ++callback_cnt_;
+    if (static_cast<int64_t>(gts.get_val_for_gts()) < ts_) {
+      ret = OB_EAGAIN;
+    } else {
+      done_ = true;
+    }
+    return ret;
+  }
+  virtual MonotonicTs get_stc() const override { return MonotonicTs(1); }
+  virtual uint64_t hash() const override { return static_cast<uint64_t>(ts_); }
+  // the same tenant as the running one, no tenant switch is needed in the callback
+  virtual uint64_t get_tenant_id() const override { return MTL_ID(); }
+public:
+  int64_t ts_;
+  int64_t callback_cnt_;
+  bool done_;
+};
+
+class TestObGtsTaskQueue : public ::testing::Test
+{
+public :
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+};
+
+TEST_F(TestObGtsTaskQueue, callback_every_queued_task)
+{
+  ObGTSTaskQueue queue;
+  ASSERT_EQ(OB_SUCCESS, queue.init(WAIT_GTS_ELAPSING));
+  MockGtsTask task1(100);
+  MockGtsTask task2(300);
+  MockGtsTask task3(200);
+  ASSERT_EQ(OB_SUCCESS, queue.push(&task1));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&task2));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&task3));
+
+  // the task which is not satisfied doesn't hold back the tasks behind it
+  ASSERT_EQ(OB_SUCCESS, queue.foreach_task(MonotonicTs(10), 200, MonotonicTs(10)));
+  ASSERT_TRUE(task1.done_);
+  ASSERT_FALSE(task2.done_);
+  ASSERT_TRUE(task3.done_);
+  ASSERT_EQ(1, queue.get_task_count());
+  // and it is visited only once per response
+  ASSERT_EQ(1, task2.callback_cnt_);
+
+  ASSERT_EQ(OB_SUCCESS, queue.foreach_task(MonotonicTs(20), 300, MonotonicTs(20)));
+  ASSERT_TRUE(task2.done_);
+  ASSERT_EQ(2, task2.callback_cnt_);
+  ASSERT_EQ(0, queue.get_task_count());
+  ASSERT_EQ(1, task1.callback_cnt_);
+  ASSERT_EQ(1, task3.callback_cnt_);
+}
+
+TEST_F(TestObGtsTaskQueue, share_gts_request_in_flight)
+{
+  ObGtsSource gts_source;
+  const MonotonicTs now = MonotonicTs::current_time();
+  // the response of the last request has arrived
+  bool update = false;
+  ASSERT_EQ(OB_SUCCESS, gts_source.gts_local_cache_.update_gts(now, 100, now, update));
+  ASSERT_EQ(OB_SUCCESS, gts_source.gts_local_cache_.update_latest_srr(now));
+  // a request is sent and not answered yet, waiters share it
+  ASSERT_EQ(OB_SUCCESS, gts_source.gts_local_cache_.update_latest_srr(MonotonicTs(now.mts_ + 1)));
+  ASSERT_EQ(OB_SUCCESS, gts_source.refresh_gts_for_waiters_());
+  ASSERT_EQ(OB_SUCCESS, gts_source.refresh_gts_for_waiters_());
+  ASSERT_EQ(2, gts_source.gts_statistics_.batched_gts_query_cnt_);
+  // the tick doesn't query gts for the tenant before the source is ready
+  ASSERT_EQ(OB_NOT_INIT, gts_source.refresh_gts_for_waiters());
+  ASSERT_EQ(2, gts_source.gts_statistics_.batched_gts_query_cnt_);
+}
+
+}//end of unittest
+}//end of oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_gts_task_queue.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}
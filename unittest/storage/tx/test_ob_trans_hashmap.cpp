@@ -86,6 +86,21 @@ public:
 
 typedef ObTransHashMap<ObTransID, ObTransTestValue, ObTransTestValueAlloc, common::SpinRWLock> TestHashMap;
 
+typedef ObTransHashMap<ObTransID, ObTransTestValue, ObTransTestValueAlloc, common::SpinRWLock, 1 << 12> ResizableHashMap;
+
+class CountFunctor
+{
+public:
+  CountFunctor() : cnt_(0) {}
+  bool operator() (ObTransTestValue *val)
+  {
+    UNUSED(val);
+    ++cnt_;
+    return true;
+  }
+  int64_t cnt_;
+};
+
 class ForeachFunctor
 {
 public:  
@@ -209,6 +224,51 @@ TEST_F(TestObTrans, hashmap_init_invalid)
   EXPECT_EQ(0, map.count());
 }
 
+TEST_F(TestObTrans, hashmap_resize)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+
+  ResizableHashMap map;
+  EXPECT_EQ(OB_SUCCESS, map.init(lib::ObMemAttr(OB_SERVER_TENANT_ID, "TestObTrans")));
+  const int64_t min_buckets_cnt = map.get_active_buckets_cnt();
+  const int64_t value_cnt = 4 * min_buckets_cnt;
+  EXPECT_LT(min_buckets_cnt, ResizableHashMap::get_buckets_cnt());
+
+  // 1 buckets are split while inserting
+  for (int64_t i = 1; i <= value_cnt; ++i) {
+    ObTransTestValue *val = NULL;
+    EXPECT_EQ(OB_SUCCESS, map.alloc_value(val));
+    EXPECT_EQ(OB_SUCCESS, val->init(ObTransID(i)));
+    EXPECT_EQ(OB_SUCCESS, map.insert(ObTransID(i), val));
+  }
+  EXPECT_EQ(value_cnt, map.count());
+  EXPECT_LT(min_buckets_cnt, map.get_active_buckets_cnt());
+  EXPECT_GE(ResizableHashMap::get_buckets_cnt(), map.get_active_buckets_cnt());
+
+  // 2 every value is found in its new bucket and visited once
+  for (int64_t i = 1; i <= value_cnt; ++i) {
+    ObTransTestValue *val = NULL;
+    EXPECT_EQ(OB_SUCCESS, map.get(ObTransID(i), val));
+    EXPECT_EQ(ObTransID(i), val->get_trans_id());
+    map.revert(val);
+  }
+  CountFunctor count_fn;
+  EXPECT_EQ(OB_SUCCESS, map.for_each(count_fn));
+  EXPECT_EQ(value_cnt, count_fn.cnt_);
+
+  // 3 buckets are merged back while deleting
+  for (int64_t i = 1; i <= value_cnt; ++i) {
+    ObTransTestValue *val = NULL;
+    EXPECT_EQ(OB_SUCCESS, map.get(ObTransID(i), val));
+    EXPECT_EQ(OB_SUCCESS, map.del(ObTransID(i), val));
+    map.revert(val);
+  }
+  EXPECT_EQ(0, map.count());
+  EXPECT_EQ(min_buckets_cnt, map.get_active_buckets_cnt());
+  ObTransTestValue *val = NULL;
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, map.get(ObTransID(1), val));
+}
+
 }//end of unittest
 }//end of oceanbase
 
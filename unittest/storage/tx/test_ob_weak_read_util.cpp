@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "storage/tx/wrs/ob_weak_read_util.h"
+#include "share/scn.h"
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace transaction;
+namespace unittest
+{
+
+class TestObWeakReadUtil : public ::testing::Test
+{
+public :
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+};
+
+TEST_F(TestObWeakReadUtil, check_weak_read_version_staleness)
+{
+  const int64_t now = 1000L * 1000L * 1000L;
+  const int64_t max_staleness = 100L * 1000L;
+  SCN version;
+
+  version.convert_from_ts(now - max_staleness);
+  EXPECT_EQ(OB_SUCCESS, ObWeakReadUtil::check_weak_read_version_staleness(version, max_staleness, now));
+  version.convert_from_ts(now);
+  EXPECT_EQ(OB_SUCCESS, ObWeakReadUtil::check_weak_read_version_staleness(version, max_staleness, now));
+  // the replicas are too stale, the statement is retried rather than waiting here
+  version.convert_from_ts(now - max_staleness - 1);
+  EXPECT_EQ(OB_REPLICA_NOT_READABLE,
+            ObWeakReadUtil::check_weak_read_version_staleness(version, max_staleness, now));
+
+  // no replica has a readable version
+  EXPECT_EQ(OB_REPLICA_NOT_READABLE,
+            ObWeakReadUtil::check_weak_read_version_staleness(SCN::min_scn(), max_staleness, now));
+  EXPECT_EQ(OB_REPLICA_NOT_READABLE,
+            ObWeakReadUtil::check_weak_read_version_staleness(SCN::max_scn(), max_staleness, now));
+  version.reset();
+  EXPECT_EQ(OB_REPLICA_NOT_READABLE,
+            ObWeakReadUtil::check_weak_read_version_staleness(version, max_staleness, now));
+}
+
+TEST_F(TestObWeakReadUtil, monotonic_weak_read_by_default)
+{
+  // the log stream weak read version is not used without the tenant config, as
+  // weak read is monotonic by default
+  EXPECT_TRUE(ObWeakReadUtil::enable_monotonic_weak_read(1001));
+}
+
+}//end of unittest
+}//end of oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_weak_read_util.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}
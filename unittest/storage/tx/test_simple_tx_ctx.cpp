@@ -190,6 +190,66 @@ TEST_F(TestMockObTxCtx, test_simple_tx_ctx1)
   // EXPECT_EQ(true, ctx2.check_status_valid(true/*should commit*/));
 }
 
+TEST_F(TestMockObTxCtx, test_extra_log_cbs)
+{
+  int64_t ls_id_gen = ObLSID::MIN_USER_LS_ID;
+  MockObTxCtx ctx;
+  ObTransID trans_id(1);
+  ObLSID ls_id(++ls_id_gen);
+  ObTxData data;
+  ctx.change_to_leader();
+  EXPECT_EQ(OB_SUCCESS, ctx.init(ls_id, trans_id, nullptr, &data, &mailbox_mgr_));
+  GCONF._private_buffer_size.set_value("2M");
+  const int64_t max_extra_cnt = MIN(OB_TX_MAX_EXTRA_LOG_CBS,
+                                    GCONF._tx_max_pending_redo_log_count - OB_TX_MAX_LOG_CBS);
+  const int64_t max_busy_cnt = OB_TX_MAX_LOG_CBS - RESERVE_LOG_CALLBACK_COUNT_FOR_FREEZING
+                               + max_extra_cnt;
+  ObTxLogCb *log_cbs[OB_TX_MAX_LOG_CBS + OB_TX_MAX_EXTRA_LOG_CBS];
+  ObTxLogCb *log_cb = NULL;
+
+  // small transactions only use the preallocated log cbs
+  for (int64_t i = 0; i < OB_TX_MAX_LOG_CBS - RESERVE_LOG_CALLBACK_COUNT_FOR_FREEZING; ++i) {
+    EXPECT_EQ(OB_SUCCESS, ctx.get_log_cb_(false, log_cbs[i]));
+  }
+  EXPECT_EQ(OB_TX_NOLOGCB, ctx.get_log_cb_(false, log_cb));
+  EXPECT_EQ(0, ctx.extra_log_cb_cnt_);
+  for (int64_t i = 0; i < OB_TX_MAX_LOG_CBS - RESERVE_LOG_CALLBACK_COUNT_FOR_FREEZING; ++i) {
+    EXPECT_EQ(OB_SUCCESS, ctx.return_log_cb_(log_cbs[i]));
+  }
+
+  // the pool grows while the pending redo is large
+  ctx.mt_ctx_.trans_mgr_.pending_log_size_ = 64L * 1024L * 1024L;
+  for (int64_t i = 0; i < max_busy_cnt; ++i) {
+    EXPECT_EQ(OB_SUCCESS, ctx.get_log_cb_(false, log_cbs[i]));
+  }
+  EXPECT_EQ(OB_TX_NOLOGCB, ctx.get_log_cb_(false, log_cb));
+  EXPECT_EQ(max_extra_cnt, ctx.extra_log_cb_cnt_);
+  EXPECT_EQ(max_busy_cnt, ctx.busy_cbs_.get_size());
+  EXPECT_EQ(RESERVE_LOG_CALLBACK_COUNT_FOR_FREEZING, ctx.free_cbs_.get_size());
+
+  // and shrinks once the pending redo is drained
+  ctx.mt_ctx_.trans_mgr_.pending_log_size_ = 0;
+  for (int64_t i = 0; i < max_busy_cnt; ++i) {
+    EXPECT_EQ(OB_SUCCESS, ctx.return_log_cb_(log_cbs[i]));
+  }
+  EXPECT_EQ(0, ctx.extra_log_cb_cnt_);
+  EXPECT_TRUE(ctx.busy_cbs_.is_empty());
+  EXPECT_EQ(OB_TX_MAX_LOG_CBS, ctx.free_cbs_.get_size());
+
+  // extra log cbs in both lists are unlinked and freed at reset
+  ctx.mt_ctx_.trans_mgr_.pending_log_size_ = 64L * 1024L * 1024L;
+  for (int64_t i = 0; i < max_busy_cnt; ++i) {
+    EXPECT_EQ(OB_SUCCESS, ctx.get_log_cb_(false, log_cbs[i]));
+  }
+  EXPECT_EQ(OB_SUCCESS, ctx.return_log_cb_(log_cbs[max_busy_cnt - 1]));
+  EXPECT_EQ(max_extra_cnt, ctx.extra_log_cb_cnt_);
+  ctx.reset_log_cbs_();
+  EXPECT_EQ(0, ctx.extra_log_cb_cnt_);
+  EXPECT_TRUE(ctx.busy_cbs_.is_empty());
+  EXPECT_TRUE(ctx.free_cbs_.is_empty());
+  ctx.mt_ctx_.trans_mgr_.pending_log_size_ = 0;
+}
+
 }
 
 namespace transaction
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "storage/tx_table/ob_tx_data_cache.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+using namespace share;
+using namespace storage;
+
+namespace unittest
+{
+
+class TestTxDataCache : public ::testing::Test
+{
+public:
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+  static void make_tx_data(const int64_t tx_id, const int32_t state, const int64_t commit_version,
+                           ObTxData &tx_data)
+  {
+    tx_data.reset();
+    tx_data.tx_id_ = ObTransID(tx_id);
+    tx_data.state_ = state;
+    tx_data.commit_version_.convert_for_tx(commit_version);
+  }
+};
+
+TEST_F(TestTxDataCache, decided_tx_data)
+{
+  ObTxDataCache cache;
+  ObTxCommitData commit_data;
+  ObTxData tx_data;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, cache.init(OB_SERVER_TENANT_ID, 1000));
+  ASSERT_EQ(OB_SUCCESS, cache.init(OB_SERVER_TENANT_ID, 16));
+  ASSERT_EQ(OB_INIT_TWICE, cache.init(OB_SERVER_TENANT_ID, 16));
+
+  // committed and aborted txns are cached
+  make_tx_data(1, ObTxData::COMMIT, 100, tx_data);
+  cache.put(tx_data);
+  make_tx_data(2, ObTxData::ABORT, 0, tx_data);
+  cache.put(tx_data);
+  ASSERT_EQ(OB_SUCCESS, cache.get(ObTransID(1), commit_data));
+  ASSERT_EQ(ObTxData::COMMIT, commit_data.state_);
+  ASSERT_EQ(100, commit_data.commit_version_.get_val_for_tx());
+  ASSERT_EQ(OB_SUCCESS, cache.get(ObTransID(2), commit_data));
+  ASSERT_EQ(ObTxData::ABORT, commit_data.state_);
+
+  // running txns are not cached
+  make_tx_data(3, ObTxData::RUNNING, 0, tx_data);
+  cache.put(tx_data);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(3), commit_data));
+
+  // the slot is taken by another txn
+  make_tx_data(17, ObTxData::COMMIT, 200, tx_data);
+  cache.put(tx_data);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(1), commit_data));
+  ASSERT_EQ(OB_SUCCESS, cache.get(ObTransID(17), commit_data));
+  ASSERT_EQ(200, commit_data.commit_version_.get_val_for_tx());
+
+  cache.reuse();
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(2), commit_data));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(17), commit_data));
+  cache.destroy();
+}
+
+TEST_F(TestTxDataCache, scan_tx_state)
+{
+  ObTxStateCache cache;
+  int32_t state = ObTxData::RUNNING;
+  int64_t commit_version = 0;
+  ASSERT_FALSE(cache.get(ObTransID(1), state, commit_version));
+  cache.put(ObTransID(1), ObTxData::COMMIT, 100);
+  cache.put(ObTransID(2), ObTxData::RUNNING, 0);
+  ASSERT_TRUE(cache.get(ObTransID(1), state, commit_version));
+  ASSERT_EQ(ObTxData::COMMIT, state);
+  ASSERT_EQ(100, commit_version);
+  ASSERT_TRUE(cache.get(ObTransID(2), state, commit_version));
+  ASSERT_EQ(ObTxData::RUNNING, state);
+  cache.put(ObTransID(1 + ObTxStateCache::SLOT_CNT), ObTxData::ABORT, 0);
+  ASSERT_FALSE(cache.get(ObTransID(1), state, commit_version));
+  cache.reset();
+  ASSERT_FALSE(cache.get(ObTransID(2), state, commit_version));
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_tx_data_cache.log*");
+  OB_LOGGER.set_file_name("test_tx_data_cache.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}